@@ -9,6 +9,7 @@
  */
 #include "ActivityLog.h"
 #include "common/network/BaseNetwork.h"
+#include "common/AsyncFileWriter.h"
 #include "common/Log.h" // for CurrentLogFileLevel() and LogGetNetwork()
 
 #if defined(_WIN32)
@@ -25,6 +26,7 @@
 #include <cstdarg>
 #include <ctime>
 #include <cassert>
+#include <mutex>
 #include <cstring>
 
 // ---------------------------------------------------------------------------
@@ -42,7 +44,9 @@ const uint32_t ACT_LOG_BUFFER_LEN = 501U;
 static std::string m_actFilePath;
 static std::string m_actFileRoot;
 
-static FILE* m_actFpLog = nullptr;
+static std::mutex m_actMutex;
+static AsyncFileWriter* m_actWriter = nullptr;
+static std::string m_actFileName;
 
 static struct tm m_actTm;
 
@@ -50,34 +54,24 @@ static struct tm m_actTm;
 //  Global Functions
 // ---------------------------------------------------------------------------
 
-/* Helper to open the activity log file, file handle. */
+/* Helper to get the current date-rolled activity log file name. */
 
-static bool ActivityLogOpen()
+static std::string ActivityLogFileName()
 {
-    if (CurrentLogFileLevel() == 0U)
-        return true;
-
     time_t now;
     ::time(&now);
 
     struct tm* tm = ::gmtime(&now);
 
-    if (tm->tm_mday == m_actTm.tm_mday && tm->tm_mon == m_actTm.tm_mon && tm->tm_year == m_actTm.tm_year) {
-        if (m_actFpLog != nullptr)
-            return true;
-    }
-    else {
-        if (m_actFpLog != nullptr)
-            ::fclose(m_actFpLog);
-    }
+    if (tm->tm_mday != m_actTm.tm_mday || tm->tm_mon != m_actTm.tm_mon || tm->tm_year != m_actTm.tm_year || m_actFileName.empty()) {
+        char filename[200U];
+        ::sprintf(filename, "%s/%s-%04d-%02d-%02d.activity.log", LogGetFilePath().c_str(), LogGetFileRoot().c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
 
-    char filename[200U];
-    ::sprintf(filename, "%s/%s-%04d-%02d-%02d.activity.log", LogGetFilePath().c_str(), LogGetFileRoot().c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
-
-    m_actFpLog = ::fopen(filename, "a+t");
-    m_actTm = *tm;
+        m_actFileName = std::string(filename);
+        m_actTm = *tm;
+    }
 
-    return m_actFpLog != nullptr;
+    return m_actFileName;
 }
 
 /* Initializes the activity log. */
@@ -87,10 +81,25 @@ bool ActivityLogInitialise(const std::string& filePath, const std::string& fileR
 #if defined(CATCH2_TEST_COMPILATION)
     return true;
 #endif
+    std::lock_guard<std::mutex> lock(m_actMutex);
     m_actFilePath = filePath;
     m_actFileRoot = fileRoot;
+    m_actFileName.clear();
+
+    if (CurrentLogFileLevel() == 0U)
+        return true;
+
+    // the writer thread isn't started until the first entry, but make sure the file can be opened now
+    FILE* fp = ::fopen(::ActivityLogFileName().c_str(), "a+t");
+    if (fp == nullptr)
+        return false;
+    ::fclose(fp);
+
+    if (m_actWriter != nullptr)
+        delete m_actWriter;
+    m_actWriter = new AsyncFileWriter("actlog");
 
-    return ::ActivityLogOpen();
+    return true;
 }
 
 /* Finalizes the activity log. */
@@ -100,8 +109,12 @@ void ActivityLogFinalise()
 #if defined(CATCH2_TEST_COMPILATION)
     return;
 #endif
-    if (m_actFpLog != nullptr)
-        ::fclose(m_actFpLog);
+    std::lock_guard<std::mutex> lock(m_actMutex);
+    if (m_actWriter != nullptr) {
+        m_actWriter->stop();
+        delete m_actWriter;
+        m_actWriter = nullptr;
+    }
 }
 
 /* Writes a new entry to the activity log. */
@@ -133,10 +146,6 @@ void ActivityLog(const char* msg, ...)
     va_end(vl_len);
     va_end(vl);
 
-    bool ret = ::ActivityLogOpen();
-    if (!ret)
-        return;
-
     if (LogGetNetwork() != nullptr) {
         network::BaseNetwork* network = (network::BaseNetwork*)LogGetNetwork();;
         network->writeActLog(buffer);
@@ -145,8 +154,14 @@ void ActivityLog(const char* msg, ...)
     if (CurrentLogFileLevel() == 0U)
         return;
 
-    ::fprintf(m_actFpLog, "%s\n", buffer);
-    ::fflush(m_actFpLog);
+    {
+        std::lock_guard<std::mutex> lock(m_actMutex);
+        if (m_actWriter == nullptr)
+            return;
+
+        std::string line = std::string(buffer) + "\n";
+        m_actWriter->write(::ActivityLogFileName(), line.c_str(), line.size());
+    }
 
     if (2U >= g_logDisplayLevel && g_logDisplayLevel != 0U) {
         ::fprintf(stdout, "%s" EOL, buffer);
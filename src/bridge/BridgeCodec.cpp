@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/dmr/data/EMB.h"
+#include "common/dmr/lc/FullLC.h"
+#include "common/dmr/SlotType.h"
+#include "common/p25/P25Defines.h"
+#include "common/Utils.h"
+#include "BridgeCodec.h"
+
+using namespace dmr;
+using namespace dmr::defines;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+const uint32_t BridgeCodec::LDU_IMBE_OFFSET[9U] = { 10U, 26U, 55U, 80U, 105U, 130U, 155U, 180U, 204U };
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to apply gain to PCM samples. */
+
+void BridgeCodec::applyGain(short* samples, float gain)
+{
+    assert(samples != nullptr);
+
+    if (gain == 1.0f)
+        return;
+
+    for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
+        float newSample = samples[n] * gain;
+        short sample = (short)newSample;
+
+        // clip if necessary
+        if (gain > 1.0f) {
+            if (newSample > 32767)
+                sample = 32767;
+            else if (newSample < -32767)
+                sample = -32767;
+        }
+
+        samples[n] = sample;
+    }
+}
+
+/* Helper to convert 16-bit little-endian PCM bytes to samples. */
+
+void BridgeCodec::pcmToSamples(const uint8_t* pcm, short* samples)
+{
+    assert(pcm != nullptr);
+    assert(samples != nullptr);
+
+    for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
+        samples[smpIdx] = (short)((pcm[(smpIdx * 2U) + 1U] << 8) + pcm[(smpIdx * 2U) + 0U]);
+    }
+}
+
+/* Helper to convert samples to 16-bit little-endian PCM bytes. */
+
+void BridgeCodec::samplesToPCM(const short* samples, uint8_t* pcm)
+{
+    assert(samples != nullptr);
+    assert(pcm != nullptr);
+
+    for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
+        pcm[(smpIdx * 2U) + 0U] = (uint8_t)(samples[smpIdx] & 0xFF);
+        pcm[(smpIdx * 2U) + 1U] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
+    }
+}
+
+/* Helper to build a UDP audio frame from PCM samples. */
+
+uint32_t BridgeCodec::buildUDPAudio(const short* samples, uint32_t srcId, uint32_t dstId, bool metadata, uint8_t* buffer)
+{
+    assert(buffer != nullptr);
+
+    __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), buffer, 0U);
+    samplesToPCM(samples, buffer + 4U);
+
+    if (!metadata)
+        return (MBE_SAMPLES_LENGTH * 2U) + 4U;
+
+    // embed destination and source IDs
+    __SET_UINT32(dstId, buffer, ((MBE_SAMPLES_LENGTH * 2U) + 4U));
+    __SET_UINT32(srcId, buffer, ((MBE_SAMPLES_LENGTH * 2U) + 8U));
+    return (MBE_SAMPLES_LENGTH * 2U) + 12U;
+}
+
+/* Helper to build a DMR voice LC header burst. */
+
+void BridgeCodec::buildDMRVoiceHeader(uint32_t srcId, uint32_t dstId, data::EmbeddedData& embeddedData, uint8_t* data)
+{
+    assert(data != nullptr);
+
+    ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+    // generate DMR LC
+    lc::LC dmrLC = lc::LC();
+    dmrLC.setFLCO(FLCO::GROUP);
+    dmrLC.setSrcId(srcId);
+    dmrLC.setDstId(dstId);
+    embeddedData.setLC(dmrLC);
+
+    // generate the Slot Type
+    SlotType slotType = SlotType();
+    slotType.setDataType(DataType::VOICE_LC_HEADER);
+    slotType.encode(data);
+
+    lc::FullLC fullLC = lc::FullLC();
+    fullLC.encode(dmrLC, data, DataType::VOICE_LC_HEADER);
+}
+
+/* Helper to build a DMR voice burst from 3 AMBE codewords. */
+
+DataType::E BridgeCodec::buildDMRVoice(const uint8_t* ambe, uint8_t dmrN, data::EmbeddedData& embeddedData, uint8_t* data)
+{
+    assert(ambe != nullptr);
+    assert(data != nullptr);
+
+    ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+    ::memcpy(data, ambe, 13U);
+    data[13U] = (uint8_t)(ambe[13U] & 0xF0);
+    data[19U] = (uint8_t)(ambe[13U] & 0x0F);
+    ::memcpy(data + 20U, ambe + 14U, 13U);
+
+    if (dmrN == 0U)
+        return DataType::VOICE_SYNC;
+
+    uint8_t lcss = embeddedData.getData(data, dmrN);
+
+    // generated embedded signalling
+    data::EMB emb = data::EMB();
+    emb.setColorCode(0U);
+    emb.setLCSS(lcss);
+    emb.encode(data);
+
+    return DataType::VOICE;
+}
+
+/* Helper to create the P25 group voice link control. */
+
+p25::lc::LC BridgeCodec::createP25GroupLC(uint32_t srcId, uint32_t dstId)
+{
+    p25::lc::LC lc = p25::lc::LC();
+    lc.setLCO(p25::defines::LCO::GROUP);
+    lc.setGroup(true);
+    lc.setPriority(4U);
+    lc.setDstId(dstId);
+    lc.setSrcId(srcId);
+    return lc;
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file BridgeCodec.h
+ * @ingroup bridge
+ * @file BridgeCodec.cpp
+ * @ingroup bridge
+ */
+#if !defined(__BRIDGE_CODEC_H__)
+#define __BRIDGE_CODEC_H__
+
+#include "Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/dmr/data/EmbeddedData.h"
+#include "common/p25/lc/LC.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// PCM + 4 bytes (PCM length) [+ 4 bytes (dstId) + 4 bytes (srcId)]
+#define UDP_AUDIO_MAX_LENGTH ((MBE_SAMPLES_LENGTH * 2U) + 12U)
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements the audio and vocoder framing helpers shared by the single-stream bridge
+ *  (HostBridge) and the multi-stream bridge (BridgeStream).
+ * @ingroup bridge
+ */
+class HOST_SW_API BridgeCodec {
+public:
+    /**
+     * @brief Offsets of the 9 IMBE codewords within a LDU buffer.
+     */
+    static const uint32_t LDU_IMBE_OFFSET[9U];
+
+    /**
+     * @brief Helper to apply gain to PCM samples.
+     * @param samples PCM samples (MBE_SAMPLES_LENGTH).
+     * @param gain Gain.
+     */
+    static void applyGain(short* samples, float gain);
+
+    /**
+     * @brief Helper to convert 16-bit little-endian PCM bytes to samples.
+     * @param[in] pcm PCM bytes (MBE_SAMPLES_LENGTH * 2).
+     * @param[out] samples PCM samples (MBE_SAMPLES_LENGTH).
+     */
+    static void pcmToSamples(const uint8_t* pcm, short* samples);
+    /**
+     * @brief Helper to convert samples to 16-bit little-endian PCM bytes.
+     * @param[in] samples PCM samples (MBE_SAMPLES_LENGTH).
+     * @param[out] pcm PCM bytes (MBE_SAMPLES_LENGTH * 2).
+     */
+    static void samplesToPCM(const short* samples, uint8_t* pcm);
+
+    /**
+     * @brief Helper to build a UDP audio frame from PCM samples.
+     * @param[in] samples PCM samples (MBE_SAMPLES_LENGTH).
+     * @param srcId Source ID (metadata only).
+     * @param dstId Destination ID (metadata only).
+     * @param metadata Flag indicating source/destination metadata is appended.
+     * @param[out] buffer UDP audio frame (UDP_AUDIO_MAX_LENGTH).
+     * @returns uint32_t Length of the UDP audio frame.
+     */
+    static uint32_t buildUDPAudio(const short* samples, uint32_t srcId, uint32_t dstId, bool metadata, uint8_t* buffer);
+
+    /**
+     * @brief Helper to build a DMR voice LC header burst, and set the LC for the embedded signalling.
+     * @param srcId Source ID.
+     * @param dstId Destination ID.
+     * @param embeddedData Embedded data (for the rest of the call).
+     * @param[out] data DMR burst (DMR_FRAME_LENGTH_BYTES).
+     */
+    static void buildDMRVoiceHeader(uint32_t srcId, uint32_t dstId, dmr::data::EmbeddedData& embeddedData, uint8_t* data);
+    /**
+     * @brief Helper to build a DMR voice burst from 3 AMBE codewords.
+     * @param[in] ambe AMBE codewords (3 * 9 bytes).
+     * @param dmrN Voice burst number (0 - 5) within the superframe.
+     * @param embeddedData Embedded data.
+     * @param[out] data DMR burst (DMR_FRAME_LENGTH_BYTES).
+     * @returns DataType::E Data type of the burst.
+     */
+    static dmr::defines::DataType::E buildDMRVoice(const uint8_t* ambe, uint8_t dmrN, dmr::data::EmbeddedData& embeddedData, uint8_t* data);
+
+    /**
+     * @brief Helper to create the P25 group voice link control.
+     * @param srcId Source ID.
+     * @param dstId Destination ID.
+     * @returns lc::LC Link control.
+     */
+    static p25::lc::LC createP25GroupLC(uint32_t srcId, uint32_t dstId);
+};
+
+#endif // __BRIDGE_CODEC_H__
@@ -0,0 +1,818 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/dmr/data/NetData.h"
+#include "common/dmr/lc/FullLC.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/data/LowSpeedData.h"
+#include "common/p25/dfsi/DFSIDefines.h"
+#include "common/p25/dfsi/LC.h"
+#include "common/p25/lc/LC.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "BridgeCodec.h"
+#include "BridgeStream.h"
+
+using namespace network;
+using namespace network::udp;
+
+#include <cassert>
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define UDP_CALL "UDP Traffic"
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the current time in milliseconds. */
+
+static uint64_t nowMS()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the BridgeStream class. */
+
+BridgeStream::BridgeStream(PeerNetwork* network, std::mutex& networkMutex, uint8_t txMode, uint32_t srcId, uint32_t dstId, uint8_t slot) :
+    m_dstId(dstId),
+    m_slot(slot),
+    m_ownedSocket(nullptr),
+    m_scheduled(false),
+    m_network(network),
+    m_networkMutex(networkMutex),
+    m_txMode(txMode),
+    m_srcId(srcId),
+    m_rxAudioGain(1.0f),
+    m_vocoderDecoderAudioGain(3.0f),
+    m_vocoderDecoderAutoGain(false),
+    m_txAudioGain(1.0f),
+    m_vocoderEncoderAudioGain(3.0f),
+    m_dropTimeMS(180U),
+    m_grantDemand(false),
+    m_overrideSrcIdFromUDP(false),
+    m_udpSocket(nullptr),
+    m_udpSendAddress("127.0.0.1"),
+    m_udpSendPort(34001U),
+    m_udpMetadata(false),
+    m_udpAddr(),
+    m_udpAddrLen(0U),
+    m_udpAddrValid(false),
+    m_decoder(nullptr),
+    m_encoder(nullptr),
+    m_queueMutex(),
+    m_frames(),
+    m_stateMutex(),
+    m_callInProgress(false),
+    m_ignoreCall(false),
+    m_callAlgoId(0U),
+    m_rxSrcId(0U),
+    m_rxStartTime(0U),
+    m_rxIdleMS(0U),
+    m_audioDetect(false),
+    m_txSrcId(0U),
+    m_txStartTime(0U),
+    m_dropTime(1000U, 0U, 180U),
+    m_txStream(),
+    m_dmrEmbeddedData(),
+    m_ambeBuffer(nullptr),
+    m_ambeCount(0U),
+    m_dmrSeqNo(0U),
+    m_dmrN(0U),
+    m_netLDU1(nullptr),
+    m_netLDU2(nullptr),
+    m_p25N(0U),
+    m_framesLate(0U),
+    m_framesDropped(0U),
+    m_maxLatency(0U)
+{
+    assert(network != nullptr);
+
+    m_ambeBuffer = new uint8_t[27U];
+    ::memset(m_ambeBuffer, 0x00U, 27U);
+
+    m_netLDU1 = new uint8_t[9U * 25U];
+    m_netLDU2 = new uint8_t[9U * 25U];
+    ::memset(m_netLDU1, 0x00U, 9U * 25U);
+    ::memset(m_netLDU2, 0x00U, 9U * 25U);
+}
+
+/* Finalizes a instance of the BridgeStream class. */
+
+BridgeStream::~BridgeStream()
+{
+    if (m_decoder != nullptr)
+        delete m_decoder;
+    if (m_encoder != nullptr)
+        delete m_encoder;
+
+    delete[] m_ambeBuffer;
+    delete[] m_netLDU1;
+    delete[] m_netLDU2;
+}
+
+/* Sets the audio gain options. */
+
+void BridgeStream::setAudioGain(float rxAudioGain, float vocoderDecoderAudioGain, bool vocoderDecoderAutoGain, float txAudioGain, float vocoderEncoderAudioGain)
+{
+    m_rxAudioGain = rxAudioGain;
+    m_vocoderDecoderAudioGain = vocoderDecoderAudioGain;
+    m_vocoderDecoderAutoGain = vocoderDecoderAutoGain;
+    m_txAudioGain = txAudioGain;
+    m_vocoderEncoderAudioGain = vocoderEncoderAudioGain;
+}
+
+/* Sets the call options. */
+
+void BridgeStream::setCallOptions(uint16_t dropTimeMS, bool grantDemand, bool overrideSrcIdFromUDP)
+{
+    m_dropTimeMS = dropTimeMS;
+    m_dropTime = Timer(1000U, 0U, m_dropTimeMS);
+    m_grantDemand = grantDemand;
+    m_overrideSrcIdFromUDP = overrideSrcIdFromUDP;
+}
+
+/* Sets the UDP audio options. */
+
+void BridgeStream::setUDP(Socket* socket, bool ownsSocket, const std::string& sendAddress, uint16_t sendPort, bool metadata)
+{
+    m_udpSocket = socket;
+    m_ownedSocket = ownsSocket ? socket : nullptr;
+    m_udpSendAddress = sendAddress;
+    m_udpSendPort = sendPort;
+    m_udpMetadata = metadata;
+}
+
+/* Initializes the stream vocoders and UDP endpoint. */
+
+bool BridgeStream::open()
+{
+    if (m_txMode == TX_MODE_DMR) {
+        m_decoder = new vocoder::MBEDecoder(vocoder::DECODE_DMR_AMBE);
+        m_encoder = new vocoder::MBEEncoder(vocoder::ENCODE_DMR_AMBE);
+    }
+    else {
+        m_decoder = new vocoder::MBEDecoder(vocoder::DECODE_88BIT_IMBE);
+        m_encoder = new vocoder::MBEEncoder(vocoder::ENCODE_88BIT_IMBE);
+    }
+
+    m_decoder->setGainAdjust(m_vocoderDecoderAudioGain);
+    m_decoder->setAutoGain(m_vocoderDecoderAutoGain);
+    m_encoder->setGainAdjust(m_vocoderEncoderAudioGain);
+
+    if (m_ownedSocket != nullptr) {
+        if (!m_ownedSocket->open()) {
+            LogError(LOG_HOST, "Stream dstId = %u, failed to open UDP audio socket", m_dstId);
+            return false;
+        }
+    }
+
+    // resolve the send address once, rather than per audio frame
+    m_udpAddrValid = (Socket::lookup(m_udpSendAddress, m_udpSendPort, m_udpAddr, m_udpAddrLen) == 0);
+    if (!m_udpAddrValid) {
+        LogError(LOG_HOST, "Stream dstId = %u, failed to resolve UDP audio send address %s:%u", m_dstId, m_udpSendAddress.c_str(), m_udpSendPort);
+        return false;
+    }
+
+    return true;
+}
+
+/* Closes the stream, ending any active call. */
+
+void BridgeStream::close()
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+
+    if (m_audioDetect)
+        txCallEnd();
+    if (m_callInProgress)
+        rxCallEnd("shutdown");
+
+    if (m_ownedSocket != nullptr) {
+        m_ownedSocket->close();
+        delete m_ownedSocket;
+        m_ownedSocket = nullptr;
+        m_udpSocket = nullptr;
+    }
+}
+
+/* Queues a network frame for this stream. */
+
+bool BridgeStream::writeNetwork(const uint8_t* buffer, uint32_t length)
+{
+    assert(buffer != nullptr);
+
+    StreamFrame frame;
+    frame.network = true;
+    frame.data = std::make_unique<uint8_t[]>(length);
+    ::memcpy(frame.data.get(), buffer, length);
+    frame.length = length;
+    frame.srcId = 0U;
+    frame.deadline = nowMS() + STREAM_FRAME_DEADLINE_MS;
+
+    return queueFrame(frame);
+}
+
+/* Queues a PCM audio frame received over UDP for this stream. */
+
+bool BridgeStream::writeAudio(const uint8_t* pcm, uint32_t srcId)
+{
+    assert(pcm != nullptr);
+
+    StreamFrame frame;
+    frame.network = false;
+    frame.data = std::make_unique<uint8_t[]>(MBE_SAMPLES_LENGTH * 2U);
+    ::memcpy(frame.data.get(), pcm, MBE_SAMPLES_LENGTH * 2U);
+    frame.length = MBE_SAMPLES_LENGTH * 2U;
+    frame.srcId = srcId;
+    frame.deadline = nowMS() + STREAM_FRAME_DEADLINE_MS;
+
+    return queueFrame(frame);
+}
+
+/* Updates the stream call timers by the passed number of milliseconds. */
+
+void BridgeStream::clock(uint32_t ms)
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+
+    // UDP audio stopped arriving; end the call
+    if (m_dropTime.isRunning()) {
+        m_dropTime.clock(ms);
+        if (m_dropTime.hasExpired() && m_audioDetect) {
+            txCallEnd();
+        }
+    }
+
+    // network call lost its terminator; end the call
+    if (m_callInProgress) {
+        m_rxIdleMS += ms;
+        if (m_rxIdleMS >= STREAM_RX_CALL_TIMEOUT_MS) {
+            rxCallEnd("call end (timeout)");
+        }
+    }
+}
+
+/* Transcodes all queued frames. */
+
+void BridgeStream::process()
+{
+    std::lock_guard<std::mutex> stateLock(m_stateMutex);
+
+    while (true) {
+        StreamFrame frame;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_frames.empty())
+                break;
+
+            frame = std::move(m_frames.front());
+            m_frames.pop_front();
+        }
+
+        if (frame.network) {
+            switch (m_txMode) {
+            case TX_MODE_DMR:
+                processDMRNetwork(frame.data.get(), frame.length);
+                break;
+            case TX_MODE_P25:
+                processP25Network(frame.data.get(), frame.length);
+                break;
+            }
+        }
+        else {
+            processAudio(frame.data.get(), frame.srcId);
+        }
+
+        // latency is measured from the frame being queued to it being fully transcoded
+        uint64_t now = nowMS();
+        uint64_t latency = now - (frame.deadline - STREAM_FRAME_DEADLINE_MS);
+        if (latency > m_maxLatency)
+            m_maxLatency = latency;
+        if (now > frame.deadline)
+            m_framesLate++;
+    }
+}
+
+/* Helper to determine whether the stream has queued frames. */
+
+bool BridgeStream::hasPendingFrames()
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return !m_frames.empty();
+}
+
+/* Gets the deadline (ms) of the oldest queued frame. */
+
+uint64_t BridgeStream::nextDeadline()
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if (m_frames.empty())
+        return nowMS() + STREAM_FRAME_DEADLINE_MS;
+    return m_frames.front().deadline;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to queue a frame for transcoding. */
+
+bool BridgeStream::queueFrame(StreamFrame& frame)
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+
+    // if the stream has fallen this far behind, the oldest audio is already useless
+    if (m_frames.size() >= STREAM_MAX_QUEUED_FRAMES) {
+        m_frames.pop_front();
+        m_framesDropped++;
+
+        if ((m_framesDropped % STREAM_MAX_QUEUED_FRAMES) == 1U) {
+            LogWarning(LOG_HOST, "Stream dstId = %u, transcoding queue overflow, %u frames dropped", m_dstId, m_framesDropped);
+        }
+    }
+
+    m_frames.push_back(std::move(frame));
+    return true;
+}
+
+/* Helper to process DMR network traffic. */
+
+void BridgeStream::processDMRNetwork(uint8_t* buffer, uint32_t length)
+{
+    assert(buffer != nullptr);
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    uint32_t srcId = __GET_UINT16(buffer, 5U);
+    uint32_t dstId = __GET_UINT16(buffer, 8U);
+
+    FLCO::E flco = (buffer[15U] & 0x40U) == 0x40U ? FLCO::PRIVATE : FLCO::GROUP;
+    uint32_t slotNo = (buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
+
+    if (flco != FLCO::GROUP || srcId == 0U)
+        return;
+    if (dstId != m_dstId || slotNo != m_slot)
+        return;
+
+    bool dataSync = (buffer[15U] & 0x20U) == 0x20U;
+    bool voiceSync = (buffer[15U] & 0x10U) == 0x10U;
+
+    uint8_t data[DMR_FRAME_LENGTH_BYTES];
+    ::memcpy(data, buffer + 20U, DMR_FRAME_LENGTH_BYTES);
+
+    DataType::E dataType = DataType::VOICE_SYNC;
+    if (dataSync) {
+        dataType = (DataType::E)(buffer[15U] & 0x0FU);
+    }
+    else if (!voiceSync) {
+        dataType = DataType::VOICE;
+    }
+
+    if (dataSync && (dataType == DataType::TERMINATOR_WITH_LC)) {
+        if (m_callInProgress)
+            rxCallEnd("call end");
+        m_ignoreCall = false;
+        return;
+    }
+
+    if (!m_callInProgress && !m_ignoreCall) {
+        rxCallStart(srcId);
+    }
+
+    m_rxIdleMS = 0U;
+
+    // if we can, use the PI LC from the PI voice header to detect encrypted traffic
+    if (dataSync && (dataType == DataType::VOICE_PI_HEADER)) {
+        lc::FullLC fullLC = lc::FullLC();
+        std::unique_ptr<lc::PrivacyLC> lc = fullLC.decodePI(data);
+        if (lc != nullptr)
+            m_callAlgoId = lc->getAlgId();
+    }
+
+    if (m_ignoreCall)
+        return;
+
+    if (m_callAlgoId != 0U) {
+        rxCallEnd("call end (T)");
+        m_ignoreCall = true;
+        return;
+    }
+
+    if (dataType == DataType::VOICE_SYNC || dataType == DataType::VOICE) {
+        uint8_t ambe[27U];
+        ::memcpy(ambe, data, 14U);
+        ambe[13] &= 0xF0;
+        ambe[13] |= (uint8_t)(data[19] & 0x0F);
+        ::memcpy(ambe + 14U, data + 20U, 13U);
+
+        for (uint32_t n = 0; n < AMBE_PER_SLOT; n++) {
+            decodeAudioFrame(ambe + (n * 9U), srcId);
+        }
+    }
+}
+
+/* Helper to process P25 network traffic. */
+
+void BridgeStream::processP25Network(uint8_t* buffer, uint32_t length)
+{
+    assert(buffer != nullptr);
+    using namespace p25;
+    using namespace p25::defines;
+    using namespace p25::dfsi::defines;
+
+    bool grantDemand = (buffer[14U] & 0x80U) == 0x80U;
+
+    DUID::E duid = (DUID::E)buffer[22U];
+    uint8_t MFId = buffer[15U];
+
+    if (duid == DUID::HDU || duid == DUID::TSDU || duid == DUID::PDU)
+        return;
+
+    uint8_t lco = buffer[4U];
+    uint32_t srcId = __GET_UINT16(buffer, 5U);
+    uint32_t dstId = __GET_UINT16(buffer, 8U);
+
+    lc::LC control;
+    control.setLCO(lco);
+    control.setMFId(MFId);
+    if (!control.isStandardMFId() || control.getLCO() == LCO::GROUP_UPDT || control.getLCO() == LCO::RFSS_STS_BCAST) {
+        control.setLCO(LCO::GROUP);
+    }
+
+    if (control.getLCO() != LCO::GROUP || srcId == 0U)
+        return;
+    if (dstId != m_dstId)
+        return;
+
+    if ((duid == DUID::TDU) || (duid == DUID::TDULC)) {
+        // ignore TDU's that are grant demands
+        if (grantDemand)
+            return;
+
+        if (m_callInProgress)
+            rxCallEnd("call end");
+        m_ignoreCall = false;
+        return;
+    }
+
+    uint8_t frameLength = buffer[23U];
+    if (frameLength <= 24U || (24U + frameLength) > length)
+        return;
+
+    const uint8_t* data = buffer + 24U;
+
+    if (!m_callInProgress && !m_ignoreCall) {
+        rxCallStart(srcId);
+    }
+
+    m_rxIdleMS = 0U;
+
+    // if this is an LDU1 see if this is the first LDU with HDU encryption data
+    if (duid == DUID::LDU1 && !m_ignoreCall && length > 181U) {
+        if (buffer[180U] == FrameType::HDU_VALID)
+            m_callAlgoId = buffer[181U];
+    }
+
+    if (duid == DUID::LDU2 && !m_ignoreCall && frameLength > 88U)
+        m_callAlgoId = data[88U];
+
+    if (m_ignoreCall)
+        return;
+
+    if (m_callAlgoId != ALGO_UNENCRYPT) {
+        rxCallEnd("call end (T)");
+        m_ignoreCall = true;
+        return;
+    }
+
+    uint8_t firstFrameType = 0U;
+    uint8_t* ldu = nullptr;
+    const uint32_t* frameLengths = nullptr;
+
+    const uint32_t LDU1_LENGTHS[9U] = { DFSI_LDU1_VOICE1_FRAME_LENGTH_BYTES, DFSI_LDU1_VOICE2_FRAME_LENGTH_BYTES, DFSI_LDU1_VOICE3_FRAME_LENGTH_BYTES,
+        DFSI_LDU1_VOICE4_FRAME_LENGTH_BYTES, DFSI_LDU1_VOICE5_FRAME_LENGTH_BYTES, DFSI_LDU1_VOICE6_FRAME_LENGTH_BYTES,
+        DFSI_LDU1_VOICE7_FRAME_LENGTH_BYTES, DFSI_LDU1_VOICE8_FRAME_LENGTH_BYTES, DFSI_LDU1_VOICE9_FRAME_LENGTH_BYTES };
+    const uint32_t LDU2_LENGTHS[9U] = { DFSI_LDU2_VOICE10_FRAME_LENGTH_BYTES, DFSI_LDU2_VOICE11_FRAME_LENGTH_BYTES, DFSI_LDU2_VOICE12_FRAME_LENGTH_BYTES,
+        DFSI_LDU2_VOICE13_FRAME_LENGTH_BYTES, DFSI_LDU2_VOICE14_FRAME_LENGTH_BYTES, DFSI_LDU2_VOICE15_FRAME_LENGTH_BYTES,
+        DFSI_LDU2_VOICE16_FRAME_LENGTH_BYTES, DFSI_LDU2_VOICE17_FRAME_LENGTH_BYTES, DFSI_LDU2_VOICE18_FRAME_LENGTH_BYTES };
+
+    switch (duid) {
+    case DUID::LDU1:
+        firstFrameType = DFSIFrameType::LDU1_VOICE1;
+        ldu = m_netLDU1;
+        frameLengths = LDU1_LENGTHS;
+        break;
+    case DUID::LDU2:
+        firstFrameType = DFSIFrameType::LDU2_VOICE10;
+        ldu = m_netLDU2;
+        frameLengths = LDU2_LENGTHS;
+        break;
+    default:
+        return;
+    }
+
+    // validate the DFSI framing of all 9 voice frames before decoding any of them
+    uint32_t count = 0U;
+    for (uint32_t n = 0U; n < 9U; n++) {
+        if (count >= frameLength || data[count] != (uint8_t)(firstFrameType + n))
+            return;
+        count += frameLengths[n];
+    }
+
+    data::LowSpeedData lsd;
+    lsd.setLSD1(buffer[20U]);
+    lsd.setLSD2(buffer[21U]);
+
+    control.setSrcId(srcId);
+    control.setDstId(dstId);
+
+    dfsi::LC dfsiLC = dfsi::LC(control, lsd);
+
+    count = 0U;
+    for (uint32_t n = 0U; n < 9U; n++) {
+        dfsiLC.setFrameType((DFSIFrameType::E)(firstFrameType + n));
+        if (duid == DUID::LDU1)
+            dfsiLC.decodeLDU1(data + count, ldu + BridgeCodec::LDU_IMBE_OFFSET[n]);
+        else
+            dfsiLC.decodeLDU2(data + count, ldu + BridgeCodec::LDU_IMBE_OFFSET[n]);
+        count += frameLengths[n];
+    }
+
+    // decode 9 IMBE codewords into PCM samples
+    for (uint32_t n = 0U; n < 9U; n++) {
+        decodeAudioFrame(ldu + BridgeCodec::LDU_IMBE_OFFSET[n], srcId);
+    }
+}
+
+/* Helper to start a call received from the network. */
+
+void BridgeStream::rxCallStart(uint32_t srcId)
+{
+    m_callInProgress = true;
+    m_callAlgoId = 0U;
+    m_rxSrcId = srcId;
+    m_rxStartTime = nowMS();
+    m_rxIdleMS = 0U;
+    m_framesLate = 0U;
+    m_maxLatency = 0U;
+
+    LogMessage(LOG_HOST, "%s, call start, srcId = %u, dstId = %u", (m_txMode == TX_MODE_DMR) ? "DMR" : "P25", srcId, m_dstId);
+}
+
+/* Helper to end a call received from the network. */
+
+void BridgeStream::rxCallEnd(const char* reason)
+{
+    if (!m_callInProgress)
+        return;
+
+    m_callInProgress = false;
+    m_callAlgoId = 0U;
+
+    uint64_t diff = nowMS() - m_rxStartTime;
+    LogMessage(LOG_HOST, "%s, %s, srcId = %u, dstId = %u, dur = %us, late frames = %u, max latency = %ums", (m_txMode == TX_MODE_DMR) ? "DMR" : "P25",
+        reason, m_rxSrcId, m_dstId, (uint32_t)(diff / 1000U), m_framesLate, (uint32_t)m_maxLatency);
+
+    m_rxSrcId = 0U;
+    m_rxStartTime = 0U;
+}
+
+/* Helper to decode an MBE codeword and write the PCM audio to UDP. */
+
+void BridgeStream::decodeAudioFrame(uint8_t* codeword, uint32_t srcId)
+{
+    assert(codeword != nullptr);
+
+    short samples[MBE_SAMPLES_LENGTH];
+    m_decoder->decode(codeword, samples);
+
+    // post-process: apply gain to decoded audio frames
+    BridgeCodec::applyGain(samples, m_rxAudioGain);
+
+    if (m_udpSocket == nullptr || !m_udpAddrValid)
+        return;
+
+    uint8_t audioData[UDP_AUDIO_MAX_LENGTH];
+    uint32_t length = BridgeCodec::buildUDPAudio(samples, srcId, m_dstId, m_udpMetadata, audioData);
+
+    m_udpSocket->write(audioData, length, m_udpAddr, m_udpAddrLen);
+}
+
+/* Helper to process a PCM audio frame received over UDP. */
+
+void BridgeStream::processAudio(const uint8_t* pcm, uint32_t srcId)
+{
+    // network traffic has priority on the talkgroup
+    if (m_callInProgress)
+        return;
+
+    if (!m_audioDetect) {
+        m_audioDetect = true;
+        m_txSrcId = m_srcId;
+        if (m_overrideSrcIdFromUDP && srcId != 0U)
+            m_txSrcId = srcId;
+        m_txStartTime = nowMS();
+        m_txStream.reset();
+        m_framesLate = 0U;
+        m_maxLatency = 0U;
+
+        LogMessage(LOG_HOST, "%s, call start, srcId = %u, dstId = %u", UDP_CALL, m_txSrcId, m_dstId);
+
+        if (m_grantDemand && m_txMode == TX_MODE_P25) {
+            p25::lc::LC lc = p25::lc::LC();
+            lc.setLCO(p25::defines::LCO::GROUP);
+            lc.setDstId(m_dstId);
+            lc.setSrcId(m_txSrcId);
+
+            p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
+
+            std::lock_guard<std::mutex> lock(m_networkMutex);
+            m_network->writeP25TDU(lc, lsd, 0x80U, m_txStream);
+        }
+    }
+
+    m_dropTime.start();
+
+    short samples[MBE_SAMPLES_LENGTH];
+    BridgeCodec::pcmToSamples(pcm, samples);
+
+    // pre-process: apply gain to PCM audio frames
+    BridgeCodec::applyGain(samples, m_txAudioGain);
+
+    switch (m_txMode) {
+    case TX_MODE_DMR:
+        encodeDMRAudioFrame(samples);
+        break;
+    case TX_MODE_P25:
+        encodeP25AudioFrame(samples);
+        break;
+    }
+}
+
+/* Helper to encode DMR audio frames. */
+
+void BridgeStream::encodeDMRAudioFrame(short* samples)
+{
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    // encode PCM samples into AMBE codewords
+    uint8_t ambe[RAW_AMBE_LENGTH_BYTES];
+    ::memset(ambe, 0x00U, RAW_AMBE_LENGTH_BYTES);
+    m_encoder->encode(samples, ambe);
+
+    ::memcpy(m_ambeBuffer + (m_ambeCount * 9U), ambe, RAW_AMBE_LENGTH_BYTES);
+    m_ambeCount++;
+
+    if (m_ambeCount < AMBE_PER_SLOT)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_networkMutex);
+
+    uint8_t data[DMR_FRAME_LENGTH_BYTES];
+    m_dmrN = (uint8_t)(m_dmrSeqNo % 6);
+
+    // is this the intitial sequence?
+    if (m_dmrSeqNo == 0) {
+        BridgeCodec::buildDMRVoiceHeader(m_txSrcId, m_dstId, m_dmrEmbeddedData, data);
+
+        // generate DMR network frame
+        data::NetData dmrData;
+        dmrData.setSlotNo(m_slot);
+        dmrData.setDataType(DataType::VOICE_LC_HEADER);
+        dmrData.setSrcId(m_txSrcId);
+        dmrData.setDstId(m_dstId);
+        dmrData.setFLCO(FLCO::GROUP);
+        dmrData.setN(m_dmrN);
+        dmrData.setSeqNo(m_dmrSeqNo);
+        dmrData.setBER(0U);
+        dmrData.setRSSI(0U);
+        dmrData.setData(data);
+
+        m_network->writeDMR(dmrData, m_txStream);
+        m_dmrSeqNo++;
+    }
+
+    // send DMR voice
+    DataType::E dataType = BridgeCodec::buildDMRVoice(m_ambeBuffer, m_dmrN, m_dmrEmbeddedData, data);
+
+    // generate DMR network frame
+    data::NetData dmrData;
+    dmrData.setSlotNo(m_slot);
+    dmrData.setDataType(dataType);
+    dmrData.setSrcId(m_txSrcId);
+    dmrData.setDstId(m_dstId);
+    dmrData.setFLCO(FLCO::GROUP);
+    dmrData.setN(m_dmrN);
+    dmrData.setSeqNo(m_dmrSeqNo);
+    dmrData.setBER(0U);
+    dmrData.setRSSI(0U);
+    dmrData.setData(data);
+
+    m_network->writeDMR(dmrData, m_txStream);
+
+    m_dmrSeqNo++;
+    ::memset(m_ambeBuffer, 0x00U, 27U);
+    m_ambeCount = 0U;
+}
+
+/* Helper to encode P25 audio frames. */
+
+void BridgeStream::encodeP25AudioFrame(short* samples)
+{
+    using namespace p25;
+    using namespace p25::defines;
+
+    if (m_p25N > 17)
+        m_p25N = 0;
+    if (m_p25N == 0)
+        ::memset(m_netLDU1, 0x00U, 9U * 25U);
+    if (m_p25N == 9)
+        ::memset(m_netLDU2, 0x00U, 9U * 25U);
+
+    // encode PCM samples into IMBE codewords, filling the LDU buffers appropriately
+    uint8_t* ldu = (m_p25N < 9U) ? m_netLDU1 : m_netLDU2;
+    m_encoder->encode(samples, ldu + BridgeCodec::LDU_IMBE_OFFSET[m_p25N % 9U]);
+
+    if (m_p25N == 8U || m_p25N == 17U) {
+        lc::LC lc = BridgeCodec::createP25GroupLC(m_txSrcId, m_dstId);
+
+        data::LowSpeedData lsd = data::LowSpeedData();
+
+        std::lock_guard<std::mutex> lock(m_networkMutex);
+        if (m_p25N == 8U)
+            m_network->writeP25LDU1(lc, lsd, m_netLDU1, FrameType::HDU_VALID, m_txStream);
+        else
+            m_network->writeP25LDU2(lc, lsd, m_netLDU2, m_txStream);
+    }
+
+    m_p25N++;
+}
+
+/* Helper to end a call received from UDP. */
+
+void BridgeStream::txCallEnd()
+{
+    uint64_t diff = nowMS() - m_txStartTime;
+    LogMessage(LOG_HOST, "%s, call end, srcId = %u, dstId = %u, dur = %us, late frames = %u, max latency = %ums", UDP_CALL,
+        m_txSrcId, m_dstId, (uint32_t)(diff / 1000U), m_framesLate, (uint32_t)m_maxLatency);
+
+    m_audioDetect = false;
+    m_dropTime.stop();
+
+    {
+        std::lock_guard<std::mutex> lock(m_networkMutex);
+        switch (m_txMode) {
+        case TX_MODE_DMR:
+        {
+            dmr::data::NetData data = dmr::data::NetData();
+            data.setSlotNo(m_slot);
+            data.setDataType(dmr::defines::DataType::TERMINATOR_WITH_LC);
+            data.setDstId(m_dstId);
+            data.setSrcId(m_txSrcId);
+
+            m_network->writeDMRTerminator(data, &m_dmrSeqNo, &m_dmrN, m_dmrEmbeddedData, &m_txStream);
+        }
+        break;
+        case TX_MODE_P25:
+        {
+            p25::lc::LC lc = p25::lc::LC();
+            lc.setLCO(p25::defines::LCO::GROUP);
+            lc.setDstId(m_dstId);
+            lc.setSrcId(m_txSrcId);
+
+            p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
+
+            m_network->writeP25TDU(lc, lsd, 0x00U, m_txStream);
+        }
+        break;
+        }
+    }
+
+    m_txStream.reset();
+    m_txSrcId = 0U;
+    m_txStartTime = 0U;
+
+    m_ambeCount = 0U;
+    ::memset(m_ambeBuffer, 0x00U, 27U);
+    m_dmrSeqNo = 0U;
+    m_dmrN = 0U;
+    m_p25N = 0U;
+}
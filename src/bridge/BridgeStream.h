@@ -0,0 +1,296 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file BridgeStream.h
+ * @ingroup bridge
+ * @file BridgeStream.cpp
+ * @ingroup bridge
+ */
+#if !defined(__BRIDGE_STREAM_H__)
+#define __BRIDGE_STREAM_H__
+
+#include "Defines.h"
+#include "common/dmr/data/EmbeddedData.h"
+#include "common/network/udp/Socket.h"
+#include "common/Timer.h"
+#include "vocoder/MBEDecoder.h"
+#include "vocoder/MBEEncoder.h"
+#include "network/PeerNetwork.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define STREAM_FRAME_DEADLINE_MS 20U
+#define STREAM_MAX_QUEUED_FRAMES 64U
+#define STREAM_RX_CALL_TIMEOUT_MS 1000U
+
+// ---------------------------------------------------------------------------
+//  Class Prototypes
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API StreamScheduler;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a single talkgroup transcoding stream of a multi-stream bridge.
+ *
+ *  Each stream owns its own vocoder state and call state. Network frames and PCM audio are
+ *  queued by the network and UDP threads and transcoded by a StreamScheduler worker; every
+ *  queued frame carries a 20ms deadline which is tracked per stream.
+ * @ingroup bridge
+ */
+class HOST_SW_API BridgeStream {
+public:
+    /**
+     * @brief Initializes a new instance of the BridgeStream class.
+     * @param network Instance of the PeerNetwork class.
+     * @param networkMutex Mutex serializing access to the peer network.
+     * @param txMode Digital mode (DMR or P25).
+     * @param srcId Default source ID for transmitted audio frames.
+     * @param dstId Talkgroup ID for transmitted/received audio frames.
+     * @param slot DMR slot for transmitted/received audio frames.
+     */
+    BridgeStream(network::PeerNetwork* network, std::mutex& networkMutex, uint8_t txMode, uint32_t srcId, uint32_t dstId, uint8_t slot);
+    /**
+     * @brief Finalizes a instance of the BridgeStream class.
+     */
+    ~BridgeStream();
+
+    /**
+     * @brief Sets the audio gain options.
+     * @param rxAudioGain PCM gain applied to decoded audio.
+     * @param vocoderDecoderAudioGain Vocoder decoder gain.
+     * @param vocoderDecoderAutoGain Flag indicating decoder AGC is enabled.
+     * @param txAudioGain PCM gain applied to audio before encoding.
+     * @param vocoderEncoderAudioGain Vocoder encoder gain.
+     */
+    void setAudioGain(float rxAudioGain, float vocoderDecoderAudioGain, bool vocoderDecoderAutoGain, float txAudioGain, float vocoderEncoderAudioGain);
+    /**
+     * @brief Sets the call options.
+     * @param dropTimeMS Amount of time (ms) from loss of UDP audio to end the call.
+     * @param grantDemand Flag indicating a grant demand is sent before audio.
+     * @param overrideSrcIdFromUDP Flag indicating the UDP source ID overrides the default source ID.
+     */
+    void setCallOptions(uint16_t dropTimeMS, bool grantDemand, bool overrideSrcIdFromUDP);
+    /**
+     * @brief Sets the UDP audio options.
+     * @param socket UDP socket used to send audio (and, if owned, to receive audio).
+     * @param ownsSocket Flag indicating the socket belongs to (and is read for) this stream only.
+     * @param sendAddress UDP audio send address.
+     * @param sendPort UDP audio send port.
+     * @param metadata Flag indicating source/destination metadata is appended to UDP audio.
+     */
+    void setUDP(network::udp::Socket* socket, bool ownsSocket, const std::string& sendAddress, uint16_t sendPort, bool metadata);
+
+    /**
+     * @brief Initializes the stream vocoders and UDP endpoint.
+     * @returns bool True, if the stream was initialized, otherwise false.
+     */
+    bool open();
+    /**
+     * @brief Closes the stream, ending any active call.
+     */
+    void close();
+
+    /**
+     * @brief Queues a network frame for this stream. (Network thread.)
+     * @param[in] buffer Network frame.
+     * @param length Length of network frame.
+     * @returns bool True, if the frame was queued, otherwise false.
+     */
+    bool writeNetwork(const uint8_t* buffer, uint32_t length);
+    /**
+     * @brief Queues a PCM audio frame received over UDP for this stream. (UDP thread.)
+     * @param[in] pcm PCM audio frame (MBE_SAMPLES_LENGTH 16-bit little-endian samples).
+     * @param srcId Source ID carried in the UDP metadata (0 if none).
+     * @returns bool True, if the frame was queued, otherwise false.
+     */
+    bool writeAudio(const uint8_t* pcm, uint32_t srcId);
+
+    /**
+     * @brief Updates the stream call timers by the passed number of milliseconds. (Watchdog thread.)
+     * @param ms Number of milliseconds.
+     */
+    void clock(uint32_t ms);
+
+    /**
+     * @brief Transcodes all queued frames. (Scheduler worker.)
+     */
+    void process();
+
+    /**
+     * @brief Helper to determine whether the stream has queued frames.
+     * @returns bool True, if frames are queued, otherwise false.
+     */
+    bool hasPendingFrames();
+    /**
+     * @brief Gets the deadline (ms) of the oldest queued frame.
+     * @returns uint64_t Deadline of the oldest queued frame.
+     */
+    uint64_t nextDeadline();
+
+    /**
+     * @brief Destination ID of the stream.
+     */
+    __READONLY_PROPERTY_PLAIN(uint32_t, dstId);
+    /**
+     * @brief DMR slot of the stream.
+     */
+    __READONLY_PROPERTY_PLAIN(uint8_t, slot);
+    /**
+     * @brief UDP socket owned by this stream (nullptr if audio is multiplexed on a shared socket).
+     */
+    __READONLY_PROPERTY_PLAIN(network::udp::Socket*, ownedSocket);
+
+private:
+    friend class StreamScheduler;
+    std::atomic<bool> m_scheduled;
+
+    network::PeerNetwork* m_network;
+    std::mutex& m_networkMutex;
+
+    uint8_t m_txMode;
+    uint32_t m_srcId;
+
+    float m_rxAudioGain;
+    float m_vocoderDecoderAudioGain;
+    bool m_vocoderDecoderAutoGain;
+    float m_txAudioGain;
+    float m_vocoderEncoderAudioGain;
+
+    uint16_t m_dropTimeMS;
+    bool m_grantDemand;
+    bool m_overrideSrcIdFromUDP;
+
+    network::udp::Socket* m_udpSocket;
+    std::string m_udpSendAddress;
+    uint16_t m_udpSendPort;
+    bool m_udpMetadata;
+    sockaddr_storage m_udpAddr;
+    uint32_t m_udpAddrLen;
+    bool m_udpAddrValid;
+
+    vocoder::MBEDecoder* m_decoder;
+    vocoder::MBEEncoder* m_encoder;
+
+    /**
+     * @brief Represents a frame queued for transcoding.
+     */
+    struct StreamFrame {
+        bool network;                       //! Flag indicating a network frame (otherwise PCM audio).
+        UInt8Array data;                    //! Frame data.
+        uint32_t length;                    //! Length of frame data.
+        uint32_t srcId;                     //! UDP source ID (PCM audio only).
+        uint64_t deadline;                  //! Time (ms) by which the frame should be transcoded.
+    };
+
+    std::mutex m_queueMutex;
+    std::deque<StreamFrame> m_frames;
+
+    // call state is touched by the worker holding the stream and the watchdog thread
+    std::mutex m_stateMutex;
+
+    // network -> UDP
+    bool m_callInProgress;
+    bool m_ignoreCall;
+    uint8_t m_callAlgoId;
+    uint32_t m_rxSrcId;
+    uint64_t m_rxStartTime;
+    uint32_t m_rxIdleMS;
+
+    // UDP -> network
+    bool m_audioDetect;
+    uint32_t m_txSrcId;
+    uint64_t m_txStartTime;
+    Timer m_dropTime;
+    network::CallStream m_txStream;
+
+    dmr::data::EmbeddedData m_dmrEmbeddedData;
+    uint8_t* m_ambeBuffer;
+    uint32_t m_ambeCount;
+    uint32_t m_dmrSeqNo;
+    uint8_t m_dmrN;
+
+    uint8_t* m_netLDU1;
+    uint8_t* m_netLDU2;
+    uint8_t m_p25N;
+
+    uint32_t m_framesLate;
+    uint32_t m_framesDropped;
+    uint64_t m_maxLatency;
+
+    /**
+     * @brief Helper to queue a frame for transcoding.
+     * @param frame Frame to queue.
+     * @returns bool True, if the frame was queued, otherwise false.
+     */
+    bool queueFrame(StreamFrame& frame);
+
+    /**
+     * @brief Helper to process DMR network traffic.
+     * @param buffer Network frame.
+     * @param length Length of network frame.
+     */
+    void processDMRNetwork(uint8_t* buffer, uint32_t length);
+    /**
+     * @brief Helper to process P25 network traffic.
+     * @param buffer Network frame.
+     * @param length Length of network frame.
+     */
+    void processP25Network(uint8_t* buffer, uint32_t length);
+    /**
+     * @brief Helper to start a call received from the network.
+     * @param srcId Source ID.
+     */
+    void rxCallStart(uint32_t srcId);
+    /**
+     * @brief Helper to end a call received from the network.
+     * @param reason Textual reason for the call end.
+     */
+    void rxCallEnd(const char* reason);
+    /**
+     * @brief Helper to decode an MBE codeword and write the PCM audio to UDP.
+     * @param codeword MBE codeword.
+     * @param srcId Source ID.
+     */
+    void decodeAudioFrame(uint8_t* codeword, uint32_t srcId);
+
+    /**
+     * @brief Helper to process a PCM audio frame received over UDP.
+     * @param pcm PCM audio frame.
+     * @param srcId Source ID carried in the UDP metadata.
+     */
+    void processAudio(const uint8_t* pcm, uint32_t srcId);
+    /**
+     * @brief Helper to encode DMR audio frames.
+     * @param samples PCM samples.
+     */
+    void encodeDMRAudioFrame(short* samples);
+    /**
+     * @brief Helper to encode P25 audio frames.
+     * @param samples PCM samples.
+     */
+    void encodeP25AudioFrame(short* samples);
+    /**
+     * @brief Helper to end a call received from UDP.
+     */
+    void txCallEnd();
+};
+
+#endif // __BRIDGE_STREAM_H__
@@ -25,6 +25,7 @@
 #include "common/Thread.h"
 #include "common/Utils.h"
 #include "bridge/ActivityLog.h"
+#include "BridgeCodec.h"
 #include "HostBridge.h"
 #include "BridgeMain.h"
 #include "SampleTimeConversion.h"
@@ -48,6 +49,11 @@ using namespace network::udp;
 
 #define IDLE_WARMUP_MS 5U
 
+// maximum time the encoder and decoder stages wait for work before re-checking state (one audio frame)
+#define PIPELINE_STAGE_WAIT_MS 20U
+// maximum time the main loop waits for network or UDP audio data before clocking the network
+#define MAIN_LOOP_WAIT_MS 10U
+
 const int SAMPLE_RATE = 8000;
 const int BITS_PER_SECOND = 16;
 const int NUMBER_OF_BUFFERS = 32;
@@ -66,6 +72,13 @@ std::mutex HostBridge::m_networkMutex;
 //  Global Functions
 // ---------------------------------------------------------------------------
 
+/* Helper to generate the transcoding stream lookup key for the given talkgroup and slot. */
+
+static uint32_t streamKey(uint32_t dstId, uint8_t slot)
+{
+    return (dstId << 1) | ((slot == 2U) ? 1U : 0U);
+}
+
 /* Helper callback, called when audio data is available. */
 
 void audioCallback(ma_device* device, void* output, const void* input, ma_uint32 frameCount)
@@ -74,33 +87,38 @@ void audioCallback(ma_device* device, void* output, const void* input, ma_uint32
     if (!bridge->m_running)
         return;
 
-    ma_uint32 pcmBytes = frameCount * ma_get_bytes_per_frame(device->capture.format, device->capture.channels);
+    // the device period is one audio frame; never touch more than that
+    if (frameCount > MBE_SAMPLES_LENGTH)
+        frameCount = MBE_SAMPLES_LENGTH;
+
+    // this runs on the audio device thread; it must never block, so frames are handed to and
+    // from the encoder/decoder stages through lock-free queues
 
     // capture input audio
     if (frameCount > 0U) {
-        std::lock_guard<std::mutex> lock(HostBridge::m_audioMutex);
+        AudioFrame frame;
+        ::memset(frame.samples, 0x00U, sizeof(frame.samples));
+        frame.timestamp = LatencyStats::now();
 
-        int smpIdx = 0;
-        short samples[MBE_SAMPLES_LENGTH];
         const uint8_t* pcm = (const uint8_t*)input;
-        for (uint32_t pcmIdx = 0; pcmIdx < pcmBytes; pcmIdx += 2) {
-            samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-            smpIdx++;
+        for (uint32_t smpIdx = 0; smpIdx < frameCount; smpIdx++) {
+            frame.samples[smpIdx] = (short)((pcm[(smpIdx * 2U) + 1U] << 8) + pcm[(smpIdx * 2U) + 0U]);
         }
 
-        bridge->m_inputAudio.addData(samples, MBE_SAMPLES_LENGTH);
+        // if the encoder has fallen a full buffer behind, the frame is dropped
+        if (bridge->m_inputAudio.push(frame))
+            bridge->m_inputAudioCond.notify_one();
     }
 
     // playback output audio
-    if (bridge->m_outputAudio.dataSize() >= MBE_SAMPLES_LENGTH) {
-        short samples[MBE_SAMPLES_LENGTH];
-        bridge->m_outputAudio.get(samples, MBE_SAMPLES_LENGTH);
+    AudioFrame frame;
+    if (bridge->m_outputAudio.pop(frame)) {
+        bridge->m_playoutLatency.recordSince(frame.timestamp);
+
         uint8_t* pcm = (uint8_t*)output;
-        int pcmIdx = 0;
-        for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-            pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-            pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-            pcmIdx += 2;
+        for (uint32_t smpIdx = 0; smpIdx < frameCount; smpIdx++) {
+            pcm[(smpIdx * 2U) + 0U] = (uint8_t)(frame.samples[smpIdx] & 0xFF);
+            pcm[(smpIdx * 2U) + 1U] = (uint8_t)((frame.samples[smpIdx] >> 8) & 0xFF);
         }
     }
 }
@@ -179,8 +197,18 @@ HostBridge::HostBridge(const std::string& confFile) :
     m_maCaptureDevices(nullptr),
     m_maDeviceConfig(),
     m_maDevice(),
-    m_inputAudio(MBE_SAMPLES_LENGTH * NUMBER_OF_BUFFERS, "Input Audio Buffer"),
-    m_outputAudio(MBE_SAMPLES_LENGTH * NUMBER_OF_BUFFERS, "Output Audio Buffer"),
+    m_inputAudio(NUMBER_OF_BUFFERS, "Input Audio Buffer"),
+    m_inputAudioMutex(),
+    m_inputAudioCond(),
+    m_outputAudio(NUMBER_OF_BUFFERS, "Output Audio Buffer"),
+    m_networkRxMutex(),
+    m_networkRxCond(),
+    m_networkRxReadyTime(0U),
+    m_captureLatency("Capture -> encode"),
+    m_encodeLatency("Encode"),
+    m_networkRxLatency("Network -> decode"),
+    m_decodeLatency("Decode"),
+    m_playoutLatency("Decode -> playout"),
     m_decoder(nullptr),
     m_encoder(nullptr),
     m_mdcDecoder(nullptr),
@@ -208,6 +236,10 @@ HostBridge::HostBridge(const std::string& confFile) :
     m_txStreamId(0U),
     m_detectedSampleCnt(0U),
     m_dumpSampleLevel(false),
+    m_streams(),
+    m_scheduler(nullptr),
+    m_udpMultiplex(false),
+    m_streamWorkers(0U),
     m_running(false),
     m_debug(false)
 #if defined(_WIN32)
@@ -351,6 +383,11 @@ int HostBridge::run()
     if (!ret)
         return EXIT_FAILURE;
 
+    // initialize multi-stream transcoding
+    ret = createStreams();
+    if (!ret)
+        return EXIT_FAILURE;
+
     ma_result result;
     if (m_localAudio) {
         // initialize audio devices
@@ -477,6 +514,19 @@ int HostBridge::run()
 
     m_running = true;
 
+    // wake the pipeline stages waiting for the bridge to come up
+    m_inputAudioCond.notify_all();
+    m_networkRxCond.notify_all();
+
+    // sockets the main loop blocks on between network clocks
+    std::vector<Socket*> waitSockets;
+    if (m_udpAudioSocket != nullptr)
+        waitSockets.push_back(m_udpAudioSocket);
+    for (auto& entry : m_streams) {
+        if (entry.second->ownedSocket() != nullptr)
+            waitSockets.push_back(entry.second->ownedSocket());
+    }
+
     StopWatch stopWatch;
     stopWatch.start();
 
@@ -514,15 +564,56 @@ int HostBridge::run()
         {
             std::lock_guard<std::mutex> lock(HostBridge::m_networkMutex);
             m_network->clock(ms);
+
+            // wake the decoder stage if frames were received
+            if (m_network->hasDMRData() || m_network->hasP25Data()) {
+                {
+                    std::lock_guard<std::mutex> rxLock(m_networkRxMutex);
+                    if (m_networkRxReadyTime == 0U)
+                        m_networkRxReadyTime = LatencyStats::now();
+                }
+                m_networkRxCond.notify_one();
+            }
         }
 
-        if (m_udpAudio && m_udpAudioSocket != nullptr)
-            processUDPAudio();
+        if (!m_streams.empty()) {
+            if (m_udpMultiplex) {
+                if (m_udpAudioSocket != nullptr)
+                    processStreamUDPAudio(m_udpAudioSocket, nullptr);
+            }
+            else {
+                for (auto& entry : m_streams) {
+                    if (entry.second->ownedSocket() != nullptr)
+                        processStreamUDPAudio(entry.second->ownedSocket(), entry.second);
+                }
+            }
+        }
+        else {
+            if (m_udpAudio && m_udpAudioSocket != nullptr)
+                processUDPAudio();
+        }
+
+        // block until peer or UDP audio traffic arrives, or the network timers need clocking; the
+        // peer socket isn't read while waiting to connect, so it isn't waited on then either
+        Socket* networkSocket = nullptr;
+        if (m_network != nullptr && m_network->getStatus() != NET_STAT_WAITING_CONNECT)
+            networkSocket = m_network->socket();
 
-        if (ms < 2U)
+        waitSockets.push_back(networkSocket);
+        int waitRet = Socket::wait(waitSockets, MAIN_LOOP_WAIT_MS);
+        waitSockets.pop_back();
+
+        if (waitRet < 0)
             Thread::sleep(1U);
     }
 
+    // wake the pipeline stages so they see the shutdown
+    m_inputAudioCond.notify_all();
+    m_networkRxCond.notify_all();
+
+    // streams may still send call terminators, so close them before the network
+    destroyStreams();
+
     ::LogSetNetwork(nullptr);
     if (m_network != nullptr) {
         m_network->close();
@@ -823,9 +914,18 @@ bool HostBridge::readParams()
 
     m_localAudio = systemConf["localAudio"].as<bool>(true);
 
+    m_streamWorkers = systemConf["streamWorkers"].as<uint32_t>(0U);
+
     yaml::Node networkConf = m_conf["network"];
     m_udpAudio = networkConf["udpAudio"].as<bool>(false);
 
+    // multi-stream transcoding is UDP only
+    yaml::Node streamList = m_conf["streams"];
+    if (streamList.size() > 0U && m_localAudio) {
+        LogWarning(LOG_HOST, "Local audio is not supported with multiple transcoding streams, disabling local audio.");
+        m_localAudio = false;
+    }
+
     LogInfo("General Parameters");
     LogInfo("    Rx Audio Gain: %.1f", m_rxAudioGain);
     LogInfo("    Vocoder Decoder Audio Gain: %.1f", m_vocoderDecoderAudioGain);
@@ -843,6 +943,12 @@ bool HostBridge::readParams()
     LogInfo("    Grant Demands: %s", m_grantDemand ? "yes" : "no");
     LogInfo("    Local Audio: %s", m_localAudio ? "yes" : "no");
     LogInfo("    UDP Audio: %s", m_udpAudio ? "yes" : "no");
+    if (streamList.size() > 0U) {
+        if (m_streamWorkers > 0U)
+            LogInfo("    Stream Workers: %u", m_streamWorkers);
+        else
+            LogInfo("    Stream Workers: auto");
+    }
 
     return true;
 }
@@ -863,6 +969,7 @@ bool HostBridge::createNetwork()
 
     m_udpAudio = networkConf["udpAudio"].as<bool>(false);
     m_udpMetadata = networkConf["udpMetadata"].as<bool>(false);
+    m_udpMultiplex = networkConf["udpMultiplex"].as<bool>(false);
     m_udpSendPort = (uint16_t)networkConf["udpSendPort"].as<uint32_t>(34001);
     m_udpSendAddress = networkConf["udpSendAddress"].as<std::string>();
     m_udpReceivePort = (uint16_t)networkConf["udpReceivePort"].as<uint32_t>(34001);
@@ -925,6 +1032,7 @@ bool HostBridge::createNetwork()
     LogInfo("    PCM over UDP Audio: %s", m_udpAudio ? "yes" : "no");
     if (m_udpAudio) {
         LogInfo("    UDP Audio Metadata: %s", m_udpMetadata ? "yes" : "no");
+        LogInfo("    UDP Audio Multiplexed: %s", m_udpMultiplex ? "yes" : "no");
         LogInfo("    UDP Audio Send Address: %s", m_udpSendAddress.c_str());
         LogInfo("    UDP Audio Send Port: %u", m_udpSendPort);
         LogInfo("    UDP Audio Receive Address: %s", m_udpReceiveAddress.c_str());
@@ -980,6 +1088,120 @@ bool HostBridge::createNetwork()
     return true;
 }
 
+/* Initializes the multi-stream transcoding streams. */
+
+bool HostBridge::createStreams()
+{
+    yaml::Node streamList = m_conf["streams"];
+    if (streamList.size() == 0U)
+        return true;
+
+    if (!m_udpAudio) {
+        ::LogError(LOG_HOST, "Multiple transcoding streams require UDP audio!");
+        return false;
+    }
+
+    if (m_udpMultiplex && !m_udpMetadata) {
+        ::LogError(LOG_HOST, "Multiplexed UDP audio requires UDP audio metadata to identify streams!");
+        return false;
+    }
+
+    // unless audio is multiplexed, each stream reads audio from its own socket
+    if (!m_udpMultiplex && m_udpAudioSocket != nullptr) {
+        m_udpAudioSocket->close();
+        delete m_udpAudioSocket;
+        m_udpAudioSocket = nullptr;
+    }
+
+    LogInfo("Transcoding Streams");
+    for (size_t i = 0; i < streamList.size(); i++) {
+        yaml::Node& streamConf = streamList[i];
+
+        uint32_t dstId = streamConf["destinationId"].as<uint32_t>(0U);
+        uint8_t slot = (uint8_t)streamConf["slot"].as<uint32_t>(m_slot);
+        if (dstId == 0U) {
+            ::LogError(LOG_HOST, "Transcoding stream %zu has no destination ID!", i);
+            destroyStreams();
+            return false;
+        }
+
+        if (slot < 1U || slot > 2U) {
+            ::LogError(LOG_HOST, "Transcoding stream %zu has an invalid DMR slot!", i);
+            destroyStreams();
+            return false;
+        }
+
+        if (m_txMode == TX_MODE_P25)
+            slot = 1U;
+
+        if (findStream(dstId, slot) != nullptr) {
+            ::LogError(LOG_HOST, "Transcoding stream %zu duplicates destination ID %u!", i, dstId);
+            destroyStreams();
+            return false;
+        }
+
+        uint32_t srcId = streamConf["sourceId"].as<uint32_t>(m_srcId);
+
+        float rxAudioGain = streamConf["rxAudioGain"].as<float>(m_rxAudioGain);
+        float vocoderDecoderAudioGain = streamConf["vocoderDecoderAudioGain"].as<float>(m_vocoderDecoderAudioGain);
+        bool vocoderDecoderAutoGain = streamConf["vocoderDecoderAutoGain"].as<bool>(m_vocoderDecoderAutoGain);
+        float txAudioGain = streamConf["txAudioGain"].as<float>(m_txAudioGain);
+        float vocoderEncoderAudioGain = streamConf["vocoderEncoderAudioGain"].as<float>(m_vocoderEncoderAudioGain);
+
+        std::string sendAddress = streamConf["udpSendAddress"].as<std::string>(m_udpSendAddress);
+        uint16_t sendPort = (uint16_t)streamConf["udpSendPort"].as<uint32_t>(m_udpSendPort);
+        std::string receiveAddress = streamConf["udpReceiveAddress"].as<std::string>(m_udpReceiveAddress);
+        uint16_t receivePort = (uint16_t)streamConf["udpReceivePort"].as<uint32_t>(m_udpReceivePort);
+
+        BridgeStream* stream = new BridgeStream(m_network, HostBridge::m_networkMutex, m_txMode, srcId, dstId, slot);
+        stream->setAudioGain(rxAudioGain, vocoderDecoderAudioGain, vocoderDecoderAutoGain, txAudioGain, vocoderEncoderAudioGain);
+        stream->setCallOptions(m_dropTimeMS, m_grantDemand, m_overrideSrcIdFromUDP);
+        if (m_udpMultiplex)
+            stream->setUDP(m_udpAudioSocket, false, sendAddress, sendPort, true);
+        else
+            stream->setUDP(new Socket(receiveAddress, receivePort), true, sendAddress, sendPort, m_udpMetadata);
+
+        m_streams[streamKey(dstId, slot)] = stream;
+        if (!stream->open()) {
+            destroyStreams();
+            return false;
+        }
+
+        if (m_udpMultiplex)
+            LogInfo("    TG %u (Slot %u): Source ID %u, UDP Send %s:%u", dstId, slot, srcId, sendAddress.c_str(), sendPort);
+        else
+            LogInfo("    TG %u (Slot %u): Source ID %u, UDP Send %s:%u, UDP Receive %s:%u", dstId, slot, srcId, sendAddress.c_str(), sendPort,
+                receiveAddress.c_str(), receivePort);
+    }
+
+    m_scheduler = new StreamScheduler(m_streamWorkers);
+    LogInfo("    Workers: %u", m_scheduler->workers());
+
+    if (!m_scheduler->start()) {
+        destroyStreams();
+        return false;
+    }
+
+    return true;
+}
+
+/* Stops the stream scheduler and releases the multi-stream transcoding streams. */
+
+void HostBridge::destroyStreams()
+{
+    if (m_scheduler != nullptr) {
+        m_scheduler->stop();
+        delete m_scheduler;
+        m_scheduler = nullptr;
+    }
+
+    for (auto& entry : m_streams) {
+        entry.second->close();
+        delete entry.second;
+    }
+    m_streams.clear();
+}
+
 /* Helper to process UDP audio. */
 
 void HostBridge::processUDPAudio()
@@ -1021,17 +1243,9 @@ void HostBridge::processUDPAudio()
 
         m_udpDstId = m_dstId;
 
+        // UDP audio is encoded directly here; the capture queue belongs to the audio device alone
         std::lock_guard<std::mutex> lock(m_audioMutex);
 
-        int smpIdx = 0;
-        short samples[MBE_SAMPLES_LENGTH];
-        for (uint32_t pcmIdx = 0; pcmIdx < pcmLength; pcmIdx += 2) {
-            samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-            smpIdx++;
-        }
-
-        m_inputAudio.addData(samples, MBE_SAMPLES_LENGTH);
-
         m_trafficFromUDP = true;
 
         // force start a call if one isn't already in progress
@@ -1081,6 +1295,64 @@ void HostBridge::processUDPAudio()
     }
 }
 
+/* Helper to process UDP audio for the multi-stream transcoding streams. */
+
+void HostBridge::processStreamUDPAudio(Socket* socket, BridgeStream* owner)
+{
+    assert(socket != nullptr);
+
+    sockaddr_storage addr;
+    uint32_t addrLen;
+
+    // drain every waiting datagram; all streams share this loop
+    uint8_t buffer[DATA_PACKET_LENGTH];
+    while (true) {
+        int length = socket->read(buffer, DATA_PACKET_LENGTH, addr, addrLen);
+        if (length <= 0)
+            return;
+
+        if (m_debug)
+            Utils::dump(1U, "UDP Audio Network Packet", buffer, length);
+
+        uint32_t pcmLength = __GET_UINT32(buffer, 0U);
+        if (pcmLength != (MBE_SAMPLES_LENGTH * 2U) || (uint32_t)length < pcmLength + 4U)
+            continue;
+
+        uint32_t dstId = 0U, srcId = 0U;
+        bool metadata = (uint32_t)length >= pcmLength + 12U;
+        if (metadata) {
+            dstId = __GET_UINT32(buffer, pcmLength + 4U);
+            srcId = __GET_UINT32(buffer, pcmLength + 8U);
+        }
+
+        BridgeStream* stream = owner;
+        if (stream == nullptr) {
+            if (!metadata)
+                continue;
+
+            // the UDP metadata carries no slot; prefer slot 1 if a talkgroup is bridged on both
+            stream = findStream(dstId, 1U);
+            if (stream == nullptr)
+                stream = findStream(dstId, 2U);
+            if (stream == nullptr)
+                continue;
+        }
+
+        stream->writeAudio(buffer + 4U, srcId);
+        m_scheduler->schedule(stream);
+    }
+}
+
+/* Helper to find the transcoding stream for the given talkgroup. */
+
+BridgeStream* HostBridge::findStream(uint32_t dstId, uint8_t slot)
+{
+    auto it = m_streams.find(streamKey(dstId, slot));
+    if (it == m_streams.end())
+        return nullptr;
+    return it->second;
+}
+
 /* Helper to process DMR network traffic. */
 
 void HostBridge::processDMRNetwork(uint8_t* buffer, uint32_t length)
@@ -1208,6 +1480,7 @@ void HostBridge::processDMRNetwork(uint8_t* buffer, uint32_t length)
                 uint64_t diff = now - m_rxStartTime;
 
                 LogMessage(LOG_HOST, "DMR, call end, srcId = %u, dstId = %u, dur = %us", srcId, dstId, diff / 1000U);
+                logLatency();
             }
             
             m_rxDMRLC = lc::LC();
@@ -1282,54 +1555,19 @@ void HostBridge::decodeDMRAudioFrame(uint8_t* ambe, uint32_t srcId, uint32_t dst
             LogMessage(LOG_HOST, DMR_DT_VOICE ", Frame, VC%u.%u, srcId = %u, dstId = %u, errs = %u", dmrN, n, srcId, dstId, errs);
 
         // post-process: apply gain to decoded audio frames
-        if (m_rxAudioGain != 1.0f) {
-            for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-                short sample = samples[n];
-                float newSample = sample * m_rxAudioGain;
-                sample = (short)newSample;
-
-                // clip if necessary
-                if (m_rxAudioGain > 1.0f) {
-                    if (newSample > 32767)
-                        sample = 32767;
-                    else if (newSample < -32767)
-                        sample = -32767;
-                }
-
-                samples[n] = sample;
-            }
-        }
+        BridgeCodec::applyGain(samples, m_rxAudioGain);
 
         if (m_localAudio) {
-            m_outputAudio.addData(samples, MBE_SAMPLES_LENGTH);
+            AudioFrame frame;
+            ::memcpy(frame.samples, samples, sizeof(frame.samples));
+            frame.timestamp = LatencyStats::now();
+            if (!m_outputAudio.push(frame))
+                LogError(LOG_HOST, "**** Overflow in %s, audio frame dropped", m_outputAudio.name());
         }
 
         if (m_udpAudio) {
-            int pcmIdx = 0;
-            uint8_t pcm[MBE_SAMPLES_LENGTH * 2U];
-            for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-                pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-                pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-                pcmIdx += 2;
-            }
-
-            uint32_t length = (MBE_SAMPLES_LENGTH * 2U) + 4U;
-            uint8_t* audioData = nullptr;
-            if (!m_udpMetadata) {
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 4U]; // PCM + 4 bytes (PCM length)
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-            }
-            else {
-                length = (MBE_SAMPLES_LENGTH * 2U) + 12U;
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 12U]; // PCM + (4 bytes (PCM length) + 4 bytes (srcId) + 4 bytes (dstId))
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-
-                // embed destination and source IDs
-                __SET_UINT32(dstId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 4U));
-                __SET_UINT32(srcId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 8U));
-            }
+            uint8_t audioData[UDP_AUDIO_MAX_LENGTH];
+            uint32_t length = BridgeCodec::buildUDPAudio(samples, srcId, dstId, m_udpMetadata, audioData);
 
             sockaddr_storage addr;
             uint32_t addrLen;
@@ -1337,8 +1575,6 @@ void HostBridge::decodeDMRAudioFrame(uint8_t* ambe, uint32_t srcId, uint32_t dst
             if (udp::Socket::lookup(m_udpSendAddress, m_udpSendPort, addr, addrLen) == 0) {
                 m_udpAudioSocket->write(audioData, length, addr, addrLen);
             }
-
-            delete[] audioData;
         }
     }
 }
@@ -1362,28 +1598,13 @@ void HostBridge::encodeDMRAudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
     if (forcedDstId > 0 && forcedDstId != m_dstId)
         dstId = forcedDstId;
 
-    uint8_t* data = nullptr;
+    uint8_t data[DMR_FRAME_LENGTH_BYTES];
     m_dmrN = (uint8_t)(m_dmrSeqNo % 6);
     if (m_ambeCount == AMBE_PER_SLOT) {
         // is this the intitial sequence?
         if (m_dmrSeqNo == 0) {
             // send DMR voice header
-            data = new uint8_t[DMR_FRAME_LENGTH_BYTES];
-
-            // generate DMR LC
-            lc::LC dmrLC = lc::LC();
-            dmrLC.setFLCO(FLCO::GROUP);
-            dmrLC.setSrcId(srcId);
-            dmrLC.setDstId(dstId);
-            m_dmrEmbeddedData.setLC(dmrLC);
-
-            // generate the Slot TYpe
-            SlotType slotType = SlotType();
-            slotType.setDataType(DataType::VOICE_LC_HEADER);
-            slotType.encode(data);
-
-            lc::FullLC fullLC = lc::FullLC();
-            fullLC.encode(dmrLC, data, DataType::VOICE_LC_HEADER);
+            BridgeCodec::buildDMRVoiceHeader(srcId, dstId, m_dmrEmbeddedData, data);
 
             // generate DMR network frame
             data::NetData dmrData;
@@ -1403,31 +1624,10 @@ void HostBridge::encodeDMRAudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
             m_txStreamId = m_network->getDMRStreamId(m_slot);
 
             m_dmrSeqNo++;
-            delete[] data;
         }
 
         // send DMR voice
-        data = new uint8_t[DMR_FRAME_LENGTH_BYTES];
-
-        ::memcpy(data, m_ambeBuffer, 13U);
-        data[13U] = (uint8_t)(m_ambeBuffer[13U] & 0xF0);
-        data[19U] = (uint8_t)(m_ambeBuffer[13U] & 0x0F);
-        ::memcpy(data + 20U, m_ambeBuffer + 14U, 13U);
-
-        DataType::E dataType = DataType::VOICE_SYNC;
-        if (m_dmrN == 0)
-            dataType = DataType::VOICE_SYNC;
-        else {
-            dataType = DataType::VOICE;
-
-            uint8_t lcss = m_dmrEmbeddedData.getData(data, m_dmrN);
-
-            // generated embedded signalling
-            data::EMB emb = data::EMB();
-            emb.setColorCode(0U);
-            emb.setLCSS(lcss);
-            emb.encode(data);
-        }
+        DataType::E dataType = BridgeCodec::buildDMRVoice(m_ambeBuffer, m_dmrN, m_dmrEmbeddedData, data);
 
         LogMessage(LOG_HOST, DMR_DT_VOICE ", srcId = %u, dstId = %u, slot = %u, seqNo = %u", srcId, dstId, m_slot, m_dmrN);
 
@@ -1453,31 +1653,11 @@ void HostBridge::encodeDMRAudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
         m_ambeCount = 0U;
     }
 
-    int smpIdx = 0;
     short samples[MBE_SAMPLES_LENGTH];
-    for (uint32_t pcmIdx = 0; pcmIdx < (MBE_SAMPLES_LENGTH * 2U); pcmIdx += 2) {
-        samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-        smpIdx++;
-    }
+    BridgeCodec::pcmToSamples(pcm, samples);
 
     // pre-process: apply gain to PCM audio frames
-    if (m_txAudioGain != 1.0f) {
-        for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-            short sample = samples[n];
-            float newSample = sample * m_txAudioGain;
-            sample = (short)newSample;
-
-            // clip if necessary
-            if (m_txAudioGain > 1.0f) {
-                if (newSample > 32767)
-                    sample = 32767;
-                else if (newSample < -32767)
-                    sample = -32767;
-            }
-
-            samples[n] = sample;
-        }
-    }
+    BridgeCodec::applyGain(samples, m_txAudioGain);
 
     // encode PCM samples into AMBE codewords
     uint8_t ambe[RAW_AMBE_LENGTH_BYTES];
@@ -1609,6 +1789,7 @@ void HostBridge::processP25Network(uint8_t* buffer, uint32_t length)
                 uint64_t diff = now - m_rxStartTime;
 
                 LogMessage(LOG_HOST, "P25, call end, srcId = %u, dstId = %u, dur = %us", srcId, dstId, diff / 1000U);
+                logLatency();
             }
 
             m_rxP25LC = lc::LC();
@@ -1780,35 +1961,7 @@ void HostBridge::decodeP25AudioFrame(uint8_t* ldu, uint32_t srcId, uint32_t dstI
     // decode 9 IMBE codewords into PCM samples
     for (int n = 0; n < 9; n++) {
         uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
-        switch (n) {
-        case 0:
-            ::memcpy(imbe, ldu + 10U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 1:
-            ::memcpy(imbe, ldu + 26U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 2:
-            ::memcpy(imbe, ldu + 55U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 3:
-            ::memcpy(imbe, ldu + 80U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 4:
-            ::memcpy(imbe, ldu + 105U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 5:
-            ::memcpy(imbe, ldu + 130U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 6:
-            ::memcpy(imbe, ldu + 155U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 7:
-            ::memcpy(imbe, ldu + 180U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        case 8:
-            ::memcpy(imbe, ldu + 204U, RAW_IMBE_LENGTH_BYTES);
-            break;
-        }
+        ::memcpy(imbe, ldu + BridgeCodec::LDU_IMBE_OFFSET[n], RAW_IMBE_LENGTH_BYTES);
 
         // Utils::dump(1U, "IMBE", imbe, RAW_IMBE_LENGTH_BYTES);
 
@@ -1829,54 +1982,19 @@ void HostBridge::decodeP25AudioFrame(uint8_t* ldu, uint32_t srcId, uint32_t dstI
             LogDebug(LOG_HOST, "P25, LDU (Logical Link Data Unit), Frame, VC%u.%u, srcId = %u, dstId = %u, errs = %u", p25N, n, srcId, dstId, errs);
 
         // post-process: apply gain to decoded audio frames
-        if (m_rxAudioGain != 1.0f) {
-            for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-                short sample = samples[n];
-                float newSample = sample * m_rxAudioGain;
-                sample = (short)newSample;
-
-                // clip if necessary
-                if (m_rxAudioGain > 1.0f) {
-                    if (newSample > 32767)
-                        sample = 32767;
-                    else if (newSample < -32767)
-                        sample = -32767;
-                }
-
-                samples[n] = sample;
-            }
-        }
+        BridgeCodec::applyGain(samples, m_rxAudioGain);
 
         if (m_localAudio) {
-            m_outputAudio.addData(samples, MBE_SAMPLES_LENGTH);
+            AudioFrame frame;
+            ::memcpy(frame.samples, samples, sizeof(frame.samples));
+            frame.timestamp = LatencyStats::now();
+            if (!m_outputAudio.push(frame))
+                LogError(LOG_HOST, "**** Overflow in %s, audio frame dropped", m_outputAudio.name());
         }
 
         if (m_udpAudio) {
-            int pcmIdx = 0;
-            uint8_t pcm[MBE_SAMPLES_LENGTH * 2U];
-            for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-                pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-                pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-                pcmIdx += 2;
-            }
-
-            uint32_t length = (MBE_SAMPLES_LENGTH * 2U) + 4U;
-            uint8_t* audioData = nullptr;
-            if (!m_udpMetadata) {
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 4U]; // PCM + 4 bytes (PCM length)
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-            }
-            else {
-                length = (MBE_SAMPLES_LENGTH * 2U) + 12U;
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 12U]; // PCM + (4 bytes (PCM length) + 4 bytes (srcId) + 4 bytes (dstId))
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-
-                // embed destination and source IDs
-                __SET_UINT32(dstId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 4U));
-                __SET_UINT32(srcId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 8U));
-            }
+            uint8_t audioData[UDP_AUDIO_MAX_LENGTH];
+            uint32_t length = BridgeCodec::buildUDPAudio(samples, srcId, dstId, m_udpMetadata, audioData);
 
             sockaddr_storage addr;
             uint32_t addrLen;
@@ -1884,8 +2002,6 @@ void HostBridge::decodeP25AudioFrame(uint8_t* ldu, uint32_t srcId, uint32_t dstI
             if (udp::Socket::lookup(m_udpSendAddress, m_udpSendPort, addr, addrLen) == 0) {
                 m_udpAudioSocket->write(audioData, length, addr, addrLen);
             }
-
-            delete[] audioData;
         }
     }
 }
@@ -1905,31 +2021,11 @@ void HostBridge::encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
     if (m_p25N == 9)
         ::memset(m_netLDU2, 0x00U, 9U * 25U);
 
-    int smpIdx = 0;
     short samples[MBE_SAMPLES_LENGTH];
-    for (uint32_t pcmIdx = 0; pcmIdx < (MBE_SAMPLES_LENGTH * 2U); pcmIdx += 2) {
-        samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-        smpIdx++;
-    }
+    BridgeCodec::pcmToSamples(pcm, samples);
 
     // pre-process: apply gain to PCM audio frames
-    if (m_txAudioGain != 1.0f) {
-        for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-            short sample = samples[n];
-            float newSample = sample * m_txAudioGain;
-            sample = (short)newSample;
-
-            // clip if necessary
-            if (m_txAudioGain > 1.0f) {
-                if (newSample > 32767)
-                    sample = 32767;
-                else if (newSample < -32767)
-                    sample = -32767;
-            }
-
-            samples[n] = sample;
-        }
-    }
+    BridgeCodec::applyGain(samples, m_txAudioGain);
 
     // encode PCM samples into IMBE codewords
     uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
@@ -1948,65 +2044,8 @@ void HostBridge::encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
     // Utils::dump(1U, "Encoded IMBE", imbe, RAW_IMBE_LENGTH_BYTES);
 
     // fill the LDU buffers appropriately
-    switch (m_p25N) {
-    // LDU1
-    case 0:
-        ::memcpy(m_netLDU1 + 10U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 1:
-        ::memcpy(m_netLDU1 + 26U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 2:
-        ::memcpy(m_netLDU1 + 55U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 3:
-        ::memcpy(m_netLDU1 + 80U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 4:
-        ::memcpy(m_netLDU1 + 105U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 5:
-        ::memcpy(m_netLDU1 + 130U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 6:
-        ::memcpy(m_netLDU1 + 155U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 7:
-        ::memcpy(m_netLDU1 + 180U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 8:
-        ::memcpy(m_netLDU1 + 204U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-
-    // LDU2
-    case 9:
-        ::memcpy(m_netLDU2 + 10U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 10:
-        ::memcpy(m_netLDU2 + 26U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 11:
-        ::memcpy(m_netLDU2 + 55U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 12:
-        ::memcpy(m_netLDU2 + 80U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 13:
-        ::memcpy(m_netLDU2 + 105U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 14:
-        ::memcpy(m_netLDU2 + 130U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 15:
-        ::memcpy(m_netLDU2 + 155U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 16:
-        ::memcpy(m_netLDU2 + 180U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    case 17:
-        ::memcpy(m_netLDU2 + 204U, imbe, RAW_IMBE_LENGTH_BYTES);
-        break;
-    }
+    uint8_t* ldu = (m_p25N < 9U) ? m_netLDU1 : m_netLDU2;
+    ::memcpy(ldu + BridgeCodec::LDU_IMBE_OFFSET[m_p25N % 9U], imbe, RAW_IMBE_LENGTH_BYTES);
 
     uint32_t srcId = m_srcId;
     if (m_srcIdOverride != 0 && (m_overrideSrcIdFromMDC))
@@ -2019,13 +2058,7 @@ void HostBridge::encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
     if (forcedDstId > 0 && forcedDstId != m_dstId)
         dstId = forcedDstId;
 
-    lc::LC lc = lc::LC();
-    lc.setLCO(LCO::GROUP);
-    lc.setGroup(true);
-    lc.setPriority(4U);
-    lc.setDstId(dstId);
-    lc.setSrcId(srcId);
-
+    lc::LC lc = BridgeCodec::createP25GroupLC(srcId, dstId);
     data::LowSpeedData lsd = data::LowSpeedData();
 
     // send P25 LDU1
@@ -2049,10 +2082,11 @@ void HostBridge::encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
 
 void HostBridge::generatePreambleTone()
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
-
+    // the preamble is queued as whole audio frames (rounded up)
     uint64_t frameCount = SampleTimeConvert::ToSamples(SAMPLE_RATE, 1, m_preambleLength);
-    if (frameCount > m_outputAudio.freeSpace()) {
+    uint32_t audioFrames = (uint32_t)((frameCount + MBE_SAMPLES_LENGTH - 1U) / MBE_SAMPLES_LENGTH);
+    frameCount = audioFrames * MBE_SAMPLES_LENGTH;
+    if (audioFrames > m_outputAudio.capacity() - m_outputAudio.size()) {
         ::LogError(LOG_HOST, "failed to generate preamble tone");
         return;
     }
@@ -2072,7 +2106,24 @@ void HostBridge::generatePreambleTone()
         smpIdx++;
     }
 
-    m_outputAudio.addData(sineSamples, frameCount);
+    uint64_t now = LatencyStats::now();
+    for (uint32_t i = 0U; i < audioFrames; i++) {
+        AudioFrame frame;
+        ::memcpy(frame.samples, sineSamples + (i * MBE_SAMPLES_LENGTH), sizeof(frame.samples));
+        frame.timestamp = now;
+        m_outputAudio.push(frame);
+    }
+}
+
+/* Helper to write the audio pipeline latency statistics to the log. */
+
+void HostBridge::logLatency()
+{
+    m_captureLatency.logAndReset();
+    m_encodeLatency.logAndReset();
+    m_networkRxLatency.logAndReset();
+    m_decodeLatency.logAndReset();
+    m_playoutLatency.logAndReset();
 }
 
 /* Helper to end a local or UDP call. */
@@ -2086,6 +2137,7 @@ void HostBridge::callEnd(uint32_t srcId, uint32_t dstId)
     }
 
     LogMessage(LOG_HOST, "%s, call end, srcId = %u, dstId = %u", trafficType.c_str(), srcId, dstId);
+    logLatency();
 
     m_audioDetect = false;
     m_dropTime.stop();
@@ -2162,25 +2214,27 @@ void* HostBridge::threadAudioProcess(void* arg)
         ::pthread_setname_np(th->thread, threadName.c_str());
 #endif // _GNU_SOURCE
 
-        StopWatch stopWatch;
-        stopWatch.start();
-
         while (!g_killed) {
-            if (!bridge->m_running) {
-                Thread::sleep(1U);
-                continue;
+            // wait for the bridge to come up and the audio callback to deliver captured audio
+            {
+                std::unique_lock<std::mutex> lock(bridge->m_inputAudioMutex);
+                bridge->m_inputAudioCond.wait_for(lock, std::chrono::milliseconds(PIPELINE_STAGE_WAIT_MS),
+                    [bridge] { return (bridge->m_running && !bridge->m_inputAudio.isEmpty()) || g_killed; });
             }
 
-            uint32_t ms = stopWatch.elapsed();
-            stopWatch.start();
+            if (!bridge->m_running)
+                continue;
 
-            // scope is intentional
-            {
-                std::lock_guard<std::mutex> lock(m_audioMutex);
+            AudioFrame frame;
+            while (bridge->m_inputAudio.pop(frame)) {
+                bridge->m_captureLatency.recordSince(frame.timestamp);
+                uint64_t encodeStart = LatencyStats::now();
+
+                // scope is intentional
+                {
+                    std::lock_guard<std::mutex> lock(m_audioMutex);
 
-                if (bridge->m_inputAudio.dataSize() >= MBE_SAMPLES_LENGTH) {
-                    short samples[MBE_SAMPLES_LENGTH];
-                    bridge->m_inputAudio.get(samples, MBE_SAMPLES_LENGTH);
+                    short* samples = frame.samples;
 
                     // process MDC, if necessary
                     if (bridge->m_overrideSrcIdFromMDC)
@@ -2261,12 +2315,7 @@ void* HostBridge::threadAudioProcess(void* arg)
                         UInt8Array __pcm = std::make_unique<uint8_t[]>(pcmBytes);
                         uint8_t* pcm = __pcm.get();
 
-                        int pcmIdx = 0;
-                        for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-                            pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-                            pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-                            pcmIdx += 2;
-                        }
+                        BridgeCodec::samplesToPCM(samples, pcm);
 
                         switch (bridge->m_txMode)
                         {
@@ -2279,9 +2328,9 @@ void* HostBridge::threadAudioProcess(void* arg)
                         }
                     }
                 }
-            }
 
-            Thread::sleep(1U);
+                bridge->m_encodeLatency.recordSince(encodeStart);
+            }
         }
 
         LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
@@ -2320,37 +2369,79 @@ void* HostBridge::threadNetworkProcess(void* arg)
         ::pthread_setname_np(th->thread, threadName.c_str());
 #endif // _GNU_SOURCE
 
-        StopWatch stopWatch;
-        stopWatch.start();
-
         while (!g_killed) {
-            if (!bridge->m_running) {
-                Thread::sleep(1U);
-                continue;
+            // wait for the bridge to come up and the main loop to signal that network frames were received
+            uint64_t readyTime = 0U;
+            {
+                std::unique_lock<std::mutex> lock(bridge->m_networkRxMutex);
+                bridge->m_networkRxCond.wait_for(lock, std::chrono::milliseconds(PIPELINE_STAGE_WAIT_MS),
+                    [bridge] { return (bridge->m_running && bridge->m_networkRxReadyTime != 0U) || g_killed; });
+                readyTime = bridge->m_networkRxReadyTime;
+                bridge->m_networkRxReadyTime = 0U;
             }
 
-            uint32_t ms = stopWatch.elapsed();
-            stopWatch.start();
+            if (!bridge->m_running)
+                continue;
+
+            if (readyTime != 0U)
+                bridge->m_networkRxLatency.recordSince(readyTime);
 
             uint32_t length = 0U;
             bool netReadRet = false;
-            if (bridge->m_txMode == TX_MODE_DMR) {
-                std::lock_guard<std::mutex> lock(HostBridge::m_networkMutex);
-                UInt8Array dmrBuffer = bridge->m_network->readDMR(netReadRet, length);
-                if (netReadRet) {
-                    bridge->processDMRNetwork(dmrBuffer.get(), length);
-                }
+
+            // in multi-stream mode frames are only demultiplexed here, and transcoded by the stream workers
+            if (!bridge->m_streams.empty()) {
+                do {
+                    UInt8Array buffer;
+                    {
+                        std::lock_guard<std::mutex> lock(HostBridge::m_networkMutex);
+                        if (bridge->m_txMode == TX_MODE_DMR)
+                            buffer = bridge->m_network->readDMR(netReadRet, length);
+                        else
+                            buffer = bridge->m_network->readP25(netReadRet, length);
+                    }
+
+                    if (!netReadRet || length < 24U)
+                        break;
+
+                    uint32_t dstId = __GET_UINT16(buffer.get(), 8U);
+                    uint8_t slot = 1U;
+                    if (bridge->m_txMode == TX_MODE_DMR)
+                        slot = (buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
+
+                    BridgeStream* stream = bridge->findStream(dstId, slot);
+                    if (stream != nullptr) {
+                        stream->writeNetwork(buffer.get(), length);
+                        bridge->m_scheduler->schedule(stream);
+                    }
+                } while (netReadRet);
+
+                continue;
             }
 
-            if (bridge->m_txMode == TX_MODE_P25) {
-                std::lock_guard<std::mutex> lock(HostBridge::m_networkMutex);
-                UInt8Array p25Buffer = bridge->m_network->readP25(netReadRet, length);
-                if (netReadRet) {
-                    bridge->processP25Network(p25Buffer.get(), length);
+            // decode every frame received
+            do {
+                uint64_t decodeStart = LatencyStats::now();
+
+                if (bridge->m_txMode == TX_MODE_DMR) {
+                    std::lock_guard<std::mutex> lock(HostBridge::m_networkMutex);
+                    UInt8Array dmrBuffer = bridge->m_network->readDMR(netReadRet, length);
+                    if (netReadRet) {
+                        bridge->processDMRNetwork(dmrBuffer.get(), length);
+                    }
                 }
-            }
 
-            Thread::sleep(1U);
+                if (bridge->m_txMode == TX_MODE_P25) {
+                    std::lock_guard<std::mutex> lock(HostBridge::m_networkMutex);
+                    UInt8Array p25Buffer = bridge->m_network->readP25(netReadRet, length);
+                    if (netReadRet) {
+                        bridge->processP25Network(p25Buffer.get(), length);
+                    }
+                }
+
+                if (netReadRet)
+                    bridge->m_decodeLatency.recordSince(decodeStart);
+            } while (netReadRet && !g_killed);
         }
 
         LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
@@ -2401,6 +2492,14 @@ void* HostBridge::threadCallWatchdog(void* arg)
             uint32_t ms = stopWatch.elapsed();
             stopWatch.start();
 
+            if (!bridge->m_streams.empty()) {
+                for (auto& entry : bridge->m_streams)
+                    entry.second->clock(ms);
+
+                Thread::sleep(5U);
+                continue;
+            }
+
             if (bridge->m_dropTime.isRunning())
                 bridge->m_dropTime.clock(ms);
 
@@ -22,7 +22,7 @@
 #include "common/dmr/lc/PrivacyLC.h"
 #include "common/network/udp/Socket.h"
 #include "common/yaml/Yaml.h"
-#include "common/RingBuffer.h"
+#include "common/SPSCQueue.h"
 #include "common/Timer.h"
 #include "vocoder/MBEDecoder.h"
 #include "vocoder/MBEEncoder.h"
@@ -30,7 +30,12 @@
 #include "audio/miniaudio.h"
 #include "mdc/mdc_decode.h"
 #include "network/PeerNetwork.h"
+#include "BridgeStream.h"
+#include "LatencyStats.h"
+#include "StreamScheduler.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -47,7 +52,6 @@
 //  Constants
 // ---------------------------------------------------------------------------
 
-#define MBE_SAMPLES_LENGTH 160
 #define NO_BIT_STEAL 0
 
 #define ECMODE_NOISE_SUPPRESS 0x40
@@ -59,9 +63,6 @@
 const uint8_t FULL_RATE_MODE = 0x00U;
 const uint8_t HALF_RATE_MODE = 0x01U;
 
-const uint8_t TX_MODE_DMR = 1U;
-const uint8_t TX_MODE_P25 = 2U;
-
 
 // ---------------------------------------------------------------------------
 //  Global Functions
@@ -91,6 +92,19 @@ void audioCallback(ma_device* device, void* output, const void* input, ma_uint32
 void mdcPacketDetected(int frameCount, mdc_u8_t op, mdc_u8_t arg, mdc_u16_t unitID,
     mdc_u8_t extra0, mdc_u8_t extra1, mdc_u8_t extra2, mdc_u8_t extra3, void* context);
 
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a single 20ms frame of PCM audio moving through the bridge audio pipeline.
+ * @ingroup bridge
+ */
+struct AudioFrame {
+    short samples[MBE_SAMPLES_LENGTH];      //! PCM samples.
+    uint64_t timestamp;                     //! Time (us) the frame entered the pipeline.
+};
+
 // ---------------------------------------------------------------------------
 //  Class Declaration
 // ---------------------------------------------------------------------------
@@ -174,8 +188,23 @@ private:
     ma_waveform m_maSineWaveform;
     ma_waveform_config m_maSineWaveConfig;
 
-    RingBuffer<short> m_inputAudio;
-    RingBuffer<short> m_outputAudio;
+    // audio callback -> encoder
+    SPSCQueue<AudioFrame> m_inputAudio;
+    std::mutex m_inputAudioMutex;
+    std::condition_variable m_inputAudioCond;
+    // decoder -> audio callback
+    SPSCQueue<AudioFrame> m_outputAudio;
+
+    // main loop (network clock) -> decoder
+    std::mutex m_networkRxMutex;
+    std::condition_variable m_networkRxCond;
+    uint64_t m_networkRxReadyTime;
+
+    LatencyStats m_captureLatency;
+    LatencyStats m_encodeLatency;
+    LatencyStats m_networkRxLatency;
+    LatencyStats m_decodeLatency;
+    LatencyStats m_playoutLatency;
 
     vocoder::MBEDecoder* m_decoder;
     vocoder::MBEEncoder* m_encoder;
@@ -210,7 +239,12 @@ private:
     uint8_t m_detectedSampleCnt;
     bool m_dumpSampleLevel;
 
-    bool m_running;
+    std::unordered_map<uint32_t, BridgeStream*> m_streams;
+    StreamScheduler* m_scheduler;
+    bool m_udpMultiplex;
+    uint32_t m_streamWorkers;
+
+    std::atomic<bool> m_running;
     bool m_debug;
 
     static std::mutex m_audioMutex;
@@ -356,11 +390,33 @@ private:
      * @returns bool True, if network connectivity was initialized, otherwise false.
      */
     bool createNetwork();
+    /**
+     * @brief Initializes the multi-stream transcoding streams.
+     * @returns bool True, if the streams were initialized, otherwise false.
+     */
+    bool createStreams();
+    /**
+     * @brief Stops the stream scheduler and releases the multi-stream transcoding streams.
+     */
+    void destroyStreams();
 
     /**
      * @brief Helper to process UDP audio.
      */
     void processUDPAudio();
+    /**
+     * @brief Helper to process UDP audio for the multi-stream transcoding streams.
+     * @param socket UDP socket to read.
+     * @param owner Stream owning the socket (nullptr if the socket is multiplexed).
+     */
+    void processStreamUDPAudio(network::udp::Socket* socket, BridgeStream* owner);
+    /**
+     * @brief Helper to find the transcoding stream for the given talkgroup.
+     * @param dstId Talkgroup ID.
+     * @param slot DMR slot.
+     * @returns BridgeStream* Transcoding stream, or nullptr if none exists.
+     */
+    BridgeStream* findStream(uint32_t dstId, uint8_t slot);
 
     /**
      * @brief Helper to process DMR network traffic.
@@ -417,6 +473,10 @@ private:
      * @param dstId 
      */
     void callEnd(uint32_t srcId, uint32_t dstId);
+    /**
+     * @brief Helper to write the audio pipeline latency statistics to the log.
+     */
+    void logLatency();
 
     /**
      * @brief Entry point to audio processing thread.
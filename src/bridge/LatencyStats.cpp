@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "LatencyStats.h"
+
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LatencyStats class. */
+
+LatencyStats::LatencyStats(const char* name) :
+    m_name(name),
+    m_count(0U),
+    m_total(0U),
+    m_max(0U)
+{
+    /* stub */
+}
+
+/* Records a latency sample. */
+
+void LatencyStats::record(uint64_t us)
+{
+    m_count.fetch_add(1U, std::memory_order_relaxed);
+    m_total.fetch_add(us, std::memory_order_relaxed);
+
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (us > max && !m_max.compare_exchange_weak(max, us, std::memory_order_relaxed))
+        ;
+}
+
+/* Writes the statistics to the log, and resets them. */
+
+void LatencyStats::logAndReset()
+{
+    uint64_t count = m_count.exchange(0U, std::memory_order_relaxed);
+    uint64_t total = m_total.exchange(0U, std::memory_order_relaxed);
+    uint64_t max = m_max.exchange(0U, std::memory_order_relaxed);
+    if (count == 0U)
+        return;
+
+    LogDebug(LOG_HOST, "%s latency, frames = %llu, avg = %.2fms, max = %.2fms", m_name, (unsigned long long)count,
+        (total / (double)count) / 1000.0, max / 1000.0);
+}
+
+/* Gets the current monotonic timestamp. */
+
+uint64_t LatencyStats::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LatencyStats.h
+ * @ingroup bridge
+ * @file LatencyStats.cpp
+ * @ingroup bridge
+ */
+#if !defined(__LATENCY_STATS_H__)
+#define __LATENCY_STATS_H__
+
+#include "Defines.h"
+
+#include <atomic>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements latency statistics for a single stage of the bridge audio pipeline.
+ *
+ *  Samples are recorded without locking, so a stage running on the audio device callback may
+ *  record while another thread reads and resets the statistics.
+ * @ingroup bridge
+ */
+class HOST_SW_API LatencyStats {
+public:
+    /**
+     * @brief Initializes a new instance of the LatencyStats class.
+     * @param name Name of the pipeline stage.
+     */
+    LatencyStats(const char* name);
+
+    /**
+     * @brief Records a latency sample.
+     * @param us Latency (us).
+     */
+    void record(uint64_t us);
+    /**
+     * @brief Records the latency from the given timestamp to now.
+     * @param start Timestamp (us) returned by now().
+     */
+    void recordSince(uint64_t start) { record(now() - start); }
+
+    /**
+     * @brief Writes the statistics to the log, and resets them.
+     */
+    void logAndReset();
+
+    /**
+     * @brief Gets the current monotonic timestamp.
+     * @returns uint64_t Timestamp (us).
+     */
+    static uint64_t now();
+
+private:
+    const char* m_name;
+
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_total;
+    std::atomic<uint64_t> m_max;
+};
+
+#endif // __LATENCY_STATS_H__
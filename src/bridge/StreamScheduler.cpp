@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "BridgeStream.h"
+#include "StreamScheduler.h"
+
+#include <cassert>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the StreamScheduler class. */
+
+StreamScheduler::StreamScheduler(uint32_t workers) :
+    m_workers(workers),
+    m_activeWorkers(0U),
+    m_ready(),
+    m_mutex(),
+    m_cond(),
+    m_running(false)
+{
+    if (m_workers == 0U) {
+        m_workers = std::thread::hardware_concurrency();
+        if (m_workers == 0U)
+            m_workers = 1U;
+    }
+}
+
+/* Finalizes a instance of the StreamScheduler class. */
+
+StreamScheduler::~StreamScheduler()
+{
+    stop();
+}
+
+/* Starts the worker threads. */
+
+bool StreamScheduler::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running)
+            return true;
+        m_running = true;
+    }
+
+    for (uint32_t i = 0U; i < m_workers; i++) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_activeWorkers++;
+        }
+
+        if (!Thread::runAsThread(this, threadWorker)) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_activeWorkers--;
+            }
+
+            stop();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Stops the worker threads. */
+
+void StreamScheduler::stop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running)
+        return;
+
+    m_running = false;
+    m_cond.notify_all();
+
+    // wait for the (detached) workers to exit
+    m_cond.wait(lock, [this] { return m_activeWorkers == 0U; });
+
+    while (!m_ready.empty())
+        m_ready.pop();
+}
+
+/* Queues the given stream for processing, if it is not already queued or being processed. */
+
+void StreamScheduler::schedule(BridgeStream* stream)
+{
+    assert(stream != nullptr);
+
+    // a stream already queued (or held by a worker) will pick up the new work itself
+    if (stream->m_scheduled.exchange(true))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running) {
+        stream->m_scheduled = false;
+        return;
+    }
+
+    m_ready.push({ stream->nextDeadline(), stream });
+    m_cond.notify_one();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Entry point to a worker thread. */
+
+void* StreamScheduler::threadWorker(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+#if defined(_WIN32)
+        ::CloseHandle(th->thread);
+#else
+        ::pthread_detach(th->thread);
+#endif // defined(_WIN32)
+
+        std::string threadName("bridge:stream-worker");
+        StreamScheduler* scheduler = static_cast<StreamScheduler*>(th->obj);
+        if (scheduler == nullptr) {
+            LogDebug(LOG_HOST, "[FAIL] %s", threadName.c_str());
+            delete th;
+            return nullptr;
+        }
+
+        LogDebug(LOG_HOST, "[ OK ] %s", threadName.c_str());
+#ifdef _GNU_SOURCE
+        ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+        while (true) {
+            BridgeStream* stream = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(scheduler->m_mutex);
+                scheduler->m_cond.wait(lock, [scheduler] { return !scheduler->m_running || !scheduler->m_ready.empty(); });
+                if (!scheduler->m_running)
+                    break;
+
+                stream = scheduler->m_ready.top().stream;
+                scheduler->m_ready.pop();
+            }
+
+            stream->process();
+
+            // release the stream; if more work arrived while it was held, queue it again
+            stream->m_scheduled = false;
+            if (stream->hasPendingFrames())
+                scheduler->schedule(stream);
+        }
+
+        {
+            // notify while still holding the lock; once stop() sees no active workers the scheduler may be destroyed
+            std::lock_guard<std::mutex> lock(scheduler->m_mutex);
+            scheduler->m_activeWorkers--;
+            scheduler->m_cond.notify_all();
+        }
+
+        LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
+        delete th;
+    }
+
+    return nullptr;
+}
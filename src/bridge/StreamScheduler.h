@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file StreamScheduler.h
+ * @ingroup bridge
+ * @file StreamScheduler.cpp
+ * @ingroup bridge
+ */
+#if !defined(__STREAM_SCHEDULER_H__)
+#define __STREAM_SCHEDULER_H__
+
+#include "Defines.h"
+#include "common/Thread.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Class Prototypes
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API BridgeStream;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a worker pool that transcodes bridge streams.
+ *
+ *  Streams with pending work are queued earliest-deadline-first; a stream is only ever
+ *  held by one worker at a time, so frames of a single stream are always processed in
+ *  order while separate streams are transcoded in parallel.
+ * @ingroup bridge
+ */
+class HOST_SW_API StreamScheduler {
+public:
+    /**
+     * @brief Initializes a new instance of the StreamScheduler class.
+     * @param workers Number of worker threads (0 for one per CPU).
+     */
+    StreamScheduler(uint32_t workers);
+    /**
+     * @brief Finalizes a instance of the StreamScheduler class.
+     */
+    ~StreamScheduler();
+
+    /**
+     * @brief Starts the worker threads.
+     * @returns bool True, if the workers were started, otherwise false.
+     */
+    bool start();
+    /**
+     * @brief Stops the worker threads.
+     */
+    void stop();
+
+    /**
+     * @brief Queues the given stream for processing, if it is not already queued or being processed.
+     * @param stream Bridge stream with pending work.
+     */
+    void schedule(BridgeStream* stream);
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @returns uint32_t Number of worker threads.
+     */
+    uint32_t workers() const { return m_workers; }
+
+private:
+    uint32_t m_workers;
+    uint32_t m_activeWorkers;
+
+    /**
+     * @brief Represents a stream waiting to be processed.
+     */
+    struct ReadyStream {
+        uint64_t deadline;                  //! Deadline (ms) of the oldest pending frame.
+        BridgeStream* stream;               //! Bridge stream.
+
+        bool operator>(const ReadyStream& other) const { return deadline > other.deadline; }
+    };
+
+    std::priority_queue<ReadyStream, std::vector<ReadyStream>, std::greater<ReadyStream>> m_ready;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_running;
+
+    /**
+     * @brief Entry point to a worker thread.
+     * @param arg Instance of the thread_t structure.
+     * @returns void* (Ignore)
+     */
+    static void* threadWorker(void* arg);
+};
+
+#endif // __STREAM_SCHEDULER_H__
@@ -80,9 +80,120 @@ bool PeerNetwork::writeP25LDU2(const p25::lc::LC& control, const p25::data::LowS
     return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq(resetSeq), m_p25StreamId);
 }
 
+/* Writes DMR frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeDMR(const dmr::data::NetData& data, CallStream& stream)
+{
+    using namespace dmr::defines;
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    uint32_t slotNo = data.getSlotNo();
+
+    // individual slot disabling
+    if (slotNo == 1U && !m_slot1)
+        return false;
+    if (slotNo == 2U && !m_slot2)
+        return false;
+
+    DataType::E dataType = data.getDataType();
+
+    bool resetSeq = false;
+    if (dataType == DataType::VOICE_LC_HEADER || stream.streamId == 0U) {
+        resetSeq = true;
+        stream.streamId = createStreamId();
+    }
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createDMR_Message(messageLength, stream.streamId, data);
+    if (message == nullptr) {
+        return false;
+    }
+
+    uint16_t seq = streamSeq(stream, resetSeq);
+    if (dataType == DataType::TERMINATOR_WITH_LC) {
+        seq = RTP_END_OF_CALL_SEQ;
+    }
+
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, seq, stream.streamId);
+}
+
+/* Writes P25 LDU1 frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeP25LDU1(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, 
+    p25::defines::FrameType::E frameType, CallStream& stream)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    bool resetSeq = false;
+    if (stream.streamId == 0U) {
+        resetSeq = true;
+        stream.streamId = createStreamId();
+    }
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createP25_LDU1Message_Raw(messageLength, control, lsd, data, frameType);
+    if (message == nullptr) {
+        return false;
+    }
+
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, streamSeq(stream, resetSeq), stream.streamId);
+}
+
+/* Writes P25 LDU2 frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeP25LDU2(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, CallStream& stream)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    bool resetSeq = false;
+    if (stream.streamId == 0U) {
+        resetSeq = true;
+        stream.streamId = createStreamId();
+    }
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createP25_LDU2Message_Raw(messageLength, control, lsd, data);
+    if (message == nullptr) {
+        return false;
+    }
+
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, streamSeq(stream, resetSeq), stream.streamId);
+}
+
+/* Writes P25 TDU frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeP25TDU(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t controlByte, CallStream& stream)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    bool resetSeq = false;
+    if (stream.streamId == 0U) {
+        resetSeq = true;
+        stream.streamId = createStreamId();
+    }
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createP25_TDUMessage(messageLength, control, lsd, controlByte);
+    if (message == nullptr) {
+        return false;
+    }
+
+    uint16_t seq = streamSeq(stream, resetSeq);
+    if (controlByte == 0x00U) {
+        seq = RTP_END_OF_CALL_SEQ;
+    }
+
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, seq, stream.streamId);
+}
+
 /* Helper to send a DMR terminator with LC message. */
 
-void PeerNetwork::writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo, uint8_t* dmrN, dmr::data::EmbeddedData& embeddedData)
+void PeerNetwork::writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo, uint8_t* dmrN, dmr::data::EmbeddedData& embeddedData,
+    CallStream* stream)
 {
     using namespace dmr;
     using namespace dmr::defines;
@@ -108,7 +219,10 @@ void PeerNetwork::writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo,
             // generate DMR network frame
             data.setData(buffer);
 
-            writeDMR(data);
+            if (stream != nullptr)
+                writeDMR(data, *stream);
+            else
+                writeDMR(data);
 
             seqNo++;
             dmrN++;
@@ -135,7 +249,10 @@ void PeerNetwork::writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo,
     // generate DMR network frame
     data.setData(buffer);
 
-    writeDMR(data);
+    if (stream != nullptr)
+        writeDMR(data, *stream);
+    else
+        writeDMR(data);
 
     seqNo = 0;
     dmrN = 0;
@@ -358,3 +475,20 @@ UInt8Array PeerNetwork::createP25_LDU2Message_Raw(uint32_t& length, const p25::l
     length = (P25_LDU2_PACKET_LENGTH + PACKET_PAD);
     return UInt8Array(buffer);
 }
+
+/* Helper to update the RTP packet sequence of the given call stream. */
+
+uint16_t PeerNetwork::streamSeq(CallStream& stream, bool reset)
+{
+    if (reset) {
+        stream.pktSeq = 0U;
+    }
+
+    uint16_t curr = stream.pktSeq;
+    ++stream.pktSeq;
+    if (stream.pktSeq > (RTP_END_OF_CALL_SEQ - 1U)) {
+        stream.pktSeq = 0U;
+    }
+
+    return curr;
+}
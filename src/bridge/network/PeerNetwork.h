@@ -29,6 +29,30 @@
 
 namespace network
 {
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the RTP stream state of a single call, used when several calls are
+     *  written concurrently through one peer connection.
+     * @ingroup bridge_network
+     */
+    struct CallStream {
+        uint32_t streamId;                  //! RTP Stream ID (0 when no call is active).
+        uint16_t pktSeq;                    //! Next RTP packet sequence.
+
+        /**
+         * @brief Initializes a new instance of the CallStream struct.
+         */
+        CallStream() : streamId(0U), pktSeq(0U) { /* stub */ }
+
+        /**
+         * @brief Resets the stream state, the next frame written will start a new stream.
+         */
+        void reset() { streamId = 0U; pktSeq = 0U; }
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     //      Implements the core peer networking logic.
@@ -76,14 +100,62 @@ namespace network
          */
         bool writeP25LDU2(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data) override;
 
+        using BaseNetwork::writeDMR;
+        using BaseNetwork::writeP25TDU;
+
+        /**
+         * @brief Writes DMR frame data to the network, as part of the given call stream.
+         * @param[in] data Instance of the dmr::data::NetData class containing the DMR message.
+         * @param stream RTP stream state for the call.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeDMR(const dmr::data::NetData& data, CallStream& stream);
+        /**
+         * @brief Writes P25 LDU1 frame data to the network, as part of the given call stream.
+         * @param[in] control Instance of p25::lc::LC containing link control data.
+         * @param[in] lsd Instance of p25::data::LowSpeedData containing low speed data.
+         * @param[in] data Buffer containing P25 LDU1 data to send.
+         * @param[in] frameType DVM P25 frame type.
+         * @param stream RTP stream state for the call.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeP25LDU1(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, 
+            p25::defines::FrameType::E frameType, CallStream& stream);
+        /**
+         * @brief Writes P25 LDU2 frame data to the network, as part of the given call stream.
+         * @param[in] control Instance of p25::lc::LC containing link control data.
+         * @param[in] lsd Instance of p25::data::LowSpeedData containing low speed data.
+         * @param[in] data Buffer containing P25 LDU2 data to send.
+         * @param stream RTP stream state for the call.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeP25LDU2(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, CallStream& stream);
+        /**
+         * @brief Writes P25 TDU frame data to the network, as part of the given call stream.
+         * @param[in] control Instance of p25::lc::LC containing link control data.
+         * @param[in] lsd Instance of p25::data::LowSpeedData containing low speed data.
+         * @param[in] controlByte DVM control byte.
+         * @param stream RTP stream state for the call.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeP25TDU(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t controlByte, CallStream& stream);
+
         /**
          * @brief Helper to send a DMR terminator with LC message.
          * @param data 
          * @param seqNo 
          * @param dmrN 
          * @param embeddedData 
+         * @param stream RTP stream state for the call (or nullptr to use the shared peer stream).
+         */
+        void writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo, uint8_t* dmrN, dmr::data::EmbeddedData& embeddedData,
+            CallStream* stream = nullptr);
+
+        /**
+         * @brief Gets the UDP socket used for peer traffic, so callers may wait on it for received data.
+         * @returns udp::Socket* UDP socket.
          */
-        void writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo, uint8_t* dmrN, dmr::data::EmbeddedData& embeddedData);
+        udp::Socket* socket() const { return m_socket; }
 
     protected:
         /**
@@ -122,6 +194,14 @@ namespace network
          */
         UInt8Array createP25_LDU2Message_Raw(uint32_t& length, const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, 
             const uint8_t* data);
+
+        /**
+         * @brief Helper to update the RTP packet sequence of the given call stream.
+         * @param stream RTP stream state for the call.
+         * @param reset Flag indicating the RTP packet sequence should be reset.
+         * @returns uint16_t RTP packet sequence.
+         */
+        uint16_t streamSeq(CallStream& stream, bool reset);
     };
 } // namespace network
 
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "common/AsyncFileWriter.h"
+#include "common/Thread.h"
+
+#include <cassert>
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the AsyncFileWriter class. */
+
+AsyncFileWriter::AsyncFileWriter(const std::string& name, bool binary, uint32_t flushIntervalMs) :
+    m_name(name),
+    m_binary(binary),
+    m_flushIntervalMs(flushIntervalMs),
+    m_pending(),
+    m_pendingBytes(0U),
+    m_dropped(0U),
+    m_mutex(),
+    m_cond(),
+    m_started(false),
+    m_running(false),
+    m_stopped(false),
+    m_fileMutex(),
+    m_header(),
+    m_fp(nullptr),
+    m_fileName()
+{
+    if (m_flushIntervalMs == 0U)
+        m_flushIntervalMs = 1U;
+}
+
+/* Finalizes a instance of the AsyncFileWriter class. */
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    stop();
+}
+
+/* Sets the data written at the start of every newly created file. */
+
+void AsyncFileWriter::setFileHeader(const std::string& header)
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_header = header;
+}
+
+/* Queues data to be appended to the given file. */
+
+bool AsyncFileWriter::write(const std::string& fileName, const char* data, size_t length)
+{
+    assert(data != nullptr);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stopped)
+        return false;
+
+    // if the disk can't keep up, drop rather than grow without bound
+    if (m_pendingBytes + length > ASYNC_WRITER_MAX_PENDING) {
+        m_dropped += length;
+        return false;
+    }
+
+    if (m_pending.empty() || m_pending.back().fileName != fileName) {
+        m_pending.push_back(Chunk());
+        m_pending.back().fileName = fileName;
+    }
+
+    m_pending.back().data.append(data, length);
+    m_pendingBytes += length;
+
+    // the writer thread is started lazily, so it is created after any daemon fork()
+    if (!m_started) {
+        m_started = true;
+        m_running = true;
+        if (!Thread::runAsThread(this, threadWriter)) {
+            m_running = false;
+
+            // no thread; fall back to writing synchronously
+            std::vector<Chunk> chunks;
+            chunks.swap(m_pending);
+            m_pendingBytes = 0U;
+            flush(chunks);
+            m_started = false;
+            return true;
+        }
+    }
+
+    if (m_pendingBytes >= ASYNC_WRITER_FLUSH_HIGH_WATER)
+        m_cond.notify_one();
+
+    return true;
+}
+
+/* Writes all queued data and stops the writer thread. */
+
+void AsyncFileWriter::stop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stopped)
+        return;
+    m_stopped = true;
+
+    if (m_running) {
+        m_cond.notify_all();
+
+        // wait for the (detached) writer to drain and exit
+        m_cond.wait(lock, [this] { return !m_running; });
+    }
+    else {
+        std::vector<Chunk> chunks;
+        chunks.swap(m_pending);
+        m_pendingBytes = 0U;
+        flush(chunks);
+    }
+
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    if (m_fp != nullptr) {
+        ::fclose(m_fp);
+        m_fp = nullptr;
+    }
+}
+
+/* Gets the number of bytes dropped because the writer fell too far behind. */
+
+uint64_t AsyncFileWriter::dropped() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to write a batch of chunks to disk. */
+
+void AsyncFileWriter::flush(std::vector<Chunk>& chunks)
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+
+    bool written = false;
+    for (Chunk& chunk : chunks) {
+        if (chunk.fileName != m_fileName || m_fp == nullptr) {
+            if (m_fp != nullptr) {
+                ::fflush(m_fp);
+                ::fclose(m_fp);
+            }
+
+            m_fileName = chunk.fileName;
+            m_fp = ::fopen(m_fileName.c_str(), m_binary ? "ab" : "a+t");
+            if (m_fp == nullptr)
+                continue;
+
+            // header for a brand new file
+            ::fseek(m_fp, 0L, SEEK_END);
+            if (::ftell(m_fp) == 0L && !m_header.empty())
+                ::fwrite(m_header.c_str(), 1U, m_header.size(), m_fp);
+        }
+
+        ::fwrite(chunk.data.c_str(), 1U, chunk.data.size(), m_fp);
+        written = true;
+    }
+
+    if (written && m_fp != nullptr)
+        ::fflush(m_fp);
+}
+
+/* Entry point to the writer thread. */
+
+void* AsyncFileWriter::threadWriter(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+#if defined(_WIN32)
+        ::CloseHandle(th->thread);
+#else
+        ::pthread_detach(th->thread);
+#endif // defined(_WIN32)
+
+        AsyncFileWriter* writer = static_cast<AsyncFileWriter*>(th->obj);
+        if (writer == nullptr) {
+            delete th;
+            return nullptr;
+        }
+
+#ifdef _GNU_SOURCE
+        std::string threadName = "async:" + writer->m_name;
+        if (threadName.size() > 15U)
+            threadName.resize(15U);
+        ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+        std::unique_lock<std::mutex> lock(writer->m_mutex);
+        while (true) {
+            writer->m_cond.wait_for(lock, std::chrono::milliseconds(writer->m_flushIntervalMs),
+                [writer] { return writer->m_stopped || writer->m_pendingBytes >= ASYNC_WRITER_FLUSH_HIGH_WATER; });
+
+            std::vector<Chunk> chunks;
+            chunks.swap(writer->m_pending);
+            writer->m_pendingBytes = 0U;
+            bool stopped = writer->m_stopped;
+
+            // disk I/O happens without holding the lock, so writers never wait on it
+            if (!chunks.empty()) {
+                lock.unlock();
+                writer->flush(chunks);
+                lock.lock();
+            }
+
+            if (stopped && writer->m_pending.empty())
+                break;
+        }
+
+        // notify while still holding the lock; once stop() sees the writer stopped the instance may be destroyed
+        writer->m_running = false;
+        writer->m_cond.notify_all();
+        lock.unlock();
+
+        delete th;
+    }
+
+    return nullptr;
+}
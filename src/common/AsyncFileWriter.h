@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file AsyncFileWriter.h
+ * @ingroup common
+ * @file AsyncFileWriter.cpp
+ * @ingroup common
+ */
+#if !defined(__ASYNC_FILE_WRITER_H__)
+#define __ASYNC_FILE_WRITER_H__
+
+#include "common/Defines.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define ASYNC_WRITER_FLUSH_INTERVAL_MS 250U
+#define ASYNC_WRITER_FLUSH_HIGH_WATER 16384U
+#define ASYNC_WRITER_MAX_PENDING 1048576U
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a buffered file writer that appends to files from a background thread.
+ *
+ *  Callers only append to an in-memory batch; the writer thread wakes every flush interval (or
+ *  early, once the batch passes a high-water mark) and writes and flushes the whole batch at once.
+ *  Each write names its target file, so date-rolled files are switched without losing ordering.
+ *  The writer thread is started by the first write, so a writer may be created before the
+ *  process daemonizes.
+ * @ingroup common
+ */
+class HOST_SW_API AsyncFileWriter {
+public:
+    /**
+     * @brief Initializes a new instance of the AsyncFileWriter class.
+     * @param name Name of the writer (used for the thread name).
+     * @param binary Flag indicating files are opened in binary mode.
+     * @param flushIntervalMs Maximum amount of time (ms) data is held before being written.
+     */
+    AsyncFileWriter(const std::string& name, bool binary = false, uint32_t flushIntervalMs = ASYNC_WRITER_FLUSH_INTERVAL_MS);
+    /**
+     * @brief Finalizes a instance of the AsyncFileWriter class.
+     */
+    ~AsyncFileWriter();
+
+    /**
+     * @brief Sets the data written at the start of every newly created file.
+     * @param header File header.
+     */
+    void setFileHeader(const std::string& header);
+
+    /**
+     * @brief Queues data to be appended to the given file.
+     * @param fileName Full path to the file.
+     * @param data Data to append.
+     * @param length Length of data.
+     * @returns bool True, if the data was queued, otherwise false.
+     */
+    bool write(const std::string& fileName, const char* data, size_t length);
+
+    /**
+     * @brief Writes all queued data and stops the writer thread.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the number of bytes dropped because the writer fell too far behind.
+     * @returns uint64_t Number of dropped bytes.
+     */
+    uint64_t dropped() const;
+
+private:
+    std::string m_name;
+    bool m_binary;
+    uint32_t m_flushIntervalMs;
+
+    /**
+     * @brief Represents data queued for a single file.
+     */
+    struct Chunk {
+        std::string fileName;               //! Full path to the file.
+        std::string data;                   //! Data to append.
+    };
+
+    std::vector<Chunk> m_pending;
+    size_t m_pendingBytes;
+    uint64_t m_dropped;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_started;
+    bool m_running;
+    bool m_stopped;
+
+    // guarded by m_fileMutex; taken after m_mutex when both are held
+    std::mutex m_fileMutex;
+    std::string m_header;
+    FILE* m_fp;
+    std::string m_fileName;
+
+    /**
+     * @brief Helper to write a batch of chunks to disk.
+     * @param chunks Chunks to write.
+     */
+    void flush(std::vector<Chunk>& chunks);
+
+    /**
+     * @brief Entry point to the writer thread.
+     * @param arg Instance of the thread_t structure.
+     * @returns void* (Ignore)
+     */
+    static void* threadWriter(void* arg);
+};
+
+#endif // __ASYNC_FILE_WRITER_H__
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file InlineObject.h
+ * @ingroup common
+ */
+#if !defined(__INLINE_OBJECT_H__)
+#define __INLINE_OBJECT_H__
+
+#include "common/Defines.h"
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Holds at most one instance of any class derived from a polymorphic base, constructed in
+ *  place in fixed size storage (i.e. on the stack) instead of on the heap.
+ *
+ *  This is the in-place counterpart of a std::unique_ptr<Base>; the held instance is destroyed when
+ *  another instance is emplaced, on reset() or when the InlineObject goes out of scope. Emplacing a
+ *  class that does not fit fails to compile.
+ * @ingroup common
+ * @tparam Base Polymorphic base class (must have a virtual destructor).
+ * @tparam Size Size of the storage, in bytes.
+ */
+template<class Base, size_t Size>
+class HOST_SW_API InlineObject {
+public:
+    static_assert(std::has_virtual_destructor<Base>::value, "base class must have a virtual destructor");
+
+    /**
+     * @brief Initializes a new (empty) instance of the InlineObject class.
+     */
+    InlineObject() :
+        m_storage(),
+        m_object(nullptr)
+    {
+        /* stub */
+    }
+    /**
+     * @brief Finalizes a instance of the InlineObject class.
+     */
+    ~InlineObject()
+    {
+        reset();
+    }
+
+    InlineObject(const InlineObject&) = delete;
+    InlineObject& operator=(const InlineObject&) = delete;
+
+    /**
+     * @brief Constructs a new instance of the given class in place, destroying any held instance.
+     * @tparam T Class derived from Base.
+     * @returns T* Instance.
+     */
+    template<class T>
+    T* emplace()
+    {
+        static_assert(std::is_base_of<Base, T>::value, "class must derive from the base class");
+        static_assert(sizeof(T) <= Size, "class does not fit in the inline storage");
+        static_assert(alignof(T) <= alignof(Storage), "class is over-aligned for the inline storage");
+
+        reset();
+
+        // the global placement new is used explicitly; a class specific operator new would hide it
+        T* object = ::new (static_cast<void*>(&m_storage)) T();
+        m_object = object;
+        return object;
+    }
+
+    /**
+     * @brief Destroys the held instance (if any).
+     */
+    void reset()
+    {
+        if (m_object != nullptr) {
+            m_object->~Base();
+            m_object = nullptr;
+        }
+    }
+
+    /**
+     * @brief Gets the held instance.
+     * @returns Base* Instance, or nullptr if empty.
+     */
+    Base* get() const { return m_object; }
+    /**
+     * @brief Gets the held instance.
+     */
+    Base* operator->() const { assert(m_object != nullptr); return m_object; }
+    /**
+     * @brief Gets the held instance.
+     */
+    Base& operator*() const { assert(m_object != nullptr); return *m_object; }
+    /**
+     * @brief Flag indicating whether an instance is held.
+     */
+    explicit operator bool() const { return m_object != nullptr; }
+
+private:
+    typedef typename std::aligned_storage<Size, alignof(std::max_align_t)>::type Storage;
+
+    Storage m_storage;
+    Base* m_object;
+};
+
+#endif // __INLINE_OBJECT_H__
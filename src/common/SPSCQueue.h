@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file SPSCQueue.h
+ * @ingroup common
+ */
+#if !defined(__SPSC_QUEUE_H__)
+#define __SPSC_QUEUE_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue.
+ *
+ *  Exactly one thread may call push() and exactly one (other) thread may call pop(); no other
+ *  synchronization is required between the two. The capacity is rounded up to the next power
+ *  of two.
+ * @ingroup common
+ */
+template<class T>
+class HOST_SW_API SPSCQueue {
+public:
+    /**
+     * @brief Initializes a new instance of the SPSCQueue class.
+     * @param capacity Maximum number of elements in the queue.
+     * @param name Name of queue.
+     */
+    SPSCQueue(uint32_t capacity, const char* name) :
+        m_capacity(1U),
+        m_mask(0U),
+        m_name(name),
+        m_buffer(nullptr),
+        m_head(0U),
+        m_pad(),
+        m_tail(0U)
+    {
+        assert(capacity > 0U);
+        assert(name != nullptr);
+
+        while (m_capacity < capacity)
+            m_capacity <<= 1;
+        m_mask = m_capacity - 1U;
+
+        m_buffer = new T[m_capacity];
+    }
+    /**
+     * @brief Finalizes a instance of the SPSCQueue class.
+     */
+    ~SPSCQueue()
+    {
+        delete[] m_buffer;
+    }
+
+    /**
+     * @brief Adds an element to the queue. (Producer thread only.)
+     * @param item Element to add.
+     * @return bool True, if the element was queued, otherwise false if the queue is full.
+     */
+    bool push(const T& item)
+    {
+        const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_capacity)
+            return false;
+
+        m_buffer[tail & m_mask] = item;
+        m_tail.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes an element from the queue. (Consumer thread only.)
+     * @param[out] item Element removed from the queue.
+     * @return bool True, if an element was removed, otherwise false if the queue is empty.
+     */
+    bool pop(T& item)
+    {
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        item = m_buffer[head & m_mask];
+        m_head.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Returns the approximate number of elements in the queue.
+     * @return uint32_t Number of elements in the queue.
+     */
+    uint32_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Gets the capacity of the queue.
+     * @return uint32_t Capacity of the queue.
+     */
+    uint32_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief Gets the name of the queue.
+     * @return const char* Name of the queue.
+     */
+    const char* name() const { return m_name; }
+
+    /**
+     * @brief Helper to return whether the queue is empty or not.
+     * @return bool True, if the queue is empty, otherwise false.
+     */
+    bool isEmpty() const { return size() == 0U; }
+
+private:
+    uint32_t m_capacity;
+    uint32_t m_mask;
+
+    const char* m_name;
+
+    T* m_buffer;
+
+    // head and tail are padded apart to keep the producer and consumer off the same cache line
+    std::atomic<uint32_t> m_head;
+    uint8_t m_pad[64U - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> m_tail;
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+};
+
+#endif // __SPSC_QUEUE_H__
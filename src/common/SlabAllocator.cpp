@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "SlabAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t SLAB_CLASS_SIZES[SLAB_SIZE_CLASSES] = { 64U, 128U, 256U, 512U, 1024U };
+const uint32_t SLAB_CLASS_HEAP = 0xFFU;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Header in front of every block; 16 bytes, so the block itself stays aligned.
+ */
+struct SlabBlock {
+    std::atomic<uint32_t> next;         //! Index + 1 of the next free block (0 if none).
+    uint32_t index;                     //! Index of this block within its size class.
+    uint32_t sizeClass;                 //! Size class (or SLAB_CLASS_HEAP).
+    uint32_t reserved;                  //!
+};
+static_assert(sizeof(SlabBlock) == 16U, "slab block header must keep blocks 16 byte aligned");
+
+/**
+ * @brief Size class state shared by all threads.
+ *
+ *  Free blocks are kept on a lock-free stack; the head holds the index of the first block (rather
+ *  than a pointer) and a tag in the upper 32 bits, which is incremented on every change so a stale
+ *  head can never be swapped back in (ABA).
+ */
+struct SlabClass {
+    std::atomic<uint64_t> head;                     //! Tag << 32 | (index + 1) of the first free block.
+    std::atomic<uint32_t> slabCount;                //! Number of slabs allocated.
+    std::atomic<uint8_t*> slabs[SLAB_MAX_SLABS];    //! Slabs.
+};
+
+/**
+ * @brief Per-thread cache of free blocks.
+ */
+struct SlabThreadCache {
+    SlabBlock* blocks[SLAB_SIZE_CLASSES][SLAB_THREAD_CACHE];
+    uint32_t count[SLAB_SIZE_CLASSES];
+    std::atomic<uint64_t> allocations;  //! Blocks allocated by this thread (only written by this thread).
+    bool alive;
+
+    SlabThreadCache();
+    ~SlabThreadCache();
+};
+
+/**
+ * @brief Registry of the live per-thread caches, used to total the per-thread counters.
+ */
+struct SlabCacheRegistry {
+    std::mutex lock;
+    std::vector<SlabThreadCache*> caches;
+    uint64_t allocations;               //! Blocks allocated by threads that have exited.
+};
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+std::atomic<bool> SlabAllocator::m_enabled{true};
+std::atomic<uint64_t> SlabAllocator::m_heapAllocations{0U};
+
+static SlabClass m_slabClasses[SLAB_SIZE_CLASSES];
+static thread_local SlabThreadCache m_slabCache;
+static std::atomic<uint64_t> m_slabUncachedAllocations{0U};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the registry of per-thread caches. */
+
+static SlabCacheRegistry& cacheRegistry()
+{
+    // never destroyed, threads may still be exiting while the process shuts down
+    static SlabCacheRegistry* registry = new SlabCacheRegistry();
+    return *registry;
+}
+
+/* Helper to get the block stride of the given size class. */
+
+static inline uint32_t blockStride(uint32_t sizeClass)
+{
+    return SLAB_CLASS_SIZES[sizeClass] + sizeof(SlabBlock);
+}
+
+/* Helper to get the block at the given index of the given size class. */
+
+static inline SlabBlock* blockAt(uint32_t sizeClass, uint32_t index)
+{
+    uint32_t perSlab = SLAB_BYTES / blockStride(sizeClass);
+    uint8_t* slab = m_slabClasses[sizeClass].slabs[index / perSlab].load(std::memory_order_acquire);
+    return reinterpret_cast<SlabBlock*>(slab + (index % perSlab) * blockStride(sizeClass));
+}
+
+/* Helper to push a free block onto the shared free list of its size class. */
+
+static void pushBlock(SlabBlock* block)
+{
+    SlabClass& c = m_slabClasses[block->sizeClass];
+    uint64_t head = c.head.load(std::memory_order_acquire);
+    uint64_t next = 0U;
+    do {
+        block->next.store((uint32_t)head, std::memory_order_relaxed);
+        next = (((head >> 32) + 1U) << 32) | (uint64_t)(block->index + 1U);
+    } while (!c.head.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_acquire));
+}
+
+/* Helper to pop a free block from the shared free list of the given size class. */
+
+static SlabBlock* popBlock(uint32_t sizeClass)
+{
+    SlabClass& c = m_slabClasses[sizeClass];
+    uint64_t head = c.head.load(std::memory_order_acquire);
+    while ((uint32_t)head != 0U) {
+        // slabs are never released, so the block can always be read -- even if it was taken by
+        // another thread in the meantime (in which case the tag has changed and the swap fails)
+        SlabBlock* block = blockAt(sizeClass, (uint32_t)head - 1U);
+        uint32_t next = block->next.load(std::memory_order_relaxed);
+        if (c.head.compare_exchange_weak(head, (((head >> 32) + 1U) << 32) | next,
+            std::memory_order_acquire, std::memory_order_acquire))
+            return block;
+    }
+
+    return nullptr;
+}
+
+/* Helper to allocate a new slab for the given size class, returning its first block. */
+
+static SlabBlock* growClass(uint32_t sizeClass)
+{
+    SlabClass& c = m_slabClasses[sizeClass];
+    if (c.slabCount.load() >= SLAB_MAX_SLABS)
+        return nullptr;
+
+    uint32_t slab = c.slabCount.fetch_add(1U);
+    if (slab >= SLAB_MAX_SLABS)
+        return nullptr;
+
+    uint8_t* mem = static_cast<uint8_t*>(::malloc(SLAB_BYTES));
+    if (mem == nullptr)
+        return nullptr;
+
+    uint32_t stride = blockStride(sizeClass);
+    uint32_t perSlab = SLAB_BYTES / stride;
+    for (uint32_t i = 0U; i < perSlab; i++) {
+        SlabBlock* block = reinterpret_cast<SlabBlock*>(mem + i * stride);
+        new (block) SlabBlock();
+        block->next.store(0U, std::memory_order_relaxed);
+        block->index = slab * perSlab + i;
+        block->sizeClass = sizeClass;
+        block->reserved = 0U;
+    }
+
+    c.slabs[slab].store(mem, std::memory_order_release);
+
+    // keep the first block, the rest go on the shared free list
+    for (uint32_t i = 1U; i < perSlab; i++) {
+        pushBlock(reinterpret_cast<SlabBlock*>(mem + i * stride));
+    }
+
+    return reinterpret_cast<SlabBlock*>(mem);
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the SlabThreadCache structure. */
+
+SlabThreadCache::SlabThreadCache() :
+    blocks(),
+    count(),
+    allocations(0U),
+    alive(true)
+{
+    SlabCacheRegistry& registry = cacheRegistry();
+    std::lock_guard<std::mutex> lock(registry.lock);
+    registry.caches.push_back(this);
+}
+
+/* Finalizes a instance of the SlabThreadCache structure. */
+
+SlabThreadCache::~SlabThreadCache()
+{
+    alive = false;
+    for (uint32_t sizeClass = 0U; sizeClass < SLAB_SIZE_CLASSES; sizeClass++) {
+        while (count[sizeClass] > 0U) {
+            pushBlock(blocks[sizeClass][--count[sizeClass]]);
+        }
+    }
+
+    SlabCacheRegistry& registry = cacheRegistry();
+    std::lock_guard<std::mutex> lock(registry.lock);
+    registry.allocations += allocations.load(std::memory_order_relaxed);
+    registry.caches.erase(std::remove(registry.caches.begin(), registry.caches.end(), this), registry.caches.end());
+}
+
+/* Allocates a block of memory. */
+
+void* SlabAllocator::allocate(size_t size)
+{
+    // the count is kept per thread (only the owning thread writes it, so no locked add is needed)
+    // and totalled when read
+    SlabThreadCache& cache = m_slabCache;
+    if (cache.alive)
+        cache.allocations.store(cache.allocations.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    else
+        m_slabUncachedAllocations.fetch_add(1U, std::memory_order_relaxed);
+
+    SlabBlock* block = nullptr;
+    if (m_enabled.load(std::memory_order_relaxed) && size <= SLAB_MAX_SIZE) {
+        uint32_t sizeClass = 0U;
+        while (SLAB_CLASS_SIZES[sizeClass] < size)
+            sizeClass++;
+
+        if (cache.alive && cache.count[sizeClass] > 0U)
+            return cache.blocks[sizeClass][--cache.count[sizeClass]] + 1;
+
+        block = popBlock(sizeClass);
+        if (block == nullptr) {
+            block = growClass(sizeClass);
+            if (block != nullptr)
+                m_heapAllocations.fetch_add(1U, std::memory_order_relaxed);
+        }
+
+        if (block != nullptr)
+            return block + 1;
+    }
+
+    // oversized (or unpooled) blocks come straight from the heap
+    block = static_cast<SlabBlock*>(::malloc(sizeof(SlabBlock) + size));
+    if (block == nullptr)
+        throw std::bad_alloc();
+
+    m_heapAllocations.fetch_add(1U, std::memory_order_relaxed);
+
+    new (block) SlabBlock();
+    block->index = 0U;
+    block->sizeClass = SLAB_CLASS_HEAP;
+    block->reserved = 0U;
+    return block + 1;
+}
+
+/* Releases a block of memory returned by allocate(). */
+
+void SlabAllocator::deallocate(void* ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    SlabBlock* block = static_cast<SlabBlock*>(ptr) - 1;
+    if (block->sizeClass == SLAB_CLASS_HEAP) {
+        block->~SlabBlock();
+        ::free(block);
+        return;
+    }
+
+    assert(block->sizeClass < SLAB_SIZE_CLASSES);
+
+    SlabThreadCache& cache = m_slabCache;
+    if (!cache.alive) {
+        pushBlock(block);
+        return;
+    }
+
+    // when the cache is full, hand half of it back to the shared free list
+    uint32_t& count = cache.count[block->sizeClass];
+    if (count == SLAB_THREAD_CACHE) {
+        while (count > SLAB_THREAD_CACHE / 2U) {
+            pushBlock(cache.blocks[block->sizeClass][--count]);
+        }
+    }
+
+    cache.blocks[block->sizeClass][count++] = block;
+}
+
+/* Gets the number of blocks allocated. */
+
+uint64_t SlabAllocator::allocations()
+{
+    SlabCacheRegistry& registry = cacheRegistry();
+    std::lock_guard<std::mutex> lock(registry.lock);
+
+    uint64_t allocations = registry.allocations + m_slabUncachedAllocations.load(std::memory_order_relaxed);
+    for (SlabThreadCache* cache : registry.caches)
+        allocations += cache->allocations.load(std::memory_order_relaxed);
+
+    return allocations;
+}
+
+/* Gets the number of slabs allocated. */
+
+uint32_t SlabAllocator::slabs()
+{
+    uint32_t slabs = 0U;
+    for (uint32_t sizeClass = 0U; sizeClass < SLAB_SIZE_CLASSES; sizeClass++) {
+        uint32_t count = m_slabClasses[sizeClass].slabCount.load();
+        slabs += (count > SLAB_MAX_SLABS) ? SLAB_MAX_SLABS : count;
+    }
+
+    return slabs;
+}
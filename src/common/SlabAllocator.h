@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file SlabAllocator.h
+ * @ingroup common
+ * @file SlabAllocator.cpp
+ * @ingroup common
+ */
+#if !defined(__SLAB_ALLOCATOR_H__)
+#define __SLAB_ALLOCATOR_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+#include <cstddef>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/*
+** Size classes; these are matched to the network message sizes -- 64 bytes for the RTP/FNE
+** headers, 128 bytes for framed DMR, NXDN and P25 TSDU messages, 256 bytes for framed P25 LDUs
+** (and most per-packet objects), 512 and 1024 bytes for larger objects and PDU blocks.
+*/
+const uint32_t SLAB_SIZE_CLASSES = 5U;
+const uint32_t SLAB_MAX_SIZE = 1024U;
+const uint32_t SLAB_BYTES = 65536U;             // size of each slab carved into blocks
+const uint32_t SLAB_MAX_SLABS = 1024U;          // maximum slabs per size class
+const uint32_t SLAB_THREAD_CACHE = 32U;         // maximum free blocks cached per thread per size class
+
+// ---------------------------------------------------------------------------
+//  Macros
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Declares class specific new/delete operators that allocate instances of the class (and
+ *  classes derived from it) from the slab allocator.
+ */
+#define __SLAB_ALLOCATED                                                                    \
+        static void* operator new(size_t size) { return SlabAllocator::allocate(size); }    \
+        static void operator delete(void* ptr) { SlabAllocator::deallocate(ptr); }
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a lock-free slab allocator for small, short lived, objects and buffers.
+ *
+ *  Memory is carved from SLAB_BYTES slabs into fixed size blocks for each size class. Freed blocks
+ *  are kept in a small per-thread cache, and beyond that returned to a lock-free free list shared
+ *  by all threads; slabs are never returned to the heap. Requests larger than SLAB_MAX_SIZE (or any
+ *  request while pooling is disabled) are passed to the heap, so deallocate() accepts any block
+ *  returned by allocate().
+ * @ingroup common
+ */
+class HOST_SW_API SlabAllocator {
+public:
+    /**
+     * @brief Allocates a block of memory.
+     * @param size Size of block.
+     * @returns void* Block of memory (aligned for any type).
+     */
+    static void* allocate(size_t size);
+    /**
+     * @brief Releases a block of memory returned by allocate().
+     * @param ptr Block of memory (may be nullptr).
+     */
+    static void deallocate(void* ptr);
+
+    /**
+     * @brief Allocates a byte buffer.
+     * @param length Length of buffer.
+     * @returns uint8_t* Buffer.
+     */
+    static uint8_t* allocateBuffer(size_t length) { return static_cast<uint8_t*>(allocate(length)); }
+
+    /**
+     * @brief Enables or disables pooling; while disabled every block is allocated from the heap.
+     * @param enabled Flag indicating pooling is enabled.
+     */
+    static void setEnabled(bool enabled) { m_enabled.store(enabled); }
+    /**
+     * @brief Flag indicating whether pooling is enabled.
+     */
+    static bool isEnabled() { return m_enabled.load(); }
+
+    /**
+     * @brief Gets the number of blocks allocated (by every thread).
+     */
+    static uint64_t allocations();
+    /**
+     * @brief Gets the number of heap allocations made (slabs and blocks not served from a slab).
+     */
+    static uint64_t heapAllocations() { return m_heapAllocations.load(); }
+    /**
+     * @brief Gets the number of slabs allocated.
+     */
+    static uint32_t slabs();
+
+private:
+    static std::atomic<bool> m_enabled;
+    static std::atomic<uint64_t> m_heapAllocations;
+};
+
+#endif // __SLAB_ALLOCATOR_H__
@@ -152,6 +152,7 @@ namespace dmr
         const uint32_t  WUID_AUTHI = 0xFFFECDU;         //! Authentication Working Unit ID
         const uint32_t  WUID_KILLI = 0xFFFECFU;         //! MS Kill Identifier
         const uint32_t  WUID_TATTSI = 0xFFFED7U;        //! Talkgroup Subscription/Attachement Service Working Unit ID
+        const uint32_t  WUID_FNE = 0xFFFFFCU;           //! FNE Working Unit ID
         const uint32_t  WUID_ALLL = 0xFFFFFDU;          //! All-call Site-wide Working Unit ID
         const uint32_t  WUID_ALLZ = 0xFFFFFEU;          //! All-call System-wide Working Unit ID
         const uint32_t  WUID_ALL = 0xFFFFFFU;           //! All-call Network-wide Working Unit ID
@@ -175,6 +176,22 @@ namespace dmr
             };
         };
 
+        /** @brief Service Access Point */
+        namespace PDUSAP {
+            /** @brief Service Access Point */
+            enum : uint8_t {
+                UDT = 0x00U,                            //! Unified Data Transport
+
+                TCP_HDR_COMPRESS = 0x02U,               //! TCP/IP Header Compression
+                UDP_HDR_COMPRESS = 0x03U,               //! UDP/IP Header Compression
+                PACKET_DATA = 0x04U,                    //! IP Based Packet Data
+                ARP = 0x05U,                            //! ARP
+
+                PROP_PACKET_DATA = 0x09U,               //! Proprietary Packet Data
+                SHORT_DATA = 0x0AU                      //! Short Data
+            };
+        };
+
         /** @brief Data Response Class */
         namespace PDUResponseClass {
             /** @brief Data Response Class */
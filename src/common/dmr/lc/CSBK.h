@@ -22,6 +22,7 @@
 #define __DMR_LC__CSBK_H__
 
 #include "common/Defines.h"
+#include "common/SlabAllocator.h"
 #include "common/dmr/DMRDefines.h"
 #include "common/dmr/SiteData.h"
 #include "common/lookups/IdenTableLookup.h"
@@ -55,6 +56,8 @@ namespace dmr
              */
             virtual ~CSBK();
 
+            __SLAB_ALLOCATED
+
             /**
              * @brief Decodes a DMR CSBK.
              * @param[in] data Buffer containing a CSBK to decode.
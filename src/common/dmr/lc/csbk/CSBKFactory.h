@@ -24,6 +24,7 @@
 #define  __DMR_LC__CSBK_FACTORY_H__
 
 #include "common/Defines.h"
+#include "common/InlineObject.h"
 
 #include "common/dmr/DMRDefines.h"
 #include "common/dmr/lc/CSBK.h"
@@ -53,6 +54,22 @@ namespace dmr
     {
         namespace csbk
         {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            const size_t CSBK_INLINE_SIZE = 128U;   // largest decoded CSBK (CSBK_BROADCAST) is 88 bytes
+
+            // ---------------------------------------------------------------------------
+            //  Types
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Stack storage for a CSBK decoded in place by CSBKFactory::decodeCSBK().
+             * @ingroup dmr_csbk
+             */
+            typedef InlineObject<CSBK, CSBK_INLINE_SIZE> CSBKStorage;
+
             // ---------------------------------------------------------------------------
             //  Class Declaration
             // ---------------------------------------------------------------------------
@@ -79,15 +96,52 @@ namespace dmr
                  * @returns CSBK* Instance of a CSBK representing the decoded data.
                  */
                 static std::unique_ptr<CSBK> createCSBK(const uint8_t* data, defines::DataType::E dataType);
+                /**
+                 * @brief Decode a CSBK in place, without allocating.
+                 * @param[in] data Buffer containing CSBK packet data to decode.
+                 * @param dataType Data Type.
+                 * @param storage Storage to decode the CSBK into.
+                 * @returns CSBK* Instance of a CSBK (held by storage) representing the decoded data, or nullptr.
+                 */
+                static CSBK* decodeCSBK(const uint8_t* data, defines::DataType::E dataType, CSBKStorage& storage);
+                /**
+                 * @brief Decode a CSBK in place, without allocating, and pass it to the given visitor.
+                 * @tparam Visitor Callable taking a CSBK&.
+                 * @param[in] data Buffer containing CSBK packet data to decode.
+                 * @param dataType Data Type.
+                 * @param visitor Visitor called with the decoded CSBK.
+                 * @returns bool True, if the CSBK was decoded and visited, otherwise false.
+                 */
+                template<typename Visitor>
+                static bool visitCSBK(const uint8_t* data, defines::DataType::E dataType, Visitor&& visitor)
+                {
+                    CSBKStorage storage;
+                    CSBK* csbk = decodeCSBK(data, dataType, storage);
+                    if (csbk == nullptr)
+                        return false;
+
+                    visitor(*csbk);
+                    return true;
+                }
 
             private:
+                /**
+                 * @brief Create and decode a CSBK.
+                 * @param[in] data Buffer containing CSBK packet data to decode.
+                 * @param dataType Data Type.
+                 * @param storage Storage to decode the CSBK into, or nullptr to allocate it on the heap.
+                 * @returns CSBK* Instance of a CSBK representing the decoded data.
+                 */
+                static CSBK* create(const uint8_t* data, defines::DataType::E dataType, CSBKStorage* storage);
                 /**
                  * @brief Decode a CSBK.
-                 * @param csbk Instance of a CSBK.
+                 * @tparam T CSBK class.
+                 * @param storage Storage to decode the CSBK into, or nullptr to allocate it on the heap.
                  * @param[in] data Buffer containing CSBK packet data to decode.
                  * @returns CSBK* Instance of a CSBK representing the decoded data.
                  */
-                static std::unique_ptr<CSBK> decode(CSBK* csbk, const uint8_t* data);
+                template<class T>
+                static CSBK* decode(CSBKStorage* storage, const uint8_t* data);
             };
         } // namespace csbk
     } // namespace lc
@@ -19,8 +19,241 @@
 using namespace edac;
 
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Lookup tables to split a byte of a 72-bit AMBE frame into its four bit streams (and back).
+ *
+ *  The AMBE_A/B/C_TABLE positions interleave the A, B and C words as four streams of 18 bits,
+ *  stream r holding every bit 4k + r. Each frame byte carries two bits of every stream; the
+ *  deinterleave table packs those as 2-bit pairs (stream 0 in the top pair), and the interleave
+ *  table is its inverse.
+ */
+struct AMBEByteTable {
+    uint8_t deinterleave[256U];
+    uint8_t interleave[256U];
+
+    constexpr AMBEByteTable() : deinterleave(), interleave()
+    {
+        for (uint32_t v = 0U; v < 256U; v++) {
+            uint32_t pairs = 0U;
+            for (uint32_t r = 0U; r < 4U; r++) {
+                uint32_t hi = (v >> (7U - r)) & 0x01U;
+                uint32_t lo = (v >> (3U - r)) & 0x01U;
+                pairs |= ((hi << 1) | lo) << (6U - (r * 2U));
+            }
+
+            deinterleave[v] = (uint8_t)pairs;
+            interleave[pairs] = (uint8_t)v;
+        }
+    }
+};
+
+/**
+ * @brief Syndrome and error-correction lookup tables for the P25 IMBE Hamming (15,11,3) code.
+ *
+ *  Codewords are packed MSB first (d[0] in bit 14). The syndrome of a codeword is the XOR of
+ *  the high and low byte lookups; the correction table maps a syndrome to the bit to flip. This
+ *  is bit-exact with Hamming::decode15113_1().
+ */
+struct Hamming15113Table {
+    uint8_t syndromeHi[128U];
+    uint8_t syndromeLo[256U];
+    uint16_t correction[16U];
+
+    constexpr Hamming15113Table() : syndromeHi(), syndromeLo(), correction()
+    {
+        // parity check rows for c0 - c3 (including their parity bit d[11] - d[14])
+        const uint32_t checks[4U] = { 0x7F08U, 0x78E4U, 0x66D2U, 0x55B1U };
+
+        for (uint32_t v = 0U; v < 256U; v++) {
+            uint32_t hi = 0U, lo = 0U;
+            for (uint32_t k = 0U; k < 4U; k++) {
+                uint32_t h = (v << 8) & checks[k];
+                uint32_t l = v & checks[k];
+                uint32_t hp = 0U, lp = 0U;
+                for (uint32_t i = 0U; i < 16U; i++) {
+                    hp ^= (h >> i) & 0x01U;
+                    lp ^= (l >> i) & 0x01U;
+                }
+
+                hi |= hp << k;
+                lo |= lp << k;
+            }
+
+            if (v < 128U)
+                syndromeHi[v] = (uint8_t)hi;
+            syndromeLo[v] = (uint8_t)lo;
+        }
+
+        // a single bit error at d[i] produces the syndrome of its column
+        for (uint32_t i = 0U; i < 15U; i++) {
+            uint32_t bit = 1U << (14U - i);
+            uint32_t syndrome = syndromeHi[bit >> 8] ^ syndromeLo[bit & 0xFFU];
+            correction[syndrome] = (uint16_t)bit;
+        }
+    }
+};
+
+constexpr AMBEByteTable AMBE_BYTE_TABLE;
+constexpr Hamming15113Table HAMMING_15113_TABLE;
+
+const uint32_t IMBE_FRAME_LENGTH_BYTES = 18U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to gather the A, B and C words from a 72-bit AMBE frame.
+ */
+static inline void gatherAMBE(const uint8_t* frame, uint32_t& a, uint32_t& b, uint32_t& c)
+{
+    uint32_t s0 = 0U, s1 = 0U, s2 = 0U, s3 = 0U;
+    for (uint32_t i = 0U; i < 9U; i++) {
+        uint32_t pairs = AMBE_BYTE_TABLE.deinterleave[frame[i]];
+        s0 = (s0 << 2) | ((pairs >> 6) & 0x03U);
+        s1 = (s1 << 2) | ((pairs >> 4) & 0x03U);
+        s2 = (s2 << 2) | ((pairs >> 2) & 0x03U);
+        s3 = (s3 << 2) | ((pairs >> 0) & 0x03U);
+    }
+
+    // A = 18 bits of stream 0 + 6 of stream 1, B = 12 of stream 1 + 11 of stream 2, C = 7 of stream 2 + stream 3
+    a = (s0 << 6) | (s1 >> 12);
+    b = ((s1 & 0xFFFU) << 11) | (s2 >> 7);
+    c = ((s2 & 0x7FU) << 18) | s3;
+}
+
+/**
+ * @brief Helper to scatter the A, B and C words back into a 72-bit AMBE frame.
+ */
+static inline void scatterAMBE(uint8_t* frame, uint32_t a, uint32_t b, uint32_t c)
+{
+    uint32_t s0 = (a >> 6) & 0x3FFFFU;
+    uint32_t s1 = ((a & 0x3FU) << 12) | ((b >> 11) & 0xFFFU);
+    uint32_t s2 = ((b & 0x7FFU) << 7) | ((c >> 18) & 0x7FU);
+    uint32_t s3 = c & 0x3FFFFU;
+
+    for (int i = 8; i >= 0; i--) {
+        uint32_t pairs = ((s0 & 0x03U) << 6) | ((s1 & 0x03U) << 4) | ((s2 & 0x03U) << 2) | (s3 & 0x03U);
+        frame[i] = AMBE_BYTE_TABLE.interleave[pairs];
+        s0 >>= 2; s1 >>= 2; s2 >>= 2; s3 >>= 2;
+    }
+}
+
+/**
+ * @brief Helper to copy the second AMBE frame of a DMR voice burst (which straddles the sync/embedded
+ *  signalling) into a contiguous 72-bit frame.
+ */
+static inline void getDMRFrame2(const uint8_t* bytes, uint8_t* frame)
+{
+    ::memcpy(frame, bytes + 9U, 4U);
+    frame[4U] = (bytes[13U] & 0xF0U) | (bytes[19U] & 0x0FU);
+    ::memcpy(frame + 5U, bytes + 20U, 4U);
+}
+
+/**
+ * @brief Helper to copy a contiguous 72-bit frame back as the second AMBE frame of a DMR voice burst.
+ */
+static inline void setDMRFrame2(uint8_t* bytes, const uint8_t* frame)
+{
+    ::memcpy(bytes + 9U, frame, 4U);
+    bytes[13U] = (bytes[13U] & 0x0FU) | (frame[4U] & 0xF0U);
+    bytes[19U] = (bytes[19U] & 0xF0U) | (frame[4U] & 0x0FU);
+    ::memcpy(bytes + 20U, frame + 5U, 4U);
+}
+
+/**
+ * @brief Helper to de-interleave a 144-bit IMBE frame into packed bytes.
+ *
+ *  IMBE_INTERLEAVE sends every 12-bit group of the frame to two adjacent bits of each of its
+ *  six 24-bit rows; the first 6 bits of a group are rows 0 - 5 in order, the last 6 are rows
+ *  1, 0, 3, 2, 5, 4.
+ */
+static inline void deinterleaveIMBE(const uint8_t* in, uint8_t* out)
+{
+    uint32_t rows[6U] = { 0U, 0U, 0U, 0U, 0U, 0U };
+
+    for (uint32_t m = 0U; m < 12U; m++) {
+        const uint8_t* p = in + ((m * 3U) >> 1);
+        uint32_t g = ((m & 0x01U) == 0U) ? ((p[0U] << 4) | (p[1U] >> 4)) : (((p[0U] & 0x0FU) << 8) | p[1U]);
+
+        uint32_t hi = g >> 6;
+        uint32_t lo = ((g & 0x2AU) >> 1) | ((g & 0x15U) << 1);
+        for (uint32_t r = 0U; r < 6U; r++)
+            rows[r] = (rows[r] << 2) | (((hi >> (5U - r)) & 0x01U) << 1) | ((lo >> (5U - r)) & 0x01U);
+    }
+
+    for (uint32_t r = 0U; r < 6U; r++) {
+        out[(r * 3U) + 0U] = (rows[r] >> 16) & 0xFFU;
+        out[(r * 3U) + 1U] = (rows[r] >> 8) & 0xFFU;
+        out[(r * 3U) + 2U] = (rows[r] >> 0) & 0xFFU;
+    }
+}
+
+/**
+ * @brief Helper to interleave packed bytes back into a 144-bit IMBE frame.
+ */
+static inline void interleaveIMBE(const uint8_t* in, uint8_t* out)
+{
+    uint32_t rows[6U];
+    for (uint32_t r = 0U; r < 6U; r++)
+        rows[r] = (in[(r * 3U) + 0U] << 16) | (in[(r * 3U) + 1U] << 8) | in[(r * 3U) + 2U];
+
+    for (uint32_t m = 0U; m < 12U; m++) {
+        uint32_t hi = 0U, lo = 0U;
+        for (uint32_t r = 0U; r < 6U; r++) {
+            uint32_t pair = (rows[r] >> (22U - (m * 2U))) & 0x03U;
+            hi |= (pair >> 1) << (5U - r);
+            lo |= (pair & 0x01U) << (5U - r);
+        }
+
+        uint32_t g = (hi << 6) | ((lo & 0x2AU) >> 1) | ((lo & 0x15U) << 1);
+
+        uint8_t* p = out + ((m * 3U) >> 1);
+        if ((m & 0x01U) == 0U) {
+            p[0U] = (g >> 4) & 0xFFU;
+            p[1U] = (p[1U] & 0x0FU) | ((g << 4) & 0xF0U);
+        } else {
+            p[0U] = (p[0U] & 0xF0U) | ((g >> 8) & 0x0FU);
+            p[1U] = g & 0xFFU;
+        }
+    }
+}
+
+/**
+ * @brief Helper to read up to 24 bits, MSB first, at the given bit offset.
+ */
+static inline uint32_t getBits(const uint8_t* in, uint32_t offset, uint32_t length)
+{
+    const uint8_t* p = in + (offset >> 3);
+    uint32_t w = ((uint32_t)p[0U] << 24) | ((uint32_t)p[1U] << 16) | ((uint32_t)p[2U] << 8) | (uint32_t)p[3U];
+    return (w << (offset & 7U)) >> (32U - length);
+}
+
+/**
+ * @brief Helper to write up to 24 bits, MSB first, at the given bit offset.
+ */
+static inline void setBits(uint8_t* out, uint32_t offset, uint32_t length, uint32_t value)
+{
+    uint8_t* p = out + (offset >> 3);
+    uint32_t shift = 32U - length - (offset & 7U);
+    uint32_t mask = ((1U << length) - 1U) << shift;
+
+    uint32_t w = ((uint32_t)p[0U] << 24) | ((uint32_t)p[1U] << 16) | ((uint32_t)p[2U] << 8) | (uint32_t)p[3U];
+    w = (w & ~mask) | ((value << shift) & mask);
+
+    p[0U] = (w >> 24) & 0xFFU;
+    p[1U] = (w >> 16) & 0xFFU;
+    p[2U] = (w >> 8) & 0xFFU;
+    p[3U] = (w >> 0) & 0xFFU;
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -43,96 +276,22 @@ uint32_t AMBEFEC::regenerateDMR(uint8_t* bytes) const
     uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
     uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
 
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
-    }
+    uint8_t frame2[9U];
+    getDMRFrame2(bytes, frame2);
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;
-    }
-
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        if (READ_BIT(bytes, c1Pos))
-            c1 |= MASK;
-        if (READ_BIT(bytes, c2Pos))
-            c2 |= MASK;
-        if (READ_BIT(bytes, c3Pos))
-            c3 |= MASK;
-    }
+    gatherAMBE(bytes, a1, b1, c1);
+    gatherAMBE(frame2, a2, b2, c2);
+    gatherAMBE(bytes + 24U, a3, b3, c3);
 
     uint32_t errors = regenerate(a1, b1, c1);
     errors += regenerate(a2, b2, c2);
     errors += regenerate(a3, b3, c3);
 
-    MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        WRITE_BIT(bytes, a1Pos, a1 & MASK);
-        WRITE_BIT(bytes, a2Pos, a2 & MASK);
-        WRITE_BIT(bytes, a3Pos, a3 & MASK);
-    }
+    scatterAMBE(bytes, a1, b1, c1);
+    scatterAMBE(frame2, a2, b2, c2);
+    scatterAMBE(bytes + 24U, a3, b3, c3);
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        WRITE_BIT(bytes, b1Pos, b1 & MASK);
-        WRITE_BIT(bytes, b2Pos, b2 & MASK);
-        WRITE_BIT(bytes, b3Pos, b3 & MASK);
-    }
-
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        WRITE_BIT(bytes, c1Pos, c1 & MASK);
-        WRITE_BIT(bytes, c2Pos, c2 & MASK);
-        WRITE_BIT(bytes, c3Pos, c3 & MASK);
-    }
+    setDMRFrame2(bytes, frame2);
 
     return errors;
 }
@@ -147,53 +306,12 @@ uint32_t AMBEFEC::measureDMRBER(const uint8_t* bytes) const
     uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
     uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
 
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
-    }
-
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;
-    }
+    uint8_t frame2[9U];
+    getDMRFrame2(bytes, frame2);
 
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        if (READ_BIT(bytes, c1Pos))
-            c1 |= MASK;
-        if (READ_BIT(bytes, c2Pos))
-            c2 |= MASK;
-        if (READ_BIT(bytes, c3Pos))
-            c3 |= MASK;
-    }
+    gatherAMBE(bytes, a1, b1, c1);
+    gatherAMBE(frame2, a2, b2, c2);
+    gatherAMBE(bytes + 24U, a3, b3, c3);
 
     uint32_t errors = regenerate(a1, b1, c1);
     errors += regenerate(a2, b2, c2);
@@ -208,133 +326,14 @@ uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    bool orig[144U];
-    bool temp[144U];
-
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
-    }
-
-    // now ..
-
-    // 12 voice bits     0
-    // 11 golay bits     12
-    //
-    // 12 voice bits     23
-    // 11 golay bits     35
-    //
-    // 12 voice bits     46
-    // 11 golay bits     58
-    //
-    // 12 voice bits     69
-    // 11 golay bits     81
-    //
-    // 11 voice bits     92
-    //  4 hamming bits   103
-    //
-    // 11 voice bits     107
-    //  4 hamming bits   118
-    //
-    // 11 voice bits     122
-    //  4 hamming bits   133
-    //
-    //  7 voice bits     137
-
-    // Process the c0 section first to allow the de-whitening to be accurate
-
-    // Check/Fix FEC
-    bool* bit = temp;
-
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    bool prn[114U];
-
-    // Create the whitening vector and save it for future use
-    uint32_t p = 16U * c0data;
-    for (uint32_t i = 0U; i < 114U; i++) {
-        p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
-    }
+    // packed de-interleaved frame (padded for the 32-bit field accessors)
+    uint8_t temp[IMBE_FRAME_LENGTH_BYTES + 2U];
+    ::memset(temp, 0x00U, sizeof(temp));
+    deinterleaveIMBE(bytes, temp);
 
-    // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
-
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
-
-    // c6
-    Hamming::decode15113_1(bit);
-
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
-
-    // Interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        WRITE_BIT(bytes, n, temp[i]);
-    }
+    uint32_t errors = regenerateIMBEBits(temp);
 
+    interleaveIMBE(temp, bytes);
     return errors;
 }
 
@@ -344,128 +343,11 @@ uint32_t AMBEFEC::measureP25BER(const uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    bool orig[144U];
-    bool temp[144U];
+    uint8_t temp[IMBE_FRAME_LENGTH_BYTES + 2U];
+    ::memset(temp, 0x00U, sizeof(temp));
+    deinterleaveIMBE(bytes, temp);
 
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
-    }
-
-    // now ..
-
-    // 12 voice bits     0
-    // 11 golay bits     12
-    //
-    // 12 voice bits     23
-    // 11 golay bits     35
-    //
-    // 12 voice bits     46
-    // 11 golay bits     58
-    //
-    // 12 voice bits     69
-    // 11 golay bits     81
-    //
-    // 11 voice bits     92
-    //  4 hamming bits   103
-    //
-    // 11 voice bits     107
-    //  4 hamming bits   118
-    //
-    // 11 voice bits     122
-    //  4 hamming bits   133
-    //
-    //  7 voice bits     137
-
-    // Process the c0 section first to allow the de-whitening to be accurate
-
-    // Check/Fix FEC
-    bool* bit = temp;
-
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    bool prn[114U];
-
-    // Create the whitening vector and save it for future use
-    uint32_t p = 16U * c0data;
-    for (uint32_t i = 0U; i < 114U; i++) {
-        p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
-    }
-
-    // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
-
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
-
-    // c6
-    Hamming::decode15113_1(bit);
-
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
-
-    return errors;
+    return regenerateIMBEBits(temp);
 }
 
 /* Regenerates the NXDN AMBE FEC for the input bytes. */
@@ -474,50 +356,12 @@ uint32_t AMBEFEC::regenerateNXDN(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    uint32_t a = 0U;
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        if (READ_BIT(bytes, aPos))
-            a |= MASK;
-    }
-
-    uint32_t b = 0U;
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        if (READ_BIT(bytes, bPos))
-            b |= MASK;
-    }
-
-    uint32_t c = 0U;
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        if (READ_BIT(bytes, cPos))
-            c |= MASK;
-    }
+    uint32_t a = 0U, b = 0U, c = 0U;
+    gatherAMBE(bytes, a, b, c);
 
     uint32_t errors = regenerate(a, b, c);
 
-    MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        WRITE_BIT(bytes, aPos, a & MASK);
-    }
-
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        WRITE_BIT(bytes, bPos, b & MASK);
-    }
-
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        WRITE_BIT(bytes, cPos, c & MASK);
-    }
-
+    scatterAMBE(bytes, a, b, c);
     return errors;
 }
 
@@ -527,29 +371,8 @@ uint32_t AMBEFEC::measureNXDNBER(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    uint32_t a = 0U;
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        if (READ_BIT(bytes, aPos))
-            a |= MASK;
-    }
-
-    uint32_t b = 0U;
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        if (READ_BIT(bytes, bPos))
-            b |= MASK;
-    }
-
-    uint32_t c = 0U;
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        if (READ_BIT(bytes, cPos))
-            c |= MASK;
-    }
+    uint32_t a = 0U, b = 0U, c = 0U;
+    gatherAMBE(bytes, a, b, c);
 
     uint32_t errors = regenerate(a, b, c);
     return errors;
@@ -606,3 +429,88 @@ uint32_t AMBEFEC::regenerate(uint32_t& a, uint32_t& b, uint32_t& c) const
 
     return errsA + errsB;
 }
+
+/* Regenerates a de-interleaved P25 IMBE frame in place. */
+
+uint32_t AMBEFEC::regenerateIMBEBits(uint8_t* bits) const
+{
+    uint8_t orig[IMBE_FRAME_LENGTH_BYTES];
+    ::memcpy(orig, bits, IMBE_FRAME_LENGTH_BYTES);
+
+    // now ..
+
+    // 12 voice bits     0
+    // 11 golay bits     12
+    //
+    // 12 voice bits     23
+    // 11 golay bits     35
+    //
+    // 12 voice bits     46
+    // 11 golay bits     58
+    //
+    // 12 voice bits     69
+    // 11 golay bits     81
+    //
+    // 11 voice bits     92
+    //  4 hamming bits   103
+    //
+    // 11 voice bits     107
+    //  4 hamming bits   118
+    //
+    // 11 voice bits     122
+    //  4 hamming bits   133
+    //
+    //  7 voice bits     137
+
+    // Process the c0 section first to allow the de-whitening to be accurate
+
+    // Check/Fix FEC; the Golay (23,12) codewords are re-encoded as 24 bits, so (as with the
+    // original bit-wise implementation) each one also rewrites the first bit of the next section
+
+    // c0
+    uint32_t c0data = Golay24128::decode23127(getBits(bits, 0U, 23U));
+    setBits(bits, 0U, 24U, Golay24128::encode23127(c0data));
+
+    // Create the whitening vector (bits 23 - 136)
+    uint8_t prn[IMBE_FRAME_LENGTH_BYTES];
+    ::memset(prn, 0x00U, IMBE_FRAME_LENGTH_BYTES);
+
+    uint32_t p = 16U * c0data;
+    uint32_t acc = 0U;
+    for (uint32_t i = 23U; i < 137U; i++) {
+        p = (173U * p + 13849U) & 0xFFFFU;
+        acc = (acc << 1) | (p >> 15);
+        if ((i & 7U) == 7U) {
+            prn[i >> 3] = (uint8_t)acc;
+            acc = 0U;
+        }
+    }
+    prn[136U >> 3] = (uint8_t)(acc << 7);
+
+    // De-whiten some bits
+    for (uint32_t i = 0U; i < IMBE_FRAME_LENGTH_BYTES; i++)
+        bits[i] ^= prn[i];
+
+    // c1 - c3
+    for (uint32_t offset = 23U; offset < 92U; offset += 23U) {
+        uint32_t data = Golay24128::decode23127(getBits(bits, offset, 23U));
+        setBits(bits, offset, 24U, Golay24128::encode23127(data));
+    }
+
+    // c4 - c6
+    for (uint32_t offset = 92U; offset < 137U; offset += 15U) {
+        uint32_t code = getBits(bits, offset, 15U);
+        uint32_t syndrome = HAMMING_15113_TABLE.syndromeHi[code >> 8] ^ HAMMING_15113_TABLE.syndromeLo[code & 0xFFU];
+        if (syndrome != 0U)
+            setBits(bits, offset, 15U, code ^ HAMMING_15113_TABLE.correction[syndrome]);
+    }
+
+    // Whiten some bits
+    uint32_t errors = 0U;
+    for (uint32_t i = 0U; i < IMBE_FRAME_LENGTH_BYTES; i++) {
+        bits[i] ^= prn[i];
+        errors += Utils::countBits8(bits[i] ^ orig[i]);
+    }
+
+    return errors;
+}
@@ -523,6 +523,12 @@ namespace edac
          * @returns uint32_t Count of errors.
          */
         uint32_t regenerate(uint32_t& a, uint32_t& b, uint32_t& c) const;
+        /**
+         * @brief Regenerates a de-interleaved P25 IMBE frame in place.
+         * @param bits Packed de-interleaved IMBE bits (padded by at least 2 bytes).
+         * @returns uint32_t Count of errors.
+         */
+        uint32_t regenerateIMBEBits(uint8_t* bits) const;
     };
 } // namespace edac
 
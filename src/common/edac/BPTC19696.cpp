@@ -6,16 +6,90 @@
  *
  *  Copyright (C) 2012 Ian Wraith
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
 #include "edac/BPTC19696.h"
-#include "edac/Hamming.h"
 #include "Utils.h"
 
 using namespace edac;
 
 #include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Bit position in the 33 byte burst of each deinterleaved matrix bit, in row order.
+ *  (The matrix bit at index a is raw bit (a * 181) % 196; raw bits 98 and up follow the
+ *  sync/embedded field in the middle of the burst. The unused R(3) bit is omitted.)
+ */
+const uint16_t INTERLEAVE_TABLE[] = {
+    249U, 234U, 219U, 204U, 189U, 174U, 91U, 76U, 61U, 46U, 31U, 16U, 1U, 250U, 235U,
+    220U, 205U, 190U, 175U, 92U, 77U, 62U, 47U, 32U, 17U, 2U, 251U, 236U, 221U, 206U,
+    191U, 176U, 93U, 78U, 63U, 48U, 33U, 18U, 3U, 252U, 237U, 222U, 207U, 192U, 177U,
+    94U, 79U, 64U, 49U, 34U, 19U, 4U, 253U, 238U, 223U, 208U, 193U, 178U, 95U, 80U,
+    65U, 50U, 35U, 20U, 5U, 254U, 239U, 224U, 209U, 194U, 179U, 96U, 81U, 66U, 51U,
+    36U, 21U, 6U, 255U, 240U, 225U, 210U, 195U, 180U, 97U, 82U, 67U, 52U, 37U, 22U,
+    7U, 256U, 241U, 226U, 211U, 196U, 181U, 166U, 83U, 68U, 53U, 38U, 23U, 8U, 257U,
+    242U, 227U, 212U, 197U, 182U, 167U, 84U, 69U, 54U, 39U, 24U, 9U, 258U, 243U, 228U,
+    213U, 198U, 183U, 168U, 85U, 70U, 55U, 40U, 25U, 10U, 259U, 244U, 229U, 214U, 199U,
+    184U, 169U, 86U, 71U, 56U, 41U, 26U, 11U, 260U, 245U, 230U, 215U, 200U, 185U, 170U,
+    87U, 72U, 57U, 42U, 27U, 12U, 261U, 246U, 231U, 216U, 201U, 186U, 171U, 88U, 73U,
+    58U, 43U, 28U, 13U, 262U, 247U, 232U, 217U, 202U, 187U, 172U, 89U, 74U, 59U, 44U,
+    29U, 14U, 263U, 248U, 233U, 218U, 203U, 188U, 173U, 90U, 75U, 60U, 45U, 30U, 15U };
+
+/**
+ * @brief Hamming (15,11,3) syndrome of bits 14-8 of a row word.
+ *  (The syndrome is linear, so the syndrome of a row is ROW_SYNDROME_HI[row >> 8] ^
+ *  ROW_SYNDROME_LO[row & 0xFF]; it is laid out like the row parity in bits 3-0.)
+ */
+const uint8_t ROW_SYNDROME_HI[] = {
+    0x00U, 0x05U, 0x0AU, 0x0FU, 0x07U, 0x02U, 0x0DU, 0x08U, 0x0EU, 0x0BU, 0x04U, 0x01U, 0x09U, 0x0CU, 0x03U, 0x06U,
+    0x0FU, 0x0AU, 0x05U, 0x00U, 0x08U, 0x0DU, 0x02U, 0x07U, 0x01U, 0x04U, 0x0BU, 0x0EU, 0x06U, 0x03U, 0x0CU, 0x09U,
+    0x0DU, 0x08U, 0x07U, 0x02U, 0x0AU, 0x0FU, 0x00U, 0x05U, 0x03U, 0x06U, 0x09U, 0x0CU, 0x04U, 0x01U, 0x0EU, 0x0BU,
+    0x02U, 0x07U, 0x08U, 0x0DU, 0x05U, 0x00U, 0x0FU, 0x0AU, 0x0CU, 0x09U, 0x06U, 0x03U, 0x0BU, 0x0EU, 0x01U, 0x04U,
+    0x09U, 0x0CU, 0x03U, 0x06U, 0x0EU, 0x0BU, 0x04U, 0x01U, 0x07U, 0x02U, 0x0DU, 0x08U, 0x00U, 0x05U, 0x0AU, 0x0FU,
+    0x06U, 0x03U, 0x0CU, 0x09U, 0x01U, 0x04U, 0x0BU, 0x0EU, 0x08U, 0x0DU, 0x02U, 0x07U, 0x0FU, 0x0AU, 0x05U, 0x00U,
+    0x04U, 0x01U, 0x0EU, 0x0BU, 0x03U, 0x06U, 0x09U, 0x0CU, 0x0AU, 0x0FU, 0x00U, 0x05U, 0x0DU, 0x08U, 0x07U, 0x02U,
+    0x0BU, 0x0EU, 0x01U, 0x04U, 0x0CU, 0x09U, 0x06U, 0x03U, 0x05U, 0x00U, 0x0FU, 0x0AU, 0x02U, 0x07U, 0x08U, 0x0DU };
+
+/**
+ * @brief Hamming (15,11,3) syndrome of bits 7-0 of a row word.
+ */
+const uint8_t ROW_SYNDROME_LO[] = {
+    0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU,
+    0x03U, 0x02U, 0x01U, 0x00U, 0x07U, 0x06U, 0x05U, 0x04U, 0x0BU, 0x0AU, 0x09U, 0x08U, 0x0FU, 0x0EU, 0x0DU, 0x0CU,
+    0x06U, 0x07U, 0x04U, 0x05U, 0x02U, 0x03U, 0x00U, 0x01U, 0x0EU, 0x0FU, 0x0CU, 0x0DU, 0x0AU, 0x0BU, 0x08U, 0x09U,
+    0x05U, 0x04U, 0x07U, 0x06U, 0x01U, 0x00U, 0x03U, 0x02U, 0x0DU, 0x0CU, 0x0FU, 0x0EU, 0x09U, 0x08U, 0x0BU, 0x0AU,
+    0x0CU, 0x0DU, 0x0EU, 0x0FU, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x04U, 0x05U, 0x06U, 0x07U, 0x00U, 0x01U, 0x02U, 0x03U,
+    0x0FU, 0x0EU, 0x0DU, 0x0CU, 0x0BU, 0x0AU, 0x09U, 0x08U, 0x07U, 0x06U, 0x05U, 0x04U, 0x03U, 0x02U, 0x01U, 0x00U,
+    0x0AU, 0x0BU, 0x08U, 0x09U, 0x0EU, 0x0FU, 0x0CU, 0x0DU, 0x02U, 0x03U, 0x00U, 0x01U, 0x06U, 0x07U, 0x04U, 0x05U,
+    0x09U, 0x08U, 0x0BU, 0x0AU, 0x0DU, 0x0CU, 0x0FU, 0x0EU, 0x01U, 0x00U, 0x03U, 0x02U, 0x05U, 0x04U, 0x07U, 0x06U,
+    0x0BU, 0x0AU, 0x09U, 0x08U, 0x0FU, 0x0EU, 0x0DU, 0x0CU, 0x03U, 0x02U, 0x01U, 0x00U, 0x07U, 0x06U, 0x05U, 0x04U,
+    0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU, 0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U,
+    0x0DU, 0x0CU, 0x0FU, 0x0EU, 0x09U, 0x08U, 0x0BU, 0x0AU, 0x05U, 0x04U, 0x07U, 0x06U, 0x01U, 0x00U, 0x03U, 0x02U,
+    0x0EU, 0x0FU, 0x0CU, 0x0DU, 0x0AU, 0x0BU, 0x08U, 0x09U, 0x06U, 0x07U, 0x04U, 0x05U, 0x02U, 0x03U, 0x00U, 0x01U,
+    0x07U, 0x06U, 0x05U, 0x04U, 0x03U, 0x02U, 0x01U, 0x00U, 0x0FU, 0x0EU, 0x0DU, 0x0CU, 0x0BU, 0x0AU, 0x09U, 0x08U,
+    0x04U, 0x05U, 0x06U, 0x07U, 0x00U, 0x01U, 0x02U, 0x03U, 0x0CU, 0x0DU, 0x0EU, 0x0FU, 0x08U, 0x09U, 0x0AU, 0x0BU,
+    0x01U, 0x00U, 0x03U, 0x02U, 0x05U, 0x04U, 0x07U, 0x06U, 0x09U, 0x08U, 0x0BU, 0x0AU, 0x0DU, 0x0CU, 0x0FU, 0x0EU,
+    0x02U, 0x03U, 0x00U, 0x01U, 0x06U, 0x07U, 0x04U, 0x05U, 0x0AU, 0x0BU, 0x08U, 0x09U, 0x0EU, 0x0FU, 0x0CU, 0x0DU };
+
+/**
+ * @brief Row word bit in error for each Hamming (15,11,3) row syndrome.
+ */
+const uint16_t ROW_ERROR_TABLE[] = {
+    0x0000U, 0x0001U, 0x0002U, 0x0010U, 0x0004U, 0x0100U, 0x0020U, 0x0400U,
+    0x0008U, 0x4000U, 0x0200U, 0x0080U, 0x0040U, 0x2000U, 0x0800U, 0x1000U };
+
+/**
+ * @brief Row in error for each Hamming (13,9,3) column syndrome (0xFF if not correctable).
+ */
+const uint8_t COLUMN_ERROR_TABLE[] = {
+    0xFFU, 9U, 10U, 6U, 11U, 3U, 7U, 1U, 12U, 0xFFU, 4U, 0xFFU, 8U, 5U, 2U, 0U };
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -24,20 +98,14 @@ using namespace edac;
 /* Initializes a new instance of the BPTC19696 class. */
 
 BPTC19696::BPTC19696() :
-    m_rawData(nullptr),
-    m_deInterData(nullptr)
+    m_rows()
 {
-    m_rawData = new bool[196];
-    m_deInterData = new bool[196];
+    /* stub */
 }
 
 /* Finalizes a instance of the BPTC19696 class. */
 
-BPTC19696::~BPTC19696()
-{
-    delete[] m_rawData;
-    delete[] m_deInterData;
-}
+BPTC19696::~BPTC19696() = default;
 
 /* Decode BPTC (196,96) FEC. */
 
@@ -46,11 +114,8 @@ void BPTC19696::decode(const uint8_t* in, uint8_t* out)
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // get the raw binary
-    decodeExtractBinary(in);
-
-    // deinterleave
-    decodeDeInterleave();
+    // deinterleave the raw binary
+    decodeDeInterleave(in);
 
     // error check
     decodeErrorCheck();
@@ -72,74 +137,30 @@ void BPTC19696::encode(const uint8_t* in, uint8_t* out)
     // error check
     encodeErrorCheck();
 
-    // interleave
-    encodeInterleave();
-
-    // get the raw binary
-    encodeExtractBinary(out);
+    // interleave into the raw binary
+    encodeInterleave(out);
 }
 
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* */
-
-void BPTC19696::decodeExtractBinary(const uint8_t* in)
-{
-    // first block
-    Utils::byteToBitsBE(in[0U], m_rawData + 0U);
-    Utils::byteToBitsBE(in[1U], m_rawData + 8U);
-    Utils::byteToBitsBE(in[2U], m_rawData + 16U);
-    Utils::byteToBitsBE(in[3U], m_rawData + 24U);
-    Utils::byteToBitsBE(in[4U], m_rawData + 32U);
-    Utils::byteToBitsBE(in[5U], m_rawData + 40U);
-    Utils::byteToBitsBE(in[6U], m_rawData + 48U);
-    Utils::byteToBitsBE(in[7U], m_rawData + 56U);
-    Utils::byteToBitsBE(in[8U], m_rawData + 64U);
-    Utils::byteToBitsBE(in[9U], m_rawData + 72U);
-    Utils::byteToBitsBE(in[10U], m_rawData + 80U);
-    Utils::byteToBitsBE(in[11U], m_rawData + 88U);
-    Utils::byteToBitsBE(in[12U], m_rawData + 96U);
-
-    // handle the two bits
-    bool bits[8U];
-    Utils::byteToBitsBE(in[20U], bits);
-    m_rawData[98U] = bits[6U];
-    m_rawData[99U] = bits[7U];
-
-    // second block
-    Utils::byteToBitsBE(in[21U], m_rawData + 100U);
-    Utils::byteToBitsBE(in[22U], m_rawData + 108U);
-    Utils::byteToBitsBE(in[23U], m_rawData + 116U);
-    Utils::byteToBitsBE(in[24U], m_rawData + 124U);
-    Utils::byteToBitsBE(in[25U], m_rawData + 132U);
-    Utils::byteToBitsBE(in[26U], m_rawData + 140U);
-    Utils::byteToBitsBE(in[27U], m_rawData + 148U);
-    Utils::byteToBitsBE(in[28U], m_rawData + 156U);
-    Utils::byteToBitsBE(in[29U], m_rawData + 164U);
-    Utils::byteToBitsBE(in[30U], m_rawData + 172U);
-    Utils::byteToBitsBE(in[31U], m_rawData + 180U);
-    Utils::byteToBitsBE(in[32U], m_rawData + 188U);
-}
-
-/* */
+/* Helper to deinterleave the raw binary into the row words. */
 
-void BPTC19696::decodeDeInterleave()
+void BPTC19696::decodeDeInterleave(const uint8_t* in)
 {
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
     // the first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // shuffle the data
-        m_deInterData[a] = m_rawData[interleaveSequence];
+    const uint16_t* pos = INTERLEAVE_TABLE;
+    for (uint32_t r = 0U; r < 13U; r++) {
+        uint32_t row = 0U;
+        for (uint32_t c = 0U; c < 15U; c++, pos++)
+            row = (row << 1) | ((in[*pos >> 3] >> (7U - (*pos & 7U))) & 0x01U);
+
+        m_rows[r] = (uint16_t)row;
     }
 }
 
-/* */
+/* Helper to iteratively correct the row words using the column and row Hamming codes. */
 
 void BPTC19696::decodeErrorCheck()
 {
@@ -148,214 +169,114 @@ void BPTC19696::decodeErrorCheck()
     do {
         fixing = false;
 
-        // run through each of the 15 columns
-        bool col[13U];
-        for (uint32_t c = 0U; c < 15U; c++) {
-            uint32_t pos = c + 1U;
-            for (uint32_t a = 0U; a < 13U; a++) {
-                col[a] = m_deInterData[pos];
-                pos = pos + 15U;
-            }
-
-            if (Hamming::decode1393(col)) {
-                uint32_t pos = c + 1U;
-                for (uint32_t a = 0U; a < 13U; a++) {
-                    m_deInterData[pos] = col[a];
-                    pos = pos + 15U;
-                }
-
+        // calculate the Hamming (13,9,3) syndrome of all 15 columns at once, each bit of
+        // s0 - s3 is the syndrome bit of the column in that bit position
+        uint32_t s0 = m_rows[0U] ^ m_rows[1U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[6U] ^ m_rows[9U];
+        uint32_t s1 = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[6U] ^ m_rows[7U] ^ m_rows[10U];
+        uint32_t s2 = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[7U] ^ m_rows[8U] ^ m_rows[11U];
+        uint32_t s3 = m_rows[0U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[5U] ^ m_rows[8U] ^ m_rows[12U];
+
+        // correct each column with a non-zero syndrome
+        uint32_t errors = s0 | s1 | s2 | s3;
+        while (errors != 0U) {
+            uint32_t bit = errors & (~errors + 1U);
+            errors &= ~bit;
+
+            uint32_t n = ((s0 & bit) ? 0x01U : 0x00U) | ((s1 & bit) ? 0x02U : 0x00U) |
+                ((s2 & bit) ? 0x04U : 0x00U) | ((s3 & bit) ? 0x08U : 0x00U);
+            uint8_t r = COLUMN_ERROR_TABLE[n];
+            if (r != 0xFFU) {
+                m_rows[r] ^= (uint16_t)bit;
                 fixing = true;
             }
         }
 
         // run through each of the 9 rows containing data
         for (uint32_t r = 0U; r < 9U; r++) {
-            uint32_t pos = (r * 15U) + 1U;
-            if (Hamming::decode15113_2(m_deInterData + pos))
+            uint8_t syndrome = ROW_SYNDROME_HI[m_rows[r] >> 8] ^ ROW_SYNDROME_LO[m_rows[r] & 0xFFU];
+            if (syndrome != 0U) {
+                m_rows[r] ^= ROW_ERROR_TABLE[syndrome];
                 fixing = true;
+            }
         }
 
         count++;
     } while (fixing && count < 5U);
 }
 
-/* */
+/* Helper to extract the data bits from the row words. */
 
 void BPTC19696::decodeExtractData(uint8_t* data) const
 {
-    bool bData[96U];
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    Utils::bitsToByteBE(bData + 0U, data[0U]);
-    Utils::bitsToByteBE(bData + 8U, data[1U]);
-    Utils::bitsToByteBE(bData + 16U, data[2U]);
-    Utils::bitsToByteBE(bData + 24U, data[3U]);
-    Utils::bitsToByteBE(bData + 32U, data[4U]);
-    Utils::bitsToByteBE(bData + 40U, data[5U]);
-    Utils::bitsToByteBE(bData + 48U, data[6U]);
-    Utils::bitsToByteBE(bData + 56U, data[7U]);
-    Utils::bitsToByteBE(bData + 64U, data[8U]);
-    Utils::bitsToByteBE(bData + 72U, data[9U]);
-    Utils::bitsToByteBE(bData + 80U, data[10U]);
-    Utils::bitsToByteBE(bData + 88U, data[11U]);
-}
-
-/* */
-
-void BPTC19696::encodeExtractData(const uint8_t* in) const
-{
-    bool bData[96U];
-    Utils::byteToBitsBE(in[0U], bData + 0U);
-    Utils::byteToBitsBE(in[1U], bData + 8U);
-    Utils::byteToBitsBE(in[2U], bData + 16U);
-    Utils::byteToBitsBE(in[3U], bData + 24U);
-    Utils::byteToBitsBE(in[4U], bData + 32U);
-    Utils::byteToBitsBE(in[5U], bData + 40U);
-    Utils::byteToBitsBE(in[6U], bData + 48U);
-    Utils::byteToBitsBE(in[7U], bData + 56U);
-    Utils::byteToBitsBE(in[8U], bData + 64U);
-    Utils::byteToBitsBE(in[9U], bData + 72U);
-    Utils::byteToBitsBE(in[10U], bData + 80U);
-    Utils::byteToBitsBE(in[11U], bData + 88U);
-
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    // row 0 carries 8 data bits (after R(2) - R(0)), rows 1 - 8 carry 11 data bits each
+    data[0U] = (uint8_t)(m_rows[0U] >> 4);
+
+    uint32_t bits = 0U, count = 0U, n = 1U;
+    for (uint32_t r = 1U; r < 9U; r++) {
+        bits = (bits << 11) | ((m_rows[r] >> 4) & 0x7FFU);
+        count += 11U;
+        while (count >= 8U) {
+            count -= 8U;
+            data[n++] = (uint8_t)(bits >> count);
+        }
+    }
 }
 
-/* */
+/* Helper to place the data bits into the row words. */
 
-void BPTC19696::encodeErrorCheck()
+void BPTC19696::encodeExtractData(const uint8_t* in)
 {
-    // run through each of the 9 rows containing data
-    for (uint32_t r = 0U; r < 9U; r++) {
-        uint32_t pos = (r * 15U) + 1U;
-        Hamming::encode15113_2(m_deInterData + pos);
-    }
-
-    // run through each of the 15 columns
-    bool col[13U];
-    for (uint32_t c = 0U; c < 15U; c++) {
-        uint32_t pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            col[a] = m_deInterData[pos];
-            pos = pos + 15U;
+    // row 0 carries 8 data bits (after R(2) - R(0)), rows 1 - 8 carry 11 data bits each
+    m_rows[0U] = (uint16_t)(in[0U] << 4);
+
+    uint32_t bits = 0U, count = 0U, n = 1U;
+    for (uint32_t r = 1U; r < 9U; r++) {
+        while (count < 11U) {
+            bits = (bits << 8) | in[n++];
+            count += 8U;
         }
 
-        Hamming::encode1393(col);
-
-        pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            m_deInterData[pos] = col[a];
-            pos = pos + 15U;
-        }
+        count -= 11U;
+        m_rows[r] = (uint16_t)(((bits >> count) & 0x7FFU) << 4);
     }
+
+    for (uint32_t r = 9U; r < 13U; r++)
+        m_rows[r] = 0U;
 }
 
-/* */
+/* Helper to calculate the row and column Hamming parity. */
 
-void BPTC19696::encodeInterleave()
+void BPTC19696::encodeErrorCheck()
 {
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_rawData[i] = false;
-
-    // the first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // unshuffle the data
-        m_rawData[interleaveSequence] = m_deInterData[a];
-    }
+    // run through each of the 9 rows containing data, with the parity bits clear the
+    // syndrome is the parity
+    for (uint32_t r = 0U; r < 9U; r++)
+        m_rows[r] |= ROW_SYNDROME_HI[m_rows[r] >> 8] ^ ROW_SYNDROME_LO[m_rows[r] & 0xFFU];
+
+    // calculate the Hamming (13,9,3) parity of all 15 columns at once
+    m_rows[9U] = m_rows[0U] ^ m_rows[1U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[6U];
+    m_rows[10U] = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[6U] ^ m_rows[7U];
+    m_rows[11U] = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[7U] ^ m_rows[8U];
+    m_rows[12U] = m_rows[0U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[5U] ^ m_rows[8U];
 }
 
-/* */
+/* Helper to interleave the row words into the raw binary. */
 
-void BPTC19696::encodeExtractBinary(uint8_t* data)
+void BPTC19696::encodeInterleave(uint8_t* data) const
 {
-    // first block
-    Utils::bitsToByteBE(m_rawData + 0U, data[0U]);
-    Utils::bitsToByteBE(m_rawData + 8U, data[1U]);
-    Utils::bitsToByteBE(m_rawData + 16U, data[2U]);
-    Utils::bitsToByteBE(m_rawData + 24U, data[3U]);
-    Utils::bitsToByteBE(m_rawData + 32U, data[4U]);
-    Utils::bitsToByteBE(m_rawData + 40U, data[5U]);
-    Utils::bitsToByteBE(m_rawData + 48U, data[6U]);
-    Utils::bitsToByteBE(m_rawData + 56U, data[7U]);
-    Utils::bitsToByteBE(m_rawData + 64U, data[8U]);
-    Utils::bitsToByteBE(m_rawData + 72U, data[9U]);
-    Utils::bitsToByteBE(m_rawData + 80U, data[10U]);
-    Utils::bitsToByteBE(m_rawData + 88U, data[11U]);
-
-    // handle the two bits
-    uint8_t byte;
-    Utils::bitsToByteBE(m_rawData + 96U, byte);
-    data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-    data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
-
-    // second block
-    Utils::bitsToByteBE(m_rawData + 100U, data[21U]);
-    Utils::bitsToByteBE(m_rawData + 108U, data[22U]);
-    Utils::bitsToByteBE(m_rawData + 116U, data[23U]);
-    Utils::bitsToByteBE(m_rawData + 124U, data[24U]);
-    Utils::bitsToByteBE(m_rawData + 132U, data[25U]);
-    Utils::bitsToByteBE(m_rawData + 140U, data[26U]);
-    Utils::bitsToByteBE(m_rawData + 148U, data[27U]);
-    Utils::bitsToByteBE(m_rawData + 156U, data[28U]);
-    Utils::bitsToByteBE(m_rawData + 164U, data[29U]);
-    Utils::bitsToByteBE(m_rawData + 172U, data[30U]);
-    Utils::bitsToByteBE(m_rawData + 180U, data[31U]);
-    Utils::bitsToByteBE(m_rawData + 188U, data[32U]);
+    // clear both halves of the payload, leaving the sync/embedded field between them untouched
+    ::memset(data, 0x00U, 12U);
+    data[12U] &= 0x3FU;
+    data[20U] &= 0xFCU;
+    ::memset(data + 21U, 0x00U, 12U);
+
+    // the first bit is R(3) which is not used so is left clear
+    const uint16_t* pos = INTERLEAVE_TABLE;
+    for (uint32_t r = 0U; r < 13U; r++) {
+        uint32_t row = m_rows[r];
+        for (uint32_t c = 0U; c < 15U; c++, pos++, row <<= 1) {
+            if ((row & 0x4000U) != 0U)
+                data[*pos >> 3] |= BIT_MASK_TABLE[*pos & 7U];
+        }
+    }
 }
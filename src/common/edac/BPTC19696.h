@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -26,6 +27,11 @@ namespace edac
 
     /**
      * @brief Implements Block Product Turbo Code (196,96) FEC.
+     *
+     *  The deinterleaved 13 x 15 bit product code matrix is held as one 15-bit word per row
+     *  (column 0 in the most significant bit). Rows are checked with a syndrome table lookup,
+     *  and all 15 columns are checked at once by computing each column syndrome bit across
+     *  the row words.
      * @ingroup edac
      */
     class HOST_SW_API BPTC19696 {
@@ -53,45 +59,37 @@ namespace edac
         void encode(const uint8_t* in, uint8_t* out);
 
     private:
-        bool* m_rawData;
-        bool* m_deInterData;
+        uint16_t m_rows[13U];
 
         /**
-         * @brief 
-         * @param in
+         * @brief Helper to deinterleave the raw binary into the row words.
+         * @param[in] in Input data to decode.
          */
-        void decodeExtractBinary(const uint8_t* in);
+        void decodeDeInterleave(const uint8_t* in);
         /**
-         * @brief 
+         * @brief Helper to iteratively correct the row words using the column and row Hamming codes.
          */
         void decodeErrorCheck();
         /**
-         * @brief 
-         */
-        void decodeDeInterleave();
-        /**
-         * @brief 
-         * @param data 
+         * @brief Helper to extract the data bits from the row words.
+         * @param[out] data Decoded data.
          */
         void decodeExtractData(uint8_t* data) const;
 
         /**
-         * @brief 
-         */
-        void encodeExtractData(const uint8_t* in) const;
-        /**
-         * @brief 
+         * @brief Helper to place the data bits into the row words.
+         * @param[in] in Input data to encode.
          */
-        void encodeInterleave();
+        void encodeExtractData(const uint8_t* in);
         /**
-         * @brief 
+         * @brief Helper to calculate the row and column Hamming parity.
          */
         void encodeErrorCheck();
         /**
-         * @brief 
-         * @param data 
+         * @brief Helper to interleave the row words into the raw binary.
+         * @param[out] data Encoded data.
          */
-        void encodeExtractBinary(uint8_t* data);
+        void encodeInterleave(uint8_t* data) const;
     };
 } // namespace edac
 
@@ -113,39 +113,105 @@ const uint16_t CCITT16_TABLE2[] = {
     0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
     0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0 };
 
-const uint32_t CRC32_TABLE[] = {
-    0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
-    0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
-    0x4C11DB70, 0x48D0C6C7, 0x4593E01E, 0x4152FDA9, 0x5F15ADAC, 0x5BD4B01B, 0x569796C2, 0x52568B75,
-    0x6A1936C8, 0x6ED82B7F, 0x639B0DA6, 0x675A1011, 0x791D4014, 0x7DDC5DA3, 0x709F7B7A, 0x745E66CD,
-    0x9823B6E0, 0x9CE2AB57, 0x91A18D8E, 0x95609039, 0x8B27C03C, 0x8FE6DD8B, 0x82A5FB52, 0x8664E6E5,
-    0xBE2B5B58, 0xBAEA46EF, 0xB7A96036, 0xB3687D81, 0xAD2F2D84, 0xA9EE3033, 0xA4AD16EA, 0xA06C0B5D,
-    0xD4326D90, 0xD0F37027, 0xDDB056FE, 0xD9714B49, 0xC7361B4C, 0xC3F706FB, 0xCEB42022, 0xCA753D95,
-    0xF23A8028, 0xF6FB9D9F, 0xFBB8BB46, 0xFF79A6F1, 0xE13EF6F4, 0xE5FFEB43, 0xE8BCCD9A, 0xEC7DD02D,
-    0x34867077, 0x30476DC0, 0x3D044B19, 0x39C556AE, 0x278206AB, 0x23431B1C, 0x2E003DC5, 0x2AC12072,
-    0x128E9DCF, 0x164F8078, 0x1B0CA6A1, 0x1FCDBB16, 0x018AEB13, 0x054BF6A4, 0x0808D07D, 0x0CC9CDCA,
-    0x7897AB07, 0x7C56B6B0, 0x71159069, 0x75D48DDE, 0x6B93DDDB, 0x6F52C06C, 0x6211E6B5, 0x66D0FB02,
-    0x5E9F46BF, 0x5A5E5B08, 0x571D7DD1, 0x53DC6066, 0x4D9B3063, 0x495A2DD4, 0x44190B0D, 0x40D816BA,
-    0xACA5C697, 0xA864DB20, 0xA527FDF9, 0xA1E6E04E, 0xBFA1B04B, 0xBB60ADFC, 0xB6238B25, 0xB2E29692,
-    0x8AAD2B2F, 0x8E6C3698, 0x832F1041, 0x87EE0DF6, 0x99A95DF3, 0x9D684044, 0x902B669D, 0x94EA7B2A,
-    0xE0B41DE7, 0xE4750050, 0xE9362689, 0xEDF73B3E, 0xF3B06B3B, 0xF771768C, 0xFA325055, 0xFEF34DE2,
-    0xC6BCF05F, 0xC27DEDE8, 0xCF3ECB31, 0xCBFFD686, 0xD5B88683, 0xD1799B34, 0xDC3ABDED, 0xD8FBA05A,
-    0x690CE0EE, 0x6DCDFD59, 0x608EDB80, 0x644FC637, 0x7A089632, 0x7EC98B85, 0x738AAD5C, 0x774BB0EB,
-    0x4F040D56, 0x4BC510E1, 0x46863638, 0x42472B8F, 0x5C007B8A, 0x58C1663D, 0x558240E4, 0x51435D53,
-    0x251D3B9E, 0x21DC2629, 0x2C9F00F0, 0x285E1D47, 0x36194D42, 0x32D850F5, 0x3F9B762C, 0x3B5A6B9B,
-    0x0315D626, 0x07D4CB91, 0x0A97ED48, 0x0E56F0FF, 0x1011A0FA, 0x14D0BD4D, 0x19939B94, 0x1D528623,
-    0xF12F560E, 0xF5EE4BB9, 0xF8AD6D60, 0xFC6C70D7, 0xE22B20D2, 0xE6EA3D65, 0xEBA91BBC, 0xEF68060B,
-    0xD727BBB6, 0xD3E6A601, 0xDEA580D8, 0xDA649D6F, 0xC423CD6A, 0xC0E2D0DD, 0xCDA1F604, 0xC960EBB3,
-    0xBD3E8D7E, 0xB9FF90C9, 0xB4BCB610, 0xB07DABA7, 0xAE3AFBA2, 0xAAFBE615, 0xA7B8C0CC, 0xA379DD7B,
-    0x9B3660C6, 0x9FF77D71, 0x92B45BA8, 0x9675461F, 0x8832161A, 0x8CF30BAD, 0x81B02D74, 0x857130C3,
-    0x5D8A9099, 0x594B8D2E, 0x5408ABF7, 0x50C9B640, 0x4E8EE645, 0x4A4FFBF2, 0x470CDD2B, 0x43CDC09C,
-    0x7B827D21, 0x7F436096, 0x7200464F, 0x76C15BF8, 0x68860BFD, 0x6C47164A, 0x61043093, 0x65C52D24,
-    0x119B4BE9, 0x155A565E, 0x18197087, 0x1CD86D30, 0x029F3D35, 0x065E2082, 0x0B1D065B, 0x0FDC1BEC,
-    0x3793A651, 0x3352BBE6, 0x3E119D3F, 0x3AD08088, 0x2497D08D, 0x2056CD3A, 0x2D15EBE3, 0x29D4F654,
-    0xC5A92679, 0xC1683BCE, 0xCC2B1D17, 0xC8EA00A0, 0xD6AD50A5, 0xD26C4D12, 0xDF2F6BCB, 0xDBEE767C,
-    0xE3A1CBC1, 0xE760D676, 0xEA23F0AF, 0xEEE2ED18, 0xF0A5BD1D, 0xF464A0AA, 0xF9278673, 0xFDE69BC4,
-    0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662, 0x933EB0BB, 0x97FFAD0C,
-    0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668, 0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4 };
+/**
+ * @brief Byte-at-a-time lookup table for a MSB-first CRC of less than or equal to 16 bits.
+ *
+ *  The CRC register is kept left-aligned in 16 bits, so a single table form serves every
+ *  width; entry n is the register after clocking 8 zero bits through a register of n << 8.
+ */
+template<uint32_t WIDTH, uint16_t POLY>
+struct CRCByteTable {
+    uint16_t table[256U];
+
+    constexpr CRCByteTable() : table()
+    {
+        for (uint32_t i = 0U; i < 256U; i++) {
+            uint16_t crc = (uint16_t)(i << 8);
+            for (uint32_t j = 0U; j < 8U; j++) {
+                if ((crc & 0x8000U) == 0x8000U)
+                    crc = (uint16_t)((crc << 1) ^ (POLY << (16U - WIDTH)));
+                else
+                    crc = (uint16_t)(crc << 1);
+            }
+
+            table[i] = crc;
+        }
+    }
+};
+
+/**
+ * @brief Slice-by-8 lookup tables for the MSB-first 32-bit CRC (polynomial 0x04C11DB7).
+ *
+ *  table[0] is the classic byte-at-a-time table; table[k] advances a byte through k further
+ *  zero bytes.
+ */
+struct CRC32SliceTable {
+    uint32_t table[8U][256U];
+
+    constexpr CRC32SliceTable() : table()
+    {
+        for (uint32_t i = 0U; i < 256U; i++) {
+            uint32_t crc = i << 24;
+            for (uint32_t j = 0U; j < 8U; j++) {
+                if ((crc & 0x80000000U) == 0x80000000U)
+                    crc = (crc << 1) ^ 0x04C11DB7U;
+                else
+                    crc = crc << 1;
+            }
+
+            table[0U][i] = crc;
+        }
+
+        for (uint32_t k = 1U; k < 8U; k++) {
+            for (uint32_t i = 0U; i < 256U; i++) {
+                uint32_t crc = table[k - 1U][i];
+                table[k][i] = (crc << 8) ^ table[0U][crc >> 24];
+            }
+        }
+    }
+};
+
+constexpr CRCByteTable<6U, 0x27U> CRC6_TABLE;
+constexpr CRCByteTable<9U, 0x59U> CRC9_TABLE;
+constexpr CRCByteTable<12U, 0x080FU> CRC12_TABLE;
+constexpr CRCByteTable<15U, 0x4CC5U> CRC15_TABLE;
+constexpr CRCByteTable<16U, 0x1021U> CRC16_TABLE;
+
+constexpr CRC32SliceTable CRC32_TABLE;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to generate a MSB-first CRC of less than or equal to 16 bits over an arbitrary bit length.
+ *
+ *  Whole bytes are processed through the lookup table; any trailing bits (when the bit length
+ *  is not byte aligned) are clocked in one at a time.
+ */
+template<uint32_t WIDTH, uint16_t POLY>
+static inline uint16_t createCRCBits(const CRCByteTable<WIDTH, POLY>& table, const uint8_t* in, uint32_t bitLength, uint16_t init)
+{
+    const uint32_t shift = 16U - WIDTH;
+
+    uint16_t crc = (uint16_t)(init << shift);
+
+    uint32_t byteLength = bitLength >> 3;
+    for (uint32_t i = 0U; i < byteLength; i++)
+        crc = (uint16_t)(crc << 8) ^ table.table[(crc >> 8) ^ in[i]];
+
+    for (uint32_t i = byteLength << 3; i < bitLength; i++) {
+        bool bit1 = READ_BIT(in, i) != 0x00U;
+        bool bit2 = (crc & 0x8000U) == 0x8000U;
+
+        crc = (uint16_t)(crc << 1);
+
+        if (bit1 ^ bit2)
+            crc ^= (uint16_t)(POLY << shift);
+    }
+
+    return crc >> shift;
+}
 
 // ---------------------------------------------------------------------------
 //  Static Class Members
@@ -296,28 +362,15 @@ bool CRC::checkCRC32(const uint8_t *in, uint32_t length)
     assert(in != nullptr);
     assert(length > 4U);
 
-    union {
-        uint32_t crc32;
-        uint8_t  crc8[4U];
-    };
-
-    uint32_t i = 0;
-    crc32 = 0x00000000U;
-
-    for (uint32_t j = (length - 4U); j-- > 0; i++) {
-        uint32_t idx = ((crc32 >> 24) ^ in[i]) & 0xFFU;
-        crc32 = (CRC32_TABLE[idx] ^ (crc32 << 8)) & 0xFFFFFFFFU;
-    }
-
-    crc32 = ~crc32;
-    crc32 &= 0xFFFFFFFFU;
+    uint32_t crc32 = createCRC32(in, length - 4U);
 
 #if DEBUG_CRC_CHECK
     uint32_t inCrc = (in[length - 4U] << 24) | (in[length - 3U] << 16) | (in[length - 2U] << 8) | (in[length - 1U] << 0);
     LogDebug(LOG_HOST, "CRC::checkCRC32(), crc = $%08X, in = $%08X, len = %u", crc32, inCrc, length);
 #endif
 
-    return crc8[0U] == in[length - 1U] && crc8[1U] == in[length - 2U] && crc8[2U] == in[length - 3U] && crc8[3U] == in[length - 4U];
+    return in[length - 1U] == ((crc32 >> 0) & 0xFFU) && in[length - 2U] == ((crc32 >> 8) & 0xFFU) && 
+        in[length - 3U] == ((crc32 >> 16) & 0xFFU) && in[length - 4U] == ((crc32 >> 24) & 0xFFU);
 }
 
 /* Encode 32-bit CRC. */
@@ -327,30 +380,16 @@ void CRC::addCRC32(uint8_t* in, uint32_t length)
     assert(in != nullptr);
     assert(length > 4U);
 
-    union {
-        uint32_t crc32;
-        uint8_t  crc8[4U];
-    };
-
-    uint32_t i = 0;
-    crc32 = 0x00000000U;
-
-    for (uint32_t j = (length - 4U); j-- > 0; i++) {
-        uint32_t idx = ((crc32 >> 24) ^ in[i]) & 0xFFU;
-        crc32 = (CRC32_TABLE[idx] ^ (crc32 << 8)) & 0xFFFFFFFFU;
-    }
-
-    crc32 = ~crc32;
-    crc32 &= 0xFFFFFFFFU;
+    uint32_t crc32 = createCRC32(in, length - 4U);
 
 #if DEBUG_CRC_ADD
     LogDebug(LOG_HOST, "CRC::addCRC32(), crc = $%08X, len = %u", crc32, length);
 #endif
 
-    in[length - 1U] = crc8[0U];
-    in[length - 2U] = crc8[1U];
-    in[length - 3U] = crc8[2U];
-    in[length - 4U] = crc8[3U];
+    in[length - 1U] = (crc32 >> 0) & 0xFFU;
+    in[length - 2U] = (crc32 >> 8) & 0xFFU;
+    in[length - 3U] = (crc32 >> 16) & 0xFFU;
+    in[length - 4U] = (crc32 >> 24) & 0xFFU;
 }
 
 /* Generate 8-bit CRC. */
@@ -576,17 +615,7 @@ uint16_t CRC::addCRC16(uint8_t* in, uint32_t bitLength)
 
 uint16_t CRC::createCRC9(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0U;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x100U) == 0x100U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x59U;
-    }
+    uint16_t crc = createCRCBits(CRC9_TABLE, in, bitLength, 0x000U);
 
     crc = ~crc;
     return crc & 0x1FFU;
@@ -596,19 +625,7 @@ uint16_t CRC::createCRC9(const uint8_t* in, uint32_t bitLength)
 
 uint16_t CRC::createCRC16(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0xFFFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x8000U) == 0x8000U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x1021U;
-    }
-
-    return crc & 0xFFFFU;
+    return createCRCBits(CRC16_TABLE, in, bitLength, 0xFFFFU);
 }
 
 // ---------------------------------------------------------------------------
@@ -619,55 +636,43 @@ uint16_t CRC::createCRC16(const uint8_t* in, uint32_t bitLength)
 
 uint8_t CRC::createCRC6(const uint8_t* in, uint32_t bitLength)
 {
-    uint8_t crc = 0x3FU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x20U) == 0x20U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x27U;
-    }
-
-    return crc & 0x3FU;
+    return (uint8_t)createCRCBits(CRC6_TABLE, in, bitLength, 0x3FU);
 }
 
 /* Generate 12-bit CRC. */
 
 uint16_t CRC::createCRC12(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0x0FFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x0800U) == 0x0800U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x080FU;
-    }
-
-    return crc & 0x0FFFU;
+    return createCRCBits(CRC12_TABLE, in, bitLength, 0x0FFFU);
 }
 
 /* Generate 15-bit CRC. */
 
 uint16_t CRC::createCRC15(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0x7FFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x4000U) == 0x4000U;
+    return createCRCBits(CRC15_TABLE, in, bitLength, 0x7FFFU);
+}
 
-        crc <<= 1;
+/* Generate 32-bit CRC. */
 
-        if (bit1 ^ bit2)
-            crc ^= 0x4CC5U;
+uint32_t CRC::createCRC32(const uint8_t* in, uint32_t length)
+{
+    const uint32_t (&table)[8U][256U] = CRC32_TABLE.table;
+
+    uint32_t crc = 0x00000000U;
+    uint32_t i = 0U;
+
+    // slice-by-8; fold 8 bytes per iteration through 8 independent table lookups
+    for (; i + 8U <= length; i += 8U) {
+        uint32_t hi = crc ^ (((uint32_t)in[i + 0U] << 24) | ((uint32_t)in[i + 1U] << 16) | ((uint32_t)in[i + 2U] << 8) | ((uint32_t)in[i + 3U] << 0));
+        crc = table[7U][(hi >> 24) & 0xFFU] ^ table[6U][(hi >> 16) & 0xFFU] ^ 
+            table[5U][(hi >> 8) & 0xFFU] ^ table[4U][(hi >> 0) & 0xFFU] ^
+            table[3U][in[i + 4U]] ^ table[2U][in[i + 5U]] ^ 
+            table[1U][in[i + 6U]] ^ table[0U][in[i + 7U]];
     }
 
-    return crc & 0x7FFFU;
+    for (; i < length; i++)
+        crc = (crc << 8) ^ table[0U][((crc >> 24) ^ in[i]) & 0xFFU];
+
+    return ~crc;
 }
@@ -182,6 +182,13 @@ namespace edac
          * @returns uint16_t 16-bit CRC.
          */
         static uint16_t createCRC16(const uint8_t* in, uint32_t bitLength);
+        /**
+         * @brief Generate 32-bit CRC.
+         * @param[in] in Input byte array.
+         * @param length Length of byte array.
+         * @returns uint32_t 32-bit CRC.
+         */
+        static uint32_t createCRC32(const uint8_t* in, uint32_t length);
 
     private:
         /**
@@ -20,12 +20,6 @@ using namespace lookups;
 
 const uint32_t UNIT_REG_TIMEOUT = 43200U; // 12 hours
 
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::mutex AffiliationLookup::m_mutex;
-
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -37,6 +31,7 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
     m_unitRegTable(),
     m_unitRegTimers(),
     m_grpAffTable(),
+    m_grpAffByDstTable(),
     m_grantChTable(),
     m_grantSrcIdTable(),
     m_uuGrantedTable(),
@@ -46,7 +41,9 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
     m_name(),
     m_chLookup(channelLookup),
     m_disableUnitRegTimeout(false),
-    m_verbose(verbose)
+    m_verbose(verbose),
+    m_affMutex(),
+    m_grantMutex()
 {
     assert(channelLookup != nullptr);
 
@@ -55,6 +52,7 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
     m_unitRegTable.clear();
     m_unitRegTimers.clear();
     m_grpAffTable.clear();
+    m_grpAffByDstTable.clear();
 
     m_grantChTable.clear();
     m_grantSrcIdTable.clear();
@@ -65,16 +63,23 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
 
 AffiliationLookup::~AffiliationLookup() = default;
 
+/* Gets the unit registration table. */
+
+std::vector<uint32_t> AffiliationLookup::unitRegTable() const
+{
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return std::vector<uint32_t>(m_unitRegTable.begin(), m_unitRegTable.end());
+}
+
 /* Helper to group affiliate a source ID. */
 
 void AffiliationLookup::unitReg(uint32_t srcId)
 {
-    if (isUnitReg(srcId)) {
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    if (!m_unitRegTable.insert(srcId).second) {
         return;
     }
 
-    m_unitRegTable.push_back(srcId);
-
     m_unitRegTimers[srcId] = Timer(1000U, UNIT_REG_TIMEOUT);
     m_unitRegTimers[srcId].start();
 
@@ -88,35 +93,30 @@ void AffiliationLookup::unitReg(uint32_t srcId)
 
 bool AffiliationLookup::unitDereg(uint32_t srcId, bool automatic)
 {
-    bool ret = false;
-
-    if (!isUnitReg(srcId)) {
-        return false;
-    }
-
-    if (m_verbose) {
-        LogMessage(LOG_HOST, "%s, unit deregistration, srcId = %u",
-            m_name.c_str(), srcId);
-    }
+    {
+        std::lock_guard<std::mutex> lock(m_affMutex);
+        if (m_unitRegTable.find(srcId) == m_unitRegTable.end()) {
+            return false;
+        }
 
-    groupUnaff(srcId);
+        if (m_verbose) {
+            LogMessage(LOG_HOST, "%s, unit deregistration, srcId = %u",
+                m_name.c_str(), srcId);
+        }
 
-    m_unitRegTimers[srcId].stop();
+        removeGrpAff(srcId);
 
-    // remove dynamic unit registration table entry
-    if (std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId) != m_unitRegTable.end()) {
-        auto it = std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId);
-        m_unitRegTable.erase(it);
-        ret = true;
+        // remove dynamic unit registration table entry
+        m_unitRegTimers.erase(srcId);
+        m_unitRegTable.erase(srcId);
     }
 
-    if (ret) {
-        if (m_unitDereg != nullptr) {
-            m_unitDereg(srcId, automatic);
-        }
+    // callback is made outside of the lock, so it may safely call back into the lookup table
+    if (m_unitDereg != nullptr) {
+        m_unitDereg(srcId, automatic);
     }
 
-    return ret;
+    return true;
 }
 
 /* Helper to start the source ID registration timer. */
@@ -127,8 +127,10 @@ void AffiliationLookup::touchUnitReg(uint32_t srcId)
         return;
     }
 
-    if (isUnitReg(srcId)) {
-        m_unitRegTimers[srcId].start();
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_unitRegTimers.find(srcId);
+    if (it != m_unitRegTimers.end()) {
+        it->second.start();
     }
 }
 
@@ -140,8 +142,10 @@ uint32_t AffiliationLookup::unitRegTimeout(uint32_t srcId)
         return 0U;
     }
 
-    if (isUnitReg(srcId)) {
-        return m_unitRegTimers[srcId].getTimeout();
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_unitRegTimers.find(srcId);
+    if (it != m_unitRegTimers.end()) {
+        return it->second.getTimeout();
     }
 
     return 0U;
@@ -155,8 +159,10 @@ uint32_t AffiliationLookup::unitRegTimer(uint32_t srcId)
         return 0U;
     }
 
-    if (isUnitReg(srcId)) {
-        return m_unitRegTimers[srcId].getTimer();
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_unitRegTimers.find(srcId);
+    if (it != m_unitRegTimers.end()) {
+        return it->second.getTimer();
     }
 
     return 0U;
@@ -167,76 +173,97 @@ uint32_t AffiliationLookup::unitRegTimer(uint32_t srcId)
 bool AffiliationLookup::isUnitReg(uint32_t srcId) const
 {
     // lookup dynamic unit registration table entry
-    if (std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId) != m_unitRegTable.end()) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return m_unitRegTable.find(srcId) != m_unitRegTable.end();
 }
 
 /* Helper to release unit registrations. */
 
 void AffiliationLookup::clearUnitReg()
 {
-    std::vector<uint32_t> srcToRel = std::vector<uint32_t>();
     LogWarning(LOG_HOST, "%s, releasing all unit registrations", m_name.c_str());
+
+    std::lock_guard<std::mutex> lock(m_affMutex);
     m_unitRegTable.clear();
+    m_unitRegTimers.clear();
+}
+
+/* Gets the group affiliation table. */
+
+std::unordered_map<uint32_t, uint32_t> AffiliationLookup::grpAffTable() const
+{
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return m_grpAffTable;
+}
+
+/* Helper to iterate the group affiliation table without copying it. */
+
+void AffiliationLookup::forEachGrpAff(std::function<void(uint32_t, uint32_t)> visitor) const
+{
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    for (const auto& entry : m_grpAffTable) {
+        visitor(entry.first, entry.second);
+    }
+}
+
+/* Gets the count of affiliations to the given group destination ID. */
+
+uint32_t AffiliationLookup::grpAffSize(uint32_t dstId) const
+{
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_grpAffByDstTable.find(dstId);
+    if (it != m_grpAffByDstTable.end()) {
+        return it->second.size();
+    }
+
+    return 0U;
 }
 
 /* Helper to group affiliate a source ID. */
 
 void AffiliationLookup::groupAff(uint32_t srcId, uint32_t dstId)
 {
-    if (!isGroupAff(srcId, dstId)) {
-        // update dynamic affiliation table
-        m_grpAffTable[srcId] = dstId;
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_grpAffTable.find(srcId);
+    if (it != m_grpAffTable.end()) {
+        if (it->second == dstId) {
+            return;
+        }
 
-        if (m_verbose) {
-            LogMessage(LOG_HOST, "%s, group affiliation, srcId = %u, dstId = %u",
-                m_name.c_str(), srcId, dstId);
+        // source ID is moving from another talkgroup, drop it from the old talkgroup
+        auto dstIt = m_grpAffByDstTable.find(it->second);
+        if (dstIt != m_grpAffByDstTable.end()) {
+            dstIt->second.erase(srcId);
+            if (dstIt->second.empty()) {
+                m_grpAffByDstTable.erase(dstIt);
+            }
         }
     }
+
+    // update dynamic affiliation table
+    m_grpAffTable[srcId] = dstId;
+    m_grpAffByDstTable[dstId].insert(srcId);
+
+    if (m_verbose) {
+        LogMessage(LOG_HOST, "%s, group affiliation, srcId = %u, dstId = %u",
+            m_name.c_str(), srcId, dstId);
+    }
 }
 
 /* Helper to group unaffiliate a source ID. */
 
 bool AffiliationLookup::groupUnaff(uint32_t srcId)
 {
-    // lookup dynamic affiliation table entry
-    if (m_grpAffTable.find(srcId) != m_grpAffTable.end()) {
-        uint32_t tblDstId = m_grpAffTable.at(srcId);
-        if (m_verbose) {
-            LogMessage(LOG_HOST, "%s, group unaffiliation, srcId = %u, dstId = %u",
-                m_name.c_str(), srcId, tblDstId);
-        }
-    } else {
-        return false;
-    }
-
-    // remove dynamic affiliation table entry
-    try {
-        uint32_t entry = m_grpAffTable.at(srcId); // this value will get discarded
-        (void)entry;                              // but some variants of C++ mark the unordered_map<>::at as nodiscard
-        m_grpAffTable.erase(srcId);
-        return true;
-    }
-    catch (...) {
-        return false;
-    }
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return removeGrpAff(srcId);
 }
 
 /* Helper to determine if the group destination ID has any affiations. */
 
 bool AffiliationLookup::hasGroupAff(uint32_t dstId) const
 {
-    for (auto entry : m_grpAffTable) {
-        if (entry.second == dstId) {
-            return true;
-        }
-    }
-
-    return false;
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return m_grpAffByDstTable.find(dstId) != m_grpAffByDstTable.end();
 }
 
 /* Helper to determine if the source ID has affiliated to the group destination ID. */
@@ -244,14 +271,10 @@ bool AffiliationLookup::hasGroupAff(uint32_t dstId) const
 bool AffiliationLookup::isGroupAff(uint32_t srcId, uint32_t dstId) const
 {
     // lookup dynamic affiliation table entry
-    if (m_grpAffTable.find(srcId) != m_grpAffTable.end()) {
-        uint32_t tblDstId = m_grpAffTable.at(srcId);
-        if (tblDstId == dstId) {
-            return true;
-        }
-        else {
-            return false;
-        }
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_grpAffTable.find(srcId);
+    if (it != m_grpAffTable.end()) {
+        return it->second == dstId;
     }
 
     return false;
@@ -266,31 +289,51 @@ std::vector<uint32_t> AffiliationLookup::clearGroupAff(uint32_t dstId, bool rele
         return srcToRel;
     }
 
+    std::lock_guard<std::mutex> lock(m_affMutex);
     if (dstId == 0U && releaseAll) {
         LogWarning(LOG_HOST, "%s, releasing all group affiliations", m_name.c_str());
-        for (auto entry : m_grpAffTable) {
-            uint32_t srcId = entry.first;
-            srcToRel.push_back(srcId);
+        srcToRel.reserve(m_grpAffTable.size());
+        for (const auto& entry : m_grpAffTable) {
+            srcToRel.push_back(entry.first);
         }
+
+        m_grpAffTable.clear();
+        m_grpAffByDstTable.clear();
     }
     else {
         LogWarning(LOG_HOST, "%s, releasing group affiliations, dstId = %u", m_name.c_str(), dstId);
-        for (auto entry : m_grpAffTable) {
-            uint32_t srcId = entry.first;
-            uint32_t grpId = entry.second;
-            if (grpId == dstId) {
-                srcToRel.push_back(srcId);
+        auto it = m_grpAffByDstTable.find(dstId);
+        if (it != m_grpAffByDstTable.end()) {
+            srcToRel.assign(it->second.begin(), it->second.end());
+            for (uint32_t srcId : it->second) {
+                m_grpAffTable.erase(srcId);
             }
-        }
-    }
 
-    for (auto srcId : srcToRel) {
-        m_grpAffTable.erase(srcId);
+            m_grpAffByDstTable.erase(it);
+        }
     }
 
     return srcToRel;
 }
 
+/* Gets the grant table. */
+
+std::unordered_map<uint32_t, uint32_t> AffiliationLookup::grantTable() const
+{
+    std::lock_guard<std::mutex> lock(m_grantMutex);
+    return m_grantChTable;
+}
+
+/* Helper to iterate the grant table without copying it. */
+
+void AffiliationLookup::forEachGrant(std::function<void(uint32_t, uint32_t)> visitor) const
+{
+    std::lock_guard<std::mutex> lock(m_grantMutex);
+    for (const auto& entry : m_grantChTable) {
+        visitor(entry.first, entry.second);
+    }
+}
+
 /* Helper to grant a channel. */
 
 bool AffiliationLookup::grantCh(uint32_t dstId, uint32_t srcId, uint32_t grantTimeout, bool grp, bool netGranted)
@@ -303,7 +346,7 @@ bool AffiliationLookup::grantCh(uint32_t dstId, uint32_t srcId, uint32_t grantTi
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_grantMutex);
     uint32_t chNo = m_chLookup->getFirstRFChannel();
     m_chLookup->removeRFCh(chNo);
 
@@ -333,7 +376,7 @@ void AffiliationLookup::touchGrant(uint32_t dstId)
         return;
     }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_grantMutex);
     if (isGranted(dstId)) {
         m_grantTimers[dstId].start();
     }
@@ -348,7 +391,7 @@ bool AffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll, bool noLoc
     }
 
     if (!noLock)
-        m_mutex.lock();
+        m_grantMutex.lock();
 
     // are we trying to release all grants?
     if (dstId == 0U && releaseAll) {
@@ -362,11 +405,11 @@ bool AffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll, bool noLoc
 
         // release grants
         for (uint32_t dstId : gntsToRel) {
-            releaseGrant(dstId, false);
+            releaseGrant(dstId, false, true);
         }
 
         if (!noLock)
-            m_mutex.unlock();
+            m_grantMutex.unlock();
         return true;
     }
 
@@ -398,12 +441,12 @@ bool AffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll, bool noLoc
         m_grantTimers[dstId].stop();
 
         if (!noLock)
-            m_mutex.unlock();
+            m_grantMutex.unlock();
         return true;
     }
 
     if (!noLock)
-        m_mutex.unlock();
+        m_grantMutex.unlock();
     return false;
 }
 
@@ -545,31 +588,36 @@ uint32_t AffiliationLookup::getGrantedSrcId(uint32_t dstId)
 
 void AffiliationLookup::clock(uint32_t ms)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    {
+        std::lock_guard<std::mutex> lock(m_grantMutex);
 
-    // clock all the grant timers
-    std::vector<uint32_t> gntsToRel = std::vector<uint32_t>();
-    for (auto entry : m_grantChTable) {
-        uint32_t dstId = entry.first;
+        // clock all the grant timers
+        std::vector<uint32_t> gntsToRel = std::vector<uint32_t>();
+        for (auto entry : m_grantChTable) {
+            uint32_t dstId = entry.first;
 
-        m_grantTimers[dstId].clock(ms);
-        if (m_grantTimers[dstId].isRunning() && m_grantTimers[dstId].hasExpired()) {
-            gntsToRel.push_back(dstId);
+            m_grantTimers[dstId].clock(ms);
+            if (m_grantTimers[dstId].isRunning() && m_grantTimers[dstId].hasExpired()) {
+                gntsToRel.push_back(dstId);
+            }
         }
-    }
 
-    // release grants that have timed out
-    for (uint32_t dstId : gntsToRel) {
-        releaseGrant(dstId, false, true);
+        // release grants that have timed out
+        for (uint32_t dstId : gntsToRel) {
+            releaseGrant(dstId, false, true);
+        }
     }
 
     if (!m_disableUnitRegTimeout) {
         // clock all the unit registration timers
         std::vector<uint32_t> unitsToDereg = std::vector<uint32_t>();
-        for (uint32_t srcId : m_unitRegTable) {
-            m_unitRegTimers[srcId].clock(ms);
-            if (m_unitRegTimers[srcId].isRunning() && m_unitRegTimers[srcId].hasExpired()) {
-                unitsToDereg.push_back(srcId);
+        {
+            std::lock_guard<std::mutex> affLock(m_affMutex);
+            for (auto& entry : m_unitRegTimers) {
+                entry.second.clock(ms);
+                if (entry.second.isRunning() && entry.second.hasExpired()) {
+                    unitsToDereg.push_back(entry.first);
+                }
             }
         }
 
@@ -579,3 +627,37 @@ void AffiliationLookup::clock(uint32_t ms)
         }
     }
 }
+
+// ---------------------------------------------------------------------------
+//  Protected Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to remove a source ID from the group affiliation tables. */
+
+bool AffiliationLookup::removeGrpAff(uint32_t srcId)
+{
+    // lookup dynamic affiliation table entry
+    auto it = m_grpAffTable.find(srcId);
+    if (it == m_grpAffTable.end()) {
+        return false;
+    }
+
+    uint32_t tblDstId = it->second;
+    if (m_verbose) {
+        LogMessage(LOG_HOST, "%s, group unaffiliation, srcId = %u, dstId = %u",
+            m_name.c_str(), srcId, tblDstId);
+    }
+
+    // remove dynamic affiliation table entry
+    m_grpAffTable.erase(it);
+
+    auto dstIt = m_grpAffByDstTable.find(tblDstId);
+    if (dstIt != m_grpAffByDstTable.end()) {
+        dstIt->second.erase(srcId);
+        if (dstIt->second.empty()) {
+            m_grpAffByDstTable.erase(dstIt);
+        }
+    }
+
+    return true;
+}
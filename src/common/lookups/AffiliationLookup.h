@@ -26,6 +26,7 @@
 
 #include <cstdio>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <vector>
 #include <functional>
@@ -66,7 +67,7 @@ namespace lookups
          * @brief Gets the unit registration table.
          * @returns std::vector<uint32> Unit Registration Table.
          */
-        std::vector<uint32_t> unitRegTable() const { return m_unitRegTable; }
+        std::vector<uint32_t> unitRegTable() const;
         /**
          * @brief Helper to register a source ID.
          * @param srcId Source Radio ID.
@@ -118,7 +119,21 @@ namespace lookups
          * @brief Gets the group affiliation table.
          * @returns std::unordered_map<uint32_t, uint32_t> Group Affiliation Table.
          */
-        std::unordered_map<uint32_t, uint32_t> grpAffTable() const { return m_grpAffTable; }
+        std::unordered_map<uint32_t, uint32_t> grpAffTable() const;
+        /**
+         * @brief Helper to iterate the group affiliation table without copying it.
+         * 
+         *  The affiliation table is locked for the duration of the iteration; the visitor must not
+         *  call back into this lookup table.
+         * @param visitor Function called for each affiliation with the source ID and talkgroup ID.
+         */
+        void forEachGrpAff(std::function<void(uint32_t, uint32_t)> visitor) const;
+        /**
+         * @brief Gets the count of affiliations to the given group destination ID.
+         * @param dstId Talkgroup ID.
+         * @returns uint32_t Total count of source IDs affiliated to the talkgroup ID.
+         */
+        uint32_t grpAffSize(uint32_t dstId) const;
         /**
          * @brief Helper to group affiliate a source ID.
          * @param srcId Source Radio ID.
@@ -163,7 +178,15 @@ namespace lookups
          * @brief Gets the grant table.
          * @returns std::unordered_map<uint32_t, uint32_t> Channel Grant Table.
          */
-        std::unordered_map<uint32_t, uint32_t> grantTable() const { return m_grantChTable; }
+        std::unordered_map<uint32_t, uint32_t> grantTable() const;
+        /**
+         * @brief Helper to iterate the grant table without copying it.
+         * 
+         *  The grant table is locked for the duration of the iteration; the visitor must not
+         *  call back into this lookup table.
+         * @param visitor Function called for each grant with the destination ID and channel number.
+         */
+        void forEachGrant(std::function<void(uint32_t, uint32_t)> visitor) const;
         /**
          * @brief Helper to grant a channel.
          * @param dstId Destination Address.
@@ -279,9 +302,11 @@ namespace lookups
     protected:
         uint8_t m_rfGrantChCnt;
 
-        std::vector<uint32_t> m_unitRegTable;
+        std::unordered_set<uint32_t> m_unitRegTable;
         std::unordered_map<uint32_t, Timer> m_unitRegTimers;
         std::unordered_map<uint32_t, uint32_t> m_grpAffTable;
+        //                 dstId                        srcIds
+        std::unordered_map<uint32_t, std::unordered_set<uint32_t>> m_grpAffByDstTable;
 
         std::unordered_map<uint32_t, uint32_t> m_grantChTable;
         std::unordered_map<uint32_t, uint32_t> m_grantSrcIdTable;
@@ -301,7 +326,16 @@ namespace lookups
 
         bool m_verbose;
 
-        static std::mutex m_mutex;
+        mutable std::mutex m_affMutex;
+        mutable std::mutex m_grantMutex;
+
+        /**
+         * @brief Helper to remove a source ID from the group affiliation tables.
+         * @note The affiliation mutex must be held by the caller.
+         * @param srcId Source Radio ID.
+         * @returns bool True, if source ID was affiliated and has been removed, otherwise false.
+         */
+        bool removeGrpAff(uint32_t srcId);
     };
 } // namespace lookups
 
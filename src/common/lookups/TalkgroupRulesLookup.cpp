@@ -9,21 +9,197 @@
  *
  */
 #include "lookups/TalkgroupRulesLookup.h"
+#include "edac/CRC.h"
 #include "Log.h"
 #include "Timer.h"
 #include "Utils.h"
 
 using namespace lookups;
 
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include <sys/stat.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t CACHE_MAGIC[4U] = { 'D', 'V', 'M', 'T' };
+const uint8_t CACHE_VERSION = 0x02U;
+const uint32_t CACHE_HEADER_LEN = 30U;
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
 
 std::mutex TalkgroupRulesLookup::m_mutex;
 
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the modification time, size and content hash of the given file. */
+
+static bool getFileStat(const std::string& filename, uint64_t& mtime, uint64_t& size, uint32_t& hash)
+{
+    struct stat st;
+    if (::stat(filename.c_str(), &st) != 0)
+        return false;
+
+    mtime = (uint64_t)st.st_mtime;
+    size = (uint64_t)st.st_size;
+
+    // the modification time only has a resolution of a second, so an edit within the same second
+    // (that keeps the file size) is only caught by hashing the file contents
+    FILE* fp = ::fopen(filename.c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve((size_t)size);
+    uint8_t chunk[4096U];
+    size_t n = 0U;
+    while ((n = ::fread(chunk, 1U, sizeof(chunk), fp)) > 0U)
+        buffer.insert(buffer.end(), chunk, chunk + n);
+    ::fclose(fp);
+
+    hash = edac::CRC::createCRC32(buffer.data(), (uint32_t)buffer.size());
+    return true;
+}
+
+/* Helper to append a uint32_t to a cache buffer. */
+
+static void cacheWriteUInt32(std::vector<uint8_t>& buffer, uint32_t val)
+{
+    uint8_t b[4U];
+    __SET_UINT32(val, b, 0U);
+    buffer.insert(buffer.end(), b, b + 4U);
+}
+
+/* Helper to append a length-prefixed string to a cache buffer. */
+
+static void cacheWriteString(std::vector<uint8_t>& buffer, const std::string& str)
+{
+    cacheWriteUInt32(buffer, (uint32_t)str.length());
+    buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+/* Helper to append a count-prefixed peer ID list to a cache buffer. */
+
+static void cacheWriteList(std::vector<uint8_t>& buffer, const std::vector<uint32_t>& list)
+{
+    cacheWriteUInt32(buffer, (uint32_t)list.size());
+    for (uint32_t id : list)
+        cacheWriteUInt32(buffer, id);
+}
+
+/* Helper to read a uint32_t from a cache buffer. */
+
+static bool cacheReadUInt32(const uint8_t* buffer, uint32_t len, uint32_t& offs, uint32_t& val)
+{
+    if (offs + 4U > len)
+        return false;
+
+    val = __GET_UINT32(buffer, offs);
+    offs += 4U;
+    return true;
+}
+
+/* Helper to read a length-prefixed string from a cache buffer. */
+
+static bool cacheReadString(const uint8_t* buffer, uint32_t len, uint32_t& offs, std::string& str)
+{
+    uint32_t strLen = 0U;
+    if (!cacheReadUInt32(buffer, len, offs, strLen))
+        return false;
+    if (strLen > len - offs)
+        return false;
+
+    str = std::string((const char*)(buffer + offs), strLen);
+    offs += strLen;
+    return true;
+}
+
+/* Helper to read a count-prefixed peer ID list from a cache buffer. */
+
+static bool cacheReadList(const uint8_t* buffer, uint32_t len, uint32_t& offs, std::vector<uint32_t>& list)
+{
+    uint32_t count = 0U;
+    if (!cacheReadUInt32(buffer, len, offs, count))
+        return false;
+    if (count > (len - offs) / 4U)
+        return false;
+
+    list.clear();
+    list.reserve(count);
+    for (uint32_t i = 0U; i < count; i++) {
+        uint32_t id = 0U;
+        cacheReadUInt32(buffer, len, offs, id);
+        list.push_back(id);
+    }
+
+    return true;
+}
+
+/* Helper to read a group voice rule from a cache buffer. */
+
+static bool cacheReadEntry(const uint8_t* buffer, uint32_t len, uint32_t& offs, TalkgroupRuleGroupVoice& entry)
+{
+    TalkgroupRuleConfig config;
+    TalkgroupRuleGroupVoiceSource source;
+
+    std::string name, alias;
+    std::vector<uint32_t> inclusion, exclusion, alwaysSend, preferred;
+    std::vector<TalkgroupRuleRewrite> rewrite;
+    uint32_t flags = 0U, rewriteCount = 0U, tgId = 0U, tgSlot = 0U;
+
+    bool ok = cacheReadString(buffer, len, offs, name) && cacheReadString(buffer, len, offs, alias) &&
+        cacheReadUInt32(buffer, len, offs, flags) &&
+        cacheReadList(buffer, len, offs, inclusion) && cacheReadList(buffer, len, offs, exclusion) &&
+        cacheReadList(buffer, len, offs, alwaysSend) && cacheReadList(buffer, len, offs, preferred) &&
+        cacheReadUInt32(buffer, len, offs, rewriteCount);
+    if (!ok)
+        return false;
+
+    for (uint32_t j = 0U; j < rewriteCount; j++) {
+        uint32_t peerId = 0U, rewrTgId = 0U, rewrSlot = 0U;
+        if (!cacheReadUInt32(buffer, len, offs, peerId) || !cacheReadUInt32(buffer, len, offs, rewrTgId) ||
+            !cacheReadUInt32(buffer, len, offs, rewrSlot))
+            return false;
+
+        TalkgroupRuleRewrite rewr;
+        rewr.peerId(peerId);
+        rewr.tgId(rewrTgId);
+        rewr.tgSlot((uint8_t)rewrSlot);
+        rewrite.push_back(rewr);
+    }
+
+    if (!cacheReadUInt32(buffer, len, offs, tgId) || !cacheReadUInt32(buffer, len, offs, tgSlot))
+        return false;
+
+    config.active((flags & 0x01U) == 0x01U);
+    config.affiliated((flags & 0x02U) == 0x02U);
+    config.parrot((flags & 0x04U) == 0x04U);
+    config.nonPreferred((flags & 0x08U) == 0x08U);
+    config.inclusion(inclusion);
+    config.exclusion(exclusion);
+    config.rewrite(rewrite);
+    config.alwaysSend(alwaysSend);
+    config.preferred(preferred);
+
+    source.tgId(tgId);
+    source.tgSlot((uint8_t)tgSlot);
+
+    entry.name(name);
+    entry.nameAlias(alias);
+    entry.config(config);
+    entry.source(source);
+    return true;
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -38,6 +214,7 @@ TalkgroupRulesLookup::TalkgroupRulesLookup(const std::string& filename, uint32_t
     m_stop(false),
     m_groupHangTime(5U),
     m_sendTalkgroups(false),
+    m_useCache(false),
     m_groupVoice()
 {
     /* stub */
@@ -280,45 +457,61 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
-    try {
-        bool ret = yaml::Parse(m_rules, m_rulesFile.c_str());
-        if (!ret) {
-            LogError(LOG_HOST, "Cannot open the talkgroup rules lookup file - %s - error parsing YML", m_rulesFile.c_str());
+    // if the compiled rules cache is current, skip parsing the YAML entirely
+    bool cached = false;
+    if (m_useCache) {
+        cached = loadCache();
+    }
+
+    if (!cached) {
+        try {
+            bool ret = yaml::Parse(m_rules, m_rulesFile.c_str());
+            if (!ret) {
+                LogError(LOG_HOST, "Cannot open the talkgroup rules lookup file - %s - error parsing YML", m_rulesFile.c_str());
+                return false;
+            }
+        }
+        catch (yaml::OperationException const& e) {
+            LogError(LOG_HOST, "Cannot open the talkgroup rules lookup file - %s (%s)", m_rulesFile.c_str(), e.message());
             return false;
         }
-    }
-    catch (yaml::OperationException const& e) {
-        LogError(LOG_HOST, "Cannot open the talkgroup rules lookup file - %s (%s)", m_rulesFile.c_str(), e.message());
-        return false;
+
+        // clear table
+        clear();
     }
 
-    // clear table
-    clear();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!cached) {
+        yaml::Node& groupVoiceList = m_rules["groupVoice"];
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    yaml::Node& groupVoiceList = m_rules["groupVoice"];
+        if (groupVoiceList.size() == 0U) {
+            ::LogError(LOG_HOST, "No group voice rules list defined!");
+            return false;
+        }
 
-    if (groupVoiceList.size() == 0U) {
-        ::LogError(LOG_HOST, "No group voice rules list defined!");
-        return false;
-    }
+        m_groupVoice.reserve(groupVoiceList.size());
+        for (size_t i = 0; i < groupVoiceList.size(); i++) {
+            m_groupVoice.push_back(TalkgroupRuleGroupVoice(groupVoiceList[i]));
+        }
 
-    for (size_t i = 0; i < groupVoiceList.size(); i++) {
-        TalkgroupRuleGroupVoice groupVoice = TalkgroupRuleGroupVoice(groupVoiceList[i]);
-        m_groupVoice.push_back(groupVoice);
+        // release the parsed node tree; the rules are now held by the table
+        m_rules = yaml::Node();
+    }
 
+    for (const TalkgroupRuleGroupVoice& groupVoice : m_groupVoice) {
+        TalkgroupRuleConfig config = groupVoice.config();
         std::string groupName = groupVoice.name();
         uint32_t tgId = groupVoice.source().tgId();
         uint8_t tgSlot = groupVoice.source().tgSlot();
-        bool active = groupVoice.config().active();
-        bool parrot = groupVoice.config().parrot();
-        bool affil = groupVoice.config().affiliated();
+        bool active = config.active();
+        bool parrot = config.parrot();
+        bool affil = config.affiliated();
 
-        uint32_t incCount = groupVoice.config().inclusion().size();
-        uint32_t excCount = groupVoice.config().exclusion().size();
-        uint32_t rewrCount = groupVoice.config().rewrite().size();
-        uint32_t alwyCount = groupVoice.config().alwaysSend().size();
-        uint32_t prefCount = groupVoice.config().preferred().size();
+        uint32_t incCount = config.inclusion().size();
+        uint32_t excCount = config.exclusion().size();
+        uint32_t rewrCount = config.rewrite().size();
+        uint32_t alwyCount = config.alwaysSend().size();
+        uint32_t prefCount = config.preferred().size();
 
         if (incCount > 0 && excCount > 0) {
             ::LogWarning(LOG_HOST, "Talkgroup (%s) defines both inclusions and exclusions! Inclusion rules take precedence and exclusion rules will be ignored.", groupName.c_str());
@@ -335,7 +528,12 @@ bool TalkgroupRulesLookup::load()
     if (size == 0U)
         return false;
 
-    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table", size);
+    lock.unlock();
+    if (m_useCache && !cached) {
+        saveCache();
+    }
+
+    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table%s", size, cached ? " (from cache)" : "");
 
     return true;
 }
@@ -349,7 +547,7 @@ bool TalkgroupRulesLookup::save()
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
     
     // New list for our new group voice rules
     yaml::Node groupVoiceList;
@@ -382,5 +580,162 @@ bool TalkgroupRulesLookup::save()
         return false;
     }
 
+    // the rules file has changed underneath the cache, regenerate it
+    lock.unlock();
+    if (m_useCache) {
+        saveCache();
+    }
+
+    return true;
+}
+
+/* Loads the table from the compiled rules cache file. */
+
+bool TalkgroupRulesLookup::loadCache()
+{
+    uint64_t mtime = 0U, fileSize = 0U;
+    uint32_t fileHash = 0U;
+    if (!getFileStat(m_rulesFile, mtime, fileSize, fileHash))
+        return false;
+
+    std::string cacheFile = cacheFilename();
+    FILE* fp = ::fopen(cacheFile.c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    std::vector<uint8_t> buffer;
+    uint8_t chunk[4096U];
+    size_t n = 0U;
+    while ((n = ::fread(chunk, 1U, sizeof(chunk), fp)) > 0U)
+        buffer.insert(buffer.end(), chunk, chunk + n);
+    ::fclose(fp);
+
+    uint32_t len = (uint32_t)buffer.size();
+    if (len < CACHE_HEADER_LEN + 4U) {
+        LogWarning(LOG_HOST, "Talkgroup rules cache %s is truncated, ignoring", cacheFile.c_str());
+        return false;
+    }
+
+    const uint8_t* data = buffer.data();
+    if (::memcmp(data, CACHE_MAGIC, 4U) != 0 || data[4U] != CACHE_VERSION) {
+        LogWarning(LOG_HOST, "Talkgroup rules cache %s is not a valid cache file, ignoring", cacheFile.c_str());
+        return false;
+    }
+
+    if (!edac::CRC::checkCRC32(data, len)) {
+        LogWarning(LOG_HOST, "Talkgroup rules cache %s failed CRC check, ignoring", cacheFile.c_str());
+        return false;
+    }
+
+    // header: magic (4), version (1), reserved (1), rules mtime (8), rules size (8), entry count (4),
+    //  rules CRC-32 (4)
+    uint32_t mtimeHi = __GET_UINT32(data, 6U);
+    uint32_t mtimeLo = __GET_UINT32(data, 10U);
+    uint32_t sizeHi = __GET_UINT32(data, 14U);
+    uint32_t sizeLo = __GET_UINT32(data, 18U);
+    uint32_t count = __GET_UINT32(data, 22U);
+    uint32_t hash = __GET_UINT32(data, 26U);
+    if (((uint64_t)mtimeHi << 32 | mtimeLo) != mtime || ((uint64_t)sizeHi << 32 | sizeLo) != fileSize || hash != fileHash) {
+        LogMessage(LOG_HOST, "Talkgroup rules file %s has changed since cache was generated", m_rulesFile.c_str());
+        return false;
+    }
+
+    len -= 4U; // exclude trailing CRC-32
+    uint32_t offs = CACHE_HEADER_LEN;
+
+    std::vector<TalkgroupRuleGroupVoice> groupVoice;
+    groupVoice.reserve(count);
+    for (uint32_t i = 0U; i < count; i++) {
+        TalkgroupRuleGroupVoice entry;
+        if (!cacheReadEntry(data, len, offs, entry)) {
+            LogWarning(LOG_HOST, "Talkgroup rules cache %s is malformed, ignoring", cacheFile.c_str());
+            return false;
+        }
+
+        groupVoice.push_back(entry);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_groupVoice = groupVoice;
+    }
+
+    return true;
+}
+
+/* Saves the table to the compiled rules cache file. */
+
+bool TalkgroupRulesLookup::saveCache()
+{
+    uint64_t mtime = 0U, fileSize = 0U;
+    uint32_t fileHash = 0U;
+    if (!getFileStat(m_rulesFile, mtime, fileSize, fileHash))
+        return false;
+
+    std::vector<uint8_t> buffer(CACHE_HEADER_LEN, 0U);
+    ::memcpy(buffer.data(), CACHE_MAGIC, 4U);
+    buffer[4U] = CACHE_VERSION;
+
+    uint32_t mtimeHi = (uint32_t)(mtime >> 32), mtimeLo = (uint32_t)mtime;
+    uint32_t sizeHi = (uint32_t)(fileSize >> 32), sizeLo = (uint32_t)fileSize;
+    __SET_UINT32(mtimeHi, buffer, 6U);
+    __SET_UINT32(mtimeLo, buffer, 10U);
+    __SET_UINT32(sizeHi, buffer, 14U);
+    __SET_UINT32(sizeLo, buffer, 18U);
+    __SET_UINT32(fileHash, buffer, 26U);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint32_t count = (uint32_t)m_groupVoice.size();
+        __SET_UINT32(count, buffer, 22U);
+
+        for (const TalkgroupRuleGroupVoice& entry : m_groupVoice) {
+            const TalkgroupRuleConfig& config = entry.config();
+
+            uint32_t flags = (config.active() ? 0x01U : 0x00U) + (config.affiliated() ? 0x02U : 0x00U) +
+                (config.parrot() ? 0x04U : 0x00U) + (config.nonPreferred() ? 0x08U : 0x00U);
+
+            cacheWriteString(buffer, entry.name());
+            cacheWriteString(buffer, entry.nameAlias());
+            cacheWriteUInt32(buffer, flags);
+            cacheWriteList(buffer, config.inclusion());
+            cacheWriteList(buffer, config.exclusion());
+            cacheWriteList(buffer, config.alwaysSend());
+            cacheWriteList(buffer, config.preferred());
+
+            cacheWriteUInt32(buffer, (uint32_t)config.rewrite().size());
+            for (const TalkgroupRuleRewrite& rewrite : config.rewrite()) {
+                cacheWriteUInt32(buffer, rewrite.peerId());
+                cacheWriteUInt32(buffer, rewrite.tgId());
+                cacheWriteUInt32(buffer, rewrite.tgSlot());
+            }
+
+            cacheWriteUInt32(buffer, entry.source().tgId());
+            cacheWriteUInt32(buffer, entry.source().tgSlot());
+        }
+    }
+
+    // reserve and append CRC-32
+    buffer.insert(buffer.end(), 4U, 0U);
+    edac::CRC::addCRC32(buffer.data(), (uint32_t)buffer.size());
+
+    // write to a temporary file and rename, so a concurrent reader never sees a partial cache
+    std::string cacheFile = cacheFilename();
+    std::string tmpFile = cacheFile + ".tmp";
+    FILE* fp = ::fopen(tmpFile.c_str(), "wb");
+    if (fp == nullptr) {
+        LogWarning(LOG_HOST, "Cannot open the talkgroup rules cache file - %s", tmpFile.c_str());
+        return false;
+    }
+
+    size_t written = ::fwrite(buffer.data(), 1U, buffer.size(), fp);
+    ::fclose(fp);
+    if (written != buffer.size() || ::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+        LogWarning(LOG_HOST, "Cannot write the talkgroup rules cache file - %s", cacheFile.c_str());
+        ::remove(tmpFile.c_str());
+        return false;
+    }
+
+    LogMessage(LOG_HOST, "Saved compiled talkgroup rules cache to %s", cacheFile.c_str());
     return true;
 }
\ No newline at end of file
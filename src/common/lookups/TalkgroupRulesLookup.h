@@ -620,6 +620,23 @@ namespace lookups
          */
         bool save();
 
+        /**
+         * @brief Helper to get the full-path to the compiled rules cache file.
+         * @returns std::string Full-path to the compiled rules cache file.
+         */
+        std::string cacheFilename() const { return m_rulesFile + ".cache"; }
+        /**
+         * @brief Loads the table from the compiled rules cache file, if the cache was generated
+         *  from the current revision of the rules file.
+         * @return True, if lookup table was loaded from the cache, otherwise false.
+         */
+        bool loadCache();
+        /**
+         * @brief Saves the table to the compiled rules cache file.
+         * @return True, if the compiled rules cache was saved, otherwise false.
+         */
+        bool saveCache();
+
     public:
         /**
          * @brief Number indicating the number of seconds to hang on a talkgroup.
@@ -629,6 +646,10 @@ namespace lookups
          * @brief Flag indicating whether or not the network layer should send the talkgroups to peers.
          */
         __PROPERTY_PLAIN(bool, sendTalkgroups);
+        /**
+         * @brief Flag indicating whether or not a compiled binary cache of the rules file should be used.
+         */
+        __PROPERTY_PLAIN(bool, useCache);
         /**
          * @brief List of group voice rules.
          */
@@ -31,7 +31,8 @@ using namespace network::frame;
 
 FrameQueue::FrameQueue(udp::Socket* socket, uint32_t peerId, bool debug) : RawFrameQueue(socket, debug),
     m_peerId(peerId),
-    m_streamTimestamps()
+    m_streamTimestamps(),
+    m_capture(nullptr)
 {
     assert(peerId < 999999999U);
 }
@@ -40,6 +41,24 @@ FrameQueue::FrameQueue(udp::Socket* socket, uint32_t peerId, bool debug) : RawFr
 
 UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
     RTPHeader* rtpHeader, RTPFNEHeader* fneHeader)
+{
+    PacketBuffer packet = readPacket(messageLength, address, addrLen, rtpHeader, fneHeader);
+    if (!packet || messageLength < 0) {
+        return nullptr;
+    }
+
+    // copy message
+    UInt8Array message = std::unique_ptr<uint8_t[]>(new uint8_t[messageLength]);
+    ::memcpy(message.get(), packet.data(), messageLength);
+
+    // LogDebug(LOG_NET, "message buffer, addr %p len %u", message.get(), messageLength);
+    return message;
+}
+
+/* Read message from the received UDP packet into a shareable packet buffer. */
+
+PacketBuffer FrameQueue::readPacket(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
+    RTPHeader* rtpHeader, RTPFNEHeader* fneHeader)
 {
     RTPHeader _rtpHeader = RTPHeader();
     RTPFNEHeader _fneHeader = RTPFNEHeader();
@@ -48,11 +67,10 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
 
     // read message from socket
     uint8_t buffer[DATA_PACKET_LENGTH];
-    ::memset(buffer, 0x00U, DATA_PACKET_LENGTH);
     int length = m_socket->read(buffer, DATA_PACKET_LENGTH, address, addrLen);
     if (length < 0) {
         LogError(LOG_NET, "Failed reading data from the network");
-        return nullptr;
+        return PacketBuffer();
     }
 
     if (length > 0) {
@@ -62,26 +80,26 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
         if (length < RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES) {
             LogError(LOG_NET, "FrameQueue::read(), message received from network is malformed! %u bytes != %u bytes", 
                 RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES, length);
-            return nullptr;
+            return PacketBuffer();
         }
 
         // decode RTP header
         if (!_rtpHeader.decode(buffer)) {
             LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
-            return nullptr;
+            return PacketBuffer();
         }
 
         // ensure the RTP header has extension header (otherwise abort)
         if (!_rtpHeader.getExtension()) {
             LogError(LOG_NET, "FrameQueue::read(), invalid RTP header received from network");
-            return nullptr;
+            return PacketBuffer();
         }
 
         // ensure payload type is correct
         if ((_rtpHeader.getPayloadType() != DVM_RTP_PAYLOAD_TYPE) &&
             (_rtpHeader.getPayloadType() != (DVM_RTP_PAYLOAD_TYPE + 1U))) {
             LogError(LOG_NET, "FrameQueue::read(), invalid RTP payload type received from network");
-            return nullptr;
+            return PacketBuffer();
         }
 
         if (rtpHeader != nullptr) {
@@ -91,30 +109,40 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
         // decode FNE RTP header
         if (!_fneHeader.decode(buffer + RTP_HEADER_LENGTH_BYTES)) {
             LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
-            return nullptr;
+            return PacketBuffer();
         }
 
         if (fneHeader != nullptr) {
             *fneHeader = _fneHeader;
         }
 
-        // copy message
-        messageLength = _fneHeader.getMessageLength();
-        UInt8Array message = std::unique_ptr<uint8_t[]>(new uint8_t[messageLength]);
-        ::memcpy(message.get(), buffer + (RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES), messageLength);
+        // copy the datagram into a packet buffer sized to it, and narrow the buffer to the message; the
+        // headers stay in place as headroom
+        PacketBuffer packet = PacketBuffer::copy(buffer, (uint32_t)length);
+        if (!packet) {
+            return PacketBuffer();
+        }
+
+        uint32_t msgLength = _fneHeader.getMessageLength();
+        if (!packet.slice(RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES, msgLength)) {
+            LogError(LOG_NET, "FrameQueue::read(), message received from network is malformed! %u bytes", msgLength);
+            return PacketBuffer();
+        }
 
-        uint16_t calc = edac::CRC::createCRC16(message.get(), messageLength * 8U);
+        uint16_t calc = edac::CRC::createCRC16(packet.data(), msgLength * 8U);
         if (calc != _fneHeader.getCRC()) {
             LogError(LOG_NET, "FrameQueue::read(), failed CRC CCITT-162 check");
-            messageLength = -1;
-            return nullptr;
+            return PacketBuffer();
         }
 
-        // LogDebug(LOG_NET, "message buffer, addr %p len %u", message.get(), messageLength);
-        return message;
+        if (m_capture != nullptr)
+            m_capture->record(buffer, (uint32_t)length);
+
+        messageLength = (int)msgLength;
+        return packet;
     }
 
-    return nullptr;
+    return PacketBuffer();
 }
 
 /* Write message to the UDP socket. */
@@ -134,7 +162,7 @@ bool FrameQueue::write(const uint8_t* message, uint32_t length, uint32_t streamI
         ret = false;
     }
 
-    delete[] buffer;
+    SlabAllocator::deallocate(buffer);
     return ret;
 }
 
@@ -166,6 +194,35 @@ void FrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, uint32_
     m_buffers.push_back(dgram);
 }
 
+/* Cache shared message to frame queue. */
+
+void FrameQueue::enqueueMessage(const PacketBuffer& message, uint32_t streamId, uint32_t peerId,
+    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen)
+{
+    assert(message);
+    assert(message.length() > 0U);
+
+    uint32_t bufferLen = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+    uint8_t* buffer = SlabAllocator::allocateBuffer(bufferLen);
+    ::memset(buffer, 0x00U, bufferLen);
+
+    generateHeader(buffer, message.data(), message.length(), streamId, peerId, ssrc, opcode, rtpSeq);
+
+    if (m_debug) {
+        Utils::dump(1U, "FrameQueue::enqueueMessage() Buffered Header", buffer, bufferLen);
+        Utils::dump(1U, "FrameQueue::enqueueMessage() Buffered Message", message.data(), message.length());
+    }
+
+    udp::UDPDatagram *dgram = new udp::UDPDatagram;
+    dgram->buffer = buffer;
+    dgram->length = bufferLen;
+    dgram->payload = message;
+    dgram->address = addr;
+    dgram->addrLen = addrLen;
+
+    m_buffers.push_back(dgram);
+}
+
 /* Helper method to clear any tracked stream timestamps. */
 
 void FrameQueue::clearTimestamps()
@@ -185,6 +242,32 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
     assert(message != nullptr);
     assert(length > 0U);
 
+    uint32_t bufferLen = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES + length;
+    uint8_t* buffer = SlabAllocator::allocateBuffer(bufferLen);
+    ::memset(buffer, 0x00U, bufferLen);
+
+    generateHeader(buffer, message, length, streamId, peerId, ssrc, opcode, rtpSeq);
+
+    ::memcpy(buffer + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES, message, length);
+
+    if (m_debug)
+        Utils::dump(1U, "FrameQueue::generateMessage() Buffered Message", buffer, bufferLen);
+
+    if (outBufferLen != nullptr) {
+        *outBufferLen = bufferLen;
+    }
+
+    return buffer;
+}
+
+/* Helper to write the RTP and FNE headers for the given message. */
+
+void FrameQueue::generateHeader(uint8_t* buffer, const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
+    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq)
+{
+    assert(buffer != nullptr);
+    assert(message != nullptr);
+
     uint32_t timestamp = INVALID_TS;
     if (streamId != 0U) {
         auto entry = m_streamTimestamps.find(streamId);
@@ -200,10 +283,6 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
         }
     }
 
-    uint32_t bufferLen = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES + length;
-    uint8_t* buffer = new uint8_t[bufferLen];
-    ::memset(buffer, 0x00U, bufferLen);
-
     RTPHeader header = RTPHeader();
     header.setExtension(true);
 
@@ -239,15 +318,4 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
     fneHeader.setSubFunction(opcode.second);
 
     fneHeader.encode(buffer + RTP_HEADER_LENGTH_BYTES);
-
-    ::memcpy(buffer + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES, message, length);
-
-    if (m_debug)
-        Utils::dump(1U, "FrameQueue::generateMessage() Buffered Message", buffer, bufferLen);
-
-    if (outBufferLen != nullptr) {
-        *outBufferLen = bufferLen;
-    }
-
-    return buffer;
 }
@@ -19,6 +19,8 @@
 #include "common/Defines.h"
 #include "common/network/RTPHeader.h"
 #include "common/network/RTPFNEHeader.h"
+#include "common/network/PacketBuffer.h"
+#include "common/network/PacketCapture.h"
 #include "common/network/RawFrameQueue.h"
 
 #include <unordered_map>
@@ -64,6 +66,20 @@ namespace network
          */
         UInt8Array read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
                 frame::RTPHeader* rtpHeader = nullptr, frame::RTPFNEHeader* fneHeader = nullptr);
+        /**
+         * @brief Read message from the received UDP packet into a shareable packet buffer.
+         * 
+         *  The packet is copied once into a packet buffer sized to the datagram; the returned buffer
+         *  covers the message, with the RTP and FNE headers left as headroom.
+         * @param[out] messageLength Actual length of message read from packet.
+         * @param[out] address IP address data read from.
+         * @param[out] addrLen 
+         * @param[out] rtpHeader RTP Header.
+         * @param[out] fneHeader FNE Header.
+         * @returns PacketBuffer Buffer containing message read.
+         */
+        PacketBuffer readPacket(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
+                frame::RTPHeader* rtpHeader = nullptr, frame::RTPFNEHeader* fneHeader = nullptr);
         /**
          * @brief Write message to the UDP socket.
          * @param[in] message Message buffer to frame and queue.
@@ -107,16 +123,40 @@ namespace network
          */
         void enqueueMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
             uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen);
+        /**
+         * @brief Cache shared message to frame queue.
+         * 
+         *  Only the RTP and FNE headers are generated for the queued datagram, the message itself is
+         *  referenced (not copied) until the queue is flushed.
+         * @param message Message buffer to frame and queue.
+         * @param streamId Message stream ID.
+         * @param peerId Peer ID.
+         * @param ssrc RTP SSRC ID.
+         * @param opcode Opcode.
+         * @param rtpSeq RTP Sequence.
+         * @param addr IP address to write data to.
+         * @param addrLen 
+         */
+        void enqueueMessage(const PacketBuffer& message, uint32_t streamId, uint32_t peerId,
+            uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen);
 
         /**
          * @brief Helper method to clear any tracked stream timestamps.
          */
         void clearTimestamps();
 
+        /**
+         * @brief Sets the packet capture every valid received datagram is recorded to.
+         * @param capture Instance of the PacketCapture class (or nullptr to stop capturing).
+         */
+        void setCapture(PacketCapture* capture) { m_capture = capture; }
+
     private:
         uint32_t m_peerId;
         std::unordered_map<uint32_t, uint32_t> m_streamTimestamps;
 
+        PacketCapture* m_capture;
+
         /**
          * @brief Generate RTP message for the frame queue.
          * @param[in] message Message buffer to frame and queue.
@@ -131,6 +171,19 @@ namespace network
          */
         uint8_t* generateMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
             uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, uint32_t* outBufferLen);
+        /**
+         * @brief Helper to write the RTP and FNE headers for the given message.
+         * @param[out] buffer Buffer to write the headers to.
+         * @param[in] message Message buffer to frame.
+         * @param length Length of message.
+         * @param streamId Message stream ID.
+         * @param peerId Peer ID.
+         * @param ssrc RTP SSRC ID.
+         * @param opcode Opcode.
+         * @param rtpSeq RTP Sequence.
+         */
+        void generateHeader(uint8_t* buffer, const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
+            uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq);
     };
 } // namespace network
 
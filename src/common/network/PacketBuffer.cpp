@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/PacketBuffer.h"
+#include "SlabAllocator.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cstring>
+#include <new>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new (empty) instance of the PacketBuffer class. */
+
+PacketBuffer::PacketBuffer() :
+    m_block(nullptr),
+    m_offset(0U),
+    m_length(0U)
+{
+    /* stub */
+}
+
+/* Initializes a new instance of the PacketBuffer class, sharing the given buffer. */
+
+PacketBuffer::PacketBuffer(const PacketBuffer& buffer) :
+    m_block(buffer.m_block),
+    m_offset(buffer.m_offset),
+    m_length(buffer.m_length)
+{
+    if (m_block != nullptr)
+        m_block->refs.fetch_add(1U);
+}
+
+/* Initializes a new instance of the PacketBuffer class, taking over the given buffer. */
+
+PacketBuffer::PacketBuffer(PacketBuffer&& buffer) :
+    m_block(buffer.m_block),
+    m_offset(buffer.m_offset),
+    m_length(buffer.m_length)
+{
+    buffer.m_block = nullptr;
+    buffer.m_offset = 0U;
+    buffer.m_length = 0U;
+}
+
+/* Finalizes a instance of the PacketBuffer class. */
+
+PacketBuffer::~PacketBuffer()
+{
+    release();
+}
+
+/* Shares the given buffer. */
+
+PacketBuffer& PacketBuffer::operator=(const PacketBuffer& buffer)
+{
+    if (this != &buffer) {
+        if (buffer.m_block != nullptr)
+            buffer.m_block->refs.fetch_add(1U);
+        release();
+
+        m_block = buffer.m_block;
+        m_offset = buffer.m_offset;
+        m_length = buffer.m_length;
+    }
+
+    return *this;
+}
+
+/* Takes over the given buffer. */
+
+PacketBuffer& PacketBuffer::operator=(PacketBuffer&& buffer)
+{
+    if (this != &buffer) {
+        release();
+
+        m_block = buffer.m_block;
+        m_offset = buffer.m_offset;
+        m_length = buffer.m_length;
+
+        buffer.m_block = nullptr;
+        buffer.m_offset = 0U;
+        buffer.m_length = 0U;
+    }
+
+    return *this;
+}
+
+/* Creates a new (zeroed) packet buffer. */
+
+PacketBuffer PacketBuffer::create(uint32_t length, uint32_t headroom)
+{
+    PacketBuffer buffer;
+    if (headroom + length > PACKET_BUFFER_HEADROOM + PACKET_BUFFER_CAPACITY)
+        return buffer;
+
+    buffer.m_block = acquire(headroom + length);
+    buffer.m_offset = headroom;
+    buffer.m_length = length;
+
+    ::memset(buffer.m_block->data(), 0x00U, headroom + length);
+    return buffer;
+}
+
+/* Creates a new packet buffer containing a copy of the given data. */
+
+PacketBuffer PacketBuffer::copy(const uint8_t* data, uint32_t length, uint32_t headroom)
+{
+    assert(data != nullptr);
+
+    PacketBuffer buffer;
+    if (headroom + length > PACKET_BUFFER_HEADROOM + PACKET_BUFFER_CAPACITY)
+        return buffer;
+
+    buffer.m_block = acquire(headroom + length);
+    buffer.m_offset = headroom;
+    buffer.m_length = length;
+
+    ::memset(buffer.m_block->data(), 0x00U, headroom);
+    ::memcpy(buffer.m_block->data() + headroom, data, length);
+    return buffer;
+}
+
+/* Extends the data into the headroom. */
+
+uint8_t* PacketBuffer::prepend(uint32_t length)
+{
+    if (m_block == nullptr || length > m_offset)
+        return nullptr;
+
+    m_offset -= length;
+    m_length += length;
+    return m_block->data() + m_offset;
+}
+
+/* Narrows the data to the given range. */
+
+bool PacketBuffer::slice(uint32_t offset, uint32_t length)
+{
+    if (m_block == nullptr || offset > m_length || length > m_length - offset)
+        return false;
+
+    m_offset += offset;
+    m_length = length;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to allocate a block. */
+
+PacketBuffer::Block* PacketBuffer::acquire(uint32_t capacity)
+{
+    // the slab allocator rounds the block up to its size class, and recycles freed blocks through
+    // per-thread caches and lock-free free lists
+    Block* block = new (SlabAllocator::allocate(sizeof(Block) + capacity)) Block();
+    block->refs.store(1U);
+    block->capacity = capacity;
+    return block;
+}
+
+/* Helper to drop this buffer's reference to its block. */
+
+void PacketBuffer::release()
+{
+    if (m_block == nullptr)
+        return;
+
+    Block* block = m_block;
+    m_block = nullptr;
+    m_offset = 0U;
+    m_length = 0U;
+
+    if (block->refs.fetch_sub(1U) != 1U)
+        return;
+
+    block->~Block();
+    SlabAllocator::deallocate(block);
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PacketBuffer.h
+ * @ingroup network_core
+ * @file PacketBuffer.cpp
+ * @ingroup network_core
+ */
+#if !defined(__PACKET_BUFFER_H__)
+#define __PACKET_BUFFER_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t PACKET_BUFFER_HEADROOM = 64U;        // room to prepend the RTP and FNE headers
+    const uint32_t PACKET_BUFFER_CAPACITY = 8192U;      // (same as DATA_PACKET_LENGTH)
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a pooled, reference counted network packet buffer.
+     *
+     *  A packet buffer is a view (offset and length) over a block sized to the headroom and data it
+     *  was created with, taken from the slab allocator. Copying a packet buffer only adds a reference
+     *  to the block, so a frame received once can be queued to any number of peers without copying
+     *  it; the block returns to the allocator when the last reference is released. Blocks are
+     *  allocated with PACKET_BUFFER_HEADROOM bytes in front of the data, so headers can be
+     *  prepended in place.
+     *
+     *  The data of a buffer that is shared must be treated as read-only.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PacketBuffer {
+    public:
+        /**
+         * @brief Initializes a new (empty) instance of the PacketBuffer class.
+         */
+        PacketBuffer();
+        /**
+         * @brief Initializes a new instance of the PacketBuffer class, sharing the given buffer.
+         * @param buffer Packet buffer.
+         */
+        PacketBuffer(const PacketBuffer& buffer);
+        /**
+         * @brief Initializes a new instance of the PacketBuffer class, taking over the given buffer.
+         * @param buffer Packet buffer.
+         */
+        PacketBuffer(PacketBuffer&& buffer);
+        /**
+         * @brief Finalizes a instance of the PacketBuffer class.
+         */
+        ~PacketBuffer();
+
+        /**
+         * @brief Shares the given buffer.
+         * @param buffer Packet buffer.
+         */
+        PacketBuffer& operator=(const PacketBuffer& buffer);
+        /**
+         * @brief Takes over the given buffer.
+         * @param buffer Packet buffer.
+         */
+        PacketBuffer& operator=(PacketBuffer&& buffer);
+
+        /**
+         * @brief Creates a new (zeroed) packet buffer.
+         * @param length Length of data.
+         * @param headroom Space reserved in front of the data.
+         * @returns PacketBuffer Packet buffer, or an empty buffer if the length exceeds the block size.
+         */
+        static PacketBuffer create(uint32_t length, uint32_t headroom = PACKET_BUFFER_HEADROOM);
+        /**
+         * @brief Creates a new packet buffer containing a copy of the given data. (Only the headroom
+         *  is zeroed.)
+         * @param[in] data Buffer to copy.
+         * @param length Length of buffer.
+         * @param headroom Space reserved in front of the data.
+         * @returns PacketBuffer Packet buffer, or an empty buffer if the length exceeds the block size.
+         */
+        static PacketBuffer copy(const uint8_t* data, uint32_t length, uint32_t headroom = PACKET_BUFFER_HEADROOM);
+
+        /**
+         * @brief Flag indicating whether this buffer references a block.
+         */
+        explicit operator bool() const { return m_block != nullptr; }
+
+        /**
+         * @brief Gets the data.
+         */
+        uint8_t* data() { return (m_block != nullptr) ? m_block->data() + m_offset : nullptr; }
+        /**
+         * @brief Gets the data.
+         */
+        const uint8_t* data() const { return (m_block != nullptr) ? m_block->data() + m_offset : nullptr; }
+        /**
+         * @brief Gets the length of the data.
+         */
+        uint32_t length() const { return m_length; }
+        /**
+         * @brief Gets the space available in front of the data.
+         */
+        uint32_t headroom() const { return m_offset; }
+        /**
+         * @brief Gets the size of the block (headroom and data) backing this buffer.
+         */
+        uint32_t capacity() const { return (m_block != nullptr) ? m_block->capacity : 0U; }
+
+        /**
+         * @brief Extends the data into the headroom.
+         * @param length Number of bytes to prepend.
+         * @returns uint8_t* Start of the data, or nullptr if there is not enough headroom.
+         */
+        uint8_t* prepend(uint32_t length);
+        /**
+         * @brief Narrows the data to the given range.
+         * @param offset Offset from the start of the current data.
+         * @param length Length of data.
+         * @returns bool True, if the range is within the current data, otherwise false.
+         */
+        bool slice(uint32_t offset, uint32_t length);
+
+        /**
+         * @brief Gets the number of references to the block.
+         */
+        uint32_t useCount() const { return (m_block != nullptr) ? m_block->refs.load() : 0U; }
+
+    private:
+        struct Block {
+            std::atomic<uint32_t> refs;
+            uint32_t capacity;
+
+            uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+        };
+
+        Block* m_block;
+        uint32_t m_offset;
+        uint32_t m_length;
+
+        /**
+         * @brief Helper to allocate a block.
+         * @param capacity Size of block (headroom and data).
+         * @returns Block* Block.
+         */
+        static Block* acquire(uint32_t capacity);
+        /**
+         * @brief Helper to drop this buffer's reference to its block.
+         */
+        void release();
+    };
+} // namespace network
+
+#endif // __PACKET_BUFFER_H__
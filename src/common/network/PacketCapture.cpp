@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/PacketCapture.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace network;
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the PacketCapture class. */
+
+PacketCapture::PacketCapture(const std::string& fileName) :
+    m_fileName(fileName),
+    m_writer("pcap", true),
+    m_count(0U)
+{
+    m_writer.setFileHeader(std::string(CAPTURE_FILE_MAGIC, CAPTURE_FILE_MAGIC_LEN));
+}
+
+/* Finalizes a instance of the PacketCapture class. */
+
+PacketCapture::~PacketCapture()
+{
+    close();
+}
+
+/* Appends a received datagram to the capture file. */
+
+void PacketCapture::record(const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+
+    if (length == 0U || length > 0xFFFFU)
+        return;
+
+    uint64_t timestamp = now();
+    uint32_t tsHigh = (uint32_t)(timestamp >> 32);
+    uint32_t tsLow = (uint32_t)(timestamp & 0xFFFFFFFFU);
+
+    uint8_t header[CAPTURE_RECORD_HEADER_LEN];
+    __SET_UINT32(tsHigh, header, 0U);
+    __SET_UINT32(tsLow, header, 4U);
+    __SET_UINT16B(length, header, 8U);
+
+    // the header and datagram are queued as one write, so a record is never split by a dropped write
+    std::string record;
+    record.reserve(CAPTURE_RECORD_HEADER_LEN + length);
+    record.append((const char*)header, CAPTURE_RECORD_HEADER_LEN);
+    record.append((const char*)data, length);
+
+    if (m_writer.write(m_fileName, record.c_str(), record.size()))
+        m_count++;
+}
+
+/* Writes all queued records and closes the capture file. */
+
+void PacketCapture::close()
+{
+    m_writer.stop();
+
+    if (m_writer.dropped() > 0U) {
+        LogWarning(LOG_NET, "Packet capture %s, dropped %llu bytes, disk could not keep up", m_fileName.c_str(),
+            (unsigned long long)m_writer.dropped());
+    }
+}
+
+/* Gets the current time in microseconds since the UNIX epoch. */
+
+uint64_t PacketCapture::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/* Initializes a new instance of the PacketCaptureReader class. */
+
+PacketCaptureReader::PacketCaptureReader() :
+    m_fp(nullptr)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the PacketCaptureReader class. */
+
+PacketCaptureReader::~PacketCaptureReader()
+{
+    close();
+}
+
+/* Opens a capture file. */
+
+bool PacketCaptureReader::open(const std::string& fileName)
+{
+    close();
+
+    m_fp = ::fopen(fileName.c_str(), "rb");
+    if (m_fp == nullptr) {
+        LogError(LOG_NET, "Cannot open the packet capture - %s", fileName.c_str());
+        return false;
+    }
+
+    char magic[CAPTURE_FILE_MAGIC_LEN];
+    if (::fread(magic, 1U, CAPTURE_FILE_MAGIC_LEN, m_fp) != CAPTURE_FILE_MAGIC_LEN ||
+        ::memcmp(magic, CAPTURE_FILE_MAGIC, CAPTURE_FILE_MAGIC_LEN) != 0) {
+        LogError(LOG_NET, "%s is not a packet capture", fileName.c_str());
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/* Closes the capture file. */
+
+void PacketCaptureReader::close()
+{
+    if (m_fp != nullptr) {
+        ::fclose(m_fp);
+        m_fp = nullptr;
+    }
+}
+
+/* Reads the next datagram from the capture file. */
+
+bool PacketCaptureReader::read(uint64_t& timestamp, uint8_t* data, uint32_t& length)
+{
+    assert(data != nullptr);
+
+    if (m_fp == nullptr)
+        return false;
+
+    uint8_t header[CAPTURE_RECORD_HEADER_LEN];
+    if (::fread(header, 1U, CAPTURE_RECORD_HEADER_LEN, m_fp) != CAPTURE_RECORD_HEADER_LEN)
+        return false;
+
+    uint32_t tsHigh = __GET_UINT32(header, 0U);
+    uint32_t tsLow = __GET_UINT32(header, 4U);
+    timestamp = ((uint64_t)tsHigh << 32) | tsLow;
+
+    length = __GET_UINT16B(header, 8U);
+    if (length == 0U || ::fread(data, 1U, length, m_fp) != length)
+        return false;
+
+    return true;
+}
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PacketCapture.h
+ * @ingroup network_core
+ * @file PacketCapture.cpp
+ * @ingroup network_core
+ */
+#if !defined(__PACKET_CAPTURE_H__)
+#define __PACKET_CAPTURE_H__
+
+#include "common/Defines.h"
+#include "common/AsyncFileWriter.h"
+
+#include <cstdio>
+#include <string>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @addtogroup network_core
+     * @{
+     */
+
+    /** @brief Capture file header. */
+    const char      CAPTURE_FILE_MAGIC[] = "DVMPCAP\x01";
+    /** @brief Length of the capture file header. */
+    const uint32_t  CAPTURE_FILE_MAGIC_LEN = 8U;
+    /** @brief Length of the header preceding each captured datagram (64-bit receive time (us), 16-bit length). */
+    const uint32_t  CAPTURE_RECORD_HEADER_LEN = 10U;
+    /** @} */
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a capture file of received RTP/FNE datagrams.
+     *
+     *  A capture file is the 8-byte CAPTURE_FILE_MAGIC header followed by one record per datagram;
+     *  each record is the receive time (big-endian 64-bit microseconds since the UNIX epoch), the
+     *  big-endian 16-bit datagram length and the unmodified (decrypted) datagram, starting with its
+     *  RTP header. Records are written through an AsyncFileWriter, so capturing never blocks the
+     *  network thread on disk I/O.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PacketCapture {
+    public:
+        /**
+         * @brief Initializes a new instance of the PacketCapture class.
+         * @param fileName Full path to the capture file.
+         */
+        PacketCapture(const std::string& fileName);
+        /**
+         * @brief Finalizes a instance of the PacketCapture class.
+         */
+        ~PacketCapture();
+
+        /**
+         * @brief Appends a received datagram to the capture file.
+         * @param[in] data Datagram, starting with the RTP header.
+         * @param length Length of datagram.
+         */
+        void record(const uint8_t* data, uint32_t length);
+
+        /**
+         * @brief Writes all queued records and closes the capture file.
+         */
+        void close();
+
+        /**
+         * @brief Gets the number of captured datagrams.
+         * @returns uint64_t Number of captured datagrams.
+         */
+        uint64_t count() const { return m_count; }
+
+        /**
+         * @brief Gets the current time in microseconds since the UNIX epoch.
+         * @returns uint64_t Current time (us).
+         */
+        static uint64_t now();
+
+    private:
+        std::string m_fileName;
+        AsyncFileWriter m_writer;
+        uint64_t m_count;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a sequential reader of a capture file written by PacketCapture.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PacketCaptureReader {
+    public:
+        /**
+         * @brief Initializes a new instance of the PacketCaptureReader class.
+         */
+        PacketCaptureReader();
+        /**
+         * @brief Finalizes a instance of the PacketCaptureReader class.
+         */
+        ~PacketCaptureReader();
+
+        /**
+         * @brief Opens a capture file.
+         * @param fileName Full path to the capture file.
+         * @returns bool True, if the capture file was opened, otherwise false.
+         */
+        bool open(const std::string& fileName);
+        /**
+         * @brief Closes the capture file.
+         */
+        void close();
+
+        /**
+         * @brief Reads the next datagram from the capture file.
+         * @param[out] timestamp Receive time (us).
+         * @param[out] data Buffer to read the datagram into (at least 65535 bytes).
+         * @param[out] length Length of datagram.
+         * @returns bool True, if a datagram was read, otherwise false (end of file or truncated record).
+         */
+        bool read(uint64_t& timestamp, uint8_t* data, uint32_t& length);
+
+    private:
+        FILE* m_fp;
+    };
+} // namespace network
+
+#endif // __PACKET_CAPTURE_H__
@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/BaseNetwork.h"
+#include "network/PeerLinkPeers.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t ENTRY_FULL = 0x00U;
+const uint8_t ENTRY_STATUS = 0x01U;
+const uint8_t ENTRY_REMOVE = 0x02U;
+
+const uint8_t STATUS_FLAG_CONNECTED = 0x01U;
+
+const uint32_t ENTRY_HEADER_LENGTH = 5U;
+const uint32_t ENTRY_STATUS_LENGTH = 14U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to append a big-endian value to a buffer. */
+
+static void append(std::vector<uint8_t>& buffer, uint64_t value, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++)
+        buffer.push_back((uint8_t)((value >> ((length - 1U - i) * 8U)) & 0xFFU));
+}
+
+/* Helper to read a big-endian value from a buffer. */
+
+static uint64_t read(const uint8_t* data, uint32_t offset, uint32_t length)
+{
+    uint64_t value = 0U;
+    for (uint32_t i = 0U; i < length; i++)
+        value = (value << 8) | data[offset + i];
+    return value;
+}
+
+/* Helper to encode the connection and ping state of a peer. */
+
+static std::vector<uint8_t> encodeStatus(const PeerLinkPeer& peer)
+{
+    std::vector<uint8_t> status;
+    status.reserve(ENTRY_STATUS_LENGTH);
+
+    status.push_back(peer.connected ? STATUS_FLAG_CONNECTED : 0x00U);
+    status.push_back(peer.connectionState);
+    append(status, peer.pingsReceived, 4U);
+    append(status, peer.lastPing, 8U);
+
+    return status;
+}
+
+/* Helper to encode the address, configuration and channel state of a peer. */
+
+static std::vector<uint8_t> encodeStatic(const PeerLinkPeer& peer)
+{
+    std::vector<uint8_t> data;
+
+    uint16_t vcCount = (peer.voiceChannels.size() > 0xFFFFU) ? 0xFFFFU : (uint16_t)peer.voiceChannels.size();
+    uint8_t addrLen = (peer.address.size() > 0xFFU) ? 0xFFU : (uint8_t)peer.address.size();
+    uint16_t configLen = (peer.config.size() > 0xFFFFU) ? 0U : (uint16_t)peer.config.size();
+
+    data.reserve(11U + (vcCount * 4U) + addrLen + configLen);
+
+    append(data, peer.port, 2U);
+    append(data, peer.ccPeerId, 4U);
+    append(data, vcCount, 2U);
+    for (uint16_t i = 0U; i < vcCount; i++)
+        append(data, peer.voiceChannels[i], 4U);
+    data.push_back(addrLen);
+    data.insert(data.end(), peer.address.begin(), peer.address.begin() + addrLen);
+    append(data, configLen, 2U);
+    data.insert(data.end(), peer.config.begin(), peer.config.begin() + configLen);
+
+    return data;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the PeerLinkPeersEncoder class. */
+
+PeerLinkPeersEncoder::PeerLinkPeersEncoder() :
+    m_updates(0U),
+    m_seq(0U),
+    m_lastStatic(),
+    m_lastStatus(),
+    m_messages()
+{
+    /* stub */
+}
+
+/* Builds the messages for the current active peer list. */
+
+void PeerLinkPeersEncoder::update(const std::vector<PeerLinkPeer>& peers)
+{
+    bool snapshot = (m_updates % PEER_LINK_PEERS_SNAPSHOT_INTERVAL) == 0U;
+    m_updates++;
+    m_seq++;
+
+    m_messages.clear();
+
+    std::vector<uint8_t> message;
+    uint16_t entries = 0U;
+
+    // helper to start a new message
+    auto begin = [&]() {
+        uint16_t total = (peers.size() > 0xFFFFU) ? 0xFFFFU : (uint16_t)peers.size();
+
+        message.reserve(PEER_LINK_PEERS_MAX_LENGTH);
+        message.insert(message.end(), TAG_PEER_LINK, TAG_PEER_LINK + 4U);
+        message.push_back(PEER_LINK_PEERS_FORMAT);
+        message.push_back(snapshot ? PEER_LINK_PEERS_FLAG_SNAPSHOT : 0x00U);
+        append(message, m_seq, 2U);
+        append(message, snapshot ? total : 0U, 2U);
+        append(message, 0U, 2U);
+    };
+
+    // helper to complete the message being built
+    auto flush = [&]() {
+        message[10U] = (entries >> 8) & 0xFFU;
+        message[11U] = (entries >> 0) & 0xFFU;
+        m_messages.push_back(message);
+        message.clear();
+        entries = 0U;
+    };
+
+    // helper to add an entry, starting a new message when the current one is full
+    auto addEntry = [&](uint8_t type, uint32_t peerId, const std::vector<uint8_t>* status, const std::vector<uint8_t>* data) {
+        uint32_t len = ENTRY_HEADER_LENGTH + ((status != nullptr) ? status->size() : 0U) + ((data != nullptr) ? data->size() : 0U);
+        if (!message.empty() && (entries == 0xFFFFU || message.size() + len > PEER_LINK_PEERS_MAX_LENGTH))
+            flush();
+        if (message.empty())
+            begin();
+
+        message.push_back(type);
+        append(message, peerId, 4U);
+        if (status != nullptr)
+            message.insert(message.end(), status->begin(), status->end());
+        if (data != nullptr)
+            message.insert(message.end(), data->begin(), data->end());
+        entries++;
+    };
+
+    std::unordered_map<uint32_t, std::vector<uint8_t>> currStatic;
+    std::unordered_map<uint32_t, std::vector<uint8_t>> currStatus;
+    for (const PeerLinkPeer& peer : peers) {
+        std::vector<uint8_t> status = encodeStatus(peer);
+        std::vector<uint8_t> data = encodeStatic(peer);
+
+        auto itStatic = m_lastStatic.find(peer.peerId);
+        if (snapshot || itStatic == m_lastStatic.end() || itStatic->second != data) {
+            addEntry(ENTRY_FULL, peer.peerId, &status, &data);
+        }
+        else {
+            auto itStatus = m_lastStatus.find(peer.peerId);
+            if (itStatus == m_lastStatus.end() || itStatus->second != status)
+                addEntry(ENTRY_STATUS, peer.peerId, &status, nullptr);
+        }
+
+        currStatic[peer.peerId] = std::move(data);
+        currStatus[peer.peerId] = std::move(status);
+    }
+
+    // a snapshot replaces the list outright, otherwise report the peers that went away
+    if (!snapshot) {
+        for (auto& entry : m_lastStatic) {
+            if (currStatic.find(entry.first) == currStatic.end())
+                addEntry(ENTRY_REMOVE, entry.first, nullptr, nullptr);
+        }
+    }
+
+    // an empty snapshot is still sent, so the masters clear their list
+    if (snapshot && message.empty() && m_messages.empty())
+        begin();
+    if (!message.empty())
+        flush();
+
+    m_lastStatic = std::move(currStatic);
+    m_lastStatus = std::move(currStatus);
+}
+
+/* Initializes a new instance of the PeerLinkPeersDecoder class. */
+
+PeerLinkPeersDecoder::PeerLinkPeersDecoder() :
+    m_peers(),
+    m_snapshotValid(false),
+    m_snapshotSeq(0U),
+    m_snapshotPeers()
+{
+    /* stub */
+}
+
+/* Applies a received message to the peer list. */
+
+bool PeerLinkPeersDecoder::decode(uint32_t parentPeerId, const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+
+    if (length < PEER_LINK_PEERS_HEADER_LENGTH)
+        return false;
+    if (data[4U] != PEER_LINK_PEERS_FORMAT) {
+        LogWarning(LOG_NET, "PEER %u unsupported Peer-Link peer list format, format = $%02X", parentPeerId, data[4U]);
+        return false;
+    }
+
+    bool snapshot = (data[5U] & PEER_LINK_PEERS_FLAG_SNAPSHOT) == PEER_LINK_PEERS_FLAG_SNAPSHOT;
+    uint16_t seq = (uint16_t)read(data, 6U, 2U);
+    uint16_t total = (uint16_t)read(data, 8U, 2U);
+    uint16_t entries = (uint16_t)read(data, 10U, 2U);
+
+    // a snapshot may span several messages, track which peers it has covered so far
+    if (snapshot && (!m_snapshotValid || m_snapshotSeq != seq)) {
+        m_snapshotValid = true;
+        m_snapshotSeq = seq;
+        m_snapshotPeers.clear();
+    }
+
+    uint32_t offs = PEER_LINK_PEERS_HEADER_LENGTH;
+    for (uint16_t n = 0U; n < entries; n++) {
+        if (offs + ENTRY_HEADER_LENGTH > length)
+            return false;
+
+        uint8_t type = data[offs];
+        uint32_t peerId = (uint32_t)read(data, offs + 1U, 4U);
+        offs += ENTRY_HEADER_LENGTH;
+
+        if (type == ENTRY_REMOVE) {
+            m_peers.erase(peerId);
+            continue;
+        }
+
+        if (offs + ENTRY_STATUS_LENGTH > length)
+            return false;
+
+        bool connected = (data[offs] & STATUS_FLAG_CONNECTED) == STATUS_FLAG_CONNECTED;
+        uint32_t connectionState = data[offs + 1U];
+        uint32_t pingsReceived = (uint32_t)read(data, offs + 2U, 4U);
+        uint64_t lastPing = read(data, offs + 6U, 8U);
+        offs += ENTRY_STATUS_LENGTH;
+
+        if (type == ENTRY_STATUS) {
+            auto it = m_peers.find(peerId);
+            if (it != m_peers.end()) {
+                it->second["connected"].set<bool>(connected);
+                it->second["connectionState"].set<uint32_t>(connectionState);
+                it->second["pingsReceived"].set<uint32_t>(pingsReceived);
+                it->second["lastPing"].set<uint64_t>(lastPing);
+            }
+
+            continue;
+        }
+
+        if (type != ENTRY_FULL)
+            return false;
+
+        if (offs + 8U > length)
+            return false;
+
+        uint16_t port = (uint16_t)read(data, offs, 2U);
+        uint32_t ccPeerId = (uint32_t)read(data, offs + 2U, 4U);
+        uint16_t vcCount = (uint16_t)read(data, offs + 6U, 2U);
+        offs += 8U;
+
+        if (offs + (vcCount * 4U) + 1U > length)
+            return false;
+
+        json::array voiceChannels = json::array();
+        for (uint16_t i = 0U; i < vcCount; i++) {
+            voiceChannels.push_back(json::value((double)read(data, offs, 4U)));
+            offs += 4U;
+        }
+
+        uint8_t addrLen = data[offs++];
+        if (offs + addrLen + 2U > length)
+            return false;
+
+        std::string address((const char*)data + offs, addrLen);
+        offs += addrLen;
+
+        uint16_t configLen = (uint16_t)read(data, offs, 2U);
+        offs += 2U;
+        if (offs + configLen > length)
+            return false;
+
+        json::object config = json::object();
+        if (configLen > 0U) {
+            json::value v;
+            std::string err = json::parse(v, std::string((const char*)data + offs, configLen));
+            if (err.empty() && v.is<json::object>())
+                config = v.get<json::object>();
+        }
+        offs += configLen;
+
+        json::object peerObj = json::object();
+        peerObj["peerId"].set<uint32_t>(peerId);
+        peerObj["address"].set<std::string>(address);
+        peerObj["port"].set<uint16_t>(port);
+        peerObj["connected"].set<bool>(connected);
+        peerObj["connectionState"].set<uint32_t>(connectionState);
+        peerObj["pingsReceived"].set<uint32_t>(pingsReceived);
+        peerObj["lastPing"].set<uint64_t>(lastPing);
+        peerObj["controlChannel"].set<uint32_t>(ccPeerId);
+        peerObj["config"].set<json::object>(config);
+        peerObj["voiceChannels"].set<json::array>(voiceChannels);
+        peerObj["parentPeerId"].set<uint32_t>(parentPeerId);
+
+        m_peers[peerId] = peerObj;
+
+        if (snapshot)
+            m_snapshotPeers.insert(peerId);
+    }
+
+    // once the whole snapshot has arrived, drop any peers it didn't contain
+    if (snapshot && m_snapshotValid && m_snapshotPeers.size() >= total) {
+        for (auto it = m_peers.begin(); it != m_peers.end();) {
+            if (m_snapshotPeers.find(it->first) == m_snapshotPeers.end())
+                it = m_peers.erase(it);
+            else
+                ++it;
+        }
+
+        m_snapshotValid = false;
+        m_snapshotPeers.clear();
+    }
+
+    return true;
+}
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PeerLinkPeers.h
+ * @ingroup network_core
+ * @file PeerLinkPeers.cpp
+ * @ingroup network_core
+ */
+#if !defined(__PEER_LINK_PEERS_H__)
+#define __PEER_LINK_PEERS_H__
+
+#include "common/Defines.h"
+#include "common/network/json/json.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t PEER_LINK_PEERS_HEADER_LENGTH = 12U;
+    const uint32_t PEER_LINK_PEERS_MAX_LENGTH = 4096U;
+    const uint32_t PEER_LINK_PEERS_SNAPSHOT_INTERVAL = 12U;    // updates between full snapshots
+
+    const uint8_t PEER_LINK_PEERS_FORMAT = 0x01U;
+    const uint8_t PEER_LINK_PEERS_FLAG_SNAPSHOT = 0x01U;
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a peer in the Peer-Link active peer list.
+     * @ingroup network_core
+     */
+    struct PeerLinkPeer {
+        uint32_t peerId;                        //! Peer ID.
+        std::string address;                    //! IP address.
+        uint16_t port;                          //! Port number.
+        bool connected;                         //! Flag indicating the peer is connected.
+        uint8_t connectionState;                //! Connection state.
+        uint32_t pingsReceived;                 //! Number of pings received.
+        uint64_t lastPing;                      //! Last ping received.
+        uint32_t ccPeerId;                      //! Control channel peer ID.
+        std::vector<uint32_t> voiceChannels;    //! Voice channel peer IDs.
+        std::string config;                     //! Serialized JSON peer configuration.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the binary encoding of the Peer-Link active peer list.
+     *
+     *  Each update only carries the peers that changed since the previous update; peers whose
+     *  address, configuration or voice channels changed are sent in full, peers whose connection
+     *  or ping state changed are sent as a short status entry, and peers that disconnected are sent
+     *  as a removal. Every PEER_LINK_PEERS_SNAPSHOT_INTERVAL updates the full list is sent, so
+     *  masters that missed an update (or connected since) converge. The messages are built once and
+     *  sent to every Peer-Link master.
+     *
+     *  Message layout:
+     *   [0-3]   TAG_PEER_LINK
+     *   [4]     Format
+     *   [5]     Flags
+     *   [6-7]   Update sequence
+     *   [8-9]   Total peers (snapshot only)
+     *   [10-11] Number of entries in this message
+     *   [12..]  Entries
+     * @ingroup network_core
+     */
+    class HOST_SW_API PeerLinkPeersEncoder {
+    public:
+        /**
+         * @brief Initializes a new instance of the PeerLinkPeersEncoder class.
+         */
+        PeerLinkPeersEncoder();
+
+        /**
+         * @brief Builds the messages for the current active peer list.
+         * @param peers Active peer list.
+         */
+        void update(const std::vector<PeerLinkPeer>& peers);
+        /**
+         * @brief Forces the next update to be a full snapshot.
+         */
+        void forceSnapshot() { m_updates = 0U; }
+
+        /**
+         * @brief Gets the messages built by the last update.
+         * @returns std::vector<std::vector<uint8_t>> Messages to send.
+         */
+        const std::vector<std::vector<uint8_t>>& messages() const { return m_messages; }
+
+    private:
+        uint32_t m_updates;
+        uint16_t m_seq;
+
+        std::unordered_map<uint32_t, std::vector<uint8_t>> m_lastStatic;
+        std::unordered_map<uint32_t, std::vector<uint8_t>> m_lastStatus;
+
+        std::vector<std::vector<uint8_t>> m_messages;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the decoding of the Peer-Link active peer list received from a single peer.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PeerLinkPeersDecoder {
+    public:
+        /**
+         * @brief Initializes a new instance of the PeerLinkPeersDecoder class.
+         */
+        PeerLinkPeersDecoder();
+
+        /**
+         * @brief Applies a received message to the peer list.
+         * @param parentPeerId Peer ID of the Peer-Link peer the message was received from.
+         * @param[in] data Buffer containing the message.
+         * @param length Length of buffer.
+         * @returns bool True, if the message was decoded, otherwise false.
+         */
+        bool decode(uint32_t parentPeerId, const uint8_t* data, uint32_t length);
+
+        /**
+         * @brief Gets the peer list.
+         * @returns std::map<uint32_t, json::object> Peer list, keyed by peer ID.
+         */
+        const std::map<uint32_t, json::object>& peers() const { return m_peers; }
+
+    private:
+        std::map<uint32_t, json::object> m_peers;
+
+        bool m_snapshotValid;
+        uint16_t m_snapshotSeq;
+        std::unordered_set<uint32_t> m_snapshotPeers;
+    };
+} // namespace network
+
+#endif // __PEER_LINK_PEERS_H__
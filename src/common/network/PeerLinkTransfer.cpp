@@ -0,0 +1,529 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/PeerLinkTransfer.h"
+#include "edac/CRC.h"
+#include "Log.h"
+#include "Utils.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the PeerLinkTransmitter class. */
+
+PeerLinkTransmitter::PeerLinkTransmitter(uint8_t subFunc) :
+    m_subFunc(subFunc),
+    m_transferId(0U),
+    m_length(0U),
+    m_blockCount(0U),
+    m_retransmits(0U),
+    m_base(0U),
+    m_compressed(),
+    m_acked(),
+    m_sentTime(),
+    m_sentSeq(),
+    m_sendCounter(0U),
+    m_probing(true),
+    m_failed(false),
+    m_lastProgress(0U)
+{
+    /* stub */
+}
+
+/* Compresses the data to transfer. */
+
+bool PeerLinkTransmitter::setData(const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+
+    if (length == 0U || length > PEER_LINK_XFER_MAX_LENGTH) {
+        LogError(LOG_NET, "Peer-Link transfer, invalid length, len = %u", length);
+        return false;
+    }
+
+    // compression structures
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    // initialize compression
+    if (deflateInit(&strm, Z_DEFAULT_COMPRESSION) != Z_OK) {
+        LogError(LOG_NET, "Peer-Link transfer, error initializing ZLIB");
+        return false;
+    }
+
+    // set input data
+    strm.avail_in = length;
+    strm.next_in = (uint8_t*)data;
+
+    // compress data
+    m_compressed.resize(deflateBound(&strm, length));
+    strm.avail_out = m_compressed.size();
+    strm.next_out = m_compressed.data();
+
+    int ret = deflate(&strm, Z_FINISH);
+    if (ret != Z_STREAM_END) {
+        LogError(LOG_NET, "Peer-Link transfer, error compressing data");
+        deflateEnd(&strm);
+        return false;
+    }
+
+    m_compressed.resize(strm.total_out);
+    deflateEnd(&strm);
+
+    uint32_t blockCount = (m_compressed.size() + PEER_LINK_BLOCK_SIZE - 1U) / PEER_LINK_BLOCK_SIZE;
+    if (blockCount > 0xFFFFU) {
+        LogError(LOG_NET, "Peer-Link transfer, data too large, compressedLen = %u", (uint32_t)m_compressed.size());
+        return false;
+    }
+
+    m_transferId = edac::CRC::createCRC32(data, length);
+    m_length = length;
+    m_blockCount = (uint16_t)blockCount;
+
+    m_acked.assign(m_blockCount, false);
+    m_sentTime.assign(m_blockCount, 0U);
+    m_sentSeq.assign(m_blockCount, 0U);
+    m_base = 0U;
+    m_retransmits = 0U;
+    m_probing = true;
+    m_failed = false;
+
+    return true;
+}
+
+/* Starts (or restarts) the transfer, all unacknowledged blocks become due for transmission. */
+
+void PeerLinkTransmitter::start(uint64_t now)
+{
+    // until the receiver acknowledges, only block 0 is sent -- the first acknowledgement
+    // tells us how much of this transfer the receiver already holds
+    m_probing = true;
+    m_failed = false;
+    m_lastProgress = now;
+
+    for (uint32_t i = m_base; i < m_blockCount; i++)
+        m_sentTime[i] = 0U;
+}
+
+/* Sends any blocks due for (re)transmission. */
+
+void PeerLinkTransmitter::clock(uint64_t now, WriteHandler write)
+{
+    if (isComplete() || m_failed)
+        return;
+
+    uint32_t limit = m_base + (m_probing ? 1U : PEER_LINK_XFER_WINDOW);
+    if (limit > m_blockCount)
+        limit = m_blockCount;
+
+    uint8_t buffer[PEER_LINK_XFER_HEADER_LENGTH + PEER_LINK_BLOCK_SIZE];
+    for (uint32_t i = m_base; i < limit; i++) {
+        if (m_acked[i])
+            continue;
+        if (m_sentTime[i] != 0U && (now - m_sentTime[i]) < PEER_LINK_XFER_RETRY_TIME)
+            continue;
+
+        if (m_sentSeq[i] != 0U)
+            m_retransmits++;
+
+        m_sentTime[i] = now;
+        m_sentSeq[i] = ++m_sendCounter;
+
+        uint32_t len = encodeBlock((uint16_t)i, buffer);
+        write(buffer, len);
+    }
+}
+
+/* Processes a transfer acknowledgement from the receiver. */
+
+bool PeerLinkTransmitter::processAck(const uint8_t* data, uint32_t length, uint64_t now)
+{
+    assert(data != nullptr);
+
+    if (length < PEER_LINK_XFER_ACK_LENGTH)
+        return false;
+
+    uint32_t transferId = __GET_UINT32(data, 4U);
+    if (data[0U] != m_subFunc || transferId != m_transferId)
+        return false;
+
+    if ((data[1U] & PEER_LINK_XFER_ACK_FLAG_ERROR) == PEER_LINK_XFER_ACK_FLAG_ERROR) {
+        m_failed = true;
+        return true;
+    }
+
+    uint16_t next = __GET_UINT16B(data, 2U);
+    if (next > m_blockCount)
+        return true;
+
+    m_probing = false;
+
+    // cumulative acknowledgement
+    if (next > m_base) {
+        for (uint32_t i = m_base; i < next; i++)
+            m_acked[i] = true;
+        m_base = next;
+        m_lastProgress = now;
+    }
+
+    // selective acknowledgement of the blocks following the first missing block
+    uint32_t sack = __GET_UINT32(data, 8U);
+    uint32_t sackSeq[32U];
+    uint32_t sackCnt = 0U;
+    for (uint32_t n = 0U; n < 32U; n++) {
+        uint32_t i = next + 1U + n;
+        if (i >= m_blockCount)
+            break;
+
+        if ((sack & (1U << n)) != 0U) {
+            if (!m_acked[i]) {
+                m_acked[i] = true;
+                m_lastProgress = now;
+            }
+
+            sackSeq[sackCnt++] = m_sentSeq[i];
+        }
+    }
+
+    // a block is taken as lost (and resent on the next clock rather than waiting for it to time out)
+    // once the receiver has seen PEER_LINK_XFER_REORDER blocks that were sent after it
+    if (sackCnt >= PEER_LINK_XFER_REORDER) {
+        uint32_t limit = next + 33U;
+        if (limit > m_blockCount)
+            limit = m_blockCount;
+
+        for (uint32_t i = m_base; i < limit; i++) {
+            if (m_acked[i] || m_sentSeq[i] == 0U)
+                continue;
+
+            uint32_t later = 0U;
+            for (uint32_t n = 0U; n < sackCnt; n++) {
+                if (sackSeq[n] > m_sentSeq[i])
+                    later++;
+            }
+
+            if (later >= PEER_LINK_XFER_REORDER)
+                m_sentTime[i] = 0U;
+        }
+    }
+
+    return true;
+}
+
+/* Helper to build the transfer header and payload for a block. */
+
+uint32_t PeerLinkTransmitter::encodeBlock(uint16_t block, uint8_t* buffer) const
+{
+    assert(buffer != nullptr);
+    assert(block < m_blockCount);
+
+    uint32_t compressedLen = m_compressed.size();
+    uint32_t offs = block * PEER_LINK_BLOCK_SIZE;
+    uint32_t blockLen = PEER_LINK_BLOCK_SIZE;
+    if (offs + blockLen > compressedLen)
+        blockLen = compressedLen - offs;
+
+    const uint8_t* payload = m_compressed.data() + offs;
+    uint32_t crc = edac::CRC::createCRC32(payload, blockLen);
+
+    __SET_UINT32(m_length, buffer, 0U);
+    __SET_UINT32(compressedLen, buffer, 4U);
+    __SET_UINT16B(block, buffer, 8U);
+    __SET_UINT16B(m_blockCount, buffer, 10U);
+    __SET_UINT32(m_transferId, buffer, 12U);
+    __SET_UINT32(crc, buffer, 16U);
+    ::memcpy(buffer + PEER_LINK_XFER_HEADER_LENGTH, payload, blockLen);
+
+    return PEER_LINK_XFER_HEADER_LENGTH + blockLen;
+}
+
+/* Initializes a new instance of the PeerLinkReceiver class. */
+
+PeerLinkReceiver::PeerLinkReceiver(uint8_t subFunc) :
+    m_subFunc(subFunc),
+    m_transferId(0U),
+    m_blockCount(0U),
+    m_length(0U),
+    m_compressedLength(0U),
+    m_next(0U),
+    m_pending(),
+    m_strm(),
+    m_inflating(false),
+    m_streamEnd(false),
+    m_data(),
+    m_complete(false),
+    m_ackPending(false),
+    m_ackError(false)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the PeerLinkReceiver class. */
+
+PeerLinkReceiver::~PeerLinkReceiver()
+{
+    reset();
+}
+
+/* Processes a transfer block. */
+
+PeerLinkReceiver::Status PeerLinkReceiver::process(const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+
+    if (length < PEER_LINK_XFER_HEADER_LENGTH) {
+        LogWarning(LOG_NET, "Peer-Link transfer, malformed block, len = %u", length);
+        return XFER_PENDING;
+    }
+
+    uint32_t len = __GET_UINT32(data, 0U);
+    uint32_t compressedLen = __GET_UINT32(data, 4U);
+    uint16_t block = __GET_UINT16B(data, 8U);
+    uint16_t blockCount = __GET_UINT16B(data, 10U);
+    uint32_t transferId = __GET_UINT32(data, 12U);
+    uint32_t crc = __GET_UINT32(data, 16U);
+
+    if (len == 0U || len > PEER_LINK_XFER_MAX_LENGTH || compressedLen == 0U ||
+        blockCount != (compressedLen + PEER_LINK_BLOCK_SIZE - 1U) / PEER_LINK_BLOCK_SIZE || block >= blockCount) {
+        LogWarning(LOG_NET, "Peer-Link transfer, invalid block header, block = %u, blockCnt = %u, len = %u, compressedLen = %u",
+            block, blockCount, len, compressedLen);
+        return XFER_PENDING;
+    }
+
+    uint32_t offs = block * PEER_LINK_BLOCK_SIZE;
+    uint32_t blockLen = PEER_LINK_BLOCK_SIZE;
+    if (offs + blockLen > compressedLen)
+        blockLen = compressedLen - offs;
+
+    const uint8_t* payload = data + PEER_LINK_XFER_HEADER_LENGTH;
+    if (length < PEER_LINK_XFER_HEADER_LENGTH + blockLen || edac::CRC::createCRC32(payload, blockLen) != crc) {
+        // treated as lost, the transmitter will resend it
+        LogWarning(LOG_NET, "Peer-Link transfer, block %u failed CRC", block);
+        return XFER_PENDING;
+    }
+
+    if (transferId == m_transferId && m_complete) {
+        // the transmitter doesn't know we already have this, tell it
+        m_ackPending = true;
+        return XFER_UNCHANGED;
+    }
+
+    // a different transfer supersedes whatever was in progress
+    if (transferId != m_transferId || m_blockCount != blockCount) {
+        if (!begin(transferId, len, compressedLen, blockCount)) {
+            m_ackPending = true;
+            m_ackError = true;
+            return XFER_FAILED;
+        }
+    }
+
+    if (block < m_next) {
+        // duplicate; the transmitter is (re)starting or missed an acknowledgement
+        m_ackPending = true;
+        return XFER_PENDING;
+    }
+
+    if (block > m_next) {
+        // hold blocks arriving ahead of a gap, and acknowledge to report the gap
+        if (block < m_next + PEER_LINK_XFER_WINDOW && m_pending.find(block) == m_pending.end()) {
+            m_pending[block] = std::vector<uint8_t>(payload, payload + blockLen);
+        }
+
+        m_ackPending = true;
+        return XFER_PENDING;
+    }
+
+    bool first = (m_next == 0U);
+
+    // inflate this block, and any held blocks that are now in order
+    bool ret = inflateBlock(payload, blockLen);
+    m_next++;
+    while (ret) {
+        auto it = m_pending.find(m_next);
+        if (it == m_pending.end())
+            break;
+
+        ret = inflateBlock(it->second.data(), it->second.size());
+        m_pending.erase(it);
+        m_next++;
+    }
+
+    if (!ret) {
+        LogError(LOG_NET, "Peer-Link transfer, error decompressing block %u", m_next - 1U);
+        uint32_t failedId = m_transferId;
+        reset();
+        m_transferId = failedId;
+        m_ackPending = true;
+        m_ackError = true;
+        return XFER_FAILED;
+    }
+
+    if (first || (m_next % PEER_LINK_XFER_ACK_INTERVAL) == 0U)
+        m_ackPending = true;
+
+    if (m_next < m_blockCount)
+        return XFER_PENDING;
+
+    // last block
+    m_ackPending = true;
+
+    inflateEnd(&m_strm);
+    m_inflating = false;
+
+    if (!m_streamEnd || m_data.size() != m_length) {
+        LogError(LOG_NET, "Peer-Link transfer, decompressed data was not of expected size! %u != %u", (uint32_t)m_data.size(), m_length);
+        uint32_t failedId = m_transferId;
+        reset();
+        m_transferId = failedId;
+        m_ackPending = true;
+        m_ackError = true;
+        return XFER_FAILED;
+    }
+
+    m_complete = true;
+    return XFER_COMPLETE;
+}
+
+/* Builds the pending acknowledgement. */
+
+uint32_t PeerLinkReceiver::encodeAck(uint8_t* buffer)
+{
+    assert(buffer != nullptr);
+
+    ::memset(buffer, 0x00U, PEER_LINK_XFER_ACK_LENGTH);
+
+    uint16_t next = m_complete ? m_blockCount : m_next;
+
+    // bit n is set when block (next + 1 + n) is being held
+    uint32_t sack = 0U;
+    for (auto& entry : m_pending) {
+        uint32_t n = entry.first - next - 1U;
+        if (n < 32U)
+            sack |= (1U << n);
+    }
+
+    buffer[0U] = m_subFunc;
+    buffer[1U] = m_ackError ? PEER_LINK_XFER_ACK_FLAG_ERROR : 0x00U;
+    __SET_UINT16B(next, buffer, 2U);
+    __SET_UINT32(m_transferId, buffer, 4U);
+    __SET_UINT32(sack, buffer, 8U);
+
+    m_ackPending = false;
+    if (m_ackError) {
+        m_ackError = false;
+        m_transferId = 0U;
+    }
+
+    return PEER_LINK_XFER_ACK_LENGTH;
+}
+
+/* Takes the uncompressed data of the completed transfer. */
+
+std::vector<uint8_t> PeerLinkReceiver::takeData()
+{
+    std::vector<uint8_t> data;
+    data.swap(m_data);
+    return data;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to begin a new transfer. */
+
+bool PeerLinkReceiver::begin(uint32_t transferId, uint32_t length, uint32_t compressedLength, uint16_t blockCount)
+{
+    reset();
+
+    m_transferId = transferId;
+    m_length = length;
+    m_compressedLength = compressedLength;
+    m_blockCount = blockCount;
+
+    m_strm.zalloc = Z_NULL;
+    m_strm.zfree = Z_NULL;
+    m_strm.opaque = Z_NULL;
+    m_strm.avail_in = 0U;
+    m_strm.next_in = Z_NULL;
+
+    // initialize decompression
+    if (inflateInit(&m_strm) != Z_OK) {
+        LogError(LOG_NET, "Peer-Link transfer, error initializing ZLIB");
+        return false;
+    }
+
+    m_inflating = true;
+    m_data.reserve(length);
+    return true;
+}
+
+/* Helper to discard the current transfer. */
+
+void PeerLinkReceiver::reset()
+{
+    if (m_inflating) {
+        inflateEnd(&m_strm);
+        m_inflating = false;
+    }
+
+    m_transferId = 0U;
+    m_blockCount = 0U;
+    m_length = 0U;
+    m_compressedLength = 0U;
+    m_next = 0U;
+    m_pending.clear();
+
+    m_streamEnd = false;
+    m_data.clear();
+    m_data.shrink_to_fit();
+
+    m_complete = false;
+}
+
+/* Helper to inflate the payload of the next in-order block. */
+
+bool PeerLinkReceiver::inflateBlock(const uint8_t* data, uint32_t length)
+{
+    if (!m_inflating || m_streamEnd)
+        return false;
+
+    m_strm.avail_in = length;
+    m_strm.next_in = (uint8_t*)data;
+
+    uint8_t outbuffer[4096U];
+    do {
+        m_strm.avail_out = sizeof(outbuffer);
+        m_strm.next_out = outbuffer;
+
+        int ret = inflate(&m_strm, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+            return false;
+
+        m_data.insert(m_data.end(), outbuffer, outbuffer + sizeof(outbuffer) - m_strm.avail_out);
+        if (m_data.size() > m_length)
+            return false;
+
+        if (ret == Z_STREAM_END) {
+            m_streamEnd = true;
+            break;
+        }
+    } while (m_strm.avail_out == 0U);
+
+    return true;
+}
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PeerLinkTransfer.h
+ * @ingroup network_core
+ * @file PeerLinkTransfer.cpp
+ * @ingroup network_core
+ */
+#if !defined(__PEER_LINK_TRANSFER_H__)
+#define __PEER_LINK_TRANSFER_H__
+
+#include "common/Defines.h"
+#include "common/network/RTPFNEHeader.h"
+#include "common/zlib/zlib.h"
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t PEER_LINK_XFER_HEADER_LENGTH = 20U;
+    const uint32_t PEER_LINK_XFER_ACK_LENGTH = 12U;
+
+    const uint32_t PEER_LINK_XFER_WINDOW = 32U;             // blocks in flight
+    const uint32_t PEER_LINK_XFER_ACK_INTERVAL = 8U;        // in-order blocks per acknowledgement
+    const uint32_t PEER_LINK_XFER_REORDER = 3U;             // later blocks received before a missing block is resent
+    const uint32_t PEER_LINK_XFER_RETRY_TIME = 500U;        // ms
+    const uint32_t PEER_LINK_XFER_TIMEOUT = 15000U;         // ms without progress
+    const uint32_t PEER_LINK_XFER_MAX_LENGTH = 64U * 1024U * 1024U;
+
+    const uint8_t PEER_LINK_XFER_ACK_FLAG_ERROR = 0x01U;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the sending side of a windowed Peer-Link bulk transfer.
+     *
+     *  The data is compressed and split into PEER_LINK_BLOCK_SIZE blocks, each carrying the
+     *  transfer header and a CRC-32 of its payload. Only block 0 is sent until the receiver first
+     *  acknowledges, which tells the transmitter where a previously interrupted transfer of the same
+     *  data left off; after that up to PEER_LINK_XFER_WINDOW unacknowledged blocks are in flight.
+     *  Blocks are retransmitted when they time out, or once the receiver reports several later blocks.
+     *
+     *  The transfer ID is the CRC-32 of the uncompressed data, so the same table always resumes
+     *  (or is recognized as unchanged) on the receiver.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PeerLinkTransmitter {
+    public:
+        /**
+         * @brief Callback used to write a block to the network.
+         */
+        typedef std::function<bool(const uint8_t* data, uint32_t length)> WriteHandler;
+
+        /**
+         * @brief Initializes a new instance of the PeerLinkTransmitter class.
+         * @param subFunc Peer-Link subfunction (table) being transferred.
+         */
+        PeerLinkTransmitter(uint8_t subFunc);
+
+        /**
+         * @brief Compresses the data to transfer.
+         * @param[in] data Buffer containing the data to transfer.
+         * @param length Length of buffer.
+         * @returns bool True, if the data was compressed, otherwise false.
+         */
+        bool setData(const uint8_t* data, uint32_t length);
+
+        /**
+         * @brief Starts (or restarts) the transfer, all unacknowledged blocks become due for transmission.
+         * @param now Current time (ms).
+         */
+        void start(uint64_t now);
+        /**
+         * @brief Sends any blocks due for (re)transmission.
+         * @param now Current time (ms).
+         * @param write Callback used to write a block to the network.
+         */
+        void clock(uint64_t now, WriteHandler write);
+        /**
+         * @brief Processes a transfer acknowledgement from the receiver.
+         * @param[in] data Buffer containing the acknowledgement.
+         * @param length Length of buffer.
+         * @param now Current time (ms).
+         * @returns bool True, if the acknowledgement belongs to this transfer, otherwise false.
+         */
+        bool processAck(const uint8_t* data, uint32_t length, uint64_t now);
+
+        /**
+         * @brief Flag indicating all blocks have been acknowledged.
+         * @returns bool True, if the transfer is complete, otherwise false.
+         */
+        bool isComplete() const { return m_base >= m_blockCount; }
+        /**
+         * @brief Flag indicating the receiver rejected the transfer, or has made no progress within the timeout.
+         * @param now Current time (ms).
+         * @returns bool True, if the transfer has failed, otherwise false.
+         */
+        bool hasFailed(uint64_t now) const { return m_failed || (now - m_lastProgress) >= PEER_LINK_XFER_TIMEOUT; }
+
+        /**
+         * @brief Helper to build the transfer header and payload for a block.
+         * @param block Block number.
+         * @param[out] buffer Buffer to write the block to (PEER_LINK_XFER_HEADER_LENGTH + PEER_LINK_BLOCK_SIZE bytes).
+         * @returns uint32_t Length of the block.
+         */
+        uint32_t encodeBlock(uint16_t block, uint8_t* buffer) const;
+
+    public:
+        /**
+         * @brief Peer-Link subfunction (table) being transferred.
+         */
+        __READONLY_PROPERTY_PLAIN(uint8_t, subFunc);
+        /**
+         * @brief Transfer ID (CRC-32 of the uncompressed data).
+         */
+        __READONLY_PROPERTY_PLAIN(uint32_t, transferId);
+        /**
+         * @brief Length of the uncompressed data.
+         */
+        __READONLY_PROPERTY_PLAIN(uint32_t, length);
+        /**
+         * @brief Number of blocks in the transfer.
+         */
+        __READONLY_PROPERTY_PLAIN(uint16_t, blockCount);
+        /**
+         * @brief Number of blocks that were retransmitted.
+         */
+        __READONLY_PROPERTY_PLAIN(uint32_t, retransmits);
+        /**
+         * @brief First block not yet acknowledged.
+         */
+        __READONLY_PROPERTY_PLAIN(uint16_t, base);
+
+    private:
+        std::vector<uint8_t> m_compressed;
+
+        std::vector<bool> m_acked;
+        std::vector<uint64_t> m_sentTime;
+        std::vector<uint32_t> m_sentSeq;
+        uint32_t m_sendCounter;
+
+        bool m_probing;
+        bool m_failed;
+        uint64_t m_lastProgress;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the receiving side of a windowed Peer-Link bulk transfer.
+     *
+     *  Blocks are checked against their CRC-32 and inflated as soon as they arrive in order; blocks
+     *  arriving ahead of a gap are held (up to PEER_LINK_XFER_WINDOW) until the gap is filled. An
+     *  interrupted transfer is kept, and resumes when the transmitter restarts it with the same
+     *  transfer ID.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PeerLinkReceiver {
+    public:
+        /**
+         * @brief Result of processing a transfer block.
+         */
+        enum Status {
+            XFER_PENDING,                           //! Transfer is in progress
+            XFER_COMPLETE,                          //! Transfer completed, takeData() is available
+            XFER_UNCHANGED,                         //! Block belongs to the last completed transfer
+            XFER_FAILED                             //! Transfer failed and was discarded
+        };
+
+        /**
+         * @brief Initializes a new instance of the PeerLinkReceiver class.
+         * @param subFunc Peer-Link subfunction (table) being received.
+         */
+        PeerLinkReceiver(uint8_t subFunc);
+        /**
+         * @brief Finalizes a instance of the PeerLinkReceiver class.
+         */
+        ~PeerLinkReceiver();
+
+        /**
+         * @brief Processes a transfer block.
+         * @param[in] data Buffer containing the block.
+         * @param length Length of buffer.
+         * @returns Status Result of processing the block.
+         */
+        Status process(const uint8_t* data, uint32_t length);
+
+        /**
+         * @brief Flag indicating an acknowledgement should be sent to the transmitter.
+         * @returns bool True, if an acknowledgement is pending, otherwise false.
+         */
+        bool hasAck() const { return m_ackPending; }
+        /**
+         * @brief Builds the pending acknowledgement.
+         * @param[out] buffer Buffer to write the acknowledgement to (PEER_LINK_XFER_ACK_LENGTH bytes).
+         * @returns uint32_t Length of the acknowledgement.
+         */
+        uint32_t encodeAck(uint8_t* buffer);
+
+        /**
+         * @brief Takes the uncompressed data of the completed transfer.
+         * @returns std::vector<uint8_t> Uncompressed data.
+         */
+        std::vector<uint8_t> takeData();
+
+    public:
+        /**
+         * @brief Peer-Link subfunction (table) being received.
+         */
+        __READONLY_PROPERTY_PLAIN(uint8_t, subFunc);
+        /**
+         * @brief Transfer ID of the current (or last completed) transfer.
+         */
+        __READONLY_PROPERTY_PLAIN(uint32_t, transferId);
+        /**
+         * @brief Number of blocks in the current transfer.
+         */
+        __READONLY_PROPERTY_PLAIN(uint16_t, blockCount);
+
+    private:
+        uint32_t m_length;
+        uint32_t m_compressedLength;
+        uint16_t m_next;
+        std::map<uint16_t, std::vector<uint8_t>> m_pending;
+
+        z_stream m_strm;
+        bool m_inflating;
+        bool m_streamEnd;
+        std::vector<uint8_t> m_data;
+
+        bool m_complete;
+        bool m_ackPending;
+        bool m_ackError;
+
+        /**
+         * @brief Helper to begin a new transfer.
+         * @param transferId Transfer ID.
+         * @param length Length of the uncompressed data.
+         * @param compressedLength Length of the compressed data.
+         * @param blockCount Number of blocks in the transfer.
+         * @returns bool True, if the transfer was started, otherwise false.
+         */
+        bool begin(uint32_t transferId, uint32_t length, uint32_t compressedLength, uint16_t blockCount);
+        /**
+         * @brief Helper to discard the current transfer.
+         */
+        void reset();
+        /**
+         * @brief Helper to inflate the payload of the next in-order block.
+         * @param[in] data Block payload.
+         * @param length Length of block payload.
+         * @returns bool True, if the payload was inflated, otherwise false.
+         */
+        bool inflateBlock(const uint8_t* data, uint32_t length);
+    };
+} // namespace network
+
+#endif // __PEER_LINK_TRANSFER_H__
@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PeerRegistry.h
+ * @ingroup network_core
+ */
+#if !defined(__PEER_REGISTRY_H__)
+#define __PEER_REGISTRY_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t PEER_REGISTRY_SHARDS = 16U;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a peer connection registry.
+     *
+     *  Peers are spread across PEER_REGISTRY_SHARDS independently locked shards, so lookups are a
+     *  single hash lookup under a lock shared only with a fraction of the peers. The registry owns
+     *  the connections; a connection that is erased (or replaced) is not deleted immediately but
+     *  retired, and only reclaimed once every thread that could still be holding a pointer to it
+     *  has left its read-side section (epoch based reclamation).
+     *
+     *  Any thread other than the one calling reclaim() must hold a ReadGuard (or a Snapshot) while
+     *  using connection pointers obtained from the registry.
+     * @tparam T Peer connection type.
+     * @ingroup network_core
+     */
+    template<class T>
+    class HOST_SW_API PeerRegistry {
+    public:
+        typedef std::pair<uint32_t, T*> PeerMapPair;
+
+        /**
+         * @brief Read-side section, connections seen while a guard is held are not reclaimed.
+         * @ingroup network_core
+         */
+        class HOST_SW_API ReadGuard {
+        public:
+            /**
+             * @brief Initializes a new instance of the ReadGuard class.
+             * @param registry Peer registry.
+             */
+            explicit ReadGuard(const PeerRegistry& registry) :
+                m_registry(&registry),
+                m_slot(0U)
+            {
+                // register against the current epoch; if the epoch moved on while registering, the
+                // reclaimer may not have seen us, so register again against the new epoch
+                while (true) {
+                    uint64_t epoch = m_registry->m_epoch.load();
+                    m_slot = (uint32_t)(epoch & 1U);
+                    m_registry->m_readers[m_slot].fetch_add(1U);
+                    if (m_registry->m_epoch.load() == epoch)
+                        break;
+
+                    m_registry->m_readers[m_slot].fetch_sub(1U);
+                }
+            }
+            /**
+             * @brief Initializes a new instance of the ReadGuard class.
+             * @param guard Guard to take over.
+             */
+            ReadGuard(ReadGuard&& guard) :
+                m_registry(guard.m_registry),
+                m_slot(guard.m_slot)
+            {
+                guard.m_registry = nullptr;
+            }
+            /**
+             * @brief Finalizes a instance of the ReadGuard class.
+             */
+            ~ReadGuard()
+            {
+                if (m_registry != nullptr)
+                    m_registry->m_readers[m_slot].fetch_sub(1U);
+            }
+
+        private:
+            const PeerRegistry* m_registry;
+            uint32_t m_slot;
+
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+        };
+
+        /**
+         * @brief Point-in-time copy of the registered peers, used to fan out to every peer.
+         *
+         *  The snapshot holds a read-side section for as long as it exists.
+         * @ingroup network_core
+         */
+        class HOST_SW_API Snapshot {
+        public:
+            /**
+             * @brief Initializes a new instance of the Snapshot class.
+             * @param registry Peer registry.
+             */
+            explicit Snapshot(const PeerRegistry& registry) :
+                m_guard(registry),
+                m_peers()
+            {
+                m_peers.reserve(registry.size());
+                for (const Shard& shard : registry.m_shards) {
+                    std::lock_guard<std::mutex> lock(shard.lock);
+                    m_peers.insert(m_peers.end(), shard.peers.begin(), shard.peers.end());
+                }
+            }
+            /**
+             * @brief Initializes a new instance of the Snapshot class.
+             * @param snapshot Snapshot to take over.
+             */
+            Snapshot(Snapshot&& snapshot) = default;
+
+            /**
+             * @brief Returns an iterator to the first peer.
+             */
+            typename std::vector<PeerMapPair>::const_iterator begin() const { return m_peers.begin(); }
+            /**
+             * @brief Returns an iterator past the last peer.
+             */
+            typename std::vector<PeerMapPair>::const_iterator end() const { return m_peers.end(); }
+            /**
+             * @brief Returns the number of peers.
+             */
+            size_t size() const { return m_peers.size(); }
+
+        private:
+            ReadGuard m_guard;
+            std::vector<PeerMapPair> m_peers;
+        };
+
+        /**
+         * @brief Initializes a new instance of the PeerRegistry class.
+         */
+        PeerRegistry() :
+            m_shards(),
+            m_count(0U),
+            m_epoch(0U),
+            m_retireLock(),
+            m_retired()
+        {
+            m_readers[0U].store(0U);
+            m_readers[1U].store(0U);
+        }
+        /**
+         * @brief Finalizes a instance of the PeerRegistry class.
+         */
+        ~PeerRegistry()
+        {
+            for (Shard& shard : m_shards) {
+                for (auto& entry : shard.peers) {
+                    if (entry.second != nullptr)
+                        delete entry.second;
+                }
+                shard.peers.clear();
+            }
+
+            for (auto& entry : m_retired) {
+                delete entry.second;
+            }
+            m_retired.clear();
+        }
+
+        /**
+         * @brief Finds the connection for the given peer.
+         * @param peerId Peer ID.
+         * @returns T* Peer connection, or nullptr if the peer is not registered.
+         */
+        T* find(uint32_t peerId) const
+        {
+            const Shard& s = shard(peerId);
+            std::lock_guard<std::mutex> lock(s.lock);
+            auto it = s.peers.find(peerId);
+            if (it != s.peers.end())
+                return it->second;
+
+            return nullptr;
+        }
+        /**
+         * @brief Flag indicating whether the given peer is registered.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer is registered, otherwise false.
+         */
+        bool contains(uint32_t peerId) const { return find(peerId) != nullptr; }
+        /**
+         * @brief Registers the connection for the given peer, retiring any other connection it replaces.
+         * @param peerId Peer ID.
+         * @param connection Peer connection (the registry takes ownership).
+         */
+        void insert(uint32_t peerId, T* connection)
+        {
+            T* replaced = nullptr;
+            {
+                Shard& s = shard(peerId);
+                std::lock_guard<std::mutex> lock(s.lock);
+                auto it = s.peers.find(peerId);
+                if (it != s.peers.end()) {
+                    replaced = it->second;
+                    it->second = connection;
+                }
+                else {
+                    s.peers[peerId] = connection;
+                    m_count.fetch_add(1U);
+                }
+            }
+
+            if (replaced != nullptr && replaced != connection)
+                retire(replaced);
+        }
+        /**
+         * @brief Removes the given peer, retiring its connection.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer was registered, otherwise false.
+         */
+        bool erase(uint32_t peerId)
+        {
+            T* connection = nullptr;
+            {
+                Shard& s = shard(peerId);
+                std::lock_guard<std::mutex> lock(s.lock);
+                auto it = s.peers.find(peerId);
+                if (it == s.peers.end())
+                    return false;
+
+                connection = it->second;
+                s.peers.erase(it);
+                m_count.fetch_sub(1U);
+            }
+
+            if (connection != nullptr)
+                retire(connection);
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of registered peers.
+         */
+        size_t size() const { return m_count.load(); }
+        /**
+         * @brief Returns the number of retired connections waiting to be reclaimed.
+         */
+        size_t retired() const
+        {
+            std::lock_guard<std::mutex> lock(m_retireLock);
+            return m_retired.size();
+        }
+        /**
+         * @brief Creates a snapshot of the registered peers.
+         * @returns Snapshot Registered peers.
+         */
+        Snapshot snapshot() const { return Snapshot(*this); }
+
+        /**
+         * @brief Deletes retired connections no longer visible to any read-side section.
+         */
+        void reclaim()
+        {
+            std::lock_guard<std::mutex> lock(m_retireLock);
+            if (m_retired.empty())
+                return;
+
+            // a connection retired during epoch N can only be seen by readers registered against epoch N
+            // (or earlier); the epoch only advances once the readers of the previous epoch have left, so
+            // by the time it reaches N + 2 there are no readers left that could hold the connection
+            for (uint32_t i = 0U; i < 2U; i++) {
+                uint64_t epoch = m_epoch.load();
+                if (m_readers[(epoch + 1U) & 1U].load() != 0U)
+                    break;
+
+                m_epoch.store(epoch + 1U);
+            }
+
+            uint64_t epoch = m_epoch.load();
+            auto it = m_retired.begin();
+            while (it != m_retired.end()) {
+                if (it->first + 2U <= epoch) {
+                    delete it->second;
+                    it = m_retired.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+    private:
+        struct Shard {
+            mutable std::mutex lock;
+            std::unordered_map<uint32_t, T*> peers;
+        };
+        Shard m_shards[PEER_REGISTRY_SHARDS];
+        std::atomic<uint32_t> m_count;
+
+        mutable std::atomic<uint64_t> m_epoch;
+        mutable std::atomic<uint32_t> m_readers[2U];
+
+        mutable std::mutex m_retireLock;
+        std::vector<std::pair<uint64_t, T*>> m_retired;
+
+        /**
+         * @brief Helper to get the shard for the given peer.
+         * @param peerId Peer ID.
+         * @returns Shard& Shard.
+         */
+        Shard& shard(uint32_t peerId) { return m_shards[peerId % PEER_REGISTRY_SHARDS]; }
+        const Shard& shard(uint32_t peerId) const { return m_shards[peerId % PEER_REGISTRY_SHARDS]; }
+        /**
+         * @brief Helper to retire a connection.
+         * @param connection Peer connection.
+         */
+        void retire(T* connection)
+        {
+            std::lock_guard<std::mutex> lock(m_retireLock);
+            for (auto& entry : m_retired) {
+                if (entry.second == connection)
+                    return;
+            }
+
+            m_retired.push_back(std::make_pair(m_epoch.load(), connection));
+        }
+    };
+} // namespace network
+
+#endif // __PEER_REGISTRY_H__
@@ -27,7 +27,7 @@
 //  Constants
 // ---------------------------------------------------------------------------
 
-#define PEER_LINK_BLOCK_SIZE 534
+#define PEER_LINK_BLOCK_SIZE 524                // + 20 byte transfer header = 544 byte payload
 
 #define RTP_FNE_HEADER_LENGTH_BYTES 16
 #define RTP_FNE_HEADER_LENGTH_EXT_LEN 4
@@ -108,6 +108,7 @@ namespace network
             PL_PEER_LIST = 0x02U,                   //! FNE Peer-Link Peer List Transfer
 
             PL_ACT_PEER_LIST = 0xA2U,               //! FNE Peer-Link Active Peer List Transfer
+            PL_XFER_ACK = 0xA3U,                    //! FNE Peer-Link Transfer Acknowledgement
         };
     };
 
@@ -82,7 +82,7 @@ bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_stor
     assert(message != nullptr);
     assert(length > 0U);
 
-    uint8_t* buffer = new uint8_t[length];
+    uint8_t* buffer = SlabAllocator::allocateBuffer(length);
     ::memset(buffer, 0x00U, length);
     ::memcpy(buffer, message, length);
 
@@ -95,6 +95,7 @@ bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_stor
         ret = false;
     }
 
+    SlabAllocator::deallocate(buffer);
     return ret;
 }
 
@@ -105,7 +106,7 @@ void RawFrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, sock
     assert(message != nullptr);
     assert(length > 0U);
 
-    uint8_t* buffer = new uint8_t[length];
+    uint8_t* buffer = SlabAllocator::allocateBuffer(length);
     ::memset(buffer, 0x00U, length);
     ::memcpy(buffer, message, length);
 
@@ -162,7 +163,7 @@ void RawFrameQueue::deleteBuffers()
         if (buffer != nullptr) {
             // LogDebug(LOG_NET, "deleting buffer, addr %p len %u", buffer->buffer, buffer->length);
             if (buffer->buffer != nullptr) {
-                delete[] buffer->buffer;
+                SlabAllocator::deallocate(buffer->buffer);
                 buffer->length = 0;
                 buffer->buffer = nullptr;
             }
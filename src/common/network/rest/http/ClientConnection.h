@@ -52,13 +52,20 @@ namespace network
                  * @brief Initializes a new instance of the ClientConnection class.
                  * @param socket TCP socket for this connection.
                  * @param handler Request handler for this connection.
+                 * @param persistent Flag indicating whether or not the connection is kept open for further requests.
                  */
-                explicit ClientConnection(asio::ip::tcp::socket socket, RequestHandlerType& handler) :
+                explicit ClientConnection(asio::ip::tcp::socket socket, RequestHandlerType& handler,
+                    bool persistent = false) :
                     m_socket(std::move(socket)),
                     m_requestHandler(handler),
-                    m_lexer(HTTPLexer(true))
+                    m_lexer(HTTPLexer(true)),
+                    m_persistent(persistent)
                 {
-                    /* stub */
+                    // requests on a persistent connection must not wait on the delayed ACK of the previous request
+                    if (m_persistent) {
+                        asio::error_code ignored_ec;
+                        m_socket.set_option(asio::ip::tcp::no_delay(true), ignored_ec);
+                    }
                 }
 
                 /**
@@ -72,14 +79,20 @@ namespace network
                 {
                     try
                     {
-                        ensureNoLinger();
                         if (m_socket.is_open()) {
+                            ensureNoLinger();
                             m_socket.close();
                         }
                     }
                     catch(const std::exception&) { /* ignore */ }
                 }
 
+                /**
+                 * @brief Helper to determine whether the connection is open.
+                 * @returns bool True, if the connection is open, otherwise false.
+                 */
+                bool isOpen() { return m_socket.is_open(); }
+
                 /**
                  * @brief Helper to enable the SO_LINGER socket option during shutdown.
                  */
@@ -170,6 +183,13 @@ namespace network
                                     if (result == HTTPLexer::GOOD) {
                                         m_sizeToTransfer = m_bytesTransferred = 0U;
                                         m_requestHandler.handleRequest(m_request, m_reply);
+
+                                        // persistent connections wait for the response to the next request
+                                        if (m_persistent) {
+                                            m_lexer.reset();
+                                            m_request = HTTPPayload();
+                                            read();
+                                        }
                                     }
                                     else if (result == HTTPLexer::BAD) {
                                         m_sizeToTransfer = m_bytesTransferred = 0U;
@@ -183,7 +203,8 @@ namespace network
                             catch(const std::exception& e) { ::LogError(LOG_REST, "ClientConnection::read(), %s", ec.message().c_str()); }
                         }
                         else if (ec != asio::error::operation_aborted) {
-                            if (ec) {
+                            // the server closing an idle persistent connection is not an error
+                            if (ec && !(m_persistent && ec == asio::error::eof)) {
                                 ::LogError(LOG_REST, "ClientConnection::read(), %s, code = %u", ec.message().c_str(), ec.value());
                             }
                             stop();
@@ -234,6 +255,8 @@ namespace network
                 HTTPPayload m_request;
                 HTTPLexer m_lexer;
                 HTTPPayload m_reply;
+
+                bool m_persistent;
             };
         } // namespace http
     } // namespace rest
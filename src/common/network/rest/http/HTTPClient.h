@@ -56,10 +56,12 @@ namespace network
                  * @brief Initializes a new instance of the HTTPClient class.
                  * @param address Hostname/IP Address.
                  * @param port Port.
+                 * @param persistent Flag indicating whether or not the connection is kept open for further requests.
                  */
-                HTTPClient(const std::string& address, uint16_t port) :
+                HTTPClient(const std::string& address, uint16_t port, bool persistent = false) :
                     m_address(address),
                     m_port(port),
+                    m_persistent(persistent),
                     m_connection(nullptr),
                     m_ioContext(),
                     m_socket(m_ioContext),
@@ -111,6 +113,16 @@ namespace network
                     return true;
                 }
 
+                /**
+                 * @brief Helper to determine whether the connection to the HTTP server is established.
+                 * @returns bool True, if the connection is established, otherwise false.
+                 */
+                bool isOpen()
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    return !m_completed && m_connection != nullptr && m_connection->isOpen();
+                }
+
                 /**
                  * @brief Opens connection to the network.
                  */
@@ -173,12 +185,16 @@ namespace network
                 {
                     asio::connect(m_socket, endpoints);
 
-                    m_connection = std::make_unique<ConnectionType>(std::move(m_socket), m_requestHandler);
-                    m_connection->start();
+                    std::unique_ptr<ConnectionType> connection = std::make_unique<ConnectionType>(std::move(m_socket), m_requestHandler, m_persistent);
+                    connection->start();
+
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_connection = std::move(connection);
                 }
 
                 std::string m_address;
                 uint16_t m_port;
+                bool m_persistent;
 
                 typedef ConnectionImpl<RequestHandlerType> ConnectionType;
 
@@ -21,6 +21,7 @@
 #include "common/network/rest/http/HTTPLexer.h"
 #include "common/network/rest/http/HTTPPayload.h"
 #include "common/Log.h"
+#include "common/Utils.h"
 
 #include <array>
 #include <memory>
@@ -108,11 +109,10 @@ namespace network
                  */
                 void handshake()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    }
+                    // the pending operation keeps the connection alive until its handler has run
+                    auto self(this->shared_from_this());
 
-                    m_socket.async_handshake(asio::ssl::stream_base::server, [this](asio::error_code ec) {
+                    m_socket.async_handshake(asio::ssl::stream_base::server, [this, self](asio::error_code ec) {
                         if (!ec) {
                             read();
                         }
@@ -124,11 +124,10 @@ namespace network
                  */
                 void read()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    }
+                    // the pending operation keeps the connection alive until its handler has run
+                    auto self(this->shared_from_this());
 
-                    m_socket.async_read_some(asio::buffer(m_buffer), [=](asio::error_code ec, std::size_t recvLength) {
+                    m_socket.async_read_some(asio::buffer(m_buffer), [this, self](asio::error_code ec, std::size_t recvLength) {
                         if (!ec) {
                             HTTPLexer::ResultType result = HTTPLexer::GOOD;
                             char* content;
@@ -210,10 +209,12 @@ namespace network
                             }
                         }
                         else if (ec != asio::error::operation_aborted) {
-                            if (ec) {
+                            // a client closing a kept alive connection between requests (or the server closing
+                            // it during shutdown) is not an error
+                            if (ec && ec != asio::error::eof && ec != asio::error::connection_reset && ec != asio::error::bad_descriptor) {
                                 ::LogError(LOG_REST, "SecureServerConnection::read(), %s, code = %u", ec.message().c_str(), ec.value());
                             }
-                            m_connectionManager.stop(this->shared_from_this());
+                            m_connectionManager.stop(self);
                             m_continue = false;
                         }
                     });
@@ -224,15 +225,20 @@ namespace network
                  */
                 void write()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    } else {
+                    // a non-persistent connection is kept open for the next request if the client asked for it
+                    bool keepAlive = m_persistent || (::strtolower(m_request.headers.find("Connection")) == "keep-alive");
+                    auto self(this->shared_from_this());
+                    if (keepAlive) {
                         m_reply.headers.add("Connection", "keep-alive");
+
+                        // replies on a kept alive connection must not wait on the delayed ACK of the previous reply
+                        asio::error_code ignored_ec;
+                        m_socket.lowest_layer().set_option(asio::ip::tcp::no_delay(true), ignored_ec);
                     }
 
                     auto buffers = m_reply.toBuffers();
-                    asio::async_write(m_socket, buffers, [=](asio::error_code ec, std::size_t) {
-                        if (m_persistent) {
+                    asio::async_write(m_socket, buffers, [this, self, keepAlive](asio::error_code ec, std::size_t) {
+                        if (keepAlive) {
                             m_lexer.reset();
                             m_reply.headers = HTTPHeaders();
                             m_reply.status = HTTPPayload::OK;
@@ -255,7 +261,7 @@ namespace network
                                 if (ec) {
                                     ::LogError(LOG_REST, "SecureServerConnection::write(), %s, code = %u", ec.message().c_str(), ec.value());
                                 }
-                                m_connectionManager.stop(this->shared_from_this());
+                                m_connectionManager.stop(self);
                             }
                         }
                     });
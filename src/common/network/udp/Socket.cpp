@@ -449,7 +449,7 @@ bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
 
     int sent = 0;
     struct mmsghdr headers[MAX_BUFFER_COUNT];
-    struct iovec chunks[MAX_BUFFER_COUNT];
+    struct iovec chunks[MAX_BUFFER_COUNT][2U];
 
     // create mmsghdrs from input buffers and send them at once
     int size = buffers.size();
@@ -468,23 +468,29 @@ bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
 
         // are we crypto wrapped?
         if (m_isCryptoWrapped && m_presharedKey != nullptr) {
-            uint32_t cryptedLen = length * sizeof(uint8_t);
+            uint32_t payloadLen = buffers[i]->payload.length();
+            uint32_t cryptedLen = (length + payloadLen) * sizeof(uint8_t);
             uint8_t* cryptoBuffer = buffers[i]->buffer;
 
-            // do we need to pad the original buffer to be block aligned?
-            if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
-                uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
-                cryptedLen += alignment;
+            // do we need to pad the original buffer to be block aligned (or flatten a shared payload)?
+            if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0 || payloadLen > 0U) {
+                if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
+                    uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
+                    cryptedLen += alignment;
+                }
 
                 // reallocate buffer and copy
                 cryptoBuffer = new uint8_t[cryptedLen];
                 ::memset(cryptoBuffer, 0x00U, cryptedLen);
                 ::memcpy(cryptoBuffer, buffers.at(i)->buffer, length);
+                if (payloadLen > 0U)
+                    ::memcpy(cryptoBuffer + length, buffers.at(i)->payload.data(), payloadLen);
             }
 
             // encrypt
             uint8_t* crypted = m_aes->encryptECB(cryptoBuffer, cryptedLen, m_presharedKey);
-            delete[] cryptoBuffer;
+            if (cryptoBuffer != buffers[i]->buffer)
+                delete[] cryptoBuffer;
 
             if (crypted == nullptr) {
                 --size;
@@ -501,7 +507,6 @@ bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
 
             // cleanup buffers and replace with new
             delete[] crypted;
-            //delete buffers[i]->buffer;
 
             // this should never happen...
             if (buffers[i] == nullptr) {
@@ -509,19 +514,30 @@ bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
                 continue;
             }
 
-            buffers[i]->buffer = new uint8_t[cryptedLen + 2U];
+            SlabAllocator::deallocate(buffers[i]->buffer);
+            buffers[i]->buffer = SlabAllocator::allocateBuffer(cryptedLen + 2U);
             ::memcpy(buffers[i]->buffer, out, cryptedLen + 2U);
             buffers[i]->length = cryptedLen + 2U;
+            buffers[i]->payload = PacketBuffer();
         }
 
-        chunks[i].iov_len = buffers.at(i)->length;
-        chunks[i].iov_base = buffers.at(i)->buffer;
+        // the datagram is sent as the header buffer followed by the (possibly shared) payload
+        size_t iovLen = 1U;
+        chunks[i][0U].iov_len = buffers.at(i)->length;
+        chunks[i][0U].iov_base = buffers.at(i)->buffer;
         sent += buffers.at(i)->length;
 
+        if (buffers.at(i)->payload) {
+            chunks[i][1U].iov_len = buffers.at(i)->payload.length();
+            chunks[i][1U].iov_base = buffers.at(i)->payload.data();
+            sent += buffers.at(i)->payload.length();
+            iovLen = 2U;
+        }
+
         headers[i].msg_hdr.msg_name = (void*)&buffers.at(i)->address;
         headers[i].msg_hdr.msg_namelen = buffers.at(i)->addrLen;
-        headers[i].msg_hdr.msg_iov = &chunks[i];
-        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_iov = chunks[i];
+        headers[i].msg_hdr.msg_iovlen = iovLen;
         headers[i].msg_hdr.msg_control = 0;
         headers[i].msg_hdr.msg_controllen = 0;
     }
@@ -586,6 +602,51 @@ void Socket::setPresharedKey(const uint8_t* presharedKey)
     }
 }
 
+/* Helper to wait until any of the given UDP sockets has data to read. */
+
+int Socket::wait(const std::vector<Socket*>& sockets, uint32_t timeoutMs)
+{
+    // the poll set is kept per thread, so waiting doesn't allocate every call
+    static thread_local std::vector<struct pollfd> pfds;
+    pfds.clear();
+    for (Socket* socket : sockets) {
+        if (socket == nullptr)
+            continue;
+#if defined(_WIN32)
+        if (socket->m_fd == INVALID_SOCKET)
+            continue;
+#else
+        if (socket->m_fd < 0)
+            continue;
+#endif // defined(_WIN32)
+
+        struct pollfd pfd;
+        pfd.fd = socket->m_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        pfds.push_back(pfd);
+    }
+
+    if (pfds.empty())
+        return -1;
+
+#if defined(_WIN32)
+    int ret = WSAPoll(pfds.data(), (ULONG)pfds.size(), (INT)timeoutMs);
+#else
+    int ret = ::poll(pfds.data(), pfds.size(), (int)timeoutMs);
+#endif // defined(_WIN32)
+    if (ret < 0) {
+#if !defined(_WIN32)
+        // a signal interrupting the wait isn't an error
+        if (errno == EINTR)
+            return 0;
+#endif // !defined(_WIN32)
+        return -1;
+    }
+
+    return ret;
+}
+
 /* Helper to lookup a hostname and resolve it to an IP address. */
 
 int Socket::lookup(const std::string& hostname, uint16_t port, sockaddr_storage& address, uint32_t& addrLen)
@@ -23,6 +23,8 @@
 
 #include "common/Defines.h"
 #include "common/AESCrypto.h"
+#include "common/SlabAllocator.h"
+#include "common/network/PacketBuffer.h"
 
 #include <string>
 #include <vector>
@@ -160,11 +162,14 @@ namespace network
          * @ingroup udp_socket
          */
         struct UDPDatagram {
-            uint8_t* buffer;            //! Message Buffer
+            uint8_t* buffer;            //! Message Buffer (allocated from the SlabAllocator)
             size_t length;              //! Length of Message Buffer
+            PacketBuffer payload;       //! Shared Payload (sent after the message buffer)
 
             sockaddr_storage address;   //! Address and Port
             uint32_t addrLen;           //! Length of address structure
+
+            __SLAB_ALLOCATED
         };
 
         /** @brief Vector of buffers that contain a full frames */
@@ -260,6 +265,14 @@ namespace network
              */
             void setPresharedKey(const uint8_t* presharedKey);
 
+            /**
+             * @brief Helper to wait until any of the given UDP sockets has data to read.
+             * @param sockets Sockets to wait on (closed or null sockets are ignored).
+             * @param timeoutMs Maximum amount of time (ms) to wait.
+             * @returns int Number of sockets with data to read, zero on timeout, or -1 if no socket could be waited on.
+             */
+            static int wait(const std::vector<Socket*>& sockets, uint32_t timeoutMs);
+
             /**
              * @brief Helper to lookup a hostname and resolve it to an IP address.
              * @param hostname String containing hostname to resolve.
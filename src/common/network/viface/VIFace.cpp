@@ -468,14 +468,13 @@ bool VIFace::isUp() const
 
 /* Read a packet from the virtual interface. */
 
-ssize_t VIFace::read(uint8_t* buffer)
+ssize_t VIFace::read(uint8_t* buffer, int timeout)
 {
     assert(buffer != nullptr);
-    ::memset(buffer, 0x00U, m_mtu);
 
     struct epoll_event wait_event;
 
-    int ret = epoll_wait(m_epollFd, &wait_event, 1, 0);
+    int ret = epoll_wait(m_epollFd, &wait_event, 1, timeout);
     if ((ret < 0) && (errno != EINTR)) {
         LogError(LOG_NET, "Error returned from epoll_wait, err: %d, error: %s", errno, strerror(errno));
         return -1;
@@ -489,7 +488,7 @@ ssize_t VIFace::read(uint8_t* buffer)
     if (ret > 0) {
         // Read packet into our buffer
         ssize_t len = ::read(wait_event.data.fd, buffer, m_mtu);
-        if (len == -1) {
+        if (len == -1 && errno != EAGAIN && errno != EWOULDBLOCK) {
             LogError(LOG_NET, "Error returned from read, err: %d, error: %s", errno, strerror(errno));
         }
     
@@ -103,9 +103,11 @@ namespace network
              *
              * @param[out] buffer The packet (if tun) or frame (if tap) as a binary blob
              *  (array of bytes).
+             * @param timeout Time in milliseconds to wait for a packet to become available (0 does not block,
+             *  -1 blocks indefinitely).
              * @returns ssize_t Actual length of data read from remote UDP socket.
              */
-            ssize_t read(uint8_t* buffer);
+            ssize_t read(uint8_t* buffer, int timeout = 0);
             /**
              * @brief Write a packet to this virtual interface.
              *
@@ -17,6 +17,7 @@
 #define  __NXDN_LC__RCCH_H__
 
 #include "common/Defines.h"
+#include "common/SlabAllocator.h"
 #include "common/nxdn/SiteData.h"
 #include "common/lookups/IdenTableLookup.h"
 
@@ -48,6 +49,8 @@ namespace nxdn
              */
             virtual ~RCCH();
 
+            __SLAB_ALLOCATED
+
             /**
              * @brief Decode RCCH data.
              * @param[in] data Buffer containing a RCCH to decode.
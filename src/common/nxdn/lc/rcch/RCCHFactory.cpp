@@ -34,6 +34,37 @@ RCCHFactory::~RCCHFactory() = default;
 /* Create an instance of a RCCH. */
 
 std::unique_ptr<RCCH> RCCHFactory::createRCCH(const uint8_t* data, uint32_t length, uint32_t offset)
+{
+    return std::unique_ptr<RCCH>(create(data, length, offset, nullptr));
+}
+
+/* Decode a RCCH in place, without allocating. */
+
+RCCH* RCCHFactory::decodeRCCH(const uint8_t* data, uint32_t length, RCCHStorage& storage, uint32_t offset)
+{
+    storage.reset();
+    return create(data, length, offset, &storage);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Internal helper to decode a RCCH link control message. */
+
+template<class T>
+RCCH* RCCHFactory::decode(RCCHStorage* storage, const uint8_t* data, uint32_t length, uint32_t offset)
+{
+    assert(data != nullptr);
+
+    RCCH* rcch = (storage != nullptr) ? storage->emplace<T>() : new T();
+    rcch->decode(data, length, offset);
+    return rcch;
+}
+
+/* Create and decode a RCCH, either in the given storage or (if none) on the heap. */
+
+RCCH* RCCHFactory::create(const uint8_t* data, uint32_t length, uint32_t offset, RCCHStorage* storage)
 {
     assert(data != nullptr);
 
@@ -43,17 +74,17 @@ std::unique_ptr<RCCH> RCCHFactory::createRCCH(const uint8_t* data, uint32_t leng
     switch (messageType) {
     case MessageType::RTCH_VCALL:
     case MessageType::RCCH_VCALL_CONN:
-        return decode(new MESSAGE_TYPE_VCALL_CONN(), data, length, offset);
+        return decode<MESSAGE_TYPE_VCALL_CONN>(storage, data, length, offset);
     case MessageType::RTCH_DCALL_HDR:
-        return decode(new MESSAGE_TYPE_DCALL_HDR(), data, length, offset);
+        return decode<MESSAGE_TYPE_DCALL_HDR>(storage, data, length, offset);
     case MessageType::IDLE:
-        return decode(new MESSAGE_TYPE_IDLE(), data, length, offset);
+        return decode<MESSAGE_TYPE_IDLE>(storage, data, length, offset);
     case MessageType::RCCH_REG:
-        return decode(new MESSAGE_TYPE_REG(), data, length, offset);
+        return decode<MESSAGE_TYPE_REG>(storage, data, length, offset);
     case MessageType::RCCH_REG_C:
-        return decode(new MESSAGE_TYPE_REG_C(), data, length, offset);
+        return decode<MESSAGE_TYPE_REG_C>(storage, data, length, offset);
     case MessageType::RCCH_GRP_REG:
-        return decode(new MESSAGE_TYPE_GRP_REG(), data, length, offset);
+        return decode<MESSAGE_TYPE_GRP_REG>(storage, data, length, offset);
     default:
         LogError(LOG_NXDN, "RCCH::decodeRCCH(), unknown RCCH value, messageType = $%02X", messageType);
         return nullptr;
@@ -61,18 +92,3 @@ std::unique_ptr<RCCH> RCCHFactory::createRCCH(const uint8_t* data, uint32_t leng
 
     return nullptr;
 }
-
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* Internal helper to decode a RCCH link control message. */
-
-std::unique_ptr<RCCH> RCCHFactory::decode(RCCH* rcch, const uint8_t* data, uint32_t length, uint32_t offset)
-{
-    assert(rcch != nullptr);
-    assert(data != nullptr);
-
-    rcch->decode(data, length, offset);
-    return std::unique_ptr<RCCH>(rcch);
-}
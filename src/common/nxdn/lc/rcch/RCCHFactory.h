@@ -21,6 +21,7 @@
 #define  __NXDN_LC__RCCH_FACTORY_H__
 
 #include "common/Defines.h"
+#include "common/InlineObject.h"
 
 #include "common/nxdn/lc/RCCH.h"
 #include "common/nxdn/lc/rcch/MESSAGE_TYPE_DCALL_HDR.h"
@@ -41,6 +42,22 @@ namespace nxdn
     {
         namespace rcch
         {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            const size_t RCCH_INLINE_SIZE = 64U;    // decoded RCCHs are 56 bytes
+
+            // ---------------------------------------------------------------------------
+            //  Types
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Stack storage for a RCCH decoded in place by RCCHFactory::decodeRCCH().
+             * @ingroup nxdn_rcch
+             */
+            typedef InlineObject<RCCH, RCCH_INLINE_SIZE> RCCHStorage;
+
             // ---------------------------------------------------------------------------
             //  Class Declaration
             // ---------------------------------------------------------------------------
@@ -67,16 +84,55 @@ namespace nxdn
                  * @param offset Offset for RCCH in data buffer.
                  */
                 static std::unique_ptr<RCCH> createRCCH(const uint8_t* data, uint32_t length, uint32_t offset = 0U);
+                /**
+                 * @brief Decode a RCCH in place, without allocating.
+                 * @param[in] data Buffer containing a RCCH to decode.
+                 * @param length Length of data buffer.
+                 * @param storage Storage to decode the RCCH into.
+                 * @param offset Offset for RCCH in data buffer.
+                 * @returns RCCH* Instance of a RCCH (held by storage) representing the decoded data, or nullptr.
+                 */
+                static RCCH* decodeRCCH(const uint8_t* data, uint32_t length, RCCHStorage& storage, uint32_t offset = 0U);
+                /**
+                 * @brief Decode a RCCH in place, without allocating, and pass it to the given visitor.
+                 * @tparam Visitor Callable taking a RCCH&.
+                 * @param[in] data Buffer containing a RCCH to decode.
+                 * @param length Length of data buffer.
+                 * @param visitor Visitor called with the decoded RCCH.
+                 * @param offset Offset for RCCH in data buffer.
+                 * @returns bool True, if the RCCH was decoded and visited, otherwise false.
+                 */
+                template<typename Visitor>
+                static bool visitRCCH(const uint8_t* data, uint32_t length, Visitor&& visitor, uint32_t offset = 0U)
+                {
+                    RCCHStorage storage;
+                    RCCH* rcch = decodeRCCH(data, length, storage, offset);
+                    if (rcch == nullptr)
+                        return false;
+
+                    visitor(*rcch);
+                    return true;
+                }
 
             private:
+                /**
+                 * @brief Create and decode a RCCH.
+                 * @param[in] data Buffer containing a RCCH to decode.
+                 * @param length Length of data buffer.
+                 * @param offset Offset for RCCH in data buffer.
+                 * @param storage Storage to decode the RCCH into, or nullptr to allocate it on the heap.
+                 */
+                static RCCH* create(const uint8_t* data, uint32_t length, uint32_t offset, RCCHStorage* storage);
                 /**
                  * @brief Internal helper to decode a RCCH link control message.
-                 * @param[out] rcch
+                 * @tparam T RCCH class.
+                 * @param storage Storage to decode the RCCH into, or nullptr to allocate it on the heap.
                  * @param[in] data Buffer containing a RCCH to decode.
                  * @param length Length of data buffer.
                  * @param offset Offset for RCCH in data buffer.
                  */
-                static std::unique_ptr<RCCH> decode(RCCH* rcch, const uint8_t* data, uint32_t length, uint32_t offset = 0U);
+                template<class T>
+                static RCCH* decode(RCCHStorage* storage, const uint8_t* data, uint32_t length, uint32_t offset);
             };
         } // namespace rcch
     } // namespace lc
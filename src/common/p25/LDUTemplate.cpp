@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "p25/P25Defines.h"
+#include "p25/LDUTemplate.h"
+#include "p25/P25Utils.h"
+#include "p25/Sync.h"
+
+using namespace p25;
+using namespace p25::defines;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LDUTemplate class. */
+
+LDUTemplate::LDUTemplate(DUID::E duid) :
+    m_duid(duid),
+    m_frame(nullptr),
+    m_lc(nullptr),
+    m_valid(false)
+{
+    assert(duid == DUID::LDU1 || duid == DUID::LDU2);
+
+    m_frame = new uint8_t[P25_LDU_FRAME_LENGTH_BYTES];
+    m_lc = new uint8_t[P25_LDU_LC_FEC_LENGTH_BYTES];
+}
+
+/* Finalizes a instance of the LDUTemplate class. */
+
+LDUTemplate::~LDUTemplate()
+{
+    delete[] m_frame;
+    delete[] m_lc;
+}
+
+/* Copies the frame template for the given link control into a frame buffer. */
+
+void LDUTemplate::get(uint8_t* data, lc::LC& lc, NID& nid)
+{
+    assert(data != nullptr);
+
+    bool ldu1 = (m_duid == DUID::LDU1);
+
+    uint8_t rs[P25_LDU_LC_FEC_LENGTH_BYTES];
+    ::memset(rs, 0x00U, P25_LDU_LC_FEC_LENGTH_BYTES);
+    if (ldu1)
+        lc.encodeLDU1LC(rs);
+    else
+        lc.encodeLDU2LC(rs);
+
+    // the sync, NID and status bits are fixed for a call, only rebuild the FEC encoded link
+    // control when it has actually changed (the audio and low speed data never overlap it)
+    if (!m_valid || ::memcmp(rs, m_lc, P25_LDU_LC_FEC_LENGTH_BYTES) != 0) {
+        ::memset(m_frame, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+
+        // generate Sync
+        Sync::addP25Sync(m_frame);
+
+        // generate NID
+        nid.encode(m_frame, m_duid);
+
+        // generate LDU data
+        if (ldu1)
+            lc.encodeLDU1(m_frame);
+        else
+            lc.encodeLDU2(m_frame);
+
+        // add status bits
+        P25Utils::addStatusBits(m_frame, P25_LDU_FRAME_LENGTH_BITS, false, false);
+
+        ::memcpy(m_lc, rs, P25_LDU_LC_FEC_LENGTH_BYTES);
+        m_valid = true;
+    }
+
+    ::memcpy(data, m_frame, P25_LDU_FRAME_LENGTH_BYTES);
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LDUTemplate.h
+ * @ingroup p25
+ * @file LDUTemplate.cpp
+ * @ingroup p25
+ */
+#if !defined(__P25_LDU_TEMPLATE_H__)
+#define __P25_LDU_TEMPLATE_H__
+
+#include "common/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/NID.h"
+#include "common/p25/lc/LC.h"
+
+namespace p25
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a LDU1 or LDU2 frame template for a single call.
+     *
+     *  The template holds the sync, NID, FEC encoded link control (or encryption sync) and status
+     *  bits of a LDU, and is only rebuilt when the link control words change; leaving only the IMBE
+     *  and low speed data to be encoded for each frame.
+     * @ingroup p25
+     */
+    class HOST_SW_API LDUTemplate {
+    public:
+        /**
+         * @brief Initializes a new instance of the LDUTemplate class.
+         * @param duid DUID (LDU1 or LDU2).
+         */
+        LDUTemplate(defines::DUID::E duid);
+        /**
+         * @brief Finalizes a instance of the LDUTemplate class.
+         */
+        ~LDUTemplate();
+
+        /**
+         * @brief Copies the frame template for the given link control into a frame buffer.
+         * @param[out] data Buffer (P25_LDU_FRAME_LENGTH_BYTES) to copy the LDU frame template into.
+         * @param lc Link control.
+         * @param nid Network identifier.
+         */
+        void get(uint8_t* data, lc::LC& lc, NID& nid);
+
+        /**
+         * @brief Invalidates the frame template, forcing it to be rebuilt on the next frame.
+         */
+        void reset() { m_valid = false; }
+
+    private:
+        defines::DUID::E m_duid;
+        uint8_t* m_frame;
+        uint8_t* m_lc;
+        bool m_valid;
+    };
+} // namespace p25
+
+#endif // __P25_LDU_TEMPLATE_H__
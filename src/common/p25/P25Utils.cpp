@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
@@ -17,6 +18,36 @@ using namespace p25::defines;
 
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Mask of a run of bits within a byte, indexed by the bit offset of the run (MSB first)
+ *  and the run length.
+ */
+const uint8_t BIT_RUN_MASK[8U][9U] = {
+    { 0x00U, 0x80U, 0xC0U, 0xE0U, 0xF0U, 0xF8U, 0xFCU, 0xFEU, 0xFFU },
+    { 0x00U, 0x40U, 0x60U, 0x70U, 0x78U, 0x7CU, 0x7EU, 0x7FU, 0x00U },
+    { 0x00U, 0x20U, 0x30U, 0x38U, 0x3CU, 0x3EU, 0x3FU, 0x00U, 0x00U },
+    { 0x00U, 0x10U, 0x18U, 0x1CU, 0x1EU, 0x1FU, 0x00U, 0x00U, 0x00U },
+    { 0x00U, 0x08U, 0x0CU, 0x0EU, 0x0FU, 0x00U, 0x00U, 0x00U, 0x00U },
+    { 0x00U, 0x04U, 0x06U, 0x07U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U },
+    { 0x00U, 0x02U, 0x03U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U },
+    { 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U } };
+
+/*
+** The status symbol pairs sit at bits 70 and 71 of every 72 bit (9 byte) block, so each pair
+** is the two least significant bits of byte 8 of the block.
+*/
+const uint32_t SS_BYTE_START = P25_SS0_START / 8U;
+const uint32_t SS_BYTE_INCREMENT = P25_SS_INCREMENT / 8U;
+const uint8_t SS_MASK = 0x03U;
+
+const uint8_t SS_BUSY = 0x01U;          // 0,1
+const uint8_t SS_UNKNOWN = 0x02U;       // 1,0
+const uint8_t SS_IDLE = 0x03U;          // 1,1
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -48,11 +79,8 @@ void P25Utils::setStatusBitsAllIdle(uint8_t* data, uint32_t length)
     assert(data != nullptr);
 
     // set "1,1" (Idle) status bits [TIA-102.BAAA]
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, true);              // 1
-    }
+    for (uint32_t ss0Pos = P25_SS0_START, i = SS_BYTE_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT, i += SS_BYTE_INCREMENT)
+        data[i] |= SS_IDLE;
 }
 
 /* Helper to add the status bits on P25 frame data. */
@@ -61,32 +89,16 @@ void P25Utils::addStatusBits(uint8_t* data, uint32_t length, bool busy, bool unk
 {
     assert(data != nullptr);
 
-    // set "1,0" (Unknown) status bits [TIA-102.BAAA]
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, false);             // 0
-    }
+    // the requested status bits are interleaved (every other) with "1,0" (Unknown) status bits
+    uint8_t status = SS_IDLE;                       // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
+    if (busy)
+        status = SS_BUSY;                           // set "0,1" (Busy) status bits [TIA-102.BAAA]
+    else if (unknown)
+        status = SS_UNKNOWN;                        // set "1,0" (Unknown) status bits [TIA-102.BAAA]
 
-    // interleave the requested status bits (every other)
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * 2U)) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        if (busy) {
-            // set "0,1" (Busy) status bits [TIA-102.BAAA]
-            WRITE_BIT(data, ss0Pos, false);         // 0
-            WRITE_BIT(data, ss1Pos, true);          // 1
-        } else {
-            if (unknown) {
-                // set "1,0" (Unknown) status bits [TIA-102.BAAA]
-                WRITE_BIT(data, ss0Pos, true);      // 1
-                WRITE_BIT(data, ss1Pos, false);     // 0
-            } else {
-                // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
-                WRITE_BIT(data, ss0Pos, true);      // 1
-                WRITE_BIT(data, ss1Pos, true);      // 1
-            }
-        }
-    }
+    uint32_t n = 0U;
+    for (uint32_t ss0Pos = P25_SS0_START, i = SS_BYTE_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT, i += SS_BYTE_INCREMENT, n++)
+        data[i] = (data[i] & ~SS_MASK) | (((n & 1U) == 0U) ? status : SS_UNKNOWN);
 }
 
 /* Helper to add the unknown (1,0) status bits on P25 frame data. */
@@ -98,12 +110,9 @@ void P25Utils::addUnknownStatusBits(uint8_t* data, uint32_t length, uint8_t inte
     if (interval == 0U)
         interval = 1U;
 
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * interval)) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        // set "1,0" (Unknown) status bits [TIA-102.BAAA]
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, false);             // 0
-    }
+    // set "1,0" (Unknown) status bits [TIA-102.BAAA]
+    for (uint32_t ss0Pos = P25_SS0_START, i = SS_BYTE_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * interval), i += (SS_BYTE_INCREMENT * interval))
+        data[i] = (data[i] & ~SS_MASK) | SS_UNKNOWN;
 }
 
 /* Helper to add the idle (1,1) status bits on P25 frame data. */
@@ -115,12 +124,9 @@ void P25Utils::addIdleStatusBits(uint8_t* data, uint32_t length, uint8_t interva
     if (interval == 0U)
         interval = 1U;
 
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * interval)) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, true);              // 1
-    }
+    // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
+    for (uint32_t ss0Pos = P25_SS0_START, i = SS_BYTE_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * interval), i += (SS_BYTE_INCREMENT * interval))
+        data[i] |= SS_IDLE;
 }
 
 /* Decode bit interleaving. */
@@ -132,26 +138,19 @@ uint32_t P25Utils::decode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
 
     // Move the SSx positions to the range needed
     uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
-    while (ss0Pos < start) {
+    while (ss0Pos < start)
         ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
-    }
 
+    // copy the runs of bits between the status symbols
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, i);
-            WRITE_BIT(out, n, b);
-            n++;
-        }
+    uint32_t i = start;
+    while (i < stop) {
+        uint32_t end = (ss0Pos < stop) ? ss0Pos : stop;
+        copyBits(in, i, out, n, end - i);
+        n += end - i;
+
+        i = ss0Pos + 2U;
+        ss0Pos += P25_SS_INCREMENT;
     }
 
     return n;
@@ -166,26 +165,19 @@ uint32_t P25Utils::encode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
 
     // Move the SSx positions to the range needed
     uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
-    while (ss0Pos < start) {
+    while (ss0Pos < start)
         ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
-    }
 
+    // copy the runs of bits between the status symbols
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, i, b);
-            n++;
-        }
+    uint32_t i = start;
+    while (i < stop) {
+        uint32_t end = (ss0Pos < stop) ? ss0Pos : stop;
+        copyBits(in, n, out, i, end - i);
+        n += end - i;
+
+        i = ss0Pos + 2U;
+        ss0Pos += P25_SS_INCREMENT;
     }
 
     return n;
@@ -198,26 +190,23 @@ uint32_t P25Utils::encodeByLength(const uint8_t* in, uint8_t* out, uint32_t leng
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
+    // copy the runs of bits between the status symbols
     uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
     uint32_t n = 0U;
     uint32_t pos = 0U;
     while (n < length) {
-        if (pos == ss0Pos) {
+        uint32_t count = ss0Pos - pos;
+        if (count > length - n)
+            count = length - n;
+
+        copyBits(in, n, out, pos, count);
+        n += count;
+        pos += count;
+
+        if (n < length) {
+            pos = ss0Pos + 2U;
             ss0Pos += P25_SS_INCREMENT;
         }
-        else if (pos == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, pos, b);
-            n++;
-        }
-        pos++;
-
     }
 
     return pos;
@@ -241,3 +230,35 @@ uint32_t P25Utils::compare(const uint8_t* data1, const uint8_t* data2, uint32_t
 
     return errs;
 }
+
+// ---------------------------------------------------------------------------
+//  Private Static Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to copy a run of bits between buffers, a byte of output at a time. */
+
+void P25Utils::copyBits(const uint8_t* in, uint32_t inOffset, uint8_t* out, uint32_t outOffset, uint32_t length)
+{
+    while (length > 0U) {
+        // fill the remainder of the current output byte
+        uint32_t outShift = outOffset & 7U;
+        uint32_t count = 8U - outShift;
+        if (count > length)
+            count = length;
+
+        // read the next count bits of input, reading the following byte only if they straddle it
+        uint32_t inShift = inOffset & 7U;
+        uint32_t word = in[inOffset >> 3] << 8;
+        if (inShift + count > 8U)
+            word |= in[(inOffset >> 3) + 1U];
+        uint8_t bits = (uint8_t)((word << inShift) >> (8U + outShift));
+
+        uint8_t mask = BIT_RUN_MASK[outShift][count];
+        uint8_t& b = out[outOffset >> 3];
+        b = (b & ~mask) | (bits & mask);
+
+        inOffset += count;
+        outOffset += count;
+        length -= count;
+    }
+}
@@ -198,6 +198,17 @@ namespace p25
          * @returns uint32_t 
          */
         static uint32_t compare(const uint8_t* data1, const uint8_t* data2, uint32_t length);
+
+    private:
+        /**
+         * @brief Helper to copy a run of bits between buffers, a byte of output at a time.
+         * @param in Input buffer.
+         * @param inOffset Input bit offset.
+         * @param out Output buffer.
+         * @param outOffset Output bit offset.
+         * @param length Number of bits to copy.
+         */
+        static void copyBits(const uint8_t* in, uint32_t inOffset, uint8_t* out, uint32_t outOffset, uint32_t length);
     };
 } // namespace p25
 
@@ -398,12 +398,7 @@ void LC::encodeLDU2(uint8_t* data)
     uint8_t rs[P25_LDU_LC_FEC_LENGTH_BYTES];
     ::memset(rs, 0x00U, P25_LDU_LC_FEC_LENGTH_BYTES);
 
-    for (uint32_t i = 0; i < MI_LENGTH_BYTES; i++)
-        rs[i] = m_mi[i];                                                            // Message Indicator
-
-    rs[9U] = m_algId;                                                               // Algorithm ID
-    rs[10U] = (m_kId >> 8) & 0xFFU;                                                 // Key ID
-    rs[11U] = (m_kId >> 0) & 0xFFU;                                                 // ...
+    encodeLDU2LC(rs);
 
 #if DEBUG_P25_LDU2
     Utils::dump(2U, "LC::encodeLDU2(), LDU2 LC", rs, P25_LDU_LC_LENGTH_BYTES);
@@ -441,6 +436,30 @@ void LC::encodeLDU2(uint8_t* data)
 #endif
 }
 
+/* Encode the link control words carried by a logical link data unit 1, before FEC. */
+
+void LC::encodeLDU1LC(uint8_t* rs)
+{
+    assert(rs != nullptr);
+
+    encodeLC(rs);
+}
+
+/* Encode the encryption sync words carried by a logical link data unit 2, before FEC. */
+
+void LC::encodeLDU2LC(uint8_t* rs) const
+{
+    assert(rs != nullptr);
+    assert(m_mi != nullptr);
+
+    for (uint32_t i = 0; i < MI_LENGTH_BYTES; i++)
+        rs[i] = m_mi[i];                                                            // Message Indicator
+
+    rs[9U] = m_algId;                                                               // Algorithm ID
+    rs[10U] = (m_kId >> 8) & 0xFFU;                                                 // Key ID
+    rs[11U] = (m_kId >> 0) & 0xFFU;                                                 // ...
+}
+
 /* Helper to determine if the MFId is a standard MFId. */
 
 bool LC::isStandardMFId() const
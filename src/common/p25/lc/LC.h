@@ -107,6 +107,17 @@ namespace p25
              */
             void encodeLDU2(uint8_t* data);
 
+            /**
+             * @brief Encode the link control words carried by a logical link data unit 1, before FEC.
+             * @param[out] rs Buffer (P25_LDU_LC_FEC_LENGTH_BYTES) to encode the LDU1 link control words into.
+             */
+            void encodeLDU1LC(uint8_t* rs);
+            /**
+             * @brief Encode the encryption sync words carried by a logical link data unit 2, before FEC.
+             * @param[out] rs Buffer (P25_LDU_LC_FEC_LENGTH_BYTES) to encode the LDU2 encryption sync words into.
+             */
+            void encodeLDU2LC(uint8_t* rs) const;
+
             /**
              * @brief Helper to determine if the MFId is a standard MFId.
              * @returns bool True, if the MFId contained for this LC is standard, otherwise false.
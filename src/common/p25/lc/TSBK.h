@@ -17,6 +17,7 @@
 #define  __P25_LC__TSBK_H__
 
 #include "common/Defines.h"
+#include "common/SlabAllocator.h"
 #include "common/edac/Trellis.h"
 #include "common/p25/lc/LC.h"
 #include "common/p25/lc/TDULC.h"
@@ -76,6 +77,8 @@ namespace p25
              */
             virtual ~TSBK();
 
+            __SLAB_ALLOCATED
+
             /**
              * @brief Decode a trunking signalling block.
              * @param[in] data Buffer containing a TSBK to decode.
@@ -45,6 +45,128 @@ TSBKFactory::~TSBKFactory() = default;
 /* Create an instance of a TSBK. */
 
 std::unique_ptr<TSBK> TSBKFactory::createTSBK(const uint8_t* data, bool rawTSBK)
+{
+    return std::unique_ptr<TSBK>(create(data, rawTSBK, nullptr));
+}
+
+/* Create an instance of a AMBT. */
+
+std::unique_ptr<AMBT> TSBKFactory::createAMBT(const data::DataHeader& dataHeader, const data::DataBlock* blocks)
+{
+    assert(blocks != nullptr);
+
+    if (dataHeader.getFormat() != PDUFormatType::AMBT) {
+        LogError(LOG_P25, "TSBKFactory::createAMBT(), PDU is not a AMBT PDU");
+        return nullptr;
+    }
+
+    if (dataHeader.getBlocksToFollow() == 0U) {
+        LogError(LOG_P25, "TSBKFactory::createAMBT(), PDU contains no data blocks");
+        return nullptr;
+    }
+
+    uint8_t lco = dataHeader.getAMBTOpcode();                                       // LCO
+    uint8_t mfId = dataHeader.getMFId();                                            // Mfg Id.
+
+    // Motorola P25 vendor opcodes
+    if (mfId == MFG_MOT) {
+        switch (lco) {
+        case TSBKO::IOSP_GRP_VCH:
+        case TSBKO::IOSP_UU_VCH:
+        case TSBKO::IOSP_UU_ANS:
+        case TSBKO::IOSP_TELE_INT_ANS:
+        case TSBKO::IOSP_STS_UPDT:
+        case TSBKO::IOSP_STS_Q:
+        case TSBKO::IOSP_MSG_UPDT:
+        case TSBKO::IOSP_CALL_ALRT:
+        case TSBKO::IOSP_ACK_RSP:
+        case TSBKO::IOSP_GRP_AFF:
+        case TSBKO::IOSP_U_REG:
+        case TSBKO::ISP_CAN_SRV_REQ:
+        case TSBKO::OSP_DENY_RSP:
+        case TSBKO::OSP_QUE_RSP:
+        case TSBKO::ISP_U_DEREG_REQ:
+        case TSBKO::OSP_U_DEREG_ACK:
+        case TSBKO::ISP_LOC_REG_REQ:
+            mfId = MFG_STANDARD;
+            break;
+        case TSBKO::ISP_GRP_AFF_Q_RSP:
+            return decode(new MBT_ISP_GRP_AFF_Q_RSP(), dataHeader, blocks);
+        default:
+            LogError(LOG_P25, "TSBKFactory::createAMBT(), unknown TSBK LCO value, mfId = $%02X, lco = $%02X", mfId, lco);
+            break;
+        }
+
+        if (mfId == MFG_MOT) {
+            return nullptr;
+        }
+        else {
+            mfId = dataHeader.getMFId();
+        }
+    }
+
+    // standard P25 reference opcodes
+    switch (lco) {
+    case TSBKO::IOSP_STS_UPDT:
+        return decode(new MBT_IOSP_STS_UPDT(), dataHeader, blocks);
+    case TSBKO::IOSP_MSG_UPDT:
+        return decode(new MBT_IOSP_MSG_UPDT(), dataHeader, blocks);
+    case TSBKO::IOSP_CALL_ALRT:
+        return decode(new MBT_IOSP_CALL_ALRT(), dataHeader, blocks);
+    case TSBKO::IOSP_ACK_RSP:
+        return decode(new MBT_IOSP_ACK_RSP(), dataHeader, blocks);
+    case TSBKO::IOSP_GRP_AFF:
+        return decode(new MBT_IOSP_GRP_AFF(), dataHeader, blocks);
+    case TSBKO::ISP_CAN_SRV_REQ:
+        return decode(new MBT_ISP_CAN_SRV_REQ(), dataHeader, blocks);
+    case TSBKO::IOSP_EXT_FNCT:
+        return decode(new MBT_IOSP_EXT_FNCT(), dataHeader, blocks);
+    case TSBKO::ISP_AUTH_RESP_M:
+        return decode(new MBT_ISP_AUTH_RESP_M(), dataHeader, blocks);
+    case TSBKO::ISP_AUTH_SU_DMD:
+        return decode(new MBT_ISP_AUTH_SU_DMD(), dataHeader, blocks);
+    default:
+        LogError(LOG_P25, "TSBKFactory::createAMBT(), unknown TSBK LCO value, mfId = $%02X, lco = $%02X", mfId, lco);
+        break;
+    }
+
+    return nullptr;
+}
+
+/* Decode a TSBK in place, without allocating. */
+
+TSBK* TSBKFactory::decodeTSBK(const uint8_t* data, TSBKStorage& storage, bool rawTSBK)
+{
+    storage.reset();
+    return create(data, rawTSBK, &storage);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Decode a TSBK. */
+
+template<class T>
+TSBK* TSBKFactory::decode(TSBKStorage* storage, const uint8_t* data, bool rawTSBK)
+{
+    assert(data != nullptr);
+
+    TSBK* tsbk = (storage != nullptr) ? storage->emplace<T>() : new T();
+    if (!tsbk->decode(data, rawTSBK)) {
+        if (storage != nullptr)
+            storage->reset();
+        else
+            delete tsbk;
+        return nullptr;
+    }
+
+    return tsbk;
+}
+
+/* Create and decode a TSBK, either in the given storage or (if none) on the heap. */
+
+TSBK* TSBKFactory::create(const uint8_t* data, bool rawTSBK, TSBKStorage* storage)
 {
     assert(data != nullptr);
 
@@ -149,7 +271,7 @@ std::unique_ptr<TSBK> TSBKFactory::createTSBK(const uint8_t* data, bool rawTSBK)
     if (mfId == MFG_DVM_OCS) {
         switch (lco) {
         case LCO::CALL_TERM:
-            return decode(new OSP_DVM_LC_CALL_TERM(), data, rawTSBK);
+            return decode<OSP_DVM_LC_CALL_TERM>(storage, data, rawTSBK);
         default:
             mfId = MFG_STANDARD;
             break;
@@ -166,57 +288,57 @@ std::unique_ptr<TSBK> TSBKFactory::createTSBK(const uint8_t* data, bool rawTSBK)
     // standard P25 reference opcodes
     switch (lco) {
     case TSBKO::IOSP_GRP_VCH:
-        return decode(new IOSP_GRP_VCH(), data, rawTSBK);
+        return decode<IOSP_GRP_VCH>(storage, data, rawTSBK);
     case TSBKO::OSP_GRP_VCH_GRANT_UPD:
-        return decode(new OSP_GRP_VCH_GRANT_UPD(), data, rawTSBK);
+        return decode<OSP_GRP_VCH_GRANT_UPD>(storage, data, rawTSBK);
     case TSBKO::IOSP_UU_VCH:
-        return decode(new IOSP_UU_VCH(), data, rawTSBK);
+        return decode<IOSP_UU_VCH>(storage, data, rawTSBK);
     case TSBKO::OSP_UU_VCH_GRANT_UPD:
-        return decode(new OSP_UU_VCH_GRANT_UPD(), data, rawTSBK);
+        return decode<OSP_UU_VCH_GRANT_UPD>(storage, data, rawTSBK);
     case TSBKO::IOSP_UU_ANS:
-        return decode(new IOSP_UU_ANS(), data, rawTSBK);
+        return decode<IOSP_UU_ANS>(storage, data, rawTSBK);
     case TSBKO::ISP_SNDCP_CH_REQ:
-        return decode(new ISP_SNDCP_CH_REQ(), data, rawTSBK);
+        return decode<ISP_SNDCP_CH_REQ>(storage, data, rawTSBK);
     case TSBKO::ISP_SNDCP_REC_REQ:
-        return decode(new ISP_SNDCP_REC_REQ(), data, rawTSBK);
+        return decode<ISP_SNDCP_REC_REQ>(storage, data, rawTSBK);
     case TSBKO::IOSP_STS_UPDT:
-        return decode(new IOSP_STS_UPDT(), data, rawTSBK);
+        return decode<IOSP_STS_UPDT>(storage, data, rawTSBK);
     case TSBKO::IOSP_MSG_UPDT:
-        return decode(new IOSP_MSG_UPDT(), data, rawTSBK);
+        return decode<IOSP_MSG_UPDT>(storage, data, rawTSBK);
     case TSBKO::IOSP_RAD_MON:
-        return decode(new IOSP_RAD_MON(), data, rawTSBK);
+        return decode<IOSP_RAD_MON>(storage, data, rawTSBK);
     case TSBKO::IOSP_CALL_ALRT:
-        return decode(new IOSP_CALL_ALRT(), data, rawTSBK);
+        return decode<IOSP_CALL_ALRT>(storage, data, rawTSBK);
     case TSBKO::IOSP_ACK_RSP:
-        return decode(new IOSP_ACK_RSP(), data, rawTSBK);
+        return decode<IOSP_ACK_RSP>(storage, data, rawTSBK);
     case TSBKO::ISP_EMERG_ALRM_REQ:
-        return decode(new ISP_EMERG_ALRM_REQ(), data, rawTSBK);
+        return decode<ISP_EMERG_ALRM_REQ>(storage, data, rawTSBK);
     case TSBKO::IOSP_EXT_FNCT:
-        return decode(new IOSP_EXT_FNCT(), data, rawTSBK);
+        return decode<IOSP_EXT_FNCT>(storage, data, rawTSBK);
     case TSBKO::IOSP_GRP_AFF:
-        return decode(new IOSP_GRP_AFF(), data, rawTSBK);
+        return decode<IOSP_GRP_AFF>(storage, data, rawTSBK);
     case TSBKO::IOSP_U_REG:
-        return decode(new IOSP_U_REG(), data, rawTSBK);
+        return decode<IOSP_U_REG>(storage, data, rawTSBK);
     case TSBKO::ISP_CAN_SRV_REQ:
-        return decode(new ISP_CAN_SRV_REQ(), data, rawTSBK);
+        return decode<ISP_CAN_SRV_REQ>(storage, data, rawTSBK);
     case TSBKO::ISP_GRP_AFF_Q_RSP:
-        return decode(new ISP_GRP_AFF_Q_RSP(), data, rawTSBK);
+        return decode<ISP_GRP_AFF_Q_RSP>(storage, data, rawTSBK);
     case TSBKO::OSP_QUE_RSP:
-        return decode(new OSP_QUE_RSP(), data, rawTSBK);
+        return decode<OSP_QUE_RSP>(storage, data, rawTSBK);
     case TSBKO::ISP_U_DEREG_REQ:
-        return decode(new ISP_U_DEREG_REQ(), data, rawTSBK);
+        return decode<ISP_U_DEREG_REQ>(storage, data, rawTSBK);
     case TSBKO::OSP_U_DEREG_ACK:
-        return decode(new OSP_U_DEREG_ACK(), data, rawTSBK);
+        return decode<OSP_U_DEREG_ACK>(storage, data, rawTSBK);
     case TSBKO::ISP_LOC_REG_REQ:
-        return decode(new ISP_LOC_REG_REQ(), data, rawTSBK);
+        return decode<ISP_LOC_REG_REQ>(storage, data, rawTSBK);
     case TSBKO::ISP_AUTH_RESP:
-        return decode(new ISP_AUTH_RESP(), data, rawTSBK);
+        return decode<ISP_AUTH_RESP>(storage, data, rawTSBK);
     case TSBKO::ISP_AUTH_FNE_RST:
-        return decode(new ISP_AUTH_FNE_RST(), data, rawTSBK);
+        return decode<ISP_AUTH_FNE_RST>(storage, data, rawTSBK);
     case TSBKO::ISP_AUTH_SU_DMD:
-        return decode(new ISP_AUTH_SU_DMD(), data, rawTSBK);
+        return decode<ISP_AUTH_SU_DMD>(storage, data, rawTSBK);
     case TSBKO::OSP_ADJ_STS_BCAST:
-        return decode(new OSP_ADJ_STS_BCAST(), data, rawTSBK);
+        return decode<OSP_ADJ_STS_BCAST>(storage, data, rawTSBK);
     default:
         LogError(LOG_P25, "TSBKFactory::create(), unknown TSBK LCO value, mfId = $%02X, lco = $%02X", mfId, lco);
         break;
@@ -225,108 +347,6 @@ std::unique_ptr<TSBK> TSBKFactory::createTSBK(const uint8_t* data, bool rawTSBK)
     return nullptr;
 }
 
-/* Create an instance of a AMBT. */
-
-std::unique_ptr<AMBT> TSBKFactory::createAMBT(const data::DataHeader& dataHeader, const data::DataBlock* blocks)
-{
-    assert(blocks != nullptr);
-
-    if (dataHeader.getFormat() != PDUFormatType::AMBT) {
-        LogError(LOG_P25, "TSBKFactory::createAMBT(), PDU is not a AMBT PDU");
-        return nullptr;
-    }
-
-    if (dataHeader.getBlocksToFollow() == 0U) {
-        LogError(LOG_P25, "TSBKFactory::createAMBT(), PDU contains no data blocks");
-        return nullptr;
-    }
-
-    uint8_t lco = dataHeader.getAMBTOpcode();                                       // LCO
-    uint8_t mfId = dataHeader.getMFId();                                            // Mfg Id.
-
-    // Motorola P25 vendor opcodes
-    if (mfId == MFG_MOT) {
-        switch (lco) {
-        case TSBKO::IOSP_GRP_VCH:
-        case TSBKO::IOSP_UU_VCH:
-        case TSBKO::IOSP_UU_ANS:
-        case TSBKO::IOSP_TELE_INT_ANS:
-        case TSBKO::IOSP_STS_UPDT:
-        case TSBKO::IOSP_STS_Q:
-        case TSBKO::IOSP_MSG_UPDT:
-        case TSBKO::IOSP_CALL_ALRT:
-        case TSBKO::IOSP_ACK_RSP:
-        case TSBKO::IOSP_GRP_AFF:
-        case TSBKO::IOSP_U_REG:
-        case TSBKO::ISP_CAN_SRV_REQ:
-        case TSBKO::OSP_DENY_RSP:
-        case TSBKO::OSP_QUE_RSP:
-        case TSBKO::ISP_U_DEREG_REQ:
-        case TSBKO::OSP_U_DEREG_ACK:
-        case TSBKO::ISP_LOC_REG_REQ:
-            mfId = MFG_STANDARD;
-            break;
-        case TSBKO::ISP_GRP_AFF_Q_RSP:
-            return decode(new MBT_ISP_GRP_AFF_Q_RSP(), dataHeader, blocks);
-        default:
-            LogError(LOG_P25, "TSBKFactory::createAMBT(), unknown TSBK LCO value, mfId = $%02X, lco = $%02X", mfId, lco);
-            break;
-        }
-
-        if (mfId == MFG_MOT) {
-            return nullptr;
-        }
-        else {
-            mfId = dataHeader.getMFId();
-        }
-    }
-
-    // standard P25 reference opcodes
-    switch (lco) {
-    case TSBKO::IOSP_STS_UPDT:
-        return decode(new MBT_IOSP_STS_UPDT(), dataHeader, blocks);
-    case TSBKO::IOSP_MSG_UPDT:
-        return decode(new MBT_IOSP_MSG_UPDT(), dataHeader, blocks);
-    case TSBKO::IOSP_CALL_ALRT:
-        return decode(new MBT_IOSP_CALL_ALRT(), dataHeader, blocks);
-    case TSBKO::IOSP_ACK_RSP:
-        return decode(new MBT_IOSP_ACK_RSP(), dataHeader, blocks);
-    case TSBKO::IOSP_GRP_AFF:
-        return decode(new MBT_IOSP_GRP_AFF(), dataHeader, blocks);
-    case TSBKO::ISP_CAN_SRV_REQ:
-        return decode(new MBT_ISP_CAN_SRV_REQ(), dataHeader, blocks);
-    case TSBKO::IOSP_EXT_FNCT:
-        return decode(new MBT_IOSP_EXT_FNCT(), dataHeader, blocks);
-    case TSBKO::ISP_AUTH_RESP_M:
-        return decode(new MBT_ISP_AUTH_RESP_M(), dataHeader, blocks);
-    case TSBKO::ISP_AUTH_SU_DMD:
-        return decode(new MBT_ISP_AUTH_SU_DMD(), dataHeader, blocks);
-    default:
-        LogError(LOG_P25, "TSBKFactory::createAMBT(), unknown TSBK LCO value, mfId = $%02X, lco = $%02X", mfId, lco);
-        break;
-    }
-
-    return nullptr;
-}
-
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* Decode a TSBK. */
-
-std::unique_ptr<TSBK> TSBKFactory::decode(TSBK* tsbk, const uint8_t* data, bool rawTSBK)
-{
-    assert(tsbk != nullptr);
-    assert(data != nullptr);
-
-    if (!tsbk->decode(data, rawTSBK)) {
-        return nullptr;
-    }
-
-    return std::unique_ptr<TSBK>(tsbk);
-}
-
 /* Decode an AMBT. */
 
 std::unique_ptr<AMBT> TSBKFactory::decode(AMBT* ambt, const data::DataHeader& dataHeader, const data::DataBlock* blocks)
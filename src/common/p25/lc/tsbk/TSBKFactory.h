@@ -25,6 +25,7 @@
 #define  __P25_LC__TSBK_FACTORY_H__
 
 #include "common/Defines.h"
+#include "common/InlineObject.h"
 
 #include "common/edac/Trellis.h"
 
@@ -104,6 +105,22 @@ namespace p25
     {
         namespace tsbk
         {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            const size_t TSBK_INLINE_SIZE = 128U;   // largest decoded TSBK (OSP_ADJ_STS_BCAST) is 104 bytes
+
+            // ---------------------------------------------------------------------------
+            //  Types
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Stack storage for a TSBK decoded in place by TSBKFactory::decodeTSBK().
+             * @ingroup p25_tsbk
+             */
+            typedef InlineObject<TSBK, TSBK_INLINE_SIZE> TSBKStorage;
+
             // ---------------------------------------------------------------------------
             //  Class Declaration
             // ---------------------------------------------------------------------------
@@ -137,6 +154,33 @@ namespace p25
                  * @returns AMBT* Instance of a AMBT representing the decoded data.
                  */
                 static std::unique_ptr<AMBT> createAMBT(const data::DataHeader& dataHeader, const data::DataBlock* blocks);
+                /**
+                 * @brief Decode a TSBK in place, without allocating.
+                 * @param[in] data Buffer containing TSBK packet data to decode.
+                 * @param storage Storage to decode the TSBK into.
+                 * @param rawTSBK Flag indicating whether or not the passed buffer is raw.
+                 * @returns TSBK* Instance of a TSBK (held by storage) representing the decoded data, or nullptr.
+                 */
+                static TSBK* decodeTSBK(const uint8_t* data, TSBKStorage& storage, bool rawTSBK = false);
+                /**
+                 * @brief Decode a TSBK in place, without allocating, and pass it to the given visitor.
+                 * @tparam Visitor Callable taking a TSBK&.
+                 * @param[in] data Buffer containing TSBK packet data to decode.
+                 * @param visitor Visitor called with the decoded TSBK.
+                 * @param rawTSBK Flag indicating whether or not the passed buffer is raw.
+                 * @returns bool True, if the TSBK was decoded and visited, otherwise false.
+                 */
+                template<typename Visitor>
+                static bool visitTSBK(const uint8_t* data, Visitor&& visitor, bool rawTSBK = false)
+                {
+                    TSBKStorage storage;
+                    TSBK* tsbk = decodeTSBK(data, storage, rawTSBK);
+                    if (tsbk == nullptr)
+                        return false;
+
+                    visitor(*tsbk);
+                    return true;
+                }
 
                 /**
                  * @brief Sets the flag indicating CRC-errors should be warnings and not errors.
@@ -147,14 +191,24 @@ namespace p25
             private:
                 static bool m_warnCRC;
 
+                /**
+                 * @brief Create and decode a TSBK.
+                 * @param[in] data Buffer containing TSBK packet data to decode.
+                 * @param rawTSBK Flag indicating whether or not the passed buffer is raw.
+                 * @param storage Storage to decode the TSBK into, or nullptr to allocate it on the heap.
+                 * @returns TSBK* Instance of a TSBK representing the decoded data.
+                 */
+                static TSBK* create(const uint8_t* data, bool rawTSBK, TSBKStorage* storage);
                 /**
                  * @brief Decode a TSBK.
-                 * @param tsbk Instance of a TSBK.
+                 * @tparam T TSBK class.
+                 * @param storage Storage to decode the TSBK into, or nullptr to allocate it on the heap.
                  * @param[in] data Buffer containing TSBK packet data to decode.
                  * @param rawTSBK Flag indicating whether or not the passed buffer is raw.
                  * @returns TSBK* Instance of a TSBK representing the decoded data.
                  */
-                static std::unique_ptr<TSBK> decode(TSBK* tsbk, const uint8_t* data, bool rawTSBK = false);
+                template<class T>
+                static TSBK* decode(TSBKStorage* storage, const uint8_t* data, bool rawTSBK);
                 /**
                  * @brief Decode an AMBT.
                  * @param tsbk Instance of a TSBK.
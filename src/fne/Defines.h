@@ -38,4 +38,6 @@
 #undef DEFAULT_LOCK_FILE
 #define DEFAULT_LOCK_FILE "/tmp/dvmfne.lock"
 
+#define DEFAULT_MTU_SIZE 496
+
 #endif // __DEFINES_H__
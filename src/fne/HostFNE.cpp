@@ -40,7 +40,7 @@ using namespace lookups;
 // ---------------------------------------------------------------------------
 
 #define IDLE_WARMUP_MS 5U
-#define DEFAULT_MTU_SIZE 496
+#define VTUN_READ_TIMEOUT_MS 100
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -53,8 +53,12 @@ HostFNE::HostFNE(const std::string& confFile) :
     m_conf(),
     m_network(nullptr),
     m_diagNetwork(nullptr),
+    m_capture(nullptr),
     m_vtunEnabled(false),
     m_packetDataMode(PacketDataMode::PROJECT25),
+    m_vtunDMRSlot(1U),
+    m_vtunPDUAckTimeout(5000U),
+    m_vtunPDURetries(2U),
 #if !defined(_WIN32)
     m_tun(nullptr),
 #endif // !defined(_WIN32)
@@ -268,6 +272,12 @@ int HostFNE::run()
         delete m_diagNetwork;
     }
 
+    if (m_capture != nullptr) {
+        LogMessage(LOG_HOST, "Packet capture closed, %llu datagrams captured", (unsigned long long)m_capture->count());
+        m_capture->close();
+        delete m_capture;
+    }
+
     for (auto network : m_peerNetworks) {
         network::Network* peerNetwork = network.second;
         if (peerNetwork != nullptr)
@@ -352,6 +362,7 @@ bool HostFNE::readParams()
     yaml::Node talkgroupRules = masterConf["talkgroup_rules"];
     std::string talkgroupConfig = talkgroupRules["file"].as<std::string>();
     uint32_t talkgroupConfigReload = talkgroupRules["time"].as<uint32_t>(30U);
+    bool talkgroupConfigCache = talkgroupRules["cache"].as<bool>(false);
 
     std::string peerListLookupFile = systemConf["peer_acl"]["file"].as<std::string>();
     bool peerListLookupEnable = systemConf["peer_acl"]["enabled"].as<bool>(false);
@@ -369,9 +380,11 @@ bool HostFNE::readParams()
     LogInfo("    File: %s", talkgroupConfig.length() > 0U ? talkgroupConfig.c_str() : "None");
     if (talkgroupConfigReload > 0U)
         LogInfo("    Reload: %u mins", talkgroupConfigReload);
+    LogInfo("    Compiled Cache: %s", talkgroupConfigCache ? "yes" : "no");
 
     m_tidLookup = new TalkgroupRulesLookup(talkgroupConfig, talkgroupConfigReload, true);
     m_tidLookup->sendTalkgroups(sendTalkgroups);
+    m_tidLookup->useCache(talkgroupConfigCache);
     m_tidLookup->read();
 
     // try to load peer whitelist/blacklist
@@ -478,6 +491,8 @@ bool HostFNE::createMasterNetwork()
 
     bool reportPeerPing = masterConf["reportPeerPing"].as<bool>(false);
 
+    std::string captureFile = masterConf["captureFile"].as<std::string>();
+
     bool encrypted = masterConf["encrypted"].as<bool>(false);
     std::string key = masterConf["presharedKey"].as<std::string>();
     uint8_t presharedKey[AES_WRAPPED_PCKT_KEY_LEN];
@@ -540,6 +555,10 @@ bool HostFNE::createMasterNetwork()
 
     LogInfo("    Report Peer Pings: %s", reportPeerPing ? "yes" : "no");
 
+    if (!captureFile.empty()) {
+        LogInfo("    Packet Capture File: %s", captureFile.c_str());
+    }
+
     if (verbose) {
         LogInfo("    Verbose: yes");
     }
@@ -571,6 +590,11 @@ bool HostFNE::createMasterNetwork()
         m_network->setPresharedKey(presharedKey);
     }
 
+    if (!captureFile.empty()) {
+        m_capture = new PacketCapture(captureFile);
+        m_network->getFrameQueue()->setCapture(m_capture);
+    }
+
     // setup alternate port for diagnostics/activity logging
     if (m_useAlternatePortForDiagnostics) {
         m_diagNetwork = new DiagNetwork(this, m_network, address, port + 1U);
@@ -808,12 +832,30 @@ bool HostFNE::createVirtualNetworking()
             m_packetDataMode = PacketDataMode::PROJECT25;
         }
 
+        m_vtunDMRSlot = (uint8_t)vtunConf["dmrSlot"].as<uint32_t>(1U);
+        if (m_vtunDMRSlot < 1U || m_vtunDMRSlot > 2U) {
+            LogWarning(LOG_HOST, "Virtual network DMR slot must be 1 or 2, defaulting to slot 1");
+            m_vtunDMRSlot = 1U;
+        }
+
+        m_vtunPDUAckTimeout = vtunConf["pduAckTimeout"].as<uint32_t>(5000U);
+        if (m_vtunPDUAckTimeout < 1000U) {
+            LogWarning(LOG_HOST, "Virtual network PDU acknowledgement timeout is too short, defaulting to 1000ms");
+            m_vtunPDUAckTimeout = 1000U;
+        }
+        m_vtunPDURetries = (uint8_t)vtunConf["pduRetries"].as<uint32_t>(2U);
+
         LogInfo("Virtual Network Parameters");
         LogInfo("    Interface Name: %s", vtunName.c_str());
         LogInfo("    Address: %s", ipv4Address.c_str());
         LogInfo("    Netmask: %s", ipv4Netmask.c_str());
         LogInfo("    Broadcast: %s", ipv4Broadcast.c_str());
         LogInfo("    Digital Packet Mode: %s", packetDataModeStr.c_str());
+        if (m_packetDataMode == PacketDataMode::DMR) {
+            LogInfo("    DMR Slot: %u", m_vtunDMRSlot);
+        }
+        LogInfo("    PDU Ack Timeout: %ums", m_vtunPDUAckTimeout);
+        LogInfo("    PDU Retries: %u", m_vtunPDURetries);
 
         // initialize networking
         m_tun = new VIFace(vtunName, false);
@@ -861,29 +903,28 @@ void* HostFNE::threadVirtualNetworking(void* arg)
 #endif // _GNU_SOURCE
 
         if (fne->m_tun != nullptr) {
-            StopWatch stopWatch;
-            stopWatch.start();
+            uint8_t packet[DEFAULT_MTU_SIZE];
 
             while (!g_killed) {
-                stopWatch.start();
-
-                uint8_t packet[DEFAULT_MTU_SIZE];
-                ::memset(packet, 0x00U, DEFAULT_MTU_SIZE);
-
-                ssize_t len = fne->m_tun->read(packet);
-                if (len > 0) {
+                // block until the interface has a packet pending (the timeout only exists so we
+                // periodically recheck for shutdown), then drain everything that is pending
+                ssize_t len = fne->m_tun->read(packet, VTUN_READ_TIMEOUT_MS);
+                while (len > 0) {
                     switch (fne->m_packetDataMode) {
                     case PacketDataMode::DMR:
-                        // TODO: not supported yet
+                        fne->m_network->dmrTrafficHandler()->packetData()->processPacketFrame(packet, (uint32_t)len);
                         break;
 
                     case PacketDataMode::PROJECT25:
-                        fne->m_network->p25TrafficHandler()->packetData()->processPacketFrame(packet, DEFAULT_MTU_SIZE);
+                        fne->m_network->p25TrafficHandler()->packetData()->processPacketFrame(packet, (uint32_t)len);
                         break;
                     }
-                }
 
-                Thread::sleep(2U);
+                    if (g_killed)
+                        break;
+
+                    len = fne->m_tun->read(packet);
+                }
             }
         }
 
@@ -935,7 +976,7 @@ void* HostFNE::threadVirtualNetworkingClock(void* arg)
                 // clock traffic handler
                 switch (fne->m_packetDataMode) {
                 case PacketDataMode::DMR:
-                    // TODO: not supported yet
+                    fne->m_network->dmrTrafficHandler()->packetData()->clock(ms);
                     break;
 
                 case PacketDataMode::PROJECT25:
@@ -20,6 +20,7 @@
 #include "common/lookups/RadioIdLookup.h"
 #include "common/lookups/TalkgroupRulesLookup.h"
 #include "common/lookups/PeerListLookup.h"
+#include "common/network/PacketCapture.h"
 #include "common/network/viface/VIFace.h"
 #include "common/yaml/Yaml.h"
 #include "common/Timer.h"
@@ -89,9 +90,13 @@ private:
     friend class network::callhandler::TagNXDNData;
     network::FNENetwork* m_network;
     network::DiagNetwork* m_diagNetwork;
+    network::PacketCapture* m_capture;
 
     bool m_vtunEnabled;
     PacketDataMode m_packetDataMode;
+    uint8_t m_vtunDMRSlot;
+    uint32_t m_vtunPDUAckTimeout;
+    uint8_t m_vtunPDURetries;
 #if !defined(_WIN32)
     network::viface::VIFace* m_tun;
 #endif // !defined(_WIN32)
@@ -65,10 +65,10 @@ void DiagNetwork::processNetwork()
     int length = 0U;
 
     // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+    PacketBuffer buffer = m_frameQueue->readPacket(length, address, addrLen, &rtpHeader, &fneHeader);
     if (length > 0) {
         if (m_debug)
-            Utils::dump(1U, "Network Message", buffer.get(), length);
+            Utils::dump(1U, "Network Message", buffer.data(), length);
 
         uint32_t peerId = fneHeader.getPeerId();
 
@@ -81,11 +81,10 @@ void DiagNetwork::processNetwork()
         req->fneHeader = fneHeader;
 
         req->length = length;
-        req->buffer = new uint8_t[length];
-        ::memcpy(req->buffer, buffer.get(), length);
+        req->packet = std::move(buffer);
+        req->buffer = req->packet.data();
 
         if (!Thread::runAsThread(m_fneNetwork, threadedNetworkRx, req)) {
-            delete[] req->buffer;
             delete req;
             return;
         }
@@ -160,6 +159,9 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
             return nullptr;
         }
 
+        // peer connections used by this thread stay valid until it completes
+        FNEPeerRegistry::ReadGuard guard(network->m_peers);
+
         if (req->length > 0) {
             uint32_t peerId = req->fneHeader.getPeerId();
             uint32_t streamId = req->fneHeader.getStreamId();
@@ -171,8 +173,8 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
 #endif // _GNU_SOURCE
 
             // update current peer packet sequence and stream ID
-            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end()) && streamId != 0U) {
-                FNEPeerConnection* connection = network->m_peers[peerId];
+            if (peerId > 0 && network->m_peers.contains(peerId) && streamId != 0U) {
+                FNEPeerConnection* connection = network->m_peers.find(peerId);
                 uint16_t pktSeq = req->rtpHeader.getSequence();
 
                 if (connection != nullptr) {
@@ -194,7 +196,6 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     }
                 }
 
-                network->m_peers[peerId] = connection;
             }
 
             // process incoming message frame opcodes
@@ -204,14 +205,14 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     // resolve peer ID (used for Activity Log and Status Transfer)
                     bool validPeerId = false;
                     uint32_t pktPeerId = 0U;
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && network->m_peers.contains(peerId)) {
                         validPeerId = true;
                         pktPeerId = peerId;
                     } else {
                         if (peerId > 0) {
                             // this could be a peer-link transfer -- in which case, we need to check the SSRC of the packet not the peer ID
-                            if (network->m_peers.find(req->rtpHeader.getSSRC()) != network->m_peers.end()) {
-                                FNEPeerConnection* connection = network->m_peers[req->rtpHeader.getSSRC()];
+                            if (network->m_peers.contains(req->rtpHeader.getSSRC())) {
+                                FNEPeerConnection* connection = network->m_peers.find(req->rtpHeader.getSSRC());
                                 if (connection != nullptr) {
                                     if (connection->isExternalPeer() && connection->isPeerLink()) {
                                         validPeerId = true;
@@ -225,7 +226,7 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     if (req->fneHeader.getSubFunction() == NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY) {    // Peer Activity Log Transfer
                         if (network->m_allowActivityTransfer) {
                             if (pktPeerId > 0 && validPeerId) {
-                                FNEPeerConnection* connection = network->m_peers[pktPeerId];
+                                FNEPeerConnection* connection = network->m_peers.find(pktPeerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
@@ -252,7 +253,7 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
 
                                         // repeat traffic to the connected SysView peers
                                         if (network->m_peers.size() > 0U) {
-                                            for (auto peer : network->m_peers) {
+                                            for (auto peer : network->m_peers.snapshot()) {
                                                 if (peer.second != nullptr) {
                                                     if (peer.second->isSysView()) {
                                                         uint32_t peerStreamId = peer.second->currStreamId();
@@ -292,8 +293,8 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG) {   // Peer Diagnostic Log Transfer
                         if (network->m_allowDiagnosticTransfer) {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && network->m_peers.contains(peerId)) {
+                                FNEPeerConnection* connection = network->m_peers.find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
@@ -330,7 +331,7 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::TRANSFER_SUBFUNC_STATUS) { // Peer Status Transfer
                         if (pktPeerId > 0 && validPeerId) {
-                            FNEPeerConnection* connection = network->m_peers[pktPeerId];
+                            FNEPeerConnection* connection = network->m_peers.find(pktPeerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
 
@@ -338,7 +339,7 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                                 if (connection->connected() && connection->address() == ip) {
                                     if (network->m_peers.size() > 0U) {
                                         // attempt to repeat status traffic to SysView clients
-                                        for (auto peer : network->m_peers) {
+                                        for (auto peer : network->m_peers.snapshot()) {
                                             if (peer.second != nullptr) {
                                                 if (peer.second->isSysView()) {
                                                     uint32_t peerStreamId = peer.second->currStreamId();
@@ -388,35 +389,17 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::PEER_LINK:
                 if (req->fneHeader.getSubFunction() == NET_SUBFUNC::PL_ACT_PEER_LIST) { // Peer-Link Active Peer List
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && network->m_peers.contains(peerId)) {
+                        FNEPeerConnection* connection = network->m_peers.find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
                             // validate peer (simple validation really)
                             if (connection->connected() && connection->address() == ip && connection->isExternalPeer() &&
                                 connection->isPeerLink()) {
-                                UInt8Array __rawPayload = std::make_unique<uint8_t[]>(req->length - 8U);
-                                uint8_t* rawPayload = __rawPayload.get();
-                                ::memset(rawPayload, 0x00U, req->length - 8U);
-                                ::memcpy(rawPayload, req->buffer + 8U, req->length - 8U);
-                                std::string payload(rawPayload, rawPayload + (req->length - 8U));
-
-                                // parse JSON body
-                                json::value v;
-                                std::string err = json::parse(v, payload);
-                                if (!err.empty()) {
-                                    break;
-                                }
-                                else  {
-                                    // ensure parsed JSON is an array
-                                    if (!v.is<json::array>()) {
-                                        break;
-                                    }
-                                    else {
-                                        json::array arr = v.get<json::array>();
-                                        network->m_peerLinkPeers[peerId] = arr;
-                                    }
+                                std::lock_guard<std::mutex> lock(network->m_peerLinkPeersMutex);
+                                if (!network->m_peerLinkPeers[peerId].decode(peerId, req->buffer, req->length)) {
+                                    LogWarning(LOG_NET, "PEER %u (%s) malformed Peer-Link active peer list", peerId, connection->identity().c_str());
                                 }
                             }
                             else {
@@ -433,8 +416,6 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
             }
         }
 
-        if (req->buffer != nullptr)
-            delete[] req->buffer;
         delete req;
     }
 
@@ -10,7 +10,6 @@
 #include "fne/Defines.h"
 #include "common/edac/SHA256.h"
 #include "common/network/json/json.h"
-#include "common/zlib/zlib.h"
 #include "common/Log.h"
 #include "common/Utils.h"
 #include "network/FNENetwork.h"
@@ -72,9 +71,15 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_peerListLookup(nullptr),
     m_status(NET_STAT_INVALID),
     m_peers(),
+    m_peerLinkPeersMutex(),
     m_peerLinkPeers(),
     m_peerAffiliations(),
+    m_ccPeerMapMutex(),
     m_ccPeerMap(),
+    m_peerLinkXferMutex(),
+    m_peerLinkXfers(),
+    m_peerLinkPeerEncoder(),
+    m_peerLinkRunning(),
     m_maintainenceTimer(1000U, pingTime),
     m_updateLookupTime(updateLookupTime * 60U),
     m_softConnLimit(0U),
@@ -113,6 +118,11 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
 
 FNENetwork::~FNENetwork()
 {
+    for (auto entry : m_peerLinkXfers) {
+        delete entry.second;
+    }
+    m_peerLinkXfers.clear();
+
     delete m_tagDMR;
     delete m_tagP25;
     delete m_tagNXDN;
@@ -227,10 +237,10 @@ void FNENetwork::processNetwork()
     int length = 0U;
 
     // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+    PacketBuffer buffer = m_frameQueue->readPacket(length, address, addrLen, &rtpHeader, &fneHeader);
     if (length > 0) {
         if (m_debug)
-            Utils::dump(1U, "Network Message", buffer.get(), length);
+            Utils::dump(1U, "Network Message", buffer.data(), length);
 
         uint32_t peerId = fneHeader.getPeerId();
 
@@ -243,11 +253,10 @@ void FNENetwork::processNetwork()
         req->fneHeader = fneHeader;
 
         req->length = length;
-        req->buffer = new uint8_t[length];
-        ::memcpy(req->buffer, buffer.get(), length);
+        req->packet = std::move(buffer);
+        req->buffer = req->packet.data();
 
         if (!Thread::runAsThread(this, threadedNetworkRx, req)) {
-            delete[] req->buffer;
             delete req;
             return;
         }
@@ -265,17 +274,19 @@ void FNENetwork::clock(uint32_t ms)
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
     if (m_forceListUpdate) {
-        for (auto peer : m_peers) {
+        for (auto peer : m_peers.snapshot()) {
             peerACLUpdate(peer.first);
         }
         m_forceListUpdate = false;
     }
 
+    clockPeerLinkTransfers(now);
+
     m_maintainenceTimer.clock(ms);
     if (m_maintainenceTimer.isRunning() && m_maintainenceTimer.hasExpired()) {
         // check to see if any peers have been quiet (no ping) longer than allowed
         std::vector<uint32_t> peersToRemove = std::vector<uint32_t>();
-        for (auto peer : m_peers) {
+        for (auto peer : m_peers.snapshot()) {
             uint32_t id = peer.first;
             FNEPeerConnection* connection = peer.second;
             if (connection != nullptr) {
@@ -292,13 +303,10 @@ void FNENetwork::clock(uint32_t ms)
 
         // remove any peers
         for (uint32_t peerId : peersToRemove) {
-            FNEPeerConnection* connection = m_peers[peerId];
             m_peers.erase(peerId);
-            if (connection != nullptr) {
-                delete connection;
-            }
 
             erasePeerAffiliations(peerId);
+            erasePeerLinkTransfers(peerId);
         }
 
         // roll the RTP timestamp if no call is in progress
@@ -309,27 +317,41 @@ void FNENetwork::clock(uint32_t ms)
 
         // send active peer list to Peer-Link masters
         if (m_host->m_peerNetworks.size() > 0) {
+            std::vector<network::PeerNetwork*> peerLinks;
             for (auto peer : m_host->m_peerNetworks) {
                 if (peer.second != nullptr) {
                     if (peer.second->isEnabled() && peer.second->isPeerLink()) {
-                        if (m_peers.size() > 0) {
-                            json::array peers = json::array();
-                            for (auto entry : m_peers) {
-                                uint32_t peerId = entry.first;
-                                network::FNEPeerConnection* peerConn = entry.second;
-                                if (peerConn != nullptr) {
-                                    json::object peerObj = fneConnObject(peerId, peerConn);
-                                    uint32_t peerNetPeerId = peer.second->getPeerId();
-                                    peerObj["parentPeerId"].set<uint32_t>(peerNetPeerId);
-                                    peers.push_back(json::value(peerObj));
-                                }
-                            }
-
-                            peer.second->writePeerLinkPeers(&peers);
+                        peerLinks.push_back(peer.second);
+
+                        // a Peer-Link master that has (re)connected needs the complete list
+                        uint32_t peerNetPeerId = peer.second->getPeerId();
+                        if (peer.second->getStatus() == NET_STAT_RUNNING) {
+                            if (m_peerLinkRunning.insert(peerNetPeerId).second)
+                                m_peerLinkPeerEncoder.forceSnapshot();
+                        } else {
+                            m_peerLinkRunning.erase(peerNetPeerId);
                         }
                     }
                 }
             }
+
+            if (peerLinks.size() > 0) {
+                std::vector<PeerLinkPeer> peers;
+                peers.reserve(m_peers.size());
+                for (auto entry : m_peers.snapshot()) {
+                    uint32_t peerId = entry.first;
+                    network::FNEPeerConnection* peerConn = entry.second;
+                    if (peerConn != nullptr) {
+                        peers.push_back(fnePeerLinkPeer(peerId, peerConn));
+                    }
+                }
+
+                // only the changes are encoded, once, and shared by every Peer-Link master
+                m_peerLinkPeerEncoder.update(peers);
+                for (network::PeerNetwork* peerLink : peerLinks) {
+                    peerLink->writePeerLinkPeers(m_peerLinkPeerEncoder.messages());
+                }
+            }
         }
 
         m_maintainenceTimer.start();
@@ -357,6 +379,9 @@ void FNENetwork::clock(uint32_t ms)
         m_parrotDelayTimer.isRunning() && m_parrotDelayTimer.hasExpired()) {
         m_parrotDelayTimer.stop();
     }
+
+    // free any peer connections removed since they are no longer in use
+    m_peers.reclaim();
 }
 
 /* Opens connection to the network. */
@@ -396,7 +421,7 @@ void FNENetwork::close()
         uint8_t buffer[1U];
         ::memset(buffer, 0x00U, 1U);
 
-        for (auto peer : m_peers) {
+        for (auto peer : m_peers.snapshot()) {
             writePeer(peer.first, { NET_FUNC::MST_CLOSING, NET_SUBFUNC::NOP }, buffer, 1U, (uint16_t)0U, 0U);
         }
     }
@@ -432,6 +457,9 @@ void* FNENetwork::threadedNetworkRx(void* arg)
             return nullptr;
         }
 
+        // peer connections used by this thread stay valid until it completes
+        FNEPeerRegistry::ReadGuard guard(network->m_peers);
+
         if (req->length > 0) {
             uint32_t peerId = req->fneHeader.getPeerId();
             uint32_t streamId = req->fneHeader.getStreamId();
@@ -443,8 +471,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 #endif // _GNU_SOURCE
 
             // update current peer packet sequence and stream ID
-            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end()) && streamId != 0U) {
-                FNEPeerConnection* connection = network->m_peers[peerId];
+            if (peerId > 0 && network->m_peers.contains(peerId) && streamId != 0U) {
+                FNEPeerConnection* connection = network->m_peers.find(peerId);
                 uint16_t pktSeq = req->rtpHeader.getSequence();
 
                 if (connection != nullptr) {
@@ -470,7 +498,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     }
                 }
 
-                network->m_peers[peerId] = connection;
             }
 
             // if we don't have a stream ID and are receiving call data -- throw an error and discard
@@ -478,8 +505,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 std::string peerIdentity = network->resolvePeerIdentity(peerId);
                 LogError(LOG_NET, "PEER %u (%s) malformed packet (no stream ID for a call?)", peerId, peerIdentity.c_str());
 
-                if (req->buffer != nullptr)
-                    delete req->buffer;
                 delete req;
 
                 return nullptr;
@@ -490,8 +515,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
             case NET_FUNC::PROTOCOL:
                 {
                     if (req->fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR) {         // Encapsulated DMR data frame
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
                                 connection->lastPing(now);
@@ -513,8 +538,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_P25) {    // Encapsulated P25 data frame
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
                                 connection->lastPing(now);
@@ -536,8 +561,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN) {   // Encapsulated NXDN data frame
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
                                 connection->lastPing(now);
@@ -566,7 +591,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::RPTL:                                                                        // Repeater Login
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) == network->m_peers.end())) {
+                    if (peerId > 0 && !network->m_peers.contains(peerId)) {
                         if (network->m_peers.size() >= MAX_HARD_CONN_CAP) {
                             LogError(LOG_NET, "PEER %u attempted to connect with no more connections available, currConnections = %u", peerId, network->m_peers.size());
                             network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_FNE_MAX_CONN, req->address, req->addrLen);
@@ -600,7 +625,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                                 network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_ACL, req->address, req->addrLen);
 
-                                delete connection;
                                 network->erasePeer(peerId);
                             }
                         }
@@ -608,14 +632,14 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     else {
                         // check if the peer is in our peer list -- if he is, and he isn't in a running state, reset
                         // the login sequence
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 if (connection->connectionState() == NET_STAT_RUNNING) {
                                     LogMessage(LOG_NET, "PEER %u (%s) resetting peer connection, connectionState = %u", peerId, connection->identity().c_str(),
                                         connection->connectionState());
-                                    delete connection;
 
+                                    // (the new connection replaces the old one, which is retired)
                                     connection = new FNEPeerConnection(peerId, req->address, req->addrLen);
                                     connection->lastPing(now);
                                     connection->currStreamId(streamId);
@@ -638,7 +662,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                                             network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_ACL, req->address, req->addrLen);
 
-                                            delete connection;
                                             network->erasePeer(peerId);
                                         }
                                     }
@@ -648,7 +671,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                     LogWarning(LOG_NET, "PEER %u (%s) RPTL NAK, bad connection state, connectionState = %u", peerId, connection->identity().c_str(),
                                         connection->connectionState());
 
-                                    delete connection;
                                     network->erasePeer(peerId);
                                 }
                             } else {
@@ -663,8 +685,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 break;
             case NET_FUNC::RPTK:                                                                        // Repeater Authentication
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && network->m_peers.contains(peerId)) {
+                        FNEPeerConnection* connection = network->m_peers.find(peerId);
                         if (connection != nullptr) {
                             connection->lastPing(now);
 
@@ -740,7 +762,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         connection->connectionState(NET_STAT_WAITING_CONFIG);
                                         network->writePeerACK(peerId);
                                         LogInfoEx(LOG_NET, "PEER %u RPTK ACK, completed the login exchange", peerId);
-                                        network->m_peers[peerId] = connection;
                                     }
                                     else {
                                         LogWarning(LOG_NET, "PEER %u RPTK NAK, failed the login exchange", peerId);
@@ -767,8 +788,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 break;
             case NET_FUNC::RPTC:                                                                        // Repeater Configuration
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && network->m_peers.contains(peerId)) {
+                        FNEPeerConnection* connection = network->m_peers.find(peerId);
                         if (connection != nullptr) {
                             connection->lastPing(now);
 
@@ -801,7 +822,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         connection->pingsReceived(0U);
                                         connection->lastPing(now);
                                         connection->lastACLUpdate(now);
-                                        network->m_peers[peerId] = connection;
 
                                         // attach extra notification data to the RPTC ACK to notify the peer of 
                                         // the use of the alternate diagnostic port
@@ -894,8 +914,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::RPT_CLOSING:                                                                 // Repeater Closing (Disconnect)
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && network->m_peers.contains(peerId)) {
+                        FNEPeerConnection* connection = network->m_peers.find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -904,7 +924,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                 LogInfoEx(LOG_NET, "PEER %u (%s) is closing down", peerId, connection->identity().c_str());
                                 if (network->erasePeer(peerId)) {
                                     network->erasePeerAffiliations(peerId);
-                                    delete connection;
                                 }
                             }
                         }
@@ -913,8 +932,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 break;
             case NET_FUNC::PING:                                                                        // Repeater Ping
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && network->m_peers.contains(peerId)) {
+                        FNEPeerConnection* connection = network->m_peers.find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -951,7 +970,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                 payload[6U] = (uint8_t)((now >> 8) & 0xFFU);
                                 payload[7U] = (uint8_t)((now >> 0) & 0xFFU);
 
-                                network->m_peers[peerId] = connection;
                                 network->writePeerCommand(peerId, { NET_FUNC::PONG, NET_SUBFUNC::NOP }, payload, 8U);
 
                                 if (network->m_reportPeerPing) {
@@ -969,8 +987,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::GRANT_REQ:                                                                   // Repeater Grant Request
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && network->m_peers.contains(peerId)) {
+                        FNEPeerConnection* connection = network->m_peers.find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -1036,8 +1054,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                     if (req->fneHeader.getSubFunction() == NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY) {    // Peer Activity Log Transfer
                         if (network->m_allowActivityTransfer) {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && network->m_peers.contains(peerId)) {
+                                FNEPeerConnection* connection = network->m_peers.find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
@@ -1071,8 +1089,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG) {   // Peer Diagnostic Log Transfer
                         if (network->m_allowDiagnosticTransfer) {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && network->m_peers.contains(peerId)) {
+                                FNEPeerConnection* connection = network->m_peers.find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
@@ -1120,8 +1138,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
             case NET_FUNC::ANNOUNCE:
                 {
                     if (req->fneHeader.getSubFunction() == NET_SUBFUNC::ANNC_SUBFUNC_GRP_AFFIL) {       // Announce Group Affiliation
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
                                 lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
@@ -1156,8 +1174,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::ANNC_SUBFUNC_UNIT_REG) {   // Announce Unit Registration
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
                                 lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
@@ -1190,8 +1208,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::ANNC_SUBFUNC_UNIT_DEREG) { // Announce Unit Deregistration
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
                                 lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
@@ -1224,8 +1242,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::ANNC_SUBFUNC_GRP_UNAFFIL) {    // Announce Group Affiliation Removal
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
                                 lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
@@ -1258,8 +1276,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::ANNC_SUBFUNC_AFFILS) {     // Announce Update All Affiliations
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
 
@@ -1306,8 +1324,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                     }
                     else if (req->fneHeader.getSubFunction() == NET_SUBFUNC::ANNC_SUBFUNC_SITE_VC) {    // Announce Site VCs
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
                             if (connection != nullptr) {
                                 std::string ip = udp::Socket::address(req->address);
 
@@ -1320,8 +1338,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                     uint32_t offs = 4U;
                                     for (uint32_t i = 0; i < len; i++) {
                                         uint32_t vcPeerId = __GET_UINT32(req->buffer, offs);
-                                        if (vcPeerId > 0 && (network->m_peers.find(vcPeerId) != network->m_peers.end())) {
-                                            FNEPeerConnection* vcConnection = network->m_peers[vcPeerId];
+                                        if (vcPeerId > 0 && network->m_peers.contains(vcPeerId)) {
+                                            FNEPeerConnection* vcConnection = network->m_peers.find(vcPeerId);
                                             if (vcConnection != nullptr) {
                                                 vcConnection->ccPeerId(peerId);
                                                 vcPeers.push_back(vcPeerId);
@@ -1330,7 +1348,10 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         offs += 4U;
                                     }
                                     LogMessage(LOG_NET, "PEER %u (%s) announced %u VCs", peerId, connection->identity().c_str(), len);
-                                    network->m_ccPeerMap[peerId] = vcPeers;
+                                    {
+                                        std::lock_guard<std::mutex> lock(network->m_ccPeerMapMutex);
+                                        network->m_ccPeerMap[peerId] = vcPeers;
+                                    }
 
                                     // attempt to repeat traffic to Peer-Link masters
                                     if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1357,14 +1378,35 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 }
                 break;
 
+            case NET_FUNC::PEER_LINK:
+                {
+                    if (req->fneHeader.getSubFunction() == NET_SUBFUNC::PL_XFER_ACK) {                  // Peer-Link Transfer Acknowledgement
+                        if (peerId > 0 && network->m_peers.contains(peerId)) {
+                            FNEPeerConnection* connection = network->m_peers.find(peerId);
+                            if (connection != nullptr) {
+                                std::string ip = udp::Socket::address(req->address);
+
+                                // validate peer (simple validation really)
+                                if (connection->connected() && connection->address() == ip && connection->isExternalPeer() && 
+                                    connection->isPeerLink()) {
+                                    network->processPeerLinkAck(peerId, req->buffer, req->length);
+                                }
+                            }
+                        }
+                    }
+                    else {
+                        network->writePeerNAK(peerId, TAG_PEER_LINK, NET_CONN_NAK_ILLEGAL_PACKET);
+                        Utils::dump("unknown Peer-Link opcode from the peer", req->buffer, req->length);
+                    }
+                }
+                break;
+
             default:
                 Utils::dump("unknown opcode from the peer", req->buffer, req->length);
                 break;
             }
         }
 
-        if (req->buffer != nullptr)
-            delete[] req->buffer;
         delete req;
     }
 
@@ -1423,16 +1465,12 @@ bool FNENetwork::erasePeerAffiliations(uint32_t peerId)
 
 bool FNENetwork::erasePeer(uint32_t peerId)
 {
-    std::lock_guard<std::mutex> lock(m_peerMutex);
-    {
-        auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-        if (it != m_peers.end()) {
-            m_peers.erase(peerId);
-        }
-    }
+    // the registry locks (and retires the connection) itself
+    m_peers.erase(peerId);
 
     // erase any CC maps for this peer
     {
+        std::lock_guard<std::mutex> lock(m_ccPeerMapMutex);
         auto it = std::find_if(m_ccPeerMap.begin(), m_ccPeerMap.end(), [&](auto x) { return x.first == peerId; });
         if (it != m_ccPeerMap.end()) {
             m_ccPeerMap.erase(peerId);
@@ -1441,12 +1479,13 @@ bool FNENetwork::erasePeer(uint32_t peerId)
 
     // erase any Peer-Link entries for this peer
     {
-        auto it = std::find_if(m_peerLinkPeers.begin(), m_peerLinkPeers.end(), [&](auto x) { return x.first == peerId; });
-        if (it != m_peerLinkPeers.end()) {
-            m_peerLinkPeers.erase(peerId);
-        }
+        std::lock_guard<std::mutex> lock(m_peerLinkPeersMutex);
+        m_peerLinkPeers.erase(peerId);
     }
 
+    // erase any Peer-Link transfers to this peer
+    erasePeerLinkTransfers(peerId);
+
     return true;
 }
 
@@ -1479,6 +1518,7 @@ json::object FNENetwork::fneConnObject(uint32_t peerId, FNEPeerConnection *conn)
     peerObj["config"].set<json::object>(peerConfig);
 
     json::array voiceChannels = json::array();
+    std::lock_guard<std::mutex> lock(m_ccPeerMapMutex);
     auto it = std::find_if(m_ccPeerMap.begin(), m_ccPeerMap.end(), [&](auto x) { return x.first == peerId; });
     if (it != m_ccPeerMap.end()) {
         std::vector<uint32_t> vcPeers = m_ccPeerMap[peerId];
@@ -1491,12 +1531,43 @@ json::object FNENetwork::fneConnObject(uint32_t peerId, FNEPeerConnection *conn)
     return peerObj;
 }
 
+/* Helper to create the Peer-Link active peer list entry of a FNE peer connection. */
+
+PeerLinkPeer FNENetwork::fnePeerLinkPeer(uint32_t peerId, FNEPeerConnection *conn)
+{
+    PeerLinkPeer peer;
+    peer.peerId = peerId;
+    peer.address = conn->address();
+    peer.port = conn->port();
+    peer.connected = conn->connected();
+    peer.connectionState = (uint8_t)conn->connectionState();
+    peer.pingsReceived = conn->pingsReceived();
+    peer.lastPing = conn->lastPing();
+    peer.ccPeerId = conn->ccPeerId();
+
+    json::object peerConfig = conn->config();
+    if (peerConfig["rcon"].is<json::object>())
+        peerConfig.erase("rcon");
+    peer.config = json::value(peerConfig).serialize();
+
+    {
+        std::lock_guard<std::mutex> lock(m_ccPeerMapMutex);
+        auto it = m_ccPeerMap.find(peerId);
+        if (it != m_ccPeerMap.end()) {
+            peer.voiceChannels = it->second;
+        }
+    }
+
+    return peer;
+}
+
 /* Helper to reset a peer connection. */
 
 bool FNENetwork::resetPeer(uint32_t peerId)
 {
-    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-        FNEPeerConnection* connection = m_peers[peerId];
+    FNEPeerRegistry::ReadGuard guard(m_peers);
+    if (peerId > 0 && m_peers.contains(peerId)) {
+        FNEPeerConnection* connection = m_peers.find(peerId);
         if (connection != nullptr) {
             sockaddr_storage addr = connection->socketStorage();
             uint32_t addrLen = connection->sockStorageLen();
@@ -1505,7 +1576,6 @@ bool FNENetwork::resetPeer(uint32_t peerId)
 
             writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_RESET, addr, addrLen);
 
-            delete connection;
             erasePeer(peerId);
 
             return true;
@@ -1520,13 +1590,10 @@ bool FNENetwork::resetPeer(uint32_t peerId)
 
 std::string FNENetwork::resolvePeerIdentity(uint32_t peerId)
 {
-    std::lock_guard<std::mutex> lock(m_peerMutex);
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        if (it->second != nullptr) {
-            FNEPeerConnection* peer = it->second;
-            return peer->identity();
-        }
+    FNEPeerRegistry::ReadGuard guard(m_peers);
+    FNEPeerConnection* peer = m_peers.find(peerId);
+    if (peer != nullptr) {
+        return peer->identity();
     }
 
     return std::string();
@@ -1542,7 +1609,7 @@ void FNENetwork::setupRepeaterLogin(uint32_t peerId, FNEPeerConnection* connecti
     LogInfoEx(LOG_NET, "PEER %u started login from, %s:%u", peerId, connection->address().c_str(), connection->port());
 
     connection->connectionState(NET_STAT_WAITING_AUTHORISATION);
-    m_peers[peerId] = connection;
+    m_peers.insert(peerId, connection);
 
     // transmit salt to peer
     uint8_t salt[4U];
@@ -1592,9 +1659,12 @@ void* FNENetwork::threadedACLUpdate(void* arg)
             return nullptr;
         }
 
+        // peer connections used by this thread stay valid until it completes
+        FNEPeerRegistry::ReadGuard guard(network->m_peers);
+
         std::string peerIdentity = network->resolvePeerIdentity(req->peerId);
 
-        FNEPeerConnection* connection = network->m_peers[req->peerId];
+        FNEPeerConnection* connection = network->m_peers.find(req->peerId);
         if (connection != nullptr) {
             // if the connection is an external peer, and peer is participating in peer link,
             // send the peer proper configuration data
@@ -1604,8 +1674,11 @@ void* FNENetwork::threadedACLUpdate(void* arg)
                 network->writeWhitelistRIDs(req->peerId, true);
                 network->writeTGIDs(req->peerId, true);
 
-                connection->pktLastSeq(RTP_END_OF_CALL_SEQ - 1U);
-                network->writePeerList(req->peerId);
+                // SysView has no use for the peer list
+                if (!connection->isSysView()) {
+                    connection->pktLastSeq(RTP_END_OF_CALL_SEQ - 1U);
+                    network->writePeerList(req->peerId);
+                }
             }
             else {
                 LogInfoEx(LOG_NET, "PEER %u (%s) sending ACL list updates", req->peerId, peerIdentity.c_str());
@@ -1633,7 +1706,7 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, bool isExternalPeer)
 
     // sending PEER_LINK style RID list to external peers
     if (isExternalPeer) {
-        FNEPeerConnection* connection = m_peers[peerId];
+        FNEPeerConnection* connection = m_peers.find(peerId);
         if (connection != nullptr) {
             std::string filename = m_ridLookup->filename();
             if (filename.empty()) {
@@ -1658,82 +1731,7 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, bool isExternalPeer)
             ::memset(buffer, 0x00U, len);
             ::memcpy(buffer, b.str().data(), len);
 
-            // compression structures
-            z_stream strm;
-            strm.zalloc = Z_NULL;
-            strm.zfree = Z_NULL;
-            strm.opaque = Z_NULL;
-
-            // initialize compression
-            if (deflateInit(&strm, Z_DEFAULT_COMPRESSION) != Z_OK) {
-                LogError(LOG_NET, "PEER %u (%s) error initializing ZLIB", peerId, connection->identity().c_str());
-                return;
-            }
-
-            // set input data
-            strm.avail_in = len;
-            strm.next_in = buffer;
-
-            // compress data
-            std::vector<uint8_t> compressedData;
-            int ret;
-            do {
-                // resize the output buffer as needed
-                compressedData.resize(compressedData.size() + 16384);
-                strm.avail_out = 16384;
-                strm.next_out = compressedData.data() + compressedData.size() - 16384;
-
-                ret = deflate(&strm, Z_FINISH);
-                if (ret == Z_STREAM_ERROR) {
-                    LogError(LOG_NET, "PEER %u (%s) error compressing TGID list", peerId, connection->identity().c_str());
-                    deflateEnd(&strm);
-                    return;
-                }
-            } while (ret != Z_STREAM_END);
-
-            // resize the output buffer to the actual compressed data size
-            compressedData.resize(strm.total_out);
-
-            // cleanup
-            deflateEnd(&strm);
-
-            uint32_t compressedLen = strm.total_out;
-            uint8_t* compressed = compressedData.data();
-
-            // Utils::dump(1U, "Compressed Payload", compressed, compressedLen);
-
-            // transmit TGIDs
-            uint8_t blockCnt = (compressedLen / PEER_LINK_BLOCK_SIZE) + (compressedLen % PEER_LINK_BLOCK_SIZE ? 1U : 0U);
-            uint32_t offs = 0U;
-            for (uint8_t i = 0U; i < blockCnt; i++) {
-                // build dataset
-                uint16_t bufSize = 10U + (PEER_LINK_BLOCK_SIZE);
-                UInt8Array __payload = std::make_unique<uint8_t[]>(bufSize);
-                uint8_t* payload = __payload.get();
-                ::memset(payload, 0x00U, bufSize);
-
-                if (i == 0U) {
-                    __SET_UINT32(len, payload, 0U);
-                    __SET_UINT32(compressedLen, payload, 4U);
-                }
-
-                payload[8U] = i;
-                payload[9U] = blockCnt - 1U;
-
-                uint32_t blockSize = PEER_LINK_BLOCK_SIZE;
-                if (offs + PEER_LINK_BLOCK_SIZE > compressedLen)
-                    blockSize = PEER_LINK_BLOCK_SIZE - ((offs + PEER_LINK_BLOCK_SIZE) - compressedLen);
-
-                ::memcpy(payload + 10U, compressed + offs, blockSize);
-
-                if (m_debug)
-                    Utils::dump(1U, "Peer-Link RID Block Payload", payload, bufSize);
-
-                offs += PEER_LINK_BLOCK_SIZE;
-
-                writePeer(peerId, { NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_RID_LIST }, 
-                    payload, bufSize, 0U, false, true, true);
-            }
+            writePeerLinkTransfer(peerId, NET_SUBFUNC::PL_RID_LIST, buffer, len);
 
             connection->lastPing(now);
         }
@@ -1757,7 +1755,7 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, bool isExternalPeer)
     }
 
     // send a chunk of RIDs to the peer
-    FNEPeerConnection* connection = m_peers[peerId];
+    FNEPeerConnection* connection = m_peers.find(peerId);
     if (connection != nullptr) {
         uint32_t chunkCnt = (ridWhitelist.size() / MAX_RID_LIST_CHUNK) + 1U;
         for (uint32_t i = 0U; i < chunkCnt; i++) {
@@ -1831,7 +1829,7 @@ void FNENetwork::writeBlacklistRIDs(uint32_t peerId)
     }
 
     // send a chunk of RIDs to the peer
-    FNEPeerConnection* connection = m_peers[peerId];
+    FNEPeerConnection* connection = m_peers.find(peerId);
     if (connection != nullptr) {
         uint32_t chunkCnt = (ridBlacklist.size() / MAX_RID_LIST_CHUNK) + 1U;
         for (uint32_t i = 0U; i < chunkCnt; i++) {
@@ -1895,7 +1893,7 @@ void FNENetwork::writeTGIDs(uint32_t peerId, bool isExternalPeer)
 
     // sending PEER_LINK style TGID list to external peers
     if (isExternalPeer) {
-        FNEPeerConnection* connection = m_peers[peerId];
+        FNEPeerConnection* connection = m_peers.find(peerId);
         if (connection != nullptr) {
             std::string filename = m_tidLookup->filename();
             if (filename.empty()) {
@@ -1920,82 +1918,7 @@ void FNENetwork::writeTGIDs(uint32_t peerId, bool isExternalPeer)
             ::memset(buffer, 0x00U, len);
             ::memcpy(buffer, b.str().data(), len);
 
-            // compression structures
-            z_stream strm;
-            strm.zalloc = Z_NULL;
-            strm.zfree = Z_NULL;
-            strm.opaque = Z_NULL;
-
-            // initialize compression
-            if (deflateInit(&strm, Z_DEFAULT_COMPRESSION) != Z_OK) {
-                LogError(LOG_NET, "PEER %u (%s) error initializing ZLIB", peerId, connection->identity().c_str());
-                return;
-            }
-
-            // set input data
-            strm.avail_in = len;
-            strm.next_in = buffer;
-
-            // compress data
-            std::vector<uint8_t> compressedData;
-            int ret;
-            do {
-                // resize the output buffer as needed
-                compressedData.resize(compressedData.size() + 16384);
-                strm.avail_out = 16384;
-                strm.next_out = compressedData.data() + compressedData.size() - 16384;
-
-                ret = deflate(&strm, Z_FINISH);
-                if (ret == Z_STREAM_ERROR) {
-                    LogError(LOG_NET, "PEER %u (%s) error compressing TGID list", peerId, connection->identity().c_str());
-                    deflateEnd(&strm);
-                    return;
-                }
-            } while (ret != Z_STREAM_END);
-
-            // resize the output buffer to the actual compressed data size
-            compressedData.resize(strm.total_out);
-
-            // cleanup
-            deflateEnd(&strm);
-
-            uint32_t compressedLen = strm.total_out;
-            uint8_t* compressed = compressedData.data();
-
-            // Utils::dump(1U, "Compressed Payload", compressed, compressedLen);
-
-            // transmit TGIDs
-            uint8_t blockCnt = (compressedLen / PEER_LINK_BLOCK_SIZE) + (compressedLen % PEER_LINK_BLOCK_SIZE ? 1U : 0U);
-            uint32_t offs = 0U;
-            for (uint8_t i = 0U; i < blockCnt; i++) {
-                // build dataset
-                uint16_t bufSize = 10U + (PEER_LINK_BLOCK_SIZE);
-                UInt8Array __payload = std::make_unique<uint8_t[]>(bufSize);
-                uint8_t* payload = __payload.get();
-                ::memset(payload, 0x00U, bufSize);
-
-                if (i == 0U) {
-                    __SET_UINT32(len, payload, 0U);
-                    __SET_UINT32(compressedLen, payload, 4U);
-                }
-
-                payload[8U] = i;
-                payload[9U] = blockCnt - 1U;
-
-                uint32_t blockSize = PEER_LINK_BLOCK_SIZE;
-                if (offs + PEER_LINK_BLOCK_SIZE > compressedLen)
-                    blockSize = PEER_LINK_BLOCK_SIZE - ((offs + PEER_LINK_BLOCK_SIZE) - compressedLen);
-
-                ::memcpy(payload + 10U, compressed + offs, blockSize);
-
-                if (m_debug)
-                    Utils::dump(1U, "Peer-Link TGID Block Payload", payload, bufSize);
-
-                offs += PEER_LINK_BLOCK_SIZE;
-
-                writePeer(peerId, { NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_TALKGROUP_LIST }, 
-                    payload, bufSize, 0U, false, true, true);
-            }
+            writePeerLinkTransfer(peerId, NET_SUBFUNC::PL_TALKGROUP_LIST, buffer, len);
 
             connection->lastPing(now);
         }
@@ -2150,7 +2073,7 @@ void FNENetwork::writePeerList(uint32_t peerId)
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
     // sending PEER_LINK style RID list to external peers
-    FNEPeerConnection* connection = m_peers[peerId];
+    FNEPeerConnection* connection = m_peers.find(peerId);
     if (connection != nullptr) {
         std::string filename = m_peerListLookup->filename();
         if (filename.empty()) {
@@ -2175,87 +2098,130 @@ void FNENetwork::writePeerList(uint32_t peerId)
         ::memset(buffer, 0x00U, len);
         ::memcpy(buffer, b.str().data(), len);
 
-        // compression structures
-        z_stream strm;
-        strm.zalloc = Z_NULL;
-        strm.zfree = Z_NULL;
-        strm.opaque = Z_NULL;
+        writePeerLinkTransfer(peerId, NET_SUBFUNC::PL_PEER_LIST, buffer, len);
+
+        connection->lastPing(now);
+    }
+
+    return;
+}
+
+/* Helper to start (or resume) a windowed Peer-Link transfer to the specified peer. */
+
+void FNENetwork::writePeerLinkTransfer(uint32_t peerId, uint8_t subFunc, const uint8_t* data, uint32_t length)
+{
+    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    PeerLinkTransmitter* xfer = new PeerLinkTransmitter(subFunc);
+    if (!xfer->setData(data, length)) {
+        LogError(LOG_NET, "PEER %u error preparing Peer-Link transfer, subFunc = $%02X", peerId, subFunc);
+        delete xfer;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_peerLinkXferMutex);
 
-        // initialize compression
-        if (deflateInit(&strm, Z_DEFAULT_COMPRESSION) != Z_OK) {
-            LogError(LOG_NET, "PEER %u (%s) error initializing ZLIB", peerId, connection->identity().c_str());
+    PeerLinkXferKey key = PeerLinkXferKey(peerId, subFunc);
+    auto it = m_peerLinkXfers.find(key);
+    if (it != m_peerLinkXfers.end()) {
+        // the same data is already on its way, leave it be
+        if (it->second->transferId() == xfer->transferId()) {
+            delete xfer;
             return;
         }
 
-        // set input data
-        strm.avail_in = len;
-        strm.next_in = buffer;
-
-        // compress data
-        std::vector<uint8_t> compressedData;
-        int ret;
-        do {
-            // resize the output buffer as needed
-            compressedData.resize(compressedData.size() + 16384);
-            strm.avail_out = 16384;
-            strm.next_out = compressedData.data() + compressedData.size() - 16384;
-
-            ret = deflate(&strm, Z_FINISH);
-            if (ret == Z_STREAM_ERROR) {
-                LogError(LOG_NET, "PEER %u (%s) error compressing TGID list", peerId, connection->identity().c_str());
-                deflateEnd(&strm);
-                return;
-            }
-        } while (ret != Z_STREAM_END);
-
-        // resize the output buffer to the actual compressed data size
-        compressedData.resize(strm.total_out);
+        delete it->second;
+        m_peerLinkXfers.erase(it);
+    }
 
-        // cleanup
-        deflateEnd(&strm);
+    if (m_debug)
+        LogDebug(LOG_NET, "PEER %u Peer-Link transfer, subFunc = $%02X, transferId = $%08X, len = %u, blockCnt = %u", peerId, subFunc,
+            xfer->transferId(), xfer->length(), xfer->blockCount());
+
+    m_peerLinkXfers[key] = xfer;
+    xfer->start(now);
+    xfer->clock(now, [=](const uint8_t* block, uint32_t blockLen) {
+        return writePeer(peerId, { NET_FUNC::PEER_LINK, (NET_SUBFUNC::ENUM)subFunc }, block, blockLen, 0U, false, true, true);
+    });
+}
 
-        uint32_t compressedLen = strm.total_out;
-        uint8_t* compressed = compressedData.data();
+/* Helper to process a Peer-Link transfer acknowledgement from the specified peer. */
 
-        // Utils::dump(1U, "Compressed Payload", compressed, compressedLen);
+void FNENetwork::processPeerLinkAck(uint32_t peerId, const uint8_t* data, uint32_t length)
+{
+    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
-        // transmit TGIDs
-        uint8_t blockCnt = (compressedLen / PEER_LINK_BLOCK_SIZE) + (compressedLen % PEER_LINK_BLOCK_SIZE ? 1U : 0U);
-        uint32_t offs = 0U;
-        for (uint8_t i = 0U; i < blockCnt; i++) {
-            // build dataset
-            uint16_t bufSize = 10U + (PEER_LINK_BLOCK_SIZE);
-            UInt8Array __payload = std::make_unique<uint8_t[]>(bufSize);
-            uint8_t* payload = __payload.get();
-            ::memset(payload, 0x00U, bufSize);
+    if (length < PEER_LINK_XFER_ACK_LENGTH)
+        return;
 
-            if (i == 0U) {
-                __SET_UINT32(len, payload, 0U);
-                __SET_UINT32(compressedLen, payload, 4U);
-            }
+    std::lock_guard<std::mutex> lock(m_peerLinkXferMutex);
 
-            payload[8U] = i;
-            payload[9U] = blockCnt - 1U;
+    auto it = m_peerLinkXfers.find(PeerLinkXferKey(peerId, data[0U]));
+    if (it == m_peerLinkXfers.end())
+        return;
 
-            uint32_t blockSize = PEER_LINK_BLOCK_SIZE;
-            if (offs + PEER_LINK_BLOCK_SIZE > compressedLen)
-                blockSize = PEER_LINK_BLOCK_SIZE - ((offs + PEER_LINK_BLOCK_SIZE) - compressedLen);
+    PeerLinkTransmitter* xfer = it->second;
+    if (!xfer->processAck(data, length, now))
+        return;
 
-            ::memcpy(payload + 10U, compressed + offs, blockSize);
+    if (xfer->isComplete()) {
+        LogInfoEx(LOG_NET, "PEER %u Peer-Link transfer complete, subFunc = $%02X, transferId = $%08X, blockCnt = %u, retransmits = %u", 
+            peerId, xfer->subFunc(), xfer->transferId(), xfer->blockCount(), xfer->retransmits());
+        delete xfer;
+        m_peerLinkXfers.erase(it);
+        return;
+    }
 
-            if (m_debug)
-                Utils::dump(1U, "Peer-Link Peer List Block Payload", payload, bufSize);
+    // acknowledgements open the window, send what is now due
+    uint8_t subFunc = xfer->subFunc();
+    xfer->clock(now, [=](const uint8_t* block, uint32_t blockLen) {
+        return writePeer(peerId, { NET_FUNC::PEER_LINK, (NET_SUBFUNC::ENUM)subFunc }, block, blockLen, 0U, false, true, true);
+    });
+}
 
-            offs += PEER_LINK_BLOCK_SIZE;
+/* Helper to retransmit Peer-Link transfer blocks and expire stalled transfers. */
 
-            writePeer(peerId, { NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_PEER_LIST }, 
-                payload, bufSize, 0U, false, true, true);
+void FNENetwork::clockPeerLinkTransfers(uint64_t now)
+{
+    std::lock_guard<std::mutex> lock(m_peerLinkXferMutex);
+
+    for (auto it = m_peerLinkXfers.begin(); it != m_peerLinkXfers.end();) {
+        uint32_t peerId = it->first.first;
+        PeerLinkTransmitter* xfer = it->second;
+
+        if (xfer->hasFailed(now)) {
+            // the receiver keeps what it has, the next ACL update resumes from there
+            LogWarning(LOG_NET, "PEER %u Peer-Link transfer failed, subFunc = $%02X, transferId = $%08X, block %u of %u", 
+                peerId, xfer->subFunc(), xfer->transferId(), xfer->base(), xfer->blockCount());
+            delete xfer;
+            it = m_peerLinkXfers.erase(it);
+            continue;
         }
 
-        connection->lastPing(now);
+        uint8_t subFunc = xfer->subFunc();
+        xfer->clock(now, [=](const uint8_t* block, uint32_t blockLen) {
+            return writePeer(peerId, { NET_FUNC::PEER_LINK, (NET_SUBFUNC::ENUM)subFunc }, block, blockLen, 0U, false, true, true);
+        });
+
+        ++it;
     }
+}
 
-    return;
+/* Helper to erase any Peer-Link transfers to the specified peer. */
+
+void FNENetwork::erasePeerLinkTransfers(uint32_t peerId)
+{
+    std::lock_guard<std::mutex> lock(m_peerLinkXferMutex);
+
+    for (auto it = m_peerLinkXfers.begin(); it != m_peerLinkXfers.end();) {
+        if (it->first.first == peerId) {
+            delete it->second;
+            it = m_peerLinkXfers.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
 }
 
 /* Helper to send a data message to the specified peer. */
@@ -2263,26 +2229,48 @@ void FNENetwork::writePeerList(uint32_t peerId)
 bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data,
     uint32_t length, uint16_t pktSeq, uint32_t streamId, bool queueOnly, bool directWrite) const
 {
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        FNEPeerConnection* connection = m_peers.at(peerId);
-        if (connection != nullptr) {
-            uint32_t peerStreamId = connection->currStreamId();
-            if (streamId == 0U) {
-                streamId = peerStreamId;
-            }
-            sockaddr_storage addr = connection->socketStorage();
-            uint32_t addrLen = connection->sockStorageLen();
+    FNEPeerRegistry::ReadGuard guard(m_peers);
+    FNEPeerConnection* connection = m_peers.find(peerId);
+    if (connection != nullptr) {
+        uint32_t peerStreamId = connection->currStreamId();
+        if (streamId == 0U) {
+            streamId = peerStreamId;
+        }
+        sockaddr_storage addr = connection->socketStorage();
+        uint32_t addrLen = connection->sockStorageLen();
 
-            if (directWrite)
-                return m_frameQueue->write(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
-            else {
-                m_frameQueue->enqueueMessage(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
-                if (queueOnly)
-                    return true;
-                return m_frameQueue->flushQueue();
-            }
+        if (directWrite)
+            return m_frameQueue->write(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
+        else {
+            m_frameQueue->enqueueMessage(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
+            if (queueOnly)
+                return true;
+            return m_frameQueue->flushQueue();
+        }
+    }
+
+    return false;
+}
+
+/* Helper to send a shared data message to the specified peer. */
+
+bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const PacketBuffer& data,
+    uint16_t pktSeq, uint32_t streamId, bool queueOnly) const
+{
+    FNEPeerRegistry::ReadGuard guard(m_peers);
+    FNEPeerConnection* connection = m_peers.find(peerId);
+    if (connection != nullptr) {
+        uint32_t peerStreamId = connection->currStreamId();
+        if (streamId == 0U) {
+            streamId = peerStreamId;
         }
+        sockaddr_storage addr = connection->socketStorage();
+        uint32_t addrLen = connection->sockStorageLen();
+
+        m_frameQueue->enqueueMessage(data, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
+        if (queueOnly)
+            return true;
+        return m_frameQueue->flushQueue();
     }
 
     return false;
@@ -2293,17 +2281,15 @@ bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const
 bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data,
     uint32_t length, uint32_t streamId, bool queueOnly, bool incPktSeq, bool directWrite) const
 {
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        FNEPeerConnection* connection = m_peers.at(peerId);
-        if (connection != nullptr) {
-            if (incPktSeq) {
-                connection->pktLastSeq(connection->pktLastSeq() + 1);
-            }
-            uint16_t pktSeq = connection->pktLastSeq();
-
-            return writePeer(peerId, opcode, data, length, pktSeq, streamId, queueOnly, directWrite);
+    FNEPeerRegistry::ReadGuard guard(m_peers);
+    FNEPeerConnection* connection = m_peers.find(peerId);
+    if (connection != nullptr) {
+        if (incPktSeq) {
+            connection->pktLastSeq(connection->pktLastSeq() + 1);
         }
+        uint16_t pktSeq = connection->pktLastSeq();
+
+        return writePeer(peerId, opcode, data, length, pktSeq, streamId, queueOnly, directWrite);
     }
 
     return false;
@@ -27,6 +27,10 @@
 #include "fne/Defines.h"
 #include "common/network/BaseNetwork.h"
 #include "common/network/json/json.h"
+#include "common/network/PeerLinkPeers.h"
+#include "common/network/PeerLinkTransfer.h"
+#include "common/network/PeerRegistry.h"
+#include "common/SlabAllocator.h"
 #include "common/lookups/AffiliationLookup.h"
 #include "common/lookups/RadioIdLookup.h"
 #include "common/lookups/TalkgroupRulesLookup.h"
@@ -36,7 +40,9 @@
 
 #include <string>
 #include <cstdint>
+#include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 
 // ---------------------------------------------------------------------------
@@ -266,6 +272,8 @@ namespace network
      */
     struct ACLUpdateRequest : thread_t {
         uint32_t peerId;        //! Peer ID for this request.
+
+        __SLAB_ALLOCATED
     };
 
     // ---------------------------------------------------------------------------
@@ -285,8 +293,13 @@ namespace network
         frame::RTPFNEHeader fneHeader;      //! RTP FNE Header
         int length = 0U;                    //! Length of raw data buffer
         uint8_t *buffer;                    //! Raw data buffer
+        PacketBuffer packet;                //! Packet buffer (backing the raw data buffer)
+
+        __SLAB_ALLOCATED
     };
 
+    typedef PeerRegistry<FNEPeerConnection> FNEPeerRegistry;
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
@@ -396,6 +409,13 @@ namespace network
          * @return json::object 
          */
         json::object fneConnObject(uint32_t peerId, FNEPeerConnection *conn);
+        /**
+         * @brief Helper to create the Peer-Link active peer list entry of a FNE peer connection.
+         * @param peerId Peer ID.
+         * @param conn FNE Peer Connection.
+         * @return PeerLinkPeer
+         */
+        PeerLinkPeer fnePeerLinkPeer(uint32_t peerId, FNEPeerConnection *conn);
 
         /**
          * @brief Helper to reset a peer connection.
@@ -439,13 +459,21 @@ namespace network
         NET_CONN_STATUS m_status;
 
         static std::mutex m_peerMutex;
-        typedef std::pair<const uint32_t, network::FNEPeerConnection*> PeerMapPair;
-        std::unordered_map<uint32_t, FNEPeerConnection*> m_peers;
-        std::unordered_map<uint32_t, json::array> m_peerLinkPeers;
+        FNEPeerRegistry m_peers;
+        std::mutex m_peerLinkPeersMutex;
+        std::unordered_map<uint32_t, PeerLinkPeersDecoder> m_peerLinkPeers;
         typedef std::pair<const uint32_t, lookups::AffiliationLookup*> PeerAffiliationMapPair;
         std::unordered_map<uint32_t, lookups::AffiliationLookup*> m_peerAffiliations;
+        std::mutex m_ccPeerMapMutex;
         std::unordered_map<uint32_t, std::vector<uint32_t>> m_ccPeerMap;
 
+        std::mutex m_peerLinkXferMutex;
+        typedef std::pair<uint32_t, uint8_t> PeerLinkXferKey;
+        std::map<PeerLinkXferKey, PeerLinkTransmitter*> m_peerLinkXfers;
+
+        PeerLinkPeersEncoder m_peerLinkPeerEncoder;
+        std::unordered_set<uint32_t> m_peerLinkRunning;
+
         Timer m_maintainenceTimer;
 
         uint32_t m_updateLookupTime;
@@ -568,6 +596,32 @@ namespace network
          */
         void writePeerList(uint32_t peerId);
 
+        /**
+         * @brief Helper to start (or resume) a windowed Peer-Link transfer to the specified peer.
+         * @param peerId Peer ID.
+         * @param subFunc Peer-Link subfunction (table) being transferred.
+         * @param[in] data Buffer containing the data to transfer.
+         * @param length Length of buffer.
+         */
+        void writePeerLinkTransfer(uint32_t peerId, uint8_t subFunc, const uint8_t* data, uint32_t length);
+        /**
+         * @brief Helper to process a Peer-Link transfer acknowledgement from the specified peer.
+         * @param peerId Peer ID.
+         * @param[in] data Buffer containing the acknowledgement.
+         * @param length Length of buffer.
+         */
+        void processPeerLinkAck(uint32_t peerId, const uint8_t* data, uint32_t length);
+        /**
+         * @brief Helper to retransmit Peer-Link transfer blocks and expire stalled transfers.
+         * @param now Current time (ms).
+         */
+        void clockPeerLinkTransfers(uint64_t now);
+        /**
+         * @brief Helper to erase any Peer-Link transfers to the specified peer.
+         * @param peerId Peer ID.
+         */
+        void erasePeerLinkTransfers(uint32_t peerId);
+
         /**
          * @brief Helper to send a data message to the specified peer.
          * @param peerId Peer ID.
@@ -581,6 +635,20 @@ namespace network
          */
         bool writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, 
             uint16_t pktSeq, uint32_t streamId, bool queueOnly = false, bool directWrite = false) const;
+        /**
+         * @brief Helper to send a shared data message to the specified peer.
+         * 
+         *  The message is referenced by the queued datagram rather than copied, so the same packet
+         *  buffer may be sent to any number of peers.
+         * @param peerId Peer ID.
+         * @param opcode FNE network opcode pair.
+         * @param data Packet buffer containing message to send to peer.
+         * @param pktSeq RTP packet sequence for this message.
+         * @param streamId Stream ID for this message.
+         * @param queueOnly Flag indicating this message should be queued for transmission.
+         */
+        bool writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const PacketBuffer& data,
+            uint16_t pktSeq, uint32_t streamId, bool queueOnly = false) const;
         /**
          * @brief Helper to send a data message to the specified peer.
          * @param peerId Peer ID.
@@ -9,7 +9,6 @@
  */
 #include "fne/Defines.h"
 #include "common/network/json/json.h"
-#include "common/zlib/zlib.h"
 #include "common/Utils.h"
 #include "fne/network/PeerNetwork.h"
 
@@ -33,15 +32,9 @@ PeerNetwork::PeerNetwork(const std::string& address, uint16_t port, uint16_t loc
     m_blockTrafficToTable(),
     m_pidLookup(nullptr),
     m_peerLink(false),
-    m_tgidCompressedSize(0U),
-    m_tgidSize(0U),
-    m_tgidBuffer(nullptr),
-    m_ridCompressedSize(0U),
-    m_ridSize(0U),
-    m_ridBuffer(nullptr),
-    m_pidCompressedSize(0U),
-    m_pidSize(0U),
-    m_pidBuffer(nullptr)
+    m_tgidXfer(NET_SUBFUNC::PL_TALKGROUP_LIST),
+    m_ridXfer(NET_SUBFUNC::PL_RID_LIST),
+    m_pidXfer(NET_SUBFUNC::PL_PEER_LIST)
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -72,30 +65,23 @@ bool PeerNetwork::checkBlockedPeer(uint32_t peerId)
     return false;
 }
 
-/* Writes a complete update of this CFNE's active peer list to the network. */
+/* Writes an update of this CFNE's active peer list to the network. */
 
-bool PeerNetwork::writePeerLinkPeers(json::array* peerList)
+bool PeerNetwork::writePeerLinkPeers(const std::vector<std::vector<uint8_t>>& messages)
 {
-    if (peerList == nullptr)
+    if (messages.size() == 0)
         return false;
-    if (peerList->size() == 0)
+    if (!m_peerLink)
         return false;
 
-    if (peerList->size() > 0 && m_peerLink) {
-        json::value v = json::value(*peerList);
-        std::string json = std::string(v.serialize());
-
-        CharArray __buffer = std::make_unique<char[]>(json.length() + 9U);
-        char* buffer = __buffer.get();
-
-        ::memcpy(buffer + 0U, TAG_PEER_LINK, 4U);
-        ::snprintf(buffer + 8U, json.length() + 1U, "%s", json.c_str());
-
-        return writeMaster({ NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_ACT_PEER_LIST }, 
-            (uint8_t*)buffer, json.length() + 8U, RTP_END_OF_CALL_SEQ, createStreamId(), false, true);
+    bool ret = true;
+    for (const std::vector<uint8_t>& message : messages) {
+        if (!writeMaster({ NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_ACT_PEER_LIST }, 
+            message.data(), message.size(), RTP_END_OF_CALL_SEQ, createStreamId(), false, true))
+            ret = false;
     }
 
-    return false;
+    return ret;
 }
 
 // ---------------------------------------------------------------------------
@@ -112,412 +98,94 @@ void PeerNetwork::userPacketHandler(uint32_t peerId, FrameQueue::OpcodePair opco
         switch (opcode.second) {
         case NET_SUBFUNC::PL_TALKGROUP_LIST:
         {
-            uint8_t curBlock = data[8U];
-            uint8_t blockCnt = data[9U];
-
-            // if this is the first block store sizes and initialize temp buffer
-            if (curBlock == 0U) {
-                m_tgidSize = __GET_UINT32(data, 0U);
-                m_tgidCompressedSize = __GET_UINT32(data, 4U);
-
-                if (m_tgidBuffer != nullptr)
-                    delete[] m_tgidBuffer;
-                if (m_tgidSize < PEER_LINK_BLOCK_SIZE)
-                    m_tgidBuffer = new uint8_t[PEER_LINK_BLOCK_SIZE + 1U];
-                else 
-                    m_tgidBuffer = new uint8_t[m_tgidSize + 1U];
+            if (processPeerLinkBlock(peerId, m_tgidXfer, data, length) != PeerLinkReceiver::XFER_COMPLETE)
+                break;
+
+            std::vector<uint8_t> decompressed = m_tgidXfer.takeData();
+            // Utils::dump(1U, "Raw TGID Data", decompressed.data(), decompressed.size());
+
+            if (m_tidLookup == nullptr) {
+                LogError(LOG_NET, "Talkgroup ID lookup not available yet.");
+                break;
             }
 
-            if (m_tgidBuffer != nullptr) {
-                if (curBlock < blockCnt) {
-                    uint32_t offs = curBlock * PEER_LINK_BLOCK_SIZE;
-                    ::memcpy(m_tgidBuffer + offs, data + 10U, PEER_LINK_BLOCK_SIZE);
-                    // Utils::dump(1U, "Block Payload", data, 10U + PEER_LINK_BLOCK_SIZE);
-                } else {
-                    uint32_t offs = curBlock * PEER_LINK_BLOCK_SIZE;
-                    ::memcpy(m_tgidBuffer + offs, data + 10U, PEER_LINK_BLOCK_SIZE);
-
-                    // Utils::dump(1U, "Block Payload", data, 10U + PEER_LINK_BLOCK_SIZE);
-                    // Utils::dump(1U, "Compressed Payload", m_tgidBuffer, m_tgidCompressedSize);
-
-                    // handle last block
-                    // compression structures
-                    z_stream strm;
-                    strm.zalloc = Z_NULL;
-                    strm.zfree = Z_NULL;
-                    strm.opaque = Z_NULL;
-
-                    // set input data
-                    strm.avail_in = m_tgidCompressedSize;
-                    strm.next_in = m_tgidBuffer;
-
-                    // initialize decompression
-                    int ret = inflateInit(&strm);
-                    if (ret != Z_OK) {
-                        LogError(LOG_NET, "PEER %u error initializing ZLIB", peerId);
-
-                        m_tgidSize = 0U;
-                        m_tgidCompressedSize = 0U;
-                        if (m_tgidBuffer != nullptr)
-                            delete[] m_tgidBuffer;
-                        m_tgidBuffer = nullptr;
-                        break;
-                    }
-
-                    // decompress data
-                    std::vector<uint8_t> decompressedData;
-                    uint8_t outbuffer[1024];
-                    do {
-                        strm.avail_out = sizeof(outbuffer);
-                        strm.next_out = outbuffer;
-
-                        ret = inflate(&strm, Z_NO_FLUSH);
-                        if (ret == Z_STREAM_ERROR) {
-                            LogError(LOG_NET, "PEER %u error decompressing TGID list", peerId);
-                            inflateEnd(&strm);
-                            goto tid_lookup_cleanup; // yes - I hate myself; but this is quick
-                        }
-
-                        decompressedData.insert(decompressedData.end(), outbuffer, outbuffer + sizeof(outbuffer) - strm.avail_out);
-                    } while (ret != Z_STREAM_END);
-
-                    // cleanup
-                    inflateEnd(&strm);
-
-                    // scope is intentional
-                    {
-                        uint32_t decompressedLen = strm.total_out;
-                        uint8_t* decompressed = decompressedData.data();
-
-                        // Utils::dump(1U, "Raw TGID Data", decompressed, decompressedLen);
-
-                        // check that we got the appropriate data
-                        if (decompressedLen == m_tgidSize) {
-                            if (m_tidLookup == nullptr) {
-                                LogError(LOG_NET, "Talkgroup ID lookup not available yet.");
-                                goto tid_lookup_cleanup; // yes - I hate myself; but this is quick
-                            }
-
-                            // store to file
-                            std::unique_ptr<char[]> __str = std::make_unique<char[]>(decompressedLen + 1U);
-                            char* str = __str.get();
-                            ::memcpy(str, decompressed, decompressedLen);
-                            str[decompressedLen] = 0; // null termination
-
-                            // randomize filename
-                            std::ostringstream s;
-                            std::random_device rd;
-                            std::mt19937 mt(rd());
-                            std::uniform_int_distribution<uint32_t> dist(0x00U, 0xFFFFFFFFU);
-                            s << "/tmp/talkgroup_rules.yml." << dist(mt);
-
-                            std::string filename = s.str();
-                            std::ofstream file(filename, std::ofstream::out);
-                            if (file.fail()) {
-                                LogError(LOG_NET, "Cannot open the talkgroup ID lookup file - %s", filename.c_str());
-                                goto tid_lookup_cleanup; // yes - I hate myself; but this is quick
-                            }
-
-                            file << str;
-                            file.close();
-
-                            m_tidLookup->stop(true);
-                            m_tidLookup->filename(filename);
-                            m_tidLookup->reload();
-
-                            // flag this peer as Peer-Link enabled
-                            m_peerLink = true;
-
-                            // cleanup temporary file
-                            ::remove(filename.c_str());
-                        }
-                        else {
-                            LogError(LOG_NET, "PEER %u error decompressed TGID list, was not of expected size! %u != %u", peerId, decompressedLen, m_tgidSize);
-                        }
-                    }
-
-                tid_lookup_cleanup:
-                    m_tgidSize = 0U;
-                    m_tgidCompressedSize = 0U;
-                    if (m_tgidBuffer != nullptr)
-                        delete[] m_tgidBuffer;
-                    m_tgidBuffer = nullptr;
-                }
+            std::string filename = writePeerLinkFile(decompressed, "/tmp/talkgroup_rules.yml.");
+            if (filename.empty()) {
+                LogError(LOG_NET, "Cannot open the talkgroup ID lookup file");
+                break;
             }
+
+            m_tidLookup->stop(true);
+            m_tidLookup->filename(filename);
+            m_tidLookup->reload();
+
+            // flag this peer as Peer-Link enabled
+            m_peerLink = true;
+
+            // cleanup temporary file
+            ::remove(filename.c_str());
         }
         break;
 
         case NET_SUBFUNC::PL_RID_LIST:
         {
-            uint8_t curBlock = data[8U];
-            uint8_t blockCnt = data[9U];
-
-            // if this is the first block store sizes and initialize temp buffer
-            if (curBlock == 0U) {
-                m_ridSize = __GET_UINT32(data, 0U);
-                m_ridCompressedSize = __GET_UINT32(data, 4U);
-
-                if (m_ridBuffer != nullptr)
-                    delete[] m_ridBuffer;
-                if (m_ridSize < PEER_LINK_BLOCK_SIZE)
-                    m_ridBuffer = new uint8_t[PEER_LINK_BLOCK_SIZE + 1U];
-                else 
-                    m_ridBuffer = new uint8_t[m_ridSize + 1U];
+            if (processPeerLinkBlock(peerId, m_ridXfer, data, length) != PeerLinkReceiver::XFER_COMPLETE)
+                break;
+
+            std::vector<uint8_t> decompressed = m_ridXfer.takeData();
+            // Utils::dump(1U, "Raw RID Data", decompressed.data(), decompressed.size());
+
+            if (m_ridLookup == nullptr) {
+                LogError(LOG_NET, "Radio ID lookup not available yet.");
+                break;
             }
 
-            if (m_ridBuffer != nullptr) {
-                if (curBlock < blockCnt) {
-                    uint32_t offs = curBlock * PEER_LINK_BLOCK_SIZE;
-                    ::memcpy(m_ridBuffer + offs, data + 10U, PEER_LINK_BLOCK_SIZE);
-                    // Utils::dump(1U, "Block Payload", data, 10U + PEER_LINK_BLOCK_SIZE);
-                } else {
-                    uint32_t offs = curBlock * PEER_LINK_BLOCK_SIZE;
-                    ::memcpy(m_ridBuffer + offs, data + 10U, PEER_LINK_BLOCK_SIZE);
-
-                    // Utils::dump(1U, "Block Payload", data, 10U + PEER_LINK_BLOCK_SIZE);
-                    // Utils::dump(1U, "Compressed Payload", m_ridBuffer, m_ridCompressedSize);
-
-                    // handle last block
-                    // compression structures
-                    z_stream strm;
-                    strm.zalloc = Z_NULL;
-                    strm.zfree = Z_NULL;
-                    strm.opaque = Z_NULL;
-
-                    // set input data
-                    strm.avail_in = m_ridCompressedSize;
-                    strm.next_in = m_ridBuffer;
-
-                    // initialize decompression
-                    int ret = inflateInit(&strm);
-                    if (ret != Z_OK) {
-                        LogError(LOG_NET, "PEER %u error initializing ZLIB", peerId);
-
-                        m_ridSize = 0U;
-                        m_ridCompressedSize = 0U;
-                        if (m_ridBuffer != nullptr)
-                            delete[] m_ridBuffer;
-                        m_ridBuffer = nullptr;
-                        break;
-                    }
-
-                    // decompress data
-                    std::vector<uint8_t> decompressedData;
-                    uint8_t outbuffer[1024];
-                    do {
-                        strm.avail_out = sizeof(outbuffer);
-                        strm.next_out = outbuffer;
-
-                        ret = inflate(&strm, Z_NO_FLUSH);
-                        if (ret == Z_STREAM_ERROR) {
-                            LogError(LOG_NET, "PEER %u error decompressing RID list", peerId);
-                            inflateEnd(&strm);
-                            goto rid_lookup_cleanup; // yes - I hate myself; but this is quick
-                        }
-
-                        decompressedData.insert(decompressedData.end(), outbuffer, outbuffer + sizeof(outbuffer) - strm.avail_out);
-                    } while (ret != Z_STREAM_END);
-
-                    // cleanup
-                    inflateEnd(&strm);
-
-                    // scope is intentional
-                    {
-                        uint32_t decompressedLen = strm.total_out;
-                        uint8_t* decompressed = decompressedData.data();
-
-                        // Utils::dump(1U, "Raw RID Data", decompressed, decompressedLen);
-
-                        // check that we got the appropriate data
-                        if (decompressedLen == m_ridSize) {
-                            if (m_ridLookup == nullptr) {
-                                LogError(LOG_NET, "Radio ID lookup not available yet.");
-                                goto rid_lookup_cleanup; // yes - I hate myself; but this is quick
-                            }
-
-                            // store to file
-                            std::unique_ptr<char[]> __str = std::make_unique<char[]>(decompressedLen + 1U);
-                            char* str = __str.get();
-                            ::memcpy(str, decompressed, decompressedLen);
-                            str[decompressedLen] = 0; // null termination
-
-                            // randomize filename
-                            std::ostringstream s;
-                            std::random_device rd;
-                            std::mt19937 mt(rd());
-                            std::uniform_int_distribution<uint32_t> dist(0x00U, 0xFFFFFFFFU);
-                            s << "/tmp/rid_acl.dat." << dist(mt);
-
-                            std::string filename = s.str();
-                            std::ofstream file(filename, std::ofstream::out);
-                            if (file.fail()) {
-                                LogError(LOG_NET, "Cannot open the radio ID lookup file - %s", filename.c_str());
-                                goto rid_lookup_cleanup; // yes - I hate myself; but this is quick
-                            }
-
-                            file << str;
-                            file.close();
-
-                            m_ridLookup->stop(true);
-                            m_ridLookup->filename(filename);
-                            m_ridLookup->reload();
-
-                            // flag this peer as Peer-Link enabled
-                            m_peerLink = true;
-
-                            // cleanup temporary file
-                            ::remove(filename.c_str());
-                        }
-                        else {
-                            LogError(LOG_NET, "PEER %u error decompressed RID list, was not of expected size! %u != %u", peerId, decompressedLen, m_ridSize);
-                        }
-                    }
-
-                rid_lookup_cleanup:
-                    m_ridSize = 0U;
-                    m_ridCompressedSize = 0U;
-                    if (m_ridBuffer != nullptr)
-                        delete[] m_ridBuffer;
-                    m_ridBuffer = nullptr;
-                }
+            std::string filename = writePeerLinkFile(decompressed, "/tmp/rid_acl.dat.");
+            if (filename.empty()) {
+                LogError(LOG_NET, "Cannot open the radio ID lookup file");
+                break;
             }
+
+            m_ridLookup->stop(true);
+            m_ridLookup->filename(filename);
+            m_ridLookup->reload();
+
+            // flag this peer as Peer-Link enabled
+            m_peerLink = true;
+
+            // cleanup temporary file
+            ::remove(filename.c_str());
         }
         break;
 
         case NET_SUBFUNC::PL_PEER_LIST:
         {
-            uint8_t curBlock = data[8U];
-            uint8_t blockCnt = data[9U];
-
-            // if this is the first block store sizes and initialize temp buffer
-            if (curBlock == 0U) {
-                m_pidSize = __GET_UINT32(data, 0U);
-                m_pidCompressedSize = __GET_UINT32(data, 4U);
-
-                if (m_pidBuffer != nullptr)
-                    delete[] m_pidBuffer;
-                if (m_pidSize < PEER_LINK_BLOCK_SIZE)
-                    m_pidBuffer = new uint8_t[PEER_LINK_BLOCK_SIZE + 1U];
-                else 
-                    m_pidBuffer = new uint8_t[m_pidSize + 1U];
+            if (processPeerLinkBlock(peerId, m_pidXfer, data, length) != PeerLinkReceiver::XFER_COMPLETE)
+                break;
+
+            std::vector<uint8_t> decompressed = m_pidXfer.takeData();
+            // Utils::dump(1U, "Raw Peer List Data", decompressed.data(), decompressed.size());
+
+            if (m_pidLookup == nullptr) {
+                LogError(LOG_NET, "Peer ID lookup not available yet.");
+                break;
             }
 
-            if (m_pidBuffer != nullptr) {
-                if (curBlock < blockCnt) {
-                    uint32_t offs = curBlock * PEER_LINK_BLOCK_SIZE;
-                    ::memcpy(m_pidBuffer + offs, data + 10U, PEER_LINK_BLOCK_SIZE);
-                    // Utils::dump(1U, "Block Payload", data, 10U + PEER_LINK_BLOCK_SIZE);
-                } else {
-                    uint32_t offs = curBlock * PEER_LINK_BLOCK_SIZE;
-                    ::memcpy(m_pidBuffer + offs, data + 10U, PEER_LINK_BLOCK_SIZE);
-
-                    // Utils::dump(1U, "Block Payload", data, 10U + PEER_LINK_BLOCK_SIZE);
-                    // Utils::dump(1U, "Compressed Payload", m_pidBuffer, m_pidCompressedSize);
-
-                    // handle last block
-                    // compression structures
-                    z_stream strm;
-                    strm.zalloc = Z_NULL;
-                    strm.zfree = Z_NULL;
-                    strm.opaque = Z_NULL;
-
-                    // set input data
-                    strm.avail_in = m_pidCompressedSize;
-                    strm.next_in = m_pidBuffer;
-
-                    // initialize decompression
-                    int ret = inflateInit(&strm);
-                    if (ret != Z_OK) {
-                        LogError(LOG_NET, "PEER %u error initializing ZLIB", peerId);
-
-                        m_pidSize = 0U;
-                        m_pidCompressedSize = 0U;
-                        if (m_pidBuffer != nullptr)
-                            delete[] m_pidBuffer;
-                        m_pidBuffer = nullptr;
-                        break;
-                    }
-
-                    // decompress data
-                    std::vector<uint8_t> decompressedData;
-                    uint8_t outbuffer[1024];
-                    do {
-                        strm.avail_out = sizeof(outbuffer);
-                        strm.next_out = outbuffer;
-
-                        ret = inflate(&strm, Z_NO_FLUSH);
-                        if (ret == Z_STREAM_ERROR) {
-                            LogError(LOG_NET, "PEER %u error decompressing peer list", peerId);
-                            inflateEnd(&strm);
-                            goto pid_lookup_cleanup; // yes - I hate myself; but this is quick
-                        }
-
-                        decompressedData.insert(decompressedData.end(), outbuffer, outbuffer + sizeof(outbuffer) - strm.avail_out);
-                    } while (ret != Z_STREAM_END);
-
-                    // cleanup
-                    inflateEnd(&strm);
-
-                    // scope is intentional
-                    {
-                        uint32_t decompressedLen = strm.total_out;
-                        uint8_t* decompressed = decompressedData.data();
-
-                        // Utils::dump(1U, "Raw Peer List Data", decompressed, decompressedLen);
-
-                        // check that we got the appropriate data
-                        if (decompressedLen == m_pidSize) {
-                            if (m_pidLookup == nullptr) {
-                                LogError(LOG_NET, "Peer ID lookup not available yet.");
-                                goto pid_lookup_cleanup; // yes - I hate myself; but this is quick
-                            }
-
-                            // store to file
-                            std::unique_ptr<char[]> __str = std::make_unique<char[]>(decompressedLen + 1U);
-                            char* str = __str.get();
-                            ::memcpy(str, decompressed, decompressedLen);
-                            str[decompressedLen] = 0; // null termination
-
-                            // randomize filename
-                            std::ostringstream s;
-                            std::random_device rd;
-                            std::mt19937 mt(rd());
-                            std::uniform_int_distribution<uint32_t> dist(0x00U, 0xFFFFFFFFU);
-                            s << "/tmp/peer_list.dat." << dist(mt);
-
-                            std::string filename = s.str();
-                            std::ofstream file(filename, std::ofstream::out);
-                            if (file.fail()) {
-                                LogError(LOG_NET, "Cannot open the peer ID lookup file - %s", filename.c_str());
-                                goto pid_lookup_cleanup; // yes - I hate myself; but this is quick
-                            }
-
-                            file << str;
-                            file.close();
-
-                            m_pidLookup->stop(true);
-                            m_pidLookup->filename(filename);
-                            m_pidLookup->reload();
-
-                            // flag this peer as Peer-Link enabled
-                            m_peerLink = true;
-
-                            // cleanup temporary file
-                            ::remove(filename.c_str());
-                        }
-                        else {
-                            LogError(LOG_NET, "PEER %u error decompressed peer ID list, was not of expected size! %u != %u", peerId, decompressedLen, m_pidSize);
-                        }
-                    }
-
-                pid_lookup_cleanup:
-                    m_pidSize = 0U;
-                    m_pidCompressedSize = 0U;
-                    if (m_pidBuffer != nullptr)
-                        delete[] m_pidBuffer;
-                    m_pidBuffer = nullptr;
-                }
+            std::string filename = writePeerLinkFile(decompressed, "/tmp/peer_list.dat.");
+            if (filename.empty()) {
+                LogError(LOG_NET, "Cannot open the peer ID lookup file");
+                break;
             }
+
+            m_pidLookup->stop(true);
+            m_pidLookup->filename(filename);
+            m_pidLookup->reload();
+
+            // flag this peer as Peer-Link enabled
+            m_peerLink = true;
+
+            // cleanup temporary file
+            ::remove(filename.c_str());
         }
         break;
 
@@ -594,3 +262,52 @@ bool PeerNetwork::writeConfig()
 
     return writeMaster({ NET_FUNC::RPTC, NET_SUBFUNC::NOP }, (uint8_t*)buffer, json.length() + 8U, pktSeq(), m_loginStreamId);
 }
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to process a Peer-Link transfer block and acknowledge it to the master. */
+
+PeerLinkReceiver::Status PeerNetwork::processPeerLinkBlock(uint32_t peerId, PeerLinkReceiver& xfer, const uint8_t* data, uint32_t length)
+{
+    if (m_debug)
+        Utils::dump(1U, "Peer-Link Block Payload", data, length);
+
+    PeerLinkReceiver::Status status = xfer.process(data, length);
+    if (status == PeerLinkReceiver::XFER_FAILED) {
+        LogError(LOG_NET, "PEER %u Peer-Link transfer failed, subFunc = $%02X", peerId, xfer.subFunc());
+    }
+
+    if (xfer.hasAck()) {
+        uint8_t buffer[PEER_LINK_XFER_ACK_LENGTH];
+        uint32_t len = xfer.encodeAck(buffer);
+
+        writeMaster({ NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_XFER_ACK }, buffer, len, RTP_END_OF_CALL_SEQ, createStreamId());
+    }
+
+    return status;
+}
+
+/* Helper to write the data of a completed Peer-Link transfer to a temporary file. */
+
+std::string PeerNetwork::writePeerLinkFile(const std::vector<uint8_t>& data, const std::string& prefix)
+{
+    // randomize filename
+    std::ostringstream s;
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<uint32_t> dist(0x00U, 0xFFFFFFFFU);
+    s << prefix << dist(mt);
+
+    std::string filename = s.str();
+    std::ofstream file(filename, std::ofstream::out | std::ofstream::binary);
+    if (file.fail()) {
+        return std::string();
+    }
+
+    file.write((const char*)data.data(), data.size());
+    file.close();
+
+    return filename;
+}
@@ -18,6 +18,7 @@
 
 #include "Defines.h"
 #include "common/lookups/PeerListLookup.h"
+#include "common/network/PeerLinkTransfer.h"
 #include "host/network/Network.h"
 
 #include <string>
@@ -80,11 +81,11 @@ namespace network
         bool checkBlockedPeer(uint32_t peerId);
 
         /**
-         * @brief Writes a complete update of this CFNE's active peer list to the network.
-         * @param peerList List of active peers.
+         * @brief Writes an update of this CFNE's active peer list to the network.
+         * @param messages Encoded peer list messages (see PeerLinkPeersEncoder).
          * @returns bool True, if list was sent, otherwise false.
          */
-        bool writePeerLinkPeers(json::array* peerList);
+        bool writePeerLinkPeers(const std::vector<std::vector<uint8_t>>& messages);
 
         /**
          * @brief Returns flag indicating whether or not this peer connection is Peer-Link enabled.
@@ -116,20 +117,26 @@ namespace network
         lookups::PeerListLookup* m_pidLookup;
         bool m_peerLink;
 
-        uint32_t m_tgidCompressedSize;
-        uint32_t m_tgidSize;
+        PeerLinkReceiver m_tgidXfer;
+        PeerLinkReceiver m_ridXfer;
+        PeerLinkReceiver m_pidXfer;
 
-        uint8_t* m_tgidBuffer;
-
-        uint32_t m_ridCompressedSize;
-        uint32_t m_ridSize;
-
-        uint8_t* m_ridBuffer;
-
-        uint32_t m_pidCompressedSize;
-        uint32_t m_pidSize;
-
-        uint8_t* m_pidBuffer;
+        /**
+         * @brief Helper to process a Peer-Link transfer block and acknowledge it to the master.
+         * @param peerId Peer ID.
+         * @param xfer Peer-Link transfer receiver.
+         * @param[in] data Buffer containing the block.
+         * @param length Length of buffer.
+         * @returns PeerLinkReceiver::Status Result of processing the block.
+         */
+        PeerLinkReceiver::Status processPeerLinkBlock(uint32_t peerId, PeerLinkReceiver& xfer, const uint8_t* data, uint32_t length);
+        /**
+         * @brief Helper to write the data of a completed Peer-Link transfer to a temporary file.
+         * @param data Uncompressed data.
+         * @param prefix Temporary filename prefix.
+         * @returns std::string Filename, or an empty string if the file could not be written.
+         */
+        std::string writePeerLinkFile(const std::vector<uint8_t>& data, const std::string& prefix);
     };
 } // namespace network
 
@@ -813,7 +813,7 @@ void RESTAPI::restAPI_GetPeerQuery(const HTTPPayload& request, HTTPPayload& repl
     json::array peers = json::array();
     if (m_network != nullptr) {
         if (m_network->m_peers.size() > 0) {
-            for (auto entry : m_network->m_peers) {
+            for (auto entry : m_network->m_peers.snapshot()) {
                 uint32_t peerId = entry.first;
                 network::FNEPeerConnection* peer = entry.second;
                 if (peer != nullptr) {
@@ -831,15 +831,11 @@ void RESTAPI::restAPI_GetPeerQuery(const HTTPPayload& request, HTTPPayload& repl
         }
 
         // report any Peer-Link reported peers
+        std::lock_guard<std::mutex> lock(m_network->m_peerLinkPeersMutex);
         if (m_network->m_peerLinkPeers.size() > 0) {
-            for (auto entry : m_network->m_peerLinkPeers) {
-                json::array peerObjs = entry.second;
-                if (entry.second.size() > 0) {
-                    for (auto linkEntry : entry.second) {
-                        if (linkEntry.is<json::object>()) {
-                            peers.push_back(json::value(linkEntry));
-                        }
-                    }
+            for (auto& entry : m_network->m_peerLinkPeers) {
+                for (auto& linkEntry : entry.second.peers()) {
+                    peers.push_back(json::value(linkEntry.second));
                 }
             }
         }
@@ -1359,29 +1355,22 @@ void RESTAPI::restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply,
     json::array affs = json::array();
     if (m_network != nullptr) {
         if (m_network->m_peers.size() > 0) {
-            for (auto entry : m_network->m_peers) {
+            for (auto entry : m_network->m_peers.snapshot()) {
                 uint32_t peerId = entry.first;
                 network::FNEPeerConnection* peer = entry.second;
                 if (peer != nullptr) {
                     lookups::AffiliationLookup* affLookup = m_network->m_peerAffiliations[peerId];
                     if (affLookup != nullptr) {
-                        std::unordered_map<uint32_t, uint32_t> affTable = affLookup->grpAffTable();
-
                         json::object peerObj = json::object();
                         peerObj["peerId"].set<uint32_t>(peerId);
 
                         json::array peerAffs = json::array();
-                        if (affLookup->grpAffSize() > 0U) {
-                            for (auto entry : affTable) {
-                                uint32_t srcId = entry.first;
-                                uint32_t dstId = entry.second;
-
-                                json::object affObj = json::object();
-                                affObj["srcId"].set<uint32_t>(srcId);
-                                affObj["dstId"].set<uint32_t>(dstId);
-                                peerAffs.push_back(json::value(affObj));
-                            }
-                        }
+                        affLookup->forEachGrpAff([&](uint32_t srcId, uint32_t dstId) {
+                            json::object affObj = json::object();
+                            affObj["srcId"].set<uint32_t>(srcId);
+                            affObj["dstId"].set<uint32_t>(dstId);
+                            peerAffs.push_back(json::value(affObj));
+                        });
 
                         peerObj["affiliations"].set<json::array>(peerAffs);
                         affs.push_back(json::value(peerObj));
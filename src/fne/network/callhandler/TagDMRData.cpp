@@ -67,10 +67,14 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 {
     hrc::hrc_t pktTime = hrc::now();
 
-    UInt8Array __buffer = std::make_unique<uint8_t[]>(len);
-    uint8_t* buffer = __buffer.get();
-    ::memset(buffer, 0x00U, len);
-    ::memcpy(buffer, data, len);
+    // copy the frame once into a pooled packet buffer, the buffer is shared by every peer the
+    // frame is repeated to (unless the peer requires the frame to be rewritten)
+    PacketBuffer packet = PacketBuffer::copy(data, len);
+    if (!packet) {
+        return false;
+    }
+
+    uint8_t* buffer = packet.data();
 
     uint8_t seqNo = data[4U];
 
@@ -279,7 +283,7 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 if (peerId != peer.first) {
                     // is this peer ignored?
                     if (!isPeerPermitted(peer.first, dmrData, streamId)) {
@@ -291,15 +295,18 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                         m_network->m_frameQueue->flushQueue();
                     }
 
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+                    // share the frame with the peer, unless it needs a TGID route rewrite
+                    PacketBuffer outboundPeerPacket = packet;
+                    uint32_t rewriteDstId = dstId;
+                    uint32_t rewriteSlotNo = slotNo;
+                    if (peerRewrite(peer.first, rewriteDstId, rewriteSlotNo)) {
+                        outboundPeerPacket = PacketBuffer::copy(buffer, len);
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, dmrData, dataType, dstId, slotNo);
+                        // perform TGID route rewrites if configured
+                        routeRewrite(outboundPeerPacket.data(), peer.first, dmrData, dataType, dstId, slotNo);
+                    }
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerPacket, pktSeq, streamId, true);
                     if (m_network->m_debug) {
                         LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
                             peerId, peer.first, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
@@ -392,7 +399,7 @@ bool TagDMRData::processGrantReq(uint32_t srcId, uint32_t dstId, uint8_t slot, b
 
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 write_CSBK_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
             }
@@ -422,7 +429,7 @@ void TagDMRData::playbackParrot()
         }
         else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "DMR, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
@@ -572,7 +579,8 @@ bool TagDMRData::processCSBK(uint8_t* buffer, uint32_t peerId, dmr::data::NetDat
         uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
         dmrData.getData(data + 2U);
 
-        std::unique_ptr<lc::CSBK> csbk = lc::csbk::CSBKFactory::createCSBK(data + 2U, DataType::CSBK);
+        lc::csbk::CSBKStorage storage;
+        lc::CSBK* csbk = lc::csbk::CSBKFactory::decodeCSBK(data + 2U, DataType::CSBK, storage);
         if (csbk != nullptr) {
             // report csbk event to InfluxDB
             if (m_network->m_enableInfluxDB && m_network->m_influxLogRawData) {
@@ -598,7 +606,7 @@ bool TagDMRData::processCSBK(uint8_t* buffer, uint32_t peerId, dmr::data::NetDat
             switch (csbk->getCSBKO()) {
             case CSBKO::BROADCAST:
                 {
-                    lc::csbk::CSBK_BROADCAST* osp = static_cast<lc::csbk::CSBK_BROADCAST*>(csbk.get());
+                    lc::csbk::CSBK_BROADCAST* osp = static_cast<lc::csbk::CSBK_BROADCAST*>(csbk);
                     if (osp->getAnncType() == BroadcastAnncType::ANN_WD_TSCC) {
                         if (m_network->m_disallowAdjStsBcast) {
                             // LogWarning(LOG_NET, "PEER %u, passing BroadcastAnncType::ANN_WD_TSCC to internal peers is prohibited, dropping", peerId);
@@ -667,8 +675,8 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
         }
 
         FNEPeerConnection* connection = nullptr;
-        if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-            connection = m_network->m_peers[peerId];
+        if (peerId > 0 && m_network->m_peers.contains(peerId)) {
+            connection = m_network->m_peers.find(peerId);
         }
 
         // is this peer a conventional peer?
@@ -958,7 +966,7 @@ void TagDMRData::write_CSBK(uint32_t peerId, uint8_t slot, lc::CSBK* csbk)
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 // every 5 peers flush the queue
                 if (i % 5U == 0U) {
                     m_network->m_frameQueue->flushQueue();
@@ -63,10 +63,14 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
 {
     hrc::hrc_t pktTime = hrc::now();
 
-    UInt8Array __buffer = std::make_unique<uint8_t[]>(len);
-    uint8_t* buffer = __buffer.get();
-    ::memset(buffer, 0x00U, len);
-    ::memcpy(buffer, data, len);
+    // copy the frame once into a pooled packet buffer, the buffer is shared by every peer the
+    // frame is repeated to (unless the peer requires the frame to be rewritten)
+    PacketBuffer packet = PacketBuffer::copy(data, len);
+    if (!packet) {
+        return false;
+    }
+
+    uint8_t* buffer = packet.data();
 
     uint8_t messageType = data[4U];
 
@@ -232,7 +236,7 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 if (peerId != peer.first) {
                     // is this peer ignored?
                     if (!isPeerPermitted(peer.first, lc, messageType, streamId)) {
@@ -244,15 +248,17 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                         m_network->m_frameQueue->flushQueue();
                     }
 
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+                    // share the frame with the peer, unless it needs a TGID route rewrite
+                    PacketBuffer outboundPeerPacket = packet;
+                    uint32_t rewriteDstId = dstId;
+                    if (peerRewrite(peer.first, rewriteDstId)) {
+                        outboundPeerPacket = PacketBuffer::copy(buffer, len);
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, messageType, dstId);
+                        // perform TGID route rewrites if configured
+                        routeRewrite(outboundPeerPacket.data(), peer.first, messageType, dstId);
+                    }
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerPacket, pktSeq, streamId, true);
                     if (m_network->m_debug) {
                         LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
                             peerId, peer.first, messageType, srcId, dstId, len, pktSeq, streamId, external);
@@ -345,7 +351,7 @@ bool TagNXDNData::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUni
 
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 write_Message_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
             }
@@ -375,7 +381,7 @@ void TagNXDNData::playbackParrot()
         }
         else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "NXDN, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
@@ -482,8 +488,8 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
         }
 
         FNEPeerConnection* connection = nullptr;
-        if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-            connection = m_network->m_peers[peerId];
+        if (peerId > 0 && m_network->m_peers.contains(peerId)) {
+            connection = m_network->m_peers.find(peerId);
         }
 
         // is this peer a conventional peer?
@@ -68,10 +68,14 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 {
     hrc::hrc_t pktTime = hrc::now();
 
-    UInt8Array __buffer = std::make_unique<uint8_t[]>(len);
-    uint8_t* buffer = __buffer.get();
-    ::memset(buffer, 0x00U, len);
-    ::memcpy(buffer, data, len);
+    // copy the frame once into a pooled packet buffer, the buffer is shared by every peer the
+    // frame is repeated to (unless the peer requires the frame to be rewritten)
+    PacketBuffer packet = PacketBuffer::copy(data, len);
+    if (!packet) {
+        return false;
+    }
+
+    uint8_t* buffer = packet.data();
 
     uint8_t lco = data[4U];
 
@@ -138,20 +142,15 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
     lsd.setLSD1(lsd1);
     lsd.setLSD2(lsd2);
 
-    uint32_t frameLength = buffer[23U];
-
     // process a TSBK out into a class literal if possible
-    std::unique_ptr<lc::TSBK> tsbk;
+    lc::tsbk::TSBKStorage tsbkStorage;
+    lc::TSBK* tsbk = nullptr;
     if (duid == DUID::TSDU) {
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+        tsbk = lc::tsbk::TSBKFactory::decodeTSBK(buffer + 24U, tsbkStorage);
     }
 
     // is the stream valid?
-    if (validate(peerId, control, duid, tsbk.get(), streamId)) {
+    if (validate(peerId, control, duid, tsbk, streamId)) {
         // is this peer ignored?
         if (!isPeerPermitted(peerId, control, duid, streamId)) {
             return false;
@@ -310,7 +309,7 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 if (peerId != peer.first) {
                     // is this peer ignored?
                     if (!isPeerPermitted(peer.first, control, duid, streamId)) {
@@ -327,15 +326,17 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                         m_network->m_frameQueue->flushQueue();
                     }
 
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+                    // share the frame with the peer, unless it needs a TGID route rewrite
+                    PacketBuffer outboundPeerPacket = packet;
+                    uint32_t rewriteDstId = dstId;
+                    if (peerRewrite(peer.first, rewriteDstId)) {
+                        outboundPeerPacket = PacketBuffer::copy(buffer, len);
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, duid, dstId);
+                        // perform TGID route rewrites if configured
+                        routeRewrite(outboundPeerPacket.data(), peer.first, duid, dstId);
+                    }
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerPacket, pktSeq, streamId, true);
                     if (m_network->m_debug) {
                         LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
                             peerId, peer.first, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
@@ -431,7 +432,7 @@ bool TagP25Data::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUnit
 
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 write_TSDU_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
             }
@@ -477,7 +478,7 @@ void TagP25Data::playbackParrot()
                         m_network->writePeer(pkt.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, 0U, false);
                     } else {
                         // repeat traffic to the connected peers
-                        for (auto peer : m_network->m_peers) {
+                        for (auto peer : m_network->m_peers.snapshot()) {
                             LogMessage(LOG_NET, "P25, Parrot Grant Demand, peer = %u, srcId = %u, dstId = %u", peer.first, srcId, dstId);
                             m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, 0U, false);
                         }
@@ -496,7 +497,7 @@ void TagP25Data::playbackParrot()
             }
         } else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "P25, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
@@ -593,7 +594,6 @@ void TagP25Data::write_TSDU_U_Reg_Cmd(uint32_t peerId, uint32_t dstId)
 void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, uint32_t dstId, bool outbound)
 {
     uint32_t srcId = __GET_UINT16(buffer, 5U);
-    uint32_t frameLength = buffer[23U];
 
     uint32_t rewriteDstId = dstId;
 
@@ -604,11 +604,8 @@ void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, ui
 
         // are we receiving a TSDU?
         if (duid == DUID::TSDU) {
-            UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-            ::memset(data.get(), 0x00U, frameLength);
-            ::memcpy(data.get(), buffer + 24U, frameLength);
-
-            std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+            lc::tsbk::TSBKStorage storage;
+            lc::TSBK* tsbk = lc::tsbk::TSBKFactory::decodeTSBK(buffer + 24U, storage);
             if (tsbk != nullptr) {
                 // handle standard P25 reference opcodes
                 switch (tsbk->getLCO()) {
@@ -683,13 +680,8 @@ bool TagP25Data::processTSDUFrom(uint8_t* buffer, uint32_t peerId, uint8_t duid)
 {
     // are we receiving a TSDU?
     if (duid == DUID::TSDU) {
-        uint32_t frameLength = buffer[23U];
-
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+        lc::tsbk::TSBKStorage storage;
+        lc::TSBK* tsbk = lc::tsbk::TSBKFactory::decodeTSBK(buffer + 24U, storage);
         if (tsbk != nullptr) {
             // report tsbk event to InfluxDB
             if (m_network->m_enableInfluxDB && m_network->m_influxLogRawData) {
@@ -727,7 +719,7 @@ bool TagP25Data::processTSDUFrom(uint8_t* buffer, uint32_t peerId, uint8_t duid)
                         // LogWarning(LOG_NET, "PEER %u, passing ADJ_STS_BCAST to internal peers is prohibited, dropping", peerId);
                         return false;
                     } else {
-                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk.get());
+                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk);
 
                         if (m_network->m_verbose) {
                             LogMessage(LOG_NET, P25_TSDU_STR ", %s, sysId = $%03X, rfss = $%02X, site = $%02X, chId = %u, chNo = %u, svcClass = $%02X, peerId = %u", tsbk->toString().c_str(),
@@ -754,20 +746,15 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
 {
     // are we receiving a TSDU?
     if (duid == DUID::TSDU) {
-        uint32_t frameLength = buffer[23U];
-
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+        lc::tsbk::TSBKStorage storage;
+        lc::TSBK* tsbk = lc::tsbk::TSBKFactory::decodeTSBK(buffer + 24U, storage);
         if (tsbk != nullptr) {
             //uint32_t srcId = tsbk->getSrcId();
             uint32_t dstId = tsbk->getDstId();
 
             FNEPeerConnection* connection = nullptr;
-            if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-                connection = m_network->m_peers[peerId];
+            if (peerId > 0 && m_network->m_peers.contains(peerId)) {
+                connection = m_network->m_peers.find(peerId);
             }
 
             // handle standard P25 reference opcodes
@@ -821,13 +808,8 @@ bool TagP25Data::processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint
 {
     // are we receiving a TSDU?
     if (duid == DUID::TSDU) {
-        uint32_t frameLength = buffer[23U];
-
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+        lc::tsbk::TSBKStorage storage;
+        lc::TSBK* tsbk = lc::tsbk::TSBKFactory::decodeTSBK(buffer + 24U, storage);
         if (tsbk != nullptr) {
             // handle standard P25 reference opcodes
             switch (tsbk->getLCO()) {
@@ -837,7 +819,7 @@ bool TagP25Data::processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint
                         // LogWarning(LOG_NET, "PEER %u, passing ADJ_STS_BCAST to external peers is prohibited, dropping", dstPeerId);
                         return false;
                     } else {
-                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk.get());
+                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk);
 
                         if (m_network->m_verbose) {
                             LogMessage(LOG_NET, P25_TSDU_STR ", %s, sysId = $%03X, rfss = $%02X, site = $%02X, chId = %u, chNo = %u, svcClass = $%02X, peerId = %u", tsbk->toString().c_str(),
@@ -965,8 +947,8 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
     }
 
     FNEPeerConnection* connection = nullptr;
-    if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-        connection = m_network->m_peers[peerId];
+    if (peerId > 0 && m_network->m_peers.contains(peerId)) {
+        connection = m_network->m_peers.find(peerId);
     }
 
     // is this peer a conventional peer?
@@ -1287,7 +1269,7 @@ void TagP25Data::write_TSDU(uint32_t peerId, lc::TSBK* tsbk)
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 // every 5 peers flush the queue
                 if (i % 5U == 0U) {
                     m_network->m_frameQueue->flushQueue();
@@ -30,11 +30,9 @@ using namespace dmr::defines;
 #include <cassert>
 #include <chrono>
 
-// ---------------------------------------------------------------------------
-//  Constants
-// ---------------------------------------------------------------------------
-
-const uint8_t DATA_CALL_COLL_TIMEOUT = 60U;
+#if !defined(_WIN32)
+#include <netinet/ip.h>
+#endif // !defined(_WIN32)
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -45,16 +43,30 @@ const uint8_t DATA_CALL_COLL_TIMEOUT = 60U;
 DMRPacketData::DMRPacketData(FNENetwork* network, TagDMRData* tag, bool debug) :
     m_network(network),
     m_tag(tag),
+    m_vtunFrames("DMR", VTUN_FRAME_POOL_SIZE),
+    m_vtunTxQueues(),
+    m_vtunTxOrder(),
+    m_vtunTxHoldoff(0U),
     m_status(),
+    m_arpMutex(),
+    m_arpTable(),
+    m_arpAddrTable(),
+    m_readyForNextPkt(),
+    m_pktSentTime(),
+    m_suSendSeq(),
     m_debug(debug)
 {
     assert(network != nullptr);
     assert(tag != nullptr);
+
 }
 
 /* Finalizes a instance of the DMRPacketData class. */
 
-DMRPacketData::~DMRPacketData() = default;
+DMRPacketData::~DMRPacketData()
+{
+    /* stub */
+}
 
 /* Process a data frame from the network. */
 
@@ -152,6 +164,8 @@ bool DMRPacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
                 // make sure we don't get a PDU with more blocks then we support
                 if (status->header.getBlocksToFollow() >= MAX_PDU_COUNT) {
                     LogError(LOG_NET, P25_PDU_STR ", too many PDU blocks to process, %u > %u", status->header.getBlocksToFollow(), MAX_PDU_COUNT);
+
+                    delete status;
                     return false;
                 }
 
@@ -160,6 +174,17 @@ bool DMRPacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
                 LogMessage(LOG_NET, "DMR, Data Call Start, peer = %u, slot = %u, srcId = %u, dstId = %u, group = %u, streamId = %u, external = %u", peerId, status->slotNo, status->srcId, status->dstId, gi, streamId, external);
                 dispatchToFNE(peerId, dmrData, data, len, seqNo, pktSeq, streamId);
 
+                // a header-only response has nothing further to wait for
+                if (status->header.getDPF() == DPF::RESPONSE && status->header.getBlocksToFollow() == 0U) {
+                    dispatch(peerId, dmrData, data, len);
+
+                    LogMessage(LOG_NET, "DMR, Data Call End, peer = %u, slot = %u, srcId = %u, dstId = %u, streamId = %u, external = %u",
+                        peerId, status->slotNo, status->srcId, status->dstId, streamId, external);
+
+                    delete status;
+                    m_status.erase(peerId);
+                }
+
                 return true;
             } else {
                 return false;
@@ -237,6 +262,37 @@ bool DMRPacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
     return true;
 }
 
+/* Process a data frame from the virtual IP network. */
+
+void DMRPacketData::processPacketFrame(const uint8_t* data, uint32_t len)
+{
+    assert(data != nullptr);
+    m_vtunFrames.write(data, len);
+}
+
+/* Updates the timer by the passed number of milliseconds. */
+
+void DMRPacketData::clock(uint32_t ms)
+{
+    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    queueVTUNFrames(now);
+
+    // release any SU whose last packet was never acknowledged
+    {
+        std::lock_guard<std::mutex> lock(m_arpMutex);
+        for (auto& entry : m_pktSentTime) {
+            auto ready = m_readyForNextPkt.find(entry.first);
+            if (ready != m_readyForNextPkt.end() && !ready->second && now > entry.second + m_network->m_host->m_vtunPDUAckTimeout) {
+                LogWarning(LOG_NET, "DMR, VTUN -> PDU IP Data, no response from dstId = %u, giving up", entry.first);
+                ready->second = true;
+            }
+        }
+    }
+
+    transmitVTUNFrames(now);
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
@@ -247,6 +303,18 @@ void DMRPacketData::dispatch(uint32_t peerId, dmr::data::NetData& dmrData, const
 {
     RxStatus *status = m_status[peerId];
 
+    // did we receive a response header?
+    if (status->header.getDPF() == DPF::RESPONSE) {
+        LogMessage(LOG_NET, DMR_DT_DATA_HEADER ", ISP, response, sap = $%02X, rspClass = $%02X, rspType = $%02X, rspStatus = $%02X, dstId = %u, srcId = %u",
+            status->header.getSAP(), status->header.getResponseClass(), status->header.getResponseType(), status->header.getResponseStatus(),
+            status->header.getDstId(), status->header.getSrcId());
+
+        // any response (ACK or NACK) completes the outstanding packet for the SU
+        std::lock_guard<std::mutex> lock(m_arpMutex);
+        m_readyForNextPkt[status->header.getSrcId()] = true;
+        return;
+    }
+
     if (status->header.getBlocksToFollow() > 0U && status->frames == 0U) {
         bool crcRet = edac::CRC::checkCRC32(status->pduUserData, status->pduDataOffset);
         if (!crcRet) {
@@ -256,6 +324,18 @@ void DMRPacketData::dispatch(uint32_t peerId, dmr::data::NetData& dmrData, const
         if (m_network->m_dumpPacketData) {
             Utils::dump(1U, "ISP PDU Packet", status->pduUserData, status->pduDataOffset);
         }
+
+        if (!crcRet) {
+            if (status->header.getA()) {
+                write_PDU_Ack_Response(PDUResponseClass::NACK, PDUResponseType::NACK_PACKET_CRC, status->header.getNs(), status->header.getSAP(),
+                    status->header.getDstId(), status->header.getSrcId());
+            }
+            return;
+        }
+
+        if (status->header.getSAP() == PDUSAP::PACKET_DATA) {
+            processPacketData(status);
+        }
     }
 }
 
@@ -271,7 +351,7 @@ void DMRPacketData::dispatchToFNE(uint32_t peerId, dmr::data::NetData& dmrData,
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
         uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 // is this peer ignored?
                 if (!m_tag->isPeerPermitted(peer.first, dmrData, streamId)) {
@@ -332,3 +412,397 @@ void DMRPacketData::dispatchToFNE(uint32_t peerId, dmr::data::NetData& dmrData,
         }
     }
 }
+
+/* Helper to process IP packet data from PDU data, and write it to the VTUN. */
+
+void DMRPacketData::processPacketData(RxStatus* status)
+{
+#if !defined(_WIN32)
+    // is the host virtual tunneling enabled?
+    if (!m_network->m_host->m_vtunEnabled || m_network->m_host->m_packetDataMode != HostFNE::PacketDataMode::DMR)
+        return;
+
+    if (status->pduDataOffset < sizeof(struct ip)) {
+        LogError(LOG_NET, "DMR, PDU -> VTUN, illegal IP packet length, len = %u", status->pduDataOffset);
+        return;
+    }
+
+    struct ip* ipHeader = (struct ip*)(status->pduUserData);
+
+    uint8_t proto = ipHeader->ip_p;
+    uint16_t pktLen = Utils::reverseEndian(ipHeader->ip_len); // bryanb: this could be problematic on different endianness
+    if (pktLen > status->pduDataOffset) {
+        LogError(LOG_NET, "DMR, PDU -> VTUN, truncated IP packet, pktLen = %u, len = %u", pktLen, status->pduDataOffset);
+        return;
+    }
+
+    uint32_t srcId = status->header.getSrcId();
+    uint32_t dstId = status->header.getDstId();
+
+    uint32_t srcProtoAddr = Utils::reverseEndian(ipHeader->ip_src.s_addr);
+    uint32_t tgtProtoAddr = Utils::reverseEndian(ipHeader->ip_dst.s_addr);
+
+    // the source SU is obviously at the source address
+    if (!hasARPEntry(srcId)) {
+        LogMessage(LOG_NET, "DMR, adding ARP entry, %s is at %u", __IP_FROM_UINT(srcProtoAddr).c_str(), srcId);
+    }
+    addARPEntry(srcId, srcProtoAddr);
+
+    // if the target is another SU, the PDU was already repeated to the network; don't hairpin it through the VTUN
+    if (getLLIdAddress(tgtProtoAddr) != 0U) {
+        LogMessage(LOG_NET, "DMR, PDU -> VTUN, IP Data, repeated to network, destination IP has an ARP table entry, dstIp = %s (%u)", 
+            __IP_FROM_UINT(tgtProtoAddr).c_str(), dstId);
+        return;
+    }
+
+    LogMessage(LOG_NET, "DMR, PDU -> VTUN, IP Data, srcIp = %s (%u), dstIp = %s (%u), pktLen = %u, proto = %02X", 
+        __IP_FROM_UINT(srcProtoAddr).c_str(), srcId, __IP_FROM_UINT(tgtProtoAddr).c_str(), dstId, pktLen, proto);
+
+    if (!m_network->m_host->m_tun->write(status->pduUserData, pktLen)) {
+        LogError(LOG_NET, "DMR, PDU -> VTUN, failed to write IP frame to virtual tunnel, len %u", pktLen);
+    }
+
+    // ack the packet so the sender knows we received it
+    if (status->header.getA()) {
+        write_PDU_Ack_Response(PDUResponseClass::ACK, PDUResponseType::ACK, status->header.getNs(), status->header.getSAP(), dstId, srcId);
+    }
+#endif // !defined(_WIN32)
+}
+
+/* Helper to move frames received from the VTUN onto the per-destination transmit queues. */
+
+void DMRPacketData::queueVTUNFrames(uint64_t now)
+{
+#if !defined(_WIN32)
+    VTUNDataFrame* dataFrame = nullptr;
+    while ((dataFrame = m_vtunFrames.read((MAX_PDU_COUNT * DMR_PDU_CONFIRMED_DATA_LENGTH_BYTES) - 4U)) != nullptr) {
+        std::deque<VTUNDataFrame*>& queue = m_vtunTxQueues[dataFrame->tgtProtoAddr];
+        if (queue.size() >= VTUN_MAX_SU_QUEUE_DEPTH) {
+            // don't let a single unresponsive SU hold the entire frame pool
+            LogWarning(LOG_NET, "DMR, VTUN transmit queue full, dropping packet, dstIp = %s", __IP_FROM_UINT(dataFrame->tgtProtoAddr).c_str());
+            m_vtunFrames.release(dataFrame);
+            continue;
+        }
+
+        if (queue.empty())
+            m_vtunTxOrder.push_back(dataFrame->tgtProtoAddr);
+        queue.push_back(dataFrame);
+    }
+#endif // !defined(_WIN32)
+}
+
+/* Helper to transmit the next VTUN frame whose destination is ready. */
+
+void DMRPacketData::transmitVTUNFrames(uint64_t now)
+{
+    // wait for the previous PDU to clear the air before starting the next one; we do *not* wait for
+    // the previous destination to acknowledge, so PDUs for different SUs are pipelined back to back
+    if (now < m_vtunTxHoldoff)
+        return;
+
+    // visit each destination with queued frames at most once, round-robin
+    size_t destinations = m_vtunTxOrder.size();
+    for (size_t i = 0U; i < destinations; i++) {
+        uint32_t tgtProtoAddr = m_vtunTxOrder.front();
+        m_vtunTxOrder.pop_front();
+
+        std::deque<VTUNDataFrame*>& queue = m_vtunTxQueues[tgtProtoAddr];
+        if (queue.empty()) {
+            m_vtunTxQueues.erase(tgtProtoAddr);
+            continue;
+        }
+
+        VTUNDataFrame* dataFrame = queue.front();
+
+        // do we have a valid target address?
+        uint32_t dstId = getLLIdAddress(tgtProtoAddr);
+        if (dstId == 0U) {
+            if (now > dataFrame->timestamp + VTUN_ARP_TIMEOUT) {
+                LogWarning(LOG_NET, "DMR, VTUN -> PDU IP Data, no ARP entry for dstIp = %s, dropping packet", __IP_FROM_UINT(tgtProtoAddr).c_str());
+                queue.pop_front();
+                m_vtunFrames.release(dataFrame);
+            }
+
+            if (!queue.empty())
+                m_vtunTxOrder.push_back(tgtProtoAddr);
+            else
+                m_vtunTxQueues.erase(tgtProtoAddr);
+            continue;
+        }
+
+        // is the SU ready for the next packet?
+        {
+            std::lock_guard<std::mutex> lock(m_arpMutex);
+            auto ready = m_readyForNextPkt.find(dstId);
+            if (ready != m_readyForNextPkt.end() && !ready->second) {
+                m_vtunTxOrder.push_back(tgtProtoAddr);
+                continue;
+            }
+
+            m_readyForNextPkt[dstId] = false;
+            m_pktSentTime[dstId] = now;
+        }
+
+        queue.pop_front();
+        if (!queue.empty())
+            m_vtunTxOrder.push_back(tgtProtoAddr);
+        else
+            m_vtunTxQueues.erase(tgtProtoAddr);
+
+        LogMessage(LOG_NET, "DMR, VTUN -> PDU IP Data, srcIp = %s, dstIp = %s (%u), pktLen = %u, proto = %02X", 
+            __IP_FROM_UINT(dataFrame->srcProtoAddr).c_str(), __IP_FROM_UINT(tgtProtoAddr).c_str(), dstId, dataFrame->pktLen, dataFrame->proto);
+
+        // assemble a DMR PDU frame header for transport...
+        data::DataHeader dataHeader = data::DataHeader();
+        dataHeader.setDPF(DPF::CONFIRMED_DATA);
+        dataHeader.setA(true);
+        dataHeader.setGI(false);
+        dataHeader.setSAP(PDUSAP::PACKET_DATA);
+        dataHeader.setSrcId(WUID_FNE);
+        dataHeader.setDstId(dstId);
+        dataHeader.setFullMesage(true);
+
+        dataHeader.calculateLength(dataFrame->pktLen);
+        uint32_t pduLength = dataHeader.getPDULength();
+
+        bool sync = false;
+        uint8_t sendSeqNo = nextSendSeqNo(dstId, sync);
+        if (sync) {
+            dataHeader.setSynchronize(true);
+        }
+
+        dataHeader.setNs(sendSeqNo);
+
+        UInt8Array __pduUserData = std::make_unique<uint8_t[]>(pduLength);
+        uint8_t* pduUserData = __pduUserData.get();
+        ::memset(pduUserData, 0x00U, pduLength);
+        ::memcpy(pduUserData, dataFrame->buffer, dataFrame->pktLen);
+
+        m_vtunFrames.release(dataFrame);
+
+        write_PDU_User(dataHeader, pduUserData);
+
+        // header + blocks, one burst per slot time
+        m_vtunTxHoldoff = now + ((dataHeader.getBlocksToFollow() + 1U) * DMR_SLOT_TIME);
+        break;
+    }
+}
+
+/* Helper to write a PDU acknowledge response. */
+
+void DMRPacketData::write_PDU_Ack_Response(uint8_t rspClass, uint8_t rspType, uint8_t rspStatus, uint8_t sap, uint32_t srcId, uint32_t dstId)
+{
+    if (rspClass == PDUResponseClass::ACK && rspType != PDUResponseType::ACK)
+        return;
+
+    uint32_t streamId = m_network->createStreamId();
+
+    uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES + 2U);
+
+    data::DataHeader rspHeader = data::DataHeader();
+    rspHeader.setDPF(DPF::RESPONSE);
+    rspHeader.setSAP(sap);
+    rspHeader.setGI(false);
+    rspHeader.setSrcId(srcId);
+    rspHeader.setDstId(dstId);
+    rspHeader.setResponseClass(rspClass);
+    rspHeader.setResponseType(rspType);
+    rspHeader.setResponseStatus(rspStatus);
+    rspHeader.setBlocksToFollow(1U);
+
+    rspHeader.encode(data + 2U);
+    writeNetwork(DataType::DATA_HEADER, rspHeader, data, 0U, 0U, streamId);
+
+    ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES + 2U);
+
+    uint8_t payload[DMR_PDU_UNCODED_LENGTH_BYTES];
+    ::memset(payload, 0x00U, DMR_PDU_UNCODED_LENGTH_BYTES);
+
+    data::DataBlock dataBlock = data::DataBlock();
+    dataBlock.setDataType(DataType::RATE_12_DATA);
+    dataBlock.setFormat(rspHeader);
+    dataBlock.setData(payload);
+    dataBlock.setLastBlock(true);
+
+    dataBlock.encode(data + 2U);
+    writeNetwork(DataType::RATE_12_DATA, rspHeader, data, 1U, RTP_END_OF_CALL_SEQ, streamId);
+}
+
+/* Helper to write user data as a DMR PDU packet. */
+
+void DMRPacketData::write_PDU_User(data::DataHeader& dataHeader, uint8_t* pduUserData)
+{
+    uint32_t streamId = m_network->createStreamId();
+    uint16_t pktSeq = 0U;
+    uint8_t seqNo = 0U;
+
+    uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES + 2U);
+
+    uint32_t blocksToFollow = dataHeader.getBlocksToFollow();
+
+    if (m_network->m_verbosePacketData)
+        LogMessage(LOG_NET, DMR_DT_DATA_HEADER ", OSP, dpf = $%02X, ack = %u, sap = $%02X, fullMessage = %u, blocksToFollow = %u, padLength = %u, packetLength = %u, S = %u, n = %u, dstId = %u, srcId = %u",
+            dataHeader.getDPF(), dataHeader.getA(), dataHeader.getSAP(), dataHeader.getFullMesage(), dataHeader.getBlocksToFollow(), dataHeader.getPadLength(),
+            dataHeader.getPacketLength(), dataHeader.getSynchronize(), dataHeader.getNs(), dataHeader.getDstId(), dataHeader.getSrcId());
+
+    // generate the PDU header
+    dataHeader.encode(data + 2U);
+    writeNetwork(DataType::DATA_HEADER, dataHeader, data, seqNo, pktSeq, streamId);
+    ++seqNo;
+    ++pktSeq;
+
+    if (pduUserData == nullptr || blocksToFollow == 0U)
+        return;
+
+    edac::CRC::addCRC32(pduUserData, dataHeader.getPDULength());
+
+    if (m_network->m_dumpPacketData) {
+        Utils::dump("OSP PDU User Data", pduUserData, dataHeader.getPDULength());
+    }
+
+    // generate the PDU data
+    bool confirmed = dataHeader.getDPF() == DPF::CONFIRMED_DATA;
+    DataType::E dataType = (confirmed) ? DataType::RATE_34_DATA : DataType::RATE_12_DATA;
+    uint32_t blockLength = (confirmed) ? DMR_PDU_CONFIRMED_DATA_LENGTH_BYTES : DMR_PDU_UNCONFIRMED_LENGTH_BYTES;
+
+    uint32_t dataOffset = 0U;
+    for (uint32_t i = 0U; i < blocksToFollow; i++) {
+        data::DataBlock dataBlock = data::DataBlock();
+        dataBlock.setDataType(dataType);
+        dataBlock.setFormat(dataHeader);
+        dataBlock.setSerialNo(i);
+        dataBlock.setData(pduUserData + dataOffset);
+        dataBlock.setLastBlock(i == blocksToFollow - 1U);
+
+        ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES + 2U);
+        dataBlock.encode(data + 2U);
+        writeNetwork(dataType, dataHeader, data, seqNo, (dataBlock.getLastBlock()) ? RTP_END_OF_CALL_SEQ : pktSeq, streamId);
+        ++seqNo;
+        ++pktSeq;
+
+        dataOffset += blockLength;
+    }
+}
+
+/* Write data processed to the local FNE network. (Will not transmit to external peers.) */
+
+void DMRPacketData::writeNetwork(DataType::E dataType, const data::DataHeader& dataHeader, uint8_t* data, 
+    uint8_t seqNo, uint16_t pktSeq, uint32_t streamId)
+{
+    assert(data != nullptr);
+
+    // regenerate the Slot Type
+    SlotType slotType;
+    slotType.setColorCode(0U);
+    slotType.setDataType(dataType);
+    slotType.encode(data + 2U);
+
+    // convert the Data Sync to be from the BS or MS as needed
+    Sync::addDMRDataSync(data + 2U, true);
+
+    data::NetData dmrData;
+    dmrData.setSlotNo(m_network->m_host->m_vtunDMRSlot);
+    dmrData.setDataType(dataType);
+    dmrData.setSrcId(dataHeader.getSrcId());
+    dmrData.setDstId(dataHeader.getDstId());
+    dmrData.setFLCO(dataHeader.getGI() ? FLCO::GROUP : FLCO::PRIVATE);
+    dmrData.setN(0U);
+    dmrData.setSeqNo(seqNo);
+    dmrData.setBER(0U);
+    dmrData.setRSSI(0U);
+
+    dmrData.setData(data + 2U);
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = m_network->createDMR_Message(messageLength, streamId, dmrData);
+    if (message == nullptr) {
+        return;
+    }
+
+    // repeat traffic to the connected peers
+    if (m_network->m_peers.size() > 0U) {
+        uint32_t i = 0U;
+        for (auto peer : m_network->m_peers.snapshot()) {
+            // every 5 peers flush the queue
+            if (i % 5U == 0U) {
+                m_network->m_frameQueue->flushQueue();
+            }
+
+            m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, pktSeq, streamId, true);
+            if (m_network->m_debug) {
+                LogDebug(LOG_NET, "DMR, dstPeer = %u, dataType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, stream = %u", 
+                    peer.first, dataType, dataHeader.getSrcId(), dataHeader.getDstId(), messageLength, pktSeq, streamId);
+            }
+
+            i++;
+        }
+        m_network->m_frameQueue->flushQueue();
+    }
+}
+
+/* Helper to add (or update) an ARP entry. */
+
+void DMRPacketData::addARPEntry(uint32_t llId, uint32_t addr)
+{
+    if (llId == 0U || addr == 0U)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+
+    // drop any stale reverse mapping for this SU
+    auto entry = m_arpTable.find(llId);
+    if (entry != m_arpTable.end() && entry->second != addr) {
+        m_arpAddrTable.erase(entry->second);
+    }
+
+    m_arpTable[llId] = addr;
+    m_arpAddrTable[addr] = llId;
+}
+
+/* Helper to determine if the logical link ID has an ARP entry. */
+
+bool DMRPacketData::hasARPEntry(uint32_t llId)
+{
+    if (llId == 0U) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+    return m_arpTable.find(llId) != m_arpTable.end();
+}
+
+/* Helper to get the logical link ID for the given IP address. */
+
+uint32_t DMRPacketData::getLLIdAddress(uint32_t addr)
+{
+    if (addr == 0U) {
+        return 0U;
+    }
+
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+    auto entry = m_arpAddrTable.find(addr);
+    if (entry != m_arpAddrTable.end()) {
+        return entry->second;
+    }
+
+    return 0U;
+}
+
+/* Helper to get (and advance) the next send sequence number for the given logical link ID. */
+
+uint8_t DMRPacketData::nextSendSeqNo(uint32_t llId, bool& sync)
+{
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+
+    uint8_t& seqNo = m_suSendSeq[llId];
+    uint8_t sendSeqNo = seqNo;
+    sync = (sendSeqNo == 0U);
+
+    ++seqNo;
+    if (seqNo > 7U)
+        seqNo = 0U;
+
+    return sendSeqNo;
+}
@@ -23,8 +23,11 @@
 #include "network/FNENetwork.h"
 #include "network/PeerNetwork.h"
 #include "network/callhandler/TagDMRData.h"
+#include "network/callhandler/packetdata/VTUNFramePool.h"
 
+#include <atomic>
 #include <deque>
+#include <mutex>
 
 namespace network
 {
@@ -66,10 +69,32 @@ namespace network
                  */
                 bool processFrame(const uint8_t* data, uint32_t len, uint32_t peerId, uint16_t pktSeq, uint32_t streamId, bool external = false);
 
+                /**
+                 * @brief Process a data frame from the virtual IP network.
+                 * 
+                 *  This is called from the VTUN receive thread; the frame is only copied into a pooled
+                 *  buffer and handed to the clocking thread, and must not be called from more than one thread.
+                 * @param data Network data buffer.
+                 * @param len Length of data.
+                 */
+                void processPacketFrame(const uint8_t* data, uint32_t len);
+
+                /**
+                 * @brief Updates the timer by the passed number of milliseconds.
+                 * @param ms Number of milliseconds.
+                 */
+                void clock(uint32_t ms);
+
             private:
                 FNENetwork* m_network;
                 TagDMRData *m_tag;
 
+                VTUNFramePool m_vtunFrames;
+
+                std::unordered_map<uint32_t, std::deque<VTUNDataFrame*>> m_vtunTxQueues;
+                std::deque<uint32_t> m_vtunTxOrder;
+                uint64_t m_vtunTxHoldoff;
+
                 /**
                  * @brief Represents the receive status of a call.
                  */
@@ -117,6 +142,13 @@ namespace network
                 typedef std::pair<const uint32_t, RxStatus*> StatusMapPair;
                 std::unordered_map<uint32_t, RxStatus*> m_status;
 
+                std::mutex m_arpMutex;
+                std::unordered_map<uint32_t, uint32_t> m_arpTable;
+                std::unordered_map<uint32_t, uint32_t> m_arpAddrTable;
+                std::unordered_map<uint32_t, bool> m_readyForNextPkt;
+                std::unordered_map<uint32_t, uint64_t> m_pktSentTime;
+                std::unordered_map<uint32_t, uint8_t> m_suSendSeq;
+
                 bool m_debug;
 
                 /**
@@ -138,6 +170,77 @@ namespace network
                  * @param streamId Stream ID.
                  */
                 void dispatchToFNE(uint32_t peerId, dmr::data::NetData& dmrData, const uint8_t* data, uint32_t len, uint8_t seqNo, uint16_t pktSeq, uint32_t streamId);
+
+                /**
+                 * @brief Helper to process IP packet data from PDU data, and write it to the VTUN.
+                 * @param status Instance of the RxStatus class.
+                 */
+                void processPacketData(RxStatus* status);
+
+                /**
+                 * @brief Helper to move frames received from the VTUN onto the per-destination transmit queues.
+                 * @param now Current time in milliseconds.
+                 */
+                void queueVTUNFrames(uint64_t now);
+                /**
+                 * @brief Helper to transmit the next VTUN frame whose destination is ready.
+                 * @param now Current time in milliseconds.
+                 */
+                void transmitVTUNFrames(uint64_t now);
+
+                /**
+                 * @brief Helper to write a PDU acknowledge response.
+                 * @param rspClass Response/Acknowledgement Class.
+                 * @param rspType Response/Acknowledgement Type.
+                 * @param rspStatus Response/Acknowledgement Status.
+                 * @param sap Service access point.
+                 * @param srcId Source ID.
+                 * @param dstId Destination ID.
+                 */
+                void write_PDU_Ack_Response(uint8_t rspClass, uint8_t rspType, uint8_t rspStatus, uint8_t sap, uint32_t srcId, uint32_t dstId);
+                /**
+                 * @brief Helper to write user data as a DMR PDU packet.
+                 * @param dataHeader Instance of a PDU data header.
+                 * @param pduUserData Buffer containing user data to transmit.
+                 */
+                void write_PDU_User(dmr::data::DataHeader& dataHeader, uint8_t* pduUserData);
+                /**
+                 * @brief Write data processed to the local FNE network. (Will not transmit to external peers.)
+                 * @param dataType DMR Data Type.
+                 * @param dataHeader Instance of a PDU data header.
+                 * @param data Buffer containing the encoded frame.
+                 * @param seqNo DMR Sequence Number.
+                 * @param pktSeq RTP packet sequence.
+                 * @param streamId Stream ID.
+                 */
+                void writeNetwork(dmr::defines::DataType::E dataType, const dmr::data::DataHeader& dataHeader, uint8_t* data, 
+                    uint8_t seqNo, uint16_t pktSeq, uint32_t streamId);
+
+                /**
+                 * @brief Helper to add (or update) an ARP entry.
+                 * @param llId Logical Link Address.
+                 * @param addr Numerical IP address.
+                 */
+                void addARPEntry(uint32_t llId, uint32_t addr);
+                /**
+                 * @brief Helper to determine if the logical link ID has an ARP entry.
+                 * @param llId Logical Link Address.
+                 * @returns bool True, if the logical link ID has an arp entry, otherwise false.
+                 */
+                bool hasARPEntry(uint32_t llId);
+                /**
+                 * @brief Helper to get the logical link ID granted to the given IP address.
+                 * @param addr Numerical IP address.
+                 * @returns uint32_t Logical Link Address.
+                 */
+                uint32_t getLLIdAddress(uint32_t addr);
+                /**
+                 * @brief Helper to get (and advance) the next send sequence number for the given logical link ID.
+                 * @param llId Logical Link Address.
+                 * @param[out] sync Flag indicating the sequence is (re)starting and the receiver should synchronize.
+                 * @returns uint8_t Send sequence number.
+                 */
+                uint8_t nextSendSeqNo(uint32_t llId, bool& sync);
             };
         } // namespace packetdata
     } // namespace callhandler
@@ -38,13 +38,7 @@ using namespace p25::sndcp;
 //  Constants
 // ---------------------------------------------------------------------------
 
-const uint8_t DATA_CALL_COLL_TIMEOUT = 60U;
-
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::timed_mutex P25PacketData::m_vtunMutex;
+const uint32_t VTUN_STATS_INTERVAL = 60U;
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -55,20 +49,32 @@ std::timed_mutex P25PacketData::m_vtunMutex;
 P25PacketData::P25PacketData(FNENetwork* network, TagP25Data* tag, bool debug) :
     m_network(network),
     m_tag(tag),
-    m_dataFrames(),
+    m_vtunFrames("P25", VTUN_FRAME_POOL_SIZE),
+    m_vtunTxQueues(),
+    m_vtunTxOrder(),
+    m_vtunStats(),
+    m_vtunStatsTimer(1000U, VTUN_STATS_INTERVAL),
     m_status(),
+    m_arpMutex(),
     m_arpTable(),
+    m_arpAddrTable(),
     m_readyForNextPkt(),
     m_suSendSeq(),
     m_debug(debug)
 {
     assert(network != nullptr);
     assert(tag != nullptr);
+
+
+    m_vtunStatsTimer.start();
 }
 
 /* Finalizes a instance of the P25PacketData class. */
 
-P25PacketData::~P25PacketData() = default;
+P25PacketData::~P25PacketData()
+{
+    /* stub */
+}
 
 /* Process a data frame from the network. */
 
@@ -135,7 +141,11 @@ bool P25PacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
             status->llId = status->header.getLLId();
 
             m_status[peerId] = status;
-            m_readyForNextPkt[status->llId] = true;
+            {
+                // an SU we hear from is reachable; but this doesn't acknowledge anything outstanding to it
+                std::lock_guard<std::mutex> lock(m_arpMutex);
+                m_readyForNextPkt.emplace(status->llId, true);
+            }
 
             // is this a response header?
             if (status->header.getFormat() == PDUFormatType::RSP) {
@@ -148,7 +158,7 @@ bool P25PacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
 
             if (status->header.getSAP() != PDUSAP::EXT_ADDR &&
                 status->header.getFormat() != PDUFormatType::UNCONFIRMED) {
-                m_suSendSeq[status->llId] = 0U;
+                resetSendSeqNo(status->llId);
             }
 
             LogMessage(LOG_NET, "P25, Data Call Start, peer = %u, llId = %u, streamId = %u, external = %u", peerId, status->llId, streamId, external);
@@ -224,7 +234,7 @@ bool P25PacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
 
             status->extendedAddress = true;
             status->llId = status->header.getSrcLLId();
-            m_suSendSeq[status->llId] = 0U;
+            resetSendSeqNo(status->llId);
 
             offset += P25_PDU_FEC_LENGTH_BYTES;
             blocksToFollow--;
@@ -328,149 +338,231 @@ bool P25PacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
 
 /* Process a data frame from the virtual IP network. */
 
-void P25PacketData::processPacketFrame(const uint8_t* data, uint32_t len, bool alreadyQueued)
+void P25PacketData::processPacketFrame(const uint8_t* data, uint32_t len)
+{
+    assert(data != nullptr);
+    m_vtunFrames.write(data, len);
+}
+
+/* Updates the timer by the passed number of milliseconds. */
+
+void P25PacketData::clock(uint32_t ms)
 {
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
-#if !defined(_WIN32)
-    struct ip* ipHeader = (struct ip*)data;
+    queueVTUNFrames();
 
-    char srcIp[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, &(ipHeader->ip_src), srcIp, INET_ADDRSTRLEN);
+    m_vtunStatsTimer.clock(ms);
+    if (m_vtunStatsTimer.isRunning() && m_vtunStatsTimer.hasExpired()) {
+        if (m_debug) {
+            for (auto& entry : m_vtunStats) {
+                LogDebug(LOG_NET, "P25, VTUN stats, llId = %u, queued = %u, sent = %u, retried = %u, dropped = %u",
+                    entry.first, entry.second.queued, entry.second.sent, entry.second.retried, entry.second.dropped);
+            }
+        }
 
-    char dstIp[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, &(ipHeader->ip_dst), dstIp, INET_ADDRSTRLEN);
+        m_vtunStatsTimer.start();
+    }
 
-    uint8_t proto = ipHeader->ip_p;
-    uint16_t pktLen = Utils::reverseEndian(ipHeader->ip_len); // bryanb: this could be problematic on different endianness
+    transmitVTUNFrames(now);
+}
 
-#if DEBUG_P25_PDU_DATA
-    Utils::dump(1U, "P25PacketData::processPacketFrame() packet", data, pktLen);
-#endif
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
 
-    VTUNDataFrame* dataFrame = new VTUNDataFrame();
-    dataFrame->buffer = new uint8_t[len];
-    ::memcpy(dataFrame->buffer, data, len);
-    dataFrame->bufferLen = len;
-    dataFrame->pktLen = pktLen;
-    dataFrame->proto = proto;
+/* Helper to move frames received from the VTUN onto the per-destination transmit queues. */
 
-    uint32_t dstLlId = getLLIdAddress(Utils::reverseEndian(ipHeader->ip_dst.s_addr));
+void P25PacketData::queueVTUNFrames()
+{
+#if !defined(_WIN32)
+    VTUNDataFrame* dataFrame = nullptr;
+    while ((dataFrame = m_vtunFrames.read(DEFAULT_MTU_SIZE)) != nullptr) {
+#if DEBUG_P25_PDU_DATA
+        Utils::dump(1U, "P25PacketData::queueVTUNFrames() packet", dataFrame->buffer, dataFrame->pktLen);
+#endif
 
-    dataFrame->srcHWAddr = WUID_FNE;
-    dataFrame->srcProtoAddr = Utils::reverseEndian(ipHeader->ip_src.s_addr);
-    dataFrame->tgtHWAddr = dstLlId;
-    dataFrame->tgtProtoAddr = Utils::reverseEndian(ipHeader->ip_dst.s_addr);
+        dataFrame->srcHWAddr = WUID_FNE;
+        dataFrame->tgtHWAddr = getLLIdAddress(dataFrame->tgtProtoAddr);
+
+        VTUNTxQueue& queue = m_vtunTxQueues[dataFrame->tgtProtoAddr];
+        if (queue.frames.size() >= VTUN_MAX_SU_QUEUE_DEPTH) {
+            // don't let a single unresponsive SU hold the entire frame pool
+            LogWarning(LOG_NET, "P25, VTUN transmit queue full, dropping packet, dstIp = %s (%u)", 
+                __IP_FROM_UINT(dataFrame->tgtProtoAddr).c_str(), dataFrame->tgtHWAddr);
+            if (dataFrame->tgtHWAddr != 0U)
+                m_vtunStats[dataFrame->tgtHWAddr].dropped++;
+            m_vtunFrames.release(dataFrame);
+            continue;
+        }
 
-    dataFrame->timestamp = now;
+        if (dataFrame->tgtHWAddr == 0U) {
+            std::string tgtIp = __IP_FROM_UINT(dataFrame->tgtProtoAddr);
+            LogMessage(LOG_NET, "P25, no ARP entry for, dstIp = %s", tgtIp.c_str());
+            write_PDU_ARP(dataFrame->tgtProtoAddr);
+        } else {
+            m_vtunStats[dataFrame->tgtHWAddr].queued++;
+        }
 
-    if (dstLlId == 0U) {
-        LogMessage(LOG_NET, "P25, no ARP entry for, dstIp = %s", dstIp);
-        write_PDU_ARP(Utils::reverseEndian(ipHeader->ip_dst.s_addr));
+        if (queue.frames.empty())
+            m_vtunTxOrder.push_back(dataFrame->tgtProtoAddr);
+        queue.frames.push_back(dataFrame);
     }
-
-    m_vtunMutex.try_lock_for(std::chrono::milliseconds(60));
-    m_dataFrames.push_back(dataFrame);
-    m_vtunMutex.unlock();
 #endif // !defined(_WIN32)
 }
 
-/* Updates the timer by the passed number of milliseconds. */
+/* Helper to service the per-destination transmit queues. */
 
-void P25PacketData::clock(uint32_t ms)
+void P25PacketData::transmitVTUNFrames(uint64_t now)
 {
-    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    uint32_t ackTimeout = m_network->m_host->m_vtunPDUAckTimeout;
+    uint32_t maxRetries = m_network->m_host->m_vtunPDURetries;
+
+    // visit each destination with queued frames once, round-robin; every SU has its own outstanding
+    // confirmed PDU, so a slow or unreachable SU only ever delays its own traffic
+    size_t destinations = m_vtunTxOrder.size();
+    for (size_t i = 0U; i < destinations; i++) {
+        uint32_t tgtProtoAddr = m_vtunTxOrder.front();
+        m_vtunTxOrder.pop_front();
+
+        auto it = m_vtunTxQueues.find(tgtProtoAddr);
+        if (it == m_vtunTxQueues.end()) {
+            continue;
+        }
 
-    if (m_dataFrames.size() == 0U) {
-        return;
-    }
+        VTUNTxQueue& queue = it->second;
+        if (queue.frames.empty()) {
+            m_vtunTxQueues.erase(it);
+            continue;
+        }
+
+        VTUNDataFrame* dataFrame = queue.frames.front();
+        uint32_t llId = dataFrame->tgtHWAddr;
+
+        if (queue.inFlight) {
+            // has the SU acknowledged the outstanding packet?
+            bool acked = false;
+            {
+                std::lock_guard<std::mutex> lock(m_arpMutex);
+                auto ready = m_readyForNextPkt.find(llId);
+                acked = (ready != m_readyForNextPkt.end() && ready->second);
+            }
+
+            if (acked) {
+                m_vtunStats[llId].sent++;
 
-    // transmit queued data frames
-    bool processed = false;
-    m_vtunMutex.try_lock_for(std::chrono::milliseconds(60));
-    auto& dataFrame = m_dataFrames[0];
-    m_vtunMutex.unlock();
+                queue.frames.pop_front();
+                queue.inFlight = false;
+                m_vtunFrames.release(dataFrame);
+            }
+            else if (now > queue.sentTime + ackTimeout) {
+                if (queue.retries < maxRetries) {
+                    queue.retries++;
+                    queue.sentTime = now;
+                    m_vtunStats[llId].retried++;
+
+                    LogWarning(LOG_NET, "P25, VTUN -> PDU IP Data, no response from llId = %u, retry %u of %u", llId, queue.retries, maxRetries);
+                    writeVTUNFrame(dataFrame, true);
+                } else {
+                    LogWarning(LOG_NET, "P25, VTUN -> PDU IP Data, no response from llId = %u, dropping packet", llId);
+                    m_vtunStats[llId].dropped++;
 
-    if (dataFrame != nullptr) {
-        if (now > dataFrame->timestamp + 500U) {
-            processed = true;
+                    queue.frames.pop_front();
+                    queue.inFlight = false;
+                    m_vtunFrames.release(dataFrame);
 
+                    std::lock_guard<std::mutex> lock(m_arpMutex);
+                    m_readyForNextPkt[llId] = true;
+                }
+            }
+        }
+        else if (now > dataFrame->timestamp + 500U) {
             // do we have a valid target address?
-            if (dataFrame->tgtHWAddr == 0U) {
-                uint32_t dstLlId = getLLIdAddress(dataFrame->tgtProtoAddr);
-                if (dstLlId == 0U) {
-                    processed = false;
-                    goto pkt_clock_abort;
+            if (llId == 0U) {
+                llId = getLLIdAddress(tgtProtoAddr);
+                if (llId != 0U) {
+                    dataFrame->tgtHWAddr = llId;
+                    m_vtunStats[llId].queued++;
                 }
+                else if (now > dataFrame->timestamp + VTUN_ARP_TIMEOUT) {
+                    LogWarning(LOG_NET, "P25, VTUN -> PDU IP Data, no ARP entry for dstIp = %s, dropping packet", __IP_FROM_UINT(tgtProtoAddr).c_str());
 
-                dataFrame->tgtHWAddr = dstLlId;
+                    queue.frames.pop_front();
+                    m_vtunFrames.release(dataFrame);
+                }
             }
 
             // is the SU ready for the next packet?
-            auto ready = std::find_if(m_readyForNextPkt.begin(), m_readyForNextPkt.end(), [=](ReadyForNextPktPair x) { return x.first == dataFrame->tgtHWAddr; });
-            if (ready != m_readyForNextPkt.end()) {
-                if (!ready->second) {
-                    processed = false;
-                    goto pkt_clock_abort;
+            bool ready = false;
+            if (llId != 0U) {
+                std::lock_guard<std::mutex> lock(m_arpMutex);
+                auto entry = m_readyForNextPkt.find(llId);
+                if (entry != m_readyForNextPkt.end() && entry->second) {
+                    entry->second = false;
+                    ready = true;
                 }
-            } else {
-                processed = false;
-                goto pkt_clock_abort;
             }
 
-            m_readyForNextPkt[dataFrame->tgtHWAddr] = false;
+            if (ready) {
+                queue.inFlight = true;
+                queue.sentTime = now;
+                queue.retries = 0U;
 
-            std::string srcIp = __IP_FROM_UINT(dataFrame->srcProtoAddr);
-            std::string tgtIp = __IP_FROM_UINT(dataFrame->tgtProtoAddr);
+                writeVTUNFrame(dataFrame, false);
+            }
+        }
 
-            LogMessage(LOG_NET, "P25, VTUN -> PDU IP Data, srcIp = %s (%u), dstIp = %s (%u), pktLen = %u, proto = %02X", 
-                srcIp.c_str(), dataFrame->srcHWAddr, tgtIp.c_str(), dataFrame->tgtHWAddr, dataFrame->pktLen, dataFrame->proto);
-
-            // assemble a P25 PDU frame header for transport...
-            data::DataHeader rspHeader = data::DataHeader();
-            rspHeader.setFormat(PDUFormatType::CONFIRMED);
-            rspHeader.setMFId(MFG_STANDARD);
-            rspHeader.setAckNeeded(true);
-            rspHeader.setOutbound(true);
-            rspHeader.setSAP(PDUSAP::EXT_ADDR);
-            rspHeader.setLLId(dataFrame->tgtHWAddr);
-            rspHeader.setBlocksToFollow(1U);
-
-            rspHeader.setEXSAP(PDUSAP::PACKET_DATA);
-            rspHeader.setSrcLLId(WUID_FNE);
-
-            rspHeader.calculateLength(dataFrame->pktLen);
-            uint32_t pduLength = rspHeader.getPDULength();
-
-            UInt8Array __pduUserData = std::make_unique<uint8_t[]>(pduLength);
-            uint8_t* pduUserData = __pduUserData.get();
-            ::memset(pduUserData, 0x00U, pduLength);
-            ::memcpy(pduUserData + 4U, dataFrame->buffer, dataFrame->pktLen);
+        if (!queue.frames.empty())
+            m_vtunTxOrder.push_back(tgtProtoAddr);
+        else
+            m_vtunTxQueues.erase(it);
+    }
+}
+
+/* Helper to write a VTUN frame as a confirmed PDU to the local FNE network. */
+
+void P25PacketData::writeVTUNFrame(VTUNDataFrame* dataFrame, bool retransmit)
+{
+    std::string srcIp = __IP_FROM_UINT(dataFrame->srcProtoAddr);
+    std::string tgtIp = __IP_FROM_UINT(dataFrame->tgtProtoAddr);
+
+    LogMessage(LOG_NET, "P25, VTUN -> PDU IP Data, srcIp = %s (%u), dstIp = %s (%u), pktLen = %u, proto = %02X, retransmit = %u", 
+        srcIp.c_str(), dataFrame->srcHWAddr, tgtIp.c_str(), dataFrame->tgtHWAddr, dataFrame->pktLen, dataFrame->proto, retransmit);
+
+    // assemble a P25 PDU frame header for transport...
+    data::DataHeader rspHeader = data::DataHeader();
+    rspHeader.setFormat(PDUFormatType::CONFIRMED);
+    rspHeader.setMFId(MFG_STANDARD);
+    rspHeader.setAckNeeded(true);
+    rspHeader.setOutbound(true);
+    rspHeader.setSAP(PDUSAP::EXT_ADDR);
+    rspHeader.setLLId(dataFrame->tgtHWAddr);
+    rspHeader.setBlocksToFollow(1U);
+
+    rspHeader.setEXSAP(PDUSAP::PACKET_DATA);
+    rspHeader.setSrcLLId(WUID_FNE);
+
+    rspHeader.calculateLength(dataFrame->pktLen);
+    uint32_t pduLength = rspHeader.getPDULength();
+
+    UInt8Array __pduUserData = std::make_unique<uint8_t[]>(pduLength);
+    uint8_t* pduUserData = __pduUserData.get();
+    ::memset(pduUserData, 0x00U, pduLength);
+    ::memcpy(pduUserData + 4U, dataFrame->buffer, dataFrame->pktLen);
 #if DEBUG_P25_PDU_DATA
-            Utils::dump(1U, "P25PacketData::clock() pduUserData", pduUserData, pduLength);
+    Utils::dump(1U, "P25PacketData::writeVTUNFrame() pduUserData", pduUserData, pduLength);
 #endif
-            dispatchUserFrameToFNE(rspHeader, true, pduUserData);
-        }
-    }
 
-pkt_clock_abort:
-    m_vtunMutex.try_lock_for(std::chrono::milliseconds(60));
-    m_dataFrames.pop_front();
-    if (processed) {
-        if (dataFrame->buffer != nullptr)
-            delete[] dataFrame->buffer;
-        delete dataFrame;
+    // a retransmission reuses the original send sequence, so the SU can discard duplicates
+    if (retransmit) {
+        rspHeader.setNs(dataFrame->sendSeqNo);
+        dispatchUserFrameToFNE(rspHeader, true, pduUserData, true);
     } else {
-        // requeue packet
-        m_dataFrames.push_back(dataFrame);
+        dispatchUserFrameToFNE(rspHeader, true, pduUserData);
+        dataFrame->sendSeqNo = rspHeader.getNs();
     }
-    m_vtunMutex.unlock();
 }
 
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
 /* Helper to dispatch PDU user data. */
 
 void P25PacketData::dispatch(uint32_t peerId)
@@ -501,6 +593,7 @@ void P25PacketData::dispatch(uint32_t peerId)
                 status->header.getLLId(), status->header.getSrcLLId());
 
         if (status->header.getResponseClass() == PDUAckClass::ACK && status->header.getResponseType() == PDUAckType::ACK) {
+            std::lock_guard<std::mutex> lock(m_arpMutex);
             m_readyForNextPkt[status->header.getSrcLLId()] = true;
         }
 
@@ -550,17 +643,11 @@ void P25PacketData::dispatch(uint32_t peerId)
             if (fneIPv4 == srcProtoAddr) {
                 LogWarning(LOG_NET, P25_PDU_STR ", ARP reply, %u is trying to masquerade as us...", srcHWAddr);
             } else {
-                m_arpTable[srcHWAddr] = srcProtoAddr;
+                addARPEntry(srcHWAddr, srcProtoAddr);
 
-                // is the SU ready for the next packet?
-                auto ready = std::find_if(m_readyForNextPkt.begin(), m_readyForNextPkt.end(), [=](ReadyForNextPktPair x) { return x.first == srcHWAddr; });
-                if (ready != m_readyForNextPkt.end()) {
-                    if (!ready->second) {
-                        m_readyForNextPkt[srcHWAddr] = true;
-                    }
-                } else {
-                    m_readyForNextPkt[srcHWAddr] = true;
-                }
+                // the SU is ready for packets, unless it still has one outstanding
+                std::lock_guard<std::mutex> lock(m_arpMutex);
+                m_readyForNextPkt.emplace(srcHWAddr, true);
             }
         }
 #else
@@ -602,17 +689,15 @@ void P25PacketData::dispatch(uint32_t peerId)
             handled = true;
 
             // is the source SU one we have proper ARP entries for?
-            auto arpEntry = std::find_if(m_arpTable.begin(), m_arpTable.end(), [=](ArpTablePair x) { return x.first == status->header.getSrcLLId(); });
-            if (arpEntry == m_arpTable.end()) {
+            if (!hasARPEntry(status->header.getSrcLLId())) {
                 uint32_t srcProtoAddr = Utils::reverseEndian(ipHeader->ip_src.s_addr);
                 LogMessage(LOG_NET, P25_PDU_STR ", adding ARP entry, %s is at %u", __IP_FROM_UINT(srcProtoAddr).c_str(), status->header.getSrcLLId());
-                m_arpTable[status->header.getSrcLLId()] = Utils::reverseEndian(ipHeader->ip_src.s_addr);
+                addARPEntry(status->header.getSrcLLId(), srcProtoAddr);
             }
         }
 
         // is the target SU one we have proper ARP entries for?
-        auto arpEntry = std::find_if(m_arpTable.begin(), m_arpTable.end(), [=](ArpTablePair x) { return x.first == status->header.getLLId(); });
-        if (arpEntry != m_arpTable.end()) {
+        if (hasARPEntry(status->header.getLLId())) {
             LogMessage(LOG_NET, "P25, PDU -> VTUN, IP Data, repeated to CAI, destination IP has a CAI ARP table entry, dstIp = %s (%u)", 
                 dstIp, status->header.getLLId());
 
@@ -620,11 +705,10 @@ void P25PacketData::dispatch(uint32_t peerId)
             handled = true;
 
             // is the source SU one we have proper ARP entries for?
-            auto arpEntry = std::find_if(m_arpTable.begin(), m_arpTable.end(), [=](ArpTablePair x) { return x.first == status->header.getSrcLLId(); });
-            if (arpEntry == m_arpTable.end()) {
+            if (!hasARPEntry(status->header.getSrcLLId())) {
                 uint32_t srcProtoAddr = Utils::reverseEndian(ipHeader->ip_src.s_addr);
                 LogMessage(LOG_NET, P25_PDU_STR ", adding ARP entry, %s is at %u", __IP_FROM_UINT(srcProtoAddr).c_str(), status->header.getSrcLLId());
-                m_arpTable[status->header.getSrcLLId()] = Utils::reverseEndian(ipHeader->ip_src.s_addr);
+                addARPEntry(status->header.getSrcLLId(), srcProtoAddr);
             }
         }
 
@@ -675,7 +759,7 @@ void P25PacketData::dispatchToFNE(uint32_t peerId)
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
         uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 // every 2 peers flush the queue
                 if (i % 2U == 0U) {
@@ -724,26 +808,25 @@ void P25PacketData::dispatchToFNE(uint32_t peerId)
 
 /* Helper to dispatch PDU user data back to the local FNE network. (Will not transmit to external peers.) */
 
-void P25PacketData::dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bool extendedAddress, uint8_t* pduUserData)
+void P25PacketData::dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bool extendedAddress, uint8_t* pduUserData, bool retransmit)
 {
     uint32_t srcId = (extendedAddress) ? dataHeader.getSrcLLId() : dataHeader.getLLId();
     uint32_t dstId = dataHeader.getLLId();
 
-    uint8_t sendSeqNo = m_suSendSeq[srcId];
-    if (sendSeqNo == 0U) {
-        dataHeader.setSynchronize(true);
-    }
+    if (!retransmit) {
+        bool sync = false;
+        uint8_t sendSeqNo = nextSendSeqNo(srcId, sync);
+        if (sync) {
+            dataHeader.setSynchronize(true);
+        }
 
-    dataHeader.setNs(sendSeqNo);
-    ++sendSeqNo;
-    if (sendSeqNo > 7U)
-        sendSeqNo = 0U;
-    m_suSendSeq[srcId] = sendSeqNo;
+        dataHeader.setNs(sendSeqNo);
+    }
 
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
         uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             // every 2 peers flush the queue
             if (i % 2U == 0U) {
                 m_network->m_frameQueue->flushQueue();
@@ -780,7 +863,7 @@ bool P25PacketData::processSNDCPControl(RxStatus* status)
             LogMessage(LOG_NET, P25_PDU_STR ", SNDCP context activation request, llId = %u, nsapi = %u, ipAddr = %s, nat = $%02X, dsut = $%02X, mdpco = $%02X", llId,
                 isp->getNSAPI(), __IP_FROM_UINT(isp->getIPAddress()).c_str(), isp->getNAT(), isp->getDSUT(), isp->getMDPCO());
 
-            m_arpTable[llId] = isp->getIPAddress();
+            addARPEntry(llId, isp->getIPAddress());
         }
         break;
 
@@ -790,7 +873,7 @@ bool P25PacketData::processSNDCPControl(RxStatus* status)
             LogMessage(LOG_NET, P25_PDU_STR ", SNDCP context deactivation request, llId = %u, deactType = %02X", llId,
                 isp->getDeactType());
 
-            m_arpTable.erase(llId);
+            removeARPEntry(llId);
         }
         break;
 
@@ -1049,26 +1132,51 @@ bool P25PacketData::writeNetwork(uint32_t peerId, network::PeerNetwork* peerNet,
     }
 }
 
+/* Helper to add (or update) an ARP entry. */
+
+void P25PacketData::addARPEntry(uint32_t llId, uint32_t addr)
+{
+    if (llId == 0U || addr == 0U)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+
+    // drop any stale reverse mapping for this SU
+    auto entry = m_arpTable.find(llId);
+    if (entry != m_arpTable.end() && entry->second != addr) {
+        m_arpAddrTable.erase(entry->second);
+    }
+
+    m_arpTable[llId] = addr;
+    m_arpAddrTable[addr] = llId;
+}
+
+/* Helper to remove an ARP entry. */
+
+void P25PacketData::removeARPEntry(uint32_t llId)
+{
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+
+    auto entry = m_arpTable.find(llId);
+    if (entry != m_arpTable.end()) {
+        auto addrEntry = m_arpAddrTable.find(entry->second);
+        if (addrEntry != m_arpAddrTable.end() && addrEntry->second == llId)
+            m_arpAddrTable.erase(addrEntry);
+        m_arpTable.erase(entry);
+    }
+}
+
 /* Helper to determine if the logical link ID has an ARP entry. */
 
-bool P25PacketData::hasARPEntry(uint32_t llId) const
+bool P25PacketData::hasARPEntry(uint32_t llId)
 {
     if (llId == 0U) {
         return false;
     }
 
-    // lookup ARP table entry
-    try {
-        uint32_t addr = m_arpTable.at(llId);
-        if (addr != 0U) {
-            return true;
-        }
-        else {
-            return false;
-        }
-    } catch (...) {
-        return false;
-    }
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+    auto entry = m_arpTable.find(llId);
+    return (entry != m_arpTable.end() && entry->second != 0U);
 }
 
 /* Helper to get the IP address for the given logical link ID. */
@@ -1079,8 +1187,10 @@ uint32_t P25PacketData::getIPAddress(uint32_t llId)
         return 0U;
     }
 
-    if (hasARPEntry(llId)) {
-        return m_arpTable[llId];
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+    auto entry = m_arpTable.find(llId);
+    if (entry != m_arpTable.end()) {
+        return entry->second;
     }
 
     return 0U;
@@ -1094,12 +1204,36 @@ uint32_t P25PacketData::getLLIdAddress(uint32_t addr)
         return 0U;
     }
 
-    // lookup ARP table entry
-    for (auto entry : m_arpTable) {
-        if (entry.second == addr) {
-            return entry.first;
-        }
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+    auto entry = m_arpAddrTable.find(addr);
+    if (entry != m_arpAddrTable.end()) {
+        return entry->second;
     }
 
     return 0U;
 }
+
+/* Helper to get (and advance) the next send sequence number for the given logical link ID. */
+
+uint8_t P25PacketData::nextSendSeqNo(uint32_t llId, bool& sync)
+{
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+
+    uint8_t& seqNo = m_suSendSeq[llId];
+    uint8_t sendSeqNo = seqNo;
+    sync = (sendSeqNo == 0U);
+
+    ++seqNo;
+    if (seqNo > 7U)
+        seqNo = 0U;
+
+    return sendSeqNo;
+}
+
+/* Helper to reset the send sequence number for the given logical link ID. */
+
+void P25PacketData::resetSendSeqNo(uint32_t llId)
+{
+    std::lock_guard<std::mutex> lock(m_arpMutex);
+    m_suSendSeq[llId] = 0U;
+}
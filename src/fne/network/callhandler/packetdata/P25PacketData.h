@@ -18,14 +18,18 @@
 
 #include "fne/Defines.h"
 #include "common/Clock.h"
+#include "common/Timer.h"
 #include "common/p25/P25Defines.h"
 #include "common/p25/data/DataBlock.h"
 #include "common/p25/data/DataHeader.h"
 #include "network/FNENetwork.h"
 #include "network/PeerNetwork.h"
 #include "network/callhandler/TagP25Data.h"
+#include "network/callhandler/packetdata/VTUNFramePool.h"
 
+#include <atomic>
 #include <deque>
+#include <mutex>
 
 namespace network
 {
@@ -69,11 +73,13 @@ namespace network
 
                 /**
                  * @brief Process a data frame from the virtual IP network.
+                 * 
+                 *  This is called from the VTUN receive thread; the frame is only copied into a pooled
+                 *  buffer and handed to the clocking thread, and must not be called from more than one thread.
                  * @param data Network data buffer.
                  * @param len Length of data.
-                 * @param alreaedyQueued Flag indicating the data frame being processed is already queued.
                  */
-                void processPacketFrame(const uint8_t* data, uint32_t len, bool alreadyQueued = false);
+                void processPacketFrame(const uint8_t* data, uint32_t len);
 
                 /**
                  * @brief Updates the timer by the passed number of milliseconds.
@@ -85,25 +91,57 @@ namespace network
                 FNENetwork* m_network;
                 TagP25Data *m_tag;
 
+                VTUNFramePool m_vtunFrames;
+
                 /**
-                 * @brief Represents a queued data frame from the VTUN.
+                 * @brief Represents the transmit queue for a single destination.
                  */
-                class VTUNDataFrame {
+                class VTUNTxQueue {
                 public:
-                    uint32_t srcHWAddr;         //! Source Hardware Address
-                    uint32_t srcProtoAddr;      //! Source Protocol Address
-                    uint32_t tgtHWAddr;         //! Target Hardware Address
-                    uint32_t tgtProtoAddr;      //! Target Protocol Address
+                    std::deque<VTUNDataFrame*> frames;  //! Queued Frames
+                    bool inFlight;              //! Flag indicating the head frame is awaiting acknowledgement
+                    uint64_t sentTime;          //! Timestamp (in milliseconds) the head frame was last sent
+                    uint8_t retries;            //! Number of retransmissions of the head frame
 
-                    uint8_t* buffer;            //! Raw data buffer
-                    uint32_t bufferLen;         //! Length of raw data buffer
-                    
-                    uint16_t pktLen;            //! Packet Length
-                    uint8_t proto;              //! Packet Protocol
+                    /**
+                     * @brief Initializes a new instance of the VTUNTxQueue class
+                     */
+                    VTUNTxQueue() :
+                        frames(),
+                        inFlight(false),
+                        sentTime(0U),
+                        retries(0U)
+                    {
+                        /* stub */
+                    }
+                };
+                std::unordered_map<uint32_t, VTUNTxQueue> m_vtunTxQueues;
+                std::deque<uint32_t> m_vtunTxOrder;
 
-                    uint64_t timestamp;         //! Timestamp in milliseconds
+                /**
+                 * @brief Represents the VTUN delivery statistics for a subscriber.
+                 */
+                class VTUNStats {
+                public:
+                    uint32_t queued;            //! Total Frames Queued
+                    uint32_t sent;              //! Total Frames Sent (and Acknowledged)
+                    uint32_t retried;           //! Total Frame Retransmissions
+                    uint32_t dropped;           //! Total Frames Dropped
+
+                    /**
+                     * @brief Initializes a new instance of the VTUNStats class
+                     */
+                    VTUNStats() :
+                        queued(0U),
+                        sent(0U),
+                        retried(0U),
+                        dropped(0U)
+                    {
+                        /* stub */
+                    }
                 };
-                std::deque<VTUNDataFrame*> m_dataFrames;
+                std::unordered_map<uint32_t, VTUNStats> m_vtunStats;
+                Timer m_vtunStatsTimer;
 
                 /**
                  * @brief Represents the receive status of a call.
@@ -164,15 +202,29 @@ namespace network
                 typedef std::pair<const uint32_t, RxStatus*> StatusMapPair;
                 std::unordered_map<uint32_t, RxStatus*> m_status;
 
-                typedef std::pair<const uint32_t, uint32_t> ArpTablePair;
+                std::mutex m_arpMutex;
                 std::unordered_map<uint32_t, uint32_t> m_arpTable;
-                typedef std::pair<const uint32_t, bool> ReadyForNextPktPair;
+                std::unordered_map<uint32_t, uint32_t> m_arpAddrTable;
                 std::unordered_map<uint32_t, bool> m_readyForNextPkt;
                 std::unordered_map<uint32_t, uint8_t> m_suSendSeq;
 
                 bool m_debug;
 
-                static std::timed_mutex m_vtunMutex;
+                /**
+                 * @brief Helper to move frames received from the VTUN onto the per-destination transmit queues.
+                 */
+                void queueVTUNFrames();
+                /**
+                 * @brief Helper to service the per-destination transmit queues.
+                 * @param now Current time in milliseconds.
+                 */
+                void transmitVTUNFrames(uint64_t now);
+                /**
+                 * @brief Helper to write a VTUN frame as a confirmed PDU to the local FNE network.
+                 * @param dataFrame VTUN data frame.
+                 * @param retransmit Flag indicating this is a retransmission of a previously sent frame.
+                 */
+                void writeVTUNFrame(VTUNDataFrame* dataFrame, bool retransmit);
 
                 /**
                  * @brief Helper to dispatch PDU user data.
@@ -189,8 +241,9 @@ namespace network
                  * @param dataHeader Instance of a PDU data header.
                  * @param extendedAddress Flag indicating whether or not to extended addressing is in use.
                  * @param pduUserData Buffer containing user data to transmit.
+                 * @param retransmit Flag indicating the data header already carries its send sequence number.
                  */
-                void dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bool extendedAddress, uint8_t* pduUserData);
+                void dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bool extendedAddress, uint8_t* pduUserData, bool retransmit = false);
 
                 /**
                  * @brief Helper used to process SNDCP control data from PDU data.
@@ -248,12 +301,23 @@ namespace network
                 bool writeNetwork(uint32_t peerId, network::PeerNetwork* peerNet, const p25::data::DataHeader& dataHeader, const uint8_t currentBlock, 
                     const uint8_t* data, uint32_t len, uint16_t pktSeq, uint32_t streamId, bool queueOnly = false);
 
+                /**
+                 * @brief Helper to add (or update) an ARP entry.
+                 * @param llId Logical Link Address.
+                 * @param addr Numerical IP address.
+                 */
+                void addARPEntry(uint32_t llId, uint32_t addr);
+                /**
+                 * @brief Helper to remove an ARP entry.
+                 * @param llId Logical Link Address.
+                 */
+                void removeARPEntry(uint32_t llId);
                 /**
                  * @brief Helper to determine if the logical link ID has an ARP entry.
                  * @param llId Logical Link Address.
                  * @returns bool True, if the logical link ID has an arp entry, otherwise false.
                  */
-                bool hasARPEntry(uint32_t llId) const;
+                bool hasARPEntry(uint32_t llId);
                 /**
                  * @brief Helper to get the IP address for the given logical link ID.
                  * @param llId Logical Link Address.
@@ -266,6 +330,18 @@ namespace network
                  * @returns uint32_t Logical Link Address.
                  */
                 uint32_t getLLIdAddress(uint32_t addr);
+                /**
+                 * @brief Helper to get (and advance) the next send sequence number for the given logical link ID.
+                 * @param llId Logical Link Address.
+                 * @param[out] sync Flag indicating the sequence is (re)starting and the receiver should synchronize.
+                 * @returns uint8_t Send sequence number.
+                 */
+                uint8_t nextSendSeqNo(uint32_t llId, bool& sync);
+                /**
+                 * @brief Helper to reset the send sequence number for the given logical link ID.
+                 * @param llId Logical Link Address.
+                 */
+                void resetSendSeqNo(uint32_t llId);
             };
         } // namespace packetdata
     } // namespace callhandler
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "network/callhandler/packetdata/VTUNFramePool.h"
+
+using namespace network::callhandler::packetdata;
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <netinet/ip.h>
+#endif // !defined(_WIN32)
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the VTUNDataFrame class. */
+
+VTUNDataFrame::VTUNDataFrame() :
+    srcHWAddr(0U),
+    srcProtoAddr(0U),
+    tgtHWAddr(0U),
+    tgtProtoAddr(0U),
+    buffer(nullptr),
+    bufferLen(0U),
+    pktLen(0U),
+    proto(0U),
+    sendSeqNo(0U),
+    timestamp(0U)
+{
+    buffer = new uint8_t[DEFAULT_MTU_SIZE];
+}
+
+/* Finalizes a instance of the VTUNDataFrame class. */
+
+VTUNDataFrame::~VTUNDataFrame()
+{
+    delete[] buffer;
+}
+
+/* Initializes a new instance of the VTUNFramePool class. */
+
+VTUNFramePool::VTUNFramePool(const char* tag, uint32_t size) :
+    m_tag(tag),
+    m_frames(nullptr),
+    m_pool(size, "VTUN Frame Pool"),
+    m_rxQueue(size, "VTUN Rx Queue"),
+    m_dropped(0U)
+{
+    // the receive queue is sized to the pool, so a frame taken from the pool can always be queued
+    m_frames = new VTUNDataFrame[size];
+    for (uint32_t i = 0U; i < size; i++)
+        m_pool.push(m_frames + i);
+}
+
+/* Finalizes a instance of the VTUNFramePool class. */
+
+VTUNFramePool::~VTUNFramePool()
+{
+    delete[] m_frames;
+}
+
+/* Copies a packet received from the VTUN into a pooled frame and queues it. */
+
+bool VTUNFramePool::write(const uint8_t* data, uint32_t len)
+{
+    assert(data != nullptr);
+
+    VTUNDataFrame* dataFrame = nullptr;
+    if (len > DEFAULT_MTU_SIZE || !m_pool.pop(dataFrame)) {
+        m_dropped.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+
+    ::memcpy(dataFrame->buffer, data, len);
+    dataFrame->bufferLen = len;
+    dataFrame->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    m_rxQueue.push(dataFrame);
+    return true;
+}
+
+/* Dequeues the next received frame, with its IP header parsed. */
+
+VTUNDataFrame* VTUNFramePool::read(uint32_t maxPktLen)
+{
+    uint32_t dropped = m_dropped.exchange(0U, std::memory_order_relaxed);
+    if (dropped > 0U) {
+        LogWarning(LOG_NET, "%s, VTUN receive queue overflow, %u packets dropped", m_tag, dropped);
+    }
+
+#if !defined(_WIN32)
+    VTUNDataFrame* dataFrame = nullptr;
+    while (m_rxQueue.pop(dataFrame)) {
+        if (dataFrame->bufferLen < sizeof(struct ip)) {
+            LogWarning(LOG_NET, "%s, VTUN packet too short, len = %u", m_tag, dataFrame->bufferLen);
+            m_pool.push(dataFrame);
+            continue;
+        }
+
+        struct ip* ipHeader = (struct ip*)dataFrame->buffer;
+
+        uint16_t pktLen = Utils::reverseEndian(ipHeader->ip_len); // bryanb: this could be problematic on different endianness
+        if (pktLen > dataFrame->bufferLen || pktLen > maxPktLen) {
+            LogWarning(LOG_NET, "%s, VTUN packet too large or truncated, pktLen = %u, len = %u", m_tag, pktLen, dataFrame->bufferLen);
+            m_pool.push(dataFrame);
+            continue;
+        }
+
+        dataFrame->pktLen = pktLen;
+        dataFrame->proto = ipHeader->ip_p;
+        dataFrame->srcHWAddr = 0U;
+        dataFrame->srcProtoAddr = Utils::reverseEndian(ipHeader->ip_src.s_addr);
+        dataFrame->tgtHWAddr = 0U;
+        dataFrame->tgtProtoAddr = Utils::reverseEndian(ipHeader->ip_dst.s_addr);
+        dataFrame->sendSeqNo = 0U;
+        return dataFrame;
+    }
+#endif // !defined(_WIN32)
+
+    return nullptr;
+}
+
+/* Returns a frame to the pool. */
+
+void VTUNFramePool::release(VTUNDataFrame* dataFrame)
+{
+    assert(dataFrame != nullptr);
+    m_pool.push(dataFrame);
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ * 
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file VTUNFramePool.h
+ * @ingroup fne_callhandler
+ * @file VTUNFramePool.cpp
+ * @ingroup fne_callhandler
+ */
+#if !defined(__PACKETDATA__VTUN_FRAME_POOL_H__)
+#define __PACKETDATA__VTUN_FRAME_POOL_H__
+
+#include "fne/Defines.h"
+#include "common/SPSCQueue.h"
+
+#include <atomic>
+
+namespace network
+{
+    namespace callhandler
+    {
+        namespace packetdata
+        {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            const uint8_t DATA_CALL_COLL_TIMEOUT = 60U;
+
+            const uint32_t VTUN_FRAME_POOL_SIZE = 256U;
+            const uint32_t VTUN_MAX_SU_QUEUE_DEPTH = 64U;
+            const uint32_t VTUN_ARP_TIMEOUT = 10000U;
+
+            // ---------------------------------------------------------------------------
+            //  Class Declaration
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Represents a queued data frame from the VTUN.
+             * @ingroup fne_callhandler
+             */
+            class HOST_SW_API VTUNDataFrame {
+            public:
+                uint32_t srcHWAddr;         //! Source Hardware Address
+                uint32_t srcProtoAddr;      //! Source Protocol Address
+                uint32_t tgtHWAddr;         //! Target Hardware Address
+                uint32_t tgtProtoAddr;      //! Target Protocol Address
+
+                uint8_t* buffer;            //! Raw data buffer
+                uint32_t bufferLen;         //! Length of raw data buffer
+
+                uint16_t pktLen;            //! Packet Length
+                uint8_t proto;              //! Packet Protocol
+                uint8_t sendSeqNo;          //! Send Sequence Number (of the first transmission)
+
+                uint64_t timestamp;         //! Timestamp in milliseconds
+
+                /**
+                 * @brief Initializes a new instance of the VTUNDataFrame class
+                 */
+                VTUNDataFrame();
+                /**
+                 * @brief Finalizes a instance of the VTUNDataFrame class
+                 */
+                ~VTUNDataFrame();
+            };
+
+            // ---------------------------------------------------------------------------
+            //  Class Declaration
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Implements the fixed pool of VTUN data frames, and the queue handing frames received
+             *  from the VTUN to the packet data clocking thread.
+             * 
+             *  Frames are only ever taken from the pool and queued by the VTUN receive thread, and only
+             *  ever dequeued and released by the clocking thread; neither side is thread-safe beyond that.
+             * @ingroup fne_callhandler
+             */
+            class HOST_SW_API VTUNFramePool {
+            public:
+                /**
+                 * @brief Initializes a new instance of the VTUNFramePool class.
+                 * @param tag Protocol tag used when logging (e.g. "P25").
+                 * @param size Number of frames in the pool.
+                 */
+                VTUNFramePool(const char* tag, uint32_t size);
+                /**
+                 * @brief Finalizes a instance of the VTUNFramePool class.
+                 */
+                ~VTUNFramePool();
+
+                /**
+                 * @brief Copies a packet received from the VTUN into a pooled frame and queues it. (VTUN
+                 *  receive thread only.)
+                 * @param data Packet data buffer.
+                 * @param len Length of packet data.
+                 * @returns bool True, if the packet was queued, otherwise false.
+                 */
+                bool write(const uint8_t* data, uint32_t len);
+
+                /**
+                 * @brief Dequeues the next received frame, with its IP header parsed. Frames that are too
+                 *  short, truncated or larger then the given maximum are logged and released. (Clocking
+                 *  thread only.)
+                 * @param maxPktLen Maximum IP packet length.
+                 * @returns VTUNDataFrame* Received frame, or nullptr if none are queued.
+                 */
+                VTUNDataFrame* read(uint32_t maxPktLen);
+                /**
+                 * @brief Returns a frame to the pool. (Clocking thread only.)
+                 * @param dataFrame VTUN data frame.
+                 */
+                void release(VTUNDataFrame* dataFrame);
+
+            private:
+                const char* m_tag;
+
+                VTUNDataFrame* m_frames;
+                SPSCQueue<VTUNDataFrame*> m_pool;
+                SPSCQueue<VTUNDataFrame*> m_rxQueue;
+                std::atomic<uint32_t> m_dropped;
+            };
+        } // namespace packetdata
+    } // namespace callhandler
+} // namespace network
+
+#endif // __PACKETDATA__VTUN_FRAME_POOL_H__
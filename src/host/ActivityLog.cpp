@@ -12,6 +12,7 @@
 */
 #include "ActivityLog.h"
 #include "common/network/BaseNetwork.h"
+#include "common/AsyncFileWriter.h"
 #include "common/Log.h" // for CurrentLogFileLevel() and LogGetNetwork()
 
 #if defined(_WIN32)
@@ -30,6 +31,8 @@
 #include <ctime>
 #include <cassert>
 #include <cstring>
+#include <chrono>
+#include <mutex>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -39,6 +42,9 @@
 
 const uint32_t ACT_LOG_BUFFER_LEN = 501U;
 
+const char CDR_BINARY_MAGIC[] = { 'D', 'V', 'M', 'C', 'D', 'R', 0x01, 0x00 };
+const char CDR_CSV_HEADER[] = "end_time,duration_ms,mode,source,slot,src_id,dst_id,frames,lost,ber,rssi_min,rssi_max,rssi_avg\n";
+
 // ---------------------------------------------------------------------------
 //  Global Variables
 // ---------------------------------------------------------------------------
@@ -46,55 +52,107 @@ const uint32_t ACT_LOG_BUFFER_LEN = 501U;
 static std::string m_actFilePath;
 static std::string m_actFileRoot;
 
-static FILE* m_actFpLog = nullptr;
+static std::mutex m_actMutex;
+static AsyncFileWriter* m_actWriter = nullptr;
+static std::string m_actFileName;
 
 static struct tm m_actTm;
 
+static uint8_t m_cdrFormat = CDR_FORMAT_NONE;
+static AsyncFileWriter* m_cdrWriter = nullptr;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
 
-/* Helper to open the activity log file, file handle. */
+/* Helper to get the current date-rolled activity log (or call detail record) file name. */
 
-static bool ActivityLogOpen()
+static std::string ActivityLogFileName(const char* ext)
 {
-    if (CurrentLogFileLevel() == 0U)
-        return true;
-
     time_t now;
     ::time(&now);
 
     struct tm* tm = ::localtime(&now);
 
-    if (tm->tm_mday == m_actTm.tm_mday && tm->tm_mon == m_actTm.tm_mon && tm->tm_year == m_actTm.tm_year) {
-        if (m_actFpLog != nullptr)
-            return true;
-    }
-    else {
-        if (m_actFpLog != nullptr)
-            ::fclose(m_actFpLog);
+    if (tm->tm_mday != m_actTm.tm_mday || tm->tm_mon != m_actTm.tm_mon || tm->tm_year != m_actTm.tm_year || m_actFileName.empty()) {
+        char filename[200U];
+        ::sprintf(filename, "%s/%s-%04d-%02d-%02d.activity.log", LogGetFilePath().c_str(), LogGetFileRoot().c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
+
+        m_actFileName = std::string(filename);
+        m_actTm = *tm;
     }
 
+    if (ext == nullptr)
+        return m_actFileName;
+
     char filename[200U];
-    ::sprintf(filename, "%s/%s-%04d-%02d-%02d.activity.log", LogGetFilePath().c_str(), LogGetFileRoot().c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
+    ::sprintf(filename, "%s/%s-%04d-%02d-%02d.%s", m_actFilePath.c_str(), m_actFileRoot.c_str(), m_actTm.tm_year + 1900, m_actTm.tm_mon + 1, m_actTm.tm_mday, ext);
+    return std::string(filename);
+}
+
+/* Helper to write an unsigned 16-bit value (little-endian). */
+
+static void SetUInt16LE(uint16_t val, uint8_t* buffer, uint32_t offset)
+{
+    buffer[offset + 0U] = (val >> 0) & 0xFFU;
+    buffer[offset + 1U] = (val >> 8) & 0xFFU;
+}
 
-    m_actFpLog = ::fopen(filename, "a+t");
-    m_actTm = *tm;
+/* Helper to write an unsigned 32-bit value (little-endian). */
 
-    return m_actFpLog != nullptr;
+static void SetUInt32LE(uint32_t val, uint8_t* buffer, uint32_t offset)
+{
+    SetUInt16LE(val & 0xFFFFU, buffer, offset);
+    SetUInt16LE((val >> 16) & 0xFFFFU, buffer, offset + 2U);
 }
 
 /* Initializes the activity log. */
 
-bool ActivityLogInitialise(const std::string& filePath, const std::string& fileRoot)
+bool ActivityLogInitialise(const std::string& filePath, const std::string& fileRoot, uint8_t cdrFormat)
 {
 #if defined(CATCH2_TEST_COMPILATION)
     return true;
 #endif
+    std::lock_guard<std::mutex> lock(m_actMutex);
     m_actFilePath = filePath;
     m_actFileRoot = fileRoot;
+    m_actFileName.clear();
+
+    if (CurrentLogFileLevel() == 0U)
+        return true;
+
+    // the writer thread isn't started until the first entry, but make sure the file can be opened now
+    std::string fileName = ::ActivityLogFileName(nullptr);
+    FILE* fp = ::fopen(fileName.c_str(), "a+t");
+    if (fp == nullptr)
+        return false;
+    ::fclose(fp);
+
+    if (m_actWriter != nullptr)
+        delete m_actWriter;
+    m_actWriter = new AsyncFileWriter("actlog");
+
+    if (m_cdrWriter != nullptr) {
+        delete m_cdrWriter;
+        m_cdrWriter = nullptr;
+    }
+
+    m_cdrFormat = cdrFormat;
+    switch (m_cdrFormat) {
+    case CDR_FORMAT_CSV:
+        m_cdrWriter = new AsyncFileWriter("cdr");
+        m_cdrWriter->setFileHeader(std::string(CDR_CSV_HEADER));
+        break;
+    case CDR_FORMAT_BINARY:
+        m_cdrWriter = new AsyncFileWriter("cdr", true);
+        m_cdrWriter->setFileHeader(std::string(CDR_BINARY_MAGIC, sizeof(CDR_BINARY_MAGIC)));
+        break;
+    default:
+        m_cdrFormat = CDR_FORMAT_NONE;
+        break;
+    }
 
-    return ::ActivityLogOpen();
+    return true;
 }
 
 /* Finalizes the activity log. */
@@ -104,8 +162,26 @@ void ActivityLogFinalise()
 #if defined(CATCH2_TEST_COMPILATION)
     return;
 #endif
-    if (m_actFpLog != nullptr)
-        ::fclose(m_actFpLog);
+    std::lock_guard<std::mutex> lock(m_actMutex);
+    if (m_actWriter != nullptr) {
+        m_actWriter->stop();
+        if (m_actWriter->dropped() > 0U) {
+            LogWarning(LOG_HOST, "Activity log, dropped %llu bytes, disk could not keep up", (unsigned long long)m_actWriter->dropped());
+        }
+
+        delete m_actWriter;
+        m_actWriter = nullptr;
+    }
+
+    if (m_cdrWriter != nullptr) {
+        m_cdrWriter->stop();
+        if (m_cdrWriter->dropped() > 0U) {
+            LogWarning(LOG_HOST, "Call detail records, dropped %llu bytes, disk could not keep up", (unsigned long long)m_cdrWriter->dropped());
+        }
+
+        delete m_cdrWriter;
+        m_cdrWriter = nullptr;
+    }
 }
 
 /* Writes a new entry to the activity log. */
@@ -143,10 +219,6 @@ void ActivityLog(const char *mode, const bool sourceRf, const char* msg, ...)
     va_end(vl_len);
     va_end(vl);
 
-    bool ret = ::ActivityLogOpen();
-    if (!ret)
-        return;
-
     if (LogGetNetwork() != nullptr) {
         network::BaseNetwork* network = (network::BaseNetwork*)LogGetNetwork();;
         network->writeActLog(buffer);
@@ -155,11 +227,83 @@ void ActivityLog(const char *mode, const bool sourceRf, const char* msg, ...)
     if (CurrentLogFileLevel() == 0U)
         return;
 
-    ::fprintf(m_actFpLog, "%s\n", buffer);
-    ::fflush(m_actFpLog);
+    {
+        std::lock_guard<std::mutex> lock(m_actMutex);
+        if (m_actWriter == nullptr)
+            return;
+
+        std::string line = std::string(buffer) + "\n";
+        m_actWriter->write(::ActivityLogFileName(nullptr), line.c_str(), line.size());
+    }
 
     if (2U >= g_logDisplayLevel && g_logDisplayLevel != 0U) {
         ::fprintf(stdout, "%s" EOL, buffer);
         ::fflush(stdout);
     }
 }
+
+/* Writes a call detail record for a completed (or lost) voice call. */
+
+void ActivityLogCDR(uint8_t mode, bool sourceRf, uint8_t slot, uint32_t srcId, uint32_t dstId,
+    uint32_t durationMs, uint32_t frames, uint32_t lost, float ber, uint32_t minRSSI, uint32_t maxRSSI, uint32_t aveRSSI)
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return;
+#endif
+    if (m_cdrFormat == CDR_FORMAT_NONE)
+        return;
+
+    uint64_t endTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    if (ber < 0.0F)
+        ber = 0.0F;
+
+    std::lock_guard<std::mutex> lock(m_actMutex);
+    if (m_cdrWriter == nullptr)
+        return;
+
+    if (m_cdrFormat == CDR_FORMAT_BINARY) {
+        uint8_t record[CDR_BINARY_RECORD_LEN];
+        ::memset(record, 0x00U, CDR_BINARY_RECORD_LEN);
+
+        SetUInt32LE((uint32_t)(endTime & 0xFFFFFFFFU), record, 0U);
+        SetUInt32LE((uint32_t)(endTime >> 32), record, 4U);
+        SetUInt32LE(durationMs, record, 8U);
+        record[12U] = mode;
+        record[13U] = sourceRf ? 0x01U : 0x00U;
+        record[14U] = slot;
+        SetUInt32LE(srcId, record, 16U);
+        SetUInt32LE(dstId, record, 20U);
+        SetUInt32LE(frames, record, 24U);
+        SetUInt32LE(lost, record, 28U);
+
+        float berHundredths = ber * 100.0F;
+        SetUInt16LE((berHundredths > 65535.0F) ? 0xFFFFU : (uint16_t)(berHundredths + 0.5F), record, 32U);
+        record[34U] = (minRSSI > 0xFFU) ? 0xFFU : (uint8_t)minRSSI;
+        record[35U] = (maxRSSI > 0xFFU) ? 0xFFU : (uint8_t)maxRSSI;
+        record[36U] = (aveRSSI > 0xFFU) ? 0xFFU : (uint8_t)aveRSSI;
+
+        m_cdrWriter->write(::ActivityLogFileName("cdr.bin"), (const char*)record, CDR_BINARY_RECORD_LEN);
+    }
+    else {
+        const char* modeStr = "DMR";
+        switch (mode) {
+        case CDR_MODE_P25:
+            modeStr = "P25";
+            break;
+        case CDR_MODE_NXDN:
+            modeStr = "NXDN";
+            break;
+        default:
+            break;
+        }
+
+        char line[ACT_LOG_BUFFER_LEN];
+        int len = ::snprintf(line, ACT_LOG_BUFFER_LEN, "%llu,%u,%s,%s,%u,%u,%u,%u,%u,%.2f,%u,%u,%u\n",
+            (unsigned long long)endTime, durationMs, modeStr, sourceRf ? "RF" : "Net", slot, srcId, dstId,
+            frames, lost, ber, minRSSI, maxRSSI, aveRSSI);
+        if (len <= 0)
+            return;
+
+        m_cdrWriter->write(::ActivityLogFileName("cdr.csv"), line, (size_t)len);
+    }
+}
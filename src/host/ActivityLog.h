@@ -20,6 +20,33 @@
 
 #include <string>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup host
+ * @{
+ */
+
+/** @brief Call detail records are not written. */
+const uint8_t   CDR_FORMAT_NONE = 0U;
+/** @brief Call detail records are written as CSV lines. */
+const uint8_t   CDR_FORMAT_CSV = 1U;
+/** @brief Call detail records are written as fixed length binary records. */
+const uint8_t   CDR_FORMAT_BINARY = 2U;
+
+/** @brief DMR call detail record. */
+const uint8_t   CDR_MODE_DMR = 1U;
+/** @brief P25 call detail record. */
+const uint8_t   CDR_MODE_P25 = 2U;
+/** @brief NXDN call detail record. */
+const uint8_t   CDR_MODE_NXDN = 3U;
+
+/** @brief Length of a binary call detail record. */
+const uint32_t  CDR_BINARY_RECORD_LEN = 40U;
+/** @} */
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -28,8 +55,9 @@
  * @brief Initializes the activity log.
  * @param filePath File path for the log file.
  * @param fileRoot Root name for log file.
+ * @param cdrFormat Call detail record format (CDR_FORMAT_NONE, CDR_FORMAT_CSV or CDR_FORMAT_BINARY).
  */
-extern HOST_SW_API bool ActivityLogInitialise(const std::string& filePath, const std::string& fileRoot);
+extern HOST_SW_API bool ActivityLogInitialise(const std::string& filePath, const std::string& fileRoot, uint8_t cdrFormat = CDR_FORMAT_NONE);
 /**
  * @brief Finalizes the activity log.
  */
@@ -43,5 +71,29 @@ extern HOST_SW_API void ActivityLogFinalise();
  * This is a variable argument function.
  */
 extern HOST_SW_API void ActivityLog(const char* mode, const bool sourceRf, const char* msg, ...);
+/**
+ * @brief Writes a call detail record for a completed (or lost) voice call.
+ * @param mode Call mode (CDR_MODE_DMR, CDR_MODE_P25 or CDR_MODE_NXDN).
+ * @param sourceRf Flag indicating whether or not the call came from RF.
+ * @param slot DMR slot (0 for other modes).
+ * @param srcId Source ID.
+ * @param dstId Destination ID.
+ * @param durationMs Call duration (ms).
+ * @param frames Number of voice frames.
+ * @param lost Number of lost frames (network) or bit errors (RF).
+ * @param ber Bit error rate (percent).
+ * @param minRSSI Minimum RSSI (-dBm, 0 if not available).
+ * @param maxRSSI Maximum RSSI (-dBm, 0 if not available).
+ * @param aveRSSI Average RSSI (-dBm, 0 if not available).
+ * 
+ *  The binary format is a file header ("DVMCDR", version byte, reserved byte) followed by
+ *  fixed CDR_BINARY_RECORD_LEN byte little-endian records:
+ *  uint64 end time (ms since epoch), uint32 duration (ms), uint8 mode, uint8 flags (bit 0 = RF),
+ *  uint8 slot, 1 reserved byte, uint32 source ID, uint32 destination ID, uint32 frames,
+ *  uint32 lost, uint16 BER (hundredths of a percent), uint8 min/max/average RSSI,
+ *  3 reserved bytes.
+ */
+extern HOST_SW_API void ActivityLogCDR(uint8_t mode, bool sourceRf, uint8_t slot, uint32_t srcId, uint32_t dstId,
+    uint32_t durationMs, uint32_t frames, uint32_t lost, float ber, uint32_t minRSSI, uint32_t maxRSSI, uint32_t aveRSSI);
 
 #endif // __ACTIVITY_LOG_H__
@@ -18,6 +18,7 @@
 #include "common/Utils.h"
 #include "modem/port/specialized/V24UDPPort.h"
 #include "remote/RESTClient.h"
+#include "remote/RESTSession.h"
 #include "host/Host.h"
 #include "ActivityLog.h"
 #include "HostMain.h"
@@ -194,7 +195,16 @@ int Host::run()
         ::fatal("unable to open the log file\n");
     }
 
-    ret = ::ActivityLogInitialise(logConf["activityFilePath"].as<std::string>(), logConf["fileRoot"].as<std::string>());
+    uint8_t cdrFormat = CDR_FORMAT_NONE;
+    std::string cdrFormatStr = logConf["cdrFormat"].as<std::string>("none");
+    if (cdrFormatStr == "csv") {
+        cdrFormat = CDR_FORMAT_CSV;
+    }
+    else if (cdrFormatStr == "binary") {
+        cdrFormat = CDR_FORMAT_BINARY;
+    }
+
+    ret = ::ActivityLogInitialise(logConf["activityFilePath"].as<std::string>(), logConf["fileRoot"].as<std::string>(), cdrFormat);
     if (!ret) {
         ::fatal("unable to open the activity log file\n");
     }
@@ -1657,6 +1667,8 @@ void Host::setState(uint8_t state)
                     delete m_RESTAPI;
                 }
 
+                RESTSession::closeAll();
+
                 if (m_channelLookup != nullptr) {
                     delete m_channelLookup;
                 }
@@ -2085,11 +2097,13 @@ void* Host::threadPresence(void* arg)
                         req["restAddress"].set<std::string>(host->m_restAddress);
                         req["restPort"].set<uint16_t>(host->m_restPort);
 
-                        int ret = RESTClient::send(host->m_controlChData.address(), host->m_controlChData.port(), host->m_controlChData.password(),
-                            HTTP_PUT, PUT_REGISTER_CC_VC, req, host->m_controlChData.ssl(), REST_QUICK_WAIT, false);
-                        if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                            ::LogError(LOG_HOST, "failed to notify the CC %s:%u of VC registration", host->m_controlChData.address().c_str(), host->m_controlChData.port());
-                        }
+                        std::string ccAddress = host->m_controlChData.address();
+                        uint16_t ccPort = host->m_controlChData.port();
+                        RESTClient::sendAsync(ccAddress, ccPort, host->m_controlChData.password(), HTTP_PUT, PUT_REGISTER_CC_VC, req, [=](int ret, json::object&) {
+                            if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                                ::LogError(LOG_HOST, "failed to notify the CC %s:%u of VC registration", ccAddress.c_str(), ccPort);
+                            }
+                        }, host->m_controlChData.ssl(), REST_QUICK_WAIT, false);
 
                         presenceNotifyTimer.start();
                     }
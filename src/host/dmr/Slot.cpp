@@ -929,8 +929,11 @@ void Slot::init(Control* dmr, bool authoritative, uint32_t colorCode, SiteData s
                 bool clear = true;
                 req["clear"].set<bool>(clear);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, voiceChData.ssl(), REST_QUICK_WAIT, tscc->m_debug);
+                RESTClient::sendAsync(voiceChData.address(), voiceChData.port(), voiceChData.password(), HTTP_PUT, PUT_DMR_TSCC_PAYLOAD_ACT, req, [=](int ret, json::object&) {
+                    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                        ::LogError(LOG_DMR, "DMR Slot %u, CSBK, RAND (Random Access), failed to clear payload channel, chNo = %u, slot = %u", tscc->m_slotNo, chNo, slot);
+                    }
+                }, voiceChData.ssl(), REST_QUICK_WAIT, tscc->m_debug);
             }
             else {
                 ::LogError(LOG_DMR, "DMR Slot %u, CSBK, RAND (Random Access), failed to clear payload channel, chNo = %u, slot = %u", tscc->m_slotNo, chNo, slot);
@@ -946,8 +949,11 @@ void Slot::init(Control* dmr, bool authoritative, uint32_t colorCode, SiteData s
                     req["dstId"].set<uint32_t>(dstId);
                     req["slot"].set<uint8_t>(slot);
 
-                    RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                        HTTP_PUT, PUT_PERMIT_TG, req, voiceChData.ssl(), REST_QUICK_WAIT, m_dmr->m_debug);
+                    RESTClient::sendAsync(voiceChData.address(), voiceChData.port(), voiceChData.password(), HTTP_PUT, PUT_PERMIT_TG, req, [=](int ret, json::object&) {
+                        if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                            ::LogError(LOG_DMR, "DMR Slot %u, CSBK, RAND (Random Access), failed to clear TG permit, chNo = %u, slot = %u", tscc->m_slotNo, chNo, slot);
+                        }
+                    }, voiceChData.ssl(), REST_QUICK_WAIT, m_dmr->m_debug);
                 }
                 else {
                     ::LogError(LOG_DMR, "DMR Slot %u, CSBK, RAND (Random Access), failed to clear TG permit, chNo = %u, slot = %u", tscc->m_slotNo, chNo, slot);
@@ -1094,6 +1100,13 @@ void Slot::processFrameLoss()
                 m_slotNo, float(m_rfFrames) / 16.667F, float(m_rfErrs * 100U) / float(m_rfBits), m_frameLossCnt);
         }
 
+        if (m_rfLC != nullptr) {
+            bool rssi = m_rssi != 0U && m_rssiCount > 0U;
+            ::ActivityLogCDR(CDR_MODE_DMR, true, m_slotNo, m_rfLC->getSrcId(), m_rfLC->getDstId(),
+                m_rfFrames * 60U, m_rfFrames, m_rfErrs, (m_rfBits > 0U) ? float(m_rfErrs * 100U) / float(m_rfBits) : 0.0F,
+                rssi ? m_minRSSI : 0U, rssi ? m_maxRSSI : 0U, rssi ? m_aveRSSI / m_rssiCount : 0U);
+        }
+
         LogMessage(LOG_RF, "DMR Slot %u, total frames: %d, total bits: %d, errors: %d, BER: %.4f%%",
             m_slotNo, m_rfFrames, m_rfBits, m_rfErrs, float(m_rfErrs * 100U) / float(m_rfBits));
 
@@ -1158,11 +1171,13 @@ void Slot::notifyCC_ReleaseGrant(uint32_t dstId)
     uint8_t slot = m_slotNo;
     req["slot"].set<uint8_t>(slot);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_RELEASE_TG, req, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the release of, dstId = %u", m_slotNo, m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    std::string ccAddress = m_controlChData.address();
+    uint16_t ccPort = m_controlChData.port();
+    RESTClient::sendAsync(ccAddress, ccPort, m_controlChData.password(), HTTP_PUT, PUT_RELEASE_TG, req, [=](int ret, json::object&) {
+        if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+            ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the release of, dstId = %u", m_slotNo, ccAddress.c_str(), ccPort, dstId);
+        }
+    }, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
 
     m_rfLastDstId = 0U;
     m_rfLastSrcId = 0U;
@@ -1194,11 +1209,13 @@ void Slot::notifyCC_TouchGrant(uint32_t dstId)
     uint8_t slot = m_slotNo;
     req["slot"].set<uint8_t>(slot);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_TOUCH_TG, req, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the touch of, dstId = %u", m_slotNo, m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    std::string ccAddress = m_controlChData.address();
+    uint16_t ccPort = m_controlChData.port();
+    RESTClient::sendAsync(ccAddress, ccPort, m_controlChData.password(), HTTP_PUT, PUT_TOUCH_TG, req, [=](int ret, json::object&) {
+        if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+            ::LogError(LOG_DMR, "DMR Slot %u, failed to notify the CC %s:%u of the touch of, dstId = %u", m_slotNo, ccAddress.c_str(), ccPort, dstId);
+        }
+    }, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
 }
 
 /* Write data frame to the network. */
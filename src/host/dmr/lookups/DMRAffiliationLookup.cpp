@@ -93,7 +93,7 @@ bool DMRAffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll, bool no
     }
 
     if (!noLock)
-        m_mutex.lock();
+        m_grantMutex.lock();
 
     // are we trying to release all grants?
     if (dstId == 0U && releaseAll) {
@@ -107,11 +107,11 @@ bool DMRAffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll, bool no
 
         // release grants
         for (uint32_t dstId : gntsToRel) {
-            releaseGrant(dstId, false);
+            releaseGrant(dstId, false, true);
         }
 
         if (!noLock)
-            m_mutex.unlock();
+            m_grantMutex.unlock();
         return true;
     }
 
@@ -146,12 +146,12 @@ bool DMRAffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll, bool no
         m_grantTimers[dstId].stop();
 
         if (!noLock)
-            m_mutex.unlock();
+            m_grantMutex.unlock();
         return true;
     }
 
     if (!noLock)
-        m_mutex.unlock();
+        m_grantMutex.unlock();
     return false;
 }
 
@@ -136,6 +136,12 @@ bool Data::process(uint8_t* data, uint32_t len)
                 m_slot->m_slotNo, float(m_slot->m_rfFrames) / 16.667F, float(m_slot->m_rfErrs * 100U) / float(m_slot->m_rfBits));
         }
 
+        bool rssi = m_slot->m_rssi != 0U && m_slot->m_rssiCount > 0U;
+        ::ActivityLogCDR(CDR_MODE_DMR, true, m_slot->m_slotNo, m_slot->m_rfLC->getSrcId(), m_slot->m_rfLC->getDstId(),
+            m_slot->m_rfFrames * 60U, m_slot->m_rfFrames, m_slot->m_rfErrs,
+            (m_slot->m_rfBits > 0U) ? float(m_slot->m_rfErrs * 100U) / float(m_slot->m_rfBits) : 0.0F,
+            rssi ? m_slot->m_minRSSI : 0U, rssi ? m_slot->m_maxRSSI : 0U, rssi ? m_slot->m_aveRSSI / m_slot->m_rssiCount : 0U);
+
         LogMessage(LOG_RF, "DMR Slot %u, total frames: %d, total bits: %d, errors: %d, BER: %.4f%%",
             m_slot->m_slotNo, m_slot->m_rfFrames, m_slot->m_rfBits, m_slot->m_rfErrs, float(m_slot->m_rfErrs * 100U) / float(m_slot->m_rfBits));
 
@@ -397,6 +403,9 @@ void Data::processNetwork(const data::NetData& dmrData)
         m_slot->m_netFrames += 2U;
         ::ActivityLog("DMR", false, "Slot %u network end of voice transmission, %.1f seconds, %u%% packet loss, BER: %.1f%%",
             m_slot->m_slotNo, float(m_slot->m_netFrames) / 16.667F, (m_slot->m_netLost * 100U) / m_slot->m_netFrames, float(m_slot->m_netErrs * 100U) / float(m_slot->m_netBits));
+        ::ActivityLogCDR(CDR_MODE_DMR, false, m_slot->m_slotNo, m_slot->m_netLC->getSrcId(), m_slot->m_netLC->getDstId(),
+            m_slot->m_netFrames * 60U, m_slot->m_netFrames, m_slot->m_netLost,
+            (m_slot->m_netBits > 0U) ? float(m_slot->m_netErrs * 100U) / float(m_slot->m_netBits) : 0.0F, 0U, 0U, 0U);
 
         m_slot->m_dmr->tsccClearActivatedSlot(m_slot->m_slotNo);
 
@@ -217,8 +217,9 @@ void Network::clock(uint32_t ms)
     frame::RTPFNEHeader fneHeader;
     int length = 0U;
 
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+    // read message (the packet buffer is pooled, so this does not allocate per frame)
+    PacketBuffer packet = m_frameQueue->readPacket(length, address, addrLen, &rtpHeader, &fneHeader);
+    uint8_t* buffer = packet.data();
     if (length > 0) {
         if (!udp::Socket::match(m_addr, address)) {
             LogError(LOG_NET, "Packet received from an invalid source");
@@ -280,13 +281,13 @@ void Network::clock(uint32_t ms)
                         }
                        
                         if (m_debug)
-                            Utils::dump(1U, "Network Received, DMR", buffer.get(), length);
+                            Utils::dump(1U, "Network Received, DMR", buffer, length);
                         if (length > 255)
                             LogError(LOG_NET, "DMR Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
 
                         uint8_t len = length;
                         m_rxDMRData.addData(&len, 1U);
-                        m_rxDMRData.addData(buffer.get(), len);
+                        m_rxDMRData.addData(buffer, len);
                     }
                 }
                 else if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_P25) {         // Encapsulated P25 data frame
@@ -308,13 +309,13 @@ void Network::clock(uint32_t ms)
                         }
 
                         if (m_debug)
-                            Utils::dump(1U, "Network Received, P25", buffer.get(), length);
+                            Utils::dump(1U, "Network Received, P25", buffer, length);
                         if (length > 255)
                             LogError(LOG_NET, "P25 Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
 
                         uint8_t len = length;
                         m_rxP25Data.addData(&len, 1U);
-                        m_rxP25Data.addData(buffer.get(), len);
+                        m_rxP25Data.addData(buffer, len);
                     }
                 }
                 else if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN) {        // Encapsulated NXDN data frame
@@ -336,17 +337,17 @@ void Network::clock(uint32_t ms)
                         }
 
                         if (m_debug)
-                            Utils::dump(1U, "Network Received, NXDN", buffer.get(), length);
+                            Utils::dump(1U, "Network Received, NXDN", buffer, length);
                         if (length > 255)
                             LogError(LOG_NET, "NXDN Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
 
                         uint8_t len = length;
                         m_rxNXDNData.addData(&len, 1U);
-                        m_rxNXDNData.addData(buffer.get(), len);
+                        m_rxNXDNData.addData(buffer, len);
                     }
                 }
                 else {
-                    Utils::dump("unknown protocol opcode from the master", buffer.get(), length);
+                    Utils::dump("unknown protocol opcode from the master", buffer, length);
                 }
             }
             break;
@@ -356,7 +357,7 @@ void Network::clock(uint32_t ms)
                 if (fneHeader.getSubFunction() == NET_SUBFUNC::MASTER_SUBFUNC_WL_RID) {         // Radio ID Whitelist
                     if (m_enabled && m_updateLookup) {
                         if (m_debug)
-                            Utils::dump(1U, "Network Received, WL RID", buffer.get(), length);
+                            Utils::dump(1U, "Network Received, WL RID", buffer, length);
 
                         if (m_ridLookup != nullptr) {
                             // update RID lists
@@ -380,7 +381,7 @@ void Network::clock(uint32_t ms)
                 else if (fneHeader.getSubFunction() == NET_SUBFUNC::MASTER_SUBFUNC_BL_RID) {        // Radio ID Blacklist
                     if (m_enabled && m_updateLookup) {
                         if (m_debug)
-                            Utils::dump(1U, "Network Received, BL RID", buffer.get(), length);
+                            Utils::dump(1U, "Network Received, BL RID", buffer, length);
 
                         if (m_ridLookup != nullptr) {
                             // update RID lists
@@ -404,7 +405,7 @@ void Network::clock(uint32_t ms)
                 else if (fneHeader.getSubFunction() == NET_SUBFUNC::MASTER_SUBFUNC_ACTIVE_TGS) {    // Talkgroup Active IDs
                     if (m_enabled && m_updateLookup) {
                         if (m_debug)
-                            Utils::dump(1U, "Network Received, ACTIVE TGS", buffer.get(), length);
+                            Utils::dump(1U, "Network Received, ACTIVE TGS", buffer, length);
 
                         if (m_tidLookup != nullptr) {
                             // update TGID lists
@@ -452,7 +453,7 @@ void Network::clock(uint32_t ms)
                 else if (fneHeader.getSubFunction() == NET_SUBFUNC::MASTER_SUBFUNC_DEACTIVE_TGS) {  // Talkgroup Deactivated IDs
                     if (m_enabled && m_updateLookup) {
                         if (m_debug)
-                            Utils::dump(1U, "Network Received, DEACTIVE TGS", buffer.get(), length);
+                            Utils::dump(1U, "Network Received, DEACTIVE TGS", buffer, length);
 
                         if (m_tidLookup != nullptr) {
                             // update TGID lists
@@ -481,7 +482,7 @@ void Network::clock(uint32_t ms)
                     }
                 }
                 else {
-                    Utils::dump("unknown master control opcode from the master", buffer.get(), length);
+                    Utils::dump("unknown master control opcode from the master", buffer, length);
                 }
             }
             break;
@@ -550,7 +551,7 @@ void Network::clock(uint32_t ms)
                     case NET_STAT_WAITING_LOGIN:
                         LogDebug(LOG_NET, "PEER %u RPTL ACK, performing login exchange, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
 
-                        ::memcpy(m_salt, buffer.get() + 6U, sizeof(uint32_t));
+                        ::memcpy(m_salt, buffer + 6U, sizeof(uint32_t));
                         writeAuthorisation();
 
                         m_status = NET_STAT_WAITING_AUTHORISATION;
@@ -601,7 +602,7 @@ void Network::clock(uint32_t ms)
             m_timeoutTimer.start();
             if (length >= 14) {
                 if (m_debug)
-                    Utils::dump(1U, "Network Received, PONG", buffer.get(), length);
+                    Utils::dump(1U, "Network Received, PONG", buffer, length);
 
                 ulong64_t serverNow = 0U;
 
@@ -623,7 +624,7 @@ void Network::clock(uint32_t ms)
             break;
         default:
             userPacketHandler(fneHeader.getPeerId(), { fneHeader.getFunction(), fneHeader.getSubFunction() }, 
-                buffer.get(), length, fneHeader.getStreamId());
+                buffer, length, fneHeader.getStreamId());
             break;
         }
     }
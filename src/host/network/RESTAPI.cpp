@@ -18,6 +18,7 @@
 #include "nxdn/Control.h"
 #include "modem/Modem.h"
 #include "network/RESTAPI.h"
+#include "remote/RESTSession.h"
 #include "Host.h"
 #include "HostMain.h"
 
@@ -516,6 +517,19 @@ void RESTAPI::restAPI_GetVoiceCh(const HTTPPayload& request, HTTPPayload& reply,
             uint16_t port = data.port();
             channel["port"].set<uint16_t>(port);
 
+            // control session statistics, if the channel has been contacted
+            RESTSessionStats stats;
+            if (RESTSession::getStats(address, port, stats)) {
+                json::object session = json::object();
+                session["requests"].set<uint32_t>(stats.requests);
+                session["failures"].set<uint32_t>(stats.failures);
+                session["connects"].set<uint32_t>(stats.connects);
+                session["lastRtt"].set<uint32_t>(stats.lastRtt);
+                session["avgRtt"].set<uint32_t>(stats.avgRtt);
+                session["maxRtt"].set<uint32_t>(stats.maxRtt);
+                channel["session"].set<json::object>(session);
+            }
+
             channels.push_back(json::value(channel));
         }
     }
@@ -1593,19 +1607,13 @@ void RESTAPI::restAPI_GetDMRAffList(const HTTPPayload& request, HTTPPayload& rep
 
     json::array affs = json::array();
     if (m_dmr->affiliations() != nullptr) {
-        std::unordered_map<uint32_t, uint32_t> affTable = m_dmr->affiliations()->grpAffTable();
-        if (affTable.size() > 0) {
-            for (auto entry : affTable) {
-                uint32_t srcId = entry.first;
-                uint32_t grpId = entry.second;
-
-                json::object aff = json::object();
-                aff["srcId"].set<uint32_t>(srcId);
-                aff["grpId"].set<uint32_t>(grpId);
+        m_dmr->affiliations()->forEachGrpAff([&](uint32_t srcId, uint32_t grpId) {
+            json::object aff = json::object();
+            aff["srcId"].set<uint32_t>(srcId);
+            aff["grpId"].set<uint32_t>(grpId);
 
-                affs.push_back(json::value(aff));
-            }
-        }
+            affs.push_back(json::value(aff));
+        });
     }
 
     response["affiliations"].set<json::array>(affs);
@@ -1966,19 +1974,13 @@ void RESTAPI::restAPI_GetP25AffList(const HTTPPayload& request, HTTPPayload& rep
     setResponseDefaultStatus(response);
 
     json::array affs = json::array();
-    std::unordered_map<uint32_t, uint32_t> affTable = m_p25->affiliations().grpAffTable();
-    if (affTable.size() > 0) {
-        for (auto entry : affTable) {
-            uint32_t srcId = entry.first;
-            uint32_t grpId = entry.second;
+    m_p25->affiliations().forEachGrpAff([&](uint32_t srcId, uint32_t grpId) {
+        json::object aff = json::object();
+        aff["srcId"].set<uint32_t>(srcId);
+        aff["grpId"].set<uint32_t>(grpId);
 
-            json::object aff = json::object();
-            aff["srcId"].set<uint32_t>(srcId);
-            aff["grpId"].set<uint32_t>(grpId);
-
-            affs.push_back(json::value(aff));
-        }
-    }
+        affs.push_back(json::value(aff));
+    });
 
     response["affiliations"].set<json::array>(affs);
     reply.payload(response);
@@ -2133,19 +2135,13 @@ void RESTAPI::restAPI_GetNXDNAffList(const HTTPPayload& request, HTTPPayload& re
     setResponseDefaultStatus(response);
 
     json::array affs = json::array();
-    std::unordered_map<uint32_t, uint32_t> affTable = m_nxdn->affiliations().grpAffTable();
-    if (affTable.size() > 0) {
-        for (auto entry : affTable) {
-            uint32_t srcId = entry.first;
-            uint32_t grpId = entry.second;
+    m_nxdn->affiliations().forEachGrpAff([&](uint32_t srcId, uint32_t grpId) {
+        json::object aff = json::object();
+        aff["srcId"].set<uint32_t>(srcId);
+        aff["grpId"].set<uint32_t>(grpId);
 
-            json::object aff = json::object();
-            aff["srcId"].set<uint32_t>(srcId);
-            aff["grpId"].set<uint32_t>(grpId);
-
-            affs.push_back(json::value(aff));
-        }
-    }
+        affs.push_back(json::value(aff));
+    });
 
     response["affiliations"].set<json::array>(affs);
     reply.payload(response);
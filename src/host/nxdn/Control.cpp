@@ -270,8 +270,11 @@ void Control::setOptions(yaml::Node& conf, bool supervisor, const std::string cw
                 dstId = 0U; // clear TG value
                 req["dstId"].set<uint32_t>(dstId);
 
-                RESTClient::send(voiceChData.address(), voiceChData.port(), voiceChData.password(),
-                    HTTP_PUT, PUT_PERMIT_TG, req, voiceChData.ssl(), REST_QUICK_WAIT, m_debug);
+                RESTClient::sendAsync(voiceChData.address(), voiceChData.port(), voiceChData.password(), HTTP_PUT, PUT_PERMIT_TG, req, [=](int ret, json::object&) {
+                    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+                        ::LogError(LOG_NXDN, "NXDN, " NXDN_RTCH_MSG_TYPE_VCALL_RESP ", failed to clear TG permit, chNo = %u", chNo);
+                    }
+                }, voiceChData.ssl(), REST_QUICK_WAIT, m_debug);
             }
             else {
                 ::LogError(LOG_NXDN, "NXDN, " NXDN_RTCH_MSG_TYPE_VCALL_RESP ", failed to clear TG permit, chNo = %u", chNo);
@@ -1011,6 +1014,12 @@ void Control::processFrameLoss()
                 float(m_voice->m_rfFrames) / 12.5F, float(m_voice->m_rfErrs * 100U) / float(m_voice->m_rfBits), m_frameLossCnt);
         }
 
+        bool rssi = m_rssi != 0U && m_rssiCount > 0U;
+        ::ActivityLogCDR(CDR_MODE_NXDN, true, 0U, m_rfLC.getSrcId(), m_rfLC.getDstId(),
+            m_voice->m_rfFrames * 80U, m_voice->m_rfFrames, m_voice->m_rfErrs,
+            (m_voice->m_rfBits > 0U) ? float(m_voice->m_rfErrs * 100U) / float(m_voice->m_rfBits) : 0.0F,
+            rssi ? m_minRSSI : 0U, rssi ? m_maxRSSI : 0U, rssi ? m_aveRSSI / m_rssiCount : 0U);
+
         LogMessage(LOG_RF, "NXDN, " NXDN_RTCH_MSG_TYPE_TX_REL ", total frames: %d, bits: %d, undecodable LC: %d, errors: %d, BER: %.4f%%",
             m_voice->m_rfFrames, m_voice->m_rfBits, m_voice->m_rfUndecodableLC, m_voice->m_rfErrs, float(m_voice->m_rfErrs * 100U) / float(m_voice->m_rfBits));
 
@@ -1058,11 +1067,13 @@ void Control::notifyCC_ReleaseGrant(uint32_t dstId)
     req["state"].set<int>(state);
     req["dstId"].set<uint32_t>(dstId);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_RELEASE_TG, req, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the release of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    std::string ccAddress = m_controlChData.address();
+    uint16_t ccPort = m_controlChData.port();
+    RESTClient::sendAsync(ccAddress, ccPort, m_controlChData.password(), HTTP_PUT, PUT_RELEASE_TG, req, [=](int ret, json::object&) {
+        if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+            ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the release of, dstId = %u", ccAddress.c_str(), ccPort, dstId);
+        }
+    }, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
 
     m_rfLastDstId = 0U;
     m_rfLastSrcId = 0U;
@@ -1092,11 +1103,13 @@ void Control::notifyCC_TouchGrant(uint32_t dstId)
     req["state"].set<int>(state);
     req["dstId"].set<uint32_t>(dstId);
 
-    int ret = RESTClient::send(m_controlChData.address(), m_controlChData.port(), m_controlChData.password(),
-        HTTP_PUT, PUT_TOUCH_TG, req, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
-    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-        ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the touch of, dstId = %u", m_controlChData.address().c_str(), m_controlChData.port(), dstId);
-    }
+    std::string ccAddress = m_controlChData.address();
+    uint16_t ccPort = m_controlChData.port();
+    RESTClient::sendAsync(ccAddress, ccPort, m_controlChData.password(), HTTP_PUT, PUT_TOUCH_TG, req, [=](int ret, json::object&) {
+        if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+            ::LogError(LOG_NXDN, "failed to notify the CC %s:%u of the touch of, dstId = %u", ccAddress.c_str(), ccPort, dstId);
+        }
+    }, m_controlChData.ssl(), REST_QUICK_WAIT, m_debug);
 }
 
 /* Helper to write control channel frame data. */
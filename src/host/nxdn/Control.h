@@ -209,7 +209,7 @@ namespace nxdn
          * @brief Gets instance of the AffiliationLookup class.
          * @returns AffiliationLookup Instance of the AffiliationLookup class.
          */
-        lookups::AffiliationLookup affiliations() { return m_affiliations; }
+        lookups::AffiliationLookup& affiliations() { return m_affiliations; }
 
         /**
          * @brief Flag indicating whether the processor or is busy or not.
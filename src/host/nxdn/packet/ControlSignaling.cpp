@@ -150,7 +150,8 @@ bool ControlSignaling::process(FuncChannelType::E fct, ChOption::E option, uint8
     uint8_t buffer[NXDN_FRAME_LENGTH_BYTES];
     cac.getData(buffer);
 
-    std::unique_ptr<RCCH> rcch = rcch::RCCHFactory::createRCCH(buffer, NXDN_RCCH_CAC_LC_SHORT_LENGTH_BITS);
+    rcch::RCCHStorage storage;
+    RCCH* rcch = rcch::RCCHFactory::decodeRCCH(buffer, NXDN_RCCH_CAC_LC_SHORT_LENGTH_BITS, storage);
     if (rcch == nullptr)
         return false;
 
@@ -237,7 +238,8 @@ bool ControlSignaling::processNetwork(FuncChannelType::E fct, ChOption::E option
     }
 
     if (m_nxdn->m_netState == RS_NET_IDLE) {
-        std::unique_ptr<lc::RCCH> rcch = RCCHFactory::createRCCH(data, len);
+        RCCHStorage storage;
+        lc::RCCH* rcch = RCCHFactory::decodeRCCH(data, len, storage);
         if (rcch == nullptr) {
             return false;
         }
@@ -272,7 +274,7 @@ bool ControlSignaling::processNetwork(FuncChannelType::E fct, ChOption::E option
                 return false;
         } // switch (rcch->getMessageType())
 
-        writeRF_Message(rcch.get(), true);
+        writeRF_Message(rcch, true);
     }
 
     return true;
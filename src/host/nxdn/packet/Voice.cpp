@@ -315,6 +315,11 @@ bool Voice::process(FuncChannelType::E fct, ChOption::E option, uint8_t* data, u
                     float(m_rfFrames) / 12.5F, float(m_rfErrs * 100U) / float(m_rfBits));
             }
 
+            bool rssi = m_nxdn->m_rssi != 0U && m_nxdn->m_rssiCount > 0U;
+            ::ActivityLogCDR(CDR_MODE_NXDN, true, 0U, m_nxdn->m_rfLC.getSrcId(), m_nxdn->m_rfLC.getDstId(),
+                m_rfFrames * 80U, m_rfFrames, m_rfErrs, (m_rfBits > 0U) ? float(m_rfErrs * 100U) / float(m_rfBits) : 0.0F,
+                rssi ? m_nxdn->m_minRSSI : 0U, rssi ? m_nxdn->m_maxRSSI : 0U, rssi ? m_nxdn->m_aveRSSI / m_nxdn->m_rssiCount : 0U);
+
             LogMessage(LOG_RF, "NXDN, " NXDN_RTCH_MSG_TYPE_TX_REL ", total frames: %d, bits: %d, undecodable LC: %d, errors: %d, BER: %.4f%%",
                 m_rfFrames, m_rfBits, m_rfUndecodableLC, m_rfErrs, float(m_rfErrs * 100U) / float(m_rfBits));
 
@@ -753,6 +758,8 @@ bool Voice::processNetwork(FuncChannelType::E fct, ChOption::E option, lc::RTCH&
             m_netFrames++;
             ::ActivityLog("NXDN", false, "network end of transmission, %.1f seconds",
                 float(m_netFrames) / 12.5F);
+            ::ActivityLogCDR(CDR_MODE_NXDN, false, 0U, m_nxdn->m_netLC.getSrcId(), m_nxdn->m_netLC.getDstId(),
+                m_netFrames * 80U, m_netFrames, m_netLost, 0.0F, 0U, 0U, 0U);
 
             LogMessage(LOG_NET, "NXDN, " NXDN_RTCH_MSG_TYPE_TX_REL ", total frames: %d", m_netFrames);
 
@@ -236,7 +236,7 @@ namespace p25
          * @brief Gets instance of the P25AffiliationLookup class.
          * @returns P25AffiliationLookup Instance of the P25AffiliationLookup class.
          */
-        lookups::P25AffiliationLookup affiliations() { return m_affiliations; }
+        lookups::P25AffiliationLookup& affiliations() { return m_affiliations; }
 
         /**
          * @brief Flag indicating whether the processor or is busy or not.
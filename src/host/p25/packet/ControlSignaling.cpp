@@ -1436,6 +1436,9 @@ void ControlSignaling::writeNet_TDULC(lc::TDULC* lc)
         ::ActivityLog("P25", false, "network end of transmission, %u frames", m_p25->m_voice->m_netFrames);
     }
 
+    ::ActivityLogCDR(CDR_MODE_P25, false, 0U, m_p25->m_voice->m_netLC.getSrcId(), m_p25->m_voice->m_netLC.getDstId(),
+        m_p25->m_voice->m_netFrames * 20U, m_p25->m_voice->m_netFrames, m_p25->m_voice->m_netLost, 0.0F, 0U, 0U, 0U);
+
     if (m_p25->m_network != nullptr)
         m_p25->m_network->resetP25();
 
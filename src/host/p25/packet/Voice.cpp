@@ -79,6 +79,8 @@ void Voice::resetNet()
     m_netLost = 0U;
     m_vocLDU1Count = 0U;
     m_roamLDU1Count = 0U;
+    m_netLDU1Template.reset();
+    m_netLDU2Template.reset();
     m_p25->m_networkWatchdog.stop();
 }
 
@@ -1087,6 +1089,11 @@ bool Voice::process(uint8_t* data, uint32_t len)
                     float(m_rfFrames) / 5.56F, float(m_rfErrs * 100U) / float(m_rfBits));
             }
 
+            bool rssi = m_p25->m_rssi != 0U && m_p25->m_rssiCount > 0U;
+            ::ActivityLogCDR(CDR_MODE_P25, true, 0U, m_rfLC.getSrcId(), m_rfLC.getDstId(),
+                m_rfFrames * 180U, m_rfFrames, m_rfErrs, (m_rfBits > 0U) ? float(m_rfErrs * 100U) / float(m_rfBits) : 0.0F,
+                rssi ? m_p25->m_minRSSI : 0U, rssi ? m_p25->m_maxRSSI : 0U, rssi ? m_p25->m_aveRSSI / m_p25->m_rssiCount : 0U);
+
             LogMessage(LOG_RF, P25_TDU_STR ", total frames: %d, bits: %d, undecodable LC: %d, errors: %d, BER: %.4f%%",
                 m_rfFrames, m_rfBits, m_rfUndecodableLC, m_rfErrs, float(m_rfErrs * 100U) / float(m_rfBits));
 
@@ -1410,6 +1417,8 @@ Voice::Voice(Control* p25, bool debug, bool verbose) :
     m_dfsiLC(),
     m_netLDU1(nullptr),
     m_netLDU2(nullptr),
+    m_netLDU1Template(DUID::LDU1),
+    m_netLDU2Template(DUID::LDU2),
     m_lastDUID(DUID::TDU),
     m_lastIMBE(nullptr),
     m_lastMI(nullptr),
@@ -1530,6 +1539,9 @@ void Voice::writeNet_TDU()
         ::ActivityLog("P25", false, "network end of transmission, %u frames", m_netFrames);
     }
 
+    ::ActivityLogCDR(CDR_MODE_P25, false, 0U, m_netLC.getSrcId(), m_netLC.getDstId(),
+        m_netFrames * 20U, m_netFrames, m_netLost, 0.0F, 0U, 0U, 0U);
+
     if (m_p25->m_network != nullptr)
         m_p25->m_network->resetP25();
 
@@ -1770,6 +1782,8 @@ void Voice::writeNet_LDU1()
         m_netLost = 0U;
         m_vocLDU1Count = 0U;
         m_roamLDU1Count = 0U;
+        m_netLDU1Template.reset();
+        m_netLDU2Template.reset();
 
         if (!m_p25->m_disableNetworkHDU) {
             if (m_netLastFrameType != FrameType::HDU_LATE_ENTRY) {
@@ -1861,15 +1875,6 @@ void Voice::writeNet_LDU1()
 
     insertMissingAudio(m_netLDU1);
 
-    uint8_t buffer[P25_LDU_FRAME_LENGTH_BYTES + 2U];
-    ::memset(buffer, 0x00U, P25_LDU_FRAME_LENGTH_BYTES + 2U);
-
-    // generate Sync
-    Sync::addP25Sync(buffer + 2U);
-
-    // generate NID
-    m_p25->m_nid.encode(buffer + 2U, DUID::LDU1);
-
     // generate LDU1 data
     if (!m_netLC.isStandardMFId()) {
         if (m_debug) {
@@ -1878,7 +1883,10 @@ void Voice::writeNet_LDU1()
         m_netLC.setRS(rsValue);
     }
 
-    m_netLC.encodeLDU1(buffer + 2U);
+    uint8_t buffer[P25_LDU_FRAME_LENGTH_BYTES + 2U];
+
+    // generate Sync, NID, LC and status bits
+    m_netLDU1Template.get(buffer + 2U, m_netLC, m_p25->m_nid);
 
     // add the Audio
     m_audio.encode(buffer + 2U, m_netLDU1 + 10U, 0U);
@@ -1896,9 +1904,6 @@ void Voice::writeNet_LDU1()
     m_netLSD.setLSD2(lsd.getLSD2());
     m_netLSD.encode(buffer + 2U);
 
-    // add status bits
-    P25Utils::addStatusBits(buffer + 2U, P25_LDU_FRAME_LENGTH_BITS, false, false);
-
     buffer[0U] = modem::TAG_DATA;
     buffer[1U] = 0x00U;
 
@@ -1960,16 +1965,9 @@ void Voice::writeNet_LDU2()
     insertMissingAudio(m_netLDU2);
 
     uint8_t buffer[P25_LDU_FRAME_LENGTH_BYTES + 2U];
-    ::memset(buffer, 0x00U, P25_LDU_FRAME_LENGTH_BYTES + 2U);
-
-    // generate Sync
-    Sync::addP25Sync(buffer + 2U);
-
-    // generate NID
-    m_p25->m_nid.encode(buffer + 2U, DUID::LDU2);
 
-    // generate LDU2 data
-    m_netLC.encodeLDU2(buffer + 2U);
+    // generate Sync, NID, LDU2 data and status bits
+    m_netLDU2Template.get(buffer + 2U, m_netLC, m_p25->m_nid);
 
     // add the Audio
     m_audio.encode(buffer + 2U, m_netLDU2 + 10U, 0U);
@@ -1987,9 +1985,6 @@ void Voice::writeNet_LDU2()
     m_netLSD.setLSD2(lsd.getLSD2());
     m_netLSD.encode(buffer + 2U);
 
-    // add status bits
-    P25Utils::addStatusBits(buffer + 2U, P25_LDU_FRAME_LENGTH_BITS, false, false);
-
     buffer[0U] = modem::TAG_DATA;
     buffer[1U] = 0x00U;
 
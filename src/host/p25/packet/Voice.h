@@ -26,6 +26,7 @@
 #include "common/p25/dfsi/LC.h"
 #include "common/p25/lc/LC.h"
 #include "common/p25/Audio.h"
+#include "common/p25/LDUTemplate.h"
 #include "p25/Control.h"
 
 #include <cstdio>
@@ -114,6 +115,9 @@ namespace p25
             uint8_t* m_netLDU1;
             uint8_t* m_netLDU2;
 
+            LDUTemplate m_netLDU1Template;
+            LDUTemplate m_netLDU2Template;
+
             defines::DUID::E m_lastDUID;
             uint8_t* m_lastIMBE;
             uint8_t* m_lastMI;
@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/network/PacketCapture.h"
+#include "common/network/RTPExtensionHeader.h"
+#include "common/Log.h"
+#include "common/Thread.h"
+#include "CaptureReplay.h"
+#include "LoadGenMain.h"
+
+using namespace network;
+using namespace network::frame;
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the CaptureReplay class. */
+
+CaptureReplay::CaptureReplay(const LoadOptions& options) :
+    m_options(options),
+    m_peers(),
+    m_lastService(0U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the CaptureReplay class. */
+
+CaptureReplay::~CaptureReplay()
+{
+    for (auto entry : m_peers) {
+        entry.second->close();
+        delete entry.second;
+    }
+    m_peers.clear();
+}
+
+/* Logs the captured peers in, replays the capture and prints the report. */
+
+int CaptureReplay::run()
+{
+    if (!createPeers())
+        return EXIT_FAILURE;
+
+    // wait for the peers to log in
+    LogMessage(LOG_HOST, "Logging in %u captured peers to %s:%u...", (uint32_t)m_peers.size(), m_options.address.c_str(), m_options.port);
+    uint32_t waited = 0U;
+    while (countRunningPeers() < m_peers.size() && waited < LOAD_LOGIN_TIMEOUT_MS && !g_killed) {
+        service();
+        Thread::sleep(5U);
+        waited += 5U;
+    }
+
+    uint32_t running = countRunningPeers();
+    if (running < m_peers.size()) {
+        LogWarning(LOG_HOST, "only %u of %u captured peers logged in, traffic from the others will be skipped", running, (uint32_t)m_peers.size());
+    }
+
+    PacketCaptureReader reader;
+    if (!reader.open(m_options.captureFile))
+        return EXIT_FAILURE;
+
+    if (m_options.replaySpeed > 0.0F)
+        LogMessage(LOG_HOST, "Replaying %s at %.2fx", m_options.captureFile.c_str(), m_options.replaySpeed);
+    else
+        LogMessage(LOG_HOST, "Replaying %s as fast as possible", m_options.captureFile.c_str());
+
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[REPLAY_MAX_DATAGRAM_LEN]);
+
+    int64_t fneCpuStart = (m_options.fnePid > 0) ? LoadGenerator::processCPUTime(m_options.fnePid) : -1;
+    uint64_t start = LoadPeer::now();
+
+    uint64_t firstTimestamp = 0U, lastTimestamp = 0U;
+    uint64_t replayed = 0U, skipped = 0U, failed = 0U;
+    uint64_t totalLate = 0U, maxLate = 0U;
+
+    uint64_t timestamp = 0U;
+    uint32_t length = 0U;
+    while (!g_killed && reader.read(timestamp, buffer.get(), length)) {
+        RTPHeader rtpHeader;
+        RTPFNEHeader fneHeader;
+        if (!decode(buffer.get(), length, rtpHeader, fneHeader)) {
+            skipped++;
+            continue;
+        }
+
+        auto it = m_peers.find(fneHeader.getPeerId());
+        if (it == m_peers.end() || !it->second->isRunning()) {
+            skipped++;
+            continue;
+        }
+
+        if (firstTimestamp == 0U)
+            firstTimestamp = timestamp;
+        lastTimestamp = timestamp;
+
+        // wait until the frame is due at the requested pace
+        uint64_t now = LoadPeer::now();
+        if (m_options.replaySpeed > 0.0F && timestamp >= firstTimestamp) {
+            uint64_t due = start + (uint64_t)((double)(timestamp - firstTimestamp) / m_options.replaySpeed);
+            while (now < due && !g_killed) {
+                service();
+
+                now = LoadPeer::now();
+                if (due > now + 1000U)
+                    Thread::sleep((uint32_t)std::min<uint64_t>((due - now) / 1000U, LOAD_WORKER_MAX_WAIT_MS));
+                now = LoadPeer::now();
+            }
+
+            uint64_t late = (now > due) ? now - due : 0U;
+            totalLate += late;
+            if (late > maxLate)
+                maxLate = late;
+        }
+        else if ((replayed % REPLAY_SERVICE_INTERVAL) == 0U) {
+            service();
+        }
+
+        const uint8_t* message = buffer.get() + (RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES);
+        FrameQueue::OpcodePair opcode = { fneHeader.getFunction(), fneHeader.getSubFunction() };
+        if (it->second->writeMaster(opcode, message, fneHeader.getMessageLength(), rtpHeader.getSequence(), fneHeader.getStreamId()))
+            replayed++;
+        else
+            failed++;
+    }
+
+    // give the FNE a chance to finish processing
+    uint32_t drained = 0U;
+    while (drained < LOAD_DRAIN_TIME_MS) {
+        service();
+        Thread::sleep(5U);
+        drained += 5U;
+    }
+
+    uint64_t wallUs = LoadPeer::now() - start;
+    int64_t fneCpuEnd = (m_options.fnePid > 0) ? LoadGenerator::processCPUTime(m_options.fnePid) : -1;
+    double wallSeconds = (double)wallUs / 1000000.0;
+    double replaySeconds = wallSeconds - ((double)LOAD_DRAIN_TIME_MS / 1000.0);
+
+    ::fprintf(stdout, "\nReplayed %llu frames from %u peers in %.2fs (%.0f frames/s); %llu skipped, %llu failed\n",
+        (unsigned long long)replayed, running, replaySeconds, (replaySeconds > 0.0) ? (double)replayed / replaySeconds : 0.0,
+        (unsigned long long)skipped, (unsigned long long)failed);
+    ::fprintf(stdout, "Captured span: %.2fs\n", (double)(lastTimestamp - firstTimestamp) / 1000000.0);
+    if (m_options.replaySpeed > 0.0F && replayed > 0U) {
+        ::fprintf(stdout, "Schedule lateness: avg %.3fms, max %.3fms\n", ((double)totalLate / (double)replayed) / 1000.0,
+            (double)maxLate / 1000.0);
+    }
+
+    if (fneCpuStart >= 0 && fneCpuEnd >= 0 && wallSeconds > 0.0) {
+        int64_t fneCpuMs = fneCpuEnd - fneCpuStart;
+        ::fprintf(stdout, "FNE CPU: %.2fs (%.1f%% of one core)", (double)fneCpuMs / 1000.0, ((double)fneCpuMs / 10.0) / wallSeconds);
+        if (replayed > 0U)
+            ::fprintf(stdout, ", %.2fus per frame", ((double)fneCpuMs * 1000.0) / (double)replayed);
+        ::fprintf(stdout, "\n");
+    }
+
+    ::fprintf(stdout, "\n");
+    ::fflush(stdout);
+    return EXIT_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to decode a captured datagram. */
+
+bool CaptureReplay::decode(const uint8_t* data, uint32_t length, RTPHeader& rtpHeader, RTPFNEHeader& fneHeader)
+{
+    assert(data != nullptr);
+
+    if (length < RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES)
+        return false;
+
+    if (!rtpHeader.decode(data) || !rtpHeader.getExtension())
+        return false;
+    if (!fneHeader.decode(data + RTP_HEADER_LENGTH_BYTES))
+        return false;
+
+    if (fneHeader.getMessageLength() == 0U ||
+        fneHeader.getMessageLength() > length - (RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES))
+        return false;
+
+    // session traffic (login, pings, etc.) is generated by the synthetic peers themselves
+    return fneHeader.getFunction() == NET_FUNC::PROTOCOL || fneHeader.getFunction() == NET_FUNC::ANNOUNCE;
+}
+
+/* Helper to create and open a synthetic peer for every peer in the capture. */
+
+bool CaptureReplay::createPeers()
+{
+    PacketCaptureReader reader;
+    if (!reader.open(m_options.captureFile))
+        return false;
+
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[REPLAY_MAX_DATAGRAM_LEN]);
+
+    uint64_t timestamp = 0U;
+    uint32_t length = 0U;
+    while (reader.read(timestamp, buffer.get(), length)) {
+        RTPHeader rtpHeader;
+        RTPFNEHeader fneHeader;
+        if (!decode(buffer.get(), length, rtpHeader, fneHeader))
+            continue;
+
+        uint32_t peerId = fneHeader.getPeerId();
+        if (m_peers.find(peerId) != m_peers.end())
+            continue;
+
+        LoadPeer* peer = new LoadPeer(m_options.address, m_options.port, peerId, m_options.password, m_options.debug,
+            m_options.modes[LOAD_MODE_DMR], m_options.modes[LOAD_MODE_P25], m_options.modes[LOAD_MODE_NXDN]);
+
+        char identity[16U];
+        ::snprintf(identity, sizeof(identity), "REPLAY%u", (uint32_t)m_peers.size());
+        peer->setMetadata(std::string(identity), 0U, 0U, 0.0F, 0.0F, 0, 0, 0, 0.0F, 0.0F, 0, "");
+        peer->setConventional(true);
+
+        peer->enable(true);
+        if (!peer->open()) {
+            LogError(LOG_HOST, "PEER %u, failed to open network", peerId);
+            delete peer;
+            return false;
+        }
+
+        m_peers[peerId] = peer;
+    }
+
+    if (m_peers.empty()) {
+        LogError(LOG_HOST, "%s contains no replayable traffic!", m_options.captureFile.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/* Helper to clock the synthetic peers and discard any traffic forwarded to them. */
+
+void CaptureReplay::service()
+{
+    uint64_t now = LoadPeer::now();
+    if (m_lastService == 0U)
+        m_lastService = now;
+
+    uint32_t ms = (uint32_t)((now - m_lastService) / 1000U);
+    if (ms > 0U)
+        m_lastService += ms * 1000ULL;
+
+    for (auto entry : m_peers) {
+        entry.second->process(now, ms, false, 0U, m_stats);
+    }
+}
+
+/* Helper to count the logged in peers. */
+
+uint32_t CaptureReplay::countRunningPeers()
+{
+    uint32_t running = 0U;
+    for (auto entry : m_peers) {
+        if (entry.second->isRunning())
+            running++;
+    }
+
+    return running;
+}
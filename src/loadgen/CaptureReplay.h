@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file CaptureReplay.h
+ * @ingroup loadgen
+ * @file CaptureReplay.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__CAPTURE_REPLAY_H__)
+#define __CAPTURE_REPLAY_H__
+
+#include "Defines.h"
+#include "common/network/RTPHeader.h"
+#include "common/network/RTPFNEHeader.h"
+#include "LoadGenerator.h"
+#include "LoadPeer.h"
+#include "LoadStats.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define REPLAY_MAX_DATAGRAM_LEN 65535U
+#define REPLAY_SERVICE_INTERVAL 64U
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements replay of a FNE packet capture.
+ *
+ *  Every peer that sent protocol or announcement traffic in the capture is impersonated by a
+ *  synthetic peer with the same peer ID, which performs a normal login. The captured protocol and
+ *  announcement messages are then resent by their original peer, in capture order, with their
+ *  original stream IDs and RTP sequence numbers, either at the captured pace (scaled by the replay
+ *  speed) or as fast as possible. Login, authorisation, configuration and ping traffic in the
+ *  capture is not replayed, as each synthetic peer maintains its own session.
+ * @ingroup loadgen
+ */
+class HOST_SW_API CaptureReplay {
+public:
+    /**
+     * @brief Initializes a new instance of the CaptureReplay class.
+     * @param options Load generator options.
+     */
+    CaptureReplay(const LoadOptions& options);
+    /**
+     * @brief Finalizes a instance of the CaptureReplay class.
+     */
+    ~CaptureReplay();
+
+    /**
+     * @brief Logs the captured peers in, replays the capture and prints the report.
+     * @returns int Zero if successful, otherwise error occurred.
+     */
+    int run();
+
+private:
+    LoadOptions m_options;
+
+    std::unordered_map<uint32_t, LoadPeer*> m_peers;
+    uint64_t m_lastService;
+
+    LoadStats m_stats[LOAD_MODE_COUNT];
+
+    /**
+     * @brief Helper to decode a captured datagram.
+     * @param[in] data Captured datagram.
+     * @param length Length of captured datagram.
+     * @param[out] rtpHeader RTP Header.
+     * @param[out] fneHeader FNE Header.
+     * @returns bool True, if the datagram is a protocol or announcement message that should be replayed, otherwise false.
+     */
+    static bool decode(const uint8_t* data, uint32_t length, network::frame::RTPHeader& rtpHeader,
+        network::frame::RTPFNEHeader& fneHeader);
+
+    /**
+     * @brief Helper to create and open a synthetic peer for every peer in the capture.
+     * @returns bool True, if the peers were created, otherwise false.
+     */
+    bool createPeers();
+    /**
+     * @brief Helper to clock the synthetic peers and discard any traffic forwarded to them.
+     */
+    void service();
+    /**
+     * @brief Helper to count the logged in peers.
+     * @returns uint32_t Number of logged in peers.
+     */
+    uint32_t countRunningPeers();
+};
+
+#endif // __CAPTURE_REPLAY_H__
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @defgroup loadgen Peer Load Generator (dvmloadgen)
+ * @brief Digital Voice Modem - Peer Load Generator
+ * @details Impersonates many peers against a FNE to measure forwarding latency, loss and CPU cost.
+ * @ingroup loadgen
+ * 
+ * @file Defines.h
+ * @ingroup loadgen
+ */
+#if !defined(__DEFINES_H__)
+#define __DEFINES_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#undef __PROG_NAME__
+#define __PROG_NAME__ "Digital Voice Modem (DVM) Peer Load Generator"
+#undef __EXE_NAME__ 
+#define __EXE_NAME__ "dvmloadgen"
+
+/**
+ * @addtogroup loadgen
+ * @{
+ */
+
+const uint8_t   LOAD_MODE_DMR = 0U;
+const uint8_t   LOAD_MODE_P25 = 1U;
+const uint8_t   LOAD_MODE_NXDN = 2U;
+const uint8_t   LOAD_MODE_COUNT = 3U;
+
+/** @brief Marker placed before the send timestamp in generated voice payloads. */
+const uint8_t   LOAD_PAYLOAD_MAGIC[] = { 0xD7U, 0x4CU };
+/** @brief Length of the marker and 48-bit send timestamp in generated voice payloads. */
+const uint32_t  LOAD_PAYLOAD_STAMP_LEN = 8U;
+
+/** @brief Offset of the timestamp within a received DMR network message (start of the DMR frame). */
+const uint32_t  LOAD_DMR_STAMP_OFFSET = 20U;
+/** @brief Offset of the timestamp within a received P25 network message (first IMBE of the LDU). */
+const uint32_t  LOAD_P25_STAMP_OFFSET = 34U;
+/** @brief Offset of the timestamp within a received NXDN network message. */
+const uint32_t  LOAD_NXDN_STAMP_OFFSET = 34U;
+
+/** @brief DMR voice burst interval (ms). */
+const uint32_t  LOAD_DMR_FRAME_MS = 60U;
+/** @brief P25 LDU interval (ms). */
+const uint32_t  LOAD_P25_FRAME_MS = 180U;
+/** @brief NXDN voice frame interval (ms). */
+const uint32_t  LOAD_NXDN_FRAME_MS = 80U;
+
+/** @brief Modem data tag prefixed to NXDN network frames (same value as the host modem::TAG_DATA). */
+const uint8_t   LOAD_NXDN_TAG_DATA = 0x01U;
+/** @brief Modem end of transmission tag prefixed to NXDN network frames (same value as the host modem::TAG_EOT). */
+const uint8_t   LOAD_NXDN_TAG_EOT = 0x03U;
+/** @} */
+
+#endif // __DEFINES_H__
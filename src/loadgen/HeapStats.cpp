@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "HeapStats.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+static std::atomic<uint64_t> m_heapAllocations{0U};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Allocates a block of memory, counting the allocation. */
+
+void* operator new(size_t size)
+{
+    m_heapAllocations.fetch_add(1U, std::memory_order_relaxed);
+
+    void* ptr = ::malloc((size > 0U) ? size : 1U);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+/* Allocates a block of memory, counting the allocation. */
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+/* Releases a block of memory. */
+
+void operator delete(void* ptr) noexcept
+{
+    ::free(ptr);
+}
+
+/* Releases a block of memory. */
+
+void operator delete[](void* ptr) noexcept
+{
+    ::free(ptr);
+}
+
+/* Releases a block of memory. */
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    ::free(ptr);
+}
+
+/* Releases a block of memory. */
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    ::free(ptr);
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Gets the number of heap allocations made through operator new. */
+
+uint64_t HeapStats::allocations()
+{
+    return m_heapAllocations.load();
+}
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file HeapStats.h
+ * @ingroup loadgen
+ * @file HeapStats.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__HEAP_STATS_H__)
+#define __HEAP_STATS_H__
+
+#include "Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Counts the heap allocations made by the load generator.
+ *
+ *  The global new and delete operators of this program are replaced with versions that count every
+ *  allocation, so the report can show how many heap allocations the peer network path makes per
+ *  frame (with and without the slab allocator).
+ * @ingroup loadgen
+ */
+class HOST_SW_API HeapStats {
+public:
+    /**
+     * @brief Gets the number of heap allocations made through operator new.
+     */
+    static uint64_t allocations();
+};
+
+#endif // __HEAP_STATS_H__
@@ -0,0 +1,405 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "common/SlabAllocator.h"
+#include "CaptureReplay.h"
+#include "LoadGenerator.h"
+#include "LoadGenMain.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <signal.h>
+
+// ---------------------------------------------------------------------------
+//	Macros
+// ---------------------------------------------------------------------------
+
+#define IS(s) (::strcmp(argv[i], s) == 0)
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+std::string g_progExe = std::string(__EXE_NAME__);
+bool g_killed = false;
+
+static LoadOptions g_options;
+
+// ---------------------------------------------------------------------------
+//	Global Functions
+// ---------------------------------------------------------------------------
+
+/* Internal signal handler. */
+
+static void sigHandler(int signum)
+{
+    g_killed = true;
+}
+
+/* Helper to print a fatal error message and exit. */
+
+void fatal(const char* message)
+{
+    ::fprintf(stderr, "%s: FATAL PANIC; %s\n", g_progExe.c_str(), message);
+    exit(EXIT_FAILURE);
+}
+
+/* Helper to pring usage the command line arguments. (And optionally an error.) */
+
+void usage(const char* message, const char* arg)
+{
+    ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+    ::fprintf(stdout, "Copyright (c) 2017-2024 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n");
+    ::fprintf(stdout, "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\n\n");
+    if (message != nullptr) {
+        ::fprintf(stderr, "%s: ", g_progExe.c_str());
+        ::fprintf(stderr, message, arg);
+        ::fprintf(stderr, "\n\n");
+    }
+
+    ::fprintf(stdout,
+        "usage: %s [-dvhu]"
+        "[-a <address>]"
+        "[-p <port>]"
+        "[-P <password>]"
+        "[-n <peers>]"
+        "[-c <calls>]"
+        "[-m <modes>]"
+        "[-T <seconds>]"
+        "[-r <capture> [-x <speed>]]"
+        "\n\n"
+        "  -d                          enable network debug\n"
+        "  -v                          show version information\n"
+        "  -h                          show this screen\n"
+        "\n"
+        "  -a                          FNE address (default 127.0.0.1)\n"
+        "  -p                          FNE port (default %u)\n"
+        "  -P                          FNE authentication password\n"
+        "\n"
+        "  -n                          number of synthetic peers (default 10)\n"
+        "  -i                          peer ID of the first synthetic peer (default 9000000)\n"
+        "  -s                          source ID of the first synthetic radio (default 1000000)\n"
+        "  -t                          first talkgroup ID (default 10000)\n"
+        "\n"
+        "  -c                          number of concurrent calls (default half the peers, at most the peers)\n"
+        "  -m                          comma separated digital modes to generate (dmr,p25,nxdn; default all)\n"
+        "  -l                          length of each call in seconds (default 10)\n"
+        "  -g                          idle time between calls in seconds (default 2)\n"
+        "  -T                          length of the measurement in seconds (default 60)\n"
+        "\n"
+        "  -w                          number of worker threads (default 1)\n"
+        "  -f                          process ID of the FNE, to report its CPU usage\n"
+        "  -u                          disable pooled (slab) allocation, to compare heap allocation counts\n"
+        "\n"
+        "  -r                          replay a FNE packet capture instead of generating calls\n"
+        "  -x                          replay speed multiplier (default 1, 0 replays as fast as possible)\n"
+        "\n"
+        "  --                          stop handling options\n"
+        "\n"
+        "Call N is placed by peer N on talkgroup <first talkgroup ID> + N, and every peer is affiliated\n"
+        "to one of the call talkgroups. These talkgroups must be present and active in the FNE talkgroup\n"
+        "rules (with no inclusion list), and the peer IDs must be permitted by the FNE peer ACL.\n"
+        "\n"
+        "When replaying, each peer in the capture logs in with its original peer ID and resends its\n"
+        "captured traffic, so the capture should be replayed against a test FNE.\n",
+        g_progExe.c_str(), TRAFFIC_DEFAULT_PORT);
+
+    exit(EXIT_FAILURE);
+}
+
+/* Helper to parse the comma separated list of digital modes. */
+
+bool parseModes(const char* arg)
+{
+    for (uint8_t mode = 0U; mode < LOAD_MODE_COUNT; mode++)
+        g_options.modes[mode] = false;
+
+    std::string modes = std::string(arg);
+    size_t start = 0U;
+    while (start <= modes.size()) {
+        size_t end = modes.find(',', start);
+        if (end == std::string::npos)
+            end = modes.size();
+
+        std::string mode = modes.substr(start, end - start);
+        if (mode == "dmr")
+            g_options.modes[LOAD_MODE_DMR] = true;
+        else if (mode == "p25")
+            g_options.modes[LOAD_MODE_P25] = true;
+        else if (mode == "nxdn")
+            g_options.modes[LOAD_MODE_NXDN] = true;
+        else
+            return false;
+
+        start = end + 1U;
+    }
+
+    return true;
+}
+
+/* Helper to validate the command line arguments. */
+
+int checkArgs(int argc, char* argv[])
+{
+    int i, p = 0;
+
+    // iterate through arguments
+    for (i = 1; i <= argc; i++)
+    {
+        if (argv[i] == nullptr) {
+            break;
+        }
+
+        if (*argv[i] != '-') {
+            continue;
+        }
+        else if (IS("--")) {
+            ++p;
+            break;
+        }
+        else if (IS("-a")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the address to connect to");
+            g_options.address = std::string(argv[++i]);
+
+            if (g_options.address.empty())
+                usage("error: %s", "FNE address cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("-p")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the port to connect to");
+            g_options.port = (uint16_t)::atoi(argv[++i]);
+
+            if (g_options.port == 0U)
+                usage("error: %s", "FNE port number cannot be blank or 0!");
+
+            p += 2;
+        }
+        else if (IS("-P")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the auth password");
+            g_options.password = std::string(argv[++i]);
+
+            if (g_options.password.empty())
+                usage("error: %s", "FNE auth password cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("-n")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the number of peers");
+            g_options.peers = (uint32_t)::atoi(argv[++i]);
+
+            if (g_options.peers == 0U)
+                usage("error: %s", "number of peers cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-i")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the first peer ID");
+            g_options.peerIdBase = (uint32_t)::atoi(argv[++i]);
+            p += 2;
+        }
+        else if (IS("-s")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the first source ID");
+            g_options.srcIdBase = (uint32_t)::atoi(argv[++i]);
+            p += 2;
+        }
+        else if (IS("-t")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the first talkgroup ID");
+            g_options.tgBase = (uint32_t)::atoi(argv[++i]);
+            p += 2;
+        }
+        else if (IS("-c")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the number of concurrent calls");
+            g_options.calls = (uint32_t)::atoi(argv[++i]);
+
+            if (g_options.calls == 0U)
+                usage("error: %s", "number of concurrent calls cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-m")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the digital modes");
+            if (!parseModes(argv[++i]))
+                usage("error: invalid digital modes `%s'", argv[i]);
+
+            p += 2;
+        }
+        else if (IS("-l")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the call length");
+            g_options.callLengthMs = (uint32_t)::atoi(argv[++i]) * 1000U;
+
+            if (g_options.callLengthMs == 0U)
+                usage("error: %s", "call length cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-g")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the call gap");
+            g_options.callGapMs = (uint32_t)::atoi(argv[++i]) * 1000U;
+            p += 2;
+        }
+        else if (IS("-T")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the measurement length");
+            g_options.durationMs = (uint32_t)::atoi(argv[++i]) * 1000U;
+
+            if (g_options.durationMs == 0U)
+                usage("error: %s", "measurement length cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-w")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the number of worker threads");
+            g_options.workers = (uint32_t)::atoi(argv[++i]);
+
+            if (g_options.workers == 0U)
+                usage("error: %s", "number of worker threads cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-f")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the FNE process ID");
+            g_options.fnePid = ::atoi(argv[++i]);
+            p += 2;
+        }
+        else if (IS("-r")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the packet capture");
+            g_options.captureFile = std::string(argv[++i]);
+
+            if (g_options.captureFile.empty())
+                usage("error: %s", "packet capture cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("-x")) {
+            if ((argc - 1) <= 0 || argv[i + 1] == nullptr)
+                usage("error: %s", "must specify the replay speed");
+            g_options.replaySpeed = (float)::atof(argv[++i]);
+
+            if (g_options.replaySpeed < 0.0F)
+                usage("error: %s", "replay speed cannot be negative!");
+
+            p += 2;
+        }
+        else if (IS("-d")) {
+            ++p;
+            g_options.debug = true;
+        }
+        else if (IS("-u")) {
+            ++p;
+            g_options.pooled = false;
+        }
+        else if (IS("-v")) {
+            ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+            ::fprintf(stdout, "Copyright (c) 2017-2024 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n");
+            ::fprintf(stdout, "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\n\n");
+            if (argc == 2)
+                exit(EXIT_SUCCESS);
+        }
+        else if (IS("-h")) {
+            usage(nullptr, nullptr);
+            if (argc == 2)
+                exit(EXIT_SUCCESS);
+        }
+        else {
+            usage("unrecognized option `%s'", argv[i]);
+        }
+    }
+
+    if (p < 0 || p > argc) {
+        p = 0;
+    }
+
+    return ++p;
+}
+
+// ---------------------------------------------------------------------------
+//  Program Entry Point
+// ---------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    g_options.address = std::string("127.0.0.1");
+    g_options.port = (uint16_t)TRAFFIC_DEFAULT_PORT;
+    g_options.password = std::string();
+    g_options.peers = 10U;
+    g_options.peerIdBase = 9000000U;
+    g_options.srcIdBase = 1000000U;
+    g_options.tgBase = 10000U;
+    g_options.calls = 0U;
+    for (uint8_t mode = 0U; mode < LOAD_MODE_COUNT; mode++)
+        g_options.modes[mode] = true;
+    g_options.callLengthMs = 10000U;
+    g_options.callGapMs = 2000U;
+    g_options.durationMs = 60000U;
+    g_options.workers = 1U;
+    g_options.fnePid = 0;
+    g_options.debug = false;
+    g_options.pooled = true;
+    g_options.captureFile = std::string();
+    g_options.replaySpeed = 1.0F;
+
+    if (argv[0] != nullptr && *argv[0] != 0)
+        g_progExe = std::string(argv[0]);
+
+    if (argc > 1) {
+        // check arguments
+        checkArgs(argc, argv);
+    }
+
+    if (g_options.calls == 0U) {
+        g_options.calls = g_options.peers / 2U;
+        if (g_options.calls == 0U)
+            g_options.calls = 1U;
+    }
+
+    if (g_options.captureFile.empty() && g_options.calls > g_options.peers)
+        usage("error: %s", "number of concurrent calls cannot exceed the number of peers!");
+
+    ::signal(SIGINT, sigHandler);
+    ::signal(SIGTERM, sigHandler);
+
+    SlabAllocator::setEnabled(g_options.pooled);
+
+    ::LogInitialise("", "", 0U, g_options.debug ? 1U : 2U, true);
+
+    ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+
+    int ret = EXIT_SUCCESS;
+    if (!g_options.captureFile.empty()) {
+        CaptureReplay* replay = new CaptureReplay(g_options);
+        ret = replay->run();
+        delete replay;
+    }
+    else {
+        LoadGenerator* generator = new LoadGenerator(g_options);
+        ret = generator->run();
+        delete generator;
+    }
+
+    ::LogFinalise();
+    return ret;
+}
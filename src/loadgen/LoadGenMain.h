@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LoadGenMain.h
+ * @ingroup loadgen
+ * @file LoadGenMain.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__LOAD_GEN_MAIN_H__)
+#define __LOAD_GEN_MAIN_H__
+
+#include "Defines.h"
+
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Externs
+// ---------------------------------------------------------------------------
+
+/** @brief  */
+extern std::string g_progExe;
+
+/** @brief (Global) Flag indicating the load generator should stop immediately. */
+extern bool g_killed;
+
+#endif // __LOAD_GEN_MAIN_H__
@@ -0,0 +1,453 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "common/SlabAllocator.h"
+#include "common/Thread.h"
+#include "HeapStats.h"
+#include "LoadGenerator.h"
+#include "LoadGenMain.h"
+
+using namespace network;
+using namespace network::udp;
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif // !defined(_WIN32)
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const char* MODE_NAMES[LOAD_MODE_COUNT] = { "DMR", "P25", "NXDN" };
+const uint32_t MODE_FRAME_MS[LOAD_MODE_COUNT] = { LOAD_DMR_FRAME_MS, LOAD_P25_FRAME_MS, LOAD_NXDN_FRAME_MS };
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LoadGenerator class. */
+
+LoadGenerator::LoadGenerator(const LoadOptions& options) :
+    m_options(options),
+    m_peers(),
+    m_runningPeers(0U),
+    m_mutex(),
+    m_cond(),
+    m_running(false),
+    m_activeWorkers(0U),
+    m_nextWorker(0U),
+    m_traffic(false)
+{
+    if (m_options.workers == 0U)
+        m_options.workers = 1U;
+    if (m_options.workers > m_options.peers)
+        m_options.workers = m_options.peers;
+}
+
+/* Finalizes a instance of the LoadGenerator class. */
+
+LoadGenerator::~LoadGenerator()
+{
+    stopWorkers();
+
+    for (LoadPeer* peer : m_peers) {
+        peer->close();
+        delete peer;
+    }
+    m_peers.clear();
+}
+
+/* Logs the peers in, runs the measurement and prints the report. */
+
+int LoadGenerator::run()
+{
+    if (!createPeers())
+        return EXIT_FAILURE;
+
+    if (!startWorkers()) {
+        LogError(LOG_HOST, "failed to start worker threads!");
+        return EXIT_FAILURE;
+    }
+
+    // wait for the peers to log in
+    LogMessage(LOG_HOST, "Logging in %u peers to %s:%u...", m_options.peers, m_options.address.c_str(), m_options.port);
+    uint32_t waited = 0U;
+    while (countRunningPeers() < m_options.peers && waited < LOAD_LOGIN_TIMEOUT_MS) {
+        Thread::sleep(100U);
+        waited += 100U;
+    }
+
+    uint32_t running = countRunningPeers();
+    if (running == 0U) {
+        LogError(LOG_HOST, "no peers were able to log in!");
+        stopWorkers();
+        return EXIT_FAILURE;
+    }
+
+    if (running < m_options.peers) {
+        LogWarning(LOG_HOST, "only %u of %u peers logged in, continuing", running, m_options.peers);
+    }
+
+    // run the measurement
+    LogMessage(LOG_HOST, "Starting %u concurrent calls for %u seconds", m_options.calls, m_options.durationMs / 1000U);
+
+    int64_t fneCpuStart = (m_options.fnePid > 0) ? processCPUTime(m_options.fnePid) : -1;
+    int64_t selfCpuStart = processCPUTime(0);
+    uint64_t heapStart = HeapStats::allocations() + SlabAllocator::heapAllocations();
+    uint64_t slabStart = SlabAllocator::allocations();
+    uint64_t start = LoadPeer::now();
+
+    m_traffic = true;
+    uint32_t elapsed = 0U;
+    while (elapsed < m_options.durationMs && !g_killed) {
+        Thread::sleep(100U);
+        elapsed += 100U;
+
+        // keep the expected receiver count current as peers come and go
+        countRunningPeers();
+
+        if ((elapsed % 10000U) == 0U) {
+            LogMessage(LOG_HOST, "%u seconds elapsed, %u peers logged in", elapsed / 1000U, m_runningPeers.load());
+        }
+    }
+    m_traffic = false;
+
+    // give in-flight frames a chance to arrive
+    Thread::sleep(LOAD_DRAIN_TIME_MS);
+
+    uint64_t wallMs = (LoadPeer::now() - start) / 1000U;
+    int64_t fneCpuEnd = (m_options.fnePid > 0) ? processCPUTime(m_options.fnePid) : -1;
+    int64_t selfCpuEnd = processCPUTime(0);
+    uint64_t heapAllocs = HeapStats::allocations() + SlabAllocator::heapAllocations() - heapStart;
+    uint64_t slabAllocs = SlabAllocator::allocations() - slabStart;
+
+    stopWorkers();
+
+    report(wallMs, (fneCpuStart >= 0 && fneCpuEnd >= 0) ? fneCpuEnd - fneCpuStart : -1,
+        (selfCpuStart >= 0 && selfCpuEnd >= 0) ? selfCpuEnd - selfCpuStart : -1, heapAllocs, slabAllocs);
+    return EXIT_SUCCESS;
+}
+
+/* Helper to read the CPU time consumed by a process. */
+
+int64_t LoadGenerator::processCPUTime(int pid)
+{
+#if defined(_WIN32)
+    return -1;
+#else
+    if (pid == 0) {
+        struct rusage usage;
+        if (::getrusage(RUSAGE_SELF, &usage) != 0)
+            return -1;
+
+        return (int64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+            (int64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+    }
+
+    if (pid < 0)
+        return -1;
+
+    char path[64U];
+    ::snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE* fp = ::fopen(path, "r");
+    if (fp == nullptr)
+        return -1;
+
+    char buffer[1024U];
+    size_t len = ::fread(buffer, 1U, sizeof(buffer) - 1U, fp);
+    ::fclose(fp);
+    buffer[len] = '\0';
+
+    // the process name may contain spaces, so start after its closing bracket
+    char* p = ::strrchr(buffer, ')');
+    if (p == nullptr)
+        return -1;
+
+    // fields 3 (state) through 13 are skipped; 14 and 15 are utime and stime in clock ticks
+    unsigned long long utime = 0U, stime = 0U;
+    if (::sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) != 2)
+        return -1;
+
+    long ticks = ::sysconf(_SC_CLK_TCK);
+    if (ticks <= 0)
+        return -1;
+
+    return (int64_t)(((utime + stime) * 1000U) / (unsigned long long)ticks);
+#endif // defined(_WIN32)
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to create and open the synthetic peers. */
+
+bool LoadGenerator::createPeers()
+{
+    std::vector<uint8_t> modes;
+    for (uint8_t mode = 0U; mode < LOAD_MODE_COUNT; mode++) {
+        if (m_options.modes[mode])
+            modes.push_back(mode);
+    }
+
+    if (modes.empty()) {
+        LogError(LOG_HOST, "no digital modes are enabled!");
+        return false;
+    }
+
+    for (uint32_t i = 0U; i < m_options.peers; i++) {
+        LoadPeer* peer = new LoadPeer(m_options.address, m_options.port, m_options.peerIdBase + i, m_options.password, m_options.debug,
+            m_options.modes[LOAD_MODE_DMR], m_options.modes[LOAD_MODE_P25], m_options.modes[LOAD_MODE_NXDN]);
+
+        char identity[20U]; // "LOADGEN" + up to 10 digits
+        ::snprintf(identity, sizeof(identity), "LOADGEN%u", i);
+        peer->setMetadata(std::string(identity), 0U, 0U, 0.0F, 0.0F, 0, 0, 0, 0.0F, 0.0F, 0, "");
+        peer->setConventional(true);
+
+        // call i is always placed by peer i, on its own talkgroup, so calls never collide
+        if (i < m_options.calls) {
+            uint8_t mode = modes[i % modes.size()];
+            uint32_t offsetMs = (i * 1000U) / m_options.calls;
+            peer->setCall(mode, m_options.srcIdBase + i, m_options.tgBase + i, m_options.callLengthMs, m_options.callGapMs, offsetMs);
+        }
+
+        peer->setAffiliation(m_options.srcIdBase + i, m_options.tgBase + (i % m_options.calls));
+
+        peer->enable(true);
+        if (!peer->open()) {
+            LogError(LOG_HOST, "PEER %u, failed to open network", m_options.peerIdBase + i);
+            delete peer;
+            return false;
+        }
+
+        m_peers.push_back(peer);
+    }
+
+    return true;
+}
+
+/* Helper to start the worker threads. */
+
+bool LoadGenerator::startWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = true;
+        m_nextWorker = 0U;
+    }
+
+    for (uint32_t i = 0U; i < m_options.workers; i++) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_activeWorkers++;
+        }
+
+        if (!Thread::runAsThread(this, threadWorker)) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_activeWorkers--;
+            }
+
+            stopWorkers();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Helper to stop the worker threads. */
+
+void LoadGenerator::stopWorkers()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running)
+        return;
+
+    m_running = false;
+
+    // wait for the (detached) workers to exit
+    m_cond.wait(lock, [this] { return m_activeWorkers == 0U; });
+}
+
+/* Helper to count the logged in peers. */
+
+uint32_t LoadGenerator::countRunningPeers()
+{
+    uint32_t running = 0U;
+    for (LoadPeer* peer : m_peers) {
+        if (peer->isRunning())
+            running++;
+    }
+
+    m_runningPeers = running;
+    return running;
+}
+
+/* Helper to print the measurement report. */
+
+void LoadGenerator::report(uint64_t wallMs, int64_t fneCpuMs, int64_t selfCpuMs, uint64_t heapAllocs, uint64_t slabAllocs)
+{
+    ::fprintf(stdout, "\nPeers: %u (%u logged in), Concurrent Calls: %u, Duration: %.1fs\n\n", m_options.peers, m_runningPeers.load(),
+        m_options.calls, (double)wallMs / 1000.0);
+    ::fprintf(stdout, "%-5s %7s %10s %10s %10s %7s %9s %9s %9s %9s %9s\n", "Mode", "Calls", "Sent", "Expected", "Received", "Loss%",
+        "p50 ms", "p90 ms", "p99 ms", "p99.9 ms", "max ms");
+
+    double callSeconds = 0.0;
+    uint64_t frames = 0U;
+    for (uint8_t mode = 0U; mode < LOAD_MODE_COUNT; mode++) {
+        const LoadStats& stats = m_stats[mode];
+        if (!m_options.modes[mode] || stats.calls() == 0U)
+            continue;
+
+        callSeconds += (double)(stats.sent() * MODE_FRAME_MS[mode]) / 1000.0;
+        frames += stats.sent() + stats.received();
+
+        ::fprintf(stdout, "%-5s %7llu %10llu %10llu %10llu %7.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n", MODE_NAMES[mode],
+            (unsigned long long)stats.calls(), (unsigned long long)stats.sent(), (unsigned long long)stats.expected(),
+            (unsigned long long)stats.received(), stats.loss(),
+            stats.percentile(50.0) / 1000.0, stats.percentile(90.0) / 1000.0, stats.percentile(99.0) / 1000.0,
+            stats.percentile(99.9) / 1000.0, stats.maxLatency() / 1000.0);
+    }
+
+    ::fprintf(stdout, "\n");
+
+    double wallSeconds = (double)wallMs / 1000.0;
+    double concurrent = (wallSeconds > 0.0) ? callSeconds / wallSeconds : 0.0;
+    if (fneCpuMs >= 0 && wallSeconds > 0.0) {
+        double cpuPercent = ((double)fneCpuMs / 10.0) / wallSeconds;
+        ::fprintf(stdout, "FNE CPU: %.2fs (%.1f%% of one core)", (double)fneCpuMs / 1000.0, cpuPercent);
+        if (concurrent > 0.0) {
+            ::fprintf(stdout, ", %.2f%% per concurrent call, %.2fms per call-second", cpuPercent / concurrent,
+                (double)fneCpuMs / callSeconds);
+        }
+        ::fprintf(stdout, "\n");
+    }
+    else {
+        ::fprintf(stdout, "FNE CPU: not measured (use -f <FNE pid>)\n");
+    }
+
+    if (selfCpuMs >= 0 && wallSeconds > 0.0) {
+        ::fprintf(stdout, "Load Generator CPU: %.2fs (%.1f%% of one core)\n", (double)selfCpuMs / 1000.0,
+            ((double)selfCpuMs / 10.0) / wallSeconds);
+    }
+
+    // frames sent and received by the synthetic peers go through the same common network path
+    // (frame queue, datagrams, control blocks) as the FNE
+    ::fprintf(stdout, "Load Generator Heap: %llu allocations", (unsigned long long)heapAllocs);
+    if (frames > 0U) {
+        ::fprintf(stdout, " (%.2f per frame sent or received)", (double)heapAllocs / (double)frames);
+    }
+    ::fprintf(stdout, ", %llu slab blocks, %u slabs (pooling %s)\n", (unsigned long long)slabAllocs, SlabAllocator::slabs(),
+        SlabAllocator::isEnabled() ? "enabled" : "disabled");
+
+    ::fprintf(stdout, "\n");
+    ::fflush(stdout);
+}
+
+/* Entry point to a worker thread. */
+
+void* LoadGenerator::threadWorker(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+#if defined(_WIN32)
+        ::CloseHandle(th->thread);
+#else
+        ::pthread_detach(th->thread);
+#endif // defined(_WIN32)
+
+        std::string threadName("loadgen:worker");
+        LoadGenerator* gen = static_cast<LoadGenerator*>(th->obj);
+        if (gen == nullptr) {
+            LogDebug(LOG_HOST, "[FAIL] %s", threadName.c_str());
+            delete th;
+            return nullptr;
+        }
+
+        LogDebug(LOG_HOST, "[ OK ] %s", threadName.c_str());
+#ifdef _GNU_SOURCE
+        ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+        uint32_t index = 0U;
+        {
+            std::lock_guard<std::mutex> lock(gen->m_mutex);
+            index = gen->m_nextWorker++;
+        }
+
+        // each worker owns every Nth peer; peers are never touched by more than one thread
+        std::vector<LoadPeer*> peers;
+        std::vector<Socket*> sockets;
+        for (uint32_t i = index; i < gen->m_peers.size(); i += gen->m_options.workers) {
+            peers.push_back(gen->m_peers[i]);
+        }
+
+        LoadStats stats[LOAD_MODE_COUNT];
+
+        uint64_t last = LoadPeer::now();
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(gen->m_mutex);
+                if (!gen->m_running)
+                    break;
+            }
+
+            uint64_t now = LoadPeer::now();
+            uint32_t ms = (uint32_t)((now - last) / 1000U);
+            if (ms > 0U)
+                last += ms * 1000ULL;
+
+            bool traffic = gen->m_traffic;
+            uint32_t running = gen->m_runningPeers;
+            uint32_t receivers = (running > 0U) ? running - 1U : 0U;
+
+            uint64_t next = now + (LOAD_WORKER_MAX_WAIT_MS * 1000ULL);
+            sockets.clear();
+            for (LoadPeer* peer : peers) {
+                peer->process(now, ms, traffic, receivers, stats);
+
+                uint64_t frameTime = peer->nextFrameTime();
+                if (frameTime != 0U && frameTime < next)
+                    next = frameTime;
+
+                sockets.push_back(peer->socket());
+            }
+
+            // sleep until a peer has data or the next voice frame is due
+            now = LoadPeer::now();
+            uint32_t waitMs = (next > now) ? (uint32_t)((next - now + 999U) / 1000U) : 0U;
+            if (waitMs > 0U) {
+                if (Socket::wait(sockets, waitMs) < 0)
+                    Thread::sleep(waitMs);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(gen->m_mutex);
+            for (uint8_t mode = 0U; mode < LOAD_MODE_COUNT; mode++)
+                gen->m_stats[mode].merge(stats[mode]);
+
+            gen->m_activeWorkers--;
+        }
+        gen->m_cond.notify_all();
+
+        LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
+        delete th;
+    }
+
+    return nullptr;
+}
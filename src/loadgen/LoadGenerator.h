@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LoadGenerator.h
+ * @ingroup loadgen
+ * @file LoadGenerator.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__LOAD_GENERATOR_H__)
+#define __LOAD_GENERATOR_H__
+
+#include "Defines.h"
+#include "LoadPeer.h"
+#include "LoadStats.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define LOAD_LOGIN_TIMEOUT_MS 30000U
+#define LOAD_DRAIN_TIME_MS 1000U
+#define LOAD_WORKER_MAX_WAIT_MS 5U
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents the load generator options.
+ * @ingroup loadgen
+ */
+struct LoadOptions {
+    std::string address;                //! FNE address.
+    uint16_t port;                      //! FNE port.
+    std::string password;               //! FNE authentication password.
+
+    uint32_t peers;                     //! Number of synthetic peers.
+    uint32_t peerIdBase;                //! Peer ID of the first synthetic peer.
+    uint32_t srcIdBase;                 //! Source ID of the first synthetic radio.
+    uint32_t tgBase;                    //! First talkgroup ID.
+
+    uint32_t calls;                     //! Number of concurrent calls.
+    bool modes[LOAD_MODE_COUNT];        //! Enabled digital modes.
+    uint32_t callLengthMs;              //! Length of each call (ms).
+    uint32_t callGapMs;                 //! Idle time between calls (ms).
+    uint32_t durationMs;                //! Length of the measurement (ms).
+
+    uint32_t workers;                   //! Number of worker threads.
+    int fnePid;                         //! Process ID of the FNE (0 if unknown).
+    bool debug;                         //! Flag indicating network debug is enabled.
+    bool pooled;                        //! Flag indicating pooled (slab) allocation is enabled.
+
+    std::string captureFile;            //! Packet capture to replay (empty to generate synthetic calls).
+    float replaySpeed;                  //! Replay speed multiplier (0 to replay as fast as possible).
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements the load generator, driving a set of synthetic peers and reporting the results.
+ * @ingroup loadgen
+ */
+class HOST_SW_API LoadGenerator {
+public:
+    /**
+     * @brief Initializes a new instance of the LoadGenerator class.
+     * @param options Load generator options.
+     */
+    LoadGenerator(const LoadOptions& options);
+    /**
+     * @brief Finalizes a instance of the LoadGenerator class.
+     */
+    ~LoadGenerator();
+
+    /**
+     * @brief Logs the peers in, runs the measurement and prints the report.
+     * @returns int Zero if successful, otherwise error occurred.
+     */
+    int run();
+
+    /**
+     * @brief Helper to read the CPU time consumed by a process.
+     * @param pid Process ID (0 for this process).
+     * @returns int64_t CPU time (ms), or -1 if not known.
+     */
+    static int64_t processCPUTime(int pid);
+
+private:
+    LoadOptions m_options;
+
+    std::vector<LoadPeer*> m_peers;
+    std::atomic<uint32_t> m_runningPeers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_running;
+    uint32_t m_activeWorkers;
+    uint32_t m_nextWorker;
+
+    std::atomic<bool> m_traffic;
+
+    LoadStats m_stats[LOAD_MODE_COUNT];
+
+    /**
+     * @brief Helper to create and open the synthetic peers.
+     * @returns bool True, if the peers were created, otherwise false.
+     */
+    bool createPeers();
+    /**
+     * @brief Helper to start the worker threads.
+     * @returns bool True, if the workers were started, otherwise false.
+     */
+    bool startWorkers();
+    /**
+     * @brief Helper to stop the worker threads.
+     */
+    void stopWorkers();
+    /**
+     * @brief Helper to count the logged in peers.
+     * @returns uint32_t Number of logged in peers.
+     */
+    uint32_t countRunningPeers();
+
+    /**
+     * @brief Helper to print the measurement report.
+     * @param wallMs Length of the measurement (ms).
+     * @param fneCpuMs CPU time (ms) consumed by the FNE, or -1 if not known.
+     * @param selfCpuMs CPU time (ms) consumed by the load generator, or -1 if not known.
+     * @param heapAllocs Number of heap allocations made by the load generator.
+     * @param slabAllocs Number of slab allocator blocks allocated by the load generator.
+     */
+    void report(uint64_t wallMs, int64_t fneCpuMs, int64_t selfCpuMs, uint64_t heapAllocs, uint64_t slabAllocs);
+
+    /**
+     * @brief Entry point to a worker thread.
+     * @param arg Instance of the thread_t structure.
+     * @returns void* (Ignore)
+     */
+    static void* threadWorker(void* arg);
+};
+
+#endif // __LOAD_GENERATOR_H__
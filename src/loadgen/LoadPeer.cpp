@@ -0,0 +1,487 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/dmr/data/EMB.h"
+#include "common/dmr/data/NetData.h"
+#include "common/dmr/lc/FullLC.h"
+#include "common/dmr/SlotType.h"
+#include "common/nxdn/NXDNDefines.h"
+#include "common/nxdn/lc/RTCH.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/data/LowSpeedData.h"
+#include "common/p25/lc/LC.h"
+#include "common/Log.h"
+#include "LoadPeer.h"
+
+using namespace network;
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t NXDN_STAMP_OFFSET = 10U;
+
+const uint64_t STAMP_MASK = 0xFFFFFFFFFFFFULL;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LoadPeer class. */
+
+LoadPeer::LoadPeer(const std::string& address, uint16_t port, uint32_t peerId, const std::string& password, bool debug,
+    bool dmr, bool p25, bool nxdn) :
+    Network(address, port, 0U, peerId, password, true, debug, dmr, p25, nxdn, true, true, false, false, false, false),
+    m_running(false),
+    m_mode(LOAD_MODE_DMR),
+    m_srcId(0U),
+    m_dstId(0U),
+    m_lengthMs(0U),
+    m_gapMs(0U),
+    m_offsetMs(0U),
+    m_affSrcId(0U),
+    m_affDstId(0U),
+    m_nextAffiliation(0U),
+    m_callConfigured(false),
+    m_callActive(false),
+    m_nextCall(0U),
+    m_nextFrame(0U),
+    m_frame(0U),
+    m_frameCount(0U),
+    m_dmrEmbeddedData(),
+    m_p25Audio(),
+    m_ldu(nullptr),
+    m_waitSockets()
+{
+    m_waitSockets.push_back(m_socket);
+
+    m_ldu = new uint8_t[p25::defines::P25_LDU_FRAME_LENGTH_BYTES];
+    ::memset(m_ldu, 0x00U, p25::defines::P25_LDU_FRAME_LENGTH_BYTES);
+}
+
+/* Finalizes a instance of the LoadPeer class. */
+
+LoadPeer::~LoadPeer()
+{
+    delete[] m_ldu;
+}
+
+/* Sets the call this peer places. */
+
+void LoadPeer::setCall(uint8_t mode, uint32_t srcId, uint32_t dstId, uint32_t lengthMs, uint32_t gapMs, uint32_t offsetMs)
+{
+    m_mode = mode;
+    m_srcId = srcId;
+    m_dstId = dstId;
+    m_lengthMs = lengthMs;
+    m_gapMs = gapMs;
+    m_offsetMs = offsetMs;
+
+    // calls always end on a whole DMR superframe or P25 LDU1/LDU2 pair
+    switch (m_mode) {
+    case LOAD_MODE_P25:
+        m_frameCount = ((m_lengthMs / LOAD_P25_FRAME_MS) + 1U) & ~1U;
+        break;
+    case LOAD_MODE_NXDN:
+        m_frameCount = m_lengthMs / LOAD_NXDN_FRAME_MS;
+        break;
+    case LOAD_MODE_DMR:
+    default:
+        m_frameCount = ((m_lengthMs / LOAD_DMR_FRAME_MS) + 5U) / 6U * 6U;
+        break;
+    }
+
+    if (m_frameCount == 0U)
+        m_frameCount = 6U;
+
+    m_callConfigured = true;
+}
+
+/* Sets the group affiliation this peer announces. */
+
+void LoadPeer::setAffiliation(uint32_t srcId, uint32_t dstId)
+{
+    m_affSrcId = srcId;
+    m_affDstId = dstId;
+}
+
+/* Updates network state, reads forwarded frames and writes any voice frames that are due. */
+
+void LoadPeer::process(uint64_t now, uint32_t ms, bool traffic, uint32_t receivers, LoadStats* stats)
+{
+    assert(stats != nullptr);
+
+    clock(ms);
+
+    // drain anything else the FNE has sent us since the last pass
+    while (udp::Socket::wait(m_waitSockets, 0U) > 0)
+        clock(0U);
+
+    bool running = m_status == NET_STAT_RUNNING;
+    if (running != m_running) {
+        m_running = running;
+        if (running) {
+            LogMessage(LOG_NET, "PEER %u logged in", m_peerId);
+            m_nextAffiliation = now;
+            m_nextCall = now + (m_offsetMs * 1000ULL);
+        }
+        else {
+            LogWarning(LOG_NET, "PEER %u connection lost", m_peerId);
+            m_callActive = false;
+        }
+    }
+
+    if (!running)
+        return;
+
+    readFrames(now, stats);
+
+    // periodically re-announce our affiliation, like a real site would
+    if (m_affSrcId != 0U && now >= m_nextAffiliation) {
+        announceGroupAffiliation(m_affSrcId, m_affDstId);
+        m_nextAffiliation = now + (LOAD_PEER_AFFILIATION_INTERVAL_MS * 1000ULL);
+    }
+
+    if (!m_callConfigured)
+        return;
+
+    if (!traffic) {
+        if (m_callActive)
+            endCall();
+
+        m_nextCall = now + (m_offsetMs * 1000ULL);
+        return;
+    }
+
+    if (!m_callActive && now >= m_nextCall)
+        startCall(now, stats[m_mode]);
+
+    // catch up on any frames that came due while we were busy
+    while (m_callActive && now >= m_nextFrame) {
+        writeFrame(now, receivers, stats[m_mode]);
+        if (m_frame >= m_frameCount) {
+            endCall();
+            m_nextCall = now + (m_gapMs * 1000ULL);
+        }
+    }
+}
+
+/* Gets the current monotonic time (us). */
+
+uint64_t LoadPeer::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to read forwarded frames and record their latency. */
+
+void LoadPeer::readFrames(uint64_t now, LoadStats* stats)
+{
+    bool ret = true;
+    uint32_t length = 0U;
+
+    while (ret) {
+        UInt8Array buffer = readDMR(ret, length);
+        if (!ret || buffer == nullptr)
+            break;
+
+        // only voice bursts carry a timestamp; headers and terminators are regenerated by the FNE
+        if ((buffer[15U] & 0x20U) == 0x00U && length >= LOAD_DMR_STAMP_OFFSET + LOAD_PAYLOAD_STAMP_LEN)
+            recordFrame(now, buffer.get() + LOAD_DMR_STAMP_OFFSET, stats[LOAD_MODE_DMR]);
+    }
+
+    ret = true;
+    while (ret) {
+        UInt8Array buffer = readP25(ret, length);
+        if (!ret || buffer == nullptr)
+            break;
+
+        p25::defines::DUID::E duid = (p25::defines::DUID::E)buffer[22U];
+        if ((duid == p25::defines::DUID::LDU1 || duid == p25::defines::DUID::LDU2) &&
+            length >= LOAD_P25_STAMP_OFFSET + LOAD_PAYLOAD_STAMP_LEN)
+            recordFrame(now, buffer.get() + LOAD_P25_STAMP_OFFSET, stats[LOAD_MODE_P25]);
+    }
+
+    ret = true;
+    while (ret) {
+        UInt8Array buffer = readNXDN(ret, length);
+        if (!ret || buffer == nullptr)
+            break;
+
+        if (buffer[4U] == nxdn::defines::MessageType::RTCH_VCALL && length >= LOAD_NXDN_STAMP_OFFSET + LOAD_PAYLOAD_STAMP_LEN)
+            recordFrame(now, buffer.get() + LOAD_NXDN_STAMP_OFFSET, stats[LOAD_MODE_NXDN]);
+    }
+}
+
+/* Helper to record the latency of a forwarded voice frame. */
+
+void LoadPeer::recordFrame(uint64_t now, const uint8_t* data, LoadStats& stats)
+{
+    // ignore traffic that isn't ours
+    if (data[0U] != LOAD_PAYLOAD_MAGIC[0U] || data[1U] != LOAD_PAYLOAD_MAGIC[1U])
+        return;
+
+    uint64_t sent = 0U;
+    for (uint32_t i = 2U; i < LOAD_PAYLOAD_STAMP_LEN; i++)
+        sent = (sent << 8) | data[i];
+
+    uint64_t latency = (now - sent) & STAMP_MASK;
+    stats.frameReceived(latency);
+}
+
+/* Helper to start a call. */
+
+void LoadPeer::startCall(uint64_t now, LoadStats& stats)
+{
+    m_callActive = true;
+    m_frame = 0U;
+    m_nextFrame = now;
+
+    stats.callStarted();
+
+    if (m_mode == LOAD_MODE_DMR) {
+        using namespace dmr;
+        using namespace dmr::defines;
+
+        uint8_t data[DMR_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+        lc::LC dmrLC = lc::LC();
+        dmrLC.setFLCO(FLCO::GROUP);
+        dmrLC.setSrcId(m_srcId);
+        dmrLC.setDstId(m_dstId);
+        m_dmrEmbeddedData.setLC(dmrLC);
+
+        // generate the Slot Type
+        SlotType slotType = SlotType();
+        slotType.setDataType(DataType::VOICE_LC_HEADER);
+        slotType.encode(data);
+
+        lc::FullLC fullLC = lc::FullLC();
+        fullLC.encode(dmrLC, data, DataType::VOICE_LC_HEADER);
+
+        data::NetData dmrData;
+        dmrData.setSlotNo(1U);
+        dmrData.setDataType(DataType::VOICE_LC_HEADER);
+        dmrData.setSrcId(m_srcId);
+        dmrData.setDstId(m_dstId);
+        dmrData.setFLCO(FLCO::GROUP);
+        dmrData.setN(0U);
+        dmrData.setSeqNo(0U);
+        dmrData.setData(data);
+
+        writeDMR(dmrData);
+    }
+}
+
+/* Helper to write the next voice frame of the current call. */
+
+void LoadPeer::writeFrame(uint64_t now, uint32_t receivers, LoadStats& stats)
+{
+    switch (m_mode) {
+    case LOAD_MODE_DMR:
+    {
+        using namespace dmr;
+        using namespace dmr::defines;
+
+        uint8_t n = (uint8_t)(m_frame % 6U);
+
+        uint8_t data[DMR_FRAME_LENGTH_BYTES];
+        ::memcpy(data, SILENCE_DATA + 2U, DMR_FRAME_LENGTH_BYTES);
+
+        DataType::E dataType = DataType::VOICE_SYNC;
+        if (n != 0U) {
+            dataType = DataType::VOICE;
+
+            uint8_t lcss = m_dmrEmbeddedData.getData(data, n);
+
+            // generated embedded signalling
+            data::EMB emb = data::EMB();
+            emb.setColorCode(0U);
+            emb.setLCSS(lcss);
+            emb.encode(data);
+        }
+
+        stamp(data);
+
+        data::NetData dmrData;
+        dmrData.setSlotNo(1U);
+        dmrData.setDataType(dataType);
+        dmrData.setSrcId(m_srcId);
+        dmrData.setDstId(m_dstId);
+        dmrData.setFLCO(FLCO::GROUP);
+        dmrData.setN(n);
+        dmrData.setSeqNo((uint8_t)(m_frame + 1U));
+        dmrData.setData(data);
+
+        writeDMR(dmrData);
+        m_nextFrame += LOAD_DMR_FRAME_MS * 1000ULL;
+    }
+    break;
+
+    case LOAD_MODE_P25:
+    {
+        using namespace p25;
+        using namespace p25::defines;
+
+        // the LDU is sent as an air interface frame, so the stamp is FEC encoded into the first IMBE codeword
+        uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
+        ::memset(imbe, 0x00U, RAW_IMBE_LENGTH_BYTES);
+        stamp(imbe);
+
+        ::memset(m_ldu, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+        m_p25Audio.encode(m_ldu, imbe, 0U);
+
+        lc::LC lc = lc::LC();
+        lc.setLCO(LCO::GROUP);
+        lc.setGroup(true);
+        lc.setPriority(4U);
+        lc.setDstId(m_dstId);
+        lc.setSrcId(m_srcId);
+
+        data::LowSpeedData lsd = data::LowSpeedData();
+
+        if ((m_frame & 1U) == 0U)
+            writeP25LDU1(lc, lsd, m_ldu, FrameType::HDU_VALID);
+        else
+            writeP25LDU2(lc, lsd, m_ldu);
+
+        m_nextFrame += LOAD_P25_FRAME_MS * 1000ULL;
+    }
+    break;
+
+    case LOAD_MODE_NXDN:
+    {
+        using namespace nxdn;
+        using namespace nxdn::defines;
+
+        uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+        ::memset(data, 0x00U, NXDN_FRAME_LENGTH_BYTES + 2U);
+        data[0U] = LOAD_NXDN_TAG_DATA;
+
+        stamp(data + NXDN_STAMP_OFFSET);
+
+        lc::RTCH lc = lc::RTCH();
+        lc.setMessageType(MessageType::RTCH_VCALL);
+        lc.setGroup(true);
+        lc.setSrcId(m_srcId);
+        lc.setDstId(m_dstId);
+
+        writeNXDN(lc, data, NXDN_FRAME_LENGTH_BYTES + 2U);
+        m_nextFrame += LOAD_NXDN_FRAME_MS * 1000ULL;
+    }
+    break;
+    }
+
+    stats.frameSent(receivers);
+    m_frame++;
+}
+
+/* Helper to end the current call. */
+
+void LoadPeer::endCall()
+{
+    m_callActive = false;
+
+    switch (m_mode) {
+    case LOAD_MODE_DMR:
+    {
+        using namespace dmr;
+        using namespace dmr::defines;
+
+        uint8_t data[DMR_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+        lc::LC dmrLC = lc::LC();
+        dmrLC.setFLCO(FLCO::GROUP);
+        dmrLC.setSrcId(m_srcId);
+        dmrLC.setDstId(m_dstId);
+
+        // generate the Slot Type
+        SlotType slotType = SlotType();
+        slotType.setDataType(DataType::TERMINATOR_WITH_LC);
+        slotType.encode(data);
+
+        lc::FullLC fullLC = lc::FullLC();
+        fullLC.encode(dmrLC, data, DataType::TERMINATOR_WITH_LC);
+
+        data::NetData dmrData;
+        dmrData.setSlotNo(1U);
+        dmrData.setDataType(DataType::TERMINATOR_WITH_LC);
+        dmrData.setSrcId(m_srcId);
+        dmrData.setDstId(m_dstId);
+        dmrData.setFLCO(FLCO::GROUP);
+        dmrData.setSeqNo((uint8_t)(m_frame + 1U));
+        dmrData.setData(data);
+
+        writeDMR(dmrData);
+        resetDMR(1U);
+    }
+    break;
+
+    case LOAD_MODE_P25:
+    {
+        p25::lc::LC lc = p25::lc::LC();
+        lc.setLCO(p25::defines::LCO::GROUP);
+        lc.setDstId(m_dstId);
+        lc.setSrcId(m_srcId);
+
+        p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
+
+        writeP25TDU(lc, lsd, 0x00U);
+        resetP25();
+    }
+    break;
+
+    case LOAD_MODE_NXDN:
+    {
+        using namespace nxdn::defines;
+
+        uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+        ::memset(data, 0x00U, NXDN_FRAME_LENGTH_BYTES + 2U);
+        data[0U] = LOAD_NXDN_TAG_EOT;
+
+        nxdn::lc::RTCH lc = nxdn::lc::RTCH();
+        lc.setMessageType(MessageType::RTCH_TX_REL);
+        lc.setGroup(true);
+        lc.setSrcId(m_srcId);
+        lc.setDstId(m_dstId);
+
+        writeNXDN(lc, data, NXDN_FRAME_LENGTH_BYTES + 2U);
+        resetNXDN();
+    }
+    break;
+    }
+}
+
+/* Helper to write the send timestamp into a voice payload. */
+
+void LoadPeer::stamp(uint8_t* data)
+{
+    assert(data != nullptr);
+
+    uint64_t sent = now() & STAMP_MASK;
+
+    data[0U] = LOAD_PAYLOAD_MAGIC[0U];
+    data[1U] = LOAD_PAYLOAD_MAGIC[1U];
+    for (uint32_t i = LOAD_PAYLOAD_STAMP_LEN - 1U; i >= 2U; i--) {
+        data[i] = (uint8_t)(sent & 0xFFU);
+        sent >>= 8;
+    }
+}
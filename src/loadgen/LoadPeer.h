@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LoadPeer.h
+ * @ingroup loadgen
+ * @file LoadPeer.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__LOAD_PEER_H__)
+#define __LOAD_PEER_H__
+
+#include "Defines.h"
+#include "common/dmr/data/EmbeddedData.h"
+#include "common/p25/Audio.h"
+#include "host/network/Network.h"
+#include "LoadStats.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define LOAD_PEER_AFFILIATION_INTERVAL_MS 30000U
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a synthetic peer that logs into a FNE and generates voice traffic.
+ *
+ *  The peer performs the normal login, authorisation, configuration and ping exchange of
+ *  network::Network. Once traffic is enabled it repeatedly places a voice call at real-time
+ *  cadence; every voice frame carries the time it was sent, so peers receiving the forwarded
+ *  frame can measure the FNE forwarding latency.
+ * @ingroup loadgen
+ */
+class HOST_SW_API LoadPeer : public network::Network {
+public:
+    /**
+     * @brief Initializes a new instance of the LoadPeer class.
+     * @param address Network Hostname/IP address to connect to.
+     * @param port Network port number.
+     * @param peerId Unique ID on the network.
+     * @param password Network authentication password.
+     * @param debug Flag indicating whether network debug is enabled.
+     * @param dmr Flag indicating whether DMR is enabled.
+     * @param p25 Flag indicating whether P25 is enabled.
+     * @param nxdn Flag indicating whether NXDN is enabled.
+     */
+    LoadPeer(const std::string& address, uint16_t port, uint32_t peerId, const std::string& password, bool debug,
+        bool dmr, bool p25, bool nxdn);
+    /**
+     * @brief Finalizes a instance of the LoadPeer class.
+     */
+    ~LoadPeer() override;
+
+    /**
+     * @brief Sets the call this peer places.
+     * @param mode Digital mode (LOAD_MODE_DMR, LOAD_MODE_P25 or LOAD_MODE_NXDN).
+     * @param srcId Source ID.
+     * @param dstId Talkgroup ID.
+     * @param lengthMs Length of each call (ms).
+     * @param gapMs Idle time between calls (ms).
+     * @param offsetMs Delay before the first call (ms).
+     */
+    void setCall(uint8_t mode, uint32_t srcId, uint32_t dstId, uint32_t lengthMs, uint32_t gapMs, uint32_t offsetMs);
+    /**
+     * @brief Sets the group affiliation this peer announces.
+     * @param srcId Source ID.
+     * @param dstId Talkgroup ID.
+     */
+    void setAffiliation(uint32_t srcId, uint32_t dstId);
+
+    /**
+     * @brief Updates network state, reads forwarded frames and writes any voice frames that are due.
+     * @param now Current time (us).
+     * @param ms Number of milliseconds since the last call.
+     * @param traffic Flag indicating calls should be placed.
+     * @param receivers Number of other logged in peers each voice frame should be forwarded to.
+     * @param stats Per-mode statistics (LOAD_MODE_COUNT entries).
+     */
+    void process(uint64_t now, uint32_t ms, bool traffic, uint32_t receivers, LoadStats* stats);
+
+    /**
+     * @brief Gets the time (us) the next voice frame is due, 0 if no call is in progress.
+     * @returns uint64_t Time the next voice frame is due.
+     */
+    uint64_t nextFrameTime() const { return m_callActive ? m_nextFrame : 0U; }
+    /**
+     * @brief Gets the UDP socket of this peer.
+     * @returns udp::Socket* UDP socket.
+     */
+    network::udp::Socket* socket() const { return m_socket; }
+    /**
+     * @brief Helper to determine whether the peer is logged in.
+     * @returns bool True, if the peer is logged in, otherwise false.
+     */
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Gets the current monotonic time (us).
+     * @returns uint64_t Current time (us).
+     */
+    static uint64_t now();
+
+private:
+    std::atomic<bool> m_running;
+
+    uint8_t m_mode;
+    uint32_t m_srcId;
+    uint32_t m_dstId;
+    uint32_t m_lengthMs;
+    uint32_t m_gapMs;
+    uint32_t m_offsetMs;
+
+    uint32_t m_affSrcId;
+    uint32_t m_affDstId;
+    uint64_t m_nextAffiliation;
+
+    bool m_callConfigured;
+    bool m_callActive;
+    uint64_t m_nextCall;
+    uint64_t m_nextFrame;
+    uint32_t m_frame;
+    uint32_t m_frameCount;
+
+    dmr::data::EmbeddedData m_dmrEmbeddedData;
+    p25::Audio m_p25Audio;
+    uint8_t* m_ldu;
+
+    std::vector<network::udp::Socket*> m_waitSockets;
+
+    /**
+     * @brief Helper to read forwarded frames and record their latency.
+     * @param now Current time (us).
+     * @param stats Per-mode statistics.
+     */
+    void readFrames(uint64_t now, LoadStats* stats);
+    /**
+     * @brief Helper to record the latency of a forwarded voice frame.
+     * @param now Current time (us).
+     * @param data Buffer containing the send timestamp.
+     * @param stats Statistics to update.
+     */
+    void recordFrame(uint64_t now, const uint8_t* data, LoadStats& stats);
+
+    /**
+     * @brief Helper to start a call.
+     * @param now Current time (us).
+     * @param stats Statistics to update.
+     */
+    void startCall(uint64_t now, LoadStats& stats);
+    /**
+     * @brief Helper to write the next voice frame of the current call.
+     * @param now Current time (us).
+     * @param receivers Number of peers the frame should be forwarded to.
+     * @param stats Statistics to update.
+     */
+    void writeFrame(uint64_t now, uint32_t receivers, LoadStats& stats);
+    /**
+     * @brief Helper to end the current call.
+     */
+    void endCall();
+
+    /**
+     * @brief Helper to write the send timestamp into a voice payload.
+     * @param data Buffer to write the timestamp to.
+     */
+    static void stamp(uint8_t* data);
+};
+
+#endif // __LOAD_PEER_H__
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "LoadStats.h"
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LoadStats class. */
+
+LoadStats::LoadStats() :
+    m_calls(0U),
+    m_sent(0U),
+    m_expected(0U),
+    m_received(0U),
+    m_maxLatency(0U),
+    m_buckets(LOAD_STATS_BUCKETS, 0U)
+{
+    /* stub */
+}
+
+/* Records a voice frame received. */
+
+void LoadStats::frameReceived(uint64_t latencyUs)
+{
+    m_received++;
+    if (latencyUs > m_maxLatency)
+        m_maxLatency = latencyUs;
+
+    uint64_t bucket = latencyUs / LOAD_STATS_BUCKET_US;
+    if (bucket >= LOAD_STATS_BUCKETS)
+        bucket = LOAD_STATS_BUCKETS - 1U;
+    m_buckets[bucket]++;
+}
+
+/* Adds the counters and histogram of the given instance to this instance. */
+
+void LoadStats::merge(const LoadStats& stats)
+{
+    m_calls += stats.m_calls;
+    m_sent += stats.m_sent;
+    m_expected += stats.m_expected;
+    m_received += stats.m_received;
+    if (stats.m_maxLatency > m_maxLatency)
+        m_maxLatency = stats.m_maxLatency;
+
+    for (uint32_t i = 0U; i < LOAD_STATS_BUCKETS; i++)
+        m_buckets[i] += stats.m_buckets[i];
+}
+
+/* Gets the latency (us) at the given percentile. */
+
+uint64_t LoadStats::percentile(double percentile) const
+{
+    if (m_received == 0U)
+        return 0U;
+
+    uint64_t target = (uint64_t)((percentile / 100.0) * (double)m_received);
+    if (target >= m_received)
+        target = m_received - 1U;
+
+    uint64_t count = 0U;
+    for (uint32_t i = 0U; i < LOAD_STATS_BUCKETS; i++) {
+        count += m_buckets[i];
+        if (count > target) {
+            // report the upper edge of the bucket, but never more than what was actually seen
+            uint64_t latency = (i + 1U) * LOAD_STATS_BUCKET_US;
+            return (latency > m_maxLatency) ? m_maxLatency : latency;
+        }
+    }
+
+    return m_maxLatency;
+}
+
+/* Gets the percentage of expected frames that were not received. */
+
+double LoadStats::loss() const
+{
+    if (m_expected == 0U || m_received >= m_expected)
+        return 0.0;
+
+    return ((double)(m_expected - m_received) * 100.0) / (double)m_expected;
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Peer Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LoadStats.h
+ * @ingroup loadgen
+ * @file LoadStats.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__LOAD_STATS_H__)
+#define __LOAD_STATS_H__
+
+#include "Defines.h"
+
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define LOAD_STATS_BUCKET_US 10U
+#define LOAD_STATS_BUCKETS 20000U
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements per-mode frame counters and a forwarding latency histogram.
+ *
+ *  Latencies are binned into 10us buckets up to 200ms (anything slower lands in the last
+ *  bucket; the true maximum is kept separately), so instances owned by different worker
+ *  threads can be merged without locking and percentiles computed once at the end.
+ * @ingroup loadgen
+ */
+class HOST_SW_API LoadStats {
+public:
+    /**
+     * @brief Initializes a new instance of the LoadStats class.
+     */
+    LoadStats();
+
+    /**
+     * @brief Records a call started.
+     */
+    void callStarted() { m_calls++; }
+    /**
+     * @brief Records a voice frame sent.
+     * @param expectedReceivers Number of peers the FNE is expected to forward the frame to.
+     */
+    void frameSent(uint32_t expectedReceivers) { m_sent++; m_expected += expectedReceivers; }
+    /**
+     * @brief Records a voice frame received.
+     * @param latencyUs Forwarding latency (us).
+     */
+    void frameReceived(uint64_t latencyUs);
+
+    /**
+     * @brief Adds the counters and histogram of the given instance to this instance.
+     * @param stats Instance to merge.
+     */
+    void merge(const LoadStats& stats);
+
+    /**
+     * @brief Gets the latency (us) at the given percentile.
+     * @param percentile Percentile (0 - 100).
+     * @returns uint64_t Latency (us).
+     */
+    uint64_t percentile(double percentile) const;
+    /**
+     * @brief Gets the percentage of expected frames that were not received.
+     * @returns double Frame loss (percent).
+     */
+    double loss() const;
+
+    /**
+     * @brief Number of calls started.
+     */
+    __READONLY_PROPERTY_PLAIN(uint64_t, calls);
+    /**
+     * @brief Number of voice frames sent.
+     */
+    __READONLY_PROPERTY_PLAIN(uint64_t, sent);
+    /**
+     * @brief Number of voice frames the FNE was expected to forward.
+     */
+    __READONLY_PROPERTY_PLAIN(uint64_t, expected);
+    /**
+     * @brief Number of voice frames received.
+     */
+    __READONLY_PROPERTY_PLAIN(uint64_t, received);
+    /**
+     * @brief Maximum latency (us).
+     */
+    __READONLY_PROPERTY_PLAIN(uint64_t, maxLatency);
+
+private:
+    std::vector<uint32_t> m_buckets;
+};
+
+#endif // __LOAD_STATS_H__
@@ -10,12 +10,9 @@
 #include "Defines.h"
 #include "common/edac/SHA256.h"
 #include "common/network/json/json.h"
-#include "common/network/rest/http/HTTPClient.h"
-#include "common/network/rest/http/SecureHTTPClient.h"
-#include "common/network/rest/RequestDispatcher.h"
-#include "common/Thread.h"
 #include "common/Log.h"
 #include "remote/RESTClient.h"
+#include "remote/RESTSession.h"
 
 using namespace network;
 using namespace network::rest::http;
@@ -25,60 +22,14 @@ using namespace network::rest::http;
 #include <cstdlib>
 #include <cstring>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 
-// ---------------------------------------------------------------------------
-//  Constants
-// ---------------------------------------------------------------------------
-
-#define ERRNO_SOCK_OPEN 98
-#define ERRNO_BAD_API_RESPONSE 97
-#define ERRNO_API_CALL_TIMEOUT 96
-#define ERRNO_BAD_AUTH_RESPONSE 95
-#define ERRNO_INTERNAL_ERROR 100
-
-#define ERRNO_NO_ADDRESS 404
-#define ERRNO_NO_PASSWORD 403
-
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
 
-bool RESTClient::m_responseAvailable = false;
-HTTPPayload RESTClient::m_response;
-
 bool RESTClient::m_console = false;
-bool RESTClient::m_enableSSL = false;
-bool RESTClient::m_debug = false;
-
-// ---------------------------------------------------------------------------
-//  Global Functions
-// ---------------------------------------------------------------------------
-
-/* */
-
-bool parseResponseBody(const HTTPPayload& response, json::object& obj)
-{
-    std::string contentType = response.headers.find("Content-Type");
-    if (contentType != "application/json") {
-        return false;
-    }
-
-    // parse JSON body
-    json::value v;
-    std::string err = json::parse(v, response.content);
-    if (!err.empty()) {
-        return false;
-    }
-
-    // ensure parsed JSON is an object
-    if (!v.is<json::object>()) {
-        return false;
-    }
-
-    obj = v.get<json::object>();
-    return true;
-}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -89,14 +40,14 @@ bool parseResponseBody(const HTTPPayload& response, json::object& obj)
 RESTClient::RESTClient(const std::string& address, uint32_t port, const std::string& password, bool enableSSL, bool debug) :
     m_address(address),
     m_port(port),
-    m_password(password)
+    m_password(password),
+    m_enableSSL(enableSSL),
+    m_debug(debug)
 {
     assert(!address.empty());
     assert(port > 0U);
 
     m_console = true;
-    m_enableSSL = enableSSL;
-    m_debug = debug;
 }
 
 /* Finalizes a instance of the RESTClient class. */
@@ -115,7 +66,7 @@ int RESTClient::send(const std::string method, const std::string endpoint, json:
 
 int RESTClient::send(const std::string method, const std::string endpoint, json::object payload, json::object& response)
 {
-    return send(m_address, m_port, m_password, method, endpoint, payload, response, m_enableSSL, m_debug);
+    return send(m_address, m_port, m_password, method, endpoint, payload, response, m_enableSSL, REST_DEFAULT_WAIT, m_debug);
 }
 
 /* Sends remote control command to the specified modem. */
@@ -132,272 +83,140 @@ int RESTClient::send(const std::string& address, uint32_t port, const std::strin
 int RESTClient::send(const std::string& address, uint32_t port, const std::string& password, const std::string method,
     const std::string endpoint, json::object payload, json::object& response, bool enableSSL, int timeout, bool debug)
 {
-    if (address.empty()) {
-        return ERRNO_NO_ADDRESS;
-    }
-    if (address == "0.0.0.0") {
-        return ERRNO_NO_ADDRESS;
-    }
-    if (port <= 0U) {
-        return ERRNO_NO_ADDRESS;
-    }
-    if (password.empty()) {
-        return ERRNO_NO_PASSWORD;
+    int ret = validate(address, port, password);
+    if (ret != 0) {
+        return ret;
     }
 
-    int ret = EXIT_SUCCESS;
-    m_enableSSL = enableSSL;
-    m_debug = debug;
-
-    typedef network::rest::BasicRequestDispatcher<network::rest::http::HTTPPayload, network::rest::http::HTTPPayload> RESTDispatcherType;
-    RESTDispatcherType m_dispatcher(RESTClient::responseHandler);
-    HTTPClient<RESTDispatcherType>* client = nullptr;
-#if defined(ENABLE_TCP_SSL)
-    SecureHTTPClient<RESTDispatcherType>* sslClient = nullptr;
-#endif // ENABLE_TCP_SSL
-
-    try {
-        // setup HTTP client for authentication payload
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient = new SecureHTTPClient<RESTDispatcherType>(address, port);
-            if (!sslClient->open()) {
-                delete sslClient;
-                return ERRNO_SOCK_OPEN;
-            }
-            sslClient->setHandler(m_dispatcher);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client = new HTTPClient<RESTDispatcherType>(address, port);
-            if (!client->open()) {
-                delete client;
-                return ERRNO_SOCK_OPEN;
+    response = json::object();
+    ret = RESTSession::get(address, port, password, enableSSL, debug)->send(method, endpoint, payload, response, timeout);
+
+    // only a response from the endpoint carries a body
+    if (!response.empty()) {
+        std::string content = json::value(response).serialize();
+        if (m_console) {
+            fprintf(stdout, "%s\r\n", content.c_str());
+        }
+        else {
+            if (debug) {
+                if (content.size() < 4095) {
+                    ::LogDebug(LOG_REST, "REST Response: %s", content.c_str());
+                }
+                // bryanb: this will cause REST responses >4095 characters to simply not print...
             }
-            client->setHandler(m_dispatcher);
-#if defined(ENABLE_TCP_SSL)
         }
-#endif // ENABLE_TCP_SSL
+    }
 
-        // generate password SHA hash
-        size_t size = password.size();
+    return ret;
+}
 
-        uint8_t* in = new uint8_t[size];
-        for (size_t i = 0U; i < size; i++)
-            in[i] = password.at(i);
+/* Queues a remote control command to the specified modem, and returns without waiting for the response. */
 
-        uint8_t out[32U];
-        ::memset(out, 0x00U, 32U);
+bool RESTClient::sendAsync(const std::string& address, uint32_t port, const std::string& password, const std::string method,
+    const std::string endpoint, json::object payload, ResponseHandler handler, bool enableSSL, int timeout, bool debug)
+{
+    if (validate(address, port, password) != 0) {
+        return false;
+    }
 
-        edac::SHA256 sha256;
-        sha256.buffer(in, (uint32_t)(size), out);
+    return RESTSession::get(address, port, password, enableSSL, debug)->sendAsync(method, endpoint, payload, handler, timeout);
+}
 
-        delete[] in;
+/* Queues a remote control command to the specified modem, and returns a future for its result. */
 
-        std::stringstream ss;
-        ss << std::hex;
+std::future<RESTClient::Result> RESTClient::sendFuture(const std::string& address, uint32_t port, const std::string& password,
+    const std::string method, const std::string endpoint, json::object payload, bool enableSSL, int timeout, bool debug)
+{
+    std::shared_ptr<std::promise<Result>> promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> result = promise->get_future();
 
-        for (uint8_t i = 0; i < 32U; i++)
-            ss << std::setw(2) << std::setfill('0') << (int)out[i];
+    int ret = validate(address, port, password);
+    if (ret != 0) {
+        promise->set_value(Result { ret, json::object() });
+        return result;
+    }
 
-        std::string hash = ss.str();
+    bool queued = RESTSession::get(address, port, password, enableSSL, debug)->sendAsync(method, endpoint, payload,
+        [promise](int ret, json::object& rsp) { promise->set_value(Result { ret, rsp }); }, timeout);
+    if (!queued) {
+        promise->set_value(Result { ERRNO_INTERNAL_ERROR, json::object() });
+    }
 
-        // send authentication API
-        json::object request = json::object();
-        request["auth"].set<std::string>(hash);
+    return result;
+}
 
-        HTTPPayload httpPayload = HTTPPayload::requestPayload(HTTP_PUT, "/auth");
-        httpPayload.payload(request);
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->request(httpPayload);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client->request(httpPayload);
-#if defined(ENABLE_TCP_SSL)
-        }
-#endif // ENABLE_TCP_SSL
-
-        // wait for response and parse
-        if (wait()) {
-#if defined(ENABLE_TCP_SSL)
-            if (m_enableSSL) {
-                sslClient->close();
-                delete sslClient;
-            } else {
-#endif // ENABLE_TCP_SSL
-                client->close();
-                delete client;
-#if defined(ENABLE_TCP_SSL)
-            }
-#endif // ENABLE_TCP_SSL
-            return ERRNO_API_CALL_TIMEOUT;
-        }
+/* Helper to parse the JSON body of a REST API response. */
 
-        json::object rsp = json::object();
-        if (!parseResponseBody(m_response, rsp)) {
-            return ERRNO_BAD_API_RESPONSE;
-        }
+bool RESTClient::parseResponseBody(const HTTPPayload& response, json::object& obj)
+{
+    std::string contentType = response.headers.find("Content-Type");
+    if (contentType != "application/json") {
+        return false;
+    }
 
-        std::string token = "";
-        int status = rsp["status"].get<int>();
-        if (status == HTTPPayload::StatusType::OK) {
-            token = rsp["token"].get<std::string>();
-        }
-        else {
-#if defined(ENABLE_TCP_SSL)
-            if (m_enableSSL) {
-                sslClient->close();
-                delete sslClient;
-            } else {
-#endif // ENABLE_TCP_SSL
-                client->close();
-                delete client;
-#if defined(ENABLE_TCP_SSL)
-            }
-#endif // ENABLE_TCP_SSL
-            return ERRNO_BAD_AUTH_RESPONSE;
-        }
+    // parse JSON body
+    json::value v;
+    std::string err = json::parse(v, response.content);
+    if (!err.empty()) {
+        return false;
+    }
 
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->close();
-            delete sslClient;
-        } else {
-#endif // ENABLE_TCP_SSL
-            client->close();
-            delete client;
-#if defined(ENABLE_TCP_SSL)
-        }
-#endif // ENABLE_TCP_SSL
-
-        // reset the HTTP client and setup for actual payload request
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient = new SecureHTTPClient<RESTDispatcherType>(address, port);
-            if (!sslClient->open()) {
-                delete sslClient;
-                return ERRNO_SOCK_OPEN;
-            }
-            sslClient->setHandler(m_dispatcher);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client = new HTTPClient<RESTDispatcherType>(address, port);
-            if (!client->open()) {
-                delete client;
-                return ERRNO_SOCK_OPEN;
-            }
-            client->setHandler(m_dispatcher);
-#if defined(ENABLE_TCP_SSL)
-        }
-#endif // ENABLE_TCP_SSL
-
-        // send actual API request
-        httpPayload = HTTPPayload::requestPayload(method, endpoint);
-        httpPayload.headers.add("X-DVM-Auth-Token", token);
-        httpPayload.payload(payload);
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->request(httpPayload);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client->request(httpPayload);
-#if defined(ENABLE_TCP_SSL)
-        }
-#endif // ENABLE_TCP_SSL
-
-        // wait for response and parse
-        if (wait()) {
-#if defined(ENABLE_TCP_SSL)
-            if (m_enableSSL) {
-                sslClient->close();
-                delete sslClient;
-            } else {
-#endif // ENABLE_TCP_SSL
-                client->close();
-                delete client;
-#if defined(ENABLE_TCP_SSL)
-            }
-#endif // ENABLE_TCP_SSL
-            return ERRNO_API_CALL_TIMEOUT;
-        }
+    // ensure parsed JSON is an object
+    if (!v.is<json::object>()) {
+        return false;
+    }
 
-        response = json::object();
-        if (!parseResponseBody(m_response, response)) {
-            return ERRNO_BAD_API_RESPONSE;
-        }
+    obj = v.get<json::object>();
+    return true;
+}
 
-        ret = response["status"].get<int>();
-        if (m_console) {
-            fprintf(stdout, "%s\r\n", m_response.content.c_str());
-        }
-        else {
-            if (m_debug) {
-                if (m_response.content.size() < 4095) {
-                    ::LogDebug(LOG_REST, "REST Response: %s", m_response.content.c_str());
-                }
-                // bryanb: this will cause REST responses >4095 characters to simply not print...
-            }
-        }
+/* Helper to generate the authentication hash for the given password. */
 
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->close();
-            delete sslClient;
-        } else {
-#endif // ENABLE_TCP_SSL
-            client->close();
-            delete client;
-#if defined(ENABLE_TCP_SSL)
-        }
-#endif // ENABLE_TCP_SSL
-    }
-    catch (std::exception&) {
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            if (sslClient != nullptr) {
-                delete sslClient;
-            }
-        } else {
-#endif // ENABLE_TCP_SSL
-            if (client != nullptr) {
-                delete client;
-            }
-#if defined(ENABLE_TCP_SSL)
-        }
-#endif // ENABLE_TCP_SSL
-        return ERRNO_INTERNAL_ERROR;
-    }
+std::string RESTClient::hashPassword(const std::string& password)
+{
+    size_t size = password.size();
 
-    return ret;
+    uint8_t* in = new uint8_t[size];
+    for (size_t i = 0U; i < size; i++)
+        in[i] = password.at(i);
+
+    uint8_t out[32U];
+    ::memset(out, 0x00U, 32U);
+
+    edac::SHA256 sha256;
+    sha256.buffer(in, (uint32_t)(size), out);
+
+    delete[] in;
+
+    std::stringstream ss;
+    ss << std::hex;
+
+    for (uint8_t i = 0; i < 32U; i++)
+        ss << std::setw(2) << std::setfill('0') << (int)out[i];
+
+    return ss.str();
 }
 
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* HTTP response handler. */
+/* Helper to validate the endpoint of a command. */
 
-void RESTClient::responseHandler(const HTTPPayload& request, HTTPPayload& reply)
+int RESTClient::validate(const std::string& address, uint32_t port, const std::string& password)
 {
-    m_responseAvailable = true;
-    m_response = request;
-}
-
-/* Helper to wait for a HTTP response. */
-
-bool RESTClient::wait(const int t)
-{
-    m_responseAvailable = false;
-
-    int timeout = t;
-    while (!m_responseAvailable && timeout > 0) {
-        timeout--;
-        Thread::sleep(1);
+    if (address.empty()) {
+        return ERRNO_NO_ADDRESS;
     }
-
-    if (timeout == 0) {
-        return true;
+    if (address == "0.0.0.0") {
+        return ERRNO_NO_ADDRESS;
+    }
+    if (port <= 0U) {
+        return ERRNO_NO_ADDRESS;
+    }
+    if (password.empty()) {
+        return ERRNO_NO_PASSWORD;
     }
 
-    return false;
+    return 0;
 }
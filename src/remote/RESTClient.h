@@ -27,22 +27,57 @@
 #include "common/network/json/json.h"
 #include "common/network/rest/http/HTTPPayload.h"
 
+#include <functional>
+#include <future>
 #include <string>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
 #define REST_DEFAULT_WAIT 500
 #define REST_QUICK_WAIT 150
 
+#define ERRNO_SOCK_OPEN 98
+#define ERRNO_BAD_API_RESPONSE 97
+#define ERRNO_API_CALL_TIMEOUT 96
+#define ERRNO_BAD_AUTH_RESPONSE 95
+#define ERRNO_INTERNAL_ERROR 100
+
+#define ERRNO_NO_ADDRESS 404
+#define ERRNO_NO_PASSWORD 403
+
 // ---------------------------------------------------------------------------
 //  Class Declaration
 // ---------------------------------------------------------------------------
 
 /**
  * @brief This class implements the REST client logic.
+ *
+ *  Requests are sent over the shared keep-alive session for the endpoint (see RESTSession), so
+ *  repeated requests to the same endpoint reuse the connection and the cached authentication
+ *  token. The send() calls block until the response arrives (or times out); the sendAsync() and
+ *  sendFuture() calls return immediately and report the result through a callback or a future.
  * @ingroup remote_rest
  */
 class HOST_SW_API RESTClient
 {
 public:
+    /**
+     * @brief Callback invoked when an asynchronous request completes.
+     * @param status REST API status, or error number.
+     * @param response REST API endpoint response.
+     */
+    typedef std::function<void(int status, json::object& response)> ResponseHandler;
+
+    /**
+     * @brief Represents the result of a request sent with sendFuture().
+     */
+    struct Result {
+        int status;                         //! REST API status, or error number.
+        json::object response;              //! REST API endpoint response.
+    };
+
     /**
      * @brief Initializes a new instance of the RESTClient class.
      * @param address Network Hostname/IP address to connect to.
@@ -84,6 +119,7 @@ public:
      * @param endpoint REST API endpoint.
      * @param payload REST API endpoint payload.
      * @param enableSSL Flag indicating whether or not HTTPS is enabled.
+     * @param timeout REST response wait timeout (ms).
      * @param debug Flag indicating whether debug is enabled.
      * @returns EXIT_SUCCESS, if command was sent, otherwise EXIT_FAILURE.
      */
@@ -99,39 +135,78 @@ public:
      * @param payload REST API endpoint payload.
      * @param response REST API endpoint response.
      * @param enableSSL Flag indicating whether or not HTTPS is enabled.
-     * @param timeout REST response wait timeout.
+     * @param timeout REST response wait timeout (ms).
      * @param debug Flag indicating whether debug is enabled.
      * @returns EXIT_SUCCESS, if command was sent, otherwise EXIT_FAILURE.
      */
     static int send(const std::string& address, uint32_t port, const std::string& password, const std::string method,
         const std::string endpoint, json::object payload, json::object& response, bool enableSSL, int timeout, bool debug = false);
 
-private:
-    typedef network::rest::http::HTTPPayload HTTPPayload;
     /**
-     * @brief HTTP response handler.
-     * @param request HTTP request.
-     * @param reply HTTP reply.
+     * @brief Queues a remote control command to the specified modem, and returns without waiting for the response.
+     * @param address Network Hostname/IP address to connect to.
+     * @param port Network port number.
+     * @param password Authentication password.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param handler Callback invoked with the result, from the session worker thread; may be empty. The callback
+     *  must not make a blocking send() to the same endpoint.
+     * @param enableSSL Flag indicating whether or not HTTPS is enabled.
+     * @param timeout REST response wait timeout (ms).
+     * @param debug Flag indicating whether debug is enabled.
+     * @returns bool True, if the command was queued, otherwise false (the callback is not invoked).
      */
-    static void responseHandler(const HTTPPayload& request, HTTPPayload& reply);
+    static bool sendAsync(const std::string& address, uint32_t port, const std::string& password, const std::string method,
+        const std::string endpoint, json::object payload, ResponseHandler handler, bool enableSSL, int timeout = REST_DEFAULT_WAIT,
+        bool debug = false);
+    /**
+     * @brief Queues a remote control command to the specified modem, and returns a future for its result.
+     * @param address Network Hostname/IP address to connect to.
+     * @param port Network port number.
+     * @param password Authentication password.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param enableSSL Flag indicating whether or not HTTPS is enabled.
+     * @param timeout REST response wait timeout (ms).
+     * @param debug Flag indicating whether debug is enabled.
+     * @returns std::future<Result> Future for the REST API status (or error number) and response.
+     */
+    static std::future<Result> sendFuture(const std::string& address, uint32_t port, const std::string& password, const std::string method,
+        const std::string endpoint, json::object payload, bool enableSSL, int timeout = REST_DEFAULT_WAIT, bool debug = false);
 
     /**
-     * @brief Helper to wait for a HTTP response.
-     * @returns True, if timed out, otherwise false.
+     * @brief Helper to parse the JSON body of a REST API response.
+     * @param response HTTP response.
+     * @param[out] obj Parsed JSON object.
+     * @returns bool True, if the response contained a JSON object, otherwise false.
      */
-    static bool wait(const int t = REST_DEFAULT_WAIT);
+    static bool parseResponseBody(const network::rest::http::HTTPPayload& response, json::object& obj);
+    /**
+     * @brief Helper to generate the authentication hash for the given password.
+     * @param password Authentication password.
+     * @returns std::string Hex encoded SHA256 hash of the password.
+     */
+    static std::string hashPassword(const std::string& password);
+
+private:
+    /**
+     * @brief Helper to validate the endpoint of a command.
+     * @param address Network Hostname/IP address.
+     * @param port Network port number.
+     * @param password Authentication password.
+     * @returns int Zero, if the endpoint is valid, otherwise error number.
+     */
+    static int validate(const std::string& address, uint32_t port, const std::string& password);
 
     std::string m_address;
     uint32_t m_port;
     std::string m_password;
+    bool m_enableSSL;
+    bool m_debug;
 
     static bool m_console;
-
-    static bool m_responseAvailable;
-    static HTTPPayload m_response;
-
-    static bool m_enableSSL;
-    static bool m_debug;
 };
 
 #endif // __REMOTE_COMMAND_H__
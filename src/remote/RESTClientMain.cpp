@@ -8,6 +8,7 @@
  *
  */
 #include "remote/RESTClient.h"
+#include "remote/RESTSession.h"
 #include "host/network/RESTDefines.h"
 #include "fne/network/RESTDefines.h"
 #include "common/Thread.h"
@@ -939,6 +940,9 @@ int main(int argc, char** argv)
         }
     }
 
+    RESTSession::closeAll();
+    delete client;
+
     ::LogFinalise();
     return retCode;
 }
@@ -0,0 +1,563 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Remote Command Client
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "common/network/rest/http/HTTPClient.h"
+#include "common/network/rest/http/SecureHTTPClient.h"
+#include "common/Thread.h"
+#include "common/Log.h"
+#include "remote/RESTSession.h"
+
+using namespace network;
+using namespace network::rest::http;
+
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <memory>
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+std::mutex RESTSession::m_sessionsLock;
+std::map<RESTSession::SessionKey, RESTSession*> RESTSession::m_sessions;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the RESTSession class. */
+
+RESTSession::RESTSession(const std::string& address, uint32_t port, const std::string& password, bool enableSSL, bool debug) :
+    m_address(address),
+    m_port(port),
+    m_password(password),
+    m_enableSSL(enableSSL),
+    m_debug(debug),
+    m_client(nullptr),
+#if defined(ENABLE_TCP_SSL)
+    m_sslClient(nullptr),
+#endif // ENABLE_TCP_SSL
+    m_token(),
+    m_requestLock(),
+    m_responseLock(),
+    m_responseCond(),
+    m_responseAvailable(false),
+    m_response(),
+    m_queueLock(),
+    m_queueCond(),
+    m_queue(),
+    m_started(false),
+    m_running(false),
+    m_stopped(false),
+    m_workerId(),
+    m_statsLock(),
+    m_stats(),
+    m_totalRtt(0U)
+{
+    assert(!address.empty());
+    assert(port > 0U);
+}
+
+/* Finalizes a instance of the RESTSession class. */
+
+RESTSession::~RESTSession()
+{
+    close();
+}
+
+/* Sends a request and waits for the response. */
+
+int RESTSession::send(const std::string method, const std::string endpoint, json::object payload, int timeout)
+{
+    json::object rsp = json::object();
+    return send(method, endpoint, payload, rsp, timeout);
+}
+
+/* Sends a request and waits for the response. */
+
+int RESTSession::send(const std::string method, const std::string endpoint, json::object payload, json::object& response, int timeout)
+{
+    // the worker would wait on itself until the timeout, and the request would always fail
+    if (isWorkerThread()) {
+        LogError(LOG_REST, "REST session to %s:%u, %s %s sent from a completion callback, dropping", m_address.c_str(), m_port,
+            method.c_str(), endpoint.c_str());
+        return ERRNO_INTERNAL_ERROR;
+    }
+
+    // the result is shared with the worker, which may still complete the request after we've given up on it
+    struct Result {
+        std::promise<int> status;
+        json::object response;
+    };
+    std::shared_ptr<Result> result = std::make_shared<Result>();
+    std::future<int> status = result->status.get_future();
+
+    // requests are funneled through the worker so they reach the endpoint in the order they were made
+    bool queued = enqueue(method, endpoint, payload, [result](int ret, json::object& rsp) {
+        result->response = rsp;
+        result->status.set_value(ret);
+    }, timeout, true);
+    if (!queued) {
+        return ERRNO_INTERNAL_ERROR;
+    }
+
+    // the timeout covers the whole request, including any time spent queued behind other requests
+    if (status.wait_for(std::chrono::milliseconds(timeout)) != std::future_status::ready) {
+        LogError(LOG_REST, "REST session to %s:%u, %s %s timed out", m_address.c_str(), m_port, method.c_str(), endpoint.c_str());
+        return ERRNO_API_CALL_TIMEOUT;
+    }
+
+    int ret = status.get();
+    response = result->response;
+    return ret;
+}
+
+/* Queues a request to be sent by the session worker thread. */
+
+bool RESTSession::sendAsync(const std::string method, const std::string endpoint, json::object payload,
+    CompletionHandler handler, int timeout)
+{
+    return enqueue(method, endpoint, payload, handler, timeout, false);
+}
+
+/* Waits for queued requests, stops the worker thread and closes the connection. */
+
+void RESTSession::close()
+{
+    // the worker can't wait for itself to exit
+    if (isWorkerThread()) {
+        LogError(LOG_REST, "REST session to %s:%u closed from a completion callback, ignoring", m_address.c_str(), m_port);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_queueLock);
+        m_stopped = true;
+
+        if (m_running) {
+            m_queueCond.notify_all();
+
+            // wait for the (detached) worker to drain and exit
+            m_queueCond.wait(lock, [this] { return !m_running; });
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_requestLock);
+    disconnect();
+}
+
+/* Gets the request statistics of this session. */
+
+RESTSessionStats RESTSession::getStats()
+{
+    std::lock_guard<std::mutex> lock(m_statsLock);
+    return m_stats;
+}
+
+/* Gets the combined request statistics of the shared sessions for the given endpoint. */
+
+bool RESTSession::getStats(const std::string& address, uint32_t port, RESTSessionStats& stats)
+{
+    stats = RESTSessionStats();
+
+    // an endpoint may be reached through more than one session (e.g. with and without debug)
+    bool found = false;
+    uint64_t totalRtt = 0U;
+
+    std::lock_guard<std::mutex> lock(m_sessionsLock);
+    for (auto entry : m_sessions) {
+        if (std::get<0>(entry.first) != address || std::get<1>(entry.first) != port)
+            continue;
+
+        RESTSessionStats sessionStats = entry.second->getStats();
+        stats.requests += sessionStats.requests;
+        stats.failures += sessionStats.failures;
+        stats.connects += sessionStats.connects;
+        stats.lastRtt = sessionStats.lastRtt;
+        if (sessionStats.maxRtt > stats.maxRtt)
+            stats.maxRtt = sessionStats.maxRtt;
+
+        totalRtt += (uint64_t)sessionStats.avgRtt * (sessionStats.requests - sessionStats.failures);
+        found = true;
+    }
+
+    if (stats.requests > stats.failures)
+        stats.avgRtt = (uint32_t)(totalRtt / (stats.requests - stats.failures));
+
+    return found;
+}
+
+/* Closes and releases all shared sessions. */
+
+void RESTSession::closeAll()
+{
+    std::lock_guard<std::mutex> lock(m_sessionsLock);
+    for (auto entry : m_sessions) {
+        delete entry.second;
+    }
+    m_sessions.clear();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Gets the shared session for the given endpoint configuration, creating it if necessary. */
+
+RESTSession* RESTSession::get(const std::string& address, uint32_t port, const std::string& password, bool enableSSL, bool debug)
+{
+    SessionKey key = std::make_tuple(address, port, password, enableSSL, debug);
+
+    std::lock_guard<std::mutex> lock(m_sessionsLock);
+    auto it = m_sessions.find(key);
+    if (it != m_sessions.end())
+        return it->second;
+
+    RESTSession* session = new RESTSession(address, port, password, enableSSL, debug);
+    m_sessions[key] = session;
+    return session;
+}
+
+/* Helper to determine whether the caller is the session worker thread. */
+
+bool RESTSession::isWorkerThread()
+{
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    return m_running && m_workerId == std::this_thread::get_id();
+}
+
+/* Helper to queue a request for the worker thread. */
+
+bool RESTSession::enqueue(const std::string& method, const std::string& endpoint, json::object& payload,
+    CompletionHandler handler, int timeout, bool expires)
+{
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    if (m_stopped)
+        return false;
+
+    if (m_queue.size() >= REST_SESSION_MAX_PENDING) {
+        LogError(LOG_REST, "REST session to %s:%u has too many pending requests, dropping %s %s", m_address.c_str(), m_port,
+            method.c_str(), endpoint.c_str());
+        return false;
+    }
+
+    // the worker thread is started lazily, so it is created after any daemon fork()
+    if (!m_started) {
+        m_started = true;
+        m_running = true;
+        if (!Thread::runAsThread(this, threadWorker)) {
+            m_running = false;
+            m_started = false;
+            return false;
+        }
+    }
+
+    Request request;
+    request.method = method;
+    request.endpoint = endpoint;
+    request.payload = payload;
+    request.handler = handler;
+    request.timeout = timeout;
+    request.expires = expires;
+    request.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+    m_queue.push_back(request);
+
+    m_queueCond.notify_all();
+    return true;
+}
+
+/* Helper to send a request on the connection, connecting and authenticating as necessary. */
+
+int RESTSession::execute(const std::string& method, const std::string& endpoint, json::object& payload, json::object& response, int timeout)
+{
+    if (m_address == "0.0.0.0") {
+        return ERRNO_NO_ADDRESS;
+    }
+    if (m_password.empty()) {
+        return ERRNO_NO_PASSWORD;
+    }
+
+    std::lock_guard<std::mutex> lock(m_requestLock);
+    auto start = std::chrono::steady_clock::now();
+
+    int ret = HTTPPayload::StatusType::OK;
+    if (!isConnected()) {
+        ret = connect(timeout);
+    }
+
+    if (ret == HTTPPayload::StatusType::OK) {
+        ret = request(method, endpoint, payload, response, timeout, true);
+
+        // the token was invalidated (e.g. another client authenticated from this host); reauthenticate and retry once
+        if (ret == HTTPPayload::StatusType::UNAUTHORIZED) {
+            if (m_debug) {
+                LogDebug(LOG_REST, "REST session to %s:%u token rejected, reauthenticating", m_address.c_str(), m_port);
+            }
+
+            ret = connect(timeout);
+            if (ret == HTTPPayload::StatusType::OK) {
+                ret = request(method, endpoint, payload, response, timeout, true);
+            }
+        }
+    }
+
+    // a late response must never be taken for the response to the next request, so
+    // the connection is discarded whenever its state is unknown
+    if (ret == ERRNO_API_CALL_TIMEOUT || ret == ERRNO_BAD_API_RESPONSE) {
+        disconnect();
+    }
+
+    uint64_t rtt = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    updateStats(rtt, ret != HTTPPayload::StatusType::OK);
+
+    if (m_debug) {
+        LogDebug(LOG_REST, "REST session to %s:%u, %s %s, status = %d, rtt = %lluus", m_address.c_str(), m_port, method.c_str(),
+            endpoint.c_str(), ret, (unsigned long long)rtt);
+    }
+
+    return ret;
+}
+
+/* Helper to send a single request on the connection and wait for its response. */
+
+int RESTSession::request(const std::string& method, const std::string& endpoint, json::object& payload, json::object& response,
+    int timeout, bool useToken)
+{
+    HTTPPayload httpPayload = HTTPPayload::requestPayload(method, endpoint);
+    httpPayload.headers.add("Connection", "keep-alive");
+    if (useToken) {
+        httpPayload.headers.add("X-DVM-Auth-Token", m_token);
+    }
+    httpPayload.payload(payload);
+
+    {
+        std::lock_guard<std::mutex> lock(m_responseLock);
+        m_responseAvailable = false;
+    }
+
+    bool sent = false;
+#if defined(ENABLE_TCP_SSL)
+    if (m_enableSSL) {
+        sent = (m_sslClient != nullptr) && m_sslClient->request(httpPayload);
+    } else {
+#endif // ENABLE_TCP_SSL
+        sent = (m_client != nullptr) && m_client->request(httpPayload);
+#if defined(ENABLE_TCP_SSL)
+    }
+#endif // ENABLE_TCP_SSL
+    if (!sent) {
+        return ERRNO_SOCK_OPEN;
+    }
+
+    // wait for response and parse
+    HTTPPayload rsp;
+    {
+        std::unique_lock<std::mutex> lock(m_responseLock);
+        if (!m_responseCond.wait_for(lock, std::chrono::milliseconds(timeout), [this] { return m_responseAvailable; })) {
+            LogError(LOG_REST, "REST session to %s:%u, %s %s timed out", m_address.c_str(), m_port, method.c_str(), endpoint.c_str());
+            return ERRNO_API_CALL_TIMEOUT;
+        }
+
+        rsp = m_response;
+    }
+
+    response = json::object();
+    if (!RESTClient::parseResponseBody(rsp, response)) {
+        return ERRNO_BAD_API_RESPONSE;
+    }
+
+    if (!response["status"].is<int>()) {
+        return ERRNO_BAD_API_RESPONSE;
+    }
+
+    return response["status"].get<int>();
+}
+
+/* Helper to open the connection and authenticate. */
+
+int RESTSession::connect(int timeout)
+{
+    if (!isConnected()) {
+        disconnect();
+
+        RESTDispatcherType dispatcher(std::bind(&RESTSession::responseHandler, this, std::placeholders::_1, std::placeholders::_2));
+
+        bool opened = false;
+#if defined(ENABLE_TCP_SSL)
+        if (m_enableSSL) {
+            m_sslClient = new SecureClientType(m_address, m_port, true);
+            m_sslClient->setHandler(dispatcher);
+            opened = m_sslClient->open();
+        } else {
+#endif // ENABLE_TCP_SSL
+            m_client = new ClientType(m_address, m_port, true);
+            m_client->setHandler(dispatcher);
+            opened = m_client->open();
+#if defined(ENABLE_TCP_SSL)
+        }
+#endif // ENABLE_TCP_SSL
+        if (!opened) {
+            disconnect();
+            return ERRNO_SOCK_OPEN;
+        }
+
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        m_stats.connects++;
+    }
+
+    // send authentication API
+    json::object request = json::object();
+    request["auth"].set<std::string>(RESTClient::hashPassword(m_password));
+
+    json::object rsp = json::object();
+    int ret = this->request(HTTP_PUT, "/auth", request, rsp, timeout, false);
+    if (ret != HTTPPayload::StatusType::OK || !rsp["token"].is<std::string>()) {
+        LogError(LOG_REST, "REST session to %s:%u failed to authenticate, status = %d", m_address.c_str(), m_port, ret);
+        disconnect();
+        return (ret == ERRNO_API_CALL_TIMEOUT || ret == ERRNO_SOCK_OPEN) ? ret : ERRNO_BAD_AUTH_RESPONSE;
+    }
+
+    m_token = rsp["token"].get<std::string>();
+    return HTTPPayload::StatusType::OK;
+}
+
+/* Helper to close the connection and discard the cached token. */
+
+void RESTSession::disconnect()
+{
+    m_token = "";
+
+#if defined(ENABLE_TCP_SSL)
+    if (m_sslClient != nullptr) {
+        m_sslClient->close();
+        delete m_sslClient;
+        m_sslClient = nullptr;
+    }
+#endif // ENABLE_TCP_SSL
+    if (m_client != nullptr) {
+        m_client->close();
+        delete m_client;
+        m_client = nullptr;
+    }
+}
+
+/* Helper to determine whether the connection is open. */
+
+bool RESTSession::isConnected()
+{
+#if defined(ENABLE_TCP_SSL)
+    if (m_enableSSL) {
+        return (m_sslClient != nullptr) && m_sslClient->isOpen();
+    }
+#endif // ENABLE_TCP_SSL
+    return (m_client != nullptr) && m_client->isOpen();
+}
+
+/* HTTP response handler. */
+
+void RESTSession::responseHandler(const HTTPPayload& request, HTTPPayload& reply)
+{
+    std::lock_guard<std::mutex> lock(m_responseLock);
+    m_response = request;
+    m_responseAvailable = true;
+    m_responseCond.notify_all();
+}
+
+/* Helper to record the outcome of a request. */
+
+void RESTSession::updateStats(uint64_t rtt, bool failed)
+{
+    std::lock_guard<std::mutex> lock(m_statsLock);
+    m_stats.requests++;
+    if (failed) {
+        m_stats.failures++;
+        return;
+    }
+
+    m_stats.lastRtt = (uint32_t)rtt;
+    if (m_stats.lastRtt > m_stats.maxRtt)
+        m_stats.maxRtt = m_stats.lastRtt;
+
+    m_totalRtt += rtt;
+    m_stats.avgRtt = (uint32_t)(m_totalRtt / (m_stats.requests - m_stats.failures));
+}
+
+/* Entry point to the worker thread. */
+
+void* RESTSession::threadWorker(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+#if defined(_WIN32)
+        ::CloseHandle(th->thread);
+#else
+        ::pthread_detach(th->thread);
+#endif // defined(_WIN32)
+
+        RESTSession* session = static_cast<RESTSession*>(th->obj);
+        if (session == nullptr) {
+            delete th;
+            return nullptr;
+        }
+
+#ifdef _GNU_SOURCE
+        ::pthread_setname_np(th->thread, "rest:session");
+#endif // _GNU_SOURCE
+
+        std::unique_lock<std::mutex> lock(session->m_queueLock);
+        session->m_workerId = std::this_thread::get_id();
+        while (true) {
+            session->m_queueCond.wait(lock, [session] { return session->m_stopped || !session->m_queue.empty(); });
+            if (session->m_queue.empty())
+                break; // stopped and drained
+
+            Request request = session->m_queue.front();
+            session->m_queue.pop_front();
+
+            // the request is sent without holding the queue lock, so callers never wait on it
+            lock.unlock();
+
+            json::object rsp = json::object();
+            int status = ERRNO_API_CALL_TIMEOUT;
+
+            // a request whose caller has already given up (e.g. a grant that was denied on timeout) must not
+            // reach the endpoint late; otherwise it only gets whatever time its caller has left
+            int timeout = request.timeout;
+            if (request.expires) {
+                timeout = (int)std::chrono::duration_cast<std::chrono::milliseconds>(request.deadline - std::chrono::steady_clock::now()).count();
+            }
+
+            if (timeout > 0) {
+                status = session->execute(request.method, request.endpoint, request.payload, rsp, timeout);
+            }
+            else {
+                LogError(LOG_REST, "REST session to %s:%u, %s %s expired before it was sent", session->m_address.c_str(), session->m_port,
+                    request.method.c_str(), request.endpoint.c_str());
+                session->updateStats(0U, true);
+            }
+
+            if (request.handler) {
+                request.handler(status, rsp);
+            }
+
+            lock.lock();
+        }
+
+        // notify while still holding the lock, close() may destroy the session as soon as it is released
+        session->m_running = false;
+        session->m_workerId = std::thread::id();
+        session->m_queueCond.notify_all();
+        lock.unlock();
+
+        delete th;
+    }
+
+    return nullptr;
+}
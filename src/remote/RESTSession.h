@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Remote Command Client
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file RESTSession.h
+ * @ingroup remote_rest
+ * @file RESTSession.cpp
+ * @ingroup remote_rest
+ */
+#if !defined(__REST_SESSION_H__)
+#define __REST_SESSION_H__
+
+#include "common/Defines.h"
+#include "common/network/json/json.h"
+#include "common/network/rest/http/HTTPPayload.h"
+#include "common/network/rest/RequestDispatcher.h"
+#include "remote/RESTClient.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define REST_SESSION_MAX_PENDING 64U
+
+// ---------------------------------------------------------------------------
+//  Class Prototypes
+// ---------------------------------------------------------------------------
+
+namespace network { namespace rest { namespace http {
+    template<typename RequestHandlerType, template<class> class ConnectionImpl> class HTTPClient;
+    template<typename RequestHandlerType, template<class> class ConnectionImpl> class SecureHTTPClient;
+    template<typename RequestHandlerType> class ClientConnection;
+    template<typename RequestHandlerType> class SecureClientConnection;
+} } }
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents the request statistics of a REST session.
+ * @ingroup remote_rest
+ */
+struct RESTSessionStats {
+    uint32_t requests;                      //! Number of requests sent.
+    uint32_t failures;                      //! Number of requests that failed or timed out.
+    uint32_t connects;                      //! Number of times the connection was (re)established.
+    uint32_t lastRtt;                       //! Round trip time of the last request, including any reconnect (us).
+    uint32_t avgRtt;                        //! Average round trip time (us).
+    uint32_t maxRtt;                        //! Maximum round trip time (us).
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief This class implements a persistent, authenticated REST session to a single endpoint.
+ *
+ *  The session keeps one HTTP keep-alive connection open to the endpoint and caches the
+ *  authentication token obtained when the connection was made, so a request costs a single
+ *  round trip. The session re-authenticates and retries once if the token is rejected, and
+ *  reconnects if the remote end closed the connection. All requests are sent in order by the
+ *  session worker thread; send() blocks only until its response arrives (or times out), while
+ *  sendAsync() returns immediately and reports the result to a callback.
+ *
+ *  Sessions are shared per endpoint configuration (address, port, password, SSL and debug) and
+ *  live until closeAll() is called. Requests are made through RESTClient, which looks up the
+ *  shared session; RESTSession is not used directly. A completion callback runs on the session
+ *  worker thread, and must not call send() or close() on the same session.
+ * @ingroup remote_rest
+ */
+class HOST_SW_API RESTSession {
+public:
+    /**
+     * @brief Callback invoked when an asynchronous request completes.
+     */
+    typedef RESTClient::ResponseHandler CompletionHandler;
+
+    /**
+     * @brief Initializes a new instance of the RESTSession class.
+     * @param address Network Hostname/IP address to connect to.
+     * @param port Network port number.
+     * @param password Authentication password.
+     * @param enableSSL Flag indicating whether or not HTTPS is enabled.
+     * @param debug Flag indicating whether debug is enabled.
+     */
+    RESTSession(const std::string& address, uint32_t port, const std::string& password, bool enableSSL, bool debug = false);
+    /**
+     * @brief Finalizes a instance of the RESTSession class.
+     */
+    ~RESTSession();
+
+    /**
+     * @brief Sends a request and waits for the response.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param timeout REST response wait timeout (ms).
+     * @returns int REST API status, or RESTClient error number.
+     */
+    int send(const std::string method, const std::string endpoint, json::object payload, int timeout = REST_DEFAULT_WAIT);
+    /**
+     * @brief Sends a request and waits for the response.
+     *  The timeout covers the whole request; if it passes before the request was sent, the request is dropped.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param response REST API endpoint response.
+     * @param timeout REST response wait timeout (ms).
+     * @returns int REST API status, or RESTClient error number.
+     */
+    int send(const std::string method, const std::string endpoint, json::object payload, json::object& response,
+        int timeout = REST_DEFAULT_WAIT);
+    /**
+     * @brief Queues a request to be sent by the session worker thread.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param handler Callback invoked (on the worker thread) with the result, may be empty. The callback
+     *  must not call send() or close() on the same session.
+     * @param timeout REST response wait timeout (ms).
+     * @returns bool True, if the request was queued, otherwise false.
+     */
+    bool sendAsync(const std::string method, const std::string endpoint, json::object payload,
+        CompletionHandler handler = nullptr, int timeout = REST_DEFAULT_WAIT);
+
+    /**
+     * @brief Waits for queued requests, stops the worker thread and closes the connection.
+     */
+    void close();
+
+    /**
+     * @brief Gets the request statistics of this session.
+     * @returns RESTSessionStats Request statistics.
+     */
+    RESTSessionStats getStats();
+
+    /**
+     * @brief Gets the combined request statistics of the shared sessions for the given endpoint.
+     * @param address Network Hostname/IP address.
+     * @param port Network port number.
+     * @param[out] stats Request statistics.
+     * @returns bool True, if any session exists for the endpoint, otherwise false.
+     */
+    static bool getStats(const std::string& address, uint32_t port, RESTSessionStats& stats);
+    /**
+     * @brief Closes and releases all shared sessions.
+     */
+    static void closeAll();
+
+private:
+    friend class RESTClient;
+
+    typedef network::rest::http::HTTPPayload HTTPPayload;
+    typedef network::rest::BasicRequestDispatcher<HTTPPayload, HTTPPayload> RESTDispatcherType;
+    typedef network::rest::http::HTTPClient<RESTDispatcherType, network::rest::http::ClientConnection> ClientType;
+#if defined(ENABLE_TCP_SSL)
+    typedef network::rest::http::SecureHTTPClient<RESTDispatcherType, network::rest::http::SecureClientConnection> SecureClientType;
+#endif // ENABLE_TCP_SSL
+
+    std::string m_address;
+    uint32_t m_port;
+    std::string m_password;
+    bool m_enableSSL;
+    bool m_debug;
+
+    ClientType* m_client;
+#if defined(ENABLE_TCP_SSL)
+    SecureClientType* m_sslClient;
+#endif // ENABLE_TCP_SSL
+    std::string m_token;
+
+    std::mutex m_requestLock;
+
+    std::mutex m_responseLock;
+    std::condition_variable m_responseCond;
+    bool m_responseAvailable;
+    HTTPPayload m_response;
+
+    /**
+     * @brief Represents a request queued for the worker thread.
+     */
+    struct Request {
+        std::string method;                 //! REST API method.
+        std::string endpoint;               //! REST API endpoint.
+        json::object payload;               //! REST API endpoint payload.
+        CompletionHandler handler;          //! Completion callback.
+        int timeout;                        //! REST response wait timeout (ms).
+        bool expires;                       //! Flag indicating the request is abandoned once its deadline passes.
+        std::chrono::steady_clock::time_point deadline; //! Time by which the request must have completed.
+    };
+
+    std::mutex m_queueLock;
+    std::condition_variable m_queueCond;
+    std::deque<Request> m_queue;
+    bool m_started;
+    bool m_running;
+    bool m_stopped;
+    std::thread::id m_workerId;
+
+    std::mutex m_statsLock;
+    RESTSessionStats m_stats;
+    uint64_t m_totalRtt;
+
+    // address, port, password, SSL, debug
+    typedef std::tuple<std::string, uint32_t, std::string, bool, bool> SessionKey;
+
+    static std::mutex m_sessionsLock;
+    static std::map<SessionKey, RESTSession*> m_sessions;
+
+    /**
+     * @brief Gets the shared session for the given endpoint configuration, creating it if necessary.
+     * @param address Network Hostname/IP address to connect to.
+     * @param port Network port number.
+     * @param password Authentication password.
+     * @param enableSSL Flag indicating whether or not HTTPS is enabled.
+     * @param debug Flag indicating whether debug is enabled.
+     * @returns RESTSession* Shared session for the endpoint configuration.
+     */
+    static RESTSession* get(const std::string& address, uint32_t port, const std::string& password, bool enableSSL, bool debug = false);
+
+    /**
+     * @brief Helper to determine whether the caller is the session worker thread.
+     * @returns bool True, if called from the session worker thread, otherwise false.
+     */
+    bool isWorkerThread();
+
+    /**
+     * @brief Helper to queue a request for the worker thread.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param handler Completion callback.
+     * @param timeout REST response wait timeout (ms).
+     * @param expires Flag indicating the request is abandoned if it cannot complete within the timeout.
+     * @returns bool True, if the request was queued, otherwise false.
+     */
+    bool enqueue(const std::string& method, const std::string& endpoint, json::object& payload, CompletionHandler handler,
+        int timeout, bool expires);
+
+    /**
+     * @brief Helper to send a request on the connection, connecting and authenticating as necessary.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param response REST API endpoint response.
+     * @param timeout REST response wait timeout (ms).
+     * @returns int REST API status, or RESTClient error number.
+     */
+    int execute(const std::string& method, const std::string& endpoint, json::object& payload, json::object& response, int timeout);
+    /**
+     * @brief Helper to send a single request on the connection and wait for its response.
+     * @param method REST API method.
+     * @param endpoint REST API endpoint.
+     * @param payload REST API endpoint payload.
+     * @param response REST API endpoint response.
+     * @param timeout REST response wait timeout (ms).
+     * @param useToken Flag indicating whether the cached token is attached to the request.
+     * @returns int REST API status, or RESTClient error number.
+     */
+    int request(const std::string& method, const std::string& endpoint, json::object& payload, json::object& response,
+        int timeout, bool useToken);
+
+    /**
+     * @brief Helper to open the connection and authenticate.
+     * @param timeout REST response wait timeout (ms).
+     * @returns int REST API status, or RESTClient error number.
+     */
+    int connect(int timeout);
+    /**
+     * @brief Helper to close the connection and discard the cached token.
+     */
+    void disconnect();
+    /**
+     * @brief Helper to determine whether the connection is open.
+     * @returns bool True, if the connection is open, otherwise false.
+     */
+    bool isConnected();
+
+    /**
+     * @brief HTTP response handler.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     */
+    void responseHandler(const HTTPPayload& request, HTTPPayload& reply);
+
+    /**
+     * @brief Helper to record the outcome of a request.
+     * @param rtt Round trip time (us).
+     * @param failed Flag indicating the request failed.
+     */
+    void updateStats(uint64_t rtt, bool failed);
+
+    /**
+     * @brief Entry point to the worker thread.
+     * @param arg Instance of the thread_t structure.
+     * @returns void* (Ignore)
+     */
+    static void* threadWorker(void* arg);
+};
+
+#endif // __REST_SESSION_H__
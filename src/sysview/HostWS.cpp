@@ -326,7 +326,7 @@ int HostWS::run()
                 json::object rsp = json::object();
             
                 int ret = RESTClient::send(fneRESTAddress, fneRESTPort, fnePassword,
-                    HTTP_GET, FNE_GET_PEER_QUERY, req, rsp, fneSSL, g_debug);
+                    HTTP_GET, FNE_GET_PEER_QUERY, req, rsp, fneSSL, REST_DEFAULT_WAIT, g_debug);
                 if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
                     ::LogError(LOG_HOST, "[AFFVIEW] failed to query peers for %s:%u", fneRESTAddress.c_str(), fneRESTPort);
                 }
@@ -353,7 +353,7 @@ int HostWS::run()
                 json::object rsp = json::object();
             
                 int ret = RESTClient::send(fneRESTAddress, fneRESTPort, fnePassword,
-                    HTTP_GET, FNE_GET_AFF_LIST, req, rsp, fneSSL, g_debug);
+                    HTTP_GET, FNE_GET_AFF_LIST, req, rsp, fneSSL, REST_DEFAULT_WAIT, g_debug);
                 if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
                     ::LogError(LOG_HOST, "[AFFVIEW] failed to query peers for %s:%u", fneRESTAddress.c_str(), fneRESTPort);
                 }
@@ -21,6 +21,7 @@
 #define __PEER_NETWORK_H__
 
 #include "Defines.h"
+#include "common/network/PeerLinkTransfer.h"
 #include "host/network/Network.h"
 
 #include <string>
@@ -98,15 +99,25 @@ namespace network
         static std::mutex m_peerStatusMutex;
         bool m_peerLink;
 
-        uint32_t m_tgidCompressedSize;
-        uint32_t m_tgidSize;
+        PeerLinkReceiver m_tgidXfer;
+        PeerLinkReceiver m_ridXfer;
 
-        uint8_t* m_tgidBuffer;
-
-        uint32_t m_ridCompressedSize;
-        uint32_t m_ridSize;
-
-        uint8_t* m_ridBuffer;
+        /**
+         * @brief Helper to process a Peer-Link transfer block and acknowledge it to the master.
+         * @param peerId Peer ID.
+         * @param xfer Peer-Link transfer receiver.
+         * @param[in] data Buffer containing the block.
+         * @param length Length of buffer.
+         * @returns PeerLinkReceiver::Status Result of processing the block.
+         */
+        PeerLinkReceiver::Status processPeerLinkBlock(uint32_t peerId, PeerLinkReceiver& xfer, const uint8_t* data, uint32_t length);
+        /**
+         * @brief Helper to write the data of a completed Peer-Link transfer to a temporary file.
+         * @param data Uncompressed data.
+         * @param prefix Temporary filename prefix.
+         * @returns std::string Filename, or an empty string if the file could not be written.
+         */
+        std::string writePeerLinkFile(const std::vector<uint8_t>& data, const std::string& prefix);
     };
 } // namespace network
 
@@ -35,6 +35,31 @@
 #pragma warning(disable: 4244)
 #endif
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define MBE_OSC_BANK_SIZE 64
+#define MBE_OSC_LANES 8
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/*
+** Bank of recursive (complex rotator) oscillators. Each oscillator is stored as the
+** (amplitude scaled) real/imaginary parts of its current phasor along with the cosine/sine
+** of its per-sample phase increment, in structure-of-arrays form so the per-sample update
+** maps directly onto SIMD lanes.
+*/
+typedef struct {
+    float c[MBE_OSC_BANK_SIZE];
+    float s[MBE_OSC_BANK_SIZE];
+    float cw[MBE_OSC_BANK_SIZE];
+    float sw[MBE_OSC_BANK_SIZE];
+    int count;
+} mbe_oscBank;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -211,21 +236,113 @@ void mbe_synthesizeSilence(short* aout_buf)
     }
 }
 
+/* Helper to render a bank of oscillators into the output buffer, shaped by the given window. */
+
+static void mbe_renderOscBank(float* aout_buf, const float* window, mbe_oscBank* bank)
+{
+    int n, k, j, count;
+    float c, s, acc;
+    float part[MBE_OSC_LANES];
+
+    if (bank->count == 0)
+        return;
+
+    // pad the bank out to a whole number of lanes with silent oscillators
+    count = (bank->count + (MBE_OSC_LANES - 1)) & ~(MBE_OSC_LANES - 1);
+    for (k = bank->count; k < count; k++) {
+        bank->c[k] = 0.0F;
+        bank->s[k] = 0.0F;
+        bank->cw[k] = 1.0F;
+        bank->sw[k] = 0.0F;
+    }
+
+    for (n = 0; n < 160; n++) {
+        // sum the oscillators using independent partial sums per lane (this keeps the reduction
+        // in a form the compiler can vectorize without relaxing floating point semantics)
+        for (j = 0; j < MBE_OSC_LANES; j++) {
+            part[j] = 0.0F;
+        }
+
+        for (k = 0; k < count; k += MBE_OSC_LANES) {
+            for (j = 0; j < MBE_OSC_LANES; j++) {
+                part[j] += bank->c[k + j];
+            }
+        }
+
+        acc = 0.0F;
+        for (j = 0; j < MBE_OSC_LANES; j++) {
+            acc += part[j];
+        }
+
+        aout_buf[n] += window[n] * acc;
+
+        // advance every oscillator by one sample; (c + js) * (cw + jsw)
+        for (k = 0; k < count; k++) {
+            c = bank->c[k];
+            s = bank->s[k];
+            bank->c[k] = (c * bank->cw[k]) - (s * bank->sw[k]);
+            bank->s[k] = (s * bank->cw[k]) + (c * bank->sw[k]);
+        }
+    }
+
+    bank->count = 0;
+}
+
+/* Helper to add an oscillator (amp * cos(w * n + phase)) to a bank, rendering the bank if it is full. */
+
+static void mbe_addOsc(float* aout_buf, const float* window, mbe_oscBank* bank, float amp, float w, float phase)
+{
+    int k;
+
+    if (amp == 0.0F)
+        return;
+
+    k = bank->count;
+    bank->c[k] = amp * cosf(phase);
+    bank->s[k] = amp * sinf(phase);
+    bank->cw[k] = cosf(w);
+    bank->sw[k] = sinf(w);
+
+    bank->count++;
+    if (bank->count == MBE_OSC_BANK_SIZE) {
+        mbe_renderOscBank(aout_buf, window, bank);
+    }
+}
+
+/* Helper to accumulate the random noise component of an unvoiced multisine mix. */
+
+static void mbe_addUvNoise(float* noise, int n, int uvquality, float scale)
+{
+    int i;
+    float C = 0.0F;
+
+    for (i = 0; i < uvquality; i++) {
+        C = C + mbe_rand();
+    }
+
+    noise[n] += C * scale;
+}
+
 /* */
 
 void mbe_synthesizeSpeechF(float* aout_buf, mbe_parms* cur_mp, mbe_parms* prev_mp, int uvquality)
 {
 
     int i, l, n, maxl;
-    float* Ss, loguvquality;
-    float C1, C2, C3, C4;
-    //float deltaphil, deltawl, thetaln, aln;
+    float loguvquality;
     int numUv;
     float cw0, pw0, cw0l, pw0l;
     float uvsine, uvrand, uvthreshold, uvthresholdf;
     float uvstep, uvoffset;
     float qfactor;
     float rphase[64], rphase2[64];
+    float uvP, uvC, noiseScaleP, noiseScaleC;
+    int noiseP, noiseC;
+
+    // harmonics are synthesized as recursive oscillators; the "previous" bank is shaped by
+    // the trailing half of the synthesis window and the "current" bank by the leading half
+    mbe_oscBank prevBank, curBank;
+    float prevNoise[160], curNoise[160];
 
     const int N = 160;
 
@@ -266,12 +383,15 @@ void mbe_synthesizeSpeechF(float* aout_buf, mbe_parms* cur_mp, mbe_parms* prev_m
     pw0 = prev_mp->w0;
 
     // init aout_buf
-    Ss = aout_buf;
     for (n = 0; n < N; n++) {
-        *Ss = (float)0;
-        Ss++;
+        aout_buf[n] = (float)0;
+        prevNoise[n] = (float)0;
+        curNoise[n] = (float)0;
     }
 
+    prevBank.count = 0;
+    curBank.count = 0;
+
     // eq 128 and 129
     if (cur_mp->L > prev_mp->L) {
         maxl = cur_mp->L;
@@ -299,98 +419,67 @@ void mbe_synthesizeSpeechF(float* aout_buf, mbe_parms* cur_mp, mbe_parms* prev_m
         }
     }
 
+    /*
+    ** NOTE: The random number generator is consumed in exactly the same order as the direct
+    ** form of the synthesizer (random phases per band, then noise per sample per band), so for
+    ** a given seed the output only differs by floating point rounding.
+    */
     for (l = 1; l <= maxl; l++) {
         cw0l = (cw0 * (float)l);
         pw0l = (pw0 * (float)l);
+
+        uvP = uvsine * prev_mp->Ml[l] * qfactor;
+        uvC = uvsine * cur_mp->Ml[l] * qfactor;
+
         if ((cur_mp->Vl[l] == 0) && (prev_mp->Vl[l] == 1)) {
-            Ss = aout_buf;
             // init random phase
             for (i = 0; i < uvquality; i++) {
                 rphase[i] = mbe_rand_phase();
             }
 
-            for (n = 0; n < N; n++) {
-                C1 = 0;
-                // eq 131
-                C1 = Ws[n + N] * prev_mp->Ml[l] * cosf((pw0l * (float)n) + prev_mp->PHIl[l]);
-                C3 = 0;
-
-                // unvoiced multisine mix
-                for (i = 0; i < uvquality; i++)
-                {
-                    C3 = C3 + cosf((cw0 * (float)n * ((float)l + ((float)i * uvstep) - uvoffset)) + rphase[i]);
-                    if (cw0l > uvthreshold)
-                    {
-                        C3 = C3 + ((cw0l - uvthreshold) * uvrand * mbe_rand());
-                    }
+            // eq 131
+            mbe_addOsc(aout_buf, Ws + N, &prevBank, prev_mp->Ml[l], pw0l, prev_mp->PHIl[l]);
+
+            // unvoiced multisine mix
+            for (i = 0; i < uvquality; i++) {
+                mbe_addOsc(aout_buf, Ws, &curBank, uvC, cw0 * ((float)l + ((float)i * uvstep) - uvoffset), rphase[i]);
+            }
+
+            if (cw0l > uvthreshold) {
+                noiseScaleC = (cw0l - uvthreshold) * uvrand * uvC;
+                for (n = 0; n < N; n++) {
+                    mbe_addUvNoise(curNoise, n, uvquality, noiseScaleC);
                 }
-                C3 = C3 * uvsine * Ws[n] * cur_mp->Ml[l] * qfactor;
-                *Ss = *Ss + C1 + C3;
-                Ss++;
             }
         }
         else if ((cur_mp->Vl[l] == 1) && (prev_mp->Vl[l] == 0)) {
-            Ss = aout_buf;
             // init random phase
             for (i = 0; i < uvquality; i++) {
                 rphase[i] = mbe_rand_phase();
             }
-            
-            for (n = 0; n < N; n++) {
-                C1 = 0;
-                // eq 132
-                C1 = Ws[n] * cur_mp->Ml[l] * cosf((cw0l * (float)(n - N)) + cur_mp->PHIl[l]);
-                C3 = 0;
-
-                // unvoiced multisine mix
-                for (i = 0; i < uvquality; i++) {
-                    C3 = C3 + cosf((pw0 * (float)n * ((float)l + ((float)i * uvstep) - uvoffset)) + rphase[i]);
-                    if (pw0l > uvthreshold) {
-                        C3 = C3 + ((pw0l - uvthreshold) * uvrand * mbe_rand());
-                    }
-                }
-                C3 = C3 * uvsine * Ws[n + N] * prev_mp->Ml[l] * qfactor;
-                *Ss = *Ss + C1 + C3;
-                Ss++;
+
+            // eq 132
+            mbe_addOsc(aout_buf, Ws, &curBank, cur_mp->Ml[l], cw0l, (cw0l * (float)(-N)) + cur_mp->PHIl[l]);
+
+            // unvoiced multisine mix
+            for (i = 0; i < uvquality; i++) {
+                mbe_addOsc(aout_buf, Ws + N, &prevBank, uvP, pw0 * ((float)l + ((float)i * uvstep) - uvoffset), rphase[i]);
             }
-        }
-        //      else if (((cur_mp->Vl[l] == 1) || (prev_mp->Vl[l] == 1)) && ((l >= 8) || (fabsf (cw0 - pw0) >= ((float) 0.1 * cw0))))
-        else if ((cur_mp->Vl[l] == 1) || (prev_mp->Vl[l] == 1)) {
-            Ss = aout_buf;
-            for (n = 0; n < N; n++) {
-                C1 = 0;
-                // eq 133-1
-                C1 = Ws[n + N] * prev_mp->Ml[l] * cosf((pw0l * (float)n) + prev_mp->PHIl[l]);
-                C2 = 0;
-                // eq 133-2
-                C2 = Ws[n] * cur_mp->Ml[l] * cosf((cw0l * (float)(n - N)) + cur_mp->PHIl[l]);
-                *Ss = *Ss + C1 + C2;
-                Ss++;
+
+            if (pw0l > uvthreshold) {
+                noiseScaleP = (pw0l - uvthreshold) * uvrand * uvP;
+                for (n = 0; n < N; n++) {
+                    mbe_addUvNoise(prevNoise, n, uvquality, noiseScaleP);
+                }
             }
         }
-/*
-        // expensive and unnecessary?
         else if ((cur_mp->Vl[l] == 1) || (prev_mp->Vl[l] == 1)) {
-            Ss = aout_buf;
-            // eq 137
-            deltaphil = cur_mp->PHIl[l] - prev_mp->PHIl[l] - (((pw0 + cw0) * (float) (l * N)) / (float) 2);
-            // eq 138
-            deltawl = ((float) 1 / (float) N) * (deltaphil - ((float) 2 * M_PI * (int) ((deltaphil + M_PI) / (M_PI * (float) 2))));
-                  
-            for (n = 0; n < N; n++) {
-                // eq 136
-                thetaln = prev_mp->PHIl[l] + ((pw0l + deltawl) * (float) n) + (((cw0 - pw0) * ((float) (l * n * n)) / (float) (2 * N)));
-                // eq 135
-                aln = prev_mp->Ml[l] + (((float) n / (float) N) * (cur_mp->Ml[l] - prev_mp->Ml[l]));
-                // eq 134
-                *Ss = *Ss + (aln * cosf (thetaln));
-                Ss++;
-            }
+            // eq 133-1
+            mbe_addOsc(aout_buf, Ws + N, &prevBank, prev_mp->Ml[l], pw0l, prev_mp->PHIl[l]);
+            // eq 133-2
+            mbe_addOsc(aout_buf, Ws, &curBank, cur_mp->Ml[l], cw0l, (cw0l * (float)(-N)) + cur_mp->PHIl[l]);
         }
-*/
-        else
-        {
-            Ss = aout_buf;
+        else {
             // init random phase
             for (i = 0; i < uvquality; i++) {
                 rphase[i] = mbe_rand_phase();
@@ -401,34 +490,35 @@ void mbe_synthesizeSpeechF(float* aout_buf, mbe_parms* cur_mp, mbe_parms* prev_m
                 rphase2[i] = mbe_rand_phase();
             }
 
-            for (n = 0; n < N; n++) {
-                C3 = 0;
+            // unvoiced multisine mix
+            for (i = 0; i < uvquality; i++) {
+                mbe_addOsc(aout_buf, Ws + N, &prevBank, uvP, pw0 * ((float)l + ((float)i * uvstep) - uvoffset), rphase[i]);
+                mbe_addOsc(aout_buf, Ws, &curBank, uvC, cw0 * ((float)l + ((float)i * uvstep) - uvoffset), rphase2[i]);
+            }
 
-                // unvoiced multisine mix
-                for (i = 0; i < uvquality; i++) {
-                    C3 = C3 + cosf((pw0 * (float)n * ((float)l + ((float)i * uvstep) - uvoffset)) + rphase[i]);
-                    if (pw0l > uvthreshold) {
-                        C3 = C3 + ((pw0l - uvthreshold) * uvrand * mbe_rand());
+            noiseP = (pw0l > uvthreshold);
+            noiseC = (cw0l > uvthreshold);
+            noiseScaleP = (pw0l - uvthreshold) * uvrand * uvP;
+            noiseScaleC = (cw0l - uvthreshold) * uvrand * uvC;
+            if (noiseP || noiseC) {
+                for (n = 0; n < N; n++) {
+                    if (noiseP) {
+                        mbe_addUvNoise(prevNoise, n, uvquality, noiseScaleP);
                     }
-                }
-
-                C3 = C3 * uvsine * Ws[n + N] * prev_mp->Ml[l] * qfactor;
-                C4 = 0;
-                
-                // unvoiced multisine mix
-                for (i = 0; i < uvquality; i++) {
-                    C4 = C4 + cosf((cw0 * (float)n * ((float)l + ((float)i * uvstep) - uvoffset)) + rphase2[i]);
-                    if (cw0l > uvthreshold) {
-                        C4 = C4 + ((cw0l - uvthreshold) * uvrand * mbe_rand());
+                    if (noiseC) {
+                        mbe_addUvNoise(curNoise, n, uvquality, noiseScaleC);
                     }
                 }
-
-                C4 = C4 * uvsine * Ws[n] * cur_mp->Ml[l] * qfactor;
-                *Ss = *Ss + C3 + C4;
-                Ss++;
             }
         }
     }
+
+    mbe_renderOscBank(aout_buf, Ws + N, &prevBank);
+    mbe_renderOscBank(aout_buf, Ws, &curBank);
+
+    for (n = 0; n < N; n++) {
+        aout_buf[n] += (Ws[n + N] * prevNoise[n]) + (Ws[n] * curNoise[n]);
+    }
 }
 
 /* */
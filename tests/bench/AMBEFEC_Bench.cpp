@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/AMBEFEC.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <stdlib.h>
+
+// each benchmark iteration regenerates one voice frame; frames/s = 1s / mean iteration time
+
+TEST_CASE("AMBEFEC", "[benchmark][AMBE FEC]") {
+    AMBEFEC fec = AMBEFEC();
+
+    // a DMR voice burst carries 3 AMBE frames, an NXDN frame 4, a P25 LDU 9 IMBE frames
+    uint8_t dmr[33U], imbe[18U], nxdn[9U];
+    for (size_t i = 0; i < sizeof(dmr); i++)
+        dmr[i] = rand();
+    for (size_t i = 0; i < sizeof(imbe); i++)
+        imbe[i] = rand();
+    for (size_t i = 0; i < sizeof(nxdn); i++)
+        nxdn[i] = rand();
+
+    BENCHMARK("DMR regenerateDMR (3 frames)") {
+        dmr[0U] ^= 0x01U;
+        return fec.regenerateDMR(dmr);
+    };
+
+    BENCHMARK("DMR measureDMRBER (3 frames)") {
+        dmr[0U] ^= 0x01U;
+        return fec.measureDMRBER(dmr);
+    };
+
+    BENCHMARK("P25 regenerateIMBE") {
+        imbe[0U] ^= 0x01U;
+        return fec.regenerateIMBE(imbe);
+    };
+
+    BENCHMARK("P25 measureP25BER") {
+        imbe[0U] ^= 0x01U;
+        return fec.measureP25BER(imbe);
+    };
+
+    BENCHMARK("NXDN regenerateNXDN") {
+        nxdn[0U] ^= 0x01U;
+        return fec.regenerateNXDN(nxdn);
+    };
+
+    BENCHMARK("NXDN measureNXDNBER") {
+        nxdn[0U] ^= 0x01U;
+        return fec.measureNXDNBER(nxdn);
+    };
+}
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a Catch2 reporter that writes benchmark results as JSON.
+ *
+ *  The output follows the layout of Google Benchmark's JSON output (a "context" object and a
+ *  "benchmarks" array, times in nanoseconds), so results can be archived per release and compared
+ *  with the usual tooling. Run with: dvmbench -r benchmark-json -o results.json
+ */
+class BenchmarkJSONReporter : public Catch::StreamingReporterBase {
+public:
+    using StreamingReporterBase::StreamingReporterBase;
+
+    /**
+     * @brief Gets the reporter description.
+     * @returns std::string Reporter description.
+     */
+    static std::string getDescription()
+    {
+        return "Reports benchmark results as JSON, in the Google Benchmark layout";
+    }
+
+    /**
+     * @brief Called when a test case starts.
+     * @param testInfo Test case information.
+     */
+    void testCaseStarting(Catch::TestCaseInfo const& testInfo) override
+    {
+        StreamingReporterBase::testCaseStarting(testInfo);
+        m_testCase = testInfo.name;
+    }
+
+    /**
+     * @brief Called when a benchmark has completed.
+     * @param stats Benchmark statistics.
+     */
+    void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override
+    {
+        using ns = std::chrono::duration<double, std::nano>;
+
+        Result result;
+        result.name = m_testCase + "/" + stats.info.name;
+        result.iterations = (uint64_t)stats.info.iterations;
+        result.samples = (uint32_t)stats.info.samples;
+        result.mean = std::chrono::duration_cast<ns>(stats.mean.point).count();
+        result.low = std::chrono::duration_cast<ns>(stats.mean.lower_bound).count();
+        result.high = std::chrono::duration_cast<ns>(stats.mean.upper_bound).count();
+        result.stddev = std::chrono::duration_cast<ns>(stats.standardDeviation.point).count();
+        result.outlierVariance = stats.outlierVariance;
+        m_results.push_back(result);
+    }
+
+    /**
+     * @brief Called when the test run has completed.
+     * @param testRunStats Test run statistics.
+     */
+    void testRunEnded(Catch::TestRunStats const& testRunStats) override
+    {
+        StreamingReporterBase::testRunEnded(testRunStats);
+
+        char date[32U];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+        m_stream << "{\n";
+        m_stream << "  \"context\": {\n";
+        m_stream << "    \"date\": \"" << date << "\",\n";
+        m_stream << "    \"executable\": \"dvmbench\",\n";
+        m_stream << "    \"version\": \"" << escape(__VER__) << "\",\n";
+        m_stream << "    \"build\": \"" << escape(__BUILD__) << "\"\n";
+        m_stream << "  },\n";
+        m_stream << "  \"benchmarks\": [";
+
+        for (size_t i = 0U; i < m_results.size(); i++) {
+            const Result& result = m_results[i];
+
+            char values[512U];
+            ::snprintf(values, sizeof(values),
+                "      \"iterations\": %llu,\n"
+                "      \"samples\": %u,\n"
+                "      \"real_time\": %.3f,\n"
+                "      \"real_time_low\": %.3f,\n"
+                "      \"real_time_high\": %.3f,\n"
+                "      \"stddev\": %.3f,\n"
+                "      \"outlier_variance\": %.4f,\n"
+                "      \"items_per_second\": %.1f,\n"
+                "      \"time_unit\": \"ns\"\n",
+                (unsigned long long)result.iterations, result.samples, result.mean, result.low, result.high,
+                result.stddev, result.outlierVariance, (result.mean > 0.0) ? 1e9 / result.mean : 0.0);
+
+            m_stream << ((i == 0U) ? "\n" : ",\n");
+            m_stream << "    {\n";
+            m_stream << "      \"name\": \"" << escape(result.name) << "\",\n";
+            m_stream << "      \"run_name\": \"" << escape(result.name) << "\",\n";
+            m_stream << "      \"run_type\": \"iteration\",\n";
+            m_stream << values;
+            m_stream << "    }";
+        }
+
+        m_stream << "\n  ]\n}\n";
+        m_stream.flush();
+    }
+
+private:
+    /**
+     * @brief Represents the result of a single benchmark.
+     */
+    struct Result {
+        std::string name;                   //! Test case and benchmark name.
+        uint64_t iterations;                //! Iterations per sample.
+        uint32_t samples;                   //! Number of samples.
+        double mean;                        //! Mean time per iteration (ns).
+        double low;                         //! Lower bound of the mean (ns).
+        double high;                        //! Upper bound of the mean (ns).
+        double stddev;                      //! Standard deviation (ns).
+        double outlierVariance;             //! Variance introduced by outliers.
+    };
+
+    std::string m_testCase;
+    std::vector<Result> m_results;
+
+    /**
+     * @brief Helper to escape a string for JSON.
+     * @param str String to escape.
+     * @returns std::string Escaped string.
+     */
+    static std::string escape(const std::string& str)
+    {
+        std::string out;
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            }
+            else if ((unsigned char)c < 0x20U) {
+                char hex[8U];
+                ::snprintf(hex, sizeof(hex), "\\u%04x", (unsigned char)c);
+                out += hex;
+            }
+            else {
+                out += c;
+            }
+        }
+
+        return out;
+    }
+};
+
+CATCH_REGISTER_REPORTER("benchmark-json", BenchmarkJSONReporter)
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/AESCrypto.h"
+#include "common/RC4Crypto.h"
+#include "common/edac/SHA256.h"
+
+using namespace crypto;
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <stdlib.h>
+
+// buffers are sized as a typical encrypted FNE datagram (a P25 LDU with RTP and FNE headers)
+
+TEST_CASE("AES", "[benchmark][AES]") {
+    AES aes = AES(AESKeyLength::AES_256);
+
+    uint8_t key[32U], iv[16U], in[256U];
+    for (size_t i = 0; i < sizeof(key); i++)
+        key[i] = rand();
+    for (size_t i = 0; i < sizeof(iv); i++)
+        iv[i] = rand();
+    for (size_t i = 0; i < sizeof(in); i++)
+        in[i] = rand();
+
+    BENCHMARK("AES-256 encryptECB (256 bytes)") {
+        in[0U] ^= 0x01U;
+        uint8_t* out = aes.encryptECB(in, sizeof(in), key);
+        uint8_t ret = out[0U];
+        delete[] out;
+        return ret;
+    };
+
+    BENCHMARK("AES-256 decryptECB (256 bytes)") {
+        in[0U] ^= 0x01U;
+        uint8_t* out = aes.decryptECB(in, sizeof(in), key);
+        uint8_t ret = out[0U];
+        delete[] out;
+        return ret;
+    };
+
+    BENCHMARK("AES-256 encryptCBC (256 bytes)") {
+        in[0U] ^= 0x01U;
+        uint8_t* out = aes.encryptCBC(in, sizeof(in), key, iv);
+        uint8_t ret = out[0U];
+        delete[] out;
+        return ret;
+    };
+
+    BENCHMARK("AES-256 decryptCBC (256 bytes)") {
+        in[0U] ^= 0x01U;
+        uint8_t* out = aes.decryptCBC(in, sizeof(in), key, iv);
+        uint8_t ret = out[0U];
+        delete[] out;
+        return ret;
+    };
+}
+
+TEST_CASE("RC4", "[benchmark][RC4]") {
+    RC4 rc4 = RC4();
+
+    uint8_t key[13U], in[256U];
+    for (size_t i = 0; i < sizeof(key); i++)
+        key[i] = rand();
+    for (size_t i = 0; i < sizeof(in); i++)
+        in[i] = rand();
+
+    BENCHMARK("crypt (256 bytes)") {
+        in[0U] ^= 0x01U;
+        uint8_t* out = rc4.crypt(in, sizeof(in), key, sizeof(key));
+        uint8_t ret = out[0U];
+        delete[] out;
+        return ret;
+    };
+}
+
+TEST_CASE("SHA256", "[benchmark][SHA256]") {
+    SHA256 sha = SHA256();
+
+    uint8_t in[256U], hash[32U];
+    for (size_t i = 0; i < sizeof(in); i++)
+        in[i] = rand();
+
+    BENCHMARK("buffer (256 bytes)") {
+        in[0U] ^= 0x01U;
+        sha.buffer(in, sizeof(in), hash);
+        return hash[0U];
+    };
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/dmr/lc/FullLC.h"
+
+using namespace dmr;
+using namespace dmr::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <string.h>
+
+TEST_CASE("DMR FullLC", "[benchmark][DMR FullLC]") {
+    lc::FullLC fullLC = lc::FullLC();
+    lc::LC lc = lc::LC(FLCO::GROUP, 1234567U, 1U);
+
+    uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    // voice LC headers are carried in a BPTC (196,96) burst with RS (12,9) FEC
+    BENCHMARK("encode VOICE_LC_HEADER") {
+        fullLC.encode(lc, data + 2U, DataType::VOICE_LC_HEADER);
+        return data[2U];
+    };
+
+    fullLC.encode(lc, data + 2U, DataType::VOICE_LC_HEADER);
+
+    BENCHMARK("decode VOICE_LC_HEADER") {
+        return fullLC.decode(data + 2U, DataType::VOICE_LC_HEADER) != nullptr;
+    };
+
+    BENCHMARK("encode TERMINATOR_WITH_LC") {
+        fullLC.encode(lc, data + 2U, DataType::TERMINATOR_WITH_LC);
+        return data[2U];
+    };
+
+    fullLC.encode(lc, data + 2U, DataType::TERMINATOR_WITH_LC);
+
+    BENCHMARK("decode TERMINATOR_WITH_LC") {
+        return fullLC.decode(data + 2U, DataType::TERMINATOR_WITH_LC) != nullptr;
+    };
+}
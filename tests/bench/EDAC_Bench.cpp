@@ -0,0 +1,327 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/BPTC19696.h"
+#include "common/edac/CRC.h"
+#include "common/edac/Golay24128.h"
+#include "common/edac/Hamming.h"
+#include "common/edac/QR1676.h"
+#include "common/edac/RS634717.h"
+#include "common/edac/Trellis.h"
+#include "edac/CRCReference.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+// decode benchmarks run against a valid codeword with a single flipped bit, so the error
+// correction path is exercised on every iteration
+
+TEST_CASE("BPTC19696", "[benchmark][BPTC19696]") {
+    BPTC19696 bptc = BPTC19696();
+
+    uint8_t payload[12U], frame[33U];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = rand();
+    ::memset(frame, 0x00U, sizeof(frame));
+    bptc.encode(payload, frame);
+
+    BENCHMARK("encode") {
+        payload[0U] ^= 0x01U;
+        bptc.encode(payload, frame);
+        return frame[0U];
+    };
+
+    bptc.encode(payload, frame);
+
+    BENCHMARK("decode (no errors)") {
+        bptc.decode(frame, payload);
+        return payload[0U];
+    };
+
+    frame[2U] ^= 0x10U;
+
+    BENCHMARK("decode") {
+        bptc.decode(frame, payload);
+        return payload[0U];
+    };
+
+    // add two more bit errors
+    frame[5U] ^= 0x01U;
+    frame[27U] ^= 0x40U;
+
+    BENCHMARK("decode (3 errors)") {
+        bptc.decode(frame, payload);
+        return payload[0U];
+    };
+
+    // one DMR data burst (encode + decode) per iteration; bursts/s = 1s / mean iteration time
+    BENCHMARK("encode/decode burst") {
+        payload[0U] ^= 0x01U;
+        bptc.encode(payload, frame);
+        bptc.decode(frame, payload);
+        return payload[0U];
+    };
+}
+
+TEST_CASE("Trellis", "[benchmark][Trellis]") {
+    Trellis trellis = Trellis();
+
+    uint8_t payload[18U], data[64U];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = rand();
+    ::memset(data, 0x00U, sizeof(data));
+
+    BENCHMARK("encode34") {
+        payload[0U] ^= 0x01U;
+        trellis.encode34(payload, data);
+        return data[0U];
+    };
+
+    trellis.encode34(payload, data);
+    data[4U] ^= 0x01U;
+
+    BENCHMARK("decode34") {
+        return trellis.decode34(data, payload);
+    };
+
+    BENCHMARK("encode12") {
+        payload[0U] ^= 0x01U;
+        trellis.encode12(payload, data);
+        return data[0U];
+    };
+
+    trellis.encode12(payload, data);
+    data[4U] ^= 0x01U;
+
+    BENCHMARK("decode12") {
+        return trellis.decode12(data, payload);
+    };
+}
+
+TEST_CASE("Golay24128", "[benchmark][Golay24128]") {
+    // the (23,12,7) and (24,12,8) encoders are table lookups, so each iteration runs through all
+    // 4096 data words; codewords/s = 4096 * 1s / mean iteration time
+    // (encode23127() returns the codeword left aligned in 24 bits, as the callers expect)
+    uint32_t code23127[4096U], code24128[4096U];
+    for (uint32_t i = 0U; i < 4096U; i++) {
+        code23127[i] = (Golay24128::encode23127(i) >> 1) ^ (1U << (i % 23U));
+        code24128[i] = Golay24128::encode24128(i) ^ (1U << (i % 24U));
+    }
+
+    BENCHMARK("encode23127 (4096 words)") {
+        uint32_t ret = 0U;
+        for (uint32_t i = 0U; i < 4096U; i++)
+            ret ^= Golay24128::encode23127(i);
+        return ret;
+    };
+
+    BENCHMARK("encode24128 (4096 words)") {
+        uint32_t ret = 0U;
+        for (uint32_t i = 0U; i < 4096U; i++)
+            ret ^= Golay24128::encode24128(i);
+        return ret;
+    };
+
+    BENCHMARK("decode23127 (4096 words)") {
+        uint32_t ret = 0U;
+        for (uint32_t i = 0U; i < 4096U; i++)
+            ret ^= Golay24128::decode23127(code23127[i]);
+        return ret;
+    };
+
+    BENCHMARK("decode24128 (4096 words)") {
+        uint32_t ret = 0U;
+        for (uint32_t i = 0U; i < 4096U; i++) {
+            uint32_t out = 0U;
+            Golay24128::decode24128(code24128[i], out);
+            ret ^= out;
+        }
+        return ret;
+    };
+}
+
+TEST_CASE("RS634717", "[benchmark][RS634717]") {
+    RS634717 rs = RS634717();
+
+    uint8_t data[27U], code[27U];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = rand();
+
+    BENCHMARK("encode241213") {
+        data[0U] ^= 0x01U;
+        rs.encode241213(data);
+        return data[0U];
+    };
+
+    BENCHMARK("encode24169") {
+        data[0U] ^= 0x01U;
+        rs.encode24169(data);
+        return data[0U];
+    };
+
+    BENCHMARK("encode362017") {
+        data[0U] ^= 0x01U;
+        rs.encode362017(data);
+        return data[0U];
+    };
+
+    rs.encode241213(data);
+    data[1U] ^= 0x01U;
+
+    BENCHMARK("decode241213") {
+        ::memcpy(code, data, sizeof(code));
+        return rs.decode241213(code);
+    };
+
+    rs.encode24169(data);
+    data[1U] ^= 0x01U;
+
+    BENCHMARK("decode24169") {
+        ::memcpy(code, data, sizeof(code));
+        return rs.decode24169(code);
+    };
+
+    rs.encode362017(data);
+    data[1U] ^= 0x01U;
+
+    BENCHMARK("decode362017") {
+        ::memcpy(code, data, sizeof(code));
+        return rs.decode362017(code);
+    };
+}
+
+TEST_CASE("QR1676", "[benchmark][QR1676]") {
+    uint8_t data[2U] = { 0x5AU, 0x00U };
+
+    BENCHMARK("encode") {
+        data[0U] = (data[0U] + 2U) & 0xFEU;
+        QR1676::encode(data);
+        return data[1U];
+    };
+
+    data[0U] = 0x5AU;
+    QR1676::encode(data);
+    data[1U] ^= 0x04U;
+
+    BENCHMARK("decode") {
+        return QR1676::decode(data);
+    };
+}
+
+TEST_CASE("Hamming", "[benchmark][Hamming]") {
+    bool bits[17U];
+    for (size_t i = 0; i < sizeof(bits); i++)
+        bits[i] = (rand() & 0x01) == 0x01;
+
+    BENCHMARK("encode15113_2") {
+        bits[0U] = !bits[0U];
+        Hamming::encode15113_2(bits);
+        return bits[14U];
+    };
+
+    BENCHMARK("decode15113_2") {
+        bits[0U] = !bits[0U];
+        return Hamming::decode15113_2(bits);
+    };
+
+    BENCHMARK("encode16114") {
+        bits[0U] = !bits[0U];
+        Hamming::encode16114(bits);
+        return bits[15U];
+    };
+
+    BENCHMARK("decode16114") {
+        bits[0U] = !bits[0U];
+        return Hamming::decode16114(bits);
+    };
+
+    BENCHMARK("encode17123") {
+        bits[0U] = !bits[0U];
+        Hamming::encode17123(bits);
+        return bits[16U];
+    };
+
+    BENCHMARK("decode17123") {
+        bits[0U] = !bits[0U];
+        return Hamming::decode17123(bits);
+    };
+}
+
+TEST_CASE("CRC", "[benchmark][CRC]") {
+    // sized as a P25 PDU block (CRC-32 / CRC-CCITT) and NXDN FACCH1/UDCH (CRC-12/CRC-16)
+    uint8_t data[64U];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = rand();
+
+    BENCHMARK("addCCITT162 (12 bytes)") {
+        data[0U] ^= 0x01U;
+        CRC::addCCITT162(data, 12U);
+        return data[11U];
+    };
+
+    BENCHMARK("checkCCITT162 (12 bytes)") {
+        return CRC::checkCCITT162(data, 12U);
+    };
+
+    BENCHMARK("addCRC32 (64 bytes)") {
+        data[0U] ^= 0x01U;
+        CRC::addCRC32(data, sizeof(data));
+        return data[63U];
+    };
+
+    BENCHMARK("checkCRC32 (64 bytes)") {
+        return CRC::checkCRC32(data, sizeof(data));
+    };
+
+    BENCHMARK("crc8 (12 bytes)") {
+        data[0U] ^= 0x01U;
+        return CRC::crc8(data, 12U);
+    };
+
+    BENCHMARK("addCRC12 (80 bits)") {
+        data[0U] ^= 0x01U;
+        return CRC::addCRC12(data, 80U);
+    };
+
+    BENCHMARK("addCRC16 (80 bits)") {
+        data[0U] ^= 0x01U;
+        return CRC::addCRC16(data, 80U);
+    };
+
+    // table-driven vs. bit-at-a-time reference; sized as a DMR BPTC payload (CRC-16) and a
+    // full confirmed P25 PDU (CRC-32)
+    BENCHMARK("createCRC16 (196 bits)") {
+        data[0U] ^= 0x01U;
+        return CRC::createCRC16(data, 196U);
+    };
+
+    BENCHMARK("reference CRC16 (196 bits)") {
+        data[0U] ^= 0x01U;
+        return referenceCRC(data, 196U, 16U, 0x1021U, 0xFFFFU);
+    };
+
+    uint8_t pdu[512U];
+    for (size_t i = 0; i < sizeof(pdu); i++)
+        pdu[i] = rand();
+
+    BENCHMARK("createCRC32 (512 bytes)") {
+        pdu[0U] ^= 0x01U;
+        return CRC::createCRC32(pdu, sizeof(pdu));
+    };
+
+    BENCHMARK("reference CRC32 (512 bytes)") {
+        pdu[0U] ^= 0x01U;
+        return referenceCRC32(pdu, sizeof(pdu));
+    };
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "vocoder/MBEDecoder.h"
+#include "vocoder/mbe.h"
+
+using namespace vocoder;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+// each benchmark iteration synthesizes one 20ms (160 sample) frame; frames/s = 1s / mean iteration time
+
+/* Helper to generate a random set of model parameters; mode 0 is voiced, 1 unvoiced, 2 mixed. */
+
+static void randomParms(mbe_parms* mp, int mode)
+{
+    ::memset(mp, 0x00, sizeof(mbe_parms));
+
+    mp->L = 9 + (rand() % 48);
+    mp->w0 = (float)((2.0 * M_PI) / ((mp->L * 2.2) + 2.0));
+    for (int l = 0; l <= 56; l++) {
+        mp->Ml[l] = (float)(rand() % 2000) / 10.0F;
+        mp->Vl[l] = (mode == 0) ? 1 : (mode == 1) ? 0 : ((rand() % 3) != 0);
+    }
+}
+
+TEST_CASE("MBE", "[benchmark][MBE Synthesis]") {
+    srand(1);
+
+    mbe_parms voiced[2], unvoiced[2], mixed[2];
+    randomParms(&voiced[0], 0);
+    randomParms(&voiced[1], 0);
+    randomParms(&unvoiced[0], 1);
+    randomParms(&unvoiced[1], 1);
+    randomParms(&mixed[0], 2);
+    randomParms(&mixed[1], 2);
+
+    float samples[160U];
+
+    BENCHMARK("mbe_synthesizeSpeechF voiced") {
+        mbe_synthesizeSpeechF(samples, &voiced[0], &voiced[1], 3);
+        return samples[0U];
+    };
+
+    BENCHMARK("mbe_synthesizeSpeechF unvoiced") {
+        mbe_synthesizeSpeechF(samples, &unvoiced[0], &unvoiced[1], 3);
+        return samples[0U];
+    };
+
+    BENCHMARK("mbe_synthesizeSpeechF mixed") {
+        mbe_synthesizeSpeechF(samples, &mixed[0], &mixed[1], 3);
+        return samples[0U];
+    };
+
+    MBEDecoder ambe = MBEDecoder(DECODE_DMR_AMBE);
+    MBEDecoder imbe = MBEDecoder(DECODE_88BIT_IMBE);
+
+    uint8_t ambeCodeword[9U], imbeCodeword[11U];
+    for (size_t i = 0; i < sizeof(ambeCodeword); i++)
+        ambeCodeword[i] = rand();
+    for (size_t i = 0; i < sizeof(imbeCodeword); i++)
+        imbeCodeword[i] = rand();
+
+    int16_t pcm[160U];
+
+    BENCHMARK("MBEDecoder DMR AMBE decode") {
+        return ambe.decode(ambeCodeword, pcm);
+    };
+
+    BENCHMARK("MBEDecoder P25 IMBE decode") {
+        return imbe.decode(imbeCodeword, pcm);
+    };
+}
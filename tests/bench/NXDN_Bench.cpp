@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/nxdn/NXDNDefines.h"
+#include "common/nxdn/channel/CAC.h"
+#include "common/nxdn/channel/FACCH1.h"
+#include "common/nxdn/channel/LICH.h"
+#include "common/nxdn/channel/SACCH.h"
+#include "common/nxdn/channel/UDCH.h"
+
+using namespace nxdn;
+using namespace nxdn::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+// channels are encoded into, and decoded from, a full NXDN frame at their air interface offsets
+
+TEST_CASE("NXDN LICH", "[benchmark][NXDN LICH]") {
+    channel::LICH lich = channel::LICH();
+    lich.setRFCT(RFChannelType::RTCH);
+    lich.setFCT(FuncChannelType::USC_SACCH_SS);
+    lich.setOption(ChOption::DATA_COMMON);
+    lich.setOutbound(true);
+
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    BENCHMARK("encode") {
+        lich.encode(data + 2U);
+        return data[2U];
+    };
+
+    lich.encode(data + 2U);
+
+    BENCHMARK("decode") {
+        return lich.decode(data + 2U);
+    };
+}
+
+TEST_CASE("NXDN SACCH", "[benchmark][NXDN SACCH]") {
+    channel::SACCH sacch = channel::SACCH();
+    sacch.setRAN(1U);
+    sacch.setStructure(ChStructure::SR_SINGLE);
+
+    uint8_t payload[NXDN_SACCH_CRC_LENGTH_BYTES];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = rand();
+    sacch.setData(payload);
+
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    BENCHMARK("encode") {
+        sacch.encode(data + 2U);
+        return data[2U];
+    };
+
+    sacch.encode(data + 2U);
+
+    BENCHMARK("decode") {
+        return sacch.decode(data + 2U);
+    };
+}
+
+TEST_CASE("NXDN FACCH1", "[benchmark][NXDN FACCH1]") {
+    channel::FACCH1 facch = channel::FACCH1();
+
+    uint8_t payload[NXDN_FACCH1_CRC_LENGTH_BYTES];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = rand();
+    facch.setData(payload);
+
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    const uint32_t offset = NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS + NXDN_SACCH_FEC_LENGTH_BITS;
+
+    BENCHMARK("encode") {
+        facch.encode(data + 2U, offset);
+        return data[2U];
+    };
+
+    facch.encode(data + 2U, offset);
+
+    BENCHMARK("decode") {
+        return facch.decode(data + 2U, offset);
+    };
+}
+
+TEST_CASE("NXDN UDCH", "[benchmark][NXDN UDCH]") {
+    channel::UDCH udch = channel::UDCH();
+    udch.setRAN(1U);
+
+    uint8_t payload[NXDN_RTCH_LC_LENGTH_BYTES];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = rand();
+    udch.setData(payload);
+
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    BENCHMARK("encode") {
+        udch.encode(data + 2U);
+        return data[2U];
+    };
+
+    udch.encode(data + 2U);
+
+    BENCHMARK("decode") {
+        return udch.decode(data + 2U);
+    };
+}
+
+TEST_CASE("NXDN CAC", "[benchmark][NXDN CAC]") {
+    channel::CAC cac = channel::CAC();
+    cac.setRAN(1U);
+    cac.setStructure(ChStructure::SR_SINGLE);
+
+    uint8_t payload[NXDN_CAC_CRC_LENGTH_BYTES];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = rand();
+    cac.setData(payload);
+
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    // only the outbound CAC can be encoded (a base station never transmits an inbound CAC), so
+    // there is no valid frame to benchmark decode against
+    BENCHMARK("encode (outbound)") {
+        cac.encode(data + 2U);
+        return data[2U];
+    };
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/NID.h"
+#include "common/p25/P25Utils.h"
+#include "common/p25/lc/LC.h"
+#include "common/Utils.h"
+
+using namespace p25;
+using namespace p25::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+/* Bit-at-a-time status symbol strip, as P25Utils::decode() used to be, for comparison. */
+static uint32_t bitwiseDecode(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+    while (ss0Pos < start) {
+        ss0Pos += P25_SS_INCREMENT;
+        ss1Pos += P25_SS_INCREMENT;
+    }
+
+    uint32_t n = 0U;
+    for (uint32_t i = start; i < stop; i++) {
+        if (i == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (i == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, i);
+            WRITE_BIT(out, n, b);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+TEST_CASE("P25 NID", "[benchmark][P25 NID]") {
+    NID nid = NID(0x293U);
+
+    uint8_t data[P25_LDU_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    BENCHMARK("encode") {
+        nid.encode(data + 2U, DUID::LDU1);
+        return data[2U];
+    };
+
+    nid.encode(data + 2U, DUID::LDU1);
+
+    BENCHMARK("decode") {
+        return nid.decode(data + 2U);
+    };
+}
+
+TEST_CASE("P25 LC", "[benchmark][P25 LC]") {
+    lc::LC lc = lc::LC();
+    lc.setLCO(LCO::GROUP);
+    lc.setSrcId(1234567U);
+    lc.setDstId(1U);
+
+    uint8_t data[P25_LDU_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, sizeof(data));
+
+    // LDU1 link control is carried in 24 Hamming (10,6,3) protected hexbits with RS (24,12,13) FEC
+    BENCHMARK("encodeLDU1") {
+        lc.setSrcId(lc.getSrcId() ^ 0x01U);
+        lc.encodeLDU1(data + 2U);
+        return data[2U];
+    };
+
+    lc.encodeLDU1(data + 2U);
+
+    BENCHMARK("decodeLDU1") {
+        return lc.decodeLDU1(data + 2U);
+    };
+}
+
+TEST_CASE("P25Utils", "[benchmark][P25Utils]") {
+    // the IMBE regions of an LDU, as extracted by p25::Audio
+    const uint32_t IMBE_REGIONS[9U][2U] = {
+        { 114U, 262U }, { 262U, 410U }, { 452U, 600U }, { 640U, 788U }, { 830U, 978U },
+        { 1020U, 1168U }, { 1208U, 1356U }, { 1398U, 1546U }, { 1578U, 1726U } };
+
+    uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES], data[P25_LDU_FRAME_LENGTH_BYTES];
+    for (size_t i = 0; i < sizeof(frame); i++)
+        frame[i] = rand();
+    ::memset(data, 0x00U, sizeof(data));
+
+    BENCHMARK("decode (full LDU)") {
+        return P25Utils::decode(frame, data, P25_PREAMBLE_LENGTH_BITS, P25_LDU_FRAME_LENGTH_BITS);
+    };
+
+    BENCHMARK("decode (full LDU, bitwise)") {
+        return bitwiseDecode(frame, data, P25_PREAMBLE_LENGTH_BITS, P25_LDU_FRAME_LENGTH_BITS);
+    };
+
+    BENCHMARK("encode (full LDU)") {
+        data[0U] ^= 0x01U;
+        return P25Utils::encode(data, frame, P25_PREAMBLE_LENGTH_BITS, P25_LDU_FRAME_LENGTH_BITS);
+    };
+
+    BENCHMARK("decode (9 IMBE regions)") {
+        uint32_t n = 0U;
+        for (uint32_t i = 0U; i < 9U; i++)
+            n += P25Utils::decode(frame, data, IMBE_REGIONS[i][0U], IMBE_REGIONS[i][1U]);
+        return n;
+    };
+
+    BENCHMARK("encode (9 IMBE regions)") {
+        uint32_t n = 0U;
+        for (uint32_t i = 0U; i < 9U; i++)
+            n += P25Utils::encode(data, frame, IMBE_REGIONS[i][0U], IMBE_REGIONS[i][1U]);
+        return n;
+    };
+
+    BENCHMARK("addStatusBits (full LDU)") {
+        P25Utils::addStatusBits(frame, P25_LDU_FRAME_LENGTH_BITS, false, false);
+        return frame[8U];
+    };
+}
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/edac/AMBEFEC.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "edac/AMBEFECReference.h"
+
+using namespace edac;
+using namespace dmr;
+using namespace dmr::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+TEST_CASE("DMR", "[DMR AMBE FEC Test]") {
+    SECTION("DMR_AMBEFEC_Regenerate_Test") {
+        bool failed = false;
+
+        INFO("DMR AMBE FEC Regenerate Test");
+
+        srand((unsigned int)time(NULL));
+
+        AMBEFEC fec = AMBEFEC();
+
+        for (uint32_t n = 0U; n < 64U; n++) {
+            uint8_t frame[DMR_FRAME_LENGTH_BYTES];
+            for (size_t i = 0; i < sizeof(frame); i++) {
+                frame[i] = rand();
+            }
+
+            // the B word whitening depends on the (corrected) A word, so it takes two passes for
+            // random data to become a valid codeword set; regenerating again must be error free
+            fec.regenerateDMR(frame);
+            fec.regenerateDMR(frame);
+
+            uint8_t clean[DMR_FRAME_LENGTH_BYTES];
+            ::memcpy(clean, frame, sizeof(frame));
+
+            uint32_t errors = fec.regenerateDMR(frame);
+            if (errors != 0U || ::memcmp(clean, frame, sizeof(frame)) != 0) {
+                ::LogDebug("T", "DMR_AMBEFEC_Regenerate_Test, failed clean frame, errors = %u", errors);
+                failed = true;
+                break;
+            }
+
+            // a single bit error in the A Golay codeword of the first AMBE frame is measured and corrected
+            uint32_t bit = AMBE_A_TABLE[rand() % 24U];
+            WRITE_BIT(frame, bit, !READ_BIT(frame, bit));
+
+            errors = fec.measureDMRBER(frame);
+            if (errors != 1U) {
+                ::LogDebug("T", "DMR_AMBEFEC_Regenerate_Test, failed BER, bit = %u, errors = %u", bit, errors);
+                failed = true;
+                break;
+            }
+
+            errors = fec.regenerateDMR(frame);
+            if (errors != 1U || ::memcmp(clean, frame, sizeof(frame)) != 0) {
+                ::LogDebug("T", "DMR_AMBEFEC_Regenerate_Test, failed correction, bit = %u, errors = %u", bit, errors);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("DMR_AMBEFEC_BitExact_Test") {
+        bool failed = false;
+
+        INFO("DMR AMBE FEC Bit-Exact Test");
+
+        AMBEFEC fec = AMBEFEC();
+
+        // regenerated and error corrected frames must be bit-exact with the original implementation
+        uint64_t hash = hashAMBEFrames(DMR_FRAME_LENGTH_BYTES,
+            [&](uint8_t* frame) { return fec.regenerateDMR(frame); },
+            [&](uint8_t* frame) { return fec.measureDMRBER(frame); });
+
+        if (hash != DMR_AMBE_FEC_REFERENCE_HASH) {
+            ::LogDebug("T", "DMR_AMBEFEC_BitExact_Test, failed, hash = $%016llX, expected = $%016llX",
+                (unsigned long long)hash, (unsigned long long)DMR_AMBE_FEC_REFERENCE_HASH);
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
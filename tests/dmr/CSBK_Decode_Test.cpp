@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/dmr/lc/csbk/CSBKFactory.h"
+#include "common/SlabAllocator.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace dmr;
+using namespace dmr::defines;
+using namespace dmr::lc;
+using namespace dmr::lc::csbk;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+TEST_CASE("CSBK", "[DMR CSBK Decode Test]") {
+    SECTION("InPlace_Decode") {
+        bool failed = false;
+
+        INFO("DMR CSBK In-Place Decode Test");
+
+        uint8_t data[DMR_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+        CSBK_CALL_ALRT alert = CSBK_CALL_ALRT();
+        alert.setSrcId(1234U);
+        alert.setDstId(5678U);
+        alert.setLastBlock(true);
+        alert.encode(data);
+
+        // decode on the heap, through the existing factory
+        std::unique_ptr<CSBK> heap = CSBKFactory::createCSBK(data, DataType::CSBK);
+        if (heap == nullptr || heap->getCSBKO() != CSBKO::RAND || heap->getFID() != FID_DMRA) {
+            ::LogDebug("T", "CSBK, factory failed to decode CSBK");
+            failed = true;
+        }
+
+        // decode in place; this should not allocate the CSBK
+        uint64_t allocations = SlabAllocator::allocations();
+
+        CSBKStorage storage;
+        CSBK* csbk = CSBKFactory::decodeCSBK(data, DataType::CSBK, storage);
+        if (csbk == nullptr || csbk != storage.get() || dynamic_cast<CSBK_CALL_ALRT*>(csbk) == nullptr) {
+            ::LogDebug("T", "CSBK, failed to decode CSBK in place");
+            failed = true;
+        }
+        else if (heap != nullptr && (csbk->getSrcId() != heap->getSrcId() || csbk->getDstId() != heap->getDstId() ||
+            csbk->getSrcId() != 1234U || csbk->getDstId() != 5678U)) {
+            ::LogDebug("T", "CSBK, in place decode mismatch, srcId = %u, dstId = %u", csbk->getSrcId(), csbk->getDstId());
+            failed = true;
+        }
+
+        uint32_t visited = 0U;
+        bool ret = CSBKFactory::visitCSBK(data, DataType::CSBK, [&](CSBK& visit) {
+            if (visit.getCSBKO() == CSBKO::RAND && visit.getDstId() == 5678U)
+                visited++;
+        });
+
+        if (!ret || visited != 1U) {
+            ::LogDebug("T", "CSBK, visitor not called, ret = %s, visited = %u", ret ? "true" : "false", visited);
+            failed = true;
+        }
+
+        if (SlabAllocator::allocations() != allocations) {
+            ::LogDebug("T", "CSBK, in place decode allocated, %u != %u", (uint32_t)SlabAllocator::allocations(), (uint32_t)allocations);
+            failed = true;
+        }
+
+        // a block that fails its CRC shouldn't decode, and leaves the storage empty
+        ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+        if (CSBKFactory::decodeCSBK(data, DataType::CSBK, storage) != nullptr || storage) {
+            ::LogDebug("T", "CSBK, invalid CSBK decoded");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#if !defined(__TESTS__AMBE_FEC_REFERENCE_H__)
+#define __TESTS__AMBE_FEC_REFERENCE_H__
+
+#include "common/Defines.h"
+#include "common/Utils.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/*
+** Hashes of the frames (and error counts) produced by the original bit-at-a-time AMBE/IMBE FEC
+** implementation for the frame sequence generated by hashAMBEFrames(). The IMBE hash includes the
+** original behaviour of the 24-bit Golay re-encode overwriting the first bit of the next section.
+*/
+const uint64_t DMR_AMBE_FEC_REFERENCE_HASH = 0x197BD1BB54A3F516ULL;
+const uint64_t NXDN_AMBE_FEC_REFERENCE_HASH = 0x1A210FB2A0F98915ULL;
+const uint64_t P25_IMBE_FEC_REFERENCE_HASH = 0xB03E6757449C5379ULL;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Runs a fixed sequence of frames through the given regenerate and measure functions, and
+ *  hashes the regenerated frames and error counts.
+ * 
+ *  Every other frame starts from a valid codeword set with up to four bit errors, the rest are random
+ *  (and mostly uncorrectable). The frames are generated with a xorshift PRNG, so the sequence doesn't
+ *  depend on the C library rand().
+ * @tparam Regen Callable taking (uint8_t* frame) and returning the count of errors.
+ * @tparam Measure Callable taking (uint8_t* frame) and returning the count of errors.
+ * @param frameLen Length of a frame in bytes.
+ * @param regen Regenerate function.
+ * @param measure Measure BER function.
+ * @returns uint64_t FNV-1a hash.
+ */
+template<typename Regen, typename Measure>
+uint64_t hashAMBEFrames(uint32_t frameLen, Regen regen, Measure measure)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    uint32_t state = 0x2545F491U;
+
+    auto nextRandom = [&]() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+    auto hashBytes = [&](const uint8_t* data, uint32_t len) {
+        for (uint32_t i = 0U; i < len; i++) {
+            hash ^= data[i];
+            hash *= 0x100000001B3ULL;
+        }
+    };
+
+    uint8_t frame[64U];
+    for (uint32_t n = 0U; n < 4096U; n++) {
+        for (uint32_t i = 0U; i < frameLen; i++) {
+            frame[i] = (uint8_t)nextRandom();
+        }
+
+        if ((n & 1U) == 1U) {
+            // the B word whitening depends on the (corrected) A word, so it takes two passes for
+            // random data to become a valid codeword set
+            regen(frame);
+            regen(frame);
+
+            uint32_t flips = 1U + (nextRandom() % 4U);
+            for (uint32_t i = 0U; i < flips; i++) {
+                uint32_t bit = nextRandom() % (frameLen * 8U);
+                WRITE_BIT(frame, bit, !READ_BIT(frame, bit));
+            }
+        }
+
+        uint32_t errors[2U];
+        errors[0U] = measure(frame);
+        errors[1U] = regen(frame);
+
+        hashBytes(frame, frameLen);
+        hashBytes((uint8_t*)errors, sizeof(errors));
+    }
+
+    return hash;
+}
+
+#endif // __TESTS__AMBE_FEC_REFERENCE_H__
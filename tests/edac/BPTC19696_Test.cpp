@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/BPTC19696.h"
+#include "common/edac/Hamming.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Bit-array BPTC (196,96) decode used as the reference for the packed implementation. */
+static void referenceDecode(const uint8_t* in, uint8_t* out)
+{
+    bool raw[196U], d[196U];
+    for (uint32_t i = 0U; i < 196U; i++) {
+        uint32_t pos = (i < 98U) ? i : i + 68U;
+        raw[i] = READ_BIT(in, pos) != 0U;
+    }
+
+    for (uint32_t a = 0U; a < 196U; a++)
+        d[a] = raw[(a * 181U) % 196U];
+
+    bool fixing;
+    uint32_t count = 0U;
+    do {
+        fixing = false;
+
+        bool col[13U];
+        for (uint32_t c = 0U; c < 15U; c++) {
+            for (uint32_t a = 0U; a < 13U; a++)
+                col[a] = d[c + 1U + (a * 15U)];
+
+            if (Hamming::decode1393(col)) {
+                for (uint32_t a = 0U; a < 13U; a++)
+                    d[c + 1U + (a * 15U)] = col[a];
+                fixing = true;
+            }
+        }
+
+        for (uint32_t r = 0U; r < 9U; r++) {
+            if (Hamming::decode15113_2(d + (r * 15U) + 1U))
+                fixing = true;
+        }
+
+        count++;
+    } while (fixing && count < 5U);
+
+    ::memset(out, 0x00U, 12U);
+    uint32_t pos = 0U;
+    for (uint32_t a = 4U; a <= 11U; a++, pos++)
+        WRITE_BIT(out, pos, d[a]);
+    for (uint32_t r = 1U; r < 9U; r++) {
+        for (uint32_t a = 0U; a < 11U; a++, pos++)
+            WRITE_BIT(out, pos, d[(r * 15U) + 1U + a]);
+    }
+}
+
+/* Bit-array BPTC (196,96) encode used as the reference for the packed implementation. */
+static void referenceEncode(const uint8_t* in, uint8_t* out)
+{
+    bool d[196U], raw[196U];
+    ::memset(d, 0x00U, sizeof(d));
+
+    uint32_t pos = 0U;
+    for (uint32_t a = 4U; a <= 11U; a++, pos++)
+        d[a] = READ_BIT(in, pos) != 0U;
+    for (uint32_t r = 1U; r < 9U; r++) {
+        for (uint32_t a = 0U; a < 11U; a++, pos++)
+            d[(r * 15U) + 1U + a] = READ_BIT(in, pos) != 0U;
+    }
+
+    for (uint32_t r = 0U; r < 9U; r++)
+        Hamming::encode15113_2(d + (r * 15U) + 1U);
+
+    bool col[13U];
+    for (uint32_t c = 0U; c < 15U; c++) {
+        for (uint32_t a = 0U; a < 13U; a++)
+            col[a] = d[c + 1U + (a * 15U)];
+        Hamming::encode1393(col);
+        for (uint32_t a = 0U; a < 13U; a++)
+            d[c + 1U + (a * 15U)] = col[a];
+    }
+
+    for (uint32_t a = 0U; a < 196U; a++)
+        raw[(a * 181U) % 196U] = d[a];
+
+    for (uint32_t i = 0U; i < 196U; i++) {
+        uint32_t pos = (i < 98U) ? i : i + 68U;
+        WRITE_BIT(out, pos, raw[i]);
+    }
+}
+
+TEST_CASE("BPTC19696", "[BPTC (196,96) Test]") {
+    SECTION("Sanity_Test") {
+        bool failed = false;
+
+        INFO("BPTC (196,96) FEC Test");
+
+        srand((unsigned int)time(NULL));
+
+        BPTC19696 bptc = BPTC19696();
+
+        uint8_t payload[12U], frame[33U], decoded[12U];
+        for (size_t i = 0; i < sizeof(payload); i++) {
+            payload[i] = rand();
+        }
+
+        ::memset(frame, 0x00U, sizeof(frame));
+        bptc.encode(payload, frame);
+
+        Utils::dump(2U, "Sanity_Test BPTC", frame, sizeof(frame));
+
+        // every single bit error in the payload should be corrected
+        for (uint32_t i = 0U; i < 196U; i++) {
+            uint32_t pos = (i < 98U) ? i : i + 68U;
+
+            uint8_t errored[33U];
+            ::memcpy(errored, frame, sizeof(errored));
+            errored[pos >> 3] ^= BIT_MASK_TABLE[pos & 7U];
+
+            bptc.decode(errored, decoded);
+            if (::memcmp(payload, decoded, sizeof(payload)) != 0) {
+                ::LogDebug("T", "Sanity_Test, failed to correct bit %u", i);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Equivalence_Test") {
+        bool failed = false;
+
+        INFO("BPTC (196,96) Packed/Bitwise Equivalence Test");
+
+        srand((unsigned int)time(NULL));
+
+        BPTC19696 bptc = BPTC19696();
+
+        uint8_t payload[12U], frame[33U], expected[33U], decoded[12U], expectedDecoded[12U];
+        for (uint32_t n = 0U; n < 4096U; n++) {
+            for (size_t i = 0; i < sizeof(payload); i++) {
+                payload[i] = rand();
+            }
+            for (size_t i = 0; i < sizeof(frame); i++) {
+                frame[i] = expected[i] = rand();
+            }
+
+            bptc.encode(payload, frame);
+            referenceEncode(payload, expected);
+            if (::memcmp(frame, expected, sizeof(frame)) != 0) {
+                ::LogDebug("T", "Equivalence_Test, encode mismatch");
+                failed = true;
+            }
+
+            // add up to 12 bit errors, past what can be corrected, so the iterative decode
+            // and its uncorrectable cases are compared as well
+            uint32_t errors = rand() % 13U;
+            for (uint32_t e = 0U; e < errors; e++) {
+                uint32_t pos = rand() % 264U;
+                frame[pos >> 3] ^= BIT_MASK_TABLE[pos & 7U];
+            }
+
+            bptc.decode(frame, decoded);
+            referenceDecode(frame, expectedDecoded);
+            if (::memcmp(decoded, expectedDecoded, sizeof(decoded)) != 0) {
+                ::LogDebug("T", "Equivalence_Test, decode mismatch, errors = %u", errors);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
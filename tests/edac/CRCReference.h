@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#if !defined(__TESTS__CRC_REFERENCE_H__)
+#define __TESTS__CRC_REFERENCE_H__
+
+#include "common/Defines.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Bit-at-a-time CRC (up to 16 bits) used as the reference for the table-driven implementations.
+ * @param in Input buffer.
+ * @param bitLength Length of input in bits.
+ * @param width Width of the CRC in bits.
+ * @param poly CRC polynomial.
+ * @param init Initial CRC register value.
+ * @returns uint16_t Calculated CRC.
+ */
+inline uint16_t referenceCRC(const uint8_t* in, uint32_t bitLength, uint32_t width, uint16_t poly, uint16_t init)
+{
+    uint16_t mask = (uint16_t)((1U << width) - 1U);
+    uint16_t top = (uint16_t)(1U << (width - 1U));
+    uint16_t crc = init;
+
+    for (uint32_t i = 0U; i < bitLength; i++) {
+        bool bit1 = READ_BIT(in, i) != 0x00U;
+        bool bit2 = (crc & top) == top;
+
+        crc <<= 1;
+
+        if (bit1 ^ bit2)
+            crc ^= poly;
+    }
+
+    return crc & mask;
+}
+
+/**
+ * @brief Bit-at-a-time 32-bit CRC used as the reference for the slice-by-8 implementation.
+ * @param in Input buffer.
+ * @param length Length of input in bytes.
+ * @returns uint32_t Calculated CRC.
+ */
+inline uint32_t referenceCRC32(const uint8_t* in, uint32_t length)
+{
+    uint32_t crc = 0x00000000U;
+
+    for (uint32_t i = 0U; i < length; i++) {
+        crc ^= (uint32_t)in[i] << 24;
+        for (uint32_t j = 0U; j < 8U; j++) {
+            if ((crc & 0x80000000U) == 0x80000000U)
+                crc = (crc << 1) ^ 0x04C11DB7U;
+            else
+                crc <<= 1;
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * @brief Compares a table-driven CRC against the bit-at-a-time reference, over random data at a
+ *  range of bit lengths (including lengths that are not byte aligned).
+ * @tparam F Callable taking (uint8_t* in, uint32_t bitLength) and returning the CRC.
+ * @param name Name of the test (for logging).
+ * @param crcFunc Table-driven CRC function.
+ * @param width Width of the CRC in bits.
+ * @param poly CRC polynomial.
+ * @param init Initial CRC register value.
+ * @param invert Flag indicating the table-driven CRC is the ones complement of the reference.
+ * @returns bool True, if every CRC matched, otherwise false.
+ */
+template<typename F>
+bool checkCRCEquivalence(const char* name, F crcFunc, uint32_t width, uint16_t poly, uint16_t init, bool invert = false)
+{
+    srand((unsigned int)time(NULL));
+
+    const uint32_t bitLengths[] = { 1U, 7U, 8U, 25U, 64U, 71U, 80U, 96U, 144U, 167U, 196U };
+    uint16_t mask = (uint16_t)((1U << width) - 1U);
+
+    bool ret = true;
+    uint8_t buffer[32U];
+    for (uint32_t bitLength : bitLengths) {
+        for (uint32_t n = 0U; n < 64U; n++) {
+            for (size_t i = 0; i < sizeof(buffer); i++) {
+                buffer[i] = rand();
+            }
+
+            uint16_t expected = referenceCRC(buffer, bitLength, width, poly, init);
+            if (invert)
+                expected = ~expected & mask;
+
+            uint16_t crc = (uint16_t)crcFunc(buffer, bitLength);
+            if (crc != expected) {
+                ::LogDebug("T", "%s, failed, bitLength = %u, crc = $%04X, expected = $%04X", name, bitLength, crc, expected);
+                ret = false;
+            }
+        }
+    }
+
+    return ret;
+}
+
+#endif // __TESTS__CRC_REFERENCE_H__
@@ -11,6 +11,7 @@
 #include "common/edac/CRC.h"
 #include "common/Log.h"
 #include "common/Utils.h"
+#include "edac/CRCReference.h"
 
 using namespace edac;
 
@@ -62,4 +63,15 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("12_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 12-bit CRC Table/Bitwise Equivalence Test");
+
+        if (!checkCRCEquivalence("12_Equivalence_Test", CRC::addCRC12, 12U, 0x080FU, 0x0FFFU))
+            failed = true;
+
+        REQUIRE(failed==false);
+    }
 }
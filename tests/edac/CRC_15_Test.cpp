@@ -11,6 +11,7 @@
 #include "common/edac/CRC.h"
 #include "common/Log.h"
 #include "common/Utils.h"
+#include "edac/CRCReference.h"
 
 using namespace edac;
 
@@ -62,4 +63,15 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("15_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 15-bit CRC Table/Bitwise Equivalence Test");
+
+        if (!checkCRCEquivalence("15_Equivalence_Test", CRC::addCRC15, 15U, 0x4CC5U, 0x7FFFU))
+            failed = true;
+
+        REQUIRE(failed==false);
+    }
 }
@@ -11,6 +11,7 @@
 #include "common/edac/CRC.h"
 #include "common/Log.h"
 #include "common/Utils.h"
+#include "edac/CRCReference.h"
 
 using namespace edac;
 
@@ -62,4 +63,15 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("16_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 16-bit CRC Table/Bitwise Equivalence Test");
+
+        if (!checkCRCEquivalence("16_Equivalence_Test", CRC::createCRC16, 16U, 0x1021U, 0xFFFFU))
+            failed = true;
+
+        REQUIRE(failed==false);
+    }
 }
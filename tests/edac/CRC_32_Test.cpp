@@ -11,6 +11,7 @@
 #include "common/edac/CRC.h"
 #include "common/Log.h"
 #include "common/Utils.h"
+#include "edac/CRCReference.h"
 
 using namespace edac;
 
@@ -61,4 +62,30 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("32_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 32-bit CRC Slice-by-8/Bitwise Equivalence Test");
+
+        srand((unsigned int)time(NULL));
+
+        uint8_t buffer[512U];
+        for (uint32_t len = 5U; len <= sizeof(buffer); len++) {
+            for (size_t i = 0; i < len; i++) {
+                buffer[i] = rand();
+            }
+
+            uint32_t expected = referenceCRC32(buffer, len - 4U);
+            CRC::addCRC32(buffer, len);
+
+            uint32_t crc = (buffer[len - 4U] << 24) | (buffer[len - 3U] << 16) | (buffer[len - 2U] << 8) | (buffer[len - 1U] << 0);
+            if (crc != expected || !CRC::checkCRC32(buffer, len)) {
+                ::LogDebug("T", "32_Equivalence_Test, failed, len = %u, crc = $%08X, expected = $%08X", len, crc, expected);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
 }
@@ -11,6 +11,7 @@
 #include "common/edac/CRC.h"
 #include "common/Log.h"
 #include "common/Utils.h"
+#include "edac/CRCReference.h"
 
 using namespace edac;
 
@@ -62,4 +63,15 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("6_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 6-bit CRC Table/Bitwise Equivalence Test");
+
+        if (!checkCRCEquivalence("6_Equivalence_Test", CRC::addCRC6, 6U, 0x27U, 0x3FU))
+            failed = true;
+
+        REQUIRE(failed==false);
+    }
 }
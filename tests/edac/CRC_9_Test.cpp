@@ -11,6 +11,7 @@
 #include "common/edac/CRC.h"
 #include "common/Log.h"
 #include "common/Utils.h"
+#include "edac/CRCReference.h"
 
 using namespace edac;
 
@@ -58,4 +59,15 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("9_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 9-bit CRC Table/Bitwise Equivalence Test");
+
+        if (!checkCRCEquivalence("9_Equivalence_Test", CRC::createCRC9, 9U, 0x59U, 0x00U, true))
+            failed = true;
+
+        REQUIRE(failed==false);
+    }
 }
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/TalkgroupRulesLookup.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to write a talkgroup rules file with a single rule of the given name. */
+
+static void writeRules(const std::string& filename, const char* name)
+{
+    FILE* fp = ::fopen(filename.c_str(), "wb");
+    REQUIRE(fp != nullptr);
+    ::fprintf(fp,
+        "groupVoice:\n"
+        "  - name: %s\n"
+        "    alias: Test\n"
+        "    config:\n"
+        "      active: true\n"
+        "      affiliated: false\n"
+        "      inclusion: [ 1, 2 ]\n"
+        "      exclusion: []\n"
+        "      rewrite:\n"
+        "        - peerid: 9000\n"
+        "          tgid: 1001\n"
+        "          slot: 2\n"
+        "      always: []\n"
+        "      preferred: []\n"
+        "    source:\n"
+        "      tgid: 1\n"
+        "      slot: 1\n", name);
+    ::fclose(fp);
+}
+
+/* Helper to load the talkgroup rules file (using the cache) and return the name of talkgroup 1. */
+
+static std::string readRules(const std::string& filename)
+{
+    TalkgroupRulesLookup* rules = new TalkgroupRulesLookup(filename, 0U, false);
+    rules->useCache(true);
+    rules->read();
+
+    std::string name = rules->find(1U, 1U).name();
+    rules->stop();
+    return name;
+}
+
+/* Helper to get the modification time of the given file. */
+
+static time_t getMTime(const std::string& filename)
+{
+    struct stat st;
+    if (::stat(filename.c_str(), &st) != 0)
+        return 0;
+    return st.st_mtime;
+}
+
+/* Helper to back date the modification time of the given file. */
+
+static void setMTime(const std::string& filename, time_t mtime)
+{
+    struct utimbuf times;
+    times.actime = mtime;
+    times.modtime = mtime;
+    ::utime(filename.c_str(), &times);
+}
+
+TEST_CASE("TalkgroupRulesCache", "[Talkgroup Rules Cache Test]") {
+    std::string filename = "/tmp/dvmtests_tgrules_" + std::to_string(::getpid()) + ".yml";
+    std::string cacheFile = filename + ".cache";
+    ::unlink(cacheFile.c_str());
+
+    SECTION("Write_Read") {
+        bool failed = false;
+
+        INFO("Talkgroup Rules Cache Write/Read Test");
+
+        writeRules(filename, "Talkgroup A");
+
+        // the first load parses the YAML and writes the cache
+        std::string name = readRules(filename);
+        if (name != "Talkgroup A" || getMTime(cacheFile) == 0) {
+            ::LogDebug("T", "TalkgroupRulesCache, cache not written, name = %s", name.c_str());
+            failed = true;
+        }
+
+        // the second load must come from the cache, which is not rewritten
+        setMTime(cacheFile, 1000);
+        name = readRules(filename);
+        if (name != "Talkgroup A" || getMTime(cacheFile) != 1000) {
+            ::LogDebug("T", "TalkgroupRulesCache, cache not used, name = %s", name.c_str());
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Stale") {
+        bool failed = false;
+
+        INFO("Talkgroup Rules Cache Stale Test");
+
+        writeRules(filename, "Talkgroup A");
+        readRules(filename);
+        setMTime(cacheFile, 1000);
+
+        // an edit that keeps the file size and modification time (i.e. within the same second)
+        // must still invalidate the cache
+        time_t mtime = getMTime(filename);
+        writeRules(filename, "Talkgroup B");
+        setMTime(filename, mtime);
+
+        std::string name = readRules(filename);
+        if (name != "Talkgroup B" || getMTime(cacheFile) == 1000) {
+            ::LogDebug("T", "TalkgroupRulesCache, stale cache used, name = %s", name.c_str());
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Corrupt") {
+        bool failed = false;
+
+        INFO("Talkgroup Rules Cache Corrupt Test");
+
+        writeRules(filename, "Talkgroup A");
+        readRules(filename);
+
+        // flip a byte in the cache body
+        FILE* fp = ::fopen(cacheFile.c_str(), "r+b");
+        REQUIRE(fp != nullptr);
+        ::fseek(fp, 40L, SEEK_SET);
+        int c = ::fgetc(fp);
+        ::fseek(fp, 40L, SEEK_SET);
+        ::fputc(c ^ 0xFF, fp);
+        ::fclose(fp);
+        setMTime(cacheFile, 1000);
+
+        std::string name = readRules(filename);
+        if (name != "Talkgroup A" || getMTime(cacheFile) == 1000) {
+            ::LogDebug("T", "TalkgroupRulesCache, corrupt cache used, name = %s", name.c_str());
+            failed = true;
+        }
+
+        // truncate the cache
+        REQUIRE(::truncate(cacheFile.c_str(), 20) == 0);
+        setMTime(cacheFile, 1000);
+
+        name = readRules(filename);
+        if (name != "Talkgroup A" || getMTime(cacheFile) == 1000) {
+            ::LogDebug("T", "TalkgroupRulesCache, truncated cache used, name = %s", name.c_str());
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Commit") {
+        bool failed = false;
+
+        INFO("Talkgroup Rules Cache Commit Test");
+
+        writeRules(filename, "Talkgroup A");
+        readRules(filename);
+        setMTime(cacheFile, 1000);
+
+        // committing a change rewrites the rules file and regenerates the cache
+        TalkgroupRulesLookup* rules = new TalkgroupRulesLookup(filename, 0U, false);
+        rules->useCache(true);
+        rules->read();
+        rules->addEntry(2U, 1U, true);
+        if (!rules->commit() || getMTime(cacheFile) == 1000) {
+            ::LogDebug("T", "TalkgroupRulesCache, commit did not regenerate the cache");
+            failed = true;
+        }
+        rules->stop();
+
+        // the regenerated cache is used by the next load, and carries the committed change
+        setMTime(cacheFile, 1000);
+        rules = new TalkgroupRulesLookup(filename, 0U, false);
+        rules->useCache(true);
+        rules->read();
+        if (rules->find(2U, 1U).source().tgId() != 2U || rules->find(1U, 1U).name() != "Talkgroup A" ||
+            getMTime(cacheFile) != 1000) {
+            ::LogDebug("T", "TalkgroupRulesCache, committed change not loaded from the cache");
+            failed = true;
+        }
+        rules->stop();
+
+        REQUIRE(failed==false);
+    }
+
+    ::unlink(filename.c_str());
+    ::unlink(cacheFile.c_str());
+}
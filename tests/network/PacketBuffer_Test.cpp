@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/FrameQueue.h"
+#include "common/network/PacketBuffer.h"
+#include "common/network/RTPHeader.h"
+#include "common/network/RTPFNEHeader.h"
+#include "common/network/udp/Socket.h"
+#include "common/SlabAllocator.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace network;
+using namespace network::frame;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <time.h>
+
+#define TEST_PORT 32091U
+#define TEST_FANOUT 16U
+
+TEST_CASE("PacketBuffer", "[Packet Buffer Test]") {
+    SECTION("Pool_Reuse") {
+        bool failed = false;
+
+        INFO("Packet Buffer Pool Reuse Test");
+
+        srand((unsigned int)time(NULL));
+
+        uint8_t data[256U];
+        for (uint32_t i = 0U; i < 256U; i++)
+            data[i] = (uint8_t)rand();
+
+        // warm up the slab allocator
+        {
+            PacketBuffer warm[4U];
+            for (uint32_t i = 0U; i < 4U; i++)
+                warm[i] = PacketBuffer::create((i & 1U) ? 128U : 256U);
+        }
+
+        uint64_t allocations = SlabAllocator::heapAllocations();
+        for (uint32_t i = 0U; i < 1000U; i++) {
+            PacketBuffer buffer = PacketBuffer::copy(data, 256U);
+            PacketBuffer other = PacketBuffer::copy(data, 128U);
+            if (::memcmp(buffer.data(), data, 256U) != 0 || ::memcmp(other.data(), data, 128U) != 0) {
+                ::LogDebug("T", "PacketBuffer, copy mismatch, iteration = %u", i);
+                failed = true;
+                break;
+            }
+        }
+
+        if (SlabAllocator::heapAllocations() != allocations) {
+            ::LogDebug("T", "PacketBuffer, blocks not reused, allocations %u != %u", (uint32_t)SlabAllocator::heapAllocations(), (uint32_t)allocations);
+            failed = true;
+        }
+
+        // blocks are sized to the data, with a zeroed headroom
+        PacketBuffer buffer = PacketBuffer::copy(data, 256U);
+        if (buffer.capacity() != PACKET_BUFFER_HEADROOM + 256U) {
+            ::LogDebug("T", "PacketBuffer, block not sized to the data, capacity = %u", buffer.capacity());
+            failed = true;
+        }
+
+        for (uint32_t i = 0U; i < PACKET_BUFFER_HEADROOM; i++) {
+            if (buffer.data()[(int)i - (int)PACKET_BUFFER_HEADROOM] != 0x00U) {
+                ::LogDebug("T", "PacketBuffer, headroom not zeroed");
+                failed = true;
+                break;
+            }
+        }
+
+        // headroom and views
+        uint8_t* start = buffer.data();
+        if (buffer.headroom() != PACKET_BUFFER_HEADROOM || !buffer.slice(32U, 64U) || buffer.data() != start + 32U ||
+            buffer.length() != 64U || buffer.prepend(32U) != start || buffer.length() != 96U) {
+            ::LogDebug("T", "PacketBuffer, bad view, headroom = %u, len = %u", buffer.headroom(), buffer.length());
+            failed = true;
+        }
+
+        if (buffer.slice(0U, 97U) || PacketBuffer::create(PACKET_BUFFER_HEADROOM + PACKET_BUFFER_CAPACITY)) {
+            ::LogDebug("T", "PacketBuffer, out of range view or buffer allowed");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Shared_FanOut") {
+        bool failed = false;
+
+        INFO("Packet Buffer Shared Fan-out Test");
+
+        srand((unsigned int)time(NULL));
+
+        udp::Socket rxSocket("127.0.0.1", TEST_PORT);
+        udp::Socket txSocket("127.0.0.1", 0U);
+        REQUIRE(rxSocket.open(AF_INET));
+        REQUIRE(txSocket.open(AF_INET));
+
+        sockaddr_storage addr;
+        uint32_t addrLen = 0U;
+        REQUIRE(udp::Socket::lookup("127.0.0.1", TEST_PORT, addr, addrLen) == 0);
+
+        FrameQueue txQueue(&txSocket, 1U, false);
+        FrameQueue rxQueue(&rxSocket, 2U, false);
+
+        uint8_t data[200U];
+        for (uint32_t i = 0U; i < 200U; i++)
+            data[i] = (uint8_t)rand();
+
+        PacketBuffer frame = PacketBuffer::copy(data, 200U);
+
+        // queue the same frame to every destination, every destination should share the frame's block
+        for (uint32_t i = 0U; i < TEST_FANOUT; i++) {
+            txQueue.enqueueMessage(frame, 1234U, 1U, 1U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, (uint16_t)i, addr, addrLen);
+        }
+
+        ::LogDebug("T", "PacketBuffer, fan-out to %u peers, refs = %u", TEST_FANOUT, frame.useCount());
+        if (frame.useCount() != TEST_FANOUT + 1U) {
+            failed = true;
+        }
+
+        txQueue.flushQueue();
+        if (frame.useCount() != 1U) {
+            ::LogDebug("T", "PacketBuffer, references held after flush, refs = %u", frame.useCount());
+            failed = true;
+        }
+
+        // every destination should have received the same, complete, frame
+        uint32_t received = 0U;
+        for (uint32_t n = 0U; n < 200U && received < TEST_FANOUT; n++) {
+            sockaddr_storage rxAddr;
+            uint32_t rxAddrLen = 0U;
+            RTPHeader rtpHeader;
+            RTPFNEHeader fneHeader;
+            int length = 0;
+
+            PacketBuffer message = rxQueue.readPacket(length, rxAddr, rxAddrLen, &rtpHeader, &fneHeader);
+            if (!message || length <= 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                continue;
+            }
+
+            if (length != 200 || ::memcmp(message.data(), data, 200U) != 0 || rtpHeader.getSequence() != received ||
+                fneHeader.getStreamId() != 1234U) {
+                ::LogDebug("T", "PacketBuffer, bad frame received, len = %d, seq = %u", length, rtpHeader.getSequence());
+                failed = true;
+            }
+
+            // the headers are left in front of the message, and the block is sized to the datagram
+            if (message.headroom() != PACKET_BUFFER_HEADROOM + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES ||
+                message.capacity() != message.headroom() + 200U) {
+                ::LogDebug("T", "PacketBuffer, bad received block, headroom = %u, capacity = %u", message.headroom(), message.capacity());
+                failed = true;
+            }
+
+            received++;
+        }
+
+        if (received != TEST_FANOUT) {
+            ::LogDebug("T", "PacketBuffer, frames lost, %u != %u", received, TEST_FANOUT);
+            failed = true;
+        }
+
+        rxSocket.close();
+        txSocket.close();
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/PeerLinkPeers.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+const uint32_t PARENT_PEER_ID = 9000000U;
+
+/* Helper to create a peer list entry. */
+static PeerLinkPeer createPeer(uint32_t peerId, uint32_t vcCount = 0U)
+{
+    PeerLinkPeer peer;
+    peer.peerId = peerId;
+    peer.address = "10.0.0." + std::to_string(peerId % 250U);
+    peer.port = (uint16_t)(30000U + (peerId % 1000U));
+    peer.connected = true;
+    peer.connectionState = 4U;
+    peer.pingsReceived = peerId % 100U;
+    peer.lastPing = 1700000000000ULL + peerId;
+    peer.ccPeerId = (vcCount > 0U) ? 0U : peerId + 1U;
+    for (uint32_t i = 0U; i < vcCount; i++)
+        peer.voiceChannels.push_back(peerId + 100U + i);
+    peer.config = "{\"identity\":\"PEER " + std::to_string(peerId) + "\",\"software\":\"DVM\"}";
+    return peer;
+}
+
+/* Helper to apply every message of the last encoder update to a decoder. */
+static bool apply(const PeerLinkPeersEncoder& encoder, PeerLinkPeersDecoder& decoder)
+{
+    bool ret = true;
+    for (const std::vector<uint8_t>& message : encoder.messages()) {
+        if (!decoder.decode(PARENT_PEER_ID, message.data(), (uint32_t)message.size()))
+            ret = false;
+    }
+
+    return ret;
+}
+
+/* Helper to check the decoded peer list matches the encoded peer list. */
+static bool matches(const std::vector<PeerLinkPeer>& peers, const PeerLinkPeersDecoder& decoder)
+{
+    std::map<uint32_t, json::object> decoded = decoder.peers();
+    if (decoded.size() != peers.size()) {
+        ::LogDebug("T", "PeerLinkPeers, peer count mismatch, %u != %u", (uint32_t)decoded.size(), (uint32_t)peers.size());
+        return false;
+    }
+
+    for (const PeerLinkPeer& peer : peers) {
+        auto it = decoded.find(peer.peerId);
+        if (it == decoded.end()) {
+            ::LogDebug("T", "PeerLinkPeers, peer %u missing", peer.peerId);
+            return false;
+        }
+
+        json::object& obj = it->second;
+
+        json::array vcs = obj["voiceChannels"].get<json::array>();
+        bool vcMatch = vcs.size() == peer.voiceChannels.size();
+        for (size_t i = 0U; vcMatch && i < vcs.size(); i++)
+            vcMatch = (uint32_t)vcs[i].get<double>() == peer.voiceChannels[i];
+
+        json::value config;
+        json::parse(config, peer.config);
+
+        if (obj["peerId"].get<uint32_t>() != peer.peerId || obj["address"].get<std::string>() != peer.address ||
+            obj["port"].get<uint16_t>() != peer.port || obj["connected"].get<bool>() != peer.connected ||
+            obj["connectionState"].get<uint32_t>() != peer.connectionState || obj["pingsReceived"].get<uint32_t>() != peer.pingsReceived ||
+            obj["lastPing"].get<uint64_t>() != peer.lastPing || obj["controlChannel"].get<uint32_t>() != peer.ccPeerId || !vcMatch ||
+            json::value(obj["config"].get<json::object>()).serialize() != config.serialize() ||
+            obj["parentPeerId"].get<uint32_t>() != PARENT_PEER_ID) {
+            ::LogDebug("T", "PeerLinkPeers, peer %u mismatch, %s", peer.peerId, json::value(obj).serialize().c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE("PeerLinkPeers", "[Peer-Link Peer List Test]") {
+    SECTION("Add_Update_Remove") {
+        bool failed = false;
+
+        INFO("Peer-Link Peer List Delta Round Trip Test");
+
+        PeerLinkPeersEncoder encoder;
+        PeerLinkPeersDecoder decoder;
+
+        std::vector<PeerLinkPeer> peers;
+        for (uint32_t i = 0U; i < 8U; i++)
+            peers.push_back(createPeer(1000U + i, (i == 0U) ? 3U : 0U));
+
+        // the first update is always a snapshot
+        encoder.update(peers);
+        if (!apply(encoder, decoder) || !matches(peers, decoder)) {
+            ::LogDebug("T", "PeerLinkPeers, initial snapshot failed");
+            failed = true;
+        }
+
+        // add
+        peers.push_back(createPeer(2000U));
+        peers.push_back(createPeer(2001U, 2U));
+        encoder.update(peers);
+        if (encoder.messages().size() != 1U || encoder.messages()[0U][5U] != 0x00U) {
+            ::LogDebug("T", "PeerLinkPeers, add was not sent as a delta");
+            failed = true;
+        }
+        if (!apply(encoder, decoder) || !matches(peers, decoder)) {
+            ::LogDebug("T", "PeerLinkPeers, add failed");
+            failed = true;
+        }
+
+        // status only change, and a configuration change
+        peers[1U].pingsReceived++;
+        peers[1U].lastPing += 5000U;
+        peers[2U].connected = false;
+        peers[3U].config = "{\"identity\":\"RENAMED\"}";
+        peers[0U].voiceChannels.pop_back();
+        encoder.update(peers);
+        if (!apply(encoder, decoder) || !matches(peers, decoder)) {
+            ::LogDebug("T", "PeerLinkPeers, update failed");
+            failed = true;
+        }
+
+        // nothing changed; no delta is sent
+        encoder.update(peers);
+        if (!encoder.messages().empty()) {
+            ::LogDebug("T", "PeerLinkPeers, unchanged peer list sent a delta");
+            failed = true;
+        }
+
+        // remove
+        peers.erase(peers.begin() + 4U);
+        peers.pop_back();
+        encoder.update(peers);
+        if (!apply(encoder, decoder) || !matches(peers, decoder)) {
+            ::LogDebug("T", "PeerLinkPeers, remove failed");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Snapshot_Resync") {
+        bool failed = false;
+
+        INFO("Peer-Link Peer List Snapshot Resync Test");
+
+        PeerLinkPeersEncoder encoder;
+        PeerLinkPeersDecoder synced;
+
+        // enough peers that a snapshot spans several messages
+        std::vector<PeerLinkPeer> peers;
+        for (uint32_t i = 0U; i < 200U; i++)
+            peers.push_back(createPeer(10000U + i, i % 4U));
+
+        encoder.update(peers);
+        if (encoder.messages().size() < 2U) {
+            ::LogDebug("T", "PeerLinkPeers, snapshot did not span messages, messages = %u", (uint32_t)encoder.messages().size());
+            failed = true;
+        }
+        for (const std::vector<uint8_t>& message : encoder.messages()) {
+            if (message.size() > PEER_LINK_PEERS_MAX_LENGTH) {
+                ::LogDebug("T", "PeerLinkPeers, message too long, len = %u", (uint32_t)message.size());
+                failed = true;
+            }
+        }
+        apply(encoder, synced);
+
+        // a master that missed the deltas (and holds a stale peer) converges on the next snapshot
+        PeerLinkPeersDecoder late;
+        std::vector<PeerLinkPeer> stale;
+        stale.push_back(createPeer(99999U));
+        PeerLinkPeersEncoder staleEncoder;
+        staleEncoder.update(stale);
+        apply(staleEncoder, late);
+
+        for (uint32_t update = 1U; update < PEER_LINK_PEERS_SNAPSHOT_INTERVAL; update++) {
+            peers[update].pingsReceived++;
+            if (update == 3U)
+                peers.erase(peers.begin() + 50U);
+            if (update == 5U)
+                peers.push_back(createPeer(50000U, 1U));
+
+            encoder.update(peers);
+            if (!apply(encoder, synced)) {
+                ::LogDebug("T", "PeerLinkPeers, delta %u failed to decode", update);
+                failed = true;
+            }
+        }
+
+        if (!matches(peers, synced)) {
+            ::LogDebug("T", "PeerLinkPeers, deltas did not track the peer list");
+            failed = true;
+        }
+
+        encoder.update(peers);
+        if ((encoder.messages()[0U][5U] & PEER_LINK_PEERS_FLAG_SNAPSHOT) == 0U) {
+            ::LogDebug("T", "PeerLinkPeers, snapshot interval did not send a snapshot");
+            failed = true;
+        }
+
+        if (!apply(encoder, late) || !matches(peers, late)) {
+            ::LogDebug("T", "PeerLinkPeers, late master failed to resync from the snapshot");
+            failed = true;
+        }
+
+        // an empty snapshot clears the list
+        encoder.forceSnapshot();
+        encoder.update(std::vector<PeerLinkPeer>());
+        if (!apply(encoder, late) || !late.peers().empty()) {
+            ::LogDebug("T", "PeerLinkPeers, empty snapshot did not clear the peer list");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Truncated_Malformed") {
+        bool failed = false;
+
+        INFO("Peer-Link Peer List Truncated/Malformed Test");
+
+        PeerLinkPeersEncoder encoder;
+
+        std::vector<PeerLinkPeer> peers;
+        for (uint32_t i = 0U; i < 4U; i++)
+            peers.push_back(createPeer(3000U + i, 2U));
+
+        encoder.update(peers);
+        std::vector<uint8_t> message = encoder.messages()[0U];
+
+        // every truncation of the message is rejected
+        for (uint32_t len = 0U; len < message.size(); len++) {
+            PeerLinkPeersDecoder decoder;
+            if (decoder.decode(PARENT_PEER_ID, message.data(), len)) {
+                ::LogDebug("T", "PeerLinkPeers, truncated message decoded, len = %u of %u", len, (uint32_t)message.size());
+                failed = true;
+                break;
+            }
+        }
+
+        // unsupported format
+        {
+            std::vector<uint8_t> bad = message;
+            bad[4U] = PEER_LINK_PEERS_FORMAT + 1U;
+
+            PeerLinkPeersDecoder decoder;
+            if (decoder.decode(PARENT_PEER_ID, bad.data(), (uint32_t)bad.size()) || !decoder.peers().empty()) {
+                ::LogDebug("T", "PeerLinkPeers, unsupported format decoded");
+                failed = true;
+            }
+        }
+
+        // unknown entry type
+        {
+            std::vector<uint8_t> bad = message;
+            bad[PEER_LINK_PEERS_HEADER_LENGTH] = 0x7FU;
+
+            PeerLinkPeersDecoder decoder;
+            if (decoder.decode(PARENT_PEER_ID, bad.data(), (uint32_t)bad.size())) {
+                ::LogDebug("T", "PeerLinkPeers, unknown entry type decoded");
+                failed = true;
+            }
+        }
+
+        // entry count larger than the entries carried
+        {
+            std::vector<uint8_t> bad = message;
+            bad[11U] = (uint8_t)(bad[11U] + 1U);
+
+            PeerLinkPeersDecoder decoder;
+            if (decoder.decode(PARENT_PEER_ID, bad.data(), (uint32_t)bad.size())) {
+                ::LogDebug("T", "PeerLinkPeers, overstated entry count decoded");
+                failed = true;
+            }
+        }
+
+        // random garbage after a valid header must never read past the buffer
+        srand(0x5EEDU);
+        for (uint32_t n = 0U; n < 1000U; n++) {
+            std::vector<uint8_t> bad(message.begin(), message.begin() + PEER_LINK_PEERS_HEADER_LENGTH);
+            uint32_t len = (uint32_t)(rand() % 256);
+            for (uint32_t i = 0U; i < len; i++)
+                bad.push_back((uint8_t)rand());
+
+            PeerLinkPeersDecoder decoder;
+            decoder.decode(PARENT_PEER_ID, bad.data(), (uint32_t)bad.size());
+        }
+
+        // a garbled message doesn't disturb a peer list already held
+        PeerLinkPeersDecoder decoder;
+        apply(encoder, decoder);
+        std::vector<uint8_t> bad = message;
+        bad.resize(bad.size() / 2U);
+        decoder.decode(PARENT_PEER_ID, bad.data(), (uint32_t)bad.size());
+        if (!matches(peers, decoder)) {
+            ::LogDebug("T", "PeerLinkPeers, garbled message corrupted the peer list");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/PeerLinkTransfer.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <deque>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Helper to generate a RID ACL style table. */
+static std::vector<uint8_t> createTable(uint32_t count)
+{
+    std::string table;
+    char line[64U];
+    for (uint32_t i = 0U; i < count; i++) {
+        ::snprintf(line, sizeof(line), "%u,1,UNIT %08X,0,\n", 1000000U + i, (uint32_t)rand());
+        table += line;
+    }
+
+    return std::vector<uint8_t>(table.begin(), table.end());
+}
+
+/* Helper to run a transfer over a lossy, reordering link; returns the number of blocks sent. */
+static uint32_t runTransfer(PeerLinkTransmitter& tx, PeerLinkReceiver& rx, uint64_t& now, uint32_t lossPct, uint32_t corruptPct,
+    uint32_t dropAfter, PeerLinkReceiver::Status& result, std::vector<uint8_t>& data)
+{
+    std::deque<std::vector<uint8_t>> wire;
+    uint32_t sent = 0U;
+    auto write = [&](const uint8_t* block, uint32_t length) {
+        sent++;
+        wire.push_back(std::vector<uint8_t>(block, block + length));
+        return true;
+    };
+
+    result = PeerLinkReceiver::XFER_PENDING;
+    tx.start(now);
+    while (!tx.isComplete() && !tx.hasFailed(now)) {
+        tx.clock(now, write);
+
+        for (uint32_t n = 0U; n < 4096U && !wire.empty(); n++) {
+            // occasionally swap the next two blocks
+            if (wire.size() > 1U && (rand() % 8) == 0)
+                std::swap(wire[0U], wire[1U]);
+
+            std::vector<uint8_t> block = wire.front();
+            wire.pop_front();
+
+            uint16_t blockNo = __GET_UINT16B(block, 8U);
+            if (blockNo >= dropAfter || (uint32_t)(rand() % 100) < lossPct)
+                continue;
+            if ((uint32_t)(rand() % 100) < corruptPct)
+                block[block.size() - 1U] ^= 0x5AU;
+
+            PeerLinkReceiver::Status status = rx.process(block.data(), block.size());
+            if (status != PeerLinkReceiver::XFER_PENDING && result == PeerLinkReceiver::XFER_PENDING)
+                result = status;
+            if (status == PeerLinkReceiver::XFER_COMPLETE)
+                data = rx.takeData();
+
+            if (rx.hasAck()) {
+                uint8_t ack[PEER_LINK_XFER_ACK_LENGTH];
+                uint32_t len = rx.encodeAck(ack);
+                if ((uint32_t)(rand() % 100) >= lossPct) {
+                    tx.processAck(ack, len, now);
+                    tx.clock(now, write);
+                }
+            }
+        }
+
+        now += 100U;
+    }
+
+    return sent;
+}
+
+TEST_CASE("PeerLinkTransfer", "[Peer-Link Transfer Test]") {
+    SECTION("Lossy_Link_Test") {
+        bool failed = false;
+
+        INFO("Peer-Link Transfer Lossy Link Test");
+
+        srand((unsigned int)time(NULL));
+
+        std::vector<uint8_t> table = createTable(8192U);
+
+        PeerLinkTransmitter tx(0x01U);
+        PeerLinkReceiver rx(0x01U);
+        REQUIRE(tx.setData(table.data(), table.size()));
+
+        uint64_t now = 1000U;
+        PeerLinkReceiver::Status result;
+        std::vector<uint8_t> data;
+        uint32_t sent = runTransfer(tx, rx, now, 10U, 2U, 0xFFFFU, result, data);
+
+        ::LogDebug("T", "Lossy_Link_Test, blockCnt = %u, sent = %u, retransmits = %u", tx.blockCount(), sent, tx.retransmits());
+
+        if (!tx.isComplete() || result != PeerLinkReceiver::XFER_COMPLETE) {
+            ::LogDebug("T", "Lossy_Link_Test, transfer did not complete");
+            failed = true;
+        }
+
+        if (data != table) {
+            ::LogDebug("T", "Lossy_Link_Test, received data mismatch, len = %u", (uint32_t)data.size());
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Resume_Test") {
+        bool failed = false;
+
+        INFO("Peer-Link Transfer Resume Test");
+
+        srand((unsigned int)time(NULL));
+
+        std::vector<uint8_t> table = createTable(8192U);
+        PeerLinkReceiver rx(0x01U);
+
+        uint64_t now = 1000U;
+        PeerLinkReceiver::Status result;
+        std::vector<uint8_t> data;
+
+        // the link goes down part way through the first attempt
+        PeerLinkTransmitter first(0x01U);
+        REQUIRE(first.setData(table.data(), table.size()));
+        uint32_t dropAfter = first.blockCount() / 2U;
+        runTransfer(first, rx, now, 0U, 0U, dropAfter, result, data);
+        if (first.isComplete() || result != PeerLinkReceiver::XFER_PENDING) {
+            ::LogDebug("T", "Resume_Test, first attempt should not complete");
+            failed = true;
+        }
+
+        // the second attempt only sends what the receiver is missing
+        PeerLinkTransmitter second(0x01U);
+        REQUIRE(second.setData(table.data(), table.size()));
+        uint32_t sent = runTransfer(second, rx, now, 0U, 0U, 0xFFFFU, result, data);
+        if (!second.isComplete() || result != PeerLinkReceiver::XFER_COMPLETE || data != table) {
+            ::LogDebug("T", "Resume_Test, second attempt did not complete");
+            failed = true;
+        }
+
+        // (allowing for the probe, and a few blocks resent due to reordering)
+        if (sent > (uint32_t)(second.blockCount() - dropAfter) + 8U) {
+            ::LogDebug("T", "Resume_Test, resumed transfer resent blocks, blockCnt = %u, sent = %u", second.blockCount(), sent);
+            failed = true;
+        }
+
+        // an unchanged table costs a single block
+        PeerLinkTransmitter third(0x01U);
+        REQUIRE(third.setData(table.data(), table.size()));
+        sent = runTransfer(third, rx, now, 0U, 0U, 0xFFFFU, result, data);
+        if (!third.isComplete() || result != PeerLinkReceiver::XFER_UNCHANGED || sent != 1U) {
+            ::LogDebug("T", "Resume_Test, unchanged table was transferred, sent = %u", sent);
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/PeerRegistry.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Test peer connection; tracks whether it has been deleted. The storage of a deleted
+ *  connection is kept until the end of the test, so a connection reclaimed too early is seen as
+ *  dead rather than being a use after free.
+ */
+class TestConnection {
+public:
+    static std::atomic<uint32_t> deleted;
+
+    /**
+     * @brief Initializes a new instance of the TestConnection class.
+     * @param peerId Peer ID.
+     */
+    TestConnection(uint32_t peerId) : peerId(peerId), alive(true) { /* stub */ }
+    /**
+     * @brief Finalizes a instance of the TestConnection class.
+     */
+    ~TestConnection() { alive.store(false); deleted.fetch_add(1U); }
+
+    static void operator delete(void* p)
+    {
+        std::lock_guard<std::mutex> lock(s_graveyardLock);
+        s_graveyard.push_back(p);
+    }
+
+    /**
+     * @brief Releases the storage of every deleted connection.
+     */
+    static void bury()
+    {
+        std::lock_guard<std::mutex> lock(s_graveyardLock);
+        for (void* p : s_graveyard)
+            ::operator delete(p);
+        s_graveyard.clear();
+    }
+
+    uint32_t peerId;
+    std::atomic<bool> alive;
+
+private:
+    static std::mutex s_graveyardLock;
+    static std::vector<void*> s_graveyard;
+};
+
+std::atomic<uint32_t> TestConnection::deleted(0U);
+std::mutex TestConnection::s_graveyardLock;
+std::vector<void*> TestConnection::s_graveyard;
+
+typedef PeerRegistry<TestConnection> TestRegistry;
+
+TEST_CASE("PeerRegistry", "[Peer Registry Test]") {
+    SECTION("Sharded_Lookup") {
+        bool failed = false;
+
+        INFO("Peer Registry Sharded Lookup Test");
+
+        TestConnection::deleted.store(0U);
+        {
+            TestRegistry registry;
+
+            // enough peers to land several in every shard
+            const uint32_t PEERS = PEER_REGISTRY_SHARDS * 64U;
+            for (uint32_t i = 0U; i < PEERS; i++)
+                registry.insert(1000U + i, new TestConnection(1000U + i));
+
+            if (registry.size() != PEERS) {
+                ::LogDebug("T", "PeerRegistry, size = %u, expected %u", (uint32_t)registry.size(), PEERS);
+                failed = true;
+            }
+
+            for (uint32_t i = 0U; i < PEERS; i++) {
+                TestConnection* connection = registry.find(1000U + i);
+                if (connection == nullptr || connection->peerId != 1000U + i) {
+                    ::LogDebug("T", "PeerRegistry, lookup of peer %u failed", 1000U + i);
+                    failed = true;
+                    break;
+                }
+            }
+
+            if (registry.find(1000U + PEERS) != nullptr || registry.contains(999U)) {
+                ::LogDebug("T", "PeerRegistry, found an unregistered peer");
+                failed = true;
+            }
+
+            // replacing a connection retires the old one
+            registry.insert(1000U, new TestConnection(1000U));
+            if (registry.size() != PEERS || registry.retired() != 1U) {
+                ::LogDebug("T", "PeerRegistry, replace failed, size = %u, retired = %u", (uint32_t)registry.size(), (uint32_t)registry.retired());
+                failed = true;
+            }
+
+            // erase every other peer
+            for (uint32_t i = 0U; i < PEERS; i += 2U) {
+                if (!registry.erase(1000U + i)) {
+                    ::LogDebug("T", "PeerRegistry, erase of peer %u failed", 1000U + i);
+                    failed = true;
+                }
+            }
+
+            if (registry.erase(1000U)) {
+                ::LogDebug("T", "PeerRegistry, erased a peer twice");
+                failed = true;
+            }
+
+            for (uint32_t i = 0U; i < PEERS; i++) {
+                if (registry.contains(1000U + i) != ((i & 1U) == 1U)) {
+                    ::LogDebug("T", "PeerRegistry, peer %u registration wrong after erase", 1000U + i);
+                    failed = true;
+                    break;
+                }
+            }
+
+            TestRegistry::Snapshot snapshot = registry.snapshot();
+            uint32_t count = 0U;
+            for (auto& entry : snapshot) {
+                if (entry.second == nullptr || entry.first != entry.second->peerId || (entry.first & 1U) == 0U)
+                    failed = true;
+                count++;
+            }
+
+            if (count != PEERS / 2U || snapshot.size() != registry.size()) {
+                ::LogDebug("T", "PeerRegistry, snapshot has %u peers, expected %u", count, PEERS / 2U);
+                failed = true;
+            }
+
+            // lookups from several threads while another thread adds and removes peers in every shard
+            std::atomic<bool> lookupFailed(false);
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0U; t < 4U; t++) {
+                threads.push_back(std::thread([&]() {
+                    for (uint32_t n = 0U; n < 20000U; n++) {
+                        uint32_t peerId = 1001U + ((n * 2U) % PEERS);
+                        TestRegistry::ReadGuard guard(registry);
+                        TestConnection* connection = registry.find(peerId);
+                        if (connection == nullptr || connection->peerId != peerId || !connection->alive.load())
+                            lookupFailed.store(true);
+                    }
+                }));
+            }
+
+            for (uint32_t n = 0U; n < 20000U; n++) {
+                uint32_t peerId = 100000U + (n % 256U);
+                if (!registry.erase(peerId))
+                    registry.insert(peerId, new TestConnection(peerId));
+                if ((n % 64U) == 0U)
+                    registry.reclaim();
+            }
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            if (lookupFailed.load()) {
+                ::LogDebug("T", "PeerRegistry, concurrent lookup failed");
+                failed = true;
+            }
+        }
+
+        TestConnection::bury();
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Deferred_Reclaim") {
+        bool failed = false;
+
+        INFO("Peer Registry Deferred Reclamation Test");
+
+        TestConnection::deleted.store(0U);
+        {
+            TestRegistry registry;
+            registry.insert(1U, new TestConnection(1U));
+            registry.insert(2U, new TestConnection(2U));
+
+            // a reader holding an epoch keeps an erased connection alive
+            {
+                TestRegistry::ReadGuard guard(registry);
+                TestConnection* connection = registry.find(1U);
+
+                registry.erase(1U);
+                for (uint32_t i = 0U; i < 8U; i++)
+                    registry.reclaim();
+
+                if (connection == nullptr || !connection->alive.load() || TestConnection::deleted.load() != 0U ||
+                    registry.retired() != 1U) {
+                    ::LogDebug("T", "PeerRegistry, connection freed while a reader held it");
+                    failed = true;
+                }
+            }
+
+            registry.reclaim();
+            if (TestConnection::deleted.load() != 1U || registry.retired() != 0U) {
+                ::LogDebug("T", "PeerRegistry, connection not reclaimed after the reader left, deleted = %u", TestConnection::deleted.load());
+                failed = true;
+            }
+
+            // a snapshot is a read-side section too
+            {
+                TestRegistry::Snapshot snapshot = registry.snapshot();
+
+                registry.erase(2U);
+                for (uint32_t i = 0U; i < 8U; i++)
+                    registry.reclaim();
+
+                for (auto& entry : snapshot) {
+                    if (!entry.second->alive.load()) {
+                        ::LogDebug("T", "PeerRegistry, connection freed while a snapshot held it");
+                        failed = true;
+                    }
+                }
+            }
+
+            registry.reclaim();
+            if (TestConnection::deleted.load() != 2U) {
+                ::LogDebug("T", "PeerRegistry, connection not reclaimed after the snapshot was released");
+                failed = true;
+            }
+
+            // a reader that arrives in a later epoch can't see the connection, and doesn't hold it up
+            registry.insert(3U, new TestConnection(3U));
+            {
+                std::unique_ptr<TestRegistry::ReadGuard> early(new TestRegistry::ReadGuard(registry));
+                registry.erase(3U);
+                registry.reclaim();
+
+                TestRegistry::ReadGuard late(registry);
+                early.reset();
+                registry.reclaim();
+
+                if (TestConnection::deleted.load() != 3U) {
+                    ::LogDebug("T", "PeerRegistry, later reader held up reclamation");
+                    failed = true;
+                }
+            }
+
+            // readers on other threads; each holds its epoch while checking the connection it looked up
+            for (uint32_t i = 0U; i < 64U; i++)
+                registry.insert(10U + i, new TestConnection(10U + i));
+
+            std::atomic<bool> running(true);
+            std::atomic<bool> readFailed(false);
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0U; t < 4U; t++) {
+                threads.push_back(std::thread([&, t]() {
+                    uint32_t n = t;
+                    while (running.load()) {
+                        TestRegistry::ReadGuard guard(registry);
+                        TestConnection* connection = registry.find(10U + (n++ % 64U));
+                        if (connection == nullptr)
+                            continue;
+
+                        for (uint32_t i = 0U; i < 16U; i++) {
+                            if (!connection->alive.load())
+                                readFailed.store(true);
+                            std::this_thread::yield();
+                        }
+                    }
+                }));
+            }
+
+            for (uint32_t n = 0U; n < 20000U; n++) {
+                uint32_t peerId = 10U + (n % 64U);
+                registry.insert(peerId, new TestConnection(peerId));
+                registry.reclaim();
+            }
+
+            running.store(false);
+            for (std::thread& thread : threads)
+                thread.join();
+
+            if (readFailed.load()) {
+                ::LogDebug("T", "PeerRegistry, connection freed while a reader on another thread held it");
+                failed = true;
+            }
+        }
+
+        TestConnection::bury();
+
+        REQUIRE(failed==false);
+    }
+}
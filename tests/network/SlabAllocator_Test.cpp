@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/udp/Socket.h"
+#include "common/SlabAllocator.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+#define TEST_THREADS 4U
+#define TEST_LIVE_BLOCKS 64U
+
+TEST_CASE("SlabAllocator", "[Slab Allocator Test]") {
+    SECTION("Size_Classes") {
+        bool failed = false;
+
+        INFO("Slab Allocator Size Classes Test");
+
+        const size_t sizes[] = { 1U, 32U, 55U, 64U, 87U, 128U, 193U, 225U, 256U, 300U, 512U, 1000U, 1024U, 4096U };
+
+        // warm up
+        for (size_t size : sizes) {
+            SlabAllocator::deallocate(SlabAllocator::allocate(size));
+        }
+
+        uint64_t heapAllocs = SlabAllocator::heapAllocations();
+        for (uint32_t i = 0U; i < 1000U; i++) {
+            for (size_t size : sizes) {
+                uint8_t* buffer = SlabAllocator::allocateBuffer(size);
+                if (((uintptr_t)buffer % 16U) != 0U) {
+                    ::LogDebug("T", "SlabAllocator, unaligned block, size = %u", (uint32_t)size);
+                    failed = true;
+                }
+
+                ::memset(buffer, (uint8_t)size, size);
+                SlabAllocator::deallocate(buffer);
+            }
+        }
+
+        // only the oversized block should have come from the heap
+        uint64_t count = SlabAllocator::heapAllocations() - heapAllocs;
+        if (count != 1000U) {
+            ::LogDebug("T", "SlabAllocator, blocks not reused, heap allocations = %u", (uint32_t)count);
+            failed = true;
+        }
+
+        // datagrams are allocated from the slab allocator
+        heapAllocs = SlabAllocator::heapAllocations();
+        udp::UDPDatagram* dgram = new udp::UDPDatagram;
+        delete dgram;
+        dgram = new udp::UDPDatagram;
+        delete dgram;
+        if (SlabAllocator::heapAllocations() - heapAllocs > 1U) {
+            ::LogDebug("T", "SlabAllocator, datagram not pooled");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Disabled") {
+        bool failed = false;
+
+        INFO("Slab Allocator Disabled Test");
+
+        uint8_t* pooled = SlabAllocator::allocateBuffer(128U);
+
+        SlabAllocator::setEnabled(false);
+        uint64_t heapAllocs = SlabAllocator::heapAllocations();
+        uint8_t* buffer = SlabAllocator::allocateBuffer(128U);
+        if (SlabAllocator::heapAllocations() - heapAllocs != 1U) {
+            ::LogDebug("T", "SlabAllocator, disabled allocation not from heap");
+            failed = true;
+        }
+
+        // blocks from either path may be released either way
+        SlabAllocator::deallocate(pooled);
+        SlabAllocator::setEnabled(true);
+        SlabAllocator::deallocate(buffer);
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Concurrent") {
+        bool failed = false;
+
+        INFO("Slab Allocator Concurrent Test");
+
+        srand((unsigned int)time(NULL));
+
+        uint64_t allocations = SlabAllocator::allocations();
+
+        std::atomic<uint32_t> errors{0U};
+        std::atomic<uint64_t> allocated{0U};
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0U; t < TEST_THREADS; t++) {
+            uint32_t seed = (uint32_t)rand();
+            threads.push_back(std::thread([t, seed, &errors, &allocated]() {
+                uint32_t state = seed;
+                uint8_t* live[TEST_LIVE_BLOCKS] = { };
+                size_t liveLen[TEST_LIVE_BLOCKS] = { };
+
+                for (uint32_t i = 0U; i < 100000U; i++) {
+                    state = state * 1103515245U + 12345U;
+                    uint32_t slot = (state >> 8) % TEST_LIVE_BLOCKS;
+
+                    // every byte of a live block carries the owning thread and slot; if a block was
+                    // ever handed out twice, another thread (or slot) would have overwritten it
+                    if (live[slot] != nullptr) {
+                        uint8_t tag = (uint8_t)((t << 6) | slot);
+                        for (size_t n = 0U; n < liveLen[slot]; n++) {
+                            if (live[slot][n] != tag) {
+                                errors++;
+                                break;
+                            }
+                        }
+
+                        SlabAllocator::deallocate(live[slot]);
+                        live[slot] = nullptr;
+                    }
+                    else {
+                        size_t len = 1U + ((state >> 16) % 1024U);
+                        live[slot] = SlabAllocator::allocateBuffer(len);
+                        liveLen[slot] = len;
+                        allocated++;
+                        ::memset(live[slot], (uint8_t)((t << 6) | slot), len);
+                    }
+                }
+
+                for (uint32_t slot = 0U; slot < TEST_LIVE_BLOCKS; slot++) {
+                    SlabAllocator::deallocate(live[slot]);
+                }
+            }));
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (errors.load() != 0U) {
+            ::LogDebug("T", "SlabAllocator, %u blocks shared between owners", errors.load());
+            failed = true;
+        }
+
+        // the per-thread allocation counts of the (exited) threads are kept in the total
+        if (SlabAllocator::allocations() - allocations != allocated.load()) {
+            ::LogDebug("T", "SlabAllocator, allocation count mismatch, %u != %u", (uint32_t)(SlabAllocator::allocations() - allocations),
+                (uint32_t)allocated.load());
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
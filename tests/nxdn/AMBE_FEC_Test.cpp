@@ -13,12 +13,16 @@
 #include "common/nxdn/NXDNUtils.h"
 #include "common/Log.h"
 #include "common/Utils.h"
+#include "edac/AMBEFECReference.h"
 
 using namespace edac;
 using namespace nxdn;
 using namespace nxdn::defines;
 
 #include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 TEST_CASE("NXDN", "[AMBE FEC Test]") {
     SECTION("NXDN_AMBEFEC_Test") {
@@ -52,4 +56,77 @@ TEST_CASE("NXDN", "[AMBE FEC Test]") {
 cleanup:
         REQUIRE(failed==false);
     }
+
+    SECTION("NXDN_AMBEFEC_Regenerate_Test") {
+        bool failed = false;
+
+        INFO("NXDN AMBE FEC Regenerate Test");
+
+        srand((unsigned int)time(NULL));
+
+        AMBEFEC fec = AMBEFEC();
+
+        for (uint32_t n = 0U; n < 64U; n++) {
+            uint8_t frame[9U];
+            for (size_t i = 0; i < sizeof(frame); i++) {
+                frame[i] = rand();
+            }
+
+            // it takes two passes for random data to become a valid codeword set; regenerating
+            // again must be error free
+            fec.regenerateNXDN(frame);
+            fec.regenerateNXDN(frame);
+
+            uint8_t clean[9U];
+            ::memcpy(clean, frame, sizeof(frame));
+
+            uint32_t errors = fec.regenerateNXDN(frame);
+            if (errors != 0U || ::memcmp(clean, frame, sizeof(frame)) != 0) {
+                ::LogDebug("T", "NXDN_AMBEFEC_Regenerate_Test, failed clean frame, errors = %u", errors);
+                failed = true;
+                break;
+            }
+
+            // a single bit error in the A Golay codeword is measured and corrected
+            uint32_t bit = AMBE_A_TABLE[rand() % 24U];
+            WRITE_BIT(frame, bit, !READ_BIT(frame, bit));
+
+            errors = fec.measureNXDNBER(frame);
+            if (errors != 1U) {
+                ::LogDebug("T", "NXDN_AMBEFEC_Regenerate_Test, failed BER, bit = %u, errors = %u", bit, errors);
+                failed = true;
+                break;
+            }
+
+            errors = fec.regenerateNXDN(frame);
+            if (errors != 1U || ::memcmp(clean, frame, sizeof(frame)) != 0) {
+                ::LogDebug("T", "NXDN_AMBEFEC_Regenerate_Test, failed correction, bit = %u, errors = %u", bit, errors);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("NXDN_AMBEFEC_BitExact_Test") {
+        bool failed = false;
+
+        INFO("NXDN AMBE FEC Bit-Exact Test");
+
+        AMBEFEC fec = AMBEFEC();
+
+        // regenerated and error corrected frames must be bit-exact with the original implementation
+        uint64_t hash = hashAMBEFrames(9U,
+            [&](uint8_t* frame) { return fec.regenerateNXDN(frame); },
+            [&](uint8_t* frame) { return fec.measureNXDNBER(frame); });
+
+        if (hash != NXDN_AMBE_FEC_REFERENCE_HASH) {
+            ::LogDebug("T", "NXDN_AMBEFEC_BitExact_Test, failed, hash = $%016llX, expected = $%016llX",
+                (unsigned long long)hash, (unsigned long long)NXDN_AMBE_FEC_REFERENCE_HASH);
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
 }
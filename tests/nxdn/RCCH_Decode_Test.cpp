@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/nxdn/NXDNDefines.h"
+#include "common/nxdn/lc/rcch/RCCHFactory.h"
+#include "common/SlabAllocator.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace nxdn;
+using namespace nxdn::defines;
+using namespace nxdn::lc;
+using namespace nxdn::lc::rcch;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+TEST_CASE("RCCH", "[NXDN RCCH Decode Test]") {
+    SECTION("InPlace_Decode") {
+        bool failed = false;
+
+        INFO("NXDN RCCH In-Place Decode Test");
+
+        uint8_t data[NXDN_RCCH_LC_LENGTH_BYTES];
+        ::memset(data, 0x00U, NXDN_RCCH_LC_LENGTH_BYTES);
+
+        MESSAGE_TYPE_GRP_REG reg = MESSAGE_TYPE_GRP_REG();
+        reg.setSrcId(1234U);
+        reg.setDstId(5678U);
+        reg.encode(data, NXDN_RCCH_LC_LENGTH_BITS);
+
+        // decode on the heap, through the existing factory
+        std::unique_ptr<RCCH> heap = RCCHFactory::createRCCH(data, NXDN_RCCH_LC_LENGTH_BITS);
+        if (heap == nullptr || heap->getMessageType() != MessageType::RCCH_GRP_REG) {
+            ::LogDebug("T", "RCCH, factory failed to decode RCCH");
+            failed = true;
+        }
+
+        // decode in place; this should not allocate the RCCH
+        uint64_t allocations = SlabAllocator::allocations();
+
+        RCCHStorage storage;
+        RCCH* rcch = RCCHFactory::decodeRCCH(data, NXDN_RCCH_LC_LENGTH_BITS, storage);
+        if (rcch == nullptr || rcch != storage.get() || dynamic_cast<MESSAGE_TYPE_GRP_REG*>(rcch) == nullptr) {
+            ::LogDebug("T", "RCCH, failed to decode RCCH in place");
+            failed = true;
+        }
+        else if (heap != nullptr && (rcch->getSrcId() != heap->getSrcId() || rcch->getDstId() != heap->getDstId() ||
+            rcch->getSrcId() != 1234U || rcch->getDstId() != 5678U)) {
+            ::LogDebug("T", "RCCH, in place decode mismatch, srcId = %u, dstId = %u", rcch->getSrcId(), rcch->getDstId());
+            failed = true;
+        }
+
+        uint32_t visited = 0U;
+        bool ret = RCCHFactory::visitRCCH(data, NXDN_RCCH_LC_LENGTH_BITS, [&](RCCH& visit) {
+            if (visit.getMessageType() == MessageType::RCCH_GRP_REG && visit.getDstId() == 5678U)
+                visited++;
+        });
+
+        if (!ret || visited != 1U) {
+            ::LogDebug("T", "RCCH, visitor not called, ret = %s, visited = %u", ret ? "true" : "false", visited);
+            failed = true;
+        }
+
+        if (SlabAllocator::allocations() != allocations) {
+            ::LogDebug("T", "RCCH, in place decode allocated, %u != %u", (uint32_t)SlabAllocator::allocations(), (uint32_t)allocations);
+            failed = true;
+        }
+
+        // an unknown message type shouldn't decode, and leaves the storage empty
+        data[0U] = 0x3FU;
+        if (RCCHFactory::decodeRCCH(data, NXDN_RCCH_LC_LENGTH_BITS, storage) != nullptr || storage) {
+            ::LogDebug("T", "RCCH, unknown RCCH decoded");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
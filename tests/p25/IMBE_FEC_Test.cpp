@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/AMBEFEC.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "edac/AMBEFECReference.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+TEST_CASE("IMBE", "[IMBE FEC Test]") {
+    SECTION("IMBE_FEC_Regenerate_Test") {
+        bool failed = false;
+
+        INFO("P25 IMBE FEC Regenerate Test");
+
+        srand((unsigned int)time(NULL));
+
+        AMBEFEC fec = AMBEFEC();
+
+        for (uint32_t n = 0U; n < 64U; n++) {
+            uint8_t frame[18U];
+            for (size_t i = 0; i < sizeof(frame); i++) {
+                frame[i] = rand();
+            }
+
+            // regenerating random data yields a valid codeword set; doing it again must be error free
+            fec.regenerateIMBE(frame);
+
+            uint8_t clean[18U];
+            ::memcpy(clean, frame, sizeof(frame));
+
+            uint32_t errors = fec.regenerateIMBE(frame);
+            if (errors != 0U || ::memcmp(clean, frame, sizeof(frame)) != 0) {
+                ::LogDebug("T", "IMBE_FEC_Regenerate_Test, failed clean frame, errors = %u", errors);
+                failed = true;
+                break;
+            }
+
+            // a single bit error in the c0 Golay codeword is measured and corrected
+            uint32_t bit = IMBE_INTERLEAVE[rand() % 23U];
+            WRITE_BIT(frame, bit, !READ_BIT(frame, bit));
+
+            errors = fec.measureP25BER(frame);
+            if (errors != 1U) {
+                ::LogDebug("T", "IMBE_FEC_Regenerate_Test, failed BER, bit = %u, errors = %u", bit, errors);
+                failed = true;
+                break;
+            }
+
+            errors = fec.regenerateIMBE(frame);
+            if (errors != 1U || ::memcmp(clean, frame, sizeof(frame)) != 0) {
+                ::LogDebug("T", "IMBE_FEC_Regenerate_Test, failed correction, bit = %u, errors = %u", bit, errors);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("IMBE_FEC_BitExact_Test") {
+        bool failed = false;
+
+        INFO("P25 IMBE FEC Bit-Exact Test");
+
+        AMBEFEC fec = AMBEFEC();
+
+        // regenerated and error corrected frames must be bit-exact with the original implementation
+        uint64_t hash = hashAMBEFrames(18U,
+            [&](uint8_t* frame) { return fec.regenerateIMBE(frame); },
+            [&](uint8_t* frame) { return fec.measureP25BER(frame); });
+
+        if (hash != P25_IMBE_FEC_REFERENCE_HASH) {
+            ::LogDebug("T", "IMBE_FEC_BitExact_Test, failed, hash = $%016llX, expected = $%016llX",
+                (unsigned long long)hash, (unsigned long long)P25_IMBE_FEC_REFERENCE_HASH);
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/data/LowSpeedData.h"
+#include "common/p25/lc/LC.h"
+#include "common/p25/Audio.h"
+#include "common/p25/LDUTemplate.h"
+#include "common/p25/NID.h"
+#include "common/p25/P25Utils.h"
+#include "common/p25/Sync.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace p25;
+using namespace p25::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Helper to assemble a LDU the way the host did before frame templates; every part of
+ *  the frame is rebuilt from scratch.
+ */
+static void buildLDU(uint8_t* data, DUID::E duid, lc::LC& lc, NID& nid, Audio& audio, const uint8_t* imbe,
+    const data::LowSpeedData& lsd)
+{
+    ::memset(data, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+
+    Sync::addP25Sync(data);
+    nid.encode(data, duid);
+
+    if (duid == DUID::LDU1)
+        lc.encodeLDU1(data);
+    else
+        lc.encodeLDU2(data);
+
+    for (uint32_t n = 0U; n < 9U; n++)
+        audio.encode(data, imbe + (n * RAW_IMBE_LENGTH_BYTES), n);
+
+    lsd.encode(data);
+
+    P25Utils::addStatusBits(data, P25_LDU_FRAME_LENGTH_BITS, false, false);
+}
+
+/**
+ * @brief Helper to assemble a LDU from a frame template; only the audio and low speed data are encoded.
+ */
+static void buildLDU(uint8_t* data, LDUTemplate& ldu, lc::LC& lc, NID& nid, Audio& audio, const uint8_t* imbe,
+    const data::LowSpeedData& lsd)
+{
+    ldu.get(data, lc, nid);
+
+    for (uint32_t n = 0U; n < 9U; n++)
+        audio.encode(data, imbe + (n * RAW_IMBE_LENGTH_BYTES), n);
+
+    lsd.encode(data);
+}
+
+TEST_CASE("LDU", "[P25 LDU Template Test]") {
+    SECTION("Template_Matches_Full_Assembly") {
+        bool failed = false;
+
+        INFO("P25 LDU Template Test");
+
+        srand(0x1234U);
+
+        NID nid = NID(0x293U);
+        Audio audio = Audio();
+
+        LDUTemplate ldu1(DUID::LDU1);
+        LDUTemplate ldu2(DUID::LDU2);
+
+        lc::LC lc = lc::LC();
+        lc.setLCO(LCO::GROUP);
+        lc.setSrcId(1234U);
+        lc.setDstId(5678U);
+
+        uint8_t imbe[9U * RAW_IMBE_LENGTH_BYTES];
+        uint8_t expected[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t actual[P25_LDU_FRAME_LENGTH_BYTES];
+
+        for (uint32_t frame = 0U; frame < 64U; frame++) {
+            // change the link control (and the encryption sync) part way through the call, then
+            // start a new call, so the template is both reused and rebuilt
+            if (frame == 24U) {
+                lc.setSrcId(4321U);
+                lc.setEmergency(true);
+
+                uint8_t mi[MI_LENGTH_BYTES];
+                for (uint32_t i = 0U; i < MI_LENGTH_BYTES; i++)
+                    mi[i] = (uint8_t)rand();
+                lc.setMI(mi);
+                lc.setAlgId(0x84U); // AES-256
+                lc.setKId(0x1234U);
+            }
+
+            if (frame == 48U) {
+                ldu1.reset();
+                ldu2.reset();
+                lc.setDstId(9999U);
+            }
+
+            for (uint32_t i = 0U; i < sizeof(imbe); i++)
+                imbe[i] = (uint8_t)rand();
+
+            data::LowSpeedData lsd = data::LowSpeedData();
+            lsd.setLSD1((uint8_t)rand());
+            lsd.setLSD2((uint8_t)rand());
+
+            DUID::E duid = (frame & 1U) ? DUID::LDU2 : DUID::LDU1;
+
+            buildLDU(expected, duid, lc, nid, audio, imbe, lsd);
+            buildLDU(actual, (duid == DUID::LDU1) ? ldu1 : ldu2, lc, nid, audio, imbe, lsd);
+
+            if (::memcmp(expected, actual, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+                ::LogDebug("T", "LDU, frame %u (%s) template mismatch", frame, (duid == DUID::LDU1) ? "LDU1" : "LDU2");
+                Utils::dump(2U, "Expected", expected, P25_LDU_FRAME_LENGTH_BYTES);
+                Utils::dump(2U, "Actual", actual, P25_LDU_FRAME_LENGTH_BYTES);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
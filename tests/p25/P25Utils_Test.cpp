@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/P25Utils.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace p25;
+using namespace p25::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Bit-at-a-time status symbol strip used as the reference for the byte-wise implementation. */
+static uint32_t referenceDecode(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+    while (ss0Pos < start) {
+        ss0Pos += P25_SS_INCREMENT;
+        ss1Pos += P25_SS_INCREMENT;
+    }
+
+    uint32_t n = 0U;
+    for (uint32_t i = start; i < stop; i++) {
+        if (i == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (i == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, i);
+            WRITE_BIT(out, n, b);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/* Bit-at-a-time status symbol insert used as the reference for the byte-wise implementation. */
+static uint32_t referenceEncode(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+    while (ss0Pos < start) {
+        ss0Pos += P25_SS_INCREMENT;
+        ss1Pos += P25_SS_INCREMENT;
+    }
+
+    uint32_t n = 0U;
+    for (uint32_t i = start; i < stop; i++) {
+        if (i == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (i == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, n);
+            WRITE_BIT(out, i, b);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+TEST_CASE("P25Utils", "[P25 Status Symbol Test]") {
+    SECTION("Decode_Encode_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("P25 Status Symbol Byte-wise/Bitwise Equivalence Test");
+
+        srand((unsigned int)time(NULL));
+
+        uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES], out[P25_LDU_FRAME_LENGTH_BYTES], expected[P25_LDU_FRAME_LENGTH_BYTES];
+        for (uint32_t n = 0U; n < 4096U; n++) {
+            for (size_t i = 0; i < sizeof(frame); i++) {
+                frame[i] = rand();
+                out[i] = expected[i] = rand();
+            }
+
+            // arbitrary (unaligned) regions, including ones starting and ending on status symbols
+            uint32_t start = rand() % P25_LDU_FRAME_LENGTH_BITS;
+            uint32_t stop = start + (rand() % (P25_LDU_FRAME_LENGTH_BITS - start + 1U));
+
+            uint32_t ret = P25Utils::decode(frame, out, start, stop);
+            uint32_t expectedRet = referenceDecode(frame, expected, start, stop);
+            if (ret != expectedRet || ::memcmp(out, expected, sizeof(out)) != 0) {
+                ::LogDebug("T", "Decode_Encode_Equivalence_Test, decode mismatch, start = %u, stop = %u", start, stop);
+                failed = true;
+            }
+
+            ret = P25Utils::encode(frame, out, start, stop);
+            expectedRet = referenceEncode(frame, expected, start, stop);
+            if (ret != expectedRet || ::memcmp(out, expected, sizeof(out)) != 0) {
+                ::LogDebug("T", "Decode_Encode_Equivalence_Test, encode mismatch, start = %u, stop = %u", start, stop);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Status_Bits_Test") {
+        bool failed = false;
+
+        INFO("P25 Status Bits Test");
+
+        uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES];
+        ::memset(frame, 0x00U, sizeof(frame));
+
+        P25Utils::addStatusBits(frame, P25_LDU_FRAME_LENGTH_BITS, true, false);
+
+        // every other status symbol is busy (0,1), the rest unknown (1,0), and no data bits are touched
+        uint32_t n = 0U;
+        for (uint32_t i = 0U; i < P25_LDU_FRAME_LENGTH_BITS; i++) {
+            bool b = READ_BIT(frame, i) != 0U;
+
+            bool expected = false;
+            if ((i % P25_SS_INCREMENT) == P25_SS0_START)
+                expected = (n % 2U) != 0U;
+            if ((i % P25_SS_INCREMENT) == P25_SS1_START) {
+                expected = (n % 2U) == 0U;
+                n++;
+            }
+
+            if (b != expected) {
+                ::LogDebug("T", "Status_Bits_Test, bad bit %u", i);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
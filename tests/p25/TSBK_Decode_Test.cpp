@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/lc/tsbk/TSBKFactory.h"
+#include "common/SlabAllocator.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace p25;
+using namespace p25::defines;
+using namespace p25::lc;
+using namespace p25::lc::tsbk;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <string.h>
+
+TEST_CASE("TSBK", "[P25 TSBK Decode Test]") {
+    SECTION("InPlace_Decode") {
+        bool failed = false;
+
+        INFO("P25 TSBK In-Place Decode Test");
+
+        uint8_t data[P25_TSDU_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, P25_TSDU_FRAME_LENGTH_BYTES);
+
+        IOSP_GRP_VCH iosp = IOSP_GRP_VCH();
+        iosp.setSrcId(1234U);
+        iosp.setDstId(5678U);
+        iosp.setGrpVchNo(42U);
+        iosp.setLastBlock(true);
+        iosp.encode(data);
+
+        // decode on the heap, through the existing factory
+        std::unique_ptr<TSBK> heap = TSBKFactory::createTSBK(data);
+        if (heap == nullptr || heap->getLCO() != TSBKO::IOSP_GRP_VCH) {
+            ::LogDebug("T", "TSBK, factory failed to decode TSBK");
+            failed = true;
+        }
+
+        // decode in place; this should not allocate the TSBK
+        uint64_t allocations = SlabAllocator::allocations();
+
+        TSBKStorage storage;
+        TSBK* tsbk = TSBKFactory::decodeTSBK(data, storage);
+        if (tsbk == nullptr || tsbk != storage.get() || dynamic_cast<IOSP_GRP_VCH*>(tsbk) == nullptr) {
+            ::LogDebug("T", "TSBK, failed to decode TSBK in place");
+            failed = true;
+        }
+        else if (heap != nullptr && (tsbk->getSrcId() != heap->getSrcId() || tsbk->getDstId() != heap->getDstId() ||
+            tsbk->getGrpVchNo() != heap->getGrpVchNo() || tsbk->getSrcId() != 1234U || tsbk->getDstId() != 5678U)) {
+            ::LogDebug("T", "TSBK, in place decode mismatch, srcId = %u, dstId = %u", tsbk->getSrcId(), tsbk->getDstId());
+            failed = true;
+        }
+
+        uint32_t visited = 0U;
+        bool ret = TSBKFactory::visitTSBK(data, [&](TSBK& visit) {
+            if (visit.getLCO() == TSBKO::IOSP_GRP_VCH && visit.getDstId() == 5678U)
+                visited++;
+        });
+
+        if (!ret || visited != 1U) {
+            ::LogDebug("T", "TSBK, visitor not called, ret = %s, visited = %u", ret ? "true" : "false", visited);
+            failed = true;
+        }
+
+        if (SlabAllocator::allocations() != allocations) {
+            ::LogDebug("T", "TSBK, in place decode allocated, %u != %u", (uint32_t)SlabAllocator::allocations(), (uint32_t)allocations);
+            failed = true;
+        }
+
+        // an invalid block shouldn't decode, and leaves the storage empty
+        ::memset(data, 0x00U, P25_TSDU_FRAME_LENGTH_BYTES);
+        if (TSBKFactory::decodeTSBK(data, storage) != nullptr || storage) {
+            ::LogDebug("T", "TSBK, invalid TSBK decoded");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}